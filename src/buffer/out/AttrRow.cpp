@@ -67,6 +67,28 @@ std::vector<uint16_t> ATTR_ROW::GetHyperlinks() const
     return ids;
 }
 
+// Routine Description:
+// - Finds the cells in this row that link to the given hyperlink.
+// Arguments:
+// - id - The hyperlink ID
+// Return Value:
+// - The [begin, end) columns of every run of cells with that hyperlink ID.
+std::vector<std::pair<uint16_t, uint16_t>> ATTR_ROW::GetHyperlinkRuns(const uint16_t id) const
+{
+    std::vector<std::pair<uint16_t, uint16_t>> runs;
+    uint16_t column = 0;
+    for (const auto& run : _data.runs())
+    {
+        const auto end = gsl::narrow_cast<uint16_t>(column + run.length);
+        if (run.value.IsHyperlink() && run.value.GetHyperlinkId() == id)
+        {
+            runs.emplace_back(column, end);
+        }
+        column = end;
+    }
+    return runs;
+}
+
 // Routine Description:
 // - Sets the attributes (colors) of all character positions from the given position through the end of the row.
 // Arguments:
@@ -108,6 +130,57 @@ void ATTR_ROW::Replace(const uint16_t beginIndex, const uint16_t endIndex, const
     _data.replace(beginIndex, endIndex, newAttr);
 }
 
+// Routine Description:
+// - Copies the attributes of [beginIndex, endIndex) over to the columns starting at destination.
+//   The runs are spliced in as they are, instead of being replaced column by column.
+// - For example, if the current row was [{2, BLUE}, {2, RED}, {2, GREEN}], the move arguments were
+//   { beginIndex = 2, endIndex = 6, destination = 0 }, then the row would be modified to be
+//   [{2, RED}, {4, GREEN}].
+// Arguments:
+// - beginIndex, endIndex: The [beginIndex, endIndex) range to copy.
+// - destination: The column the attribute at beginIndex is copied to.
+// Return Value:
+// - <none>
+void ATTR_ROW::Move(const uint16_t beginIndex, const uint16_t endIndex, const uint16_t destination)
+{
+    Copy(*this, beginIndex, endIndex, destination);
+}
+
+// Routine Description:
+// - Copies the attributes of [beginIndex, endIndex) of the source row over to
+//   the columns of this row starting at destination, splicing in the runs as they are.
+// - source may be this row itself. See Move.
+// Arguments:
+// - source: The row to copy the attributes from.
+// - beginIndex, endIndex: The [beginIndex, endIndex) range to copy.
+// - destination: The column the attribute at beginIndex is copied to.
+// Return Value:
+// - <none>
+void ATTR_ROW::Copy(const ATTR_ROW& source, const uint16_t beginIndex, const uint16_t endIndex, const uint16_t destination)
+{
+    if (beginIndex >= endIndex)
+    {
+        return;
+    }
+
+    const auto moved = source._data.slice(beginIndex, endIndex);
+    const auto& runs = moved.runs();
+    _data.replace(destination, gsl::narrow_cast<uint16_t>(destination + (endIndex - beginIndex)), { runs.data(), runs.size() });
+}
+
+// Routine Description:
+// - Returns the memory the runs of this row allocated on the heap. A row with
+//   a single run stores it inline and allocates nothing.
+// Arguments:
+// - <none>
+// Return Value:
+// - The size of the heap allocation, in bytes.
+size_t ATTR_ROW::MemoryUsage() const noexcept
+{
+    const auto& runs = _data.runs();
+    return runs.capacity() > 1 ? runs.capacity() * sizeof(rle_vector::container::value_type) : 0;
+}
+
 ATTR_ROW::const_iterator ATTR_ROW::begin() const noexcept
 {
     return _data.begin();
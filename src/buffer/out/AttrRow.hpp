@@ -42,11 +42,16 @@ public:
 
     TextAttribute GetAttrByColumn(uint16_t column) const;
     std::vector<uint16_t> GetHyperlinks() const;
+    std::vector<std::pair<uint16_t, uint16_t>> GetHyperlinkRuns(uint16_t id) const;
 
     bool SetAttrToEnd(uint16_t beginIndex, TextAttribute attr);
     void ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith);
     void Resize(uint16_t newWidth);
     void Replace(uint16_t beginIndex, uint16_t endIndex, const TextAttribute& newAttr);
+    void Move(uint16_t beginIndex, uint16_t endIndex, uint16_t destination);
+    void Copy(const ATTR_ROW& source, uint16_t beginIndex, uint16_t endIndex, uint16_t destination);
+
+    size_t MemoryUsage() const noexcept;
 
     const_iterator begin() const noexcept;
     const_iterator end() const noexcept;
@@ -10,19 +10,16 @@
 // Routine Description:
 // - constructor
 // Arguments:
-// - rowWidth - the size (in wchar_t) of the char and attribute rows
+// - buffer - the slice of the text buffer's cell storage that holds this row's cells.
+//            The cells are expected to already be in their default state.
 // - pParent - the parent ROW
 // Return Value:
 // - instantiated object
-// Note: will through if unable to allocate char/attribute buffers
-#pragma warning(push)
-#pragma warning(disable : 26447) // small_vector's constructor says it can throw but it should not given how we use it.  This suppresses this error for the AuditMode build.
-CharRow::CharRow(size_t rowWidth, ROW* const pParent) noexcept :
-    _data(rowWidth, value_type()),
+CharRow::CharRow(const gsl::span<value_type> buffer, ROW* const pParent) noexcept :
+    _data{ buffer },
     _pParent{ FAIL_FAST_IF_NULL(pParent) }
 {
 }
-#pragma warning(pop)
 
 // Routine Description:
 // - gets the size of the row, in glyph cells
@@ -43,48 +40,67 @@ size_t CharRow::size() const noexcept
 // - <none>
 void CharRow::Reset() noexcept
 {
-    for (auto& cell : _data)
-    {
-        cell.Reset();
-    }
+    std::fill(begin(), end(), value_type{});
 }
 
 // Routine Description:
-// - resizes the width of the CharRowBase
+// - resizes the width of the CharRowBase by moving it onto a new slice of cell storage
+// - as many cells as fit are carried over. any new cells keep the default state they
+//   already have in the new slice.
 // Arguments:
-// - newSize - the new width of the character and attributes rows
+// - buffer - the new slice of cell storage. its size is the new width of the row.
 // Return Value:
-// - S_OK on success, otherwise relevant error code
-[[nodiscard]] HRESULT CharRow::Resize(const size_t newSize) noexcept
+// - <none>
+void CharRow::Resize(const gsl::span<value_type> buffer) noexcept
 {
-    try
+    if (buffer.data() != _data.data())
     {
-        const value_type insertVals;
-        _data.resize(newSize, insertVals);
+        const auto count = std::min(_data.size(), buffer.size());
+        std::copy_n(cbegin(), count, buffer.data());
     }
-    CATCH_RETURN();
-
-    return S_OK;
+    _data = buffer;
 }
 
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead. We're implementing the span's iterators.
 typename CharRow::iterator CharRow::begin() noexcept
 {
-    return _data.begin();
+    return _data.data();
 }
 
 typename CharRow::const_iterator CharRow::cbegin() const noexcept
 {
-    return _data.cbegin();
+    return _data.data();
 }
 
 typename CharRow::iterator CharRow::end() noexcept
 {
-    return _data.end();
+    return _data.data() + _data.size();
 }
 
 typename CharRow::const_iterator CharRow::cend() const noexcept
 {
-    return _data.cend();
+    return _data.data() + _data.size();
+}
+#pragma warning(pop)
+
+// Routine Description:
+// - bounds checked access to the cell at the given column
+// Arguments:
+// - column - the column of the cell
+// Return Value:
+// - reference to the cell
+// Note: will throw exception if column is out of bounds
+typename CharRow::value_type& CharRow::_cellAt(const size_t column)
+{
+    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    return til::at(_data, column);
+}
+
+const typename CharRow::value_type& CharRow::_cellAt(const size_t column) const
+{
+    THROW_HR_IF(E_INVALIDARG, column >= _data.size());
+    return til::at(_data, column);
 }
 
 // Routine Description:
@@ -95,12 +111,12 @@ typename CharRow::const_iterator CharRow::cend() const noexcept
 // - The calculated left boundary of the internal string.
 size_t CharRow::MeasureLeft() const noexcept
 {
-    const_iterator it = _data.cbegin();
-    while (it != _data.cend() && it->IsSpace())
+    const_iterator it = cbegin();
+    while (it != cend() && it->IsSpace())
     {
         ++it;
     }
-    return it - _data.cbegin();
+    return it - cbegin();
 }
 
 // Routine Description:
@@ -111,17 +127,18 @@ size_t CharRow::MeasureLeft() const noexcept
 // - The calculated right boundary of the internal string.
 size_t CharRow::MeasureRight() const
 {
-    const_reverse_iterator it = _data.crbegin();
-    while (it != _data.crend() && it->IsSpace())
+    const const_reverse_iterator rend{ cbegin() };
+    const_reverse_iterator it{ cend() };
+    while (it != rend && it->IsSpace())
     {
         ++it;
     }
-    return _data.crend() - it;
+    return rend - it;
 }
 
 void CharRow::ClearCell(const size_t column)
 {
-    _data.at(column).Reset();
+    _cellAt(column).Reset();
 }
 
 // Routine Description:
@@ -151,7 +168,7 @@ bool CharRow::ContainsText() const noexcept
 // Note: will throw exception if column is out of bounds
 const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 {
-    return _data.at(column).DbcsAttr();
+    return _cellAt(column).DbcsAttr();
 }
 
 // Routine Description:
@@ -163,7 +180,7 @@ const DbcsAttribute& CharRow::DbcsAttrAt(const size_t column) const
 // Note: will throw exception if column is out of bounds
 DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 {
-    return _data.at(column).DbcsAttr();
+    return _cellAt(column).DbcsAttr();
 }
 
 // Routine Description:
@@ -175,7 +192,7 @@ DbcsAttribute& CharRow::DbcsAttrAt(const size_t column)
 // Note: will throw exception if column is out of bounds
 void CharRow::ClearGlyph(const size_t column)
 {
-    _data.at(column).EraseChars();
+    _cellAt(column).EraseChars();
 }
 
 // Routine Description:
@@ -265,10 +282,10 @@ const UnicodeStorage& CharRow::GetUnicodeStorage() const noexcept
 // Arguments:
 // - column - the column to generate the key for
 // Return Value:
-// - the COORD key for data access from UnicodeStorage for the column
-COORD CharRow::GetStorageKey(const size_t column) const noexcept
+// - the key for data access from the row's UnicodeStorage for the column
+UnicodeStorage::key_type CharRow::GetStorageKey(const size_t column) const noexcept
 {
-    return { gsl::narrow<SHORT>(column), _pParent->GetId() };
+    return column;
 }
 
 // Routine Description:
@@ -49,15 +49,20 @@ class CharRow final
 public:
     using glyph_type = typename wchar_t;
     using value_type = typename CharRowCell;
-    using iterator = typename boost::container::small_vector_base<value_type>::iterator;
-    using const_iterator = typename boost::container::small_vector_base<value_type>::const_iterator;
-    using const_reverse_iterator = typename boost::container::small_vector_base<value_type>::const_reverse_iterator;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
     using reference = typename CharRowCellReference;
 
-    CharRow(size_t rowWidth, ROW* const pParent) noexcept;
+    CharRow(const gsl::span<value_type> buffer, ROW* const pParent) noexcept;
+
+    CharRow(const CharRow&) = delete;
+    CharRow& operator=(const CharRow&) = delete;
+    CharRow(CharRow&&) noexcept = default;
+    CharRow& operator=(CharRow&&) noexcept = default;
 
     size_t size() const noexcept;
-    [[nodiscard]] HRESULT Resize(const size_t newSize) noexcept;
+    void Resize(const gsl::span<value_type> buffer) noexcept;
     size_t MeasureLeft() const noexcept;
     size_t MeasureRight() const;
     bool ContainsText() const noexcept;
@@ -82,7 +87,7 @@ public:
 
     UnicodeStorage& GetUnicodeStorage() noexcept;
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
-    COORD GetStorageKey(const size_t column) const noexcept;
+    UnicodeStorage::key_type GetStorageKey(const size_t column) const noexcept;
 
     void UpdateParent(ROW* const pParent);
 
@@ -94,9 +99,13 @@ private:
     void ClearCell(const size_t column);
     std::wstring GetText() const;
 
+    value_type& _cellAt(const size_t column);
+    const value_type& _cellAt(const size_t column) const;
+
 protected:
-    // storage for glyph data and dbcs attributes
-    boost::container::small_vector<value_type, 120> _data;
+    // storage for glyph data and dbcs attributes.
+    // This is a slice of the cell arena owned by the TextBuffer, not our own allocation.
+    gsl::span<value_type> _data;
 
     // ROW that this CharRow belongs to
     ROW* _pParent;
@@ -14,6 +14,11 @@ void CharRowCellReference::operator=(const std::wstring_view chars)
     THROW_HR_IF(E_INVALIDARG, chars.empty());
     if (chars.size() == 1)
     {
+        // Don't leave the glyph we're replacing behind in the row's storage.
+        if (_cellData().DbcsAttr().IsGlyphStored())
+        {
+            _parent.GetUnicodeStorage().Erase(_parent.GetStorageKey(_index));
+        }
         _cellData().Char() = chars.front();
         _cellData().DbcsAttr().SetGlyphStored(false);
     }
@@ -41,7 +46,7 @@ CharRowCellReference::operator std::wstring_view() const
 // - ref to the CharRowCell
 CharRowCell& CharRowCellReference::_cellData()
 {
-    return _parent._data.at(_index);
+    return _parent._cellAt(_index);
 }
 
 // Routine Description:
@@ -50,7 +55,7 @@ CharRowCell& CharRowCellReference::_cellData()
 // - ref to the CharRowCell
 const CharRowCell& CharRowCellReference::_cellData() const
 {
-    return _parent._data.at(_index);
+    return _parent._cellAt(_index);
 }
 
 // Routine Description:
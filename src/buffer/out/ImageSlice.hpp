@@ -0,0 +1,57 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- ImageSlice.hpp
+
+Abstract:
+- One row's worth of an image (e.g. a sixel graphic) displayed in the buffer.
+- Images are split into slices one cell high, and every slice is anchored to
+  the ROW it covers. That way an image scrolls with the text around it, and
+  it's gone as soon as the rows it was drawn on are cleared.
+- The pixels are premultiplied BGRA, one uint32_t per pixel, exactly as the
+  render engines want them. A slice is immutable once it's in the buffer, so
+  an engine can cache whatever it uploads for a slice by its Id.
+--*/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+class ImageSlice final
+{
+public:
+    ImageSlice(const til::size cellSize, const size_t columnBegin, const size_t columnCount) :
+        _id{ _nextId.fetch_add(1, std::memory_order_relaxed) },
+        _cellSize{ cellSize },
+        _columnBegin{ columnBegin },
+        _columnCount{ columnCount },
+        _pixels(columnCount * cellSize.width<size_t>() * cellSize.height<size_t>())
+    {
+    }
+
+    // Unique for every slice of every image there ever was.
+    uint64_t Id() const noexcept { return _id; }
+
+    // The size of a cell, in pixels of this slice. The pixels of a cell are
+    // scaled to whatever the size of a cell on the screen is.
+    til::size CellSize() const noexcept { return _cellSize; }
+    til::size PixelSize() const noexcept { return { _cellSize.width() * gsl::narrow_cast<ptrdiff_t>(_columnCount), _cellSize.height() }; }
+
+    size_t ColumnBegin() const noexcept { return _columnBegin; }
+    size_t ColumnEnd() const noexcept { return _columnBegin + _columnCount; }
+
+    gsl::span<uint32_t> Pixels() noexcept { return _pixels; }
+    gsl::span<const uint32_t> Pixels() const noexcept { return _pixels; }
+
+private:
+    static inline std::atomic<uint64_t> _nextId{ 1 };
+
+    uint64_t _id;
+    til::size _cellSize;
+    size_t _columnBegin;
+    size_t _columnCount;
+    std::vector<uint32_t> _pixels;
+};
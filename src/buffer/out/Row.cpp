@@ -11,19 +11,22 @@
 // - constructor
 // Arguments:
 // - rowId - the row index in the text buffer
-// - rowWidth - the width of the row, cell elements
+// - charBuffer - the slice of the text buffer's cell storage for this row. Its size is the width of the row.
 // - fillAttribute - the default text attribute
 // - pParent - the text buffer that this row belongs to
 // Return Value:
 // - constructed object
-ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent) :
+ROW::ROW(const SHORT rowId, const gsl::span<CharRowCell> charBuffer, const TextAttribute fillAttribute, TextBuffer* const pParent) :
+    _generation{ 0 },
     _id{ rowId },
-    _rowWidth{ rowWidth },
-    _charRow{ rowWidth, this },
-    _attrRow{ rowWidth, fillAttribute },
+    _rowWidth{ gsl::narrow<unsigned short>(charBuffer.size()) },
+    _charRow{ charBuffer, this },
+    _attrRow{ gsl::narrow<unsigned short>(charBuffer.size()), fillAttribute },
+    _unicodeStorage{},
     _lineRendition{ LineRendition::SingleWidth },
     _wrapForced{ false },
     _doubleBytePadded{ false },
+    _hyperlinkCountPending{ false },
     _pParent{ pParent }
 {
 }
@@ -36,13 +39,10 @@ ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute f
 // - <none>
 bool ROW::Reset(const TextAttribute Attr)
 {
-    _lineRendition = LineRendition::SingleWidth;
-    _wrapForced = false;
-    _doubleBytePadded = false;
-    _charRow.Reset();
+    SetLineRendition(LineRendition::SingleWidth);
     try
     {
-        _attrRow.Reset(Attr);
+        Clear(Attr);
     }
     catch (...)
     {
@@ -52,23 +52,64 @@ bool ROW::Reset(const TextAttribute Attr)
     return true;
 }
 
+// Routine Description:
+// - sets the line rendition of the row, and lets the parent text buffer
+//   count the rows that aren't single width
+// Arguments:
+// - lineRendition - the new line rendition
+// Return Value:
+// - <none>
+void ROW::SetLineRendition(const LineRendition lineRendition) noexcept
+{
+    if (_lineRendition != lineRendition && _pParent)
+    {
+        _pParent->_LineRenditionChanged(_lineRendition, lineRendition);
+    }
+    _lineRendition = lineRendition;
+}
+
+// Routine Description:
+// - clears the whole row to spaces in the given attribute, as one run.
+//   Unlike Reset, the line rendition is kept.
+// Arguments:
+// - attr - the attribute to fill the row with
+// Return Value:
+// - <none>
+void ROW::Clear(const TextAttribute& attr)
+{
+    _wrapForced = false;
+    _doubleBytePadded = false;
+    _charRow.Reset();
+    _unicodeStorage.Clear();
+    _attrRow.Reset(attr);
+    _imageSlice.reset();
+}
+
 // Routine Description:
 // - resizes ROW to new width
 // Arguments:
-// - width - the new width, in cells
+// - charBuffer - the new slice of the text buffer's cell storage. Its size is the new width, in cells.
 // Return Value:
 // - S_OK if successful, otherwise relevant error
-[[nodiscard]] HRESULT ROW::Resize(const unsigned short width)
+[[nodiscard]] HRESULT ROW::Resize(const gsl::span<CharRowCell> charBuffer)
 {
-    RETURN_IF_FAILED(_charRow.Resize(width));
+    // The text buffer hands out slices no wider than a SHORT.
+    const auto width = gsl::narrow_cast<unsigned short>(charBuffer.size());
+
+    // The char row must always be moved onto the new storage, even if we fail below,
+    // as the text buffer will release the old storage once we return.
+    _charRow.Resize(charBuffer);
+    _rowWidth = width;
+
+    // Drop the glyphs of any columns we've lost.
+    _unicodeStorage.Truncate(width);
+
     try
     {
         _attrRow.Resize(width);
     }
     CATCH_RETURN();
 
-    _rowWidth = width;
-
     return S_OK;
 }
 
@@ -84,14 +125,176 @@ void ROW::ClearColumn(const size_t column)
     _charRow.ClearCell(column);
 }
 
+// Routine Description:
+// - copies the cells [begin, end) over to the columns starting at destination,
+//   like memmove does. Cells of the source that aren't overwritten keep their contents.
+// - The text is moved in one block and the attributes are spliced as runs,
+//   which is a lot cheaper than rewriting the cells one at a time.
+// - This is the building block of inserting and deleting characters in a line.
+// Arguments:
+// - begin, end - the [begin, end) range of columns to copy
+// - destination - the column the cell at begin is copied to
+// Return Value:
+// - <none>
+void ROW::MoveCells(const size_t begin, const size_t end, const size_t destination)
+{
+    THROW_HR_IF(E_INVALIDARG, begin > end || end > _charRow.size());
+    const auto count = end - begin;
+    THROW_HR_IF(E_INVALIDARG, destination > _charRow.size() - count);
+
+    if (count == 0 || begin == destination)
+    {
+        return;
+    }
+
+    const auto cells = _charRow.begin();
+    if (destination < begin)
+    {
+        std::copy(cells + begin, cells + end, cells + destination);
+    }
+    else
+    {
+        std::copy_backward(cells + begin, cells + end, cells + destination + count);
+    }
+
+    _unicodeStorage.Move(begin, end, destination);
+    _attrRow.Move(gsl::narrow_cast<uint16_t>(begin), gsl::narrow_cast<uint16_t>(end), gsl::narrow_cast<uint16_t>(destination));
+
+    _ClearSplitGlyphs(destination, destination + count);
+}
+
+// Routine Description:
+// - copies the cells [begin, end) of another row over to the columns of this
+//   row starting at destination. Like MoveCells, the text is copied in one
+//   block and the attributes are spliced as runs.
+// - This is the building block of scrolling a rectangle that's narrower
+//   than the buffer up or down.
+// Arguments:
+// - source - the row to copy the cells from. Must not be this row; use MoveCells for that.
+// - begin, end - the [begin, end) range of columns to copy
+// - destination - the column the cell at begin is copied to
+// Return Value:
+// - <none>
+void ROW::CopyCells(const ROW& source, const size_t begin, const size_t end, const size_t destination)
+{
+    THROW_HR_IF(E_INVALIDARG, &source == this);
+    THROW_HR_IF(E_INVALIDARG, begin > end || end > source._charRow.size());
+    const auto count = end - begin;
+    THROW_HR_IF(E_INVALIDARG, destination > _charRow.size() || count > _charRow.size() - destination);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    std::copy(source._charRow.cbegin() + begin, source._charRow.cbegin() + end, _charRow.begin() + destination);
+
+    _unicodeStorage.Copy(source._unicodeStorage, begin, end, destination);
+    _attrRow.Copy(source._attrRow, gsl::narrow_cast<uint16_t>(begin), gsl::narrow_cast<uint16_t>(end), gsl::narrow_cast<uint16_t>(destination));
+
+    _ClearSplitGlyphs(destination, destination + count);
+}
+
+// Routine Description:
+// - replaces the cells [begin, end) with spaces in the given attribute.
+// Arguments:
+// - begin, end - the [begin, end) range of columns to fill
+// - attr - the attribute to fill the cells with
+// Return Value:
+// - <none>
+void ROW::FillCells(const size_t begin, const size_t end, const TextAttribute& attr)
+{
+    FillText(begin, end, UNICODE_SPACE);
+    FillAttributes(begin, end, attr);
+}
+
+// Routine Description:
+// - replaces the text of the cells [begin, end) with the given character,
+//   leaving their attributes alone.
+// Arguments:
+// - begin, end - the [begin, end) range of columns to fill
+// - wch - the character to fill the cells with. Must be a narrow glyph.
+// Return Value:
+// - <none>
+void ROW::FillText(const size_t begin, const size_t end, const wchar_t wch)
+{
+    THROW_HR_IF(E_INVALIDARG, begin > end || end > _charRow.size());
+
+    if (begin == end)
+    {
+        return;
+    }
+
+    std::fill(_charRow.begin() + begin, _charRow.begin() + end, CharRowCell{ wch, DbcsAttribute{} });
+    _unicodeStorage.EraseRange(begin, end);
+
+    _ClearSplitGlyphs(begin, end);
+}
+
+// Routine Description:
+// - replaces the attributes of the cells [begin, end) with a single run of
+//   the given attribute, leaving their text alone.
+// Arguments:
+// - begin, end - the [begin, end) range of columns to fill
+// - attr - the attribute to fill the cells with
+// Return Value:
+// - <none>
+void ROW::FillAttributes(const size_t begin, const size_t end, const TextAttribute& attr)
+{
+    THROW_HR_IF(E_INVALIDARG, begin > end || end > _charRow.size());
+
+    if (begin == end)
+    {
+        return;
+    }
+
+    _attrRow.Replace(gsl::narrow_cast<uint16_t>(begin), gsl::narrow_cast<uint16_t>(end), attr);
+}
+
+// Routine Description:
+// - after the cells [begin, end) were replaced, clears the halves of wide
+//   glyphs that lost their other half because they straddle the edges of the range.
+// Arguments:
+// - begin, end - the [begin, end) range of columns that were replaced
+// Return Value:
+// - <none>
+void ROW::_ClearSplitGlyphs(const size_t begin, const size_t end)
+{
+    if (_charRow.DbcsAttrAt(begin).IsTrailing())
+    {
+        _ClearCellAndGlyph(begin);
+    }
+    if (_charRow.DbcsAttrAt(end - 1).IsLeading())
+    {
+        _ClearCellAndGlyph(end - 1);
+    }
+    if (begin > 0 && _charRow.DbcsAttrAt(begin - 1).IsLeading())
+    {
+        _ClearCellAndGlyph(begin - 1);
+    }
+    if (end < _charRow.size() && _charRow.DbcsAttrAt(end).IsTrailing())
+    {
+        _ClearCellAndGlyph(end);
+    }
+}
+
+void ROW::_ClearCellAndGlyph(const size_t column)
+{
+    if (_charRow.DbcsAttrAt(column).IsGlyphStored())
+    {
+        _unicodeStorage.Erase(_charRow.GetStorageKey(column));
+    }
+    _charRow.ClearCell(column);
+}
+
 UnicodeStorage& ROW::GetUnicodeStorage() noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    return _unicodeStorage;
 }
 
 const UnicodeStorage& ROW::GetUnicodeStorage() const noexcept
 {
-    return _pParent->GetUnicodeStorage();
+    return _unicodeStorage;
 }
 
 // Routine Description:
@@ -196,3 +399,178 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
 
     return it;
 }
+
+// Routine Description:
+// - writes a run of printable ASCII text to the row, all in one attribute.
+// - This is the same as WriteCells, but since every code unit of such text is
+//   exactly one narrow glyph, we can skip the per cell measuring and DBCS
+//   handling and fill the attribute run in one go.
+// Arguments:
+// - text - the text to write. Must only contain characters between L' ' and L'~'.
+// - index - column in row to start writing at
+// - attr - the attribute to apply to every written cell
+// - wrap - change the wrap flag if we filled the last column of the row.
+// Return Value:
+// - the number of cells written. Text that doesn't fit in the row is dropped.
+size_t ROW::WriteAsciiRun(const std::wstring_view text, const size_t index, const TextAttribute& attr, const std::optional<bool> wrap)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto count = std::min(text.size(), _charRow.size() - index);
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    auto cell = _charRow.begin() + index;
+    for (const auto wch : text.substr(0, count))
+    {
+        *cell++ = CharRowCell{ wch, DbcsAttribute{} };
+    }
+    _unicodeStorage.EraseRange(index, index + count);
+    _ClearSplitGlyphs(index, index + count);
+
+    _attrRow.Replace(gsl::narrow_cast<uint16_t>(index), gsl::narrow_cast<uint16_t>(index + count), attr);
+
+    // NOTE: see WriteCells for the meaning of the wrap parameter.
+    if (wrap.has_value() && index + count == _charRow.size())
+    {
+        SetWrapForced(*wrap);
+    }
+
+    return count;
+}
+
+// Routine Description:
+// - writes a run of CHAR_INFOs (as given to WriteConsoleOutputW) to the row.
+// - This behaves like WriteCells with an OutputCellIterator over the CHAR_INFOs,
+//   but copies the cells directly and only builds a TextAttribute whenever the
+//   legacy attributes change between neighboring cells.
+// Arguments:
+// - charInfos - the cells to write. The lead/trailing byte flags are honored.
+// - index - column in row to start writing at
+// - wrap - change the wrap flag if we filled the last column of the row.
+// Return Value:
+// - the number of CHAR_INFOs consumed. Cells that don't fit in the row are dropped.
+size_t ROW::WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos, const size_t index, const std::optional<bool> wrap)
+{
+    THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
+
+    const auto finalColumnInRow = _charRow.size() - 1;
+
+    auto source = charInfos.begin();
+    auto column = index;
+    auto runStart = index;
+    WORD runAttr = 0;
+
+    const auto commitRun = [&]() {
+        if (column > runStart)
+        {
+            _attrRow.Replace(gsl::narrow_cast<uint16_t>(runStart), gsl::narrow_cast<uint16_t>(column), TextAttribute{ runAttr });
+        }
+    };
+
+    while (source != charInfos.end() && column <= finalColumnInRow)
+    {
+        // Don't use legacy lead/trailing byte flags for colors.
+        auto attr = source->Attributes;
+        WI_ClearAllFlags(attr, COMMON_LVB_SBCSDBCS);
+        if (column == runStart)
+        {
+            runAttr = attr;
+        }
+        else if (attr != runAttr)
+        {
+            commitRun();
+            runStart = column;
+            runAttr = attr;
+        }
+
+        DbcsAttribute dbcsAttr;
+        if (WI_IsFlagSet(source->Attributes, COMMON_LVB_LEADING_BYTE))
+        {
+            dbcsAttr.SetLeading();
+        }
+        else if (WI_IsFlagSet(source->Attributes, COMMON_LVB_TRAILING_BYTE))
+        {
+            dbcsAttr.SetTrailing();
+        }
+
+        const bool fillingLastColumn = column == finalColumnInRow;
+
+        // Pad out half glyphs at the edges of the row just like WriteCells does.
+        if (column == 0 && dbcsAttr.IsTrailing())
+        {
+            _charRow.ClearCell(column);
+        }
+        else if (fillingLastColumn && dbcsAttr.IsLeading())
+        {
+            _charRow.ClearCell(column);
+            SetDoubleBytePadded(true);
+        }
+        else
+        {
+            _charRow._cellAt(column) = CharRowCell{ source->Char.UnicodeChar, dbcsAttr };
+            ++source;
+        }
+
+        // NOTE: see WriteCells for the meaning of the wrap parameter.
+        if (wrap.has_value() && fillingLastColumn)
+        {
+            SetWrapForced(*wrap);
+        }
+
+        ++column;
+    }
+
+    commitRun();
+
+    if (column > index)
+    {
+        _unicodeStorage.EraseRange(index, column);
+        _ClearSplitGlyphs(index, column);
+    }
+
+    return gsl::narrow_cast<size_t>(source - charInfos.begin());
+}
+
+// Routine Description:
+// - reads a run of cells out of the row as CHAR_INFOs (as returned by ReadConsoleOutputW).
+// - The legacy attributes are only computed once per attribute run of the row.
+// Arguments:
+// - index - column in row to start reading at
+// - charInfos - receives charInfos.size() cells, starting at index.
+// Return Value:
+// - <none>
+void ROW::ReadCharInfos(const size_t index, const gsl::span<CHAR_INFO> charInfos) const
+{
+    THROW_HR_IF(E_INVALIDARG, index > _charRow.size() || charInfos.size() > _charRow.size() - index);
+
+    if (charInfos.empty())
+    {
+        return;
+    }
+
+    auto attrIt = _attrRow.begin();
+    attrIt += gsl::narrow_cast<ptrdiff_t>(index);
+
+    auto currentAttr = *attrIt;
+    auto currentLegacy = currentAttr.GetLegacyAttributes();
+
+    auto column = index;
+    for (auto& ci : charInfos)
+    {
+        if (*attrIt != currentAttr)
+        {
+            currentAttr = *attrIt;
+            currentLegacy = currentAttr.GetLegacyAttributes();
+        }
+
+        const auto& cell = _charRow._cellAt(column);
+        ci.Char.UnicodeChar = cell.DbcsAttr().IsGlyphStored() ? Utf16ToUcs2(_charRow.GlyphAt(column)) : cell.Char();
+        ci.Attributes = gsl::narrow_cast<WORD>(currentLegacy | cell.DbcsAttr().GeneratePublicApiAttributeFormat());
+
+        ++attrIt;
+        ++column;
+    }
+}
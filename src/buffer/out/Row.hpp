@@ -25,6 +25,7 @@ Revision History:
 #include "OutputCell.hpp"
 #include "OutputCellIterator.hpp"
 #include "CharRow.hpp"
+#include "ImageSlice.hpp"
 #include "UnicodeStorage.hpp"
 
 class TextBuffer;
@@ -32,7 +33,12 @@ class TextBuffer;
 class ROW final
 {
 public:
-    ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute fillAttribute, TextBuffer* const pParent);
+    ROW(const SHORT rowId, const gsl::span<CharRowCell> charBuffer, const TextAttribute fillAttribute, TextBuffer* const pParent);
+
+    ROW(const ROW&) = delete;
+    ROW& operator=(const ROW&) = delete;
+    ROW(ROW&&) noexcept = default;
+    ROW& operator=(ROW&&) noexcept = default;
 
     size_t size() const noexcept { return _rowWidth; }
 
@@ -49,21 +55,48 @@ public:
     ATTR_ROW& GetAttrRow() noexcept { return _attrRow; }
 
     LineRendition GetLineRendition() const noexcept { return _lineRendition; }
-    void SetLineRendition(const LineRendition lineRendition) noexcept { _lineRendition = lineRendition; }
+    void SetLineRendition(const LineRendition lineRendition) noexcept;
 
     SHORT GetId() const noexcept { return _id; }
     void SetId(const SHORT id) noexcept { _id = id; }
 
+    // The generation is handed out by the parent TextBuffer whenever this row
+    // may have been modified. See TextBuffer::GetRowGeneration.
+    uint64_t GetGeneration() const noexcept { return _generation; }
+    void SetGeneration(const uint64_t generation) noexcept { _generation = generation; }
+
+    // The parent TextBuffer counts the rows referencing each hyperlink. These
+    // are the hyperlinks it counted for this row, and whether the row may have
+    // changed since. See TextBuffer::_CountHyperlinks.
+    std::vector<uint16_t>& GetCountedHyperlinks() noexcept { return _countedHyperlinks; }
+    const std::vector<uint16_t>& GetCountedHyperlinks() const noexcept { return _countedHyperlinks; }
+    bool IsHyperlinkCountPending() const noexcept { return _hyperlinkCountPending; }
+    void SetHyperlinkCountPending(const bool pending) noexcept { _hyperlinkCountPending = pending; }
+
+    // The slice of an image drawn over this row, if there is one. It's
+    // dropped when the row is cleared, but kept when cells are written.
+    const std::shared_ptr<const ImageSlice>& GetImageSlice() const noexcept { return _imageSlice; }
+    void SetImageSlice(std::shared_ptr<const ImageSlice> imageSlice) noexcept { _imageSlice = std::move(imageSlice); }
+
     bool Reset(const TextAttribute Attr);
-    [[nodiscard]] HRESULT Resize(const unsigned short width);
+    void Clear(const TextAttribute& attr);
+    [[nodiscard]] HRESULT Resize(const gsl::span<CharRowCell> charBuffer);
 
     void ClearColumn(const size_t column);
+    void MoveCells(const size_t begin, const size_t end, const size_t destination);
+    void CopyCells(const ROW& source, const size_t begin, const size_t end, const size_t destination);
+    void FillCells(const size_t begin, const size_t end, const TextAttribute& attr);
+    void FillText(const size_t begin, const size_t end, const wchar_t wch);
+    void FillAttributes(const size_t begin, const size_t end, const TextAttribute& attr);
     std::wstring GetText() const { return _charRow.GetText(); }
 
     UnicodeStorage& GetUnicodeStorage() noexcept;
     const UnicodeStorage& GetUnicodeStorage() const noexcept;
 
     OutputCellIterator WriteCells(OutputCellIterator it, const size_t index, const std::optional<bool> wrap = std::nullopt, std::optional<size_t> limitRight = std::nullopt);
+    size_t WriteAsciiRun(const std::wstring_view text, const size_t index, const TextAttribute& attr, const std::optional<bool> wrap = std::nullopt);
+    size_t WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos, const size_t index, const std::optional<bool> wrap = std::nullopt);
+    void ReadCharInfos(const size_t index, const gsl::span<CHAR_INFO> charInfos) const;
 
 #ifdef UNIT_TESTING
     friend constexpr bool operator==(const ROW& a, const ROW& b) noexcept;
@@ -71,15 +104,23 @@ public:
 #endif
 
 private:
+    void _ClearSplitGlyphs(const size_t begin, const size_t end);
+    void _ClearCellAndGlyph(const size_t column);
+
     CharRow _charRow;
     ATTR_ROW _attrRow;
+    UnicodeStorage _unicodeStorage;
     LineRendition _lineRendition;
+    uint64_t _generation;
+    std::vector<uint16_t> _countedHyperlinks;
+    std::shared_ptr<const ImageSlice> _imageSlice;
     SHORT _id;
     unsigned short _rowWidth;
     // Occurs when the user runs out of text in a given row and we're forced to wrap the cursor to the next line
     bool _wrapForced;
     // Occurs when the user runs out of text to support a double byte character and we're forced to the next line
     bool _doubleBytePadded;
+    bool _hyperlinkCountPending;
     TextBuffer* _pParent; // non ownership pointer
 };
 
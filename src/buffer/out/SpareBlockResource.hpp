@@ -0,0 +1,97 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- SpareBlockResource.hpp
+
+Abstract:
+- A memory resource that holds on to the last blocks it was given back,
+  so that a buffer that's torn down and rebuilt at the same size
+  (like the alternate screen buffer) can reuse its storage.
+--*/
+
+#pragma once
+
+// Hands out blocks from the upstream resource. The last few blocks that are
+// deallocated are kept as spares instead, freeing the oldest spare when
+// there's no room left. An allocation of exactly a spare's size and alignment
+// gets that spare back.
+// Not thread-safe: use it under the same lock as the buffers it backs.
+class SpareBlockResource final : public std::pmr::memory_resource
+{
+public:
+    // A TextBuffer allocates two blocks: its cells and its rows.
+    static constexpr size_t MaxSpares = 2;
+
+    explicit SpareBlockResource(std::pmr::memory_resource* const upstream = til::pmr::get_default_resource()) noexcept :
+        _upstream{ upstream }
+    {
+    }
+
+    SpareBlockResource(const SpareBlockResource&) = delete;
+    SpareBlockResource& operator=(const SpareBlockResource&) = delete;
+
+    ~SpareBlockResource() override
+    {
+        Release();
+    }
+
+    // Frees all the spare blocks.
+    void Release() noexcept
+    {
+        while (_spareCount)
+        {
+            _FreeOldest();
+        }
+    }
+
+private:
+    struct Block
+    {
+        void* ptr;
+        size_t bytes;
+        size_t align;
+    };
+
+    void* do_allocate(const size_t bytes, const size_t align) override
+    {
+        for (size_t i = 0; i < _spareCount; ++i)
+        {
+            const auto block = til::at(_spares, i);
+            if (block.bytes == bytes && block.align == align)
+            {
+                std::move(_spares.begin() + i + 1, _spares.begin() + _spareCount, _spares.begin() + i);
+                --_spareCount;
+                return block.ptr;
+            }
+        }
+        return _upstream->allocate(bytes, align);
+    }
+
+    void do_deallocate(void* const ptr, const size_t bytes, const size_t align) noexcept override
+    {
+        if (_spareCount == MaxSpares)
+        {
+            _FreeOldest();
+        }
+        til::at(_spares, _spareCount++) = { ptr, bytes, align };
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    void _FreeOldest() noexcept
+    {
+        const auto block = _spares.front();
+        _upstream->deallocate(block.ptr, block.bytes, block.align);
+        std::move(_spares.begin() + 1, _spares.begin() + _spareCount, _spares.begin());
+        --_spareCount;
+    }
+
+    std::pmr::memory_resource* _upstream;
+    std::array<Block, MaxSpares> _spares{};
+    size_t _spareCount = 0;
+};
@@ -5,10 +5,23 @@
 #include "UnicodeStorage.hpp"
 
 UnicodeStorage::UnicodeStorage() noexcept :
-    _map{}
+    _glyphs{}
 {
 }
 
+// Routine Description:
+// - finds the first stored item at or after key
+// Arguments:
+// - key - the column to search for
+// Return Value:
+// - iterator to the item, or the insertion point for key if it isn't stored
+std::vector<UnicodeStorage::value_type>::const_iterator UnicodeStorage::_find(const key_type key) const noexcept
+{
+    return std::lower_bound(_glyphs.cbegin(), _glyphs.cend(), key, [](const value_type& item, const key_type key) noexcept {
+        return item.first < key;
+    });
+}
+
 // Routine Description:
 // - fetches the text associated with key
 // Arguments:
@@ -18,7 +31,9 @@ UnicodeStorage::UnicodeStorage() noexcept :
 // Note: will throw exception if key is not stored yet
 const UnicodeStorage::mapped_type& UnicodeStorage::GetText(const key_type key) const
 {
-    return _map.at(key);
+    const auto it = _find(key);
+    THROW_HR_IF(E_INVALIDARG, it == _glyphs.cend() || it->first != key);
+    return it->second;
 }
 
 // Routine Description:
@@ -28,7 +43,16 @@ const UnicodeStorage::mapped_type& UnicodeStorage::GetText(const key_type key) c
 // - glyph - the glyph data to store
 void UnicodeStorage::StoreGlyph(const key_type key, const mapped_type& glyph)
 {
-    _map.insert_or_assign(key, glyph);
+    const auto offset = _find(key) - _glyphs.cbegin();
+    const auto it = _glyphs.begin() + offset;
+    if (it != _glyphs.end() && it->first == key)
+    {
+        it->second = glyph;
+    }
+    else
+    {
+        _glyphs.emplace(it, key, glyph);
+    }
 }
 
 // Routine Description:
@@ -37,62 +61,96 @@ void UnicodeStorage::StoreGlyph(const key_type key, const mapped_type& glyph)
 // - key - the key to remove
 void UnicodeStorage::Erase(const key_type key) noexcept
 {
-    _map.erase(key);
+    const auto it = _find(key);
+    if (it != _glyphs.cend() && it->first == key)
+    {
+        _glyphs.erase(it);
+    }
 }
 
 // Routine Description:
-// - Remaps all of the stored items to new coordinate positions
-//   based on a bulk rearrangement of row IDs and potential row width resize.
+// - erases all of the stored items in the [begin, end) range of columns
 // Arguments:
-// - rowMap - A map of the old row IDs to the new row IDs.
-// - width - The width of the new row. Remove any items that are beyond the row width.
-//         - Use nullopt if we're not resizing the width of the row, just renumbering the rows.
-void UnicodeStorage::Remap(const std::unordered_map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width)
+// - begin, end - the range of columns to erase
+void UnicodeStorage::EraseRange(const key_type begin, const key_type end) noexcept
 {
-    // Make a temporary map to hold all the new row positioning
-    std::unordered_map<key_type, mapped_type> newMap;
+    _glyphs.erase(_find(begin), _find(end));
+}
 
-    // Walk through every stored item.
-    for (const auto& pair : _map)
+// Routine Description:
+// - copies the items stored for the [begin, end) range of columns over to
+//   the columns starting at destination, like memmove does. Whatever was
+//   stored for the destination columns before is erased, the items of source
+//   columns that weren't overwritten are kept.
+// Arguments:
+// - begin, end - the range of columns to copy
+// - destination - the column the item for begin is copied to
+void UnicodeStorage::Move(const key_type begin, const key_type end, const key_type destination)
+{
+    if (_glyphs.empty())
     {
-        // Extract the old coordinate position
-        const auto oldCoord = pair.first;
-
-        // Only try to short-circuit based on width if we were told it changed
-        // by being given a new width value.
-        if (width.has_value())
-        {
-            // Get the column ID
-            const auto oldColId = oldCoord.X;
+        return;
+    }
 
-            // If the column index is at/beyond the row width, don't bother copying it to the new map.
-            if (oldColId >= width.value())
-            {
-                continue;
-            }
-        }
+    Copy(*this, begin, end, destination);
+}
 
-        // Get the row ID from the position as that's what we need to remap
-        const auto oldRowId = oldCoord.Y;
+// Routine Description:
+// - copies the items source stores for the [begin, end) range of columns
+//   over to the columns of this storage starting at destination. Whatever
+//   was stored for the destination columns before is erased.
+// - source may be this storage itself. See Move.
+// Arguments:
+// - source - the storage to copy the items from
+// - begin, end - the range of columns to copy
+// - destination - the column the item for begin is copied to
+void UnicodeStorage::Copy(const UnicodeStorage& source, const key_type begin, const key_type end, const key_type destination)
+{
+    if (begin >= end)
+    {
+        return;
+    }
 
-        // Use the mapping given to convert the old row ID to the new row ID
-        const auto mapIter = rowMap.find(oldRowId);
+    std::vector<value_type> moved;
+    for (auto it = source._find(begin); it != source._glyphs.cend() && it->first < end; ++it)
+    {
+        moved.emplace_back(it->first - begin + destination, it->second);
+    }
 
-        // If there's no mapping to a new row, don't bother copying it to the new map. The row is gone.
-        if (mapIter == rowMap.end())
-        {
-            continue;
-        }
+    // Once the destination range is erased, nothing else is stored in it,
+    // so inserting the moved items in one go keeps the storage sorted.
+    EraseRange(destination, destination + (end - begin));
+    const auto offset = _find(destination) - _glyphs.cbegin();
+    _glyphs.insert(_glyphs.begin() + offset, std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end()));
+}
 
-        const auto newRowId = mapIter->second;
+// Routine Description:
+// - erases all of the stored items
+void UnicodeStorage::Clear() noexcept
+{
+    _glyphs.clear();
+}
 
-        // Generate a new coordinate with the same X as the old one, but a new Y value.
-        const auto newCoord = COORD{ oldCoord.X, newRowId };
+// Routine Description:
+// - erases all of the stored items at or beyond the given column,
+//   for when the row is resized to be narrower.
+// Arguments:
+// - width - The new width of the row.
+void UnicodeStorage::Truncate(const key_type width) noexcept
+{
+    _glyphs.erase(_find(width), _glyphs.cend());
+}
 
-        // Put the adjusted coordinate into the map with the original value.
-        newMap.emplace(newCoord, pair.second);
+// Routine Description:
+// - Returns the memory the stored glyphs allocated on the heap.
+// Return Value:
+// - The size of the heap allocations, in bytes.
+size_t UnicodeStorage::MemoryUsage() const noexcept
+{
+    auto usage = _glyphs.capacity() * sizeof(value_type);
+    for (const auto& glyph : _glyphs)
+    {
+        usage += glyph.second.capacity() * sizeof(wchar_t);
     }
-
-    // Swap into the stored map, free the temporary when we exit.
-    _map.swap(newMap);
+    return usage;
 }
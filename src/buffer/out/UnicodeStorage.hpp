@@ -15,36 +15,14 @@ Author(s):
 #pragma once
 
 #include <vector>
-#include <unordered_map>
-#include <climits>
-
-// std::unordered_map needs help to know how to hash a COORD
-namespace std
-{
-    template<>
-    struct hash<COORD>
-    {
-        // Routine Description:
-        // - hashes a coord. coord will be hashed by storing the x and y values consecutively in the lower
-        // bits of a size_t.
-        // Arguments:
-        // - coord - the coord to hash
-        // Return Value:
-        // - the hashed coord
-        constexpr size_t operator()(const COORD& coord) const noexcept
-        {
-            size_t retVal = coord.Y;
-            const size_t xCoord = coord.X;
-            retVal |= xCoord << (sizeof(coord.Y) * CHAR_BIT);
-            return retVal;
-        }
-    };
-}
 
+// Stores the glyphs of a single ROW that don't fit into a cell, keyed by column.
+// Every ROW owns its storage, so it moves along with the row when the buffer
+// scrolls and never has to be re-keyed.
 class UnicodeStorage final
 {
 public:
-    using key_type = typename COORD;
+    using key_type = typename size_t;
     using mapped_type = typename std::vector<wchar_t>;
 
     UnicodeStorage() noexcept;
@@ -55,10 +33,25 @@ public:
 
     void Erase(const key_type key) noexcept;
 
-    void Remap(const std::unordered_map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width);
+    void EraseRange(const key_type begin, const key_type end) noexcept;
+
+    void Move(const key_type begin, const key_type end, const key_type destination);
+
+    void Copy(const UnicodeStorage& source, const key_type begin, const key_type end, const key_type destination);
+
+    void Clear() noexcept;
+
+    void Truncate(const key_type width) noexcept;
+
+    size_t MemoryUsage() const noexcept;
 
 private:
-    std::unordered_map<key_type, mapped_type> _map;
+    // Sorted by column. A row rarely holds more than a few of these glyphs,
+    // so a flat vector is both smaller and faster than a hash map.
+    using value_type = std::pair<key_type, mapped_type>;
+    std::vector<value_type> _glyphs;
+
+    std::vector<value_type>::const_iterator _find(const key_type key) const noexcept;
 
 #ifdef UNIT_TESTING
     friend class UnicodeStorageTests;
@@ -22,13 +22,17 @@ using namespace Microsoft::Console::Types;
 // - str - The search term you want to find (the "needle")
 // - direction - The direction to search (upward or downward)
 // - sensitivity - Whether or not you care about case
+// - syntax - Whether str is plain text or a regular expression
+// - NOTE: Throws E_INVALIDARG if str isn't a valid regular expression.
 Search::Search(IUiaData& uiaData,
                const std::wstring& str,
                const Direction direction,
-               const Sensitivity sensitivity) :
+               const Sensitivity sensitivity,
+               const Syntax syntax) :
     _direction(direction),
     _sensitivity(sensitivity),
-    _needle(s_CreateNeedleFromString(str)),
+    _needle(s_CreateNeedleFromString(str, sensitivity)),
+    _regex(s_CreateRegex(str, sensitivity, syntax)),
     _uiaData(uiaData),
     _coordAnchor(s_GetInitialAnchor(uiaData, direction))
 {
@@ -46,14 +50,18 @@ Search::Search(IUiaData& uiaData,
 // - direction - The direction to search (upward or downward)
 // - sensitivity - Whether or not you care about case
 // - anchor - starting search location in screenInfo
+// - syntax - Whether str is plain text or a regular expression
+// - NOTE: Throws E_INVALIDARG if str isn't a valid regular expression.
 Search::Search(IUiaData& uiaData,
                const std::wstring& str,
                const Direction direction,
                const Sensitivity sensitivity,
-               const COORD anchor) :
+               const COORD anchor,
+               const Syntax syntax) :
     _direction(direction),
     _sensitivity(sensitivity),
-    _needle(s_CreateNeedleFromString(str)),
+    _needle(s_CreateNeedleFromString(str, sensitivity)),
+    _regex(s_CreateRegex(str, sensitivity, syntax)),
     _coordAnchor(anchor),
     _uiaData(uiaData)
 {
@@ -93,6 +101,46 @@ bool Search::FindNext()
     return false;
 }
 
+// Routine Description
+// - Locates every instance of the search term that starts within the given rows.
+// - This ignores the direction and anchor of the search and doesn't affect
+//   what FindNext will find next.
+// - Callers that search a large buffer can call this in batches of rows and
+//   release the buffer's lock in between.
+// Arguments:
+// - firstRow - The first row to search
+// - lastRow - The last row to search (inclusive). Matches that start on this
+//   row may continue onto the following rows.
+// Return Value:
+// - The [start, end] positions of every match, in buffer order.
+std::vector<std::pair<COORD, COORD>> Search::FindAll(const SHORT firstRow, const SHORT lastRow) const
+{
+    std::vector<std::pair<COORD, COORD>> results;
+
+    const auto bufferEndPosition = _uiaData.GetTextBufferEndPosition();
+    const auto width = _uiaData.GetTextBuffer().GetSize().Width();
+    const auto endRow = std::min(lastRow, bufferEndPosition.Y);
+
+    for (SHORT y = firstRow; y <= endRow; ++y)
+    {
+        const auto endColumn = y == bufferEndPosition.Y ? bufferEndPosition.X + 1 : width;
+        for (SHORT x = 0; x < endColumn; ++x)
+        {
+            COORD start;
+            COORD end;
+            // A match that wraps around from the bottom of the circular
+            // buffer back to the top isn't a real match.
+            if (_FindNeedleInHaystackAt({ x, y }, start, end) &&
+                (end.Y > start.Y || (end.Y == start.Y && end.X >= start.X)))
+            {
+                results.emplace_back(start, end);
+            }
+        }
+    }
+
+    return results;
+}
+
 // Routine Description:
 // - Takes the found word and selects it in the screen buffer
 void Search::Select() const
@@ -192,13 +240,22 @@ bool Search::_FindNeedleInHaystackAt(const COORD pos, COORD& start, COORD& end)
     start = { 0 };
     end = { 0 };
 
+    if (_regex)
+    {
+        return _FindRegexMatchAt(pos, start, end);
+    }
+
+    const auto& textBuffer = _uiaData.GetTextBuffer();
     COORD bufferPos = pos;
 
     for (const auto& needleCell : _needle)
     {
         // Haystack is the buffer. Needle is the string we were given.
-        const auto hayIter = _uiaData.GetTextBuffer().GetTextDataAt(bufferPos);
-        const auto hayChars = *hayIter;
+        // The glyph is read straight out of its row. Constructing a
+        // TextBufferTextIterator for every cell we compare made searching
+        // a large scrollback noticeably slow, since this runs at every
+        // position of the buffer.
+        const std::wstring_view hayChars = textBuffer.GetRowByOffset(bufferPos.Y).GetCharRow().GlyphAt(bufferPos.X);
         const auto needleChars = std::wstring_view(needleCell.data(), needleCell.size());
 
         // If we didn't match at any point of the needle, return false.
@@ -220,12 +277,115 @@ bool Search::_FindNeedleInHaystackAt(const COORD pos, COORD& start, COORD& end)
     return true;
 }
 
+// Routine Description:
+// - Checks whether a match of the regular expression starts at the given
+//   position of the screen buffer.
+// - The matches are found a line at a time, in one linear pass of the
+//   regex over the text of the line, and are then looked up for every
+//   position of it. The buffer must thus not change while we're searching.
+// Arguments:
+// - pos - The position in the screen buffer to check
+// - start - If we found it, this is filled with the coordinate of the first cell of the match.
+// - end - If we found it, this is filled with the coordinate of the last cell of the match.
+// Return Value:
+// - True if we found it. False if not.
+bool Search::_FindRegexMatchAt(const COORD pos, COORD& start, COORD& end) const
+{
+    _UpdateRegexLine(pos.Y);
+
+    const auto& matches = _regexLine.matches;
+    const auto it = std::lower_bound(matches.begin(), matches.end(), pos, [](const auto& match, const COORD& coord) {
+        return match.first.Y < coord.Y || (match.first.Y == coord.Y && match.first.X < coord.X);
+    });
+    if (it == matches.end() || it->first != pos)
+    {
+        return false;
+    }
+
+    start = it->first;
+    end = it->second;
+    return true;
+}
+
+// Routine Description:
+// - Makes _regexLine hold the line that the given row is part of, and all
+//   the matches of the regular expression in it.
+// Arguments:
+// - row - The row of the screen buffer that we're searching
+// Return Value:
+// - <none>
+void Search::_UpdateRegexLine(const SHORT row) const
+{
+    if (row >= _regexLine.firstRow && row <= _regexLine.lastRow)
+    {
+        return;
+    }
+
+    const auto& textBuffer = _uiaData.GetTextBuffer();
+    const auto rowCount = gsl::narrow_cast<SHORT>(textBuffer.TotalRowCount());
+
+    auto firstRow = row;
+    while (firstRow > 0 && textBuffer.GetRowByOffset(firstRow - 1).WasWrapForced())
+    {
+        --firstRow;
+    }
+    auto lastRow = row;
+    while (lastRow + 1 < rowCount && textBuffer.GetRowByOffset(lastRow).WasWrapForced())
+    {
+        ++lastRow;
+    }
+
+    auto& line = _regexLine;
+    line.firstRow = firstRow;
+    line.lastRow = lastRow;
+    line.text.clear();
+    line.cells.clear();
+    line.matches.clear();
+
+    for (auto y = firstRow; y <= lastRow; ++y)
+    {
+        const auto& charRow = textBuffer.GetRowByOffset(y).GetCharRow();
+        // The spaces that pad the end of the line aren't part of its text.
+        // Otherwise "$" could never match right after the last word.
+        const auto width = y == lastRow ? charRow.MeasureRight() : charRow.size();
+        for (size_t x = 0; x < width; ++x)
+        {
+            const auto dbcsAttr = charRow.DbcsAttrAt(x);
+            if (dbcsAttr.IsTrailing())
+            {
+                continue;
+            }
+
+            const std::wstring_view glyph = charRow.GlyphAt(x);
+            const COORD firstCell{ gsl::narrow_cast<SHORT>(x), y };
+            const COORD lastCell{ gsl::narrow_cast<SHORT>(dbcsAttr.IsLeading() ? std::min(x + 1, charRow.size() - 1) : x), y };
+            line.text.append(glyph);
+            line.cells.insert(line.cells.end(), glyph.size(), { firstCell, lastCell });
+        }
+    }
+
+    size_t offset = 0;
+    while (const auto match = _regex->Find(line.text, offset))
+    {
+        const auto [begin, matchEnd] = *match;
+        if (begin == matchEnd)
+        {
+            // An empty match covers no cells, so there's nothing to find.
+            offset = matchEnd + 1;
+            continue;
+        }
+        line.matches.emplace_back(line.cells.at(begin).first, line.cells.at(matchEnd - 1).second);
+        offset = matchEnd;
+    }
+}
+
 // Routine Description:
 // - Provides an abstraction for comparing two spans of text.
 // - Internally handles case sensitivity based on object construction.
 // Arguments:
-// - one - String view representing the first string of text
-// - two - String view representing the second string of text
+// - one - String view representing the text from the buffer
+// - two - String view representing the text from the needle. The needle had
+//   the case sensitivity applied when it was created.
 // Return Value:
 // - True if they are the same. False otherwise.
 bool Search::_CompareChars(const std::wstring_view one, const std::wstring_view two) const noexcept
@@ -237,7 +397,7 @@ bool Search::_CompareChars(const std::wstring_view one, const std::wstring_view
 
     for (size_t i = 0; i < one.size(); i++)
     {
-        if (_ApplySensitivity(one.at(i)) != _ApplySensitivity(two.at(i)))
+        if (_ApplySensitivity(one.at(i)) != two.at(i))
         {
             return false;
         }
@@ -328,14 +488,21 @@ void Search::_UpdateNextPosition()
 //   that we can use for our search
 // Arguments:
 // - wstr - String that will be our search term
+// - sensitivity - Whether or not to fold the needle to lower case, so that
+//   only the haystack needs to be folded while comparing
 // Return Value:
 // - Structured text data for comparison to screen buffer text data.
-std::vector<std::vector<wchar_t>> Search::s_CreateNeedleFromString(const std::wstring& wstr)
+std::vector<std::vector<wchar_t>> Search::s_CreateNeedleFromString(const std::wstring& wstr, const Sensitivity sensitivity)
 {
     const auto charData = Utf16Parser::Parse(wstr);
     std::vector<std::vector<wchar_t>> cells;
-    for (const auto chars : charData)
+    for (auto chars : charData)
     {
+        if (sensitivity == Sensitivity::CaseInsensitive)
+        {
+            std::transform(chars.begin(), chars.end(), chars.begin(), ::towlower);
+        }
+
         if (IsGlyphFullWidth(std::wstring_view{ chars.data(), chars.size() }))
         {
             cells.emplace_back(chars);
@@ -344,3 +511,20 @@ std::vector<std::vector<wchar_t>> Search::s_CreateNeedleFromString(const std::ws
     }
     return cells;
 }
+
+// Routine Description:
+// - Compiles the search term into a regular expression, if it is one.
+// Arguments:
+// - wstr - String that will be our search term
+// - sensitivity - Whether or not the regex ignores case
+// - syntax - Whether wstr is a regular expression at all
+// Return Value:
+// - The compiled regex, or nothing for plain text searches.
+std::optional<LinearRegex> Search::s_CreateRegex(const std::wstring& wstr, const Sensitivity sensitivity, const Syntax syntax)
+{
+    if (syntax != Syntax::RegularExpression)
+    {
+        return std::nullopt;
+    }
+    return std::optional<LinearRegex>{ std::in_place, wstr, sensitivity == Sensitivity::CaseInsensitive };
+}
@@ -21,6 +21,7 @@ Revision History:
 #include "TextAttribute.hpp"
 #include "textBuffer.hpp"
 #include "../types/IUiaData.h"
+#include "../types/inc/LinearRegex.hpp"
 
 // This used to be in find.h.
 #define SEARCH_STRING_LENGTH (80)
@@ -40,18 +41,27 @@ public:
         CaseSensitive
     };
 
+    enum class Syntax
+    {
+        Literal,
+        RegularExpression
+    };
+
     Search(Microsoft::Console::Types::IUiaData& uiaData,
            const std::wstring& str,
            const Direction dir,
-           const Sensitivity sensitivity);
+           const Sensitivity sensitivity,
+           const Syntax syntax = Syntax::Literal);
 
     Search(Microsoft::Console::Types::IUiaData& uiaData,
            const std::wstring& str,
            const Direction dir,
            const Sensitivity sensitivity,
-           const COORD anchor);
+           const COORD anchor,
+           const Syntax syntax = Syntax::Literal);
 
     bool FindNext();
+    std::vector<std::pair<COORD, COORD>> FindAll(const SHORT firstRow, const SHORT lastRow) const;
     void Select() const;
     void Color(const TextAttribute attr) const;
 
@@ -60,6 +70,8 @@ public:
 private:
     wchar_t _ApplySensitivity(const wchar_t wch) const noexcept;
     bool _FindNeedleInHaystackAt(const COORD pos, COORD& start, COORD& end) const;
+    bool _FindRegexMatchAt(const COORD pos, COORD& start, COORD& end) const;
+    void _UpdateRegexLine(const SHORT row) const;
     bool _CompareChars(const std::wstring_view one, const std::wstring_view two) const noexcept;
     void _UpdateNextPosition();
 
@@ -68,7 +80,22 @@ private:
 
     static COORD s_GetInitialAnchor(Microsoft::Console::Types::IUiaData& uiaData, const Direction dir);
 
-    static std::vector<std::vector<wchar_t>> s_CreateNeedleFromString(const std::wstring& wstr);
+    static std::vector<std::vector<wchar_t>> s_CreateNeedleFromString(const std::wstring& wstr, const Sensitivity sensitivity);
+    static std::optional<Microsoft::Console::Types::LinearRegex> s_CreateRegex(const std::wstring& wstr, const Sensitivity sensitivity, const Syntax syntax);
+
+    // The text of the line that regular expressions were last matched
+    // against, and the matches in it. A line is all the rows that wrapped
+    // into each other, so that a match can continue on the next row.
+    struct RegexLine
+    {
+        SHORT firstRow = -1;
+        SHORT lastRow = -1;
+        std::wstring text;
+        // The first and the last cell of the glyph of every code unit of text.
+        std::vector<std::pair<COORD, COORD>> cells;
+        // The [start, end] cells of every match, in order.
+        std::vector<std::pair<COORD, COORD>> matches;
+    };
 
     bool _reachedEnd = false;
     COORD _coordNext = { 0 };
@@ -79,8 +106,11 @@ private:
     const std::vector<std::vector<wchar_t>> _needle;
     const Direction _direction;
     const Sensitivity _sensitivity;
+    const std::optional<Microsoft::Console::Types::LinearRegex> _regex;
     Microsoft::Console::Types::IUiaData& _uiaData;
 
+    mutable RegexLine _regexLine;
+
 #ifdef UNIT_TESTING
     friend class SearchTests;
 #endif
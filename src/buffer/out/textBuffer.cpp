@@ -24,31 +24,134 @@ using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 // - screenBufferSize - The X by Y dimensions of the new screen buffer
 // - fill - Uses the .Attributes property to decide which default color to apply to all text in this buffer
 // - cursorSize - The height of the cursor within this buffer
+// - storageResource - Where the rows and their cells get allocated from
 // Return Value:
 // - constructed object
 // Note: may throw exception
 TextBuffer::TextBuffer(const COORD screenBufferSize,
                        const TextAttribute defaultAttributes,
                        const UINT cursorSize,
-                       Microsoft::Console::Render::IRenderTarget& renderTarget) :
+                       Microsoft::Console::Render::IRenderTarget& renderTarget,
+                       std::pmr::memory_resource* const storageResource) :
     _firstRow{ 0 },
+    _lineRenditionRowCount{ 0 },
+    _circledRowCount{ 0 },
+    _lastRowGeneration{ _NextRowGenerationBase() },
+    _delimiterClassCache{},
+    _delimiterClassCacheDelimiters{},
+    _delimiterClassCacheNext{ 0 },
     _currentAttributes{ defaultAttributes },
     _cursor{ cursorSize, *this },
-    _storage{},
-    _unicodeStorage{},
+    _charBuffer{ _AllocateCharBuffer(screenBufferSize, storageResource) },
+    _storage{ storageResource },
+    _blankRowCells(gsl::narrow<size_t>(std::max<SHORT>(screenBufferSize.X, 0)), storageResource),
+    _blankRowAttributes{ defaultAttributes },
+    _blankRow{ 0, _blankRowCells, defaultAttributes, this },
     _renderTarget{ renderTarget },
     _size{},
     _currentHyperlinkId{ 1 },
     _currentPatternId{ 0 }
 {
-    // initialize ROWs
-    _storage.reserve(static_cast<size_t>(screenBufferSize.Y));
-    for (size_t i = 0; i < static_cast<size_t>(screenBufferSize.Y); ++i)
+    // The rows themselves are created as they're first written to. Reserving
+    // room for them costs next to nothing until then, and it guarantees that
+    // creating a row never moves the others.
+    _storage.reserve(static_cast<size_t>(std::max<SHORT>(screenBufferSize.Y, 0)));
+
+    // The rows that haven't been created yet are read as _blankRow, so it
+    // needs a generation of this buffer's own, like every other row.
+    _blankRow.SetGeneration(++_lastRowGeneration);
+
+    _UpdateSize(screenBufferSize);
+}
+
+// Routine Description:
+// - Allocates the cell storage for all rows of a buffer of the given size.
+// - The storage is empty, it only has the capacity for every cell. It grows
+//   (initializing the cells to their default (space) state) as rows are
+//   created, see _AllocateRows.
+// Arguments:
+// - size - The X by Y dimensions of the buffer
+// - resource - Where to allocate the storage from
+// Return Value:
+// - The storage, with a capacity of size.X * size.Y cells.
+// Note: may throw exception
+std::pmr::vector<CharRowCell> TextBuffer::_AllocateCharBuffer(const COORD size, std::pmr::memory_resource* const resource)
+{
+    const auto width = gsl::narrow<size_t>(std::max<SHORT>(size.X, 0));
+    const auto height = gsl::narrow<size_t>(std::max<SHORT>(size.Y, 0));
+    std::pmr::vector<CharRowCell> charBuffer{ resource };
+    charBuffer.reserve(width * height);
+    return charBuffer;
+}
+
+// Routine Description:
+// - Returns the slice of the cell storage that belongs to the index-th row of the
+//   storage vector, given the width of a row.
+// Arguments:
+// - index - The index of the row within _storage
+// - width - The width of every row in the buffer
+// Return Value:
+// - The slice of _charBuffer for that row.
+gsl::span<CharRowCell> TextBuffer::_GetCharBufferSlice(const size_t index, const size_t width) noexcept
+{
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead. We're creating the span.
+    return { _charBuffer.data() + index * width, width };
+}
+
+// Routine Description:
+// - Creates the rows of the storage up to the given count, if they haven't
+//   been created yet. A new row looks exactly like _blankRow, which is what
+//   readers have been seeing in its place so far, down to its generation.
+// Arguments:
+// - count - The number of rows the storage should have at least
+// Return Value:
+// - <none>
+// Note: may throw exception
+void TextBuffer::_AllocateRows(const size_t count)
+{
+    const auto target = std::min<size_t>(count, TotalRowCount());
+    if (_storage.size() >= target)
+    {
+        return;
+    }
+
+    // Neither of these reallocates. See the comment on _charBuffer.
+    const auto width = _blankRow.size();
+    _charBuffer.resize(target * width);
+    while (_storage.size() < target)
     {
-        _storage.emplace_back(static_cast<SHORT>(i), screenBufferSize.X, _currentAttributes, this);
+        const auto index = _storage.size();
+        auto& row = _storage.emplace_back(gsl::narrow_cast<SHORT>(index), _GetCharBufferSlice(index, width), _blankRowAttributes, this);
+        row.SetGeneration(_blankRow.GetGeneration());
     }
+}
 
-    _UpdateSize();
+// Routine Description:
+// - Returns whether the row at the given offset from the first row of the
+//   buffer has been created. Rows that haven't been are read as _blankRow.
+// Arguments:
+// - index - Number of rows down from the first row of the buffer.
+// Return Value:
+// - true if the row exists in the storage.
+bool TextBuffer::_IsRowCreated(const size_t index) const noexcept
+{
+    const size_t totalRows = TotalRowCount();
+    return totalRows != 0 && (_firstRow + index) % totalRows < _storage.size();
+}
+
+// Routine Description:
+// - Changes the attributes of the rows that haven't been created yet.
+// - _blankRow gets a new generation, so that anyone who kept the generation of
+//   one of these rows knows that it may have changed.
+// Arguments:
+// - attr - The attribute to fill the rows with
+// Return Value:
+// - <none>
+void TextBuffer::_SetBlankRowAttributes(const TextAttribute& attr)
+{
+    _blankRowAttributes = attr;
+    _blankRow.Reset(attr);
+    _blankRow.SetGeneration(++_lastRowGeneration);
 }
 
 // Routine Description:
@@ -71,7 +174,7 @@ void TextBuffer::CopyProperties(const TextBuffer& OtherBuffer) noexcept
 // - Total number of rows in the buffer
 UINT TextBuffer::TotalRowCount() const noexcept
 {
-    return gsl::narrow<UINT>(_storage.size());
+    return gsl::narrow_cast<UINT>(_size.Height());
 }
 
 // Routine Description:
@@ -87,12 +190,19 @@ const ROW& TextBuffer::GetRowByOffset(const size_t index) const
 
     // Rows are stored circularly, so the index you ask for is offset by the start position and mod the total of rows.
     const size_t offsetIndex = (_firstRow + index) % totalRows;
+
+    // Rows that haven't been created yet all look the same.
+    if (offsetIndex >= _storage.size())
+    {
+        return _blankRow;
+    }
     return _storage.at(offsetIndex);
 }
 
 // Routine Description:
 // - Retrieves a row from the buffer by its offset from the first row of the text buffer (what corresponds to
 // the top row of the screen buffer)
+// - The caller is assumed to modify the row, so it's assigned a new generation.
 // Arguments:
 // - Number of rows down from the first row of the buffer.
 // Return Value:
@@ -103,7 +213,118 @@ ROW& TextBuffer::GetRowByOffset(const size_t index)
 
     // Rows are stored circularly, so the index you ask for is offset by the start position and mod the total of rows.
     const size_t offsetIndex = (_firstRow + index) % totalRows;
-    return _storage.at(offsetIndex);
+    _AllocateRows(offsetIndex + 1);
+    auto& row = _storage.at(offsetIndex);
+    _TouchRow(row);
+    return row;
+}
+
+// Routine Description:
+// - Retrieves the generation of a row by its offset from the first row of the text buffer.
+// - The generation changes whenever the row may have been modified and it's
+//   unique across all rows. If the row at a given offset has the same
+//   generation as the last time you looked, it's still the same row, with the
+//   same contents, even if rows have been scrolled or rotated in the meantime.
+// Arguments:
+// - index - Number of rows down from the first row of the buffer.
+// Return Value:
+// - The row's generation.
+uint64_t TextBuffer::GetRowGeneration(const size_t index) const
+{
+    return GetRowByOffset(index).GetGeneration();
+}
+
+// Routine Description:
+// - Hands out the generation a new buffer starts counting from. Every buffer
+//   gets a range of 2^40 generations of its own, so that a generation kept
+//   from one buffer can't be mistaken for one of another, like the alt buffer
+//   or the buffer that replaces this one on a resize.
+// Arguments:
+// - <none>
+// Return Value:
+// - The generation to start counting from.
+uint64_t TextBuffer::_NextRowGenerationBase() noexcept
+{
+    static std::atomic<uint64_t> lastBuffer{ 0 };
+    return (lastBuffer.fetch_add(1, std::memory_order_relaxed) + 1) << 40;
+}
+
+// Routine Description:
+// - Retrieves the generations of generations.size() consecutive rows,
+//   starting at firstRow. See GetRowGeneration.
+// Arguments:
+// - firstRow - Number of rows down from the first row of the buffer.
+// - generations - Receives the generation of each row.
+// Return Value:
+// - <none>
+void TextBuffer::SnapshotRowGenerations(const size_t firstRow, const gsl::span<uint64_t> generations) const
+{
+    auto index = firstRow;
+    for (auto& generation : generations)
+    {
+        generation = GetRowByOffset(index++).GetGeneration();
+    }
+}
+
+// Routine Description:
+// - Appends the contents of every row that changed since the given snapshot
+//   of generations was taken to frame, and updates the snapshot to match.
+//   For each of those rows, that's an ExportedRowHeader followed by its cells
+//   as CHAR_INFOs, like ReadCharInfos returns them.
+// - Callers like test harnesses can keep the snapshot and a copy of the
+//   screen, and apply each frame to it, instead of reading back the entire
+//   screen every time. The snapshot is only meaningful for this buffer: a
+//   resize replaces the buffer, and should be followed by a full export.
+// Arguments:
+// - firstRow - Number of rows down from the first row of the buffer.
+// - generations - The generations of generations.size() consecutive rows,
+//   starting at firstRow, from SnapshotRowGenerations or a previous call.
+//   Fill it with UnknownRowGeneration to export all of these rows.
+// - frame - Receives the changed rows.
+// Return Value:
+// - <none>
+void TextBuffer::ExportChangedRows(const size_t firstRow, const gsl::span<uint64_t> generations, std::vector<std::byte>& frame) const
+{
+    const auto width = gsl::narrow_cast<size_t>(GetSize().Width());
+    const auto rowBytes = sizeof(ExportedRowHeader) + width * sizeof(CHAR_INFO);
+
+    auto index = firstRow;
+    for (auto& generation : generations)
+    {
+        const auto& row = GetRowByOffset(index);
+        if (row.GetGeneration() != generation)
+        {
+            generation = row.GetGeneration();
+
+            const ExportedRowHeader header{ gsl::narrow_cast<uint16_t>(index), gsl::narrow_cast<uint16_t>(width) };
+            const auto offset = frame.size();
+            frame.resize(offset + rowBytes);
+
+            const auto data = frame.data() + offset;
+            memcpy(data, &header, sizeof(header));
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast. The frame is just bytes.
+            row.ReadCharInfos(0, { reinterpret_cast<CHAR_INFO*>(data + sizeof(header)), width });
+        }
+        ++index;
+    }
+}
+
+// Routine Description:
+// - Assigns a new generation to the given row, marking it as (possibly) modified.
+// - Its hyperlinks are counted again before they're needed next.
+// Arguments:
+// - row - The row to mark.
+// Return Value:
+// - <none>
+void TextBuffer::_TouchRow(ROW& row)
+{
+    row.SetGeneration(++_lastRowGeneration);
+
+    if (!row.IsHyperlinkCountPending())
+    {
+        _hyperlinkCountPendingRows.emplace_back(gsl::narrow_cast<size_t>(row.GetId()));
+        row.SetHyperlinkCountPending(true);
+    }
 }
 
 // Routine Description:
@@ -391,6 +612,382 @@ OutputCellIterator TextBuffer::WriteLine(const OutputCellIterator givenIt,
     return newIt;
 }
 
+// Routine Description:
+// - Writes a run of printable ASCII text to one line of the output buffer.
+// - This is a faster WriteLine for text that is known to contain no control
+//   characters and no wide glyphs. See ROW::WriteAsciiRun.
+// Arguments:
+// - text - The text to write. Must only contain characters between L' ' and L'~'.
+// - target - Coordinate targeted within output buffer
+// - attr - The attribute to apply to every written cell
+// - wrap - change the wrap flag if we filled the last column of the row.
+// Return Value:
+// - The number of cells written. Text that doesn't fit in the row is dropped.
+size_t TextBuffer::WriteAsciiRun(const std::wstring_view text,
+                                 const COORD target,
+                                 const TextAttribute& attr,
+                                 const std::optional<bool> wrap)
+{
+    // If we're not in bounds, exit early.
+    if (!GetSize().IsInBounds(target))
+    {
+        return 0;
+    }
+
+    ROW& row = GetRowByOffset(target.Y);
+    const auto written = row.WriteAsciiRun(text, target.X, attr, wrap);
+
+    if (written != 0)
+    {
+        const Viewport paint = Viewport::FromDimensions(target, { gsl::narrow<SHORT>(written), 1 });
+        _NotifyPaint(paint);
+    }
+
+    return written;
+}
+
+// Routine Description:
+// - Writes CHAR_INFOs to one line of the output buffer. See ROW::WriteCharInfos.
+// Arguments:
+// - charInfos - The cells to write
+// - target - Coordinate targeted within output buffer
+// - wrap - change the wrap flag if we filled the last column of the row.
+// Return Value:
+// - The number of CHAR_INFOs consumed. Cells that don't fit in the row are dropped.
+size_t TextBuffer::WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos,
+                                  const COORD target,
+                                  const std::optional<bool> wrap)
+{
+    // If we're not in bounds, exit early.
+    if (!GetSize().IsInBounds(target) || charInfos.empty())
+    {
+        return 0;
+    }
+
+    ROW& row = GetRowByOffset(target.Y);
+    const auto consumed = row.WriteCharInfos(charInfos, target.X, wrap);
+
+    // We always touch as many cells as we were given, clipped to the row.
+    const auto written = std::min<size_t>(charInfos.size(), row.size() - target.X);
+    const Viewport paint = Viewport::FromDimensions(target, { gsl::narrow<SHORT>(written), 1 });
+    _NotifyPaint(paint);
+
+    return consumed;
+}
+
+// Routine Description:
+// - Reads charInfos.size() cells of one line of the output buffer as CHAR_INFOs.
+//   See ROW::ReadCharInfos.
+// Arguments:
+// - origin - Coordinate of the first cell to read
+// - charInfos - Receives the cells
+// Return Value:
+// - <none>
+void TextBuffer::ReadCharInfos(const COORD origin, const gsl::span<CHAR_INFO> charInfos) const
+{
+    THROW_HR_IF(E_INVALIDARG, !GetSize().IsInBounds(origin));
+    GetRowByOffset(origin.Y).ReadCharInfos(origin.X, charInfos);
+}
+
+// Routine Description:
+// - Copies count cells of one line of the output buffer to another column of
+//   the same line, like memmove does. See ROW::MoveCells.
+// Arguments:
+// - source - Coordinate of the first cell to copy
+// - count - The number of cells to copy. Clipped to the row.
+// - destinationX - The column the first cell is copied to
+// Return Value:
+// - <none>
+void TextBuffer::MoveCells(const COORD source, const size_t count, const SHORT destinationX)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    THROW_HR_IF(E_INVALIDARG, !GetSize().IsInBounds(source) || !GetSize().IsInBounds({ destinationX, source.Y }));
+
+    ROW& row = GetRowByOffset(source.Y);
+    const size_t width = row.size();
+    const size_t begin = source.X;
+    const size_t destination = destinationX;
+    const auto clipped = std::min({ count, width - begin, width - destination });
+    if (clipped == 0)
+    {
+        return;
+    }
+
+    row.MoveCells(begin, begin + clipped, destination);
+
+    // Wide glyphs cut in half on either side of the destination have been cleared, too.
+    const auto left = destination > 0 ? destination - 1 : destination;
+    const auto right = std::min(destination + clipped + 1, width);
+    _NotifyPaint(Viewport::FromDimensions({ gsl::narrow_cast<SHORT>(left), source.Y }, { gsl::narrow_cast<SHORT>(right - left), 1 }));
+}
+
+// Routine Description:
+// - Copies count cells of one line of the output buffer to another line, in
+//   one block per line. See ROW::CopyCells.
+// Arguments:
+// - source - Coordinate of the first cell to copy
+// - count - The number of cells to copy. Clipped to the row.
+// - destination - Coordinate the first cell is copied to
+// Return Value:
+// - <none>
+void TextBuffer::CopyCells(const COORD source, const size_t count, const COORD destination)
+{
+    if (source.Y == destination.Y)
+    {
+        MoveCells(source, count, destination.X);
+        return;
+    }
+    if (count == 0)
+    {
+        return;
+    }
+    THROW_HR_IF(E_INVALIDARG, !GetSize().IsInBounds(source) || !GetSize().IsInBounds(destination));
+
+    // Get the target first: it may have to be allocated, which must
+    // not happen while we're holding on to the source.
+    ROW& targetRow = GetRowByOffset(destination.Y);
+    const ROW& sourceRow = std::as_const(*this).GetRowByOffset(source.Y);
+    const size_t width = targetRow.size();
+    const size_t begin = source.X;
+    const size_t target = destination.X;
+    const auto clipped = std::min({ count, width - begin, width - target });
+    if (clipped == 0)
+    {
+        return;
+    }
+
+    targetRow.CopyCells(sourceRow, begin, begin + clipped, target);
+
+    // Wide glyphs cut in half on either side of the destination have been cleared, too.
+    const auto left = target > 0 ? target - 1 : target;
+    const auto right = std::min(target + clipped + 1, width);
+    _NotifyPaint(Viewport::FromDimensions({ gsl::narrow_cast<SHORT>(left), destination.Y }, { gsl::narrow_cast<SHORT>(right - left), 1 }));
+}
+
+// Routine Description:
+// - Fills count cells of one line of the output buffer with spaces. See ROW::FillCells.
+// Arguments:
+// - target - Coordinate of the first cell to fill
+// - count - The number of cells to fill. Clipped to the row.
+// - attr - The attribute to fill the cells with
+// Return Value:
+// - <none>
+void TextBuffer::FillCells(const COORD target, const size_t count, const TextAttribute& attr)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    THROW_HR_IF(E_INVALIDARG, !GetSize().IsInBounds(target));
+
+    ROW& row = GetRowByOffset(target.Y);
+    const size_t width = row.size();
+    const size_t begin = target.X;
+    const auto clipped = std::min(count, width - begin);
+    if (clipped == 0)
+    {
+        return;
+    }
+
+    row.FillCells(begin, begin + clipped, attr);
+
+    const auto left = begin > 0 ? begin - 1 : begin;
+    const auto right = std::min(begin + clipped + 1, width);
+    _NotifyPaint(Viewport::FromDimensions({ gsl::narrow_cast<SHORT>(left), target.Y }, { gsl::narrow_cast<SHORT>(right - left), 1 }));
+}
+
+// Routine Description:
+// - Fills count cells with the same character and/or attribute, starting at
+//   target and continuing onto the following rows, like Write with a
+//   repeating OutputCellIterator does. Each row is filled in one block: one
+//   std::fill of its text and one run of its attributes.
+// - Like any fill, it unsets the wrap of rows it fills up to the last column. See GH#1126.
+// Arguments:
+// - target - Coordinate of the first cell to fill
+// - count - The number of cells to fill. Clipped to the end of the buffer.
+// - wch - The character to fill with, or nullopt to keep the text. Must be a narrow glyph.
+// - attr - The attribute to fill with, or nullopt to keep the attributes
+// Return Value:
+// - The number of cells filled.
+size_t TextBuffer::Fill(const COORD target,
+                        const size_t count,
+                        const std::optional<wchar_t> wch,
+                        const std::optional<TextAttribute> attr)
+{
+    const auto size = GetSize();
+    if (count == 0 || !size.IsInBounds(target))
+    {
+        return 0;
+    }
+    THROW_HR_IF(E_INVALIDARG, wch.has_value() && IsGlyphFullWidth(*wch));
+
+    const auto width = gsl::narrow_cast<size_t>(size.Width());
+    auto remaining = count;
+    auto column = gsl::narrow_cast<size_t>(target.X);
+    auto y = target.Y;
+    // Filling a row that hasn't been created yet with what it already looks
+    // like doesn't change anything, and shouldn't create it. That's what
+    // clearing the whole buffer (like cls does) mostly is.
+    const auto fillsLikeBlankRow = (!wch || *wch == UNICODE_SPACE) && (!attr || *attr == _blankRowAttributes);
+
+    for (; remaining > 0 && y < size.BottomExclusive(); ++y)
+    {
+        const auto end = std::min(width, column + remaining);
+        if (fillsLikeBlankRow && !_IsRowCreated(y))
+        {
+            remaining -= end - column;
+            column = 0;
+            continue;
+        }
+
+        auto& row = GetRowByOffset(y);
+        if (wch.has_value())
+        {
+            row.FillText(column, end, *wch);
+            if (end == width)
+            {
+                row.SetWrapForced(false);
+            }
+        }
+        if (attr.has_value())
+        {
+            row.FillAttributes(column, end, *attr);
+        }
+        remaining -= end - column;
+        column = 0;
+    }
+
+    const auto filled = count - remaining;
+    if (y - target.Y == 1)
+    {
+        // Wide glyphs cut in half on either side of the fill have been cleared, too.
+        const auto left = target.X > 0 ? target.X - 1 : target.X;
+        const auto right = std::min(target.X + filled + 1, width);
+        _NotifyPaint(Viewport::FromDimensions({ gsl::narrow_cast<SHORT>(left), target.Y }, { gsl::narrow_cast<SHORT>(right - left), 1 }));
+    }
+    else
+    {
+        _NotifyPaint(Viewport::FromExclusive({ 0, target.Y, size.Width(), y }));
+    }
+
+    return filled;
+}
+
+// Routine Description:
+// - Clears count whole rows to spaces in the given attribute. See ROW::Clear.
+// - Each row is cleared in one go, rather than cell by cell, and the renderer
+//   is notified once for all of them. Line renditions are kept.
+// Arguments:
+// - firstRow - The first row to clear
+// - count - The number of rows to clear. Clipped to the buffer.
+// - attr - The attribute to fill the rows with
+// Return Value:
+// - <none>
+void TextBuffer::ClearRows(const SHORT firstRow, const SHORT count, const TextAttribute& attr)
+{
+    const auto size = GetSize();
+    const auto top = std::clamp<int>(firstRow, 0, size.Height());
+    const auto bottom = std::clamp<int>(firstRow + count, top, size.Height());
+    if (top == bottom)
+    {
+        return;
+    }
+
+    // The rows that haven't been created yet are left that way, as long as
+    // they'd look the same once cleared. If every one of them is cleared, they
+    // can all take on the new attribute instead.
+    auto clearedRowsEnd = bottom;
+    if (!_IsRowCreated(gsl::narrow_cast<size_t>(bottom - 1)))
+    {
+        const auto createdRows = std::max(top, gsl::narrow_cast<int>(_storage.size()));
+        if (attr == _blankRowAttributes)
+        {
+            clearedRowsEnd = createdRows;
+        }
+        else if (bottom == size.Height())
+        {
+            clearedRowsEnd = createdRows;
+            _SetBlankRowAttributes(attr);
+        }
+    }
+
+    for (auto y = top; y < clearedRowsEnd; ++y)
+    {
+        GetRowByOffset(y).Clear(attr);
+    }
+
+    _NotifyPaint(Viewport::FromExclusive({ 0, gsl::narrow_cast<SHORT>(top), size.Width(), gsl::narrow_cast<SHORT>(bottom) }));
+}
+
+// Routine Description:
+// - Clears every row from firstRow to the bottom of the buffer, like ClearRows,
+//   but instead of clearing them one by one, they're dropped altogether and
+//   their memory is given back. They're created anew as they're written to.
+// - The rows above firstRow are moved onto new cell storage of their own, so
+//   this is meant for when most of the buffer is cleared, like when the
+//   scrollback is erased.
+// Arguments:
+// - firstRow - the first row to release
+// - attr - the attribute the released rows are filled with
+// Return Value:
+// - <none>
+void TextBuffer::ReleaseRows(const SHORT firstRow, const TextAttribute& attr)
+{
+    const auto size = GetSize();
+    const auto keptRows = gsl::narrow_cast<size_t>(std::clamp<int>(firstRow, 0, size.Height()));
+
+    // The rows are about to move, just like in ScrollRows.
+    _FlushDeferredPaint();
+    _CountHyperlinks();
+
+    // Straighten out the circular buffer first, so that the rows we keep are
+    // the first ones in the storage.
+    if (_firstRow != 0)
+    {
+        std::rotate(_storage.begin(), _storage.begin() + _firstRow, _storage.end());
+        _firstRow = 0;
+    }
+
+    if (keptRows < _storage.size())
+    {
+        // Give up the references of the rows we drop. See _PruneHyperlinks.
+        for (auto i = keptRows; i < _storage.size(); ++i)
+        {
+            for (const auto id : til::at(_storage, i).GetCountedHyperlinks())
+            {
+                const auto it = _hyperlinkRowCounts.find(id);
+                if (it != _hyperlinkRowCounts.end() && --it->second == 0)
+                {
+                    _hyperlinkRowCounts.erase(it);
+                    RemoveHyperlinkFromMap(id);
+                }
+            }
+        }
+
+        // Allocate up front, such that nothing below can fail once the rows we
+        // keep start moving over to the new storage. See ResizeTraditional.
+        const auto width = gsl::narrow_cast<size_t>(size.Width());
+        auto charBuffer = _AllocateCharBuffer(size.Dimensions(), _charBuffer.get_allocator().resource());
+        charBuffer.resize(keptRows * width);
+
+        _storage.erase(_storage.begin() + keptRows, _storage.end());
+        _RecountLineRenditions();
+        _charBuffer.swap(charBuffer);
+        for (size_t i = 0; i < _storage.size(); ++i)
+        {
+            til::at(_storage, i).GetCharRow().Resize(_GetCharBufferSlice(i, width));
+        }
+    }
+
+    _RefreshRowIDs(std::nullopt);
+    _SetBlankRowAttributes(attr);
+
+    _NotifyPaint(Viewport::FromExclusive({ 0, gsl::narrow_cast<SHORT>(keptRows), size.Width(), size.Height() }));
+}
+
 //Routine Description:
 // - Inserts one codepoint into the buffer at the current cursor position and advances the cursor as appropriate.
 //Arguments:
@@ -553,35 +1150,65 @@ bool TextBuffer::NewlineCursor()
 // - true if we successfully incremented the buffer.
 bool TextBuffer::IncrementCircularBuffer(const bool inVtMode)
 {
+    return AdvanceCircularBuffer(1, inVtMode);
+}
+
+//Routine Description:
+// - Increments the circular buffer by count rows at once, like count calls to
+//   IncrementCircularBuffer, but the renderer is only told about it once.
+//Arguments:
+// - count - the number of rows to move the first row down by.
+// - inVtMode - set to true in VT mode, so standard erase attributes are used for the new rows.
+//Return Value:
+// - true if we successfully incremented the buffer.
+bool TextBuffer::AdvanceCircularBuffer(const size_t count, const bool inVtMode)
+{
+    if (count == 0)
+    {
+        return true;
+    }
+
     // FirstRow is at any given point in time the array index in the circular buffer that corresponds
     // to the logical position 0 in the window (cursor coordinates and all other coordinates).
+    // Anything written so far is about to move up, so it can't be deferred any longer.
+    _FlushDeferredPaint();
     _renderTarget.TriggerCircling();
 
-    // Prune hyperlinks to delete obsolete references
-    _PruneHyperlinks();
-
-    // Second, clean out the old "first row" as it will become the "last row" of the buffer after the circle is performed.
     auto fillAttributes = _currentAttributes;
     if (inVtMode)
     {
-        // The VT standard requires that the new row is initialized with
+        // The VT standard requires that the new rows are initialized with
         // the current background color, but with no meta attributes set.
         fillAttributes.SetStandardErase();
     }
-    const bool fSuccess = _storage.at(_firstRow).Reset(fillAttributes);
-    if (fSuccess)
+
+    // Once the first row moves, rows aren't stored front to back anymore.
+    // Create all of them now, so that they never have to be created out of order.
+    _AllocateRows(TotalRowCount());
+
+    // Advancing by more than the whole buffer clears every row just the same.
+    const auto totalRows = TotalRowCount();
+    const auto cleared = std::min(count, totalRows);
+    for (size_t i = 0; i < cleared; ++i)
     {
-        // Now proceed to increment.
-        // Incrementing it will cause the next line down to become the new "top" of the window (the new "0" in logical coordinates)
-        _firstRow++;
+        // Prune hyperlinks to delete obsolete references
+        _PruneHyperlinks();
 
-        // If we pass up the height of the buffer, loop back to 0.
-        if (_firstRow >= GetSize().Height())
+        // Clean out the old "first row" as it will become the "last row" of the buffer after the circle is performed.
+        auto& oldFirstRow = _storage.at(_firstRow);
+        _TouchRow(oldFirstRow);
+        if (!oldFirstRow.Reset(fillAttributes))
         {
-            _firstRow = 0;
+            return false;
         }
+
+        // Incrementing it will cause the next line down to become the new "top" of the window (the new "0" in logical coordinates)
+        // If we pass up the height of the buffer, loop back to 0.
+        _firstRow = gsl::narrow_cast<SHORT>((_firstRow + 1) % totalRows);
     }
-    return fSuccess;
+    _firstRow = gsl::narrow_cast<SHORT>((_firstRow + (count - cleared)) % totalRows);
+    _circledRowCount += count;
+    return true;
 }
 
 //Routine Description:
@@ -670,9 +1297,9 @@ const Viewport TextBuffer::GetSize() const noexcept
     return _size;
 }
 
-void TextBuffer::_UpdateSize()
+void TextBuffer::_UpdateSize(const COORD size)
 {
-    _size = Viewport::FromDimensions({ 0, 0 }, { gsl::narrow<SHORT>(_storage.at(0).size()), gsl::narrow<SHORT>(_storage.size()) });
+    _size = Viewport::FromDimensions({ 0, 0 }, size);
 }
 
 void TextBuffer::_SetFirstRowIndex(const SHORT FirstRowIndex) noexcept
@@ -688,18 +1315,43 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         return;
     }
 
+    // The rows we collected deferred paints for are about to move.
+    _FlushDeferredPaint();
+    // So are the rows whose hyperlinks are still to be counted.
+    _CountHyperlinks();
+
     // OK. We're about to play games by moving rows around within the deque to
     // scroll a massive region in a faster way than copying things.
-    // To make this easier, first correct the circular buffer to have the first row be 0 again.
-    if (_firstRow != 0)
+    // The rows we rotate are the region and the rows it scrolls over.
+    const auto totalRows = gsl::narrow_cast<ptrdiff_t>(TotalRowCount());
+    const ptrdiff_t rangeStart = firstRow + std::min<SHORT>(delta, 0);
+    const ptrdiff_t rangeSize = size + std::abs(delta);
+
+    // All of those rows have to exist. As long as not every row has been
+    // created yet, the first row is still 0 and they're stored front to back.
+    _AllocateRows(gsl::narrow_cast<size_t>(_firstRow + rangeStart + rangeSize));
+
+    // Rows are stored circularly. As long as the range doesn't wrap around the end
+    // of the storage, we can rotate it where it is. Otherwise, first correct the
+    // circular buffer to have the first row be 0 again. Rotating the entire
+    // storage is expensive, so this is only done when there's no other way.
+    auto physicalStart = (_firstRow + rangeStart) % totalRows;
+    bool rotatedStorage = false;
+    if (physicalStart + rangeSize > totalRows)
     {
         // Rotate the buffer to put the first row at the front.
         std::rotate(_storage.begin(), _storage.begin() + _firstRow, _storage.end());
 
         // The first row is now at the top.
         _firstRow = 0;
+        physicalStart = rangeStart;
+        rotatedStorage = true;
     }
 
+    // In the layouts below, "begin + X" is where buffer row X is stored.
+    const auto offset = physicalStart - rangeStart;
+    const auto at = [&](const ptrdiff_t row) { return _storage.begin() + (offset + row); };
+
     // Rotate just the subsection specified
     if (delta < 0)
     {
@@ -736,7 +1388,7 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 10
         // | 11
         // - end
-        std::rotate(_storage.begin() + firstRow + delta, _storage.begin() + firstRow, _storage.begin() + firstRow + size);
+        std::rotate(at(firstRow + delta), at(firstRow), at(firstRow + size));
     }
     else
     {
@@ -773,12 +1425,24 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         // | 10
         // | 11
         // - end
-        std::rotate(_storage.begin() + firstRow, _storage.begin() + firstRow + size, _storage.begin() + firstRow + size + delta);
+        std::rotate(at(firstRow), at(firstRow + size), at(firstRow + size + delta));
     }
 
     // Renumber the IDs now that we've rearranged where the rows sit within the buffer.
-    // Refreshing should also delegate to the UnicodeStorage to re-key all the stored unicode sequences (where applicable).
-    _RefreshRowIDs(std::nullopt);
+    // Unless we had to rotate everything, only the rotated range has changed.
+    if (rotatedStorage)
+    {
+        _RefreshRowIDs(std::nullopt);
+    }
+    else
+    {
+        for (auto i = physicalStart; i < physicalStart + rangeSize; ++i)
+        {
+            auto& row = til::at(_storage, gsl::narrow_cast<size_t>(i));
+            row.SetId(gsl::narrow_cast<SHORT>(i));
+            row.GetCharRow().UpdateParent(&row);
+        }
+    }
 }
 
 Cursor& TextBuffer::GetCursor() noexcept
@@ -832,7 +1496,12 @@ void TextBuffer::ResetLineRenditionRange(const size_t startRow, const size_t end
 {
     for (auto row = startRow; row < endRow; row++)
     {
-        GetRowByOffset(row).SetLineRendition(LineRendition::SingleWidth);
+        // Most rows are single width already. Don't touch them (or create
+        // them, if they haven't been written to yet) just to say so again.
+        if (IsDoubleWidthLine(row))
+        {
+            GetRowByOffset(row).SetLineRendition(LineRendition::SingleWidth);
+        }
     }
 }
 
@@ -846,6 +1515,70 @@ bool TextBuffer::IsDoubleWidthLine(const size_t row) const
     return GetLineRendition(row) != LineRendition::SingleWidth;
 }
 
+// Routine Description:
+// - Returns true if any row in the buffer is double width or double height.
+//   The renderer uses this to skip line transforms entirely in the common case.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if at least one row has a line rendition other than single width.
+bool TextBuffer::HasLineRenditions() const noexcept
+{
+    return _lineRenditionRowCount != 0;
+}
+
+// Routine Description:
+// - Draws a slice of an image over the row the cursor is on. It replaces
+//   any slice that was drawn over that row before.
+// Arguments:
+// - imageSlice - the slice to draw. Its columns are relative to the row.
+// Return Value:
+// - <none>
+void TextBuffer::SetCurrentImageSlice(std::shared_ptr<const ImageSlice> imageSlice)
+{
+    const auto rowIndex = GetCursor().GetPosition().Y;
+    GetRowByOffset(rowIndex).SetImageSlice(std::move(imageSlice));
+    _NotifyPaint(Viewport::FromDimensions({ 0, rowIndex }, { GetSize().Width(), 1 }));
+}
+
+// Routine Description:
+// - Called by a row whenever its line rendition changes, to keep the count
+//   of the rows that aren't single width.
+// Arguments:
+// - oldRendition - the row's previous line rendition
+// - newRendition - the row's new line rendition
+// Return Value:
+// - <none>
+void TextBuffer::_LineRenditionChanged(const LineRendition oldRendition, const LineRendition newRendition) noexcept
+{
+    if (oldRendition == LineRendition::SingleWidth)
+    {
+        ++_lineRenditionRowCount;
+    }
+    else if (newRendition == LineRendition::SingleWidth && _lineRenditionRowCount != 0)
+    {
+        --_lineRenditionRowCount;
+    }
+}
+
+// Routine Description:
+// - Counts the rows that aren't single width anew, after rows were dropped.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::_RecountLineRenditions() noexcept
+{
+    _lineRenditionRowCount = 0;
+    for (const auto& row : _storage)
+    {
+        if (row.GetLineRendition() != LineRendition::SingleWidth)
+        {
+            ++_lineRenditionRowCount;
+        }
+    }
+}
+
 SHORT TextBuffer::GetLineWidth(const size_t row) const
 {
     // Use shift right to quickly divide the width by 2 for double width lines.
@@ -882,8 +1615,10 @@ void TextBuffer::Reset()
 
     for (auto& row : _storage)
     {
+        _TouchRow(row);
         row.Reset(attr);
     }
+    _SetBlankRowAttributes(attr);
 }
 
 // Routine Description:
@@ -908,68 +1643,84 @@ void TextBuffer::Reset()
         }
         const SHORT TopRowIndex = (GetFirstRowIndex() + TopRow) % currentSize.Y;
 
+        // The rows are about to be rotated and cut off. Create all of them first,
+        // so that the rows that are still missing afterwards are exactly the ones
+        // we're adding, which start out in the current attributes.
+        _AllocateRows(TotalRowCount());
+        const auto keptRows = std::min<size_t>(_storage.size(), static_cast<size_t>(newSize.Y));
+
+        // Allocate the new cell storage and reserve the rows up front, such that
+        // nothing below can fail once the rows start moving over to the new storage.
+        const auto resource = _charBuffer.get_allocator().resource();
+        auto charBuffer = _AllocateCharBuffer(newSize, resource);
+        charBuffer.resize(keptRows * static_cast<size_t>(newSize.X));
+        std::pmr::vector<CharRowCell> blankRowCells(static_cast<size_t>(newSize.X), resource);
+        _storage.reserve(static_cast<size_t>(newSize.Y));
+
         // rotate rows until the top row is at index 0
-        for (int i = 0; i < TopRowIndex; i++)
-        {
-            _storage.emplace_back(std::move(_storage.front()));
-            _storage.erase(_storage.begin());
-        }
+        std::rotate(_storage.begin(), _storage.begin() + TopRowIndex, _storage.end());
 
         _SetFirstRowIndex(0);
 
         // realloc in the Y direction
         // remove rows if we're shrinking
-        while (_storage.size() > static_cast<size_t>(newSize.Y))
+        if (_storage.size() > static_cast<size_t>(newSize.Y))
         {
-            _storage.pop_back();
+            _storage.erase(_storage.begin() + newSize.Y, _storage.end());
+            _RecountLineRenditions();
         }
-        // add rows if we're growing
-        while (_storage.size() < static_cast<size_t>(newSize.Y))
+
+        // From here on new slices are handed out from the new storage. The old storage
+        // stays alive until we return, so the rows can copy their contents over.
+        // Move every row over right away (this can't fail), so that no row is
+        // left pointing into the old storage should anything below throw.
+        _charBuffer.swap(charBuffer);
+        for (size_t i = 0; i < _storage.size(); ++i)
         {
-            _storage.emplace_back(static_cast<short>(_storage.size()), newSize.X, attributes, this);
+            til::at(_storage, i).GetCharRow().Resize(_GetCharBufferSlice(i, newSize.X));
         }
 
+        // The rows we're adding if we're growing are created as they're written to.
+        // Until then they look like the blank row, which moves onto its new cells too.
+        THROW_IF_FAILED(_blankRow.Resize(blankRowCells));
+        _blankRowCells.swap(blankRowCells);
+        _SetBlankRowAttributes(attributes);
+
         // Now that we've tampered with the row placement, refresh all the row IDs.
-        // Also take advantage of the row ID refresh loop to resize the rows in the X dimension
-        // and cleanup the UnicodeStorage characters that might fall outside the resized buffer.
+        // Also take advantage of the row ID refresh loop to resize the rows in the X dimension.
+        // Each row cleans up the UnicodeStorage characters that fall outside of its new width.
         _RefreshRowIDs(newSize.X);
 
+        // Rows were dropped and moved around: count every row's hyperlinks anew.
+        _ResetHyperlinkCounts();
+        for (auto& row : _storage)
+        {
+            _TouchRow(row);
+        }
+
         // Update the cached size value
-        _UpdateSize();
+        _UpdateSize(newSize);
     }
     CATCH_RETURN();
 
     return S_OK;
 }
 
-const UnicodeStorage& TextBuffer::GetUnicodeStorage() const noexcept
-{
-    return _unicodeStorage;
-}
-
-UnicodeStorage& TextBuffer::GetUnicodeStorage() noexcept
-{
-    return _unicodeStorage;
-}
-
 // Routine Description:
 // - Method to help refresh all the Row IDs after manipulating the row
 //   by shuffling pointers around.
 // - This will also update parent pointers that are stored in depth within the buffer
 //   (e.g. it will update CharRow parents pointing at Rows that might have been moved around)
-// - Optionally takes a new row width if we're resizing to perform a resize operation and cleanup
-//   any high unicode (UnicodeStorage) runs while we're already looping through the rows.
+// - Optionally takes a new row width if we're resizing to perform a resize operation while
+//   we're already looping through the rows. Each row drops its own high unicode
+//   (UnicodeStorage) glyphs that fall outside the new width.
 // Arguments:
 // - newRowWidth - Optional new value for the row width.
 void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
 {
-    std::unordered_map<SHORT, SHORT> rowMap;
     SHORT i = 0;
     for (auto& it : _storage)
     {
-        // Build a map so we can update Unicode Storage
-        rowMap.emplace(it.GetId(), i);
-
         // Update the IDs
         it.SetId(i++);
 
@@ -979,19 +1730,79 @@ void TextBuffer::_RefreshRowIDs(std::optional<SHORT> newRowWidth)
         // Resize the rows in the X dimension if we have a new width
         if (newRowWidth.has_value())
         {
-            // Realloc in the X direction
-            THROW_IF_FAILED(it.Resize(newRowWidth.value()));
+            // Move the row onto its slice of the (new) cell storage.
+            THROW_IF_FAILED(it.Resize(_GetCharBufferSlice(i - 1, newRowWidth.value())));
         }
     }
+}
+
+void TextBuffer::_NotifyPaint(const Viewport& viewport)
+{
+    if (_deferPaintDepth == 0)
+    {
+        _renderTarget.TriggerRedraw(viewport);
+        return;
+    }
+
+    // The buffer can't be resized in the middle of a write,
+    // but if it was, we can't collect coordinates of both sizes.
+    if (const til::size size{ GetSize().Dimensions() }; _deferredPaint.size() != size)
+    {
+        _FlushDeferredPaint();
+        _deferredPaint.resize(size);
+    }
+
+    if (const auto clipped = GetSize().Clamp(viewport); clipped.IsValid())
+    {
+        _deferredPaint.set(til::rectangle{ clipped.ToInclusive() });
+    }
+}
+
+// Routine Description:
+// - Stops notifying the renderer about every write, until the matching call
+//   to EndDeferPaint. Writes that happen in between are coalesced, so the
+//   renderer is only notified once per touched run of cells. Calls can nest.
+// - If rows are moved around in the meantime (IncrementCircularBuffer,
+//   ScrollRows), whatever was collected before is sent to the renderer first.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::StartDeferPaint() noexcept
+{
+    ++_deferPaintDepth;
+}
 
-    // Give the new mapping to Unicode Storage
-    _unicodeStorage.Remap(rowMap, newRowWidth);
+// Routine Description:
+// - Ends a StartDeferPaint block, and notifies the renderer about everything
+//   that was written since the outermost one began.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::EndDeferPaint() noexcept
+{
+    if (_deferPaintDepth != 0 && --_deferPaintDepth == 0)
+    {
+        _FlushDeferredPaint();
+    }
 }
 
-void TextBuffer::_NotifyPaint(const Viewport& viewport) const
+void TextBuffer::_FlushDeferredPaint() noexcept
+try
 {
-    _renderTarget.TriggerRedraw(viewport);
+    if (!_deferredPaint.any())
+    {
+        return;
+    }
+
+    for (const auto& run : _deferredPaint.runs())
+    {
+        _renderTarget.TriggerRedraw(Viewport::FromInclusive(run));
+    }
+    _deferredPaint.reset_all();
 }
+CATCH_LOG()
 
 // Routine Description:
 // - Retrieves the first row from the underlying buffer.
@@ -1022,7 +1833,9 @@ ROW& TextBuffer::_GetPrevRowNoWrap(const ROW& Row)
     }
 
     THROW_HR_IF(E_FAIL, Row.GetId() == _firstRow);
-    return _storage.at(prevRowIndex);
+    auto& prevRow = _storage.at(prevRowIndex);
+    _TouchRow(prevRow);
+    return prevRow;
 }
 
 // Method Description:
@@ -1046,7 +1859,57 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget() noexcep
 // - the delimiter class for the given char
 const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const
 {
-    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, wordDelimiters);
+    const auto& classes = _GetRowDelimiterClasses(pos.Y, wordDelimiters);
+    THROW_HR_IF(E_INVALIDARG, pos.X < 0 || gsl::narrow_cast<size_t>(pos.X) >= classes.size());
+    return til::at(classes, pos.X);
+}
+
+// Method Description:
+// - get the delimiter class of every cell in the given row
+// - The result is cached until the row is modified (its generation changes)
+//   or a different set of delimiters is asked for.
+// Arguments:
+// - row: the row under observation
+// - wordDelimiters: the delimiters defined as a part of the DelimiterClass::DelimiterChar
+// Return Value:
+// - the delimiter class for each cell in the row. Only valid until the next call.
+const std::vector<DelimiterClass>& TextBuffer::_GetRowDelimiterClasses(const size_t row, const std::wstring_view wordDelimiters) const
+{
+    const auto& targetRow = GetRowByOffset(row);
+    const auto generation = targetRow.GetGeneration();
+    const auto& charRow = targetRow.GetCharRow();
+    const auto width = charRow.size();
+
+    if (_delimiterClassCacheDelimiters != wordDelimiters)
+    {
+        _delimiterClassCacheDelimiters = wordDelimiters;
+        for (auto& entry : _delimiterClassCache)
+        {
+            entry.classes.clear();
+        }
+    }
+
+    for (const auto& entry : _delimiterClassCache)
+    {
+        if (entry.row == row && entry.generation == generation && entry.classes.size() == width)
+        {
+            return entry.classes;
+        }
+    }
+
+    auto& entry = til::at(_delimiterClassCache, _delimiterClassCacheNext);
+    _delimiterClassCacheNext = (_delimiterClassCacheNext + 1) % DelimiterClassCacheSize;
+
+    // Invalidate the entry first, in case filling it in throws.
+    entry.classes.clear();
+    entry.classes.reserve(width);
+    for (size_t column = 0; column < width; ++column)
+    {
+        entry.classes.push_back(charRow.DelimiterClassAt(column, wordDelimiters));
+    }
+    entry.row = row;
+    entry.generation = generation;
+    return entry.classes;
 }
 
 // Method Description:
@@ -1294,50 +2157,87 @@ const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const std::w
     return result;
 }
 
+// Routine Description:
+// - Called before the first row is recycled. The hyperlinks that are only
+//   referenced by this row are removed from the hyperlink maps.
+// - Rather than searching the entire buffer for other references, this
+//   consults the count of rows referencing each hyperlink. Only the rows that
+//   were modified since the last time are counted again.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
 void TextBuffer::_PruneHyperlinks()
 {
-    // Check the old first row for hyperlink references
-    // If there are any, search the entire buffer for the same reference
-    // If the buffer does not contain the same reference, we can remove that hyperlink from our map
-    // This way, obsolete hyperlink references are cleared from our hyperlink map instead of hanging around
-    // Get all the hyperlink references in the row we're erasing
-    const auto hyperlinks = _storage.at(_firstRow).GetAttrRow().GetHyperlinks();
-
-    if (!hyperlinks.empty())
-    {
-        // Move to unordered set so we can use hashed lookup of IDs instead of linear search.
-        // Only make it an unordered set now because set always heap allocates but vector
-        // doesn't when the set is empty (saving an allocation in the common case of no links.)
-        std::unordered_set<uint16_t> firstRowRefs{ hyperlinks.cbegin(), hyperlinks.cend() };
-
-        const auto total = TotalRowCount();
-        // Loop through all the rows in the buffer except the first row -
-        // we have found all hyperlink references in the first row and put them in refs,
-        // now we need to search the rest of the buffer (i.e. all the rows except the first)
-        // to see if those references are anywhere else
-        for (size_t i = 1; i != total; ++i)
-        {
-            const auto nextRowRefs = GetRowByOffset(i).GetAttrRow().GetHyperlinks();
-            for (auto id : nextRowRefs)
-            {
-                if (firstRowRefs.find(id) != firstRowRefs.end())
-                {
-                    firstRowRefs.erase(id);
-                }
-            }
-            if (firstRowRefs.empty())
+    _CountHyperlinks();
+
+    auto& hyperlinks = _storage.at(_firstRow).GetCountedHyperlinks();
+    for (const auto id : hyperlinks)
+    {
+        const auto it = _hyperlinkRowCounts.find(id);
+        if (it != _hyperlinkRowCounts.end() && --it->second == 0)
+        {
+            _hyperlinkRowCounts.erase(it);
+            RemoveHyperlinkFromMap(id);
+        }
+    }
+    hyperlinks.clear();
+}
+
+// Routine Description:
+// - Brings the count of rows referencing each hyperlink up to date, by
+//   counting the hyperlinks of each row modified since the last time again.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::_CountHyperlinks()
+{
+    for (const auto index : _hyperlinkCountPendingRows)
+    {
+        auto& row = _storage.at(index);
+        auto& counted = row.GetCountedHyperlinks();
+
+        for (const auto id : counted)
+        {
+            const auto it = _hyperlinkRowCounts.find(id);
+            if (it != _hyperlinkRowCounts.end() && --it->second == 0)
             {
-                // No more hyperlink references left to search for, terminate early
-                break;
+                _hyperlinkRowCounts.erase(it);
             }
         }
 
-        // Now delete obsolete references from our map
-        for (auto hyperlinkReference : firstRowRefs)
+        // A row references a hyperlink once, no matter how many runs it has.
+        counted = row.GetAttrRow().GetHyperlinks();
+        std::sort(counted.begin(), counted.end());
+        counted.erase(std::unique(counted.begin(), counted.end()), counted.end());
+
+        for (const auto id : counted)
         {
-            RemoveHyperlinkFromMap(hyperlinkReference);
+            ++_hyperlinkRowCounts[id];
         }
+
+        row.SetHyperlinkCountPending(false);
+    }
+    _hyperlinkCountPendingRows.clear();
+}
+
+// Routine Description:
+// - Forgets all hyperlink counts. Every row has to be touched afterwards, so
+//   that it's counted again.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void TextBuffer::_ResetHyperlinkCounts()
+{
+    for (auto& row : _storage)
+    {
+        row.GetCountedHyperlinks().clear();
+        row.SetHyperlinkCountPending(false);
     }
+    _hyperlinkRowCounts.clear();
+    _hyperlinkCountPendingRows.clear();
 }
 
 // Method Description:
@@ -1501,7 +2401,7 @@ bool TextBuffer::MoveToPreviousGlyph(til::point& pos) const
 //                      the buffer rather than the screen.
 // Return Value:
 // - the delimiter class for the given char
-const std::vector<SMALL_RECT> TextBuffer::GetTextRects(COORD start, COORD end, bool blockSelection, bool bufferCoordinates) const
+const std::vector<SMALL_RECT> TextBuffer::GetTextRects(COORD start, COORD end, bool blockSelection, bool bufferCoordinates, TextRectsCache* cache) const
 {
     std::vector<SMALL_RECT> textRects;
 
@@ -1516,6 +2416,15 @@ const std::vector<SMALL_RECT> TextBuffer::GetTextRects(COORD start, COORD end, b
 
     const auto textRectSize = base::ClampedNumeric<short>(1) + lowerCoord.Y - higherCoord.Y;
     textRects.reserve(textRectSize);
+
+    // Expanding a row walks its glyphs, which adds up when a large selection gets
+    // dragged around. Most rows of it are the same from one call to the next though.
+    std::vector<TextRectsCache::Entry> cachedRows;
+    if (cache)
+    {
+        cachedRows.reserve(textRectSize);
+    }
+
     for (auto row = higherCoord.Y; row <= lowerCoord.Y; row++)
     {
         SMALL_RECT textRow;
@@ -1542,10 +2451,39 @@ const std::vector<SMALL_RECT> TextBuffer::GetTextRects(COORD start, COORD end, b
             textRow = ScreenToBufferLine(textRow, GetLineRendition(row));
         }
 
-        _ExpandTextRow(textRow);
+        if (cache)
+        {
+            const auto unexpanded = textRow;
+            const auto generation = GetRowGeneration(row);
+
+            const auto index = base::ClampSub<size_t>(row, cache->firstRow);
+            if (row >= cache->firstRow && index < cache->rows.size() &&
+                til::at(cache->rows, index).generation == generation &&
+                til::at(cache->rows, index).unexpanded == unexpanded)
+            {
+                textRow = til::at(cache->rows, index).expanded;
+            }
+            else
+            {
+                _ExpandTextRow(textRow);
+            }
+
+            cachedRows.push_back({ unexpanded, textRow, generation });
+        }
+        else
+        {
+            _ExpandTextRow(textRow);
+        }
+
         textRects.emplace_back(textRow);
     }
 
+    if (cache)
+    {
+        cache->rows = std::move(cachedRows);
+        cache->firstRow = higherCoord.Y;
+    }
+
     return textRects;
 }
 
@@ -1610,6 +2548,11 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
     TextAndColor data;
     const bool copyTextColor = GetAttributeColors != nullptr;
 
+    // Most cells share the attributes of the cell before them, so we only ask
+    // for the colors again when the attributes change.
+    std::optional<TextAttribute> lastAttr;
+    std::pair<COLORREF, COLORREF> lastColors{};
+
     // preallocate our vectors to reduce reallocs
     size_t const rows = selectionRects.size();
     data.text.reserve(rows);
@@ -1654,13 +2597,15 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
 
                 if (copyTextColor)
                 {
-                    const auto cellData = cell.TextAttr();
-                    const auto [CellFgAttr, CellBkAttr] = GetAttributeColors(cellData);
-                    for (size_t j = 0; j < chars.size(); ++j)
+                    const auto& cellData = cell.TextAttr();
+                    if (!lastAttr.has_value() || *lastAttr != cellData)
                     {
-                        selectionFgAttr.push_back(CellFgAttr);
-                        selectionBkAttr.push_back(CellBkAttr);
+                        lastAttr = cellData;
+                        lastColors = GetAttributeColors(cellData);
                     }
+                    const auto [CellFgAttr, CellBkAttr] = lastColors;
+                    selectionFgAttr.insert(selectionFgAttr.end(), chars.size(), CellFgAttr);
+                    selectionBkAttr.insert(selectionBkAttr.end(), chars.size(), CellBkAttr);
                 }
             }
 #pragma warning(suppress : 26444)
@@ -1721,6 +2666,140 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
     return data;
 }
 
+// Routine Description:
+// - Appends the SGR sequence that sets up a color to an SGR sequence that's
+//   being built.
+// Arguments:
+// - color - the color, with the 16 colors in the Windows order TextColor uses
+// - isForeground - whether it's the foreground or the background color
+// - sgr - the sequence to append the parameters to
+// Return Value:
+// - <none>
+static void _AppendSgrColor(const TextColor color, const bool isForeground, std::wstring& sgr)
+{
+    // The 16 colors are stored in the Windows order, where red and blue are
+    // swapped compared to the ANSI order that SGR uses.
+    const auto toAnsiIndex = [](const BYTE index) noexcept {
+        return gsl::narrow_cast<BYTE>((index & 0b1010) | ((index & 0b0001) << 2) | ((index & 0b0100) >> 2));
+    };
+
+    if (color.IsIndex16())
+    {
+        const auto index = toAnsiIndex(color.GetIndex() & 0x0F);
+        const auto base = index < 8 ? (isForeground ? 30 : 40) : (isForeground ? 90 : 100);
+        fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L";{}"), base + (index & 0b0111));
+    }
+    else if (color.IsIndex256())
+    {
+        const auto index = color.GetIndex() < 16 ? toAnsiIndex(color.GetIndex()) : color.GetIndex();
+        fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L";{};5;{}"), isForeground ? 38 : 48, index);
+    }
+    else if (color.IsRgb())
+    {
+        const auto rgb = color.GetRGB();
+        fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L";{};2;{};{};{}"), isForeground ? 38 : 48, GetRValue(rgb), GetGValue(rgb), GetBValue(rgb));
+    }
+}
+
+// Routine Description:
+// - Appends the SGR sequence that sets up the given attributes from scratch.
+// Arguments:
+// - attributes - the attributes to set
+// - text - the text to append the sequence to
+// Return Value:
+// - <none>
+static void _AppendSgr(const TextAttribute& attributes, std::wstring& text)
+{
+    // Every sequence starts with a reset, so that it doesn't matter
+    // what the attributes before it were.
+    std::wstring sgr{ L"\x1b[0" };
+    const std::pair<bool, std::wstring_view> renditions[]{
+        { attributes.IsBold(), L";1" },
+        { attributes.IsFaint(), L";2" },
+        { attributes.IsItalic(), L";3" },
+        { attributes.IsUnderlined(), L";4" },
+        { attributes.IsBlinking(), L";5" },
+        { attributes.IsReverseVideo(), L";7" },
+        { attributes.IsInvisible(), L";8" },
+        { attributes.IsCrossedOut(), L";9" },
+        { attributes.IsDoublyUnderlined(), L";21" },
+        { attributes.IsOverlined(), L";53" },
+    };
+    for (const auto& [isSet, parameter] : renditions)
+    {
+        if (isSet)
+        {
+            sgr.append(parameter);
+        }
+    }
+    _AppendSgrColor(attributes.GetForeground(), true, sgr);
+    _AppendSgrColor(attributes.GetBackground(), false, sgr);
+    sgr.push_back(L'm');
+    text.append(sgr);
+}
+
+// Routine Description:
+// - Appends the text of the given rows, for saving the buffer to a file.
+// - Every line ends with a CRLF. Rows that wrap onto the next one are
+//   joined with it instead, and the spaces that pad the end of a line are
+//   left out, just like when the text is copied.
+// - This only reads the rows it's asked for, so that callers can save a
+//   large buffer a chunk of rows at a time, and release the lock and write
+//   the chunk out in between.
+// Arguments:
+// - firstRow - the first row to append
+// - lastRow - the last row to append (inclusive)
+// - includeAttributes - if true, the colors and renditions of the text are
+//   preserved as SGR sequences, so that the text looks the same when it's
+//   printed to a terminal again.
+// - text - the text to append the rows to
+// Return Value:
+// - <none>
+void TextBuffer::SerializeRows(const size_t firstRow, const size_t lastRow, const bool includeAttributes, std::wstring& text) const
+{
+    const auto endRow = std::min(lastRow, TotalRowCount() - 1);
+    for (auto y = firstRow; y <= endRow; ++y)
+    {
+        const auto& row = GetRowByOffset(y);
+        const auto& charRow = row.GetCharRow();
+        const auto& attrRow = row.GetAttrRow();
+        const auto wrapped = row.WasWrapForced();
+        const auto width = wrapped ? charRow.size() : charRow.MeasureRight();
+
+        std::optional<TextAttribute> lastAttributes;
+        for (size_t x = 0; x < width; ++x)
+        {
+            if (charRow.DbcsAttrAt(x).IsTrailing())
+            {
+                continue;
+            }
+
+            if (includeAttributes)
+            {
+                const auto attributes = attrRow.GetAttrByColumn(gsl::narrow_cast<uint16_t>(x));
+                if (!lastAttributes || attributes != *lastAttributes)
+                {
+                    _AppendSgr(attributes, text);
+                    lastAttributes = attributes;
+                }
+            }
+            const std::wstring_view glyph = charRow.GlyphAt(x);
+            text.append(glyph);
+        }
+
+        // Reset the attributes at the end of every row, so that the
+        // background color doesn't run on into the next line.
+        if (lastAttributes && *lastAttributes != TextAttribute{})
+        {
+            text.append(L"\x1b[m");
+        }
+        if (!wrapped)
+        {
+            text.append(L"\r\n");
+        }
+    }
+}
+
 // Routine Description:
 // - Generates a CF_HTML compliant structure based on the passed in text and color data
 // Arguments:
@@ -2174,12 +3253,18 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
             }
         }
 
+        // Walk the attributes alongside the columns. Looking each one up
+        // with GetAttrByColumn scans the row's runs from the start every
+        // time, which made copying a row quadratic in its number of runs.
+        auto attrIt = row.GetAttrRow().cbegin();
+        const bool isOldCursorRow = iOldRow == cOldCursorPos.Y;
+
         // Loop through every character in the current row (up to
         // the "right" boundary, which is one past the final valid
         // character)
-        for (short iOldCol = 0; iOldCol < iRight; iOldCol++)
+        for (short iOldCol = 0; iOldCol < iRight; iOldCol++, ++attrIt)
         {
-            if (iOldCol == cOldCursorPos.X && iOldRow == cOldCursorPos.Y)
+            if (isOldCursorRow && iOldCol == cOldCursorPos.X)
             {
                 cNewCursorPos = newCursor.GetPosition();
                 fFoundCursorPos = true;
@@ -2188,11 +3273,10 @@ HRESULT TextBuffer::Reflow(TextBuffer& oldBuffer,
             try
             {
                 // TODO: MSFT: 19446208 - this should just use an iterator and the inserter...
-                const auto glyph = row.GetCharRow().GlyphAt(iOldCol);
-                const auto dbcsAttr = row.GetCharRow().DbcsAttrAt(iOldCol);
-                const auto textAttr = row.GetAttrRow().GetAttrByColumn(iOldCol);
+                const auto glyph = charRow.GlyphAt(iOldCol);
+                const auto dbcsAttr = charRow.DbcsAttrAt(iOldCol);
 
-                if (!newBuffer.InsertCharacter(glyph, dbcsAttr, textAttr))
+                if (!newBuffer.InsertCharacter(glyph, dbcsAttr, *attrIt))
                 {
                     hr = E_OUTOFMEMORY;
                     break;
@@ -2466,14 +3550,17 @@ void TextBuffer::CopyHyperlinkMaps(const TextBuffer& other)
 // Method Description:
 // - Adds a regex pattern we should search for
 // - The searching does not happen here, we only search when asked to by TerminalCore
+// - The pattern is compiled once here, since GetPatterns is called every time
+//   the visible region of the buffer changes.
 // Arguments:
 // - The regex pattern
 // Return value:
 // - An ID that the caller should associate with the given pattern
 const size_t TextBuffer::AddPatternRecognizer(const std::wstring_view regexString)
 {
+    std::wregex regexObj{ regexString.begin(), regexString.end() };
     ++_currentPatternId;
-    _idsAndPatterns.emplace(std::make_pair(_currentPatternId, regexString));
+    _idsAndPatterns.emplace(_currentPatternId, std::move(regexObj));
     return _currentPatternId;
 }
 
@@ -2518,10 +3605,21 @@ PointTree TextBuffer::GetPatterns(const size_t firstRow, const size_t lastRow) c
         concatAll += row.GetText();
     }
 
+    // measures the columns taken up by a part of concatAll. The sub_match
+    // iterators are walked directly so that we don't copy every prefix and
+    // match into a new string just to measure it.
+    const auto columnsIn = [](const std::wstring::const_iterator first, const std::wstring::const_iterator last) {
+        size_t columns = 0;
+        std::for_each(first, last, [&](const auto ch) {
+            columns += IsGlyphFullWidth(ch) ? 2 : 1;
+        });
+        return columns;
+    };
+
     // for each pattern we know of, iterate through the string
     for (const auto& idAndPattern : _idsAndPatterns)
     {
-        std::wregex regexObj{ idAndPattern.second };
+        const auto& regexObj = idAndPattern.second;
 
         // search through the run with our regex object
         auto words_begin = std::wsregex_iterator(concatAll.begin(), concatAll.end(), regexObj);
@@ -2534,18 +3632,11 @@ PointTree TextBuffer::GetPatterns(const size_t firstRow, const size_t lastRow) c
             // when we find a match, the prefix is text that is between this
             // match and the previous match, so we use the size of the prefix
             // along with the size of the match to determine the locations
-            size_t prefixSize = 0;
-
-            for (const auto ch : i->prefix().str())
-            {
-                prefixSize += IsGlyphFullWidth(ch) ? 2 : 1;
-            }
+            const auto& prefix = i->prefix();
+            const auto prefixSize = columnsIn(prefix.first, prefix.second);
             const auto start = lenUpToThis + prefixSize;
-            size_t matchSize = 0;
-            for (const auto ch : i->str())
-            {
-                matchSize += IsGlyphFullWidth(ch) ? 2 : 1;
-            }
+            const auto& match = (*i)[0];
+            const auto matchSize = columnsIn(match.first, match.second);
             const auto end = start + matchSize;
             lenUpToThis = end;
 
@@ -2563,3 +3654,48 @@ PointTree TextBuffer::GetPatterns(const size_t firstRow, const size_t lastRow) c
     PointTree result(std::move(intervals));
     return result;
 }
+
+// Routine Description:
+// - Estimates the memory held by an unordered_map: its buckets, and a node
+//   for every entry, without whatever the entries own themselves.
+template<typename Map>
+static size_t _HashMapMemoryUsage(const Map& map) noexcept
+{
+    return map.bucket_count() * sizeof(void*) + map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void*));
+}
+
+// Routine Description:
+// - Adds up the memory this buffer holds, to see where it goes. This walks
+//   every row, so it's meant for diagnostics, not for every frame.
+// Arguments:
+// - <none>
+// Return Value:
+// - The memory in use, in bytes, for each kind of data in the buffer.
+TextBuffer::MemoryUsage TextBuffer::GetMemoryUsage() const noexcept
+{
+    MemoryUsage usage;
+
+    usage.cells = (_charBuffer.capacity() + _blankRowCells.capacity()) * sizeof(CharRowCell);
+    usage.rows = _storage.capacity() * sizeof(ROW) + _hyperlinkCountPendingRows.capacity() * sizeof(size_t);
+    for (const auto& row : _storage)
+    {
+        usage.attributes += row.GetAttrRow().MemoryUsage();
+        usage.unicodeStorage += row.GetUnicodeStorage().MemoryUsage();
+        usage.hyperlinks += row.GetCountedHyperlinks().capacity() * sizeof(uint16_t);
+    }
+
+    usage.hyperlinks += _HashMapMemoryUsage(_hyperlinkMap) + _HashMapMemoryUsage(_hyperlinkCustomIdMap) + _HashMapMemoryUsage(_hyperlinkRowCounts);
+    for (const auto& [id, uri] : _hyperlinkMap)
+    {
+        usage.hyperlinks += uri.capacity() * sizeof(wchar_t);
+    }
+    for (const auto& [customId, id] : _hyperlinkCustomIdMap)
+    {
+        usage.hyperlinks += customId.capacity() * sizeof(wchar_t);
+    }
+
+    // The compiled regular expressions don't say how large they are.
+    usage.patterns = _HashMapMemoryUsage(_idsAndPatterns);
+
+    return usage;
+}
@@ -22,10 +22,11 @@ ScreenBuffer data structure overview:
 
 each screen buffer has an array of ROW structures.  each ROW structure
 contains the data for one row of text.  the data stored for one row of
-text is a character array and an attribute array.  the character array
-is allocated the full length of the row from the heap, regardless of the
-non-space length. we also maintain the non-space length.  the character
-array is initialized to spaces.  the attribute
+text is a character array and an attribute array.  the character arrays
+of all rows are slices of a single allocation owned by the text buffer
+(row width * row count cells), regardless of the non-space length. we
+also maintain the non-space length.  the character array is initialized
+to spaces.  the attribute
 array is run length encoded (i.e 5 BLUE, 3 RED). if there is only one
 attribute for the whole row (the normal case), it is stored in the ATTR_ROW
 structure.  otherwise the attr string is allocated from the heap.
@@ -49,6 +50,7 @@ filling in the last row, and updating the screen.
 
 #pragma once
 
+#include <regex>
 #include <vector>
 
 #include "cursor.h"
@@ -68,7 +70,8 @@ public:
     TextBuffer(const COORD screenBufferSize,
                const TextAttribute defaultAttributes,
                const UINT cursorSize,
-               Microsoft::Console::Render::IRenderTarget& renderTarget);
+               Microsoft::Console::Render::IRenderTarget& renderTarget,
+               std::pmr::memory_resource* const storageResource = til::pmr::get_default_resource());
     TextBuffer(const TextBuffer& a) = delete;
 
     // Used for duplicating properties to another text buffer
@@ -78,6 +81,27 @@ public:
     const ROW& GetRowByOffset(const size_t index) const;
     ROW& GetRowByOffset(const size_t index);
 
+    // Every time a row may have been modified it gets assigned a new generation
+    // that's unique across all buffers. Renderers can keep a snapshot of the
+    // generations of the rows they've painted and compare it with the current
+    // one to figure out which rows haven't changed since.
+    uint64_t GetRowGeneration(const size_t index) const;
+    void SnapshotRowGenerations(const size_t firstRow, const gsl::span<uint64_t> generations) const;
+
+    // A generation no row ever has. A snapshot filled with it makes
+    // ExportChangedRows export every row.
+    static constexpr uint64_t UnknownRowGeneration = std::numeric_limits<uint64_t>::max();
+
+    // Every row in a frame written by ExportChangedRows is this header,
+    // followed by `width` CHAR_INFOs with the row's contents.
+    struct ExportedRowHeader
+    {
+        uint16_t row;
+        uint16_t width;
+    };
+
+    void ExportChangedRows(const size_t firstRow, const gsl::span<uint64_t> generations, std::vector<std::byte>& frame) const;
+
     TextBufferCellIterator GetCellDataAt(const COORD at) const;
     TextBufferCellIterator GetCellLineDataAt(const COORD at) const;
     TextBufferCellIterator GetCellDataAt(const COORD at, const Microsoft::Console::Types::Viewport limit) const;
@@ -97,6 +121,27 @@ public:
                                  const std::optional<bool> setWrap = std::nullopt,
                                  const std::optional<size_t> limitRight = std::nullopt);
 
+    size_t WriteAsciiRun(const std::wstring_view text,
+                         const COORD target,
+                         const TextAttribute& attr,
+                         const std::optional<bool> wrap = true);
+
+    size_t WriteCharInfos(const gsl::span<const CHAR_INFO> charInfos,
+                          const COORD target,
+                          const std::optional<bool> wrap = true);
+
+    void ReadCharInfos(const COORD origin, const gsl::span<CHAR_INFO> charInfos) const;
+
+    void MoveCells(const COORD source, const size_t count, const SHORT destinationX);
+    void CopyCells(const COORD source, const size_t count, const COORD destination);
+    void FillCells(const COORD target, const size_t count, const TextAttribute& attr);
+    void ClearRows(const SHORT firstRow, const SHORT count, const TextAttribute& attr);
+    void ReleaseRows(const SHORT firstRow, const TextAttribute& attr);
+    size_t Fill(const COORD target,
+                const size_t count,
+                const std::optional<wchar_t> wch,
+                const std::optional<TextAttribute> attr);
+
     bool InsertCharacter(const wchar_t wch, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool InsertCharacter(const std::wstring_view chars, const DbcsAttribute dbcsAttribute, const TextAttribute attr);
     bool IncrementCursor();
@@ -104,6 +149,11 @@ public:
 
     // Scroll needs access to this to quickly rotate around the buffer.
     bool IncrementCircularBuffer(const bool inVtMode = false);
+    bool AdvanceCircularBuffer(const size_t count, const bool inVtMode = false);
+    // The number of rows the buffer has been advanced by, in total. Code that
+    // walks the buffer with the lock released in between can thus tell how
+    // far the rows it hasn't gotten to yet moved up in the meantime.
+    uint64_t GetCircledRowCount() const noexcept { return _circledRowCount; }
 
     COORD GetLastNonSpaceCharacter(std::optional<const Microsoft::Console::Types::Viewport> viewOptional = std::nullopt) const;
 
@@ -126,6 +176,9 @@ public:
     void ResetLineRenditionRange(const size_t startRow, const size_t endRow);
     LineRendition GetLineRendition(const size_t row) const;
     bool IsDoubleWidthLine(const size_t row) const;
+    bool HasLineRenditions() const noexcept;
+
+    void SetCurrentImageSlice(std::shared_ptr<const ImageSlice> imageSlice);
 
     SHORT GetLineWidth(const size_t row) const;
     COORD ClampPositionWithinLine(const COORD position) const;
@@ -136,11 +189,12 @@ public:
 
     [[nodiscard]] HRESULT ResizeTraditional(const COORD newSize) noexcept;
 
-    const UnicodeStorage& GetUnicodeStorage() const noexcept;
-    UnicodeStorage& GetUnicodeStorage() noexcept;
 
     Microsoft::Console::Render::IRenderTarget& GetRenderTarget() noexcept;
 
+    void StartDeferPaint() noexcept;
+    void EndDeferPaint() noexcept;
+
     const COORD GetWordStart(const COORD target, const std::wstring_view wordDelimiters, bool accessibilityMode = false) const;
     const COORD GetWordEnd(const COORD target, const std::wstring_view wordDelimiters, bool accessibilityMode = false) const;
     bool MoveToNextWord(COORD& pos, const std::wstring_view wordDelimiters, COORD lastCharPos) const;
@@ -151,7 +205,27 @@ public:
     bool MoveToNextGlyph(til::point& pos, bool allowBottomExclusive = false) const;
     bool MoveToPreviousGlyph(til::point& pos) const;
 
-    const std::vector<SMALL_RECT> GetTextRects(COORD start, COORD end, bool blockSelection, bool bufferCoordinates) const;
+    // Lets GetTextRects reuse the rows it expanded the last time it was called with
+    // the same cache, as long as the row and the requested range of it haven't changed.
+    // Clear it when switching to a different buffer, since generations are per buffer.
+    struct TextRectsCache
+    {
+        struct Entry
+        {
+            SMALL_RECT unexpanded;
+            SMALL_RECT expanded;
+            uint64_t generation;
+        };
+        std::vector<Entry> rows;
+        short firstRow{ 0 };
+
+        void Clear() noexcept
+        {
+            rows.clear();
+        }
+    };
+
+    const std::vector<SMALL_RECT> GetTextRects(COORD start, COORD end, bool blockSelection, bool bufferCoordinates, TextRectsCache* cache = nullptr) const;
 
     void AddHyperlinkToMap(std::wstring_view uri, uint16_t id);
     std::wstring GetHyperlinkUriFromId(uint16_t id) const;
@@ -174,6 +248,8 @@ public:
                                std::function<std::pair<COLORREF, COLORREF>(const TextAttribute&)> GetAttributeColors = nullptr,
                                const bool formatWrappedRows = false) const;
 
+    void SerializeRows(const size_t firstRow, const size_t lastRow, const bool includeAttributes, std::wstring& text) const;
+
     static std::string GenHTML(const TextAndColor& rows,
                                const int fontHeightPoints,
                                const std::wstring_view fontFaceName,
@@ -200,27 +276,90 @@ public:
     void CopyPatterns(const TextBuffer& OtherBuffer);
     interval_tree::IntervalTree<til::point, size_t> GetPatterns(const size_t firstRow, const size_t lastRow) const;
 
+    // The memory this buffer holds, in bytes, by what it holds it for.
+    // The sizes of the hash maps are estimates, since their nodes are
+    // allocated by the standard library.
+    struct MemoryUsage
+    {
+        size_t cells{ 0 };
+        size_t rows{ 0 };
+        size_t attributes{ 0 };
+        size_t unicodeStorage{ 0 };
+        size_t hyperlinks{ 0 };
+        size_t patterns{ 0 };
+    };
+
+    MemoryUsage GetMemoryUsage() const noexcept;
+
 private:
-    void _UpdateSize();
+    void _UpdateSize(const COORD size);
+    static std::pmr::vector<CharRowCell> _AllocateCharBuffer(const COORD size, std::pmr::memory_resource* const resource);
+    gsl::span<CharRowCell> _GetCharBufferSlice(const size_t index, const size_t width) noexcept;
+    void _AllocateRows(const size_t count);
+    bool _IsRowCreated(const size_t index) const noexcept;
+    void _SetBlankRowAttributes(const TextAttribute& attr);
     Microsoft::Console::Types::Viewport _size;
-    std::vector<ROW> _storage;
+    // Cell storage for every row, which are all slices of this one allocation.
+    // Both vectors have the capacity for the whole buffer, but rows are only
+    // created once they're first written to, front to back. They never
+    // reallocate, so rows and their slices stay where they are.
+    std::pmr::vector<CharRowCell> _charBuffer;
+    std::pmr::vector<ROW> _storage;
+    // What every row that hasn't been created yet looks like.
+    std::pmr::vector<CharRowCell> _blankRowCells;
+    TextAttribute _blankRowAttributes;
+    ROW _blankRow;
     Cursor _cursor;
 
     SHORT _firstRow; // indexes top row (not necessarily 0)
+    // The number of rows that aren't single width. ROW::SetLineRendition
+    // keeps it up to date, so that the renderer can tell whether it needs any
+    // line transforms at all without looking at every row.
+    size_t _lineRenditionRowCount;
+    uint64_t _circledRowCount;
+    uint64_t _lastRowGeneration;
+    static uint64_t _NextRowGenerationBase() noexcept;
+
+    // Word navigation (selection, UIA) asks for the delimiter class of the same
+    // few rows over and over again, one cell at a time. We keep the classes of
+    // the most recently used rows, validated against the row's generation.
+    struct DelimiterClassCacheEntry
+    {
+        size_t row;
+        uint64_t generation;
+        std::vector<DelimiterClass> classes;
+    };
+    static constexpr size_t DelimiterClassCacheSize = 8;
+    mutable std::array<DelimiterClassCacheEntry, DelimiterClassCacheSize> _delimiterClassCache;
+    mutable std::wstring _delimiterClassCacheDelimiters;
+    mutable size_t _delimiterClassCacheNext;
 
     TextAttribute _currentAttributes;
 
     // storage location for glyphs that can't fit into the buffer normally
-    UnicodeStorage _unicodeStorage;
 
     std::unordered_map<uint16_t, std::wstring> _hyperlinkMap;
     std::unordered_map<std::wstring, uint16_t> _hyperlinkCustomIdMap;
     uint16_t _currentHyperlinkId;
 
+    // The number of rows referencing each hyperlink, as of the last time the
+    // rows in _hyperlinkCountPendingRows (indices into _storage) were counted.
+    std::unordered_map<uint16_t, size_t> _hyperlinkRowCounts;
+    std::vector<size_t> _hyperlinkCountPendingRows;
+
     void _RefreshRowIDs(std::optional<SHORT> newRowWidth);
+    void _LineRenditionChanged(const LineRendition oldRendition, const LineRendition newRendition) noexcept;
+    void _RecountLineRenditions() noexcept;
+    void _TouchRow(ROW& row);
 
     Microsoft::Console::Render::IRenderTarget& _renderTarget;
 
+    // While painting is deferred, the cells that were written to are only
+    // collected here, and the renderer is told about all of them at once.
+    size_t _deferPaintDepth{ 0 };
+    til::bitmap _deferredPaint;
+    void _FlushDeferredPaint() noexcept;
+
     void _SetFirstRowIndex(const SHORT FirstRowIndex) noexcept;
 
     COORD _GetPreviousFromCursor() const;
@@ -228,7 +367,7 @@ private:
     void _SetWrapOnCurrentRow();
     void _AdjustWrapOnCurrentRow(const bool fSet);
 
-    void _NotifyPaint(const Microsoft::Console::Types::Viewport& viewport) const;
+    void _NotifyPaint(const Microsoft::Console::Types::Viewport& viewport);
 
     // Assist with maintaining proper buffer state for Double Byte character sequences
     bool _PrepareForDoubleByteSequence(const DbcsAttribute dbcsAttribute);
@@ -240,16 +379,21 @@ private:
     void _ExpandTextRow(SMALL_RECT& selectionRow) const;
 
     const DelimiterClass _GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const;
+    const std::vector<DelimiterClass>& _GetRowDelimiterClasses(const size_t row, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const;
     const COORD _GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
 
     void _PruneHyperlinks();
+    void _CountHyperlinks();
+    void _ResetHyperlinkCounts();
 
-    std::unordered_map<size_t, std::wstring> _idsAndPatterns;
+    std::unordered_map<size_t, std::wregex> _idsAndPatterns;
     size_t _currentPatternId;
 
+    friend class ROW;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class UiaTextRangeTests;
@@ -358,3 +358,19 @@ COORD TextBufferCellIterator::Pos() const noexcept
 {
     return _pos;
 }
+
+// Routine Description:
+// - Counts how many cells, starting with the current one, share its text attribute.
+//   The count stops at the right edge of the bounds, so it never spans two rows.
+// Return Value:
+// - The number of cells left in the current attribute run. 0 if the iterator is exhausted.
+size_t TextBufferCellIterator::AttrRunLength() const noexcept
+{
+    if (!*this)
+    {
+        return 0;
+    }
+
+    const auto cellsToEdge = gsl::narrow_cast<size_t>(_bounds.RightInclusive() - _pos.X) + 1;
+    return std::min<size_t>(_attrIter.run_remaining(), cellsToEdge);
+}
@@ -48,6 +48,7 @@ public:
     const OutputCellView* operator->() const noexcept;
 
     COORD Pos() const noexcept;
+    size_t AttrRunLength() const noexcept;
 
 protected:
     void _SetPos(const COORD newPos);
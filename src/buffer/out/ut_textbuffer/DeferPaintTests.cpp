@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../textBuffer.hpp"
+#include "../../renderer/inc/IRenderTarget.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using Microsoft::Console::Types::Viewport;
+
+namespace
+{
+    // Remembers every region the buffer asked to be redrawn.
+    class RecordingRenderTarget final : public Microsoft::Console::Render::IRenderTarget
+    {
+    public:
+        void TriggerRedraw(const Viewport& region) override { regions.push_back(region); }
+        void TriggerRedraw(const COORD* const /*pcoord*/) override {}
+        void TriggerRedrawCursor(const COORD* const /*pcoord*/) override {}
+        void TriggerRedrawAll() override {}
+        void TriggerTeardown() noexcept override {}
+        void TriggerSelection() override {}
+        void TriggerScroll() override {}
+        void TriggerScroll(const COORD* const /*pcoordDelta*/) override {}
+        void TriggerScrollRegion(const Viewport& /*region*/, const COORD* const /*pcoordDelta*/) override {}
+        void TriggerCircling() override { ++circlings; }
+        void TriggerTitleChange() override {}
+        void SynchronizedOutputChanged(const bool /*enabled*/) noexcept override {}
+
+        std::vector<Viewport> regions;
+        size_t circlings{ 0 };
+    };
+}
+
+class DeferPaintTests
+{
+    TEST_CLASS(DeferPaintTests);
+
+    TEST_METHOD(WritesAreNotifiedImmediately)
+    {
+        RecordingRenderTarget target;
+        TextBuffer buffer{ { 10, 5 }, TextAttribute{ 0x7 }, 0, target };
+
+        for (SHORT x = 0; x < 5; ++x)
+        {
+            buffer.Write(OutputCellIterator{ L"A" }, { x, 1 });
+        }
+
+        VERIFY_ARE_EQUAL(5u, target.regions.size());
+    }
+
+    TEST_METHOD(DeferredWritesAreCoalesced)
+    {
+        RecordingRenderTarget target;
+        TextBuffer buffer{ { 10, 5 }, TextAttribute{ 0x7 }, 0, target };
+
+        buffer.StartDeferPaint();
+        for (SHORT x = 0; x < 5; ++x)
+        {
+            buffer.Write(OutputCellIterator{ L"A" }, { x, 1 });
+        }
+        VERIFY_ARE_EQUAL(0u, target.regions.size());
+        buffer.EndDeferPaint();
+
+        VERIFY_ARE_EQUAL(1u, target.regions.size());
+        VERIFY_ARE_EQUAL((SMALL_RECT{ 0, 1, 4, 1 }), target.regions.at(0).ToInclusive());
+    }
+
+    TEST_METHOD(NestedDeferralFlushesAtTheOutermostEnd)
+    {
+        RecordingRenderTarget target;
+        TextBuffer buffer{ { 10, 5 }, TextAttribute{ 0x7 }, 0, target };
+
+        buffer.StartDeferPaint();
+        buffer.StartDeferPaint();
+        buffer.Write(OutputCellIterator{ L"A" }, { 0, 0 });
+        buffer.EndDeferPaint();
+        VERIFY_ARE_EQUAL(0u, target.regions.size());
+
+        buffer.Write(OutputCellIterator{ L"B" }, { 0, 2 });
+        buffer.EndDeferPaint();
+
+        // The two cells aren't adjacent, so they're two separate runs.
+        VERIFY_ARE_EQUAL(2u, target.regions.size());
+    }
+
+    TEST_METHOD(CirclingFlushesPendingRegions)
+    {
+        RecordingRenderTarget target;
+        TextBuffer buffer{ { 10, 5 }, TextAttribute{ 0x7 }, 0, target };
+
+        buffer.StartDeferPaint();
+        buffer.Write(OutputCellIterator{ L"A" }, { 0, 0 });
+        VERIFY_IS_TRUE(buffer.IncrementCircularBuffer());
+
+        // The deferred cell has to be reported in the coordinates it was
+        // written at, before the rows are renumbered.
+        VERIFY_ARE_EQUAL(1u, target.regions.size());
+        VERIFY_ARE_EQUAL(1u, target.circlings);
+
+        buffer.EndDeferPaint();
+        VERIFY_ARE_EQUAL(1u, target.regions.size());
+    }
+};
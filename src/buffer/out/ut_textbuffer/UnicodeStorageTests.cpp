@@ -18,17 +18,16 @@ class UnicodeStorageTests
     TEST_METHOD(CanOverwriteEmoji)
     {
         UnicodeStorage storage;
-        const COORD coord{ 1, 3 };
+        const UnicodeStorage::key_type column = 1;
         const std::vector<wchar_t> newMoon{ 0xD83C, 0xDF11 };
         const std::vector<wchar_t> fullMoon{ 0xD83C, 0xDF15 };
 
         // store initial glyph
-        storage.StoreGlyph(coord, newMoon);
+        storage.StoreGlyph(column, newMoon);
 
         // verify it was stored
-        auto findIt = storage._map.find(coord);
-        VERIFY_ARE_NOT_EQUAL(findIt, storage._map.end());
-        const std::vector<wchar_t>& newMoonGlyph = findIt->second;
+        VERIFY_ARE_EQUAL(1u, storage._glyphs.size());
+        const std::vector<wchar_t>& newMoonGlyph = storage.GetText(column);
         VERIFY_ARE_EQUAL(newMoonGlyph.size(), newMoon.size());
         for (size_t i = 0; i < newMoon.size(); ++i)
         {
@@ -36,16 +35,53 @@ class UnicodeStorageTests
         }
 
         // overwrite it
-        storage.StoreGlyph(coord, fullMoon);
+        storage.StoreGlyph(column, fullMoon);
 
         // verify the glyph was overwritten
-        findIt = storage._map.find(coord);
-        VERIFY_ARE_NOT_EQUAL(findIt, storage._map.end());
-        const std::vector<wchar_t>& fullMoonGlyph = findIt->second;
+        VERIFY_ARE_EQUAL(1u, storage._glyphs.size());
+        const std::vector<wchar_t>& fullMoonGlyph = storage.GetText(column);
         VERIFY_ARE_EQUAL(fullMoonGlyph.size(), fullMoon.size());
         for (size_t i = 0; i < fullMoon.size(); ++i)
         {
             VERIFY_ARE_EQUAL(fullMoonGlyph.at(i), fullMoon.at(i));
         }
     }
+
+    TEST_METHOD(KeepsGlyphsSortedByColumn)
+    {
+        UnicodeStorage storage;
+        const std::vector<wchar_t> newMoon{ 0xD83C, 0xDF11 };
+        const std::vector<wchar_t> fullMoon{ 0xD83C, 0xDF15 };
+        const std::vector<wchar_t> eggplant{ 0xD83C, 0xDF46 };
+
+        // store them out of order
+        storage.StoreGlyph(7, fullMoon);
+        storage.StoreGlyph(2, newMoon);
+        storage.StoreGlyph(40, eggplant);
+
+        VERIFY_ARE_EQUAL(3u, storage._glyphs.size());
+        VERIFY_ARE_EQUAL(2u, storage._glyphs[0].first);
+        VERIFY_ARE_EQUAL(7u, storage._glyphs[1].first);
+        VERIFY_ARE_EQUAL(40u, storage._glyphs[2].first);
+        VERIFY_IS_TRUE(fullMoon == storage.GetText(7));
+
+        // columns that were never stored can't be read
+        VERIFY_THROWS(storage.GetText(3), wil::ResultException);
+
+        // erasing a column that isn't stored does nothing
+        storage.Erase(3);
+        VERIFY_ARE_EQUAL(3u, storage._glyphs.size());
+
+        storage.Erase(2);
+        VERIFY_ARE_EQUAL(2u, storage._glyphs.size());
+        VERIFY_ARE_EQUAL(7u, storage._glyphs[0].first);
+
+        // truncating drops everything at or beyond the new width
+        storage.Truncate(40);
+        VERIFY_ARE_EQUAL(1u, storage._glyphs.size());
+        VERIFY_ARE_EQUAL(7u, storage._glyphs[0].first);
+
+        storage.Clear();
+        VERIFY_ARE_EQUAL(0u, storage._glyphs.size());
+    }
 };
@@ -0,0 +1,216 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "HeadlessTerminal.hpp"
+
+using namespace ::Microsoft::Terminal::Core;
+
+HeadlessTerminal::HeadlessTerminal(const COORD size, const SHORT scrollback)
+{
+    // The terminal calls most of its callbacks unconditionally. Nobody is
+    // around to ring a bell or change a title, so they're all no-ops.
+    _terminal.SetWarningBellCallback([]() {});
+    _terminal.SetTitleChangedCallback([](auto) {});
+    _terminal.SetTabColorChangedCallback([](auto) {});
+    _terminal.SetCopyToClipboardCallback([](auto) {});
+    _terminal.SetScrollPositionChangedCallback([](auto, auto, auto) {});
+    _terminal.SetCursorPositionChangedCallback([]() {});
+    _terminal.SetBackgroundCallback([](auto) {});
+    _terminal.TaskbarProgressChangedCallback([]() {});
+
+    // Responses to queries, like DA or DSR, are what the application would
+    // have read from its input.
+    _terminal.SetWriteInputCallback([this](const std::wstring_view input) noexcept {
+        if (_pfnWriteCallback)
+        {
+            try
+            {
+                _pfnWriteCallback(input.data(), input.size());
+            }
+            CATCH_LOG();
+        }
+    });
+
+    _terminal.Create(size, scrollback, _renderTarget);
+}
+
+void HeadlessTerminal::Write(std::wstring_view data)
+{
+    _terminal.Write(data);
+}
+
+// Method Description:
+// - Writes UTF-8 output to the terminal. A multi-byte sequence may be split
+//   across two calls, the partial sequence is kept until the next call.
+// Arguments:
+// - data: the UTF-8 text to write.
+void HeadlessTerminal::WriteUtf8(std::string_view data)
+{
+    THROW_IF_FAILED(til::u8u16(data, _u16Output, _u8State));
+    _terminal.Write(_u16Output);
+}
+
+HRESULT HeadlessTerminal::Resize(const COORD size)
+{
+    auto lock = _terminal.LockForWriting();
+    return _terminal.UserResize(size);
+}
+
+// Method Description:
+// - Gets the mutable viewport, the part of the buffer rows written by the
+//   application end up in, in buffer coordinates.
+SMALL_RECT HeadlessTerminal::GetViewport()
+{
+    auto lock = _terminal.LockForReading();
+    return _terminal.GetViewport().ToInclusive();
+}
+
+// Method Description:
+// - Gets the cursor position, relative to the viewport.
+COORD HeadlessTerminal::GetCursorPosition()
+{
+    auto lock = _terminal.LockForReading();
+    const auto position = _terminal.GetCursorPosition();
+    return { position.X, gsl::narrow_cast<SHORT>(position.Y - _terminal.GetViewport().Top()) };
+}
+
+// Method Description:
+// - Copies the text and the resolved colors and attributes of the cells
+//   in one row of the buffer.
+// Arguments:
+// - row: the row, relative to the viewport. Negative values are rows in the scrollback.
+// - cells: receives the cells, from the start of the row.
+// Return Value:
+// - The number of cells written, at most the width of the buffer.
+size_t HeadlessTerminal::SnapshotRow(const SHORT row, gsl::span<HeadlessTerminalCell> cells)
+{
+    auto lock = _terminal.LockForReading();
+
+    const auto& buffer = _terminal.GetTextBuffer();
+    const auto bufferSize = buffer.GetSize();
+    const auto y = row + _terminal.GetViewport().Top();
+    THROW_HR_IF(E_INVALIDARG, y < 0 || y >= bufferSize.Height());
+
+    const auto count = std::min<size_t>(cells.size(), bufferSize.Width());
+    auto it = buffer.GetCellDataAt({ 0, gsl::narrow_cast<SHORT>(y) });
+    for (size_t i = 0; i < count && it; ++i, ++it)
+    {
+        auto& cell = til::at(cells, i);
+        const auto chars = it->Chars();
+        const auto& attr = it->TextAttr();
+        const auto dbcs = it->DbcsAttr();
+        const auto [foreground, background] = _terminal.GetAttributeColors(attr);
+
+        cell = {};
+        if (!dbcs.IsTrailing())
+        {
+            const auto length = std::min<size_t>(chars.size(), std::size(cell.Text));
+            std::copy_n(chars.begin(), length, std::begin(cell.Text));
+        }
+        cell.Foreground = foreground;
+        cell.Background = background;
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_BOLD, attr.IsBold());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_FAINT, attr.IsFaint());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_ITALIC, attr.IsItalic());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_UNDERLINED, attr.IsUnderlined());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_DOUBLY_UNDERLINED, attr.IsDoublyUnderlined());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_CROSSED_OUT, attr.IsCrossedOut());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_BLINKING, attr.IsBlinking());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_INVISIBLE, attr.IsInvisible());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_LEADING_HALF, dbcs.IsLeading());
+        WI_SetFlagIf(cell.Flags, HEADLESS_TERMINAL_CELL_TRAILING_HALF, dbcs.IsTrailing());
+    }
+    return count;
+}
+
+void HeadlessTerminal::RegisterWriteCallback(std::function<void(const wchar_t*, size_t)> callback) noexcept
+{
+    auto lock = _terminal.LockForWriting();
+    _pfnWriteCallback = std::move(callback);
+}
+
+HRESULT _stdcall HeadlessTerminalCreate(_In_ short width, _In_ short height, _In_ short scrollback, _Out_ void** terminal)
+try
+{
+    *terminal = nullptr;
+    RETURN_HR_IF(E_INVALIDARG, width <= 0 || height <= 0 || scrollback < 0);
+
+    auto headlessTerminal = std::make_unique<HeadlessTerminal>(COORD{ width, height }, scrollback);
+    *terminal = headlessTerminal.release();
+    return S_OK;
+}
+CATCH_RETURN()
+
+void _stdcall HeadlessTerminalDestroy(_In_ void* terminal)
+{
+    delete static_cast<HeadlessTerminal*>(terminal);
+}
+
+HRESULT _stdcall HeadlessTerminalWrite(_In_ void* terminal, _In_reads_(length) const wchar_t* data, _In_ size_t length)
+try
+{
+    const auto headlessTerminal = static_cast<HeadlessTerminal*>(terminal);
+    headlessTerminal->Write({ data, length });
+    return S_OK;
+}
+CATCH_RETURN()
+
+HRESULT _stdcall HeadlessTerminalWriteUtf8(_In_ void* terminal, _In_reads_(length) const char* data, _In_ size_t length)
+try
+{
+    const auto headlessTerminal = static_cast<HeadlessTerminal*>(terminal);
+    headlessTerminal->WriteUtf8({ data, length });
+    return S_OK;
+}
+CATCH_RETURN()
+
+HRESULT _stdcall HeadlessTerminalResize(_In_ void* terminal, _In_ short width, _In_ short height)
+try
+{
+    RETURN_HR_IF(E_INVALIDARG, width <= 0 || height <= 0);
+    const auto headlessTerminal = static_cast<HeadlessTerminal*>(terminal);
+    return headlessTerminal->Resize({ width, height });
+}
+CATCH_RETURN()
+
+HRESULT _stdcall HeadlessTerminalGetViewport(_In_ void* terminal, _Out_ SMALL_RECT* viewport)
+try
+{
+    const auto headlessTerminal = static_cast<HeadlessTerminal*>(terminal);
+    *viewport = headlessTerminal->GetViewport();
+    return S_OK;
+}
+CATCH_RETURN()
+
+HRESULT _stdcall HeadlessTerminalGetCursorPosition(_In_ void* terminal, _Out_ COORD* position)
+try
+{
+    const auto headlessTerminal = static_cast<HeadlessTerminal*>(terminal);
+    *position = headlessTerminal->GetCursorPosition();
+    return S_OK;
+}
+CATCH_RETURN()
+
+HRESULT _stdcall HeadlessTerminalSnapshotRow(_In_ void* terminal, _In_ short row, _Out_writes_to_(count, *written) HeadlessTerminalCell* cells, _In_ size_t count, _Out_ size_t* written)
+try
+{
+    *written = 0;
+    const auto headlessTerminal = static_cast<HeadlessTerminal*>(terminal);
+    *written = headlessTerminal->SnapshotRow(row, { cells, count });
+    return S_OK;
+}
+CATCH_RETURN()
+
+void _stdcall HeadlessTerminalRegisterWriteCallback(_In_ void* terminal, void __stdcall callback(void*, const wchar_t*, size_t), _In_opt_ void* context)
+{
+    const auto headlessTerminal = static_cast<HeadlessTerminal*>(terminal);
+    if (callback)
+    {
+        headlessTerminal->RegisterWriteCallback([=](const wchar_t* data, size_t length) { callback(context, data, length); });
+    }
+    else
+    {
+        headlessTerminal->RegisterWriteCallback(nullptr);
+    }
+}
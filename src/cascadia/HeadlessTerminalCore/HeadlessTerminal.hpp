@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "../../cascadia/TerminalCore/Terminal.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
+
+// Keep in sync with the consumers of this library.
+typedef struct _HeadlessTerminalCell
+{
+    // The cell's text, one or two UTF-16 code units, null padded. Empty for
+    // the trailing half of a wide glyph.
+    wchar_t Text[2];
+    COLORREF Foreground;
+    COLORREF Background;
+    uint16_t Flags; // A combination of the HEADLESS_TERMINAL_CELL_* flags below.
+    uint16_t Reserved;
+} HeadlessTerminalCell, *LPHeadlessTerminalCell;
+
+#define HEADLESS_TERMINAL_CELL_BOLD 0x0001
+#define HEADLESS_TERMINAL_CELL_FAINT 0x0002
+#define HEADLESS_TERMINAL_CELL_ITALIC 0x0004
+#define HEADLESS_TERMINAL_CELL_UNDERLINED 0x0008
+#define HEADLESS_TERMINAL_CELL_DOUBLY_UNDERLINED 0x0010
+#define HEADLESS_TERMINAL_CELL_CROSSED_OUT 0x0020
+#define HEADLESS_TERMINAL_CELL_BLINKING 0x0040
+#define HEADLESS_TERMINAL_CELL_INVISIBLE 0x0080
+#define HEADLESS_TERMINAL_CELL_LEADING_HALF 0x0100
+#define HEADLESS_TERMINAL_CELL_TRAILING_HALF 0x0200
+
+extern "C" {
+__declspec(dllexport) HRESULT _stdcall HeadlessTerminalCreate(_In_ short width, _In_ short height, _In_ short scrollback, _Out_ void** terminal);
+__declspec(dllexport) void _stdcall HeadlessTerminalDestroy(_In_ void* terminal);
+__declspec(dllexport) HRESULT _stdcall HeadlessTerminalWrite(_In_ void* terminal, _In_reads_(length) const wchar_t* data, _In_ size_t length);
+__declspec(dllexport) HRESULT _stdcall HeadlessTerminalWriteUtf8(_In_ void* terminal, _In_reads_(length) const char* data, _In_ size_t length);
+__declspec(dllexport) HRESULT _stdcall HeadlessTerminalResize(_In_ void* terminal, _In_ short width, _In_ short height);
+__declspec(dllexport) HRESULT _stdcall HeadlessTerminalGetViewport(_In_ void* terminal, _Out_ SMALL_RECT* viewport);
+__declspec(dllexport) HRESULT _stdcall HeadlessTerminalGetCursorPosition(_In_ void* terminal, _Out_ COORD* position);
+__declspec(dllexport) HRESULT _stdcall HeadlessTerminalSnapshotRow(_In_ void* terminal, _In_ short row, _Out_writes_to_(count, *written) HeadlessTerminalCell* cells, _In_ size_t count, _Out_ size_t* written);
+__declspec(dllexport) void _stdcall HeadlessTerminalRegisterWriteCallback(_In_ void* terminal, void __stdcall callback(void*, const wchar_t*, size_t), _In_opt_ void* context);
+};
+
+// A Terminal without a renderer, window or XAML island. It only owns the
+// emulator state (the buffer and the state machine), so that callers can run
+// a great number of them side by side, feed them output and inspect the
+// resulting cells. All functions are safe to call from any thread.
+struct HeadlessTerminal
+{
+public:
+    HeadlessTerminal(const COORD size, const SHORT scrollback);
+
+    void Write(std::wstring_view data);
+    void WriteUtf8(std::string_view data);
+    HRESULT Resize(const COORD size);
+    SMALL_RECT GetViewport();
+    COORD GetCursorPosition();
+    size_t SnapshotRow(const SHORT row, gsl::span<HeadlessTerminalCell> cells);
+    void RegisterWriteCallback(std::function<void(const wchar_t*, size_t)> callback) noexcept;
+
+private:
+    // The buffer keeps a reference to the render target, it must outlive the terminal.
+    DummyRenderTarget _renderTarget;
+    ::Microsoft::Terminal::Core::Terminal _terminal;
+    std::function<void(const wchar_t*, size_t)> _pfnWriteCallback;
+
+    // Carries incomplete UTF-8 sequences from one WriteUtf8 call to the
+    // next, and keeps the converted text's allocation around between calls.
+    til::u8state _u8State;
+    std::wstring _u16Output;
+};
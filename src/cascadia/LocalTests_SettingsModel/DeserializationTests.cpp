@@ -86,6 +86,7 @@ namespace SettingsModelLocalTests
 
         TEST_METHOD(TestCopy);
         TEST_METHOD(TestCloneInheritanceTree);
+        TEST_METHOD(TestCopySharesInheritedLayers);
 
         TEST_METHOD(TestValidDefaults);
 
@@ -2756,6 +2757,80 @@ namespace SettingsModelLocalTests
         verifyEmptyPD(missingPDJson);
     }
 
+    void DeserializationTests::TestCopySharesInheritedLayers()
+    {
+        const std::string inboxJson{ R"(
+        {
+            "profiles": [
+                {
+                    "name": "CMD",
+                    "guid": "{61c54bbd-1111-5271-96e7-009a87ff44bf}"
+                }
+            ],
+            "actions": [
+                { "command": "closePane", "keys": "ctrl+shift+w" }
+            ]
+        })" };
+        const std::string userJson{ R"(
+        {
+            "defaultProfile": "{61c54bbd-1111-5271-96e7-009a87ff44bf}",
+            "profiles":
+            {
+                "defaults": {
+                    "historySize": 1
+                },
+                "list": [
+                    {
+                        "guid": "{61c54bbd-1111-5271-96e7-009a87ff44bf}",
+                        "name": "Custom CMD"
+                    }
+                ]
+            },
+            "actions": [
+                { "command": "closePane", "keys": "ctrl+alt+w" }
+            ]
+        })" };
+
+        VerifyParseSucceeded(inboxJson);
+        VerifyParseSucceeded(userJson);
+
+        auto settings{ winrt::make_self<implementation::CascadiaSettings>() };
+        settings->_ParseJsonString(inboxJson, true);
+        settings->LayerJson(settings->_defaultSettings);
+        settings->_ParseJsonString(userJson, false);
+        settings->_ApplyDefaultsFromUserSettings();
+        settings->LayerJson(settings->_userSettings);
+        settings->_ValidateSettings();
+
+        const auto copy{ settings->Copy() };
+        const auto copyImpl{ winrt::get_self<implementation::CascadiaSettings>(copy) };
+
+        Log::Comment(L"The user's layer is copied...");
+        auto srcProfile{ winrt::get_self<implementation::Profile>(settings->_allProfiles.GetAt(0)) };
+        auto copyProfile{ winrt::get_self<implementation::Profile>(copyImpl->_allProfiles.GetAt(0)) };
+        VERIFY_ARE_NOT_EQUAL(srcProfile, copyProfile);
+        VERIFY_ARE_NOT_EQUAL(settings->_userDefaultProfileSettings.get(), copyImpl->_userDefaultProfileSettings.get());
+        VERIFY_ARE_NOT_EQUAL(settings->_globals.get(), copyImpl->_globals.get());
+        VERIFY_ARE_NOT_EQUAL(settings->_globals->_actionMap.get(), copyImpl->_globals->_actionMap.get());
+
+        Log::Comment(L"...and hooked up to the copy of profile.defaults...");
+        VERIFY_ARE_EQUAL(2u, copyProfile->Parents().size());
+        VERIFY_ARE_EQUAL(copyImpl->_userDefaultProfileSettings.get(), copyProfile->Parents().at(0).get());
+        VERIFY_ARE_EQUAL(1, copyProfile->HistorySize());
+
+        Log::Comment(L"...while the layers below it are shared.");
+        VERIFY_ARE_EQUAL(srcProfile->Parents().at(1).get(), copyProfile->Parents().at(1).get());
+        VERIFY_ARE_EQUAL(settings->_globals->Parents().at(0).get(), copyImpl->_globals->Parents().at(0).get());
+        VERIFY_ARE_EQUAL(settings->_globals->_actionMap->Parents().at(0).get(), copyImpl->_globals->_actionMap->Parents().at(0).get());
+
+        Log::Comment(L"Changing the copy doesn't change the original.");
+        copyProfile->Name(L"changed value");
+        copyImpl->_userDefaultProfileSettings->HistorySize(2);
+        VERIFY_ARE_EQUAL(L"Custom CMD", srcProfile->Name());
+        VERIFY_ARE_EQUAL(1, srcProfile->HistorySize());
+        VERIFY_ARE_EQUAL(2, copyProfile->HistorySize());
+    }
+
     void DeserializationTests::TestValidDefaults()
     {
         // GH#8146: A LoadDefaults call should populate the list of active profiles
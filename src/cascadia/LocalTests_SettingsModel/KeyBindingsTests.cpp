@@ -41,6 +41,7 @@ namespace SettingsModelLocalTests
         TEST_METHOD(LayerKeybindings);
         TEST_METHOD(UnbindKeybindings);
         TEST_METHOD(TestExplicitUnbind);
+        TEST_METHOD(TestLookupThroughLayers);
         TEST_METHOD(TestArbitraryArgs);
         TEST_METHOD(TestSplitPaneArgs);
 
@@ -257,6 +258,39 @@ namespace SettingsModelLocalTests
         VERIFY_IS_FALSE(actionMap->IsKeyChordExplicitlyUnbound(keyChord));
     }
 
+    void KeyBindingsTests::TestLookupThroughLayers()
+    {
+        const std::string parentString{ R"([ { "command": "copy", "keys": ["ctrl+c"] }, { "command": "paste", "keys": ["ctrl+v"] } ])" };
+        const std::string childString{ R"([ { "command": "unbound", "keys": ["ctrl+c"] } ])" };
+
+        const auto parentJson = VerifyParseSucceeded(parentString);
+        const auto childJson = VerifyParseSucceeded(childString);
+
+        const KeyChord ctrlC{ VirtualKeyModifiers::Control, static_cast<int32_t>('C'), 0 };
+        const KeyChord ctrlV{ VirtualKeyModifiers::Control, static_cast<int32_t>('V'), 0 };
+        const KeyChord ctrlX{ VirtualKeyModifiers::Control, static_cast<int32_t>('X'), 0 };
+
+        auto parent = winrt::make_self<implementation::ActionMap>();
+        parent->LayerJson(parentJson);
+        auto child = parent->CreateChild();
+        child->LayerJson(childJson);
+
+        Log::Comment(L"Key chords resolve in the closest layer that binds them");
+        VERIFY_IS_NULL(child->GetActionByKeyChord(ctrlC));
+        VERIFY_IS_TRUE(child->IsKeyChordExplicitlyUnbound(ctrlC));
+        VERIFY_ARE_EQUAL(ShortcutAction::PasteText, child->GetActionByKeyChord(ctrlV).ActionAndArgs().Action());
+        VERIFY_IS_NULL(child->GetActionByKeyChord(ctrlX));
+        VERIFY_IS_FALSE(child->IsKeyChordExplicitlyUnbound(ctrlX));
+        VERIFY_ARE_EQUAL(ShortcutAction::CopyText, parent->GetActionByKeyChord(ctrlC).ActionAndArgs().Action());
+
+        Log::Comment(L"Binding a key chord updates the lookup");
+        child->RegisterKeyBinding(ctrlV, ActionAndArgs{ ShortcutAction::CopyText, nullptr });
+        child->RegisterKeyBinding(ctrlX, ActionAndArgs{ ShortcutAction::PasteText, nullptr });
+        VERIFY_ARE_EQUAL(ShortcutAction::CopyText, child->GetActionByKeyChord(ctrlV).ActionAndArgs().Action());
+        VERIFY_ARE_EQUAL(ShortcutAction::PasteText, child->GetActionByKeyChord(ctrlX).ActionAndArgs().Action());
+        VERIFY_ARE_EQUAL(ShortcutAction::PasteText, parent->GetActionByKeyChord(ctrlV).ActionAndArgs().Action());
+    }
+
     void KeyBindingsTests::TestArbitraryArgs()
     {
         const std::string bindings0String{ R"([
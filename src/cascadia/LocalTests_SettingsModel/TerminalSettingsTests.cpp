@@ -42,6 +42,8 @@ namespace SettingsModelLocalTests
 
         TEST_METHOD(TestLayerProfileOnColorScheme);
 
+        TEST_METHOD(TestCachedProfileSettings);
+
         TEST_CLASS_SETUP(ClassSetup)
         {
             return true;
@@ -554,4 +556,56 @@ namespace SettingsModelLocalTests
         VERIFY_ARE_EQUAL(ARGB(0, 0x45, 0x67, 0x89), terminalSettings4->CursorColor()); // from profile (no color scheme)
         VERIFY_ARE_EQUAL(DEFAULT_CURSOR_COLOR, terminalSettings5->CursorColor()); // default
     }
+
+    void TerminalSettingsTests::TestCachedProfileSettings()
+    {
+        Log::Comment(NoThrowString().Format(
+            L"Ensure that the settings made from a cached profile don't share anything the caller can change."));
+
+        const std::string settingsJson{ R"(
+        {
+            "defaultProfile": "{6239a42c-0000-49a3-80bd-e8fdd045185c}",
+            "profiles": [
+                {
+                    "name": "profile0",
+                    "guid": "{6239a42c-0000-49a3-80bd-e8fdd045185c}",
+                    "commandline": "cmd.exe",
+                    "cursorColor": "#123456",
+                    "unfocusedAppearance": { "cursorShape": "bar" }
+                }
+            ]
+        })" };
+
+        const winrt::guid guid0{ ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-0000-49a3-80bd-e8fdd045185c}") };
+
+        CascadiaSettings settings{ til::u8u16(settingsJson) };
+
+        const auto settingsStruct0{ TerminalSettings::CreateWithProfileByID(settings, guid0, nullptr) };
+        const auto settingsStruct1{ TerminalSettings::CreateWithProfileByID(settings, guid0, nullptr) };
+        const auto settings0{ settingsStruct0.DefaultSettings() };
+        const auto settings1{ settingsStruct1.DefaultSettings() };
+
+        Log::Comment(L"Both are children of the same cached settings");
+        VERIFY_IS_FALSE(settings0 == settings1);
+        VERIFY_IS_NOT_NULL(settings0.GetParent());
+        VERIFY_IS_TRUE(settings0.GetParent() == settings1.GetParent());
+        VERIFY_ARE_EQUAL(1u, winrt::get_self<implementation::CascadiaSettings>(settings)->_terminalSettingsCache.size());
+
+        Log::Comment(L"Changing one of them doesn't change the other");
+        settings0.Commandline(L"pwsh.exe");
+        VERIFY_ARE_EQUAL(L"pwsh.exe", settings0.Commandline());
+        VERIFY_ARE_EQUAL(L"cmd.exe", settings1.Commandline());
+
+        Log::Comment(L"Each gets its own unfocused settings, with the unfocused appearance");
+        const auto unfocused0{ settingsStruct0.UnfocusedSettings() };
+        const auto unfocused1{ settingsStruct1.UnfocusedSettings() };
+        VERIFY_IS_NOT_NULL(unfocused0);
+        VERIFY_IS_NOT_NULL(unfocused1);
+        VERIFY_IS_FALSE(unfocused0 == unfocused1);
+        VERIFY_IS_TRUE(settings0 == unfocused0.GetParent());
+        VERIFY_ARE_EQUAL(winrt::Microsoft::Terminal::Core::CursorStyle::Bar, unfocused0.CursorShape());
+        VERIFY_ARE_EQUAL(ARGB(0, 0x12, 0x34, 0x56), unfocused0.CursorColor());
+        VERIFY_ARE_EQUAL(L"pwsh.exe", unfocused0.Commandline());
+        VERIFY_ARE_EQUAL(L"cmd.exe", unfocused1.Commandline());
+    }
 }
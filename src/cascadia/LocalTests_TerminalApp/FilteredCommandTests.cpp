@@ -26,6 +26,7 @@ namespace TerminalAppLocalTests
         TEST_METHOD(VerifyWeight);
         TEST_METHOD(VerifyCompare);
         TEST_METHOD(VerifyCompareIgnoreCase);
+        TEST_METHOD(VerifyUpdateFilterNarrowing);
     };
 
     void FilteredCommandTests::VerifyHighlighting()
@@ -229,4 +230,44 @@ namespace TerminalAppLocalTests
 
         VERIFY_SUCCEEDED(result);
     }
+
+    void FilteredCommandTests::VerifyUpdateFilterNarrowing()
+    {
+        auto result = RunOnUIThread([]() {
+            const auto paletteItem{ winrt::make<winrt::TerminalApp::implementation::CommandLinePaletteItem>(L"Close Tab") };
+            const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
+
+            Log::Comment(L"A filter that doesn't match, and a filter that extends it");
+            filteredCommand->UpdateFilter(L"x");
+            VERIFY_ARE_EQUAL(0, filteredCommand->Weight());
+            filteredCommand->UpdateFilter(L"xt");
+            VERIFY_ARE_EQUAL(0, filteredCommand->Weight());
+            VERIFY_ARE_EQUAL(L"xt", filteredCommand->Filter());
+            VERIFY_ARE_EQUAL(1u, filteredCommand->HighlightedName().Segments().Size());
+
+            Log::Comment(L"A filter that doesn't extend the previous one is matched from scratch");
+            filteredCommand->UpdateFilter(L"t");
+            VERIFY_IS_GREATER_THAN(filteredCommand->Weight(), 0);
+
+            Log::Comment(L"Extending a filter that matched keeps matching");
+            filteredCommand->UpdateFilter(L"ct");
+            VERIFY_IS_GREATER_THAN(filteredCommand->Weight(), 0);
+            auto segments = filteredCommand->HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(4u, segments.Size());
+            VERIFY_ARE_EQUAL(L"C", segments.GetAt(0).TextSegment());
+            VERIFY_IS_TRUE(segments.GetAt(0).IsHighlighted());
+            VERIFY_ARE_EQUAL(L"T", segments.GetAt(2).TextSegment());
+            VERIFY_IS_TRUE(segments.GetAt(2).IsHighlighted());
+
+            Log::Comment(L"Going back to the empty filter shows the whole name again");
+            filteredCommand->UpdateFilter(L"");
+            VERIFY_ARE_EQUAL(0, filteredCommand->Weight());
+            segments = filteredCommand->HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(1u, segments.Size());
+            VERIFY_ARE_EQUAL(L"Close Tab", segments.GetAt(0).TextSegment());
+            VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
+        });
+
+        VERIFY_SUCCEEDED(result);
+    }
 }
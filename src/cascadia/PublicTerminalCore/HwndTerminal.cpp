@@ -241,7 +241,7 @@ HRESULT HwndTerminal::Initialize()
     _terminal->Create(COORD{ 80, 25 }, 1000, *_renderer);
     _terminal->SetDefaultBackground(RGB(12, 12, 12));
     _terminal->SetDefaultForeground(RGB(204, 204, 204));
-    _terminal->SetWriteInputCallback([=](std::wstring& input) noexcept { _WriteTextToConnection(input); });
+    _terminal->SetWriteInputCallback([=](const std::wstring_view input) noexcept { _WriteTextToConnection(input); });
     localPointerToThread->EnablePainting();
 
     _multiClickTime = std::chrono::milliseconds{ GetDoubleClickTime() };
@@ -281,8 +281,20 @@ void HwndTerminal::RegisterScrollCallback(std::function<void(int, int, int)> cal
     _terminal->SetScrollPositionChangedCallback(callback);
 }
 
-void HwndTerminal::_WriteTextToConnection(const std::wstring& input) noexcept
+void HwndTerminal::_WriteTextToConnection(const std::wstring_view input) noexcept
 {
+    // The buffer callback borrows our string for the duration of the call,
+    // so there's nothing to allocate here, or to free on the other side.
+    if (_pfnWriteBufferCallback)
+    {
+        try
+        {
+            _pfnWriteBufferCallback(input.data(), input.size());
+        }
+        CATCH_LOG();
+        return;
+    }
+
     if (!_pfnWriteCallback)
     {
         return;
@@ -301,6 +313,11 @@ void HwndTerminal::RegisterWriteCallback(const void _stdcall callback(wchar_t*))
     _pfnWriteCallback = callback;
 }
 
+void HwndTerminal::RegisterWriteBufferCallback(std::function<void(const wchar_t*, size_t)> callback)
+{
+    _pfnWriteBufferCallback = std::move(callback);
+}
+
 ::Microsoft::Console::Types::IUiaData* HwndTerminal::GetUiaData() const noexcept
 {
     return _terminal.get();
@@ -380,6 +397,17 @@ void HwndTerminal::SendOutput(std::wstring_view data)
     _terminal->Write(data);
 }
 
+// Method Description:
+// - Writes UTF-8 output to the terminal. A multi-byte sequence may be split
+//   across two calls, the partial sequence is kept until the next call.
+// Arguments:
+// - data: the UTF-8 text to write.
+void HwndTerminal::SendOutputUtf8(std::string_view data)
+{
+    THROW_IF_FAILED(til::u8u16(data, _u16Output, _u8State));
+    _terminal->Write(_u16Output);
+}
+
 HRESULT _stdcall CreateTerminal(HWND parentHwnd, _Out_ void** hwnd, _Out_ void** terminal)
 {
     // In order for UIA to hook up properly there needs to be a "static" window hosting the
@@ -422,12 +450,41 @@ void _stdcall TerminalRegisterWriteCallback(void* terminal, const void __stdcall
     publicTerminal->RegisterWriteCallback(callback);
 }
 
+void _stdcall TerminalRegisterWriteBufferCallback(void* terminal, void __stdcall callback(const wchar_t*, size_t))
+{
+    const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
+    publicTerminal->RegisterWriteBufferCallback(callback);
+}
+
 void _stdcall TerminalSendOutput(void* terminal, LPCWSTR data)
 {
     const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
     publicTerminal->SendOutput(data);
 }
 
+// Routine Description:
+// - Writes length characters of UTF-16 output to the terminal. Unlike
+//   TerminalSendOutput, the data doesn't need to be null terminated, and the
+//   caller keeps ownership of it. It isn't used after the call returns.
+void _stdcall TerminalSendOutputBuffer(void* terminal, const wchar_t* data, size_t length)
+{
+    const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
+    publicTerminal->SendOutput({ data, length });
+}
+
+// Routine Description:
+// - Writes length bytes of UTF-8 output to the terminal, see TerminalSendOutputBuffer.
+// Return Value:
+// - S_OK, or an error if the text couldn't be converted.
+HRESULT _stdcall TerminalSendOutputUtf8Buffer(void* terminal, const char* data, size_t length)
+try
+{
+    const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
+    publicTerminal->SendOutputUtf8({ data, length });
+    return S_OK;
+}
+CATCH_RETURN()
+
 /// <summary>
 /// Triggers a terminal resize using the new width and height in pixel.
 /// </summary>
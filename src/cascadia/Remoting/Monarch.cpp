@@ -31,7 +31,8 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
     // This is a private constructor to be used in unit tests, where we don't
     // want each Monarch to necessarily use the current PID.
     Monarch::Monarch(const uint64_t testPID) :
-        _ourPID{ testPID }
+        _ourPID{ testPID },
+        _watchPeasantProcesses{ false }
     {
     }
 
@@ -77,8 +78,22 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
             peasant.WindowActivated({ this, &Monarch::_peasantWindowActivated });
             peasant.IdentifyWindowsRequested({ this, &Monarch::_identifyWindows });
             peasant.RenameRequested({ this, &Monarch::_renameRequested });
+            peasant.WindowNameChanged([this, newPeasantsId](auto&&, const winrt::hstring& name) {
+                _peasantNameChanged(newPeasantsId, name);
+            });
+
+            // Ask for the peasant's name and process now, once. From here on,
+            // the peasant tells us about its name, and we can check if it's
+            // still alive with the process handle, without an RPC.
+            PeasantInfo info{ peasant.WindowName() };
+            if (_watchPeasantProcesses)
+            {
+                info.process.reset(OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(peasant.GetPID())));
+                LOG_LAST_ERROR_IF(!info.process);
+            }
 
             _peasants[newPeasantsId] = peasant;
+            _peasantInfos[newPeasantsId] = std::move(info);
 
             TraceLoggingWrite(g_hRemotingProvider,
                               "Monarch_AddPeasant",
@@ -130,31 +145,101 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         {
             const auto peasantSearch = _peasants.find(peasantID);
             auto maybeThePeasant = peasantSearch == _peasants.end() ? nullptr : peasantSearch->second;
-            // Ask the peasant for their PID. This will validate that they're
-            // actually still alive.
-            if (maybeThePeasant)
+            if (maybeThePeasant && !_isPeasantAlive(peasantID, maybeThePeasant))
             {
-                maybeThePeasant.GetPID();
+                _removePeasant(peasantID);
+                return nullptr;
             }
             return maybeThePeasant;
         }
         catch (...)
         {
             LOG_CAUGHT_EXCEPTION();
-            // Remove the peasant from the list of peasants
-            _peasants.erase(peasantID);
-
-            // Remove the peasant from the list of MRU windows. They're dead.
-            // They can't be the MRU anymore.
-            _clearOldMruEntries(peasantID);
+            _removePeasant(peasantID);
             return nullptr;
         }
     }
 
+    // Method Description:
+    // - Check if the given peasant is still alive. If we have a handle to its
+    //   process, that's a local check. Otherwise, ask the peasant for its PID,
+    //   which fails if it has died.
+    // Arguments:
+    // - peasantID: The ID of the peasant to check
+    // - peasant: The peasant to check. This might be out-of-proc!
+    // Return Value:
+    // - false if the peasant has died.
+    bool Monarch::_isPeasantAlive(const uint64_t peasantID, const Remoting::IPeasant& peasant) const
+    {
+        const auto infoSearch = _peasantInfos.find(peasantID);
+        if (infoSearch != _peasantInfos.end() && infoSearch->second.process)
+        {
+            return WaitForSingleObject(infoSearch->second.process.get(), 0) == WAIT_TIMEOUT;
+        }
+
+        try
+        {
+            peasant.GetPID();
+            return true;
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            return false;
+        }
+    }
+
+    // Method Description:
+    // - Forget about a peasant that has died.
+    // Arguments:
+    // - peasantID: The ID of the dead peasant
+    // Return Value:
+    // - <none>
+    void Monarch::_removePeasant(const uint64_t peasantID)
+    {
+        // Remove the peasant from the list of peasants
+        _peasants.erase(peasantID);
+        _peasantInfos.erase(peasantID);
+
+        // Remove the peasant from the list of MRU windows. They're dead.
+        // They can't be the MRU anymore.
+        _clearOldMruEntries(peasantID);
+    }
+
+    // Method Description:
+    // - Event handler for the Peasant::WindowNameChanged event. Updates our
+    //   copy of the peasant's name.
+    // Arguments:
+    // - peasantID: The ID of the peasant that was renamed
+    // - name: The peasant's new name
+    // Return Value:
+    // - <none>
+    void Monarch::_peasantNameChanged(const uint64_t peasantID, const winrt::hstring& name)
+    {
+        const auto infoSearch = _peasantInfos.find(peasantID);
+        if (infoSearch != _peasantInfos.end())
+        {
+            infoSearch->second.name = name;
+        }
+    }
+
+    // Method Description:
+    // - Get our copy of the name of the given peasant.
+    // Arguments:
+    // - peasantID: The ID of the peasant
+    // Return Value:
+    // - The name of the peasant, or an empty string if we don't know it.
+    winrt::hstring Monarch::_getPeasantName(const uint64_t peasantID) const
+    {
+        const auto infoSearch = _peasantInfos.find(peasantID);
+        return infoSearch == _peasantInfos.end() ? winrt::hstring{} : infoSearch->second.name;
+    }
+
     // Method Description:
     // - Find the ID of the peasant with the given name. If no such peasant
-    //   exists, then we'll return 0. If we encounter any peasants who have died
-    //   during this process, then we'll remove them from the set of _peasants
+    //   exists, then we'll return 0. This looks through our own copy of the
+    //   names, so only the peasant we find is checked for being alive. If it
+    //   has died, we'll remove it from the set of _peasants, and return 0.
     // Arguments:
     // - name: The window name to look for
     // Return Value:
@@ -167,38 +252,21 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
             return 0;
         }
 
-        std::vector<uint64_t> peasantsToErase{};
         uint64_t result = 0;
-        for (const auto& [id, p] : _peasants)
+        for (const auto& [id, info] : _peasantInfos)
         {
-            try
-            {
-                auto otherName = p.WindowName();
-                if (otherName == name)
-                {
-                    result = id;
-                    break;
-                }
-            }
-            catch (...)
+            if (info.name == name)
             {
-                LOG_CAUGHT_EXCEPTION();
-                // Normally, we'd just erase the peasant here. However, we can't
-                // erase from the map while we're iterating over it like this.
-                // Instead, pull a good ole Java and collect this id for removal
-                // later.
-                peasantsToErase.push_back(id);
+                result = id;
+                break;
             }
         }
 
-        // Remove the dead peasants we came across while iterating.
-        for (const auto& id : peasantsToErase)
+        // Names are unique, so if the peasant with this name has died, there's
+        // no other one. _getPeasant will remove the dead one.
+        if (result != 0 && !_getPeasant(result))
         {
-            // Remove the peasant from the list of peasants
-            _peasants.erase(id);
-            // Remove the peasant from the list of MRU windows. They're dead.
-            // They can't be the MRU anymore.
-            _clearOldMruEntries(id);
+            result = 0;
         }
 
         return result;
@@ -387,7 +455,7 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
                 continue;
             }
 
-            if (ignoreQuakeWindow && peasant.WindowName() == QuakeWindowName)
+            if (ignoreQuakeWindow && _getPeasantName(mruWindowArgs.PeasantID()) == QuakeWindowName)
             {
                 // The _quake window should never be treated as the MRU window.
                 // Skip it if we see it. Users can still target it with `wt -w
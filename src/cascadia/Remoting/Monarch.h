@@ -64,11 +64,28 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
 
         std::unordered_map<uint64_t, winrt::Microsoft::Terminal::Remoting::IPeasant> _peasants;
 
+        // What we know about each peasant without having to call into its
+        // process. The peasants tell us when their name changes, and the
+        // process handle lets us see if they died without an RPC.
+        struct PeasantInfo
+        {
+            winrt::hstring name;
+            wil::unique_handle process;
+        };
+        std::unordered_map<uint64_t, PeasantInfo> _peasantInfos;
+        // The test peasants all live in our process, with made up PIDs.
+        bool _watchPeasantProcesses{ true };
+
         std::vector<Remoting::WindowActivatedArgs> _mruPeasants;
 
         winrt::Microsoft::Terminal::Remoting::IPeasant _getPeasant(uint64_t peasantID);
         uint64_t _getMostRecentPeasantID(bool limitToCurrentDesktop, const bool ignoreQuakeWindow);
         uint64_t _lookupPeasantIdForName(std::wstring_view name);
+        winrt::hstring _getPeasantName(const uint64_t peasantID) const;
+        bool _isPeasantAlive(const uint64_t peasantID, const winrt::Microsoft::Terminal::Remoting::IPeasant& peasant) const;
+        void _removePeasant(const uint64_t peasantID);
+
+        void _peasantNameChanged(const uint64_t peasantID, const winrt::hstring& name);
 
         void _peasantWindowActivated(const winrt::Windows::Foundation::IInspectable& sender,
                                      const winrt::Microsoft::Terminal::Remoting::WindowActivatedArgs& args);
@@ -41,6 +41,37 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
         return _ourPID;
     }
 
+    winrt::hstring Peasant::WindowName() const
+    {
+        return _windowName;
+    }
+
+    // Method Description:
+    // - Set our name, and tell the monarch about it. The monarch keeps a copy
+    //   of every window's name, so that looking a window up by name is a local
+    //   lookup, rather than a call into every window process.
+    // Arguments:
+    // - name: our new name
+    // Return Value:
+    // - <none>
+    void Peasant::WindowName(const winrt::hstring& name)
+    {
+        if (_windowName == name)
+        {
+            return;
+        }
+        _windowName = name;
+
+        try
+        {
+            // Try/catch this, because the other side of this event is handled
+            // by the monarch. The monarch might have died. If they have, the
+            // new one will ask for our name when we're added to it.
+            _WindowNameChangedHandlers(*this, _windowName);
+        }
+        CATCH_LOG();
+    }
+
     bool Peasant::ExecuteCommandline(const Remoting::CommandlineArgs& args)
     {
         // If this is the first set of args we were ever told about, stash them
@@ -194,7 +225,7 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
     void Peasant::RequestRename(const winrt::Microsoft::Terminal::Remoting::RenameRequestArgs& args)
     {
         bool successfullyNotified = false;
-        const auto oldName{ _WindowName };
+        const auto oldName{ _windowName };
         try
         {
             // Try/catch this, because the other side of this event is handled
@@ -204,7 +235,7 @@ namespace winrt::Microsoft::Terminal::Remoting::implementation
             _RenameRequestedHandlers(*this, args);
             if (args.Succeeded())
             {
-                _WindowName = args.NewName();
+                WindowName(args.NewName());
             }
             successfullyNotified = true;
         }
@@ -73,21 +73,18 @@ namespace winrt::TerminalApp::implementation
             // Get the runtime settings of the focused control
             const auto& controlSettings{ activeControl.Settings().as<TerminalSettings>() };
 
-            // Get the control's root settings, the ones that we actually
-            // assigned to it.
-            auto parentSettings{ controlSettings.GetParent() };
-            while (parentSettings.GetParent() != nullptr)
-            {
-                parentSettings = parentSettings.GetParent();
-            }
+            // Get the parent of the preview TerminalSettings we inserted.
+            // That's the settings that we actually assigned to the control.
+            const auto previewSettings{ controlSettings.GetParent() };
+            const auto parentSettings{ previewSettings ? previewSettings.GetParent() : nullptr };
 
-            // If the root settings are the same as the ones we stashed,
+            // If those settings are the same as the ones we stashed,
             // then reset the parent of the runtime settings to the stashed
             // settings. This condition might be false if the settings
             // hot-reloaded while the palette was open. In that case, we
             // don't want to reset the settings to what they were _before_
             // the hot-reload.
-            if (_originalSettings == parentSettings)
+            if (_originalSettings && _originalSettings == parentSettings)
             {
                 // Set the original settings as the parent of the control's settings
                 activeControl.Settings().as<TerminalSettings>().SetParent(_originalSettings);
@@ -119,15 +116,17 @@ namespace winrt::TerminalApp::implementation
             {
                 // Get the settings of the focused control and stash them
                 const auto& controlSettings = activeControl.Settings().as<TerminalSettings>();
-                // Make sure to recurse up to the root - if you're doing
-                // this while you're currently previewing a SetColorScheme
-                // action, then the parent of the control's settings is _the
-                // last preview TerminalSettings we inserted! We don't want
-                // to save that one!
-                _originalSettings = controlSettings.GetParent();
-                while (_originalSettings.GetParent() != nullptr)
+                // If you're doing this while you're currently previewing a
+                // SetColorScheme action, then the parent of the control's
+                // settings is _the last preview TerminalSettings we
+                // inserted! We don't want to save that one! We can't just
+                // recurse up to the root either: the settings we assigned
+                // to the control are themselves a child of the settings
+                // shared by all the panes of the profile.
+                const auto parentSettings{ controlSettings.GetParent() };
+                if (!_originalSettings || parentSettings.GetParent() != _originalSettings)
                 {
-                    _originalSettings = _originalSettings.GetParent();
+                    _originalSettings = parentSettings;
                 }
                 // Create a new child for those settings
                 TerminalSettingsCreateResult fake{ _originalSettings };
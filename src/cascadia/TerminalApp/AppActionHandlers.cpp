@@ -861,4 +861,34 @@ namespace winrt::TerminalApp::implementation
             }
         }
     }
+
+    void TerminalPage::_HandleExportBuffer(const IInspectable& /*sender*/,
+                                           const ActionEventArgs& args)
+    {
+        if (const auto& realArgs = args.ActionArgs().try_as<ExportBufferArgs>())
+        {
+            if (const auto& control{ _GetActiveControl() })
+            {
+                _ExportBuffer(control, realArgs.Path(), realArgs.IncludeAttributes());
+                args.Handled(true);
+            }
+        }
+    }
+
+    void TerminalPage::_HandleToggleRenderStatistics(const IInspectable& /*sender*/,
+                                                     const ActionEventArgs& args)
+    {
+        if (const auto& termControl{ _GetActiveControl() })
+        {
+            termControl.ToggleRenderStatistics();
+            args.Handled(true);
+        }
+    }
+
+    void TerminalPage::_HandleReportMemoryUsage(const IInspectable& /*sender*/,
+                                                const ActionEventArgs& args)
+    {
+        _ReportMemoryUsage();
+        args.Handled(true);
+    }
 }
@@ -10,6 +10,7 @@
 
 #include <LibraryResources.h>
 #include <WtExeUtils.h>
+#include "../../types/inc/utils.hpp"
 
 using namespace winrt::Windows::ApplicationModel;
 using namespace winrt::Windows::ApplicationModel::DataTransfer;
@@ -291,6 +292,9 @@ namespace winrt::TerminalApp::implementation
         _root->SetSettings(_settings, false);
         _root->Loaded({ this, &AppLogic::_OnLoaded });
         _root->Initialized([this](auto&&, auto&&) {
+            _RecordStartupMilestone(L"TerminalPageInitialized");
+            _ReportStartupMilestones();
+
             // GH#288 - When we finish initialization, if the user wanted us
             // launched _fullscreen_, toggle fullscreen mode. This will make sure
             // that the window size is _first_ set up as something sensible, so
@@ -315,6 +319,7 @@ namespace winrt::TerminalApp::implementation
             }
         });
         _root->Create();
+        _RecordStartupMilestone(L"TerminalPageCreated");
 
         _ApplyLanguageSettingChange();
         _RefreshThemeRoutine();
@@ -852,6 +857,7 @@ namespace winrt::TerminalApp::implementation
             TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
 
         _loadedInitialSettings = true;
+        _RecordStartupMilestone(L"SettingsLoaded");
 
         // Register for directory change notification.
         _RegisterSettingsChange();
@@ -859,6 +865,61 @@ namespace winrt::TerminalApp::implementation
         Jumplist::UpdateJumplist(_settings);
     }
 
+    // Method Description:
+    // - Emits a StartupMilestone event for the given milestone, and remembers
+    //   it for _ReportStartupMilestones. The other modules emit the same event
+    //   for their milestones (window creation, control initialization, conpty
+    //   launch, first frame). All of them are timed from process creation, so
+    //   a trace of the Terminal providers (see Terminal.wprp) lines them all up.
+    // Arguments:
+    // - name: the name of the milestone
+    // Return Value:
+    // - <none>
+    void AppLogic::_RecordStartupMilestone(const std::wstring_view name)
+    {
+        const auto elapsed = ::Microsoft::Console::Utils::MillisecondsSinceProcessStart();
+
+        TraceLoggingWrite(
+            g_hTerminalAppProvider,
+            "StartupMilestone",
+            TraceLoggingDescription("Event emitted when a step of starting up is complete"),
+            TraceLoggingCountedWideString(name.data(), gsl::narrow_cast<ULONG>(name.size()), "Milestone"),
+            TraceLoggingFloat64(elapsed, "MillisecondsSinceProcessStart"),
+            TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+            TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
+        _startupMilestones.emplace_back(name, elapsed);
+    }
+
+    // Method Description:
+    // - If debug features are enabled, writes the startup milestones we
+    //   recorded to the debugger, so a cold/warm start can be compared between
+    //   builds without having to take a trace. This only ever runs once.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void AppLogic::_ReportStartupMilestones()
+    {
+        if (_startupMilestones.empty())
+        {
+            return;
+        }
+
+        if (_settings && _settings.GlobalSettings().DebugFeaturesEnabled())
+        {
+            std::wstring summary{ L"Startup milestones (ms since process creation):\n" };
+            for (const auto& [name, elapsed] : _startupMilestones)
+            {
+                fmt::format_to(std::back_inserter(summary), FMT_STRING(L"  {:<28}{:>10.2f}\n"), name, elapsed);
+            }
+            OutputDebugStringW(summary.c_str());
+        }
+
+        _startupMilestones.clear();
+        _startupMilestones.shrink_to_fit();
+    }
+
     // Method Description:
     // - Registers for changes to the settings folder and upon a updated settings
     //      profile calls _ReloadSettings().
@@ -1129,6 +1190,21 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Method Description:
+    // - Called when the window is minimized or restored. Forwards it to our
+    //   page, so its controls can stop rendering while they can't be seen.
+    // Arguments:
+    // - showOrHide: false if the window was minimized
+    // Return Value:
+    // - <none>
+    void AppLogic::WindowVisibilityChanged(const bool showOrHide)
+    {
+        if (_root)
+        {
+            _root->WindowVisibilityChanged(showOrHide);
+        }
+    }
+
     winrt::TerminalApp::TaskbarState AppLogic::TaskbarState()
     {
         if (_root)
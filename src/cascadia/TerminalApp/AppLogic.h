@@ -89,6 +89,7 @@ namespace winrt::TerminalApp::implementation
         bool OnDirectKeyEvent(const uint32_t vkey, const uint8_t scanCode, const bool down);
 
         void WindowCloseButtonClicked();
+        void WindowVisibilityChanged(const bool showOrHide);
 
         winrt::TerminalApp::TaskbarState TaskbarState();
 
@@ -116,6 +117,10 @@ namespace winrt::TerminalApp::implementation
         HRESULT _settingsLoadedResult = S_OK;
         bool _loadedInitialSettings = false;
 
+        // Milestones (in ms since process creation) from launch until the
+        // page finished initializing. See _RecordStartupMilestone.
+        std::vector<std::pair<std::wstring_view, double>> _startupMilestones;
+
         std::shared_mutex _dialogLock;
 
         ::TerminalApp::AppCommandlineArgs _appArgs;
@@ -144,6 +149,8 @@ namespace winrt::TerminalApp::implementation
 
         [[nodiscard]] HRESULT _TryLoadSettings() noexcept;
         void _RegisterSettingsChange();
+        void _RecordStartupMilestone(const std::wstring_view name);
+        void _ReportStartupMilestones();
         fire_and_forget _DispatchReloadSettings();
         void _ReloadSettings();
 
@@ -26,6 +26,7 @@ namespace winrt::TerminalApp::implementation
         _Filter(L""),
         _Weight(0)
     {
+        _updateFoldedName();
         _HighlightedName = _computeHighlightedName();
 
         // Recompute the highlighted name if the item name changes
@@ -33,6 +34,7 @@ namespace winrt::TerminalApp::implementation
             auto filteredCommand{ weakThis.get() };
             if (filteredCommand && e.PropertyName() == L"Name")
             {
+                filteredCommand->_updateFoldedName();
                 filteredCommand->HighlightedName(filteredCommand->_computeHighlightedName());
                 filteredCommand->Weight(filteredCommand->_computeWeight());
             }
@@ -45,12 +47,85 @@ namespace winrt::TerminalApp::implementation
         // that might result in triggering a notification event
         if (filter != _Filter)
         {
+            // If we didn't match the old filter, then we can't match a filter
+            // that only adds characters to it either. That's what typing into
+            // the palette does, so most commands get out of here early.
+            const auto narrowsPreviousFilter = !_Filter.empty() &&
+                                               std::wstring_view{ filter }.substr(0, _Filter.size()) == std::wstring_view{ _Filter };
+            const auto didNotMatch = _Weight == 0;
+
             Filter(filter);
+            if (narrowsPreviousFilter && didNotMatch)
+            {
+                return;
+            }
+
             HighlightedName(_computeHighlightedName());
             Weight(_computeWeight());
         }
     }
 
+    // Method Description:
+    // - Recomputes the folded name and character mask after the item's name changed.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void FilteredCommand::_updateFoldedName()
+    {
+        const auto name = _Item.Name();
+        _foldedName = _foldCase(name);
+        _nameCharMask = _computeCharMask(_foldedName);
+
+        const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
+        segments.Append(winrt::make<HighlightedTextSegment>(name, false));
+        _unhighlightedName = winrt::make<HighlightedText>(segments);
+    }
+
+    // Function Description:
+    // - Folds the case of each code unit in the given text, using the user's
+    //   locale. GH#9941: matching has to be locale-aware. We used to compare
+    //   every pair of characters with lstrcmpi, which is far too slow to do
+    //   for every command on every keystroke. Folding both sides once and
+    //   comparing code units matches the same characters, except for the rare
+    //   ones that lstrcmpi would only consider equal after normalization.
+    // Arguments:
+    // - text: the text to fold
+    // Return Value:
+    // - the folded text. It has exactly as many code units as `text`, so that
+    //   offsets into it are offsets into `text` as well.
+    std::wstring FilteredCommand::_foldCase(const std::wstring_view text)
+    {
+        std::wstring folded{ text };
+        for (auto& ch : folded)
+        {
+            wchar_t lower{};
+            if (LCMapStringEx(LOCALE_NAME_USER_DEFAULT, LCMAP_LOWERCASE | LCMAP_LINGUISTIC_CASING, &ch, 1, &lower, 1, nullptr, nullptr, 0) == 1)
+            {
+                ch = lower;
+            }
+        }
+        return folded;
+    }
+
+    // Function Description:
+    // - Computes a bitmask with one bit set for each character in the text,
+    //   hashed into 64 buckets. If a filter's mask has a bit that a name's
+    //   mask doesn't, the filter can't match the name.
+    // Arguments:
+    // - foldedText: text that has gone through _foldCase
+    // Return Value:
+    // - the mask
+    uint64_t FilteredCommand::_computeCharMask(const std::wstring_view foldedText) noexcept
+    {
+        uint64_t mask = 0;
+        for (const auto ch : foldedText)
+        {
+            mask |= uint64_t{ 1 } << (ch % 64);
+        }
+        return mask;
+    }
+
     // Method Description:
     // - Looks up the filter characters within the item name.
     // Iterating through the filter and the item name it tries to associate the next filter character
@@ -72,31 +147,37 @@ namespace winrt::TerminalApp::implementation
     // - The HighlightedText object initialized with the segments computed according to the algorithm above.
     winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName()
     {
+        if (_Filter.empty())
+        {
+            return _unhighlightedName;
+        }
+
+        // Rule out most of the names that can't match before building any segments.
+        const auto foldedFilter = _foldCase(_Filter);
+        if ((_computeCharMask(foldedFilter) & ~_nameCharMask) != 0)
+        {
+            return _unhighlightedName;
+        }
+
         const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
         auto commandName = _Item.Name();
         bool isProcessingMatchedSegment = false;
         uint32_t nextOffsetToReport = 0;
         uint32_t currentOffset = 0;
 
-        for (const auto searchChar : _Filter)
+        for (const auto searchChar : foldedFilter)
         {
-            const WCHAR searchCharAsString[] = { searchChar, L'\0' };
             while (true)
             {
-                if (currentOffset == commandName.size())
+                if (currentOffset == _foldedName.size())
                 {
                     // There are still unmatched filter characters but we finished scanning the name.
                     // In this case we return the entire item name as unmatched
-                    auto entireNameSegment{ winrt::make<HighlightedTextSegment>(commandName, false) };
-                    segments.Clear();
-                    segments.Append(entireNameSegment);
-                    return winrt::make<HighlightedText>(segments);
+                    return _unhighlightedName;
                 }
 
-                // GH#9941: search should be locale-aware as well
-                // We use the same comparison method as upon sorting to guarantee consistent behavior
-                const WCHAR currentCharAsString[] = { commandName[currentOffset], L'\0' };
-                auto isCurrentCharMatched = lstrcmpi(searchCharAsString, currentCharAsString) == 0;
+                // GH#9941: search should be locale-aware as well (see _foldCase)
+                auto isCurrentCharMatched = searchChar == _foldedName[currentOffset];
                 if (isProcessingMatchedSegment != isCurrentCharMatched)
                 {
                     // We reached the end of the region (matched character came after a series of unmatched or vice versa).
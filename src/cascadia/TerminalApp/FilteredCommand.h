@@ -33,6 +33,19 @@ namespace winrt::TerminalApp::implementation
     private:
         winrt::TerminalApp::HighlightedText _computeHighlightedName();
         int _computeWeight();
+        void _updateFoldedName();
+
+        static std::wstring _foldCase(const std::wstring_view text);
+        static uint64_t _computeCharMask(const std::wstring_view foldedText) noexcept;
+
+        // The item's name with its case folded, one code unit for each code
+        // unit of the name, and a bitmask of the characters in it. Filtering
+        // runs for every command on every keystroke, so these are computed
+        // only when the name changes.
+        std::wstring _foldedName;
+        uint64_t _nameCharMask{ 0 };
+        winrt::TerminalApp::HighlightedText _unhighlightedName{ nullptr };
+
         Windows::UI::Xaml::Data::INotifyPropertyChanged::PropertyChanged_revoker _itemChangedRevoker;
 
         friend class TerminalAppLocalTests::FilteredCommandTests;
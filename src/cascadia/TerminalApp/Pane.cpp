@@ -33,6 +33,7 @@ static const Duration AnimationDuration = DurationHelper::FromTimeSpan(winrt::Wi
 
 winrt::Windows::UI::Xaml::Media::SolidColorBrush Pane::s_focusedBorderBrush = { nullptr };
 winrt::Windows::UI::Xaml::Media::SolidColorBrush Pane::s_unfocusedBorderBrush = { nullptr };
+uint64_t Pane::s_layoutGeneration{ 1 };
 
 Pane::Pane(const GUID& profile, const TermControl& control, const bool lastFocused) :
     _control{ control },
@@ -44,6 +45,7 @@ Pane::Pane(const GUID& profile, const TermControl& control, const bool lastFocus
 
     _connectionStateChangedToken = _control.ConnectionStateChanged({ this, &Pane::_ControlConnectionStateChangedHandler });
     _warningBellToken = _control.WarningBell({ this, &Pane::_ControlWarningBellHandler });
+    _SetupControlLayoutHandlers();
 
     // On the first Pane's creation, lookup resources we'll use to theme the
     // Pane, including the brushed to use for the focused/unfocused border
@@ -77,6 +79,11 @@ Pane::Pane(const GUID& profile, const TermControl& control, const bool lastFocus
 // - Because we're just manually setting the row/column sizes in pixels, we have
 //   to be told our new size, we can't just use our own OnSized event, because
 //   that _won't fire when we get smaller_.
+// - The row/column definitions are proportional, and leaves don't use the size
+//   they're given, so the children's sizes don't need to be snapped here. It
+//   used to, which made every resize frame walk the whole subtree once per
+//   character cell at every level. The window itself is still snapped through
+//   CalcSnappedDimension.
 // Arguments:
 // - newSize: the amount of space that this pane has to fill now.
 // Return Value:
@@ -90,19 +97,19 @@ void Pane::ResizeContent(const Size& newSize)
 
     if (_splitState == SplitState::Vertical)
     {
-        const auto paneSizes = _CalcChildrenSizes(width);
+        const auto firstWidth = width * _desiredSplitPosition;
 
-        const Size firstSize{ paneSizes.first, height };
-        const Size secondSize{ paneSizes.second, height };
+        const Size firstSize{ firstWidth, height };
+        const Size secondSize{ width - firstWidth, height };
         _firstChild->ResizeContent(firstSize);
         _secondChild->ResizeContent(secondSize);
     }
     else if (_splitState == SplitState::Horizontal)
     {
-        const auto paneSizes = _CalcChildrenSizes(height);
+        const auto firstHeight = height * _desiredSplitPosition;
 
-        const Size firstSize{ width, paneSizes.first };
-        const Size secondSize{ width, paneSizes.second };
+        const Size firstSize{ width, firstHeight };
+        const Size secondSize{ width, height - firstHeight };
         _firstChild->ResizeContent(firstSize);
         _secondChild->ResizeContent(secondSize);
     }
@@ -785,6 +792,27 @@ void Pane::Shutdown()
     }
 }
 
+// Method Description:
+// - Tells all the controls beneath this pane whether the window is visible, so
+//   that they can stop rendering while it's minimized.
+// Arguments:
+// - showOrHide: false if the window was minimized
+// Return Value:
+// - <none>
+void Pane::WindowVisibilityChanged(const bool showOrHide)
+{
+    std::unique_lock lock{ _createCloseLock };
+    if (_IsLeaf())
+    {
+        _control.WindowVisibilityChanged(showOrHide);
+    }
+    else
+    {
+        _firstChild->WindowVisibilityChanged(showOrHide);
+        _secondChild->WindowVisibilityChanged(showOrHide);
+    }
+}
+
 // Method Description:
 // - Get the root UIElement of this pane. There may be a single TermControl as a
 //   child, or an entire tree of grids and panes as children of this element.
@@ -1007,6 +1035,9 @@ void Pane::UpdateSettings(const TerminalSettingsCreateResult& settings, const GU
             }
             _control.UnfocusedAppearance(unfocusedSettings);
             _control.UpdateSettings();
+
+            // The padding or the scrollbar might have changed.
+            _InvalidateLayoutCaches();
         }
     }
 }
@@ -1099,6 +1130,9 @@ void Pane::_CloseChild(const bool closeFirst)
         // re-attach our handler for the control's GotFocus event.
         _gotFocusRevoker = _control.GotFocus(winrt::auto_revoke, { this, &Pane::_ControlGotFocusHandler });
         _lostFocusRevoker = _control.LostFocus(winrt::auto_revoke, { this, &Pane::_ControlLostFocusHandler });
+        _SetupControlLayoutHandlers();
+        remainingChild->_fontSizeChangedRevoker.revoke();
+        remainingChild->_controlInitializedRevoker.revoke();
 
         // If we're inheriting the "last active" state from one of our children,
         // focus our control now. This should trigger our own GotFocus event.
@@ -1364,6 +1398,24 @@ void Pane::_SetupChildCloseHandlers()
     });
 }
 
+// Method Description:
+// - Registers for the control events that change the sizes we cache for
+//   snapping: its font size, and its initialization (the scrollbar only has a
+//   width once the control has been laid out).
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Pane::_SetupControlLayoutHandlers()
+{
+    _fontSizeChangedRevoker = _control.FontSizeChanged(winrt::auto_revoke, [](auto&&, auto&&, auto&&) {
+        _InvalidateLayoutCaches();
+    });
+    _controlInitializedRevoker = _control.Initialized(winrt::auto_revoke, [](auto&&, auto&&) {
+        _InvalidateLayoutCaches();
+    });
+}
+
 // Method Description:
 // - Sets up row/column definitions for this pane. There are three total
 //   row/cols. The middle one is for the separator. The first and third are for
@@ -1381,7 +1433,17 @@ void Pane::_CreateRowColDefinitions()
     const auto second = 100.0f - first;
     if (_splitState == SplitState::Vertical)
     {
-        _root.ColumnDefinitions().Clear();
+        // This runs for every resize, so only update the existing columns
+        // if we already have them.
+        const auto columns = _root.ColumnDefinitions();
+        if (columns.Size() == 2)
+        {
+            columns.GetAt(0).Width(GridLengthHelper::FromValueAndType(first, GridUnitType::Star));
+            columns.GetAt(1).Width(GridLengthHelper::FromValueAndType(second, GridUnitType::Star));
+            return;
+        }
+
+        columns.Clear();
 
         // Create two columns in this grid: one for each pane
 
@@ -1391,12 +1453,20 @@ void Pane::_CreateRowColDefinitions()
         auto secondColDef = Controls::ColumnDefinition();
         secondColDef.Width(GridLengthHelper::FromValueAndType(second, GridUnitType::Star));
 
-        _root.ColumnDefinitions().Append(firstColDef);
-        _root.ColumnDefinitions().Append(secondColDef);
+        columns.Append(firstColDef);
+        columns.Append(secondColDef);
     }
     else if (_splitState == SplitState::Horizontal)
     {
-        _root.RowDefinitions().Clear();
+        const auto rows = _root.RowDefinitions();
+        if (rows.Size() == 2)
+        {
+            rows.GetAt(0).Height(GridLengthHelper::FromValueAndType(first, GridUnitType::Star));
+            rows.GetAt(1).Height(GridLengthHelper::FromValueAndType(second, GridUnitType::Star));
+            return;
+        }
+
+        rows.Clear();
 
         // Create two rows in this grid: one for each pane
 
@@ -1406,8 +1476,8 @@ void Pane::_CreateRowColDefinitions()
         auto secondRowDef = Controls::RowDefinition();
         secondRowDef.Height(GridLengthHelper::FromValueAndType(second, GridUnitType::Star));
 
-        _root.RowDefinitions().Append(firstRowDef);
-        _root.RowDefinitions().Append(secondRowDef);
+        rows.Append(firstRowDef);
+        rows.Append(secondRowDef);
     }
 }
 
@@ -1419,6 +1489,10 @@ void Pane::_CreateRowColDefinitions()
 // - <none>
 void Pane::_UpdateBorders()
 {
+    // Everything that changes our borders or the shape of the tree ends up
+    // here, and both change the minimum sizes used for snapping.
+    _InvalidateLayoutCaches();
+
     double top = 0, bottom = 0, left = 0, right = 0;
 
     Thickness newBorders{ 0 };
@@ -1858,6 +1932,8 @@ std::pair<std::shared_ptr<Pane>, std::shared_ptr<Pane>> Pane::_Split(SplitState
     // parent.
     _gotFocusRevoker.revoke();
     _lostFocusRevoker.revoke();
+    _fontSizeChangedRevoker.revoke();
+    _controlInitializedRevoker.revoke();
 
     _splitState = actualSplitType;
     _desiredSplitPosition = 1.0f - splitSize;
@@ -2190,7 +2266,7 @@ Pane::SnapSizeResult Pane::_CalcSnappedDimension(const bool widthOrHeight, const
         }
         else
         {
-            const auto cellSize = _control.CharacterDimensions();
+            const auto cellSize = _GetCharacterDimensions();
             const auto higher = lower + (widthOrHeight ? cellSize.Width : cellSize.Height);
             return { lower, higher };
         }
@@ -2250,7 +2326,7 @@ void Pane::_AdvanceSnappedDimension(const bool widthOrHeight, LayoutSizeNode& si
         }
         else
         {
-            const auto cellSize = _control.CharacterDimensions();
+            const auto cellSize = _GetCharacterDimensions();
             sizeNode.size += widthOrHeight ? cellSize.Width : cellSize.Height;
         }
     }
@@ -2354,6 +2430,38 @@ void Pane::_AdvanceSnappedDimension(const bool widthOrHeight, LayoutSizeNode& si
 //   character.
 Size Pane::_GetMinSize() const
 {
+    _EnsureLayoutCache();
+    return _cachedMinSize;
+}
+
+// Method Description:
+// - Get the size of a single character cell of our control. Only valid for leaves.
+// Arguments:
+// - <none>
+// Return Value:
+// - The dimensions of a character of our control, in DIPs.
+Size Pane::_GetCharacterDimensions() const
+{
+    _EnsureLayoutCache();
+    return _cachedCharacterDimensions;
+}
+
+// Method Description:
+// - Recomputes our cached minimum size (and, for a leaf, our control's
+//   character dimensions) if they were invalidated since we last computed
+//   them. Our children's min sizes are cached too, so this only ever walks
+//   the part of the tree that's out of date.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Pane::_EnsureLayoutCache() const
+{
+    if (_layoutCacheGeneration == s_layoutGeneration)
+    {
+        return;
+    }
+
     if (_IsLeaf())
     {
         auto controlSize = _control.MinimumSize();
@@ -2365,7 +2473,8 @@ Size Pane::_GetMinSize() const
         newHeight += WI_IsFlagSet(_borders, Borders::Top) ? PaneBorderSize : 0;
         newHeight += WI_IsFlagSet(_borders, Borders::Bottom) ? PaneBorderSize : 0;
 
-        return { newWidth, newHeight };
+        _cachedMinSize = { newWidth, newHeight };
+        _cachedCharacterDimensions = _control.CharacterDimensions();
     }
     else
     {
@@ -2379,8 +2488,24 @@ Size Pane::_GetMinSize() const
                                    firstSize.Height + secondSize.Height :
                                    std::max(firstSize.Height, secondSize.Height);
 
-        return { minWidth, minHeight };
+        _cachedMinSize = { minWidth, minHeight };
+        _cachedCharacterDimensions = {};
     }
+
+    _layoutCacheGeneration = s_layoutGeneration;
+}
+
+// Method Description:
+// - Throws away the cached minimum sizes and character dimensions of every
+//   pane. This is cheap, and the things that call for it (font, padding,
+//   border or tree changes) are rare compared to resizes.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Pane::_InvalidateLayoutCaches() noexcept
+{
+    ++s_layoutGeneration;
 }
 
 // Method Description:
@@ -2476,6 +2601,17 @@ int Pane::GetLeafPaneCount() const noexcept
     return _IsLeaf() ? 1 : (_firstChild->GetLeafPaneCount() + _secondChild->GetLeafPaneCount());
 }
 
+// Method Description:
+// - Has the control of every leaf in this tree report its memory usage.
+// Arguments:
+// - <none>
+// Return Value:
+// - The memory used by all the controls in this tree, in bytes.
+uint64_t Pane::ReportMemoryUsage()
+{
+    return _IsLeaf() ? _control.ReportMemoryUsage() : (_firstChild->ReportMemoryUsage() + _secondChild->ReportMemoryUsage());
+}
+
 // Method Description:
 // - This is a helper to determine which direction an "Automatic" split should
 //   happen in for a given pane, but without using the ActualWidth() and
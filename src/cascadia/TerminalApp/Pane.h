@@ -79,9 +79,11 @@ public:
                                              const float splitSize,
                                              const winrt::Windows::Foundation::Size availableSpace) const;
     void Shutdown();
+    void WindowVisibilityChanged(const bool showOrHide);
     void Close();
 
     int GetLeafPaneCount() const noexcept;
+    uint64_t ReportMemoryUsage();
 
     void Maximize(std::shared_ptr<Pane> zoomedPane);
     void Restore(std::shared_ptr<Pane> zoomedPane);
@@ -130,6 +132,18 @@ private:
 
     winrt::Windows::UI::Xaml::UIElement::GotFocus_revoker _gotFocusRevoker;
     winrt::Windows::UI::Xaml::UIElement::LostFocus_revoker _lostFocusRevoker;
+    winrt::Microsoft::Terminal::Control::TermControl::FontSizeChanged_revoker _fontSizeChangedRevoker;
+    winrt::Microsoft::Terminal::Control::TermControl::Initialized_revoker _controlInitializedRevoker;
+
+    // Snapping a size walks the pane tree once per character cell, asking
+    // every pane for its minimum size and every control for its cell size.
+    // Both only change with the font, padding, borders or the shape of the
+    // tree, so they're cached here until s_layoutGeneration is bumped by
+    // _InvalidateLayoutCaches.
+    mutable uint64_t _layoutCacheGeneration{ 0 };
+    mutable winrt::Windows::Foundation::Size _cachedMinSize{};
+    mutable winrt::Windows::Foundation::Size _cachedCharacterDimensions{};
+    static uint64_t s_layoutGeneration;
 
     std::shared_mutex _createCloseLock{};
 
@@ -140,6 +154,7 @@ private:
     bool _IsLeaf() const noexcept;
     bool _HasFocusedChild() const noexcept;
     void _SetupChildCloseHandlers();
+    void _SetupControlLayoutHandlers();
 
     std::pair<std::shared_ptr<Pane>, std::shared_ptr<Pane>> _Split(winrt::Microsoft::Terminal::Settings::Model::SplitState splitType,
                                                                    const float splitSize,
@@ -181,6 +196,9 @@ private:
     void _AdvanceSnappedDimension(const bool widthOrHeight, LayoutSizeNode& sizeNode) const;
 
     winrt::Windows::Foundation::Size _GetMinSize() const;
+    winrt::Windows::Foundation::Size _GetCharacterDimensions() const;
+    void _EnsureLayoutCache() const;
+    static void _InvalidateLayoutCaches() noexcept;
     LayoutSizeNode _CreateMinSizeTree(const bool widthOrHeight) const;
     float _ClampSplitPosition(const bool widthOrHeight, const float requestedValue, const float totalSize) const;
 
@@ -0,0 +1,440 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "RecordingConnection.h"
+
+using namespace ::winrt::Microsoft::Terminal::TerminalConnection;
+using namespace ::winrt::Windows::Foundation;
+
+namespace
+{
+    // Appends data to out as the contents of a JSON string.
+    void _AppendJsonString(std::wstring& out, const std::wstring_view data)
+    {
+        for (const auto wch : data)
+        {
+            switch (wch)
+            {
+            case L'"':
+                out.append(L"\\\"");
+                break;
+            case L'\\':
+                out.append(L"\\\\");
+                break;
+            case L'\n':
+                out.append(L"\\n");
+                break;
+            case L'\r':
+                out.append(L"\\r");
+                break;
+            case L'\t':
+                out.append(L"\\t");
+                break;
+            default:
+                if (wch < L' ')
+                {
+                    fmt::format_to(std::back_inserter(out), FMT_STRING(L"\\u{:04x}"), static_cast<unsigned int>(wch));
+                }
+                else
+                {
+                    out.push_back(wch);
+                }
+                break;
+            }
+        }
+    }
+
+    void _SkipWhitespace(std::wstring_view& in) noexcept
+    {
+        while (!in.empty() && (in.front() == L' ' || in.front() == L'\t' || in.front() == L'\r'))
+        {
+            in.remove_prefix(1);
+        }
+    }
+
+    bool _ConsumeChar(std::wstring_view& in, const wchar_t wch) noexcept
+    {
+        _SkipWhitespace(in);
+        if (in.empty() || in.front() != wch)
+        {
+            return false;
+        }
+        in.remove_prefix(1);
+        return true;
+    }
+
+    // Routine Description:
+    // - Reads a JSON string from the front of in, and unescapes it.
+    //   \u escapes are UTF-16 code units already, so surrogate pairs that
+    //   were escaped come out as the pair.
+    // Arguments:
+    // - in - the text to read from. The string is removed from it.
+    // - out - receives the string
+    // Return Value:
+    // - false if in doesn't start with a valid JSON string.
+    bool _ConsumeJsonString(std::wstring_view& in, std::wstring& out)
+    {
+        if (!_ConsumeChar(in, L'"'))
+        {
+            return false;
+        }
+
+        out.clear();
+        while (!in.empty())
+        {
+            const auto wch = in.front();
+            in.remove_prefix(1);
+
+            if (wch == L'"')
+            {
+                return true;
+            }
+            if (wch != L'\\')
+            {
+                out.push_back(wch);
+                continue;
+            }
+
+            if (in.empty())
+            {
+                return false;
+            }
+            const auto escape = in.front();
+            in.remove_prefix(1);
+            switch (escape)
+            {
+            case L'b':
+                out.push_back(L'\b');
+                break;
+            case L'f':
+                out.push_back(L'\f');
+                break;
+            case L'n':
+                out.push_back(L'\n');
+                break;
+            case L'r':
+                out.push_back(L'\r');
+                break;
+            case L't':
+                out.push_back(L'\t');
+                break;
+            case L'u':
+            {
+                if (in.size() < 4)
+                {
+                    return false;
+                }
+                wchar_t unit = 0;
+                for (const auto digit : in.substr(0, 4))
+                {
+                    unit <<= 4;
+                    if (digit >= L'0' && digit <= L'9')
+                    {
+                        unit |= digit - L'0';
+                    }
+                    else if (digit >= L'a' && digit <= L'f')
+                    {
+                        unit |= digit - L'a' + 10;
+                    }
+                    else if (digit >= L'A' && digit <= L'F')
+                    {
+                        unit |= digit - L'A' + 10;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                in.remove_prefix(4);
+                out.push_back(unit);
+                break;
+            }
+            default: // ", \ and /
+                out.push_back(escape);
+                break;
+            }
+        }
+        return false;
+    }
+
+    struct ReplayEvent
+    {
+        double time;
+        std::wstring type;
+        std::wstring data;
+    };
+
+    // Routine Description:
+    // - Parses one event line of an asciicast v2 file: [time, "type", "data"]
+    // Arguments:
+    // - line - the line, without the newline
+    // - event - receives the event
+    // Return Value:
+    // - false if the line isn't an event, like the header line.
+    bool _ParseEvent(std::wstring_view line, ReplayEvent& event)
+    {
+        if (!_ConsumeChar(line, L'['))
+        {
+            return false;
+        }
+
+        _SkipWhitespace(line);
+        const std::wstring number{ line.substr(0, line.find(L',')) };
+        wchar_t* end = nullptr;
+        event.time = wcstod(number.c_str(), &end);
+        if (end == number.c_str())
+        {
+            return false;
+        }
+        line.remove_prefix(end - number.c_str());
+
+        return _ConsumeChar(line, L',') &&
+               _ConsumeJsonString(line, event.type) &&
+               _ConsumeChar(line, L',') &&
+               _ConsumeJsonString(line, event.data) &&
+               _ConsumeChar(line, L']');
+    }
+}
+
+namespace winrt::Microsoft::TerminalApp::implementation
+{
+    RecordingConnection::RecordingConnection(ITerminalConnection wrappedConnection, const std::filesystem::path& path) :
+        _wrappedConnection{ std::move(wrappedConnection) },
+        _start{ std::chrono::steady_clock::now() },
+        _timestamp{ std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count() }
+    {
+        _file.reset(CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        THROW_LAST_ERROR_IF(!_file);
+
+        _outputRevoker = _wrappedConnection.TerminalOutput(winrt::auto_revoke, { this, &RecordingConnection::_OutputHandler });
+        _stateChangedRevoker = _wrappedConnection.StateChanged(winrt::auto_revoke, [this](auto&& /*s*/, auto&& /*e*/) {
+            _StateChangedHandlers(*this, nullptr);
+        });
+    }
+
+    void RecordingConnection::Start()
+    {
+        _wrappedConnection.Start();
+    }
+
+    void RecordingConnection::WriteInput(hstring const& data)
+    {
+        _WriteEvent(L"i", data);
+        _wrappedConnection.WriteInput(data);
+    }
+
+    void RecordingConnection::Resize(uint32_t rows, uint32_t columns)
+    {
+        bool headerWritten;
+        {
+            const std::lock_guard guard{ _fileLock };
+            // The control sizes the connection before it starts it. That
+            // first size goes into the header, the ones after it are events.
+            headerWritten = _headerWritten;
+            if (!headerWritten)
+            {
+                _rows = rows;
+                _columns = columns;
+            }
+        }
+        if (headerWritten)
+        {
+            _WriteEvent(L"r", fmt::format(FMT_STRING(L"{}x{}"), columns, rows));
+        }
+        _wrappedConnection.Resize(rows, columns);
+    }
+
+    void RecordingConnection::Close()
+    {
+        _outputRevoker.revoke();
+        _stateChangedRevoker.revoke();
+        _wrappedConnection.Close();
+
+        const std::lock_guard guard{ _fileLock };
+        _file.reset();
+    }
+
+    ConnectionState RecordingConnection::State() const noexcept
+    {
+        return _wrappedConnection.State();
+    }
+
+    void RecordingConnection::_OutputHandler(const hstring str)
+    {
+        _WriteEvent(L"o", str);
+        _TerminalOutputHandlers(str);
+    }
+
+    // Routine Description:
+    // - Appends one line with an event to the recording.
+    // Arguments:
+    // - type - the asciicast event type: o for output, i for input, r for resize
+    // - data - the event's data
+    void RecordingConnection::_WriteEvent(const std::wstring_view type, const std::wstring_view data)
+    try
+    {
+        const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - _start };
+
+        auto line{ fmt::format(FMT_STRING(L"[{:.6f}, \"{}\", \""), elapsed.count(), type) };
+        _AppendJsonString(line, data);
+        line.append(L"\"]\n");
+
+        const std::lock_guard guard{ _fileLock };
+        if (!_file)
+        {
+            return;
+        }
+        if (!_headerWritten)
+        {
+            _WriteHeaderUnderLock();
+        }
+        const auto utf8{ winrt::to_string(line) };
+        DWORD written = 0;
+        LOG_IF_WIN32_BOOL_FALSE(WriteFile(_file.get(), utf8.data(), gsl::narrow<DWORD>(utf8.size()), &written, nullptr));
+    }
+    CATCH_LOG()
+
+    void RecordingConnection::_WriteHeaderUnderLock()
+    {
+        const auto header{ fmt::format(FMT_STRING("{{\"version\": 2, \"width\": {}, \"height\": {}, \"timestamp\": {}}}\n"), _columns, _rows, _timestamp) };
+        DWORD written = 0;
+        LOG_IF_WIN32_BOOL_FALSE(WriteFile(_file.get(), header.data(), gsl::narrow<DWORD>(header.size()), &written, nullptr));
+        _headerWritten = true;
+    }
+
+    ReplayConnection::ReplayConnection(const std::filesystem::path& path, const bool asFastAsPossible) :
+        _path{ path },
+        _asFastAsPossible{ asFastAsPossible }
+    {
+    }
+
+    ReplayConnection::~ReplayConnection()
+    {
+        _closing.SetEvent();
+        if (_hReplayThread)
+        {
+            WaitForSingleObject(_hReplayThread.get(), INFINITE);
+        }
+    }
+
+    void ReplayConnection::Start()
+    {
+        _hReplayThread.reset(CreateThread(
+            nullptr,
+            0,
+            [](LPVOID lpParameter) noexcept {
+                ReplayConnection* const pInstance = static_cast<ReplayConnection*>(lpParameter);
+                if (pInstance)
+                {
+                    return pInstance->_ReplayThread();
+                }
+                return gsl::narrow_cast<DWORD>(E_INVALIDARG);
+            },
+            this,
+            0,
+            nullptr));
+
+        THROW_LAST_ERROR_IF_NULL(_hReplayThread);
+
+        LOG_IF_FAILED(SetThreadDescription(_hReplayThread.get(), L"ReplayConnection Thread"));
+
+        _TransitionToState(ConnectionState::Connected);
+    }
+
+    void ReplayConnection::Close()
+    {
+        _closing.SetEvent();
+        if (_hReplayThread)
+        {
+            WaitForSingleObject(_hReplayThread.get(), INFINITE);
+            _hReplayThread.reset();
+        }
+        _TransitionToState(ConnectionState::Closed);
+    }
+
+    ConnectionState ReplayConnection::State() const noexcept
+    {
+        return _state.load();
+    }
+
+    void ReplayConnection::_TransitionToState(const ConnectionState state)
+    {
+        if (_state.exchange(state) != state)
+        {
+            _StateChangedHandlers(*this, nullptr);
+        }
+    }
+
+    // Routine Description:
+    // - Reads the recording a line at a time, and sends the output events in
+    //   it to the terminal. Unless the replay is as fast as possible, each
+    //   event is held back until as much time has passed since the replay
+    //   started as had when it was recorded.
+    DWORD ReplayConnection::_ReplayThread()
+    try
+    {
+        std::ifstream file{ _path, std::ios::binary };
+        if (!file)
+        {
+            _TerminalOutputHandlers(fmt::format(FMT_STRING(L"\x1b[31mCouldn't open the recording {}\x1b[m\r\n"), _path.native()));
+            _TransitionToState(ConnectionState::Failed);
+            return ERROR_FILE_NOT_FOUND;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        std::string line;
+        std::wstring wideLine;
+        ReplayEvent event;
+        while (std::getline(file, line))
+        {
+            if (_closing.is_signaled())
+            {
+                return 0;
+            }
+
+            if (FAILED(til::u8u16(line, wideLine)) || !_ParseEvent(wideLine, event) || event.type != L"o")
+            {
+                continue;
+            }
+
+            if (!_asFastAsPossible)
+            {
+                const auto due = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(event.time));
+                const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(due - std::chrono::steady_clock::now());
+                if (wait.count() > 0 && _closing.wait(gsl::narrow_cast<DWORD>(wait.count())))
+                {
+                    return 0;
+                }
+            }
+
+            _TerminalOutputHandlers(event.data);
+        }
+
+        _TransitionToState(ConnectionState::Closed);
+        return 0;
+    }
+    catch (...)
+    {
+        LOG_CAUGHT_EXCEPTION();
+        _TransitionToState(ConnectionState::Failed);
+        return gsl::narrow_cast<DWORD>(wil::ResultFromCaughtException());
+    }
+}
+
+// Function Description
+// - Wraps a connection in one that records its traffic into the asciicast
+//   file at path.
+ITerminalConnection OpenRecordingConnection(ITerminalConnection baseConnection, const std::filesystem::path& path)
+{
+    using namespace winrt::Microsoft::TerminalApp::implementation;
+    return winrt::make<RecordingConnection>(std::move(baseConnection), path);
+}
+
+// Function Description
+// - Creates a connection that plays back the asciicast file at path.
+ITerminalConnection OpenReplayConnection(const std::filesystem::path& path, const bool asFastAsPossible)
+{
+    using namespace winrt::Microsoft::TerminalApp::implementation;
+    return winrt::make<ReplayConnection>(path, asFastAsPossible);
+}
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <winrt/Microsoft.Terminal.TerminalConnection.h>
+#include "../../inc/cppwinrt_utils.h"
+
+namespace winrt::Microsoft::TerminalApp::implementation
+{
+    // RecordingConnection wraps a connection and writes everything it outputs,
+    // everything written into it and every resize into an asciicast (v2) file,
+    // along with the time it happened.
+    class RecordingConnection : public winrt::implements<RecordingConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection>
+    {
+    public:
+        RecordingConnection(Microsoft::Terminal::TerminalConnection::ITerminalConnection wrappedConnection, const std::filesystem::path& path);
+        void Initialize(const Windows::Foundation::Collections::ValueSet& /*settings*/){};
+        ~RecordingConnection() = default;
+        void Start();
+        void WriteInput(hstring const& data);
+        void Resize(uint32_t rows, uint32_t columns);
+        void Close();
+        winrt::Microsoft::Terminal::TerminalConnection::ConnectionState State() const noexcept;
+
+        WINRT_CALLBACK(TerminalOutput, winrt::Microsoft::Terminal::TerminalConnection::TerminalOutputHandler);
+
+        TYPED_EVENT(StateChanged, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Windows::Foundation::IInspectable);
+
+    private:
+        void _OutputHandler(const hstring str);
+        void _WriteEvent(const std::wstring_view type, const std::wstring_view data);
+        void _WriteHeaderUnderLock();
+
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::TerminalOutput_revoker _outputRevoker;
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::StateChanged_revoker _stateChangedRevoker;
+        winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection _wrappedConnection;
+
+        // Output arrives on the connection's output thread, input and resizes
+        // on the UI thread. All of them go through this lock to the file.
+        std::mutex _fileLock;
+        wil::unique_hfile _file;
+        std::chrono::steady_clock::time_point _start;
+        int64_t _timestamp;
+        uint32_t _rows{ 30 };
+        uint32_t _columns{ 120 };
+        bool _headerWritten{ false };
+    };
+
+    // ReplayConnection plays back the output of a recording made by a
+    // RecordingConnection (or any asciicast v2 file), either with the
+    // recorded timing or as fast as possible. Input written into it is
+    // dropped, the output of the recording echoes what was typed already.
+    class ReplayConnection : public winrt::implements<ReplayConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection>
+    {
+    public:
+        ReplayConnection(const std::filesystem::path& path, const bool asFastAsPossible);
+        void Initialize(const Windows::Foundation::Collections::ValueSet& /*settings*/){};
+        ~ReplayConnection();
+        void Start();
+        void WriteInput(hstring const& /*data*/){};
+        void Resize(uint32_t /*rows*/, uint32_t /*columns*/){};
+        void Close();
+        winrt::Microsoft::Terminal::TerminalConnection::ConnectionState State() const noexcept;
+
+        WINRT_CALLBACK(TerminalOutput, winrt::Microsoft::Terminal::TerminalConnection::TerminalOutputHandler);
+
+        TYPED_EVENT(StateChanged, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Windows::Foundation::IInspectable);
+
+    private:
+        DWORD _ReplayThread();
+        void _TransitionToState(const winrt::Microsoft::Terminal::TerminalConnection::ConnectionState state);
+
+        std::filesystem::path _path;
+        bool _asFastAsPossible;
+        wil::unique_handle _hReplayThread;
+        wil::unique_event _closing{ wil::EventOptions::ManualReset };
+        std::atomic<winrt::Microsoft::Terminal::TerminalConnection::ConnectionState> _state{ winrt::Microsoft::Terminal::TerminalConnection::ConnectionState::NotConnected };
+    };
+}
+
+winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection OpenRecordingConnection(winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection baseConnection, const std::filesystem::path& path);
+winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection OpenReplayConnection(const std::filesystem::path& path, const bool asFastAsPossible);
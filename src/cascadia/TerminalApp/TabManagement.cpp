@@ -18,6 +18,7 @@
 #include "TabRowControl.h"
 #include "ColorHelper.h"
 #include "DebugTapConnection.h"
+#include "RecordingConnection.h"
 #include "SettingsTab.h"
 
 using namespace winrt;
@@ -107,6 +108,31 @@ namespace winrt::TerminalApp::implementation
         // Create a connection based on the values in our settings object if we weren't given one.
         auto connection = existingConnection ? existingConnection : _CreateConnectionFromSettings(profileGuid, settings.DefaultSettings());
 
+        // With debug features on, sessions can be recorded into (and played
+        // back from) asciicast files, which lets a perf bug's workload be
+        // captured once and replayed against new builds.
+        // - WT_RECORD_SESSIONS names a directory every new session is recorded into.
+        // - WT_REPLAY_SESSION names a recording that every new tab plays back
+        //   instead of starting its profile, with the recorded timing unless
+        //   WT_REPLAY_AS_FAST_AS_POSSIBLE is set.
+        if (_settings.GlobalSettings().DebugFeaturesEnabled())
+        {
+            if (const auto replay{ wil::TryGetEnvironmentVariableW<std::wstring>(L"WT_REPLAY_SESSION") }; !replay.empty())
+            {
+                const auto asFastAsPossible = !wil::TryGetEnvironmentVariableW<std::wstring>(L"WT_REPLAY_AS_FAST_AS_POSSIBLE").empty();
+                connection = OpenReplayConnection(replay, asFastAsPossible);
+            }
+            else if (const auto directory{ wil::TryGetEnvironmentVariableW<std::wstring>(L"WT_RECORD_SESSIONS") }; !directory.empty())
+            {
+                const auto name = fmt::format(FMT_STRING(L"{}.cast"), ::Microsoft::Console::Utils::GuidToString(::Microsoft::Console::Utils::CreateGuid()));
+                try
+                {
+                    connection = OpenRecordingConnection(connection, std::filesystem::path{ directory } / name);
+                }
+                CATCH_LOG();
+            }
+        }
+
         // If we had an `existingConnection`, then this is an inbound handoff from somewhere else.
         // We need to tell it about our size information so it can match the dimensions of what
         // we are about to present.
@@ -442,6 +468,14 @@ namespace winrt::TerminalApp::implementation
             _mruTabs.RemoveAt(mruIndex);
         }
 
+        // With warm tabs, the content of a tab in the background may still
+        // be in the tree. Don't let it hold on to the control.
+        uint32_t contentIndex{};
+        if (_tabContent.Children().IndexOf(tab.Content(), contentIndex))
+        {
+            _tabContent.Children().RemoveAt(contentIndex);
+        }
+
         _tabs.RemoveAt(tabIndex);
         _tabView.TabItems().RemoveAt(tabIndex);
         _UpdateTabIndices();
@@ -449,6 +483,7 @@ namespace winrt::TerminalApp::implementation
         // To close the window here, we need to close the hosting window.
         if (_tabs.Size() == 0)
         {
+            _FlushClipboard();
             _LastTabClosedHandlers(*this, nullptr);
         }
         else if (focusedTabIndex.has_value() && focusedTabIndex.value() == gsl::narrow_cast<uint32_t>(tabIndex))
@@ -795,8 +830,7 @@ namespace winrt::TerminalApp::implementation
 
         try
         {
-            _tabContent.Children().Clear();
-            _tabContent.Children().Append(tab.Content());
+            _SetTabContent(tab);
 
             // GH#7409: If the tab switcher is open, then we _don't_ want to
             // automatically focus the new tab here. The tab switcher wants
@@ -825,6 +859,72 @@ namespace winrt::TerminalApp::implementation
         CATCH_LOG();
     }
 
+    // Method Description:
+    // - Puts the content of the given tab into the tab content area.
+    // - With "experimental.warmTabCount" set, the content of that many of the
+    //   most recently used tabs stays in the tree, collapsed, instead of being
+    //   detached. Their layout and the last frame of their swap chains are
+    //   kept, so switching back to them doesn't have to lay them out and
+    //   present them again first.
+    // Arguments:
+    // - tab: the tab whose content should be shown
+    // Return Value:
+    // - <none>
+    void TerminalPage::_SetTabContent(const winrt::TerminalApp::TabBase& tab)
+    {
+        const auto content = tab.Content();
+        const auto children = _tabContent.Children();
+        const auto warmTabCount = gsl::narrow_cast<size_t>(std::max(0, _settings.GlobalSettings().WarmTabCount()));
+
+        content.Visibility(Visibility::Visible);
+
+        if (warmTabCount == 0)
+        {
+            children.Clear();
+            children.Append(content);
+            return;
+        }
+
+        // The content to keep: this tab's, then the most recently used ones.
+        std::vector<UIElement> warmContent{ content };
+        for (const auto& mruTab : _mruTabs)
+        {
+            if (warmContent.size() > warmTabCount)
+            {
+                break;
+            }
+            if (mruTab != tab)
+            {
+                warmContent.emplace_back(mruTab.Content());
+            }
+        }
+
+        // Anything else gets detached. That's the tabs that fell out of the
+        // list, but also the old roots of tabs whose content changed.
+        for (auto i = children.Size(); i-- > 0;)
+        {
+            const auto child = children.GetAt(i);
+            if (child == content)
+            {
+                continue;
+            }
+            if (std::find(warmContent.begin(), warmContent.end(), child) == warmContent.end())
+            {
+                children.RemoveAt(i);
+            }
+            else
+            {
+                child.Visibility(Visibility::Collapsed);
+            }
+        }
+
+        uint32_t index{};
+        if (!children.IndexOf(content, index))
+        {
+            children.Append(content);
+        }
+    }
+
     // Method Description:
     // - Responds to the TabView control's Selection Changed event (to move a
     //      new terminal control into focus) when not in in the middle of a tab rearrangement.
@@ -820,13 +820,18 @@ namespace winrt::TerminalApp::implementation
             }
 
             auto conhostConn = TerminalConnection::ConptyConnection();
-            conhostConn.Initialize(TerminalConnection::ConptyConnection::CreateSettings(settings.Commandline(),
-                                                                                        newWorkingDirectory,
-                                                                                        settings.StartingTitle(),
-                                                                                        envMap.GetView(),
-                                                                                        ::base::saturated_cast<uint32_t>(settings.InitialRows()),
-                                                                                        ::base::saturated_cast<uint32_t>(settings.InitialCols()),
-                                                                                        winrt::guid()));
+            auto valueSet = TerminalConnection::ConptyConnection::CreateSettings(settings.Commandline(),
+                                                                                 newWorkingDirectory,
+                                                                                 settings.StartingTitle(),
+                                                                                 envMap.GetView(),
+                                                                                 ::base::saturated_cast<uint32_t>(settings.InitialRows()),
+                                                                                 ::base::saturated_cast<uint32_t>(settings.InitialCols()),
+                                                                                 winrt::guid());
+            if (profile.ConnectionPassthroughMode())
+            {
+                valueSet.Insert(L"passthroughMode", winrt::box_value(true));
+            }
+            conhostConn.Initialize(valueSet);
 
             sessionGuid = conhostConn.Guid();
             connection = conhostConn;
@@ -1021,8 +1026,7 @@ namespace winrt::TerminalApp::implementation
                 {
                     if (*tab == page->_GetFocusedTab())
                     {
-                        page->_tabContent.Children().Clear();
-                        page->_tabContent.Children().Append(tab->Content());
+                        page->_SetTabContent(*tab);
 
                         tab->Focus(FocusState::Programmatic);
                     }
@@ -1160,6 +1164,26 @@ namespace winrt::TerminalApp::implementation
         _RemoveAllTabs();
     }
 
+    // Method Description:
+    // - Tells every control in every tab whether the window is visible.
+    //   Controls in background tabs already know they're hidden, since they
+    //   aren't in the UI tree, but a minimized window still has its focused
+    //   tab loaded.
+    // Arguments:
+    // - showOrHide: false if the window was minimized
+    // Return Value:
+    // - <none>
+    void TerminalPage::WindowVisibilityChanged(const bool showOrHide)
+    {
+        for (const auto& tab : _tabs)
+        {
+            if (auto terminalTab{ _GetTerminalTabImpl(tab) })
+            {
+                terminalTab->WindowVisibilityChanged(showOrHide);
+            }
+        }
+    }
+
     // Method Description:
     // - Move the viewport of the terminal of the currently focused tab up or
     //      down a number of lines.
@@ -1514,32 +1538,90 @@ namespace winrt::TerminalApp::implementation
         // copy text to dataPack
         dataPack.SetText(copiedData.Text());
 
+        // HTML and RTF are offered with delayed rendering. They're only
+        // generated if the paste target actually asks for them, and most
+        // targets only want the text.
+        bool hasDelayedFormats = false;
         if (WI_IsFlagSet(copyFormats, CopyFormat::HTML))
         {
-            // copy html to dataPack
-            const auto htmlData = copiedData.Html();
-            if (!htmlData.empty())
-            {
-                dataPack.SetHtmlFormat(htmlData);
-            }
+            dataPack.SetDataProvider(StandardDataFormats::Html(), [copiedData](const DataProviderRequest& request) {
+                _ProvideDelayedClipboardFormat(request, copiedData, CopyFormat::HTML);
+            });
+            hasDelayedFormats = true;
         }
 
         if (WI_IsFlagSet(copyFormats, CopyFormat::RTF))
         {
-            // copy rtf data to dataPack
-            const auto rtfData = copiedData.Rtf();
-            if (!rtfData.empty())
+            dataPack.SetDataProvider(StandardDataFormats::Rtf(), [copiedData](const DataProviderRequest& request) {
+                _ProvideDelayedClipboardFormat(request, copiedData, CopyFormat::RTF);
+            });
+            hasDelayedFormats = true;
+        }
+
+        try
+        {
+            Clipboard::SetContent(dataPack);
+
+            // Flushing lets the clipboard outlive us, but it renders every
+            // delayed format right away. If we have any, we put the flush off
+            // until the window closes (see _FlushClipboard).
+            _clipboardFlushPending = hasDelayedFormats;
+            if (!hasDelayedFormats)
             {
-                dataPack.SetRtf(rtfData);
+                Clipboard::Flush();
             }
         }
+        CATCH_LOG();
+    }
+
+    // Method Description:
+    // - Generates a delayed clipboard format when a paste target asks for it.
+    //   The generation happens in the background, since it can take a while
+    //   for large selections.
+    // Arguments:
+    // - request: the clipboard's request for the data
+    // - copiedData: the copied data to generate the format from
+    // - format: either CopyFormat::HTML or CopyFormat::RTF
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget TerminalPage::_ProvideDelayedClipboardFormat(const DataProviderRequest request,
+                                                                        const CopyToClipboardEventArgs copiedData,
+                                                                        const CopyFormat format)
+    {
+        const auto deferral = request.GetDeferral();
+        co_await winrt::resume_background();
 
         try
         {
-            Clipboard::SetContent(dataPack);
-            Clipboard::Flush();
+            const auto data = format == CopyFormat::HTML ? copiedData.Html() : copiedData.Rtf();
+            request.SetData(winrt::box_value(data));
         }
         CATCH_LOG();
+
+        deferral.Complete();
+    }
+
+    // Method Description:
+    // - Flushes the clipboard if we still owe it delayed formats, so that the
+    //   data stays available after this window is gone. Called when the last
+    //   tab closes.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TerminalPage::_FlushClipboard()
+    {
+        if (_clipboardFlushPending)
+        {
+            _clipboardFlushPending = false;
+            try
+            {
+                // This fails harmlessly if someone else has taken over the
+                // clipboard since we copied.
+                Clipboard::Flush();
+            }
+            CATCH_LOG();
+        }
     }
 
     // Function Description:
@@ -1796,6 +1878,80 @@ namespace winrt::TerminalApp::implementation
         }
     }
 
+    // Method Description:
+    // - Writes the contents of the control's buffer to a file. If no path was
+    //   given, asks the user for one with a save dialog first.
+    // Arguments:
+    // - control: the control whose buffer to export
+    // - path: the file to write to, or empty to ask the user
+    // - includeAttributes: whether to write the text's attributes as SGR sequences
+    winrt::fire_and_forget TerminalPage::_ExportBuffer(const TermControl control, winrt::hstring path, const bool includeAttributes)
+    {
+        try
+        {
+            if (path.empty())
+            {
+                auto fileDialog{ winrt::create_instance<IFileSaveDialog>(CLSID_FileSaveDialog) };
+                DWORD flags{};
+                THROW_IF_FAILED(fileDialog->GetOptions(&flags));
+                THROW_IF_FAILED(fileDialog->SetOptions(flags | FOS_FORCEFILESYSTEM | FOS_NOCHANGEDIR | FOS_DONTADDTORECENT));
+
+                static constexpr COMDLG_FILTERSPEC supportedFileTypes[] = {
+                    { L"Text Files (*.txt)", L"*.txt" },
+                    { L"All Files (*.*)", L"*.*" },
+                };
+                THROW_IF_FAILED(fileDialog->SetFileTypes(ARRAYSIZE(supportedFileTypes), supportedFileTypes));
+                THROW_IF_FAILED(fileDialog->SetDefaultExtension(L"txt"));
+
+                const auto hr{ fileDialog->Show(_hostingHwnd.value_or(nullptr)) };
+                if (hr == HRESULT_FROM_WIN32(ERROR_CANCELLED))
+                {
+                    co_return;
+                }
+                THROW_IF_FAILED(hr);
+
+                winrt::com_ptr<IShellItem> result;
+                THROW_IF_FAILED(fileDialog->GetResult(result.put()));
+
+                wil::unique_cotaskmem_string filePath;
+                THROW_IF_FAILED(result->GetDisplayName(SIGDN_FILESYSPATH, &filePath));
+                path = filePath.get();
+            }
+
+            co_await control.ExportBuffer(path, includeAttributes);
+        }
+        CATCH_LOG();
+    }
+
+    // Method Description:
+    // - Has every control in this window write its memory usage as an event,
+    //   then writes the sum for the whole window.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TerminalPage::_ReportMemoryUsage()
+    {
+        uint64_t total = 0;
+        uint32_t controls = 0;
+        for (const auto& tab : _tabs)
+        {
+            if (auto tabImpl{ _GetTerminalTabImpl(tab) })
+            {
+                total += tabImpl->ReportMemoryUsage();
+                controls += gsl::narrow_cast<uint32_t>(tabImpl->GetLeafPaneCount());
+            }
+        }
+
+        TraceLoggingWrite(
+            g_hTerminalAppProvider,
+            "WindowMemoryUsage",
+            TraceLoggingDescription("The memory held by all the controls in a window, in bytes. Each control writes its own MemoryUsage event."),
+            TraceLoggingUInt32(controls, "Controls"),
+            TraceLoggingUInt64(total, "Total"),
+            TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+    }
+
     // Function Description:
     // - Called when the settings button is clicked. ShellExecutes the settings
     //   file, as to open it in the default editor for .json files. Does this in
@@ -70,6 +70,7 @@ namespace winrt::TerminalApp::implementation
         winrt::hstring ApplicationVersion();
 
         winrt::fire_and_forget CloseWindow();
+        void WindowVisibilityChanged(const bool showOrHide);
 
         void ToggleFocusMode();
         void ToggleFullscreen();
@@ -151,6 +152,10 @@ namespace winrt::TerminalApp::implementation
         TerminalApp::SettingsTab _settingsTab{ nullptr };
 
         bool _isInFocusMode{ false };
+
+        // Set while the clipboard holds formats we haven't rendered yet.
+        // See _CopyToClipboardHandler.
+        bool _clipboardFlushPending{ false };
         bool _isFullscreen{ false };
         bool _isAlwaysOnTop{ false };
         winrt::hstring _WindowName{};
@@ -268,6 +273,10 @@ namespace winrt::TerminalApp::implementation
         void _SetAcceleratorForMenuItem(Windows::UI::Xaml::Controls::MenuFlyoutItem& menuItem, const winrt::Microsoft::Terminal::Control::KeyChord& keyChord);
 
         winrt::fire_and_forget _CopyToClipboardHandler(const IInspectable sender, const winrt::Microsoft::Terminal::Control::CopyToClipboardEventArgs copiedData);
+        static winrt::fire_and_forget _ProvideDelayedClipboardFormat(const winrt::Windows::ApplicationModel::DataTransfer::DataProviderRequest request,
+                                                                     const winrt::Microsoft::Terminal::Control::CopyToClipboardEventArgs copiedData,
+                                                                     const winrt::Microsoft::Terminal::Control::CopyFormat format);
+        void _FlushClipboard();
         winrt::fire_and_forget _PasteFromClipboardHandler(const IInspectable sender,
                                                           const Microsoft::Terminal::Control::PasteFromClipboardEventArgs eventArgs);
 
@@ -281,6 +290,9 @@ namespace winrt::TerminalApp::implementation
 
         void _PasteText();
 
+        winrt::fire_and_forget _ExportBuffer(const Microsoft::Terminal::Control::TermControl control, winrt::hstring path, const bool includeAttributes);
+        void _ReportMemoryUsage();
+
         winrt::fire_and_forget _ControlNoticeRaisedHandler(const IInspectable sender, const Microsoft::Terminal::Control::NoticeEventArgs eventArgs);
         void _ShowControlNoticeDialog(const winrt::hstring& title, const winrt::hstring& message);
 
@@ -296,6 +308,7 @@ namespace winrt::TerminalApp::implementation
         void _OnTabCloseRequested(const IInspectable& sender, const Microsoft::UI::Xaml::Controls::TabViewTabCloseRequestedEventArgs& eventArgs);
         void _OnFirstLayout(const IInspectable& sender, const IInspectable& eventArgs);
         void _UpdatedSelectedTab(const winrt::TerminalApp::TabBase& tab);
+        void _SetTabContent(const winrt::TerminalApp::TabBase& tab);
 
         void _OnDispatchCommandRequested(const IInspectable& sender, const Microsoft::Terminal::Settings::Model::Command& command);
         void _OnCommandLineExecutionRequested(const IInspectable& sender, const winrt::hstring& commandLine);
@@ -553,6 +553,13 @@ namespace winrt::TerminalApp::implementation
         _rootPane->Shutdown();
     }
 
+    // Method Description:
+    // - Forwards a change in the window's visibility to every pane in this tab.
+    void TerminalTab::WindowVisibilityChanged(const bool showOrHide)
+    {
+        _rootPane->WindowVisibilityChanged(showOrHide);
+    }
+
     // Method Description:
     // - Closes the currently focused pane in this tab. If it's the last pane in
     //   this tab, our Closed event will be fired (at a later time) for anyone
@@ -1249,6 +1256,17 @@ namespace winrt::TerminalApp::implementation
         return _rootPane->GetLeafPaneCount();
     }
 
+    // Method Description:
+    // - Has every control hosted by this tab report its memory usage.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - The memory used by all the controls in this tab, in bytes.
+    uint64_t TerminalTab::ReportMemoryUsage()
+    {
+        return _rootPane->ReportMemoryUsage();
+    }
+
     // Method Description:
     // - This is a helper to determine which direction an "Automatic" split should
     //   happen in for the active pane of this tab, but without using the ActualWidth() and
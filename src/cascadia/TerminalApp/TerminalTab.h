@@ -61,6 +61,7 @@ namespace winrt::TerminalApp::implementation
         winrt::fire_and_forget UpdateTitle();
 
         void Shutdown() override;
+        void WindowVisibilityChanged(const bool showOrHide);
         void ClosePane();
 
         void SetTabText(winrt::hstring title);
@@ -80,6 +81,7 @@ namespace winrt::TerminalApp::implementation
         void ExitZoom();
 
         int GetLeafPaneCount() const noexcept;
+        uint64_t ReportMemoryUsage();
 
         void TogglePaneReadOnly();
         std::shared_ptr<Pane> GetActivePane() const;
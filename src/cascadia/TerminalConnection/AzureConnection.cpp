@@ -31,6 +31,10 @@ static constexpr auto HttpUserAgent = L"Terminal/0.0";
 static constexpr int USER_INPUT_COLOR = 93; // yellow - the color of something the user can type
 static constexpr int USER_INFO_COLOR = 97; // white - the color of clarifying information
 
+// The most output we'll collect from messages that already arrived before
+// passing it on to the terminal.
+static constexpr size_t MaxOutputBatchSize = 64 * 1024;
+
 static constexpr winrt::guid AzureConnectionType = { 0xd9fcfdfa, 0xa479, 0x412c, { 0x83, 0xb7, 0xc5, 0x64, 0xe, 0x61, 0xcd, 0x62 } };
 
 static inline std::wstring _colorize(const unsigned int colorCode, const std::wstring_view text)
@@ -184,11 +188,18 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         if (_state == AzureState::TermConnected)
         {
             // If we're connected, we don't need to do any fun input shenanigans.
-            websocket_outgoing_message msg;
-            const auto str = winrt::to_string(data);
-            msg.set_utf8_message(str);
-
-            _cloudShellSocket.send(msg).get();
+            // Input that's written while a message is still being sent
+            // is sent together as the next message, once that's done.
+            {
+                std::lock_guard<std::mutex> lock{ _sendMutex };
+                _pendingInput.append(winrt::to_string(data));
+                if (_sendInFlight)
+                {
+                    return;
+                }
+                _sendInFlight = true;
+            }
+            _SendPendingInput();
             return;
         }
 
@@ -252,6 +263,50 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
     }
     CATCH_LOG();
 
+    // Method description:
+    // - sends all the input that was written since the last message was
+    //   sent as a single message. Once it's sent, this is called again, until
+    //   there's nothing left to send.
+    void AzureConnection::_SendPendingInput()
+    {
+        std::string input;
+        {
+            std::lock_guard<std::mutex> lock{ _sendMutex };
+            if (_pendingInput.empty())
+            {
+                _sendInFlight = false;
+                return;
+            }
+            input.swap(_pendingInput);
+        }
+
+        try
+        {
+            websocket_outgoing_message msg;
+            msg.set_utf8_message(std::move(input));
+
+            _cloudShellSocket.send(msg).then([weakThis = get_weak()](const pplx::task<void>& sent) {
+                try
+                {
+                    sent.get();
+                }
+                CATCH_LOG();
+
+                if (auto self{ weakThis.get() })
+                {
+                    self->_SendPendingInput();
+                }
+            });
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+
+            std::lock_guard<std::mutex> lock{ _sendMutex };
+            _sendInFlight = false;
+        }
+    }
+
     // Method description:
     // - ascribes to the ITerminalConnection interface
     // - closes the websocket connection and the output thread
@@ -382,17 +437,28 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                 case AzureState::TermConnected:
                 {
                     _transitionToState(ConnectionState::Connected);
+                    auto nextMessage = _cloudShellSocket.receive();
+                    std::string output;
                     while (true)
                     {
-                        // Read from websocket
-                        pplx::task<websocket_incoming_message> msgT;
+                        // Read from websocket. Messages that have already
+                        // arrived are collected and passed on together.
                         try
                         {
-                            msgT = _cloudShellSocket.receive();
-                            msgT.wait();
+                            do
+                            {
+                                auto msg = nextMessage.get();
+                                output.append(msg.extract_string().get());
+                                nextMessage = _cloudShellSocket.receive();
+                            } while (output.size() < MaxOutputBatchSize && nextMessage.is_done());
                         }
                         catch (...)
                         {
+                            if (!output.empty())
+                            {
+                                _TerminalOutputHandlers(winrt::to_hstring(output));
+                            }
+
                             // Websocket has been closed; consider it a graceful exit?
                             // This should result in our termination.
                             if (_transitionToState(ConnectionState::Closed))
@@ -400,17 +466,12 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
                                 // End the output thread.
                                 return S_FALSE;
                             }
+                            throw;
                         }
 
-                        auto msg = msgT.get();
-                        auto msgStringTask = msg.extract_string();
-                        auto msgString = msgStringTask.get();
-
-                        // Convert to hstring
-                        const auto hstr = winrt::to_hstring(msgString);
-
                         // Pass the output to our registered event handlers
-                        _TerminalOutputHandlers(hstr);
+                        _TerminalOutputHandlers(winrt::to_hstring(output));
+                        output.clear();
                     }
                     return S_OK;
                 }
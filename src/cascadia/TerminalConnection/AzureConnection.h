@@ -96,6 +96,13 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         std::optional<std::wstring> _ReadUserInput(InputMode mode);
 
+        // Protects the input that's waiting to be sent while connected.
+        std::mutex _sendMutex;
+        std::string _pendingInput;
+        bool _sendInFlight{ false };
+
+        void _SendPendingInput();
+
         web::websockets::client::websocket_client _cloudShellSocket;
 
         static std::optional<utility::string_t> _ParsePreferredShellType(const web::json::value& settingsResponse);
@@ -35,11 +35,40 @@ using namespace ::Microsoft::Console;
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
     // Function Description:
-    // - creates some basic anonymous pipes and passes them to CreatePseudoConsole
+    // - Creates the pipe the pseudoconsole's output is read from. Unlike
+    //   anonymous pipes, our end of it is opened for overlapped I/O, so that it
+    //   can be read through the thread pool instead of by a dedicated thread.
+    //   The pseudoconsole's end is a regular synchronous handle.
+    // Arguments:
+    // - phOurSide: Receives the handle to read from.
+    // - phPseudoConsoleSide: Receives the handle the pseudoconsole writes to.
+    static HRESULT _CreateOverlappedOutputPipe(wil::unique_hfile& ourSide, wil::unique_hfile& pseudoConsoleSide) noexcept
+    try
+    {
+        const auto pipeName = fmt::format(L"\\\\.\\pipe\\conpty-output-{}-{}", GetCurrentProcessId(), Utils::GuidToString(Utils::CreateGuid()));
+
+        ourSide.reset(CreateNamedPipeW(pipeName.c_str(),
+                                       PIPE_ACCESS_INBOUND | FILE_FLAG_OVERLAPPED | FILE_FLAG_FIRST_PIPE_INSTANCE,
+                                       PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                       1, // one instance
+                                       0, // default out buffer size, like CreatePipe
+                                       0, // default in buffer size
+                                       0, // default timeout
+                                       nullptr));
+        RETURN_LAST_ERROR_IF(!ourSide);
+
+        pseudoConsoleSide.reset(CreateFileW(pipeName.c_str(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr));
+        RETURN_LAST_ERROR_IF(!pseudoConsoleSide);
+        return S_OK;
+    }
+    CATCH_RETURN()
+
+    // Function Description:
+    // - creates some basic pipes and passes them to CreatePseudoConsole
     // Arguments:
     // - size: The size of the conpty to create, in characters.
     // - phInput: Receives the handle to the newly-created anonymous pipe for writing input to the conpty.
-    // - phOutput: Receives the handle to the newly-created anonymous pipe for reading the output of the conpty.
+    // - phOutput: Receives the handle to the newly-created overlapped pipe for reading the output of the conpty.
     // - phPc: Receives a token value to identify this conpty
 #pragma warning(suppress : 26430) // This statement sufficiently checks the out parameters. Analyzer cannot find this.
     static HRESULT _CreatePseudoConsoleAndPipes(const COORD size, const DWORD dwFlags, HANDLE* phInput, HANDLE* phOutput, HPCON* phPC) noexcept
@@ -50,13 +79,115 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         wil::unique_hfile inPipeOurSide, inPipePseudoConsoleSide;
 
         RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&inPipePseudoConsoleSide, &inPipeOurSide, nullptr, 0));
-        RETURN_IF_WIN32_BOOL_FALSE(CreatePipe(&outPipeOurSide, &outPipePseudoConsoleSide, nullptr, 0));
+        RETURN_IF_FAILED(_CreateOverlappedOutputPipe(outPipeOurSide, outPipePseudoConsoleSide));
         RETURN_IF_FAILED(ConptyCreatePseudoConsole(size, inPipePseudoConsoleSide.get(), outPipePseudoConsoleSide.get(), dwFlags, phPC));
         *phInput = inPipeOurSide.release();
         *phOutput = outPipeOurSide.release();
         return S_OK;
     }
 
+    // Every fresh connection creates its pseudoconsole with these flags.
+    static constexpr DWORD PseudoConsoleFlags = PSEUDOCONSOLE_RESIZE_QUIRK | PSEUDOCONSOLE_WIN32_INPUT_MODE | PSEUDOCONSOLE_TERMINAL_REFLOW | PSEUDOCONSOLE_REPEAT_CHARACTER;
+
+    // The size a pseudoconsole is created at before we know which connection
+    // it's for. It's resized to the real size when it's claimed.
+    static constexpr COORD PrewarmedPseudoConsoleSize{ 80, 25 };
+
+    // Starting OpenConsole is a good part of the time it takes to open a new
+    // tab, and it doesn't depend on the profile at all: the commandline,
+    // environment and starting directory only matter to the client. So once
+    // the first connection has started, we keep one pseudoconsole (without a
+    // client) ready for the next one.
+    struct PrewarmedPseudoConsole
+    {
+        wil::unique_hfile inPipe;
+        wil::unique_hfile outPipe;
+        wil::unique_static_pseudoconsole_handle hPC;
+    };
+
+    static std::mutex s_prewarmedLock;
+    static std::optional<PrewarmedPseudoConsole> s_prewarmed;
+    static std::atomic<bool> s_prewarming{ false };
+
+    // Function Description:
+    // - Creates a pseudoconsole for the next connection on a threadpool
+    //   thread, unless there's one waiting already or one being created.
+    static void _PrewarmPseudoConsole() noexcept
+    {
+        if (s_prewarming.exchange(true))
+        {
+            return;
+        }
+
+        const auto submitted = TrySubmitThreadpoolCallback(
+            [](PTP_CALLBACK_INSTANCE /*callbackInstance*/, PVOID /*context*/) noexcept {
+                auto clearPrewarming = wil::scope_exit([]() noexcept { s_prewarming.store(false); });
+
+                try
+                {
+                    {
+                        const std::scoped_lock lock{ s_prewarmedLock };
+                        if (s_prewarmed)
+                        {
+                            return;
+                        }
+                    }
+
+                    PrewarmedPseudoConsole prewarmed;
+                    if (FAILED_LOG(_CreatePseudoConsoleAndPipes(PrewarmedPseudoConsoleSize, PseudoConsoleFlags, &prewarmed.inPipe, &prewarmed.outPipe, &prewarmed.hPC)))
+                    {
+                        return;
+                    }
+
+                    const std::scoped_lock lock{ s_prewarmedLock };
+                    s_prewarmed.emplace(std::move(prewarmed));
+                }
+                CATCH_LOG();
+            },
+            nullptr,
+            nullptr);
+
+        if (!submitted)
+        {
+            LOG_LAST_ERROR();
+            s_prewarming.store(false);
+        }
+    }
+
+    // Function Description:
+    // - Hands the prewarmed pseudoconsole, if there is one, to a connection.
+    // Arguments:
+    // - inPipe, outPipe, hPC: receive the pipes and the pseudoconsole.
+    // Return Value:
+    // - true if a prewarmed pseudoconsole was claimed. If not, the caller
+    //   has to create its own.
+    static bool _TryClaimPrewarmedPseudoConsole(wil::unique_hfile& inPipe, wil::unique_hfile& outPipe, wil::unique_static_pseudoconsole_handle& hPC)
+    {
+        std::optional<PrewarmedPseudoConsole> prewarmed;
+        {
+            const std::scoped_lock lock{ s_prewarmedLock };
+            prewarmed.swap(s_prewarmed);
+        }
+
+        if (!prewarmed)
+        {
+            return false;
+        }
+
+        // If OpenConsole went away while it was waiting (someone killed it),
+        // its end of the output pipe is closed and this fails. Destroying
+        // `prewarmed` cleans up what's left of it.
+        if (!PeekNamedPipe(prewarmed->outPipe.get(), nullptr, 0, nullptr, nullptr, nullptr))
+        {
+            return false;
+        }
+
+        inPipe = std::move(prewarmed->inPipe);
+        outPipe = std::move(prewarmed->outPipe);
+        hPC = std::move(prewarmed->hPC);
+        return true;
+    }
+
     // Function Description:
     // - Promotes a starting directory provided to a WSL invocation to a commandline argument.
     //   This is necessary because WSL has some modicum of support for linux-side directories (!) which
@@ -338,6 +469,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             _initialCols = winrt::unbox_value_or<uint32_t>(settings.TryLookup(L"initialCols").try_as<Windows::Foundation::IPropertyValue>(), _initialCols);
             _guid = winrt::unbox_value_or<winrt::guid>(settings.TryLookup(L"guid").try_as<Windows::Foundation::IPropertyValue>(), _guid);
             _environment = settings.TryLookup(L"environment").try_as<Windows::Foundation::Collections::ValueSet>();
+            _passthroughMode = winrt::unbox_value_or<bool>(settings.TryLookup(L"passthroughMode").try_as<Windows::Foundation::IPropertyValue>(), _passthroughMode);
         }
 
         if (_guid == guid{})
@@ -362,8 +494,36 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         // handoff from an already-started PTY process.
         if (!_inPipe)
         {
-            THROW_IF_FAILED(_CreatePseudoConsoleAndPipes(dimensions, PSEUDOCONSOLE_RESIZE_QUIRK | PSEUDOCONSOLE_WIN32_INPUT_MODE, &_inPipe, &_outPipe, &_hPC));
+            // Prewarmed pseudoconsoles are created without passthrough.
+            if (!_passthroughMode && _TryClaimPrewarmedPseudoConsole(_inPipe, _outPipe, _hPC))
+            {
+                // The client isn't attached yet, so it'll only ever see the right size.
+                THROW_IF_FAILED(ConptyResizePseudoConsole(_hPC.get(), dimensions));
+            }
+            else
+            {
+                const auto flags = PseudoConsoleFlags | (_passthroughMode ? PSEUDOCONSOLE_PASSTHROUGH_MODE : 0);
+                THROW_IF_FAILED(_CreatePseudoConsoleAndPipes(dimensions, flags, &_inPipe, &_outPipe, &_hPC));
+            }
+            _overlappedOutput = true;
             THROW_IF_FAILED(_LaunchAttachedClient());
+
+            // Get a pseudoconsole ready for the next connection.
+            _PrewarmPseudoConsole();
+
+            // Only the first connection in the process is part of starting up.
+            static std::atomic<bool> s_reportedStartupMilestone{ false };
+            if (!s_reportedStartupMilestone.exchange(true))
+            {
+                TraceLoggingWrite(
+                    g_hTerminalConnectionProvider,
+                    "StartupMilestone",
+                    TraceLoggingDescription("Event emitted when a step of starting up is complete"),
+                    TraceLoggingWideString(L"ConptyLaunched", "Milestone"),
+                    TraceLoggingFloat64(Utils::MillisecondsSinceProcessStart(), "MillisecondsSinceProcessStart"),
+                    TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                    TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+            }
         }
         // But if it was an inbound handoff... attempt to synchronize the size of it with what our connection
         // window is expecting it to be on the first layout.
@@ -374,27 +534,60 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         _startTime = std::chrono::high_resolution_clock::now();
 
-        // Create our own output handling thread
+        // Start reading the output.
         // This must be done after the pipes are populated.
         // Each connection needs to make sure to drain the output from its backing host.
-        _hOutputThread.reset(CreateThread(
-            nullptr,
-            0,
-            [](LPVOID lpParameter) noexcept {
-                ConptyConnection* const pInstance = static_cast<ConptyConnection*>(lpParameter);
-                if (pInstance)
-                {
-                    return pInstance->_OutputThread();
-                }
-                return gsl::narrow_cast<DWORD>(E_INVALIDARG);
-            },
-            this,
-            0,
-            nullptr));
+        _outputDrained.create(wil::EventOptions::ManualReset);
+        auto clearOutputDrained = wil::scope_exit([&]() noexcept { _outputDrained.reset(); });
 
-        THROW_LAST_ERROR_IF_NULL(_hOutputThread);
+        if (_overlappedOutput)
+        {
+            // Our own pipes are read through the thread pool, so that idle
+            // connections don't each hold on to a thread.
+            _outputIo.reset(CreateThreadpoolIo(
+                _outPipe.get(),
+                [](PTP_CALLBACK_INSTANCE /*callbackInstance*/, PVOID context, PVOID /*overlapped*/, ULONG ioResult, ULONG_PTR bytesTransferred, PTP_IO /*io*/) noexcept {
+                    ConptyConnection* const pInstance = static_cast<ConptyConnection*>(context);
+                    if (pInstance)
+                    {
+                        pInstance->_OutputReadCompleted(ioResult, gsl::narrow_cast<DWORD>(bytesTransferred));
+                    }
+                },
+                this,
+                nullptr));
 
-        LOG_IF_FAILED(SetThreadDescription(_hOutputThread.get(), L"ConptyConnection Output Thread"));
+            THROW_LAST_ERROR_IF_NULL(_outputIo);
+
+            // Keep us alive while a read is pending; the destructor won't
+            // wait for it, and the known exit points _do_.
+            _outputStrongThis = get_strong();
+            _StartOutputRead();
+        }
+        else
+        {
+            // The pipes of an inbound handoff are anonymous pipes, which
+            // don't support overlapped I/O. They get a thread of their own.
+            _hOutputThread.reset(CreateThread(
+                nullptr,
+                0,
+                [](LPVOID lpParameter) noexcept {
+                    ConptyConnection* const pInstance = static_cast<ConptyConnection*>(lpParameter);
+                    if (pInstance)
+                    {
+                        return pInstance->_OutputThread();
+                    }
+                    return gsl::narrow_cast<DWORD>(E_INVALIDARG);
+                },
+                this,
+                0,
+                nullptr));
+
+            THROW_LAST_ERROR_IF_NULL(_hOutputThread);
+
+            LOG_IF_FAILED(SetThreadDescription(_hOutputThread.get(), L"ConptyConnection Output Thread"));
+        }
+
+        clearOutputDrained.release();
 
         _clientExitWait.reset(CreateThreadpoolWait(
             [](PTP_CALLBACK_INSTANCE /*callbackInstance*/, PVOID context, PTP_WAIT /*wait*/, TP_WAIT_RESULT /*waitResult*/) noexcept {
@@ -473,10 +666,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         // Close the pseudoconsole and wait for all output to drain.
         _hPC.reset();
-        if (auto localOutputThreadHandle = std::move(_hOutputThread))
-        {
-            LOG_LAST_ERROR_IF(WAIT_FAILED == WaitForSingleObject(localOutputThreadHandle.get(), INFINITE));
-        }
+        _WaitForOutputDrained();
 
         _indicateExitWithStatus(exitCode);
 
@@ -526,13 +716,9 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             _inPipe.reset(); // break the pipes
             _outPipe.reset();
 
-            if (_hOutputThread)
-            {
-                // Tear down our output thread -- now that the output pipe was closed on the
-                // far side, we can run down our local reader.
-                LOG_LAST_ERROR_IF(WAIT_FAILED == WaitForSingleObject(_hOutputThread.get(), INFINITE));
-                _hOutputThread.reset();
-            }
+            // Tear down our output reader -- now that the output pipe was closed on the
+            // far side, we can run down our local reader.
+            _WaitForOutputDrained();
 
             if (_piClient.hProcess)
             {
@@ -546,11 +732,61 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
     }
     CATCH_LOG()
 
+    // Method Description:
+    // - Waits until the output reader stopped, and all output the pseudoconsole
+    //   wrote was handed to our TerminalOutput handlers.
+    void ConptyConnection::_WaitForOutputDrained() noexcept
+    {
+        if (_outputDrained)
+        {
+            LOG_LAST_ERROR_IF(WAIT_FAILED == WaitForSingleObject(_outputDrained.get(), INFINITE));
+        }
+        _hOutputThread.reset();
+    }
+
+    // Method Description:
+    // - Issues the next overlapped read on the output pipe. It completes in
+    //   _OutputReadCompleted, on a thread pool thread.
+    void ConptyConnection::_StartOutputRead() noexcept
+    {
+        StartThreadpoolIo(_outputIo.get());
+        if (!ReadFile(_outPipe.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), nullptr, &_outputOverlapped))
+        {
+            const auto lastError = GetLastError();
+            if (lastError != ERROR_IO_PENDING)
+            {
+                // There won't be a completion for this read.
+                CancelThreadpoolIo(_outputIo.get());
+                _OutputReadCompleted(lastError, 0);
+            }
+        }
+    }
+
+    // Method Description:
+    // - Called when an overlapped read on the output pipe completed, whether
+    //   it succeeded or not.
+    // Arguments:
+    // - error: the Win32 error code the read completed with.
+    // - read: the number of bytes read into _buffer.
+    void ConptyConnection::_OutputReadCompleted(const DWORD error, const DWORD read) noexcept
+    {
+        if (_HandleOutput(error, read))
+        {
+            _StartOutputRead();
+            return;
+        }
+
+        // This may be the last reference to us, see final_release().
+        auto strongThis{ std::move(_outputStrongThis) };
+        _outputDrained.SetEvent();
+    }
+
     DWORD ConptyConnection::_OutputThread()
     {
         // Keep us alive until the output thread terminates; the destructor
         // won't wait for us, and the known exit points _do_.
         auto strongThis{ get_strong() };
+        auto setDrained = wil::scope_exit([&]() noexcept { _outputDrained.SetEvent(); });
 
         // process the data of the output pipe in a loop
         while (true)
@@ -558,60 +794,79 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             DWORD read{};
 
             const auto readFail{ !ReadFile(_outPipe.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), &read, nullptr) };
-            if (readFail) // reading failed (we must check this first, because read will also be 0.)
+            if (!_HandleOutput(readFail ? GetLastError() : ERROR_SUCCESS, read))
             {
-                const auto lastError = GetLastError();
-                if (lastError != ERROR_BROKEN_PIPE && !_isStateAtOrBeyond(ConnectionState::Closing))
-                {
-                    // EXIT POINT
-                    _indicateExitWithStatus(HRESULT_FROM_WIN32(lastError)); // print a message
-                    _transitionToState(ConnectionState::Failed);
-                    return gsl::narrow_cast<DWORD>(HRESULT_FROM_WIN32(lastError));
-                }
-                // else we call convertUTF8ChunkToUTF16 with an empty string_view to convert possible remaining partials to U+FFFD
+                return 0;
             }
+        }
+    }
 
-            const HRESULT result{ til::u8u16(std::string_view{ _buffer.data(), read }, _u16Str, _u8State) };
-            if (FAILED(result))
+    // Method Description:
+    // - Converts a chunk of output read into _buffer and passes it to our
+    //   TerminalOutput handlers.
+    // Arguments:
+    // - error: the Win32 error code the read failed with, or ERROR_SUCCESS.
+    // - read: the number of bytes read into _buffer.
+    // Return Value:
+    // - true if the next chunk should be read, false if the output has ended.
+    bool ConptyConnection::_HandleOutput(const DWORD error, const DWORD read) noexcept
+    {
+        if (error != ERROR_SUCCESS) // reading failed (we must check this first, because read will also be 0.)
+        {
+            if (error != ERROR_BROKEN_PIPE && !_isStateAtOrBeyond(ConnectionState::Closing))
             {
-                if (_isStateAtOrBeyond(ConnectionState::Closing))
-                {
-                    // This termination was expected.
-                    return 0;
-                }
-
                 // EXIT POINT
-                _indicateExitWithStatus(result); // print a message
+                _indicateExitWithStatus(HRESULT_FROM_WIN32(error)); // print a message
                 _transitionToState(ConnectionState::Failed);
-                return gsl::narrow_cast<DWORD>(result);
+                return false;
             }
+            // else we call convertUTF8ChunkToUTF16 with an empty string_view to convert possible remaining partials to U+FFFD
+        }
 
-            if (_u16Str.empty())
+        const HRESULT result{ til::u8u16(std::string_view{ _buffer.data(), read }, _u16Str, _u8State) };
+        if (FAILED(result))
+        {
+            if (_isStateAtOrBeyond(ConnectionState::Closing))
             {
-                return 0;
+                // This termination was expected.
+                return false;
             }
 
-            if (!_receivedFirstByte)
-            {
-                const auto now = std::chrono::high_resolution_clock::now();
-                const std::chrono::duration<double> delta = now - _startTime;
+            // EXIT POINT
+            _indicateExitWithStatus(result); // print a message
+            _transitionToState(ConnectionState::Failed);
+            return false;
+        }
+
+        if (_u16Str.empty())
+        {
+            return false;
+        }
+
+        if (!_receivedFirstByte)
+        {
+            const auto now = std::chrono::high_resolution_clock::now();
+            const std::chrono::duration<double> delta = now - _startTime;
 
 #pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
-                TraceLoggingWrite(g_hTerminalConnectionProvider,
-                                  "ReceivedFirstByte",
-                                  TraceLoggingDescription("An event emitted when the connection receives the first byte"),
-                                  TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
-                                  TraceLoggingFloat64(delta.count(), "Duration"),
-                                  TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
-                                  TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
-                _receivedFirstByte = true;
-            }
+            TraceLoggingWrite(g_hTerminalConnectionProvider,
+                              "ReceivedFirstByte",
+                              TraceLoggingDescription("An event emitted when the connection receives the first byte"),
+                              TraceLoggingGuid(_guid, "SessionGuid", "The WT_SESSION's GUID"),
+                              TraceLoggingFloat64(delta.count(), "Duration"),
+                              TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
+                              TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+            _receivedFirstByte = true;
+        }
 
-            // Pass the output to our registered event handlers
+        // Pass the output to our registered event handlers.
+        // The handlers receive a reference to _u16Str (a fast-pass string), not a copy of it.
+        try
+        {
             _TerminalOutputHandlers(_u16Str);
         }
-
-        return 0;
+        CATCH_LOG();
+        return true;
     }
 
     static winrt::event<NewConnectionHandler> _newConnectionHandlers;
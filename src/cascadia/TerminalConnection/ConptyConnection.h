@@ -68,6 +68,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         hstring _startingTitle{};
         Windows::Foundation::Collections::ValueSet _environment{ nullptr };
         guid _guid{}; // A unique session identifier for connected client
+        bool _passthroughMode{ false };
         hstring _clientName{}; // The name of the process hosted by this ConPTY connection (as of launch).
 
         bool _receivedFirstByte{ false };
@@ -75,16 +76,30 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         wil::unique_hfile _inPipe; // The pipe for writing input to
         wil::unique_hfile _outPipe; // The pipe for reading output from
-        wil::unique_handle _hOutputThread;
+        wil::unique_handle _hOutputThread; // Only used for inbound handoffs, see Start().
+        wil::unique_threadpool_io _outputIo;
+        OVERLAPPED _outputOverlapped{};
+        winrt::com_ptr<ConptyConnection> _outputStrongThis; // Held while an overlapped read is pending.
+        wil::unique_event _outputDrained; // Set once the output reader stopped.
+        bool _overlappedOutput{ false };
         wil::unique_process_information _piClient;
         wil::unique_static_pseudoconsole_handle _hPC;
         wil::unique_threadpool_wait _clientExitWait;
 
         til::u8state _u8State{};
         std::wstring _u16Str{};
-        std::array<char, 4096> _buffer{};
-
+        // Every chunk we read is converted and handed to the TerminalOutput handlers,
+        // which in turn take the terminal's write lock and kick off a pattern update.
+        // ReadFile returns with whatever is available, so a larger buffer only
+        // amortizes that per-chunk cost when the client is producing a lot of output.
+        static constexpr size_t _outputBufferSize{ 128 * 1024 };
+        std::array<char, _outputBufferSize> _buffer{};
+
+        void _WaitForOutputDrained() noexcept;
+        void _StartOutputRead() noexcept;
+        void _OutputReadCompleted(const DWORD error, const DWORD read) noexcept;
         DWORD _OutputThread();
+        bool _HandleOutput(const DWORD error, const DWORD read) noexcept;
     };
 }
 
@@ -33,6 +33,16 @@ constexpr const auto TsfRedrawInterval = std::chrono::milliseconds(100);
 // The minimum delay between updating the locations of regex patterns
 constexpr const auto UpdatePatternLocationsInterval = std::chrono::milliseconds(500);
 
+// The minimum delay between resizing the connection during a window drag.
+constexpr const auto ResizeConnectionInterval = std::chrono::milliseconds(50);
+
+// The minimum delay between updates of the title, tab color and taskbar
+// progress, which shells and build tools may change on every command.
+constexpr const auto TabStateUpdateInterval = std::chrono::milliseconds(50);
+
+// The longest SuspendRendering will wait for a frame that's being painted.
+constexpr const DWORD RenderingSuspendTimeoutMs = 100;
+
 namespace winrt::Microsoft::Terminal::Control::implementation
 {
     // Helper static function to ensure that all ambiguous-width glyphs are reported as narrow.
@@ -42,6 +52,33 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return false; // glyph is not wide.
     }
 
+    // Helper static function to compare the font features or axes of two
+    // settings objects. Either map may be null, which is the same as empty.
+    template<typename T>
+    static bool _FontMapsEqual(const winrt::Windows::Foundation::Collections::IMap<winrt::hstring, T>& lhs,
+                               const winrt::Windows::Foundation::Collections::IMap<winrt::hstring, T>& rhs)
+    {
+        const auto lhsSize = lhs ? lhs.Size() : 0u;
+        const auto rhsSize = rhs ? rhs.Size() : 0u;
+        if (lhsSize != rhsSize)
+        {
+            return false;
+        }
+        if (lhsSize == 0)
+        {
+            return true;
+        }
+
+        for (const auto& [key, value] : lhs)
+        {
+            if (!rhs.HasKey(key) || rhs.Lookup(key) != value)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     static bool _EnsureStaticInitialization()
     {
         // use C++11 magic statics to make sure we only do this once.
@@ -70,10 +107,18 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _ConnectionStateChangedHandlers(*this, nullptr);
         });
 
+        // Output from the connection is handed off to a dedicated parser thread
+        // through a lock-free ring, so that the connection's output thread
+        // never has to wait for the terminal lock (which the render thread
+        // holds while painting). The parser thread drains everything that has
+        // accumulated in the meantime under a single lock acquisition.
+        auto [outputProducer, outputConsumer] = til::spsc::channel<winrt::hstring>(OutputChannelCapacity);
+        _outputProducer.emplace(std::move(outputProducer));
+
         // This event is explicitly revoked in the destructor: does not need weak_ref
         _connectionOutputEventToken = _connection.TerminalOutput({ this, &ControlCore::_connectionOutputHandler });
 
-        _terminal->SetWriteInputCallback([this](std::wstring& wstr) {
+        _terminal->SetWriteInputCallback([this](const std::wstring_view wstr) {
             _sendInputToConnection(wstr);
         });
 
@@ -129,6 +174,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         //   need to hop across the process boundary every time text is output.
         //   We can throttle this to once every 8ms, which will get us out of
         //   the way of the main output & rendering threads.
+        // * _resizeConnection: Dragging the window resizes the terminal many
+        //   times a second. Every resize makes conpty reflow and repaint its
+        //   whole buffer, which we'd then have to parse. Only the latest size
+        //   is sent, at most every 50ms.
+        // * _updateTitle, _updateTabColor, _updateTaskbarProgress: Prompts
+        //   that set the title on every command, or build tools that set it
+        //   (and the progress) on every step, would otherwise flood the UI
+        //   thread with tab updates. Only the latest state matters.
         _tsfTryRedrawCanvas = std::make_shared<ThrottledFuncTrailing<>>(
             _dispatcher,
             TsfRedrawInterval,
@@ -159,19 +212,91 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 }
             });
 
+        _resizeConnection = std::make_shared<ThrottledFuncTrailing<uint32_t, uint32_t>>(
+            _dispatcher,
+            ResizeConnectionInterval,
+            [weakThis = get_weak()](const uint32_t rows, const uint32_t columns) {
+                if (auto core{ weakThis.get() }; !core->_IsClosing())
+                {
+                    core->_connection.Resize(rows, columns);
+                }
+            });
+
+        _updateTitle = std::make_shared<ThrottledFuncTrailing<winrt::hstring>>(
+            _dispatcher,
+            TabStateUpdateInterval,
+            [weakThis = get_weak()](const winrt::hstring& title) {
+                if (auto core{ weakThis.get() }; !core->_IsClosing())
+                {
+                    core->_TitleChangedHandlers(*core, winrt::make<TitleChangedEventArgs>(title));
+                }
+            });
+
+        _updateTabColor = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            TabStateUpdateInterval,
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; !core->_IsClosing())
+                {
+                    core->_TabColorChangedHandlers(*core, nullptr);
+                }
+            });
+
+        _updateTaskbarProgress = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            TabStateUpdateInterval,
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; !core->_IsClosing())
+                {
+                    core->_TaskbarProgressChangedHandlers(*core, nullptr);
+                }
+            });
+
         UpdateSettings(settings);
+
+        // Start parsing only once we're fully set up. Anything the
+        // connection has output before this point is waiting in the channel.
+        _outputThread = std::thread([this, consumer = std::move(outputConsumer)]() {
+            _outputThreadMain(consumer);
+        });
     }
 
     ControlCore::~ControlCore()
     {
         Close();
 
+        // Dropping the producer makes the parser thread's pop_n() return once
+        // it has written out whatever was still queued up.
+        _outputProducer.reset();
+        if (_outputThread.joinable())
+        {
+            _outputThread.join();
+        }
+
         if (_renderer)
         {
             _renderer->TriggerTeardown();
         }
     }
 
+    // Function Description:
+    // - Destroys the ControlCore on a background thread. This is where we
+    //   wait for the output thread to finish and for the renderer to tear
+    //   down, and where the DxEngine releases its device resources, all of
+    //   which can take a while. Closing a tab with many panes would otherwise
+    //   do all of that on the UI thread, one pane after the other. This way
+    //   the tab is gone right away, and every pane's core is destroyed on a
+    //   thread of its own, at the same time.
+    // Arguments:
+    // - core: the ControlCore that's being released
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget ControlCore::final_release(std::unique_ptr<ControlCore> core)
+    {
+        co_await winrt::resume_background(); // move to background
+        core.reset(); // explicitly destruct
+    }
+
     bool ControlCore::Initialize(const double actualWidth,
                                  const double actualHeight,
                                  const double compositionScale)
@@ -215,7 +340,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 }
             });
 
+            // The render thread is stopped before we're destroyed, and this is
+            // called for every frame, so it doesn't bother resolving a weak ref.
+            _renderer->SetFramePresentedCallback([this](const std::chrono::steady_clock::time_point frameCaptured) {
+                _finishInputLatencyMeasurement(frameCaptured);
+            });
+
             THROW_IF_FAILED(localPointerToThread->Initialize(_renderer.get()));
+            _renderThread = localPointerToThread;
 
             // Set up the DX Engine
             auto dxEngine = std::make_unique<::Microsoft::Console::Render::DxEngine>();
@@ -278,13 +410,78 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _initializedTerminal = true;
         } // scope for TerminalLock
 
+        // Only the first control in the process is part of starting up.
+        static std::atomic<bool> s_reportedStartupMilestone{ false };
+        if (!s_reportedStartupMilestone.exchange(true))
+        {
+            TraceLoggingWrite(
+                g_hTerminalControlProvider,
+                "StartupMilestone",
+                TraceLoggingDescription("Event emitted when a step of starting up is complete"),
+                TraceLoggingWideString(L"ControlCoreInitialized", "Milestone"),
+                TraceLoggingFloat64(::Microsoft::Console::Utils::MillisecondsSinceProcessStart(), "MillisecondsSinceProcessStart"),
+                TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+        }
+
         // Start the connection outside of lock, because it could
         // start writing output immediately.
-        _connection.Start();
+        _asyncStartConnection();
 
         return true;
     }
 
+    // Method Description:
+    // - Starts the connection on a background thread. For a conpty
+    //   connection that means creating the pseudoconsole and the client
+    //   process, which would otherwise block the UI thread for every pane we
+    //   create (and for a whole layout's worth of them on startup).
+    // - If we're resized while the connection is starting, it might drop that
+    //   resize, so once it's up we make sure it has our current size.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget ControlCore::_asyncStartConnection()
+    {
+        auto weakThis{ get_weak() };
+        auto connection{ _connection };
+        auto lifetimeLock{ _connectionLifetimeLock };
+        auto dispatcher{ _dispatcher };
+        const auto initialViewport = [&]() {
+            auto lock = _terminal->LockForReading();
+            return _terminal->GetViewport();
+        }();
+
+        co_await winrt::resume_background(); // ** DO NOT INTERACT WITH THE CONTROL CORE AFTER THIS LINE **
+
+        {
+            // _asyncCloseConnection takes this lock too, so a connection is
+            // never closed while it's still starting. If it was closed before
+            // we got here, don't start it at all.
+            const std::scoped_lock lock{ *lifetimeLock };
+            if (connection.State() != TerminalConnection::ConnectionState::NotConnected)
+            {
+                co_return;
+            }
+            connection.Start();
+        }
+
+        co_await winrt::resume_foreground(dispatcher);
+
+        if (auto core{ weakThis.get() }; core && !core->_IsClosing())
+        {
+            const auto viewport = [&]() {
+                auto lock = core->_terminal->LockForReading();
+                return core->_terminal->GetViewport();
+            }();
+            if (viewport.Dimensions() != initialViewport.Dimensions())
+            {
+                connection.Resize(viewport.Height(), viewport.Width());
+            }
+        }
+    }
+
     // Method Description:
     // - Tell the renderer to start painting.
     // - !! IMPORTANT !! Make sure that we've attached our swap chain to an
@@ -295,12 +492,93 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - <none>
     void ControlCore::EnablePainting()
     {
-        if (_initializedTerminal)
+        if (_initializedTerminal && !_renderingSuspended)
         {
             _renderer->EnablePainting();
         }
     }
 
+    // Method Description:
+    // - Pauses the render thread while the control isn't visible (a background
+    //   tab or a minimized window). Output keeps flowing into the buffer, and
+    //   the invalidated regions pile up until ResumeRendering.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::SuspendRendering()
+    {
+        if (!_initializedTerminal || _renderingSuspended)
+        {
+            return;
+        }
+
+        _renderingSuspended = true;
+        // Don't hold up the UI thread for long if a frame is in progress.
+        // Painting stays disabled after it completes either way.
+        _renderer->WaitForPaintCompletionAndDisable(RenderingSuspendTimeoutMs);
+    }
+
+    // Method Description:
+    // - Releases the render engine's device resources (swap chain, render
+    //   targets, brushes) while rendering is suspended. The engine also drops
+    //   its glyph caches and trims the D3D device, and the renderer frees its
+    //   scratch buffers. Everything is recreated on the first frame after
+    //   ResumeRendering.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::ReleaseRenderingResources()
+    {
+        if (!_renderingSuspended || _renderingResourcesReleased || !_renderEngine)
+        {
+            return;
+        }
+
+        {
+            // The render thread may still be finishing its last frame. It only
+            // touches the engine while holding the lock.
+            auto lock = _terminal->LockForWriting();
+            LOG_IF_FAILED(_renderEngine->Disable());
+            _renderer->ReleaseScratchBuffers();
+            _renderingResourcesReleased = true;
+        }
+
+        // Give the pages that were just freed back to the OS. This is only
+        // worth anything on hosts shared by many idle windows, and it's
+        // cheap enough to do whenever a control goes idle. It returns the
+        // size of the largest free block, which we don't care about.
+        HeapCompact(GetProcessHeap(), 0);
+    }
+
+    // Method Description:
+    // - Undoes SuspendRendering (and ReleaseRenderingResources) and repaints
+    //   the whole viewport, since we have no idea what changed in the meantime.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::ResumeRendering()
+    {
+        if (!_renderingSuspended)
+        {
+            return;
+        }
+
+        _renderingSuspended = false;
+        {
+            auto lock = _terminal->LockForWriting();
+            if (_renderingResourcesReleased)
+            {
+                LOG_IF_FAILED(_renderEngine->Enable());
+                _renderingResourcesReleased = false;
+            }
+            _renderer->TriggerRedrawAll();
+        }
+        _renderer->EnablePainting();
+    }
+
     // Method Description:
     // - Writes the given sequence as input to the active terminal connection.
     // - This method has been overloaded to allow zero-copy winrt::param::hstring optimizations.
@@ -317,6 +595,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         else
         {
             _connection.WriteInput(wstr);
+            _advanceInputLatencyMeasurement(_inputLatency.keyPressed, _inputLatency.inputWritten);
         }
     }
 
@@ -335,6 +614,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                     const WORD scanCode,
                                     const ::Microsoft::Terminal::Core::ControlKeyStates modifiers)
     {
+        _startInputLatencyMeasurement();
         return _terminal->SendCharEvent(ch, scanCode, modifiers);
     }
 
@@ -381,6 +661,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             }
         }
 
+        if (keyDown && !KeyEvent::IsModifierKey(vkey))
+        {
+            _startInputLatencyMeasurement();
+        }
+
         // If the terminal translated the key, mark the event as handled.
         // This will prevent the system from trying to get the character out
         // of it and sending us a CharacterReceived event.
@@ -477,6 +762,57 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    // Method Description:
+    // - Shows or hides the renderer's statistics for the last frame, in the
+    //   top right corner of the control.
+    void ControlCore::ToggleRenderStatistics()
+    {
+        auto lock = _terminal->LockForWriting();
+        if (_renderer)
+        {
+            _renderer->SetDebugOverlayEnabled(!_renderer->IsDebugOverlayEnabled());
+        }
+    }
+
+    // Method Description:
+    // - Adds up the memory held by this control's buffers and its render
+    //   engine, and writes the breakdown as a "MemoryUsage" event.
+    // - The connection's buffers aren't included, since ITerminalConnection
+    //   doesn't expose them.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - The total memory in use, in bytes.
+    uint64_t ControlCore::ReportMemoryUsage()
+    {
+        // The renderer paints under the write lock. Holding it keeps the
+        // engine's caches from changing while they're being measured.
+        auto lock = _terminal->LockForWriting();
+
+        const auto buffer = _terminal->GetMemoryUsage();
+        const auto engine = _renderEngine ? _renderEngine->GetMemoryUsage() : ::Microsoft::Console::Render::DxEngine::MemoryUsage{};
+        const uint64_t total = buffer.cells + buffer.rows + buffer.attributes + buffer.unicodeStorage + buffer.hyperlinks + buffer.patterns +
+                               engine.swapChain + engine.intermediateTargets + engine.glyphCaches;
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "MemoryUsage",
+                          TraceLoggingDescription("The memory held by a control, in bytes, by what it's held for"),
+                          TraceLoggingUInt64(buffer.cells, "Cells", "The cells of the text buffer's rows"),
+                          TraceLoggingUInt64(buffer.rows, "Rows"),
+                          TraceLoggingUInt64(buffer.attributes, "Attributes", "The attribute runs of rows with more than one"),
+                          TraceLoggingUInt64(buffer.unicodeStorage, "UnicodeStorage"),
+                          TraceLoggingUInt64(buffer.hyperlinks, "Hyperlinks"),
+                          TraceLoggingUInt64(buffer.patterns, "Patterns"),
+                          TraceLoggingUInt64(engine.swapChain, "SwapChain"),
+                          TraceLoggingUInt64(engine.intermediateTargets, "IntermediateTargets"),
+                          TraceLoggingUInt64(engine.glyphCaches, "GlyphCaches"),
+                          TraceLoggingUInt64(total, "Total"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+
+        return total;
+    }
+
     // Method Description:
     // - Tell TerminalCore to update its knowledge about the locations of visible regex patterns
     // - We should call this (through the throttled function) when something causes the visible
@@ -533,11 +869,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             {
                 auto lock = _terminal->LockForWriting();
 
+                // Only the link we moved off of and the one we moved onto look any different.
+                _terminal->InvalidateHyperlink(_lastHoveredId, _lastHoveredInterval);
+                _terminal->InvalidateHyperlink(newId, newInterval);
+
                 _lastHoveredId = newId;
                 _lastHoveredInterval = newInterval;
                 _renderEngine->UpdateHyperlinkHoveredId(newId);
                 _renderer->UpdateLastHoveredInterval(newInterval);
-                _renderer->TriggerRedrawAll();
             }
 
             _HoveredHyperlinkChangedHandlers(*this, nullptr);
@@ -573,6 +912,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         auto lock = _terminal->LockForWriting();
 
+        const auto oldSettings = _settings;
         _settings = settings;
 
         // Initialize our font information.
@@ -585,8 +925,22 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         //      The family is only used to determine if the font is truetype or
         //      not, but DX doesn't use that info at all.
         //      The Codepage is additionally not actually used by the DX engine at all.
-        _actualFont = { fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8, false };
-        _desiredFont = { _actualFont };
+        const FontInfo newFont{ fontFace, 0, fontWeight.Weight, { 0, fontHeight }, CP_UTF8, false };
+        const FontInfoDesired newDesiredFont{ newFont };
+
+        // Most settings reloads don't touch the font at all. Looking the font
+        // up again is the most expensive part of applying new settings, so
+        // only do it if something about the font actually changed.
+        const auto fontChanged = !_initializedTerminal ||
+                                 !oldSettings ||
+                                 !(newDesiredFont == _desiredFont) ||
+                                 !_FontMapsEqual(oldSettings.FontFeatures(), _settings.FontFeatures()) ||
+                                 !_FontMapsEqual(oldSettings.FontAxes(), _settings.FontAxes());
+        if (fontChanged)
+        {
+            _actualFont = newFont;
+            _desiredFont = newDesiredFont;
+        }
 
         // Update the terminal core with its new Core settings
         _terminal->UpdateSettings(_settings);
@@ -602,6 +956,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _renderEngine->SetSoftwareRendering(_settings.SoftwareRendering());
         _updateAntiAliasingMode(_renderEngine.get());
 
+        if (!fontChanged)
+        {
+            return;
+        }
+
         // Refresh our font with the renderer
         const auto actualFontOldSize = _actualFont.GetSize();
         _updateFont();
@@ -829,7 +1188,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const HRESULT hr = _terminal->UserResize({ vp.Width(), vp.Height() });
         if (SUCCEEDED(hr) && hr != S_FALSE)
         {
-            _connection.Resize(vp.Height(), vp.Width());
+            _resizeConnection->Run(vp.Height(), vp.Width());
         }
     }
 
@@ -867,8 +1226,6 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         const auto dpi = (float)(scale * USER_DEFAULT_SCREEN_DPI);
 
-        const auto actualFontOldSize = _actualFont.GetSize();
-
         auto lock = _terminal->LockForWriting();
         _compositionScale = scale;
 
@@ -876,11 +1233,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                      _desiredFont,
                                      _actualFont);
 
-        const auto actualFontNewSize = _actualFont.GetSize();
-        if (actualFontNewSize != actualFontOldSize)
+        // The swap chain's size in pixels changes with the scale, even when
+        // the grid of cells doesn't. The engine resizes its buffers in place
+        // on the next frame and keeps its device. The buffer is only resized
+        // (and reflowed) below if the grid actually changed.
+        const SIZE size{ static_cast<long>(_panelWidth * scale), static_cast<long>(_panelHeight * scale) };
+        if (size.cx > 0 && size.cy > 0)
         {
-            _refreshSizeUnderLock();
+            LOG_IF_FAILED(_renderEngine->SetWindowSize(size));
         }
+
+        _refreshSizeUnderLock();
     }
 
     void ControlCore::SetSelectionAnchor(til::point const& position)
@@ -913,8 +1276,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         };
 
         // save location (for rendering) + render
+        const til::point oldStart{ _terminal->GetSelectionAnchor() };
+        const til::point oldEnd{ _terminal->GetSelectionEnd() };
         _terminal->SetSelectionEnd(terminalPosition);
-        _renderer->TriggerSelection();
+
+        // Dragging within a cell, or a word in word selection mode, doesn't
+        // move the selection. There's nothing to redraw then.
+        if (til::point{ _terminal->GetSelectionAnchor() } != oldStart || til::point{ _terminal->GetSelectionEnd() } != oldEnd)
+        {
+            _renderer->TriggerSelection();
+        }
     }
 
     // Called when the Terminal wants to set something to the clipboard, i.e.
@@ -943,47 +1314,92 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         // extract text from buffer
         // RetrieveSelectedTextFromBuffer will lock while it's reading
-        const auto bufferData = _terminal->RetrieveSelectedTextFromBuffer(singleLine);
+        auto bufferData = _terminal->RetrieveSelectedTextFromBuffer(singleLine);
+
+        if (!_settings.CopyOnSelect())
+        {
+            _terminal->ClearSelection();
+            _renderer->TriggerSelection();
+        }
+
+        // Joining a large selection into one string takes a while, and it
+        // doesn't need the buffer anymore. Do it in the background.
+        _copyToClipboardAsync(std::move(bufferData),
+                              _actualFont.GetUnscaledSize().Y,
+                              std::wstring{ _actualFont.GetFaceName() },
+                              til::color{ _settings.DefaultBackground() },
+                              formats);
+        return true;
+    }
+
+    // Method Description:
+    // - Converts the copied buffer contents into text on a background thread,
+    //   then raises CopyToClipboard with it.
+    // - HTML and RTF aren't generated here. The event args generate them from
+    //   the buffer contents only if the clipboard ever asks for them.
+    // Arguments:
+    // - bufferData: the text and colors of the selection
+    // - fontHeightPoints, fontFaceName, backgroundColor: used to format the HTML and RTF
+    // - formats: the formats to offer. nullptr means all and lets the
+    //   handler decide which ones to use.
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget ControlCore::_copyToClipboardAsync(TextBuffer::TextAndColor bufferData,
+                                                              const int fontHeightPoints,
+                                                              const std::wstring fontFaceName,
+                                                              const COLORREF backgroundColor,
+                                                              const Windows::Foundation::IReference<CopyFormat> formats)
+    {
+        auto weakThis{ get_weak() };
+        co_await winrt::resume_background();
 
         // convert text: vector<string> --> string
+        size_t textSize = 0;
+        for (const auto& text : bufferData.text)
+        {
+            textSize += text.size();
+        }
         std::wstring textData;
+        textData.reserve(textSize);
         for (const auto& text : bufferData.text)
         {
             textData += text;
         }
 
+        // Both generators share the buffer contents, which live as long as
+        // the clipboard might still ask for either format.
+        const auto sharedData = std::make_shared<const TextBuffer::TextAndColor>(std::move(bufferData));
+
         // convert text to HTML format
         // GH#5347 - Don't provide a title for the generated HTML, as many
         // web applications will paste the title first, followed by the HTML
         // content, which is unexpected.
-        const auto htmlData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML) ?
-                                  TextBuffer::GenHTML(bufferData,
-                                                      _actualFont.GetUnscaledSize().Y,
-                                                      _actualFont.GetFaceName(),
-                                                      til::color{ _settings.DefaultBackground() }) :
-                                  "";
+        std::function<winrt::hstring()> htmlGenerator;
+        if (formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::HTML))
+        {
+            htmlGenerator = [=]() {
+                return winrt::to_hstring(TextBuffer::GenHTML(*sharedData, fontHeightPoints, fontFaceName, backgroundColor));
+            };
+        }
 
         // convert to RTF format
-        const auto rtfData = formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF) ?
-                                 TextBuffer::GenRTF(bufferData,
-                                                    _actualFont.GetUnscaledSize().Y,
-                                                    _actualFont.GetFaceName(),
-                                                    til::color{ _settings.DefaultBackground() }) :
-                                 "";
-
-        if (!_settings.CopyOnSelect())
+        std::function<winrt::hstring()> rtfGenerator;
+        if (formats == nullptr || WI_IsFlagSet(formats.Value(), CopyFormat::RTF))
         {
-            _terminal->ClearSelection();
-            _renderer->TriggerSelection();
+            rtfGenerator = [=]() {
+                return winrt::to_hstring(TextBuffer::GenRTF(*sharedData, fontHeightPoints, fontFaceName, backgroundColor));
+            };
         }
 
-        // send data up for clipboard
-        _CopyToClipboardHandlers(*this,
-                                 winrt::make<CopyToClipboardEventArgs>(winrt::hstring{ textData },
-                                                                       winrt::to_hstring(htmlData),
-                                                                       winrt::to_hstring(rtfData),
-                                                                       formats));
-        return true;
+        if (auto core{ weakThis.get() })
+        {
+            // send data up for clipboard
+            core->_CopyToClipboardHandlers(*core,
+                                           winrt::make<CopyToClipboardEventArgs>(winrt::hstring{ textData },
+                                                                                 std::move(htmlGenerator),
+                                                                                 std::move(rtfGenerator),
+                                                                                 formats));
+        }
     }
 
     // Method Description:
@@ -1122,7 +1538,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // Since this can only ever be triggered by output from the connection,
         // then the Terminal already has the write lock when calling this
         // callback.
-        _TitleChangedHandlers(*this, winrt::make<TitleChangedEventArgs>(winrt::hstring{ wstr }));
+        if (!_inUnitTests)
+        {
+            _updateTitle->Run(winrt::hstring{ wstr });
+        }
+        else
+        {
+            _TitleChangedHandlers(*this, winrt::make<TitleChangedEventArgs>(winrt::hstring{ wstr }));
+        }
     }
 
     // Method Description:
@@ -1137,7 +1560,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     void ControlCore::_terminalTabColorChanged(const std::optional<til::color> /*color*/)
     {
         // Raise a TabColorChanged event
-        _TabColorChangedHandlers(*this, nullptr);
+        if (!_inUnitTests)
+        {
+            _updateTabColor->Run();
+        }
+        else
+        {
+            _TabColorChangedHandlers(*this, nullptr);
+        }
     }
 
     // Method Description:
@@ -1189,7 +1619,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
 
         // Additionally, start the throttled update of where our links are.
-        _updatePatternLocations->Run();
+        // During an output burst, the parser thread does that once it's over.
+        if (!_inOutputBurst.load(std::memory_order_relaxed))
+        {
+            _updatePatternLocations->Run();
+        }
     }
 
     void ControlCore::_terminalCursorPositionChanged()
@@ -1201,7 +1635,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     void ControlCore::_terminalTaskbarProgressChanged()
     {
-        _TaskbarProgressChangedHandlers(*this, nullptr);
+        if (!_inUnitTests)
+        {
+            _updateTaskbarProgress->Run();
+        }
+        else
+        {
+            _TaskbarProgressChangedHandlers(*this, nullptr);
+        }
     }
 
     bool ControlCore::HasSelection() const
@@ -1240,11 +1681,13 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - text: the text to search
     // - goForward: boolean that represents if the current search direction is forward
     // - caseSensitive: boolean that represents if the current search is case sensitive
+    // - regularExpression: boolean that represents if the text is a regular expression
     // Return Value:
     // - <none>
     void ControlCore::Search(const winrt::hstring& text,
                              const bool goForward,
-                             const bool caseSensitive)
+                             const bool caseSensitive,
+                             const bool regularExpression)
     {
         if (text.size() == 0)
         {
@@ -1259,13 +1702,190 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                                     Search::Sensitivity::CaseSensitive :
                                                     Search::Sensitivity::CaseInsensitive;
 
-        ::Search search(*GetUiaData(), text.c_str(), direction, sensitivity);
+        const Search::Syntax syntax = regularExpression ?
+                                          Search::Syntax::RegularExpression :
+                                          Search::Syntax::Literal;
+
+        try
+        {
+            ::Search search(*GetUiaData(), text.c_str(), direction, sensitivity, syntax);
+            auto lock = _terminal->LockForWriting();
+            if (search.FindNext())
+            {
+                _terminal->SetBlockSelection(false);
+                search.Select();
+                _renderer->TriggerSelection();
+            }
+        }
+        catch (...)
+        {
+            // The text isn't a valid regular expression (or not yet, while
+            // it's being typed), so there's nothing to find.
+            ClearSearchHighlights();
+            return;
+        }
+
+        // Pressing enter again moves on to the next match. Only look for
+        // all of them again when the search itself changed.
+        const auto thisSearch = std::make_tuple(text, caseSensitive, regularExpression);
+        if (_highlightedSearch != thisSearch)
+        {
+            _highlightedSearch = thisSearch;
+            _highlightAllMatchesAsync(text, caseSensitive, regularExpression);
+        }
+    }
+
+    // Method Description:
+    // - Removes the highlighting of all the matches of the last search, and
+    //   stops looking for more of them if we're still searching.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::ClearSearchHighlights()
+    {
+        ++_searchGeneration;
+        _highlightedSearch = std::nullopt;
+
         auto lock = _terminal->LockForWriting();
-        if (search.FindNext())
+        _terminal->ClearSearchHighlights();
+    }
+
+    // Method Description:
+    // - Finds all the matches of the given search on a background thread and
+    //   highlights them in the buffer as they're found.
+    // - The buffer is searched a batch of rows at a time, and the terminal
+    //   lock is released in between batches, so neither the UI nor the
+    //   connection's output is blocked for long on big buffers.
+    // Arguments:
+    // - text: the text to search
+    // - caseSensitive: boolean that represents if the current search is case sensitive
+    // - regularExpression: boolean that represents if the text is a regular expression
+    // Return Value:
+    // - <none>
+    winrt::fire_and_forget ControlCore::_highlightAllMatchesAsync(const winrt::hstring text, const bool caseSensitive, const bool regularExpression)
+    {
+        // This many rows are searched while holding the lock at once.
+        static constexpr int rowsPerBatch = 1000;
+
+        const auto generation = ++_searchGeneration;
         {
-            _terminal->SetBlockSelection(false);
-            search.Select();
-            _renderer->TriggerSelection();
+            auto lock = _terminal->LockForWriting();
+            _terminal->ClearSearchHighlights();
+        }
+
+        auto weakThis{ get_weak() };
+        co_await winrt::resume_background();
+
+        const Search::Sensitivity sensitivity = caseSensitive ?
+                                                    Search::Sensitivity::CaseSensitive :
+                                                    Search::Sensitivity::CaseInsensitive;
+
+        const Search::Syntax syntax = regularExpression ?
+                                          Search::Syntax::RegularExpression :
+                                          Search::Syntax::Literal;
+
+        int firstRow = 0;
+        while (auto core{ weakThis.get() })
+        {
+            std::vector<std::pair<COORD, COORD>> matches;
+            {
+                // _IsClosing may only be checked on the UI thread, so we rely
+                // on ClearSearchHighlights (or a newer search) bumping the
+                // generation to stop us.
+                auto lock = core->_terminal->LockForReading();
+                if (core->_searchGeneration != generation)
+                {
+                    co_return;
+                }
+
+                const int lastRow = core->_terminal->GetTextBufferEndPosition().Y;
+                if (firstRow > lastRow)
+                {
+                    co_return;
+                }
+
+                // An explicit anchor keeps Search from looking at the selection.
+                // Search already compiled the same regex, so it's valid.
+                ::Search search(*core->GetUiaData(), text.c_str(), Search::Direction::Forward, sensitivity, COORD{ 0, 0 }, syntax);
+                matches = search.FindAll(gsl::narrow_cast<SHORT>(firstRow),
+                                         gsl::narrow_cast<SHORT>(std::min(firstRow + rowsPerBatch - 1, lastRow)));
+                firstRow += rowsPerBatch;
+            }
+
+            if (!matches.empty())
+            {
+                auto lock = core->_terminal->LockForWriting();
+                if (core->_searchGeneration != generation)
+                {
+                    co_return;
+                }
+                core->_terminal->AddSearchHighlights(matches);
+            }
+        }
+    }
+
+    // Method Description:
+    // - Saves the text of the whole buffer, the scrollback included, to a file.
+    // - The rows are read a batch at a time on a background thread, with the
+    //   terminal lock released in between batches, and every batch is written
+    //   out before the next one is read. Neither the UI nor the connection's
+    //   output wait for the whole buffer, and only one batch of it is ever
+    //   held in memory.
+    // Arguments:
+    // - path: the file to write to. It's replaced if it exists.
+    // - includeAttributes: if true, the colors and renditions of the text are
+    //   saved as SGR sequences.
+    // Return Value:
+    // - <none>
+    Windows::Foundation::IAsyncAction ControlCore::ExportBuffer(const winrt::hstring path, const bool includeAttributes)
+    {
+        // This many rows are read while holding the lock at once.
+        static constexpr size_t rowsPerBatch = 1000;
+
+        auto weakThis{ get_weak() };
+        co_await winrt::resume_background();
+
+        wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+
+        std::wstring text;
+        std::string utf8;
+        size_t nextRow = 0;
+        std::optional<uint64_t> circledRowCount;
+        while (auto core{ weakThis.get() })
+        {
+            text.clear();
+            {
+                auto lock = core->_terminal->LockForReading();
+                const auto& buffer = core->_terminal->GetTextBuffer();
+
+                // New output may have scrolled the buffer since the last batch,
+                // and the rows we haven't gotten to yet moved up with it. Those
+                // that scrolled out of the top of the buffer in the meantime
+                // are lost.
+                const auto circled = buffer.GetCircledRowCount();
+                if (circledRowCount)
+                {
+                    const auto moved = circled - *circledRowCount;
+                    nextRow = gsl::narrow_cast<size_t>(nextRow > moved ? nextRow - moved : 0);
+                }
+                circledRowCount = circled;
+
+                const auto lastRow = gsl::narrow_cast<size_t>(core->_terminal->GetTextBufferEndPosition().Y);
+                if (nextRow > lastRow)
+                {
+                    break;
+                }
+
+                const auto batchEnd = std::min(nextRow + rowsPerBatch - 1, lastRow);
+                buffer.SerializeRows(nextRow, batchEnd, includeAttributes, text);
+                nextRow = batchEnd + 1;
+            }
+
+            THROW_IF_FAILED(til::u16u8(text, utf8));
+            DWORD written = 0;
+            THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), utf8.data(), gsl::narrow<DWORD>(utf8.size()), &written, nullptr));
         }
     }
 
@@ -1291,6 +1911,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         if (auto localConnection{ std::exchange(_connection, nullptr) })
         {
+            auto lifetimeLock{ _connectionLifetimeLock };
+
             // Close the connection on the background thread.
             co_await winrt::resume_background(); // ** DO NOT INTERACT WITH THE CONTROL CORE AFTER THIS LINE **
 
@@ -1299,6 +1921,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             // possible that the background thread is resuming after we've been
             // cleaned up.
 
+            // Wait for _asyncStartConnection, if it's still starting it.
+            const std::scoped_lock lock{ *lifetimeLock };
             localConnection.Close();
             // connection is destroyed.
         }
@@ -1310,6 +1934,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         {
             _closing = true;
 
+            // Stop any search that's still running in the background.
+            ++_searchGeneration;
+
+            _traceWriteLockStatistics();
+            _traceInputLatencyStatistics();
+
             // Stop accepting new output and state changes before we disconnect everything.
             _connection.TerminalOutput(_connectionOutputEventToken);
             _connectionStateChangedRevoker.revoke();
@@ -1323,6 +1953,197 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    // Method Description:
+    // - Logs how long the terminal's Write() had to wait for, and held on
+    //   to, the terminal lock over the lifetime of this control. These are
+    //   only collected when someone's listening, for diagnosing cases where
+    //   heavy output starves the renderer.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_traceWriteLockStatistics()
+    {
+        if (!TraceLoggingProviderEnabled(g_hTerminalControlProvider, WINEVENT_LEVEL_VERBOSE, 0))
+        {
+            return;
+        }
+
+        const auto stats = [&]() {
+            auto lock = _terminal->LockForReading();
+            return _terminal->GetWriteLockStatistics();
+        }();
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "WriteLockStatistics",
+                          TraceLoggingDescription("Histograms of the time Terminal::Write waited for and held the terminal lock, in buckets of 64us << i"),
+                          TraceLoggingUInt32Array(stats.waitHistogram.data(), gsl::narrow_cast<UINT16>(stats.waitHistogram.size()), "WaitHistogram"),
+                          TraceLoggingUInt32Array(stats.holdHistogram.data(), gsl::narrow_cast<UINT16>(stats.holdHistogram.size()), "HoldHistogram"),
+                          TraceLoggingUInt32(stats.slicesYielded, "SlicesYielded"),
+                          TraceLoggingUInt32(stats.exclusiveContentions, "ExclusiveContentions"),
+                          TraceLoggingUInt32(stats.sharedContentions, "SharedContentions"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+    }
+
+    // Method Description:
+    // - Starts measuring how long it takes until a key press shows up on
+    //   screen, unless a previous one is still being measured. A key that
+    //   doesn't echo anything never finishes its measurement, so that one is
+    //   given up on after a second.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_startInputLatencyMeasurement() noexcept
+    {
+        if (!TraceLoggingProviderEnabled(g_hTerminalControlProvider, WINEVENT_LEVEL_VERBOSE, 0))
+        {
+            return;
+        }
+
+        const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        const auto pending = _inputLatency.keyPressed.load(std::memory_order_acquire);
+        if (pending != 0 && std::chrono::steady_clock::duration{ now - pending } < std::chrono::seconds{ 1 })
+        {
+            return;
+        }
+
+        _inputLatency.inputWritten.store(0, std::memory_order_relaxed);
+        _inputLatency.outputReceived.store(0, std::memory_order_relaxed);
+        _inputLatency.outputParsed.store(0, std::memory_order_relaxed);
+        _inputLatency.keyPressed.store(now, std::memory_order_release);
+    }
+
+    // Method Description:
+    // - Records that the key press that's being measured reached the next
+    //   hop, if it has already passed the previous one and hasn't reached
+    //   this one yet.
+    // Arguments:
+    // - previous: the timestamp of the previous hop
+    // - next: the timestamp of the hop that was reached
+    // Return Value:
+    // - <none>
+    void ControlCore::_advanceInputLatencyMeasurement(const std::atomic<int64_t>& previous, std::atomic<int64_t>& next) noexcept
+    {
+        if (previous.load(std::memory_order_acquire) == 0 || next.load(std::memory_order_relaxed) != 0)
+        {
+            return;
+        }
+
+        int64_t expected = 0;
+        next.compare_exchange_strong(expected, std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+    }
+
+    // Method Description:
+    // - Called on the render thread for every frame. If the frame includes the
+    //   output that followed the key press being measured, the measurement
+    //   is recorded, logged and finished.
+    // Arguments:
+    // - frameCaptured: the time the frame's contents were taken from the buffer
+    // Return Value:
+    // - <none>
+    void ControlCore::_finishInputLatencyMeasurement(const std::chrono::steady_clock::time_point frameCaptured) noexcept
+    {
+        const auto outputParsed = _inputLatency.outputParsed.load(std::memory_order_acquire);
+        if (outputParsed == 0 || frameCaptured.time_since_epoch().count() < outputParsed)
+        {
+            return;
+        }
+
+        const auto presented = std::chrono::steady_clock::now().time_since_epoch().count();
+        const auto inputWritten = _inputLatency.inputWritten.load(std::memory_order_relaxed);
+        const auto outputReceived = _inputLatency.outputReceived.load(std::memory_order_relaxed);
+        // Taking the key press out of the measurement finishes it, unless the
+        // UI thread has just given up on it and started measuring another one.
+        auto keyPressed = _inputLatency.keyPressed.load(std::memory_order_relaxed);
+        if (keyPressed == 0 || !_inputLatency.keyPressed.compare_exchange_strong(keyPressed, 0, std::memory_order_acq_rel))
+        {
+            return;
+        }
+        _inputLatency.outputParsed.store(0, std::memory_order_relaxed);
+
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        using std::chrono::steady_clock;
+        const auto us = [](const int64_t from, const int64_t to) noexcept {
+            return duration_cast<microseconds>(steady_clock::duration{ to - from }).count();
+        };
+        const std::array<int64_t, InputLatency::HopCount> hops{
+            us(keyPressed, inputWritten),
+            us(inputWritten, outputReceived),
+            us(outputReceived, outputParsed),
+            us(outputParsed, presented),
+            us(keyPressed, presented),
+        };
+
+        for (size_t i = 0; i < hops.size(); ++i)
+        {
+            size_t bucket = 0;
+            while (bucket < InputLatency::BucketCount - 1 && til::at(hops, i) >= (125ll << bucket))
+            {
+                ++bucket;
+            }
+            til::at(til::at(_inputLatency.histograms, i), bucket).fetch_add(1, std::memory_order_relaxed);
+        }
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "InputLatency",
+                          TraceLoggingDescription("The time from a key press to the frame that shows its echo, per hop, in microseconds"),
+                          TraceLoggingInt64(hops[0], "KeyToInput", "Until the input was written to the connection"),
+                          TraceLoggingInt64(hops[1], "InputToOutput", "Until the connection received output, including the round trip through conpty and the application"),
+                          TraceLoggingInt64(hops[2], "OutputToParsed", "Until the output was written to the buffer"),
+                          TraceLoggingInt64(hops[3], "ParsedToPresent", "Until a frame with the output was presented"),
+                          TraceLoggingInt64(hops[4], "Total"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+    }
+
+    // Method Description:
+    // - Logs the histograms of the input latency measured over the lifetime
+    //   of this control, if any was measured at all.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void ControlCore::_traceInputLatencyStatistics()
+    {
+        if (!TraceLoggingProviderEnabled(g_hTerminalControlProvider, WINEVENT_LEVEL_VERBOSE, 0))
+        {
+            return;
+        }
+
+        std::array<std::array<uint32_t, InputLatency::BucketCount>, InputLatency::HopCount> histograms{};
+        uint32_t samples = 0;
+        for (size_t i = 0; i < histograms.size(); ++i)
+        {
+            for (size_t j = 0; j < InputLatency::BucketCount; ++j)
+            {
+                til::at(til::at(histograms, i), j) = til::at(til::at(_inputLatency.histograms, i), j).load(std::memory_order_relaxed);
+            }
+        }
+        for (const auto count : histograms.back())
+        {
+            samples += count;
+        }
+        if (samples == 0)
+        {
+            return;
+        }
+
+#pragma warning(suppress : 26477 26485 26494 26482 26446) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hTerminalControlProvider,
+                          "InputLatencyStatistics",
+                          TraceLoggingDescription("Histograms of the input latency per hop, in buckets of 125us << i"),
+                          TraceLoggingUInt32(samples, "Samples"),
+                          TraceLoggingUInt32Array(histograms[0].data(), gsl::narrow_cast<UINT16>(histograms[0].size()), "KeyToInputHistogram"),
+                          TraceLoggingUInt32Array(histograms[1].data(), gsl::narrow_cast<UINT16>(histograms[1].size()), "InputToOutputHistogram"),
+                          TraceLoggingUInt32Array(histograms[2].data(), gsl::narrow_cast<UINT16>(histograms[2].size()), "OutputToParsedHistogram"),
+                          TraceLoggingUInt32Array(histograms[3].data(), gsl::narrow_cast<UINT16>(histograms[3].size()), "ParsedToPresentHistogram"),
+                          TraceLoggingUInt32Array(histograms[4].data(), gsl::narrow_cast<UINT16>(histograms[4].size()), "TotalHistogram"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE));
+    }
+
     uint64_t ControlCore::SwapChainHandle() const
     {
         // This is called by:
@@ -1460,6 +2281,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _renderer->TriggerSelection();
     }
 
+    // Method Description:
+    // - Gets the minimum time between two text changed or cursor changed
+    //   notifications to automation clients.
+    // Return Value:
+    // - the interval from our settings
+    std::chrono::milliseconds ControlCore::AccessibilityNotificationInterval() const
+    {
+        return std::chrono::milliseconds{ _settings.AccessibilityNotificationInterval() };
+    }
+
     void ControlCore::AttachUiaEngine(::Microsoft::Console::Render::IRenderEngine* const pEngine)
     {
         if (_renderer)
@@ -1468,6 +2299,27 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    // Method Description:
+    // - Takes over the UiaEngine that was attached with AttachUiaEngine, when
+    //   its owner goes away. Our renderer still holds on to it until we're
+    //   destroyed, which is on a background thread, and possibly only after
+    //   the automation peer the engine signals is gone. That's why it's
+    //   disabled here, under the lock, so it doesn't signal anything anymore.
+    // Arguments:
+    // - engine: the UiaEngine that was attached to our renderer
+    // Return Value:
+    // - <none>
+    void ControlCore::DetachUiaEngine(std::unique_ptr<::Microsoft::Console::Render::UiaEngine> engine)
+    {
+        if (engine)
+        {
+            // The renderer only starts and ends a paint with the lock held.
+            auto lock = _terminal->LockForWriting();
+            LOG_IF_FAILED(engine->Disable());
+            _detachedUiaEngine = std::move(engine);
+        }
+    }
+
     bool ControlCore::IsInReadOnlyMode() const
     {
         return _isReadOnly;
@@ -1483,12 +2335,130 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         auto noticeArgs = winrt::make<NoticeEventArgs>(NoticeLevel::Info, RS_(L"TermControlReadOnly"));
         _RaiseNoticeHandlers(*this, std::move(noticeArgs));
     }
+    // Method Description:
+    // - Called on the connection's output thread for every chunk of output.
+    //   Queues the chunk up for the parser thread. This only blocks if the
+    //   parser thread has fallen OutputChannelCapacity chunks behind, which
+    //   pushes back on the connection the same way a slow Write() used to.
+    // Arguments:
+    // - hstr: the chunk of output from the connection.
+    // Return Value:
+    // - <none>
     void ControlCore::_connectionOutputHandler(const hstring& hstr)
     {
-        _terminal->Write(hstr);
+        // The unit tests inspect the buffer right after writing to their mock
+        // connection, so they need the output to be parsed synchronously.
+        _advanceInputLatencyMeasurement(_inputLatency.inputWritten, _inputLatency.outputReceived);
+
+        if (_inUnitTests || !_outputProducer)
+        {
+            _terminal->Write(hstr);
+            _advanceInputLatencyMeasurement(_inputLatency.outputReceived, _inputLatency.outputParsed);
+            _updatePatternLocations->Run();
+            return;
+        }
+
+        _outputProducer->emplace(hstr);
+    }
+
+    // Method Description:
+    // - The body of the parser thread. Waits for output to be queued up by
+    //   _connectionOutputHandler, then takes everything that's available at
+    //   once (up to OutputBatchSize chunks) and writes it to the terminal in a
+    //   single call, so the write lock is acquired once per batch instead of
+    //   once per chunk.
+    // - If a whole batch was waiting, we're behind, and switch to an output
+    //   burst until we've caught up. See _setOutputBurst.
+    // - Returns once the producer has been dropped and the queue is drained.
+    // Arguments:
+    // - consumer: the receiving end of the output channel.
+    // Return Value:
+    // - <none>
+    void ControlCore::_outputThreadMain(const til::spsc::consumer<winrt::hstring>& consumer)
+    {
+        std::array<winrt::hstring, OutputBatchSize> chunks;
+        std::wstring batch;
+        std::optional<unsigned int> normalFramesPerSecond;
+
+        for (;;)
+        {
+            // block_initially waits for the first chunk, but then only takes
+            // what's already there, instead of waiting for the batch to fill up.
+            const auto [count, alive] = consumer.pop_n(til::spsc::block_initially, chunks.begin(), chunks.size());
+            if (count == 0 && !alive)
+            {
+                break;
+            }
+
+            _setOutputBurst(count == chunks.size(), normalFramesPerSecond);
+
+            try
+            {
+                if (count == 1)
+                {
+                    _terminal->Write(chunks[0]);
+                }
+                else
+                {
+                    batch.clear();
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        batch.append(chunks[i]);
+                    }
+                    _terminal->Write(batch);
+                }
+                _advanceInputLatencyMeasurement(_inputLatency.outputReceived, _inputLatency.outputParsed);
+
+                // Start the throttled update of where our hyperlinks are.
+                if (!_inOutputBurst.load(std::memory_order_relaxed))
+                {
+                    _updatePatternLocations->Run();
+                }
+            }
+            CATCH_LOG();
+
+            std::fill_n(chunks.begin(), count, winrt::hstring{});
+        }
+    }
+
+    // Method Description:
+    // - Starts or ends an output burst. While it lasts, the renderer paints
+    //   fewer frames, so that the parser gets the lock more often, and the
+    //   pattern locations aren't updated. Once it's over, we go back to the
+    //   usual frame rate, and look for patterns in what's on screen now.
+    // - Only called on the parser thread.
+    // Arguments:
+    // - inBurst: true if the parser is behind.
+    // - normalFramesPerSecond: the frame rate from before the burst, to go
+    //   back to once it's over.
+    // Return Value:
+    // - <none>
+    void ControlCore::_setOutputBurst(const bool inBurst, std::optional<unsigned int>& normalFramesPerSecond)
+    {
+        if (_inOutputBurst.load(std::memory_order_relaxed) == inBurst)
+        {
+            return;
+        }
+        _inOutputBurst.store(inBurst, std::memory_order_relaxed);
+
+        if (const auto renderThread{ _renderThread.load() })
+        {
+            if (inBurst)
+            {
+                normalFramesPerSecond = renderThread->GetMaxFramesPerSecond();
+                renderThread->SetMaxFramesPerSecond(OutputBurstFramesPerSecond);
+            }
+            else if (normalFramesPerSecond)
+            {
+                renderThread->SetMaxFramesPerSecond(*normalFramesPerSecond);
+                normalFramesPerSecond.reset();
+            }
+        }
 
-        // Start the throttled update of where our hyperlinks are.
-        _updatePatternLocations->Run();
+        if (!inBurst)
+        {
+            _updatePatternLocations->Run();
+        }
     }
 
 }
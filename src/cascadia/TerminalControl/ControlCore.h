@@ -38,13 +38,18 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         ControlCore(IControlSettings settings,
                     TerminalConnection::ITerminalConnection connection);
         ~ControlCore();
+        static winrt::fire_and_forget final_release(std::unique_ptr<ControlCore> core);
 
         bool Initialize(const double actualWidth,
                         const double actualHeight,
                         const double compositionScale);
         void EnablePainting();
+        void SuspendRendering();
+        void ResumeRendering();
+        void ReleaseRenderingResources();
 
         void UpdateSettings(const IControlSettings& settings);
+        std::chrono::milliseconds AccessibilityNotificationInterval() const;
         void UpdateAppearance(const IControlAppearance& newAppearance);
         void SizeChanged(const double width, const double height);
         void ScaleChanged(const double scale);
@@ -67,6 +72,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         bool CopySelectionToClipboard(bool singleLine, const Windows::Foundation::IReference<CopyFormat>& formats);
 
         void ToggleShaderEffects();
+        void ToggleRenderStatistics();
+        Windows::Foundation::IAsyncAction ExportBuffer(const winrt::hstring path, const bool includeAttributes);
+        uint64_t ReportMemoryUsage();
         void AdjustOpacity(const double adjustment);
         void ResumeRendering();
 
@@ -130,7 +138,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         void Search(const winrt::hstring& text,
                     const bool goForward,
-                    const bool caseSensitive);
+                    const bool caseSensitive,
+                    const bool regularExpression);
+        void ClearSearchHighlights();
 
         void LeftClickOnTerminal(const til::point terminalPosition,
                                  const int numberOfClicks,
@@ -140,6 +150,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                  bool& selectionNeedsToBeCopied);
 
         void AttachUiaEngine(::Microsoft::Console::Render::IRenderEngine* const pEngine);
+        void DetachUiaEngine(std::unique_ptr<::Microsoft::Console::Render::UiaEngine> engine);
 
         bool IsInReadOnlyMode() const;
         void ToggleReadOnlyMode();
@@ -168,6 +179,12 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     private:
         bool _initializedTerminal{ false };
+
+        // While we're not visible, the render thread is paused, and after a
+        // while our engine's device resources are released too. Only touched
+        // on the UI thread.
+        bool _renderingSuspended{ false };
+        bool _renderingResourcesReleased{ false };
         bool _closing{ false };
 
         TerminalConnection::ITerminalConnection _connection{ nullptr };
@@ -176,6 +193,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         std::unique_ptr<::Microsoft::Terminal::Core::Terminal> _terminal{ nullptr };
 
+        // NOTE: _detachedUiaEngine must be ordered before _renderer.
+        //
+        // The UiaEngine is owned by the ControlInteractivity, which hands it
+        // over to us when it goes away. We're destroyed on a background thread
+        // (see final_release), so the interactivity may well be gone before
+        // the _renderer is, and the _renderer still holds a raw pointer to it.
+        std::unique_ptr<::Microsoft::Console::Render::UiaEngine> _detachedUiaEngine{ nullptr };
+
         // NOTE: _renderEngine must be ordered before _renderer.
         //
         // As _renderer has a dependency on _renderEngine (through a raw pointer)
@@ -210,8 +235,65 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         std::shared_ptr<ThrottledFuncTrailing<>> _tsfTryRedrawCanvas;
         std::shared_ptr<ThrottledFuncTrailing<>> _updatePatternLocations;
         std::shared_ptr<ThrottledFuncTrailing<Control::ScrollPositionChangedArgs>> _updateScrollBar;
-
+        std::shared_ptr<ThrottledFuncTrailing<uint32_t, uint32_t>> _resizeConnection;
+        std::shared_ptr<ThrottledFuncTrailing<winrt::hstring>> _updateTitle;
+        std::shared_ptr<ThrottledFuncTrailing<>> _updateTabColor;
+        std::shared_ptr<ThrottledFuncTrailing<>> _updateTaskbarProgress;
+
+        // The connection's output thread pushes chunks into _outputProducer,
+        // and _outputThread drains them into the terminal in batches.
+        static constexpr uint32_t OutputChannelCapacity{ 64 };
+        static constexpr size_t OutputBatchSize{ 16 };
+        std::optional<til::spsc::producer<winrt::hstring>> _outputProducer;
+        std::thread _outputThread;
+
+        // While the parser thread keeps finding a whole batch waiting for it,
+        // the output is coming in faster than anyone can read it. During such
+        // a burst we paint at OutputBurstFramesPerSecond, and only look for
+        // patterns again once it's over.
+        static constexpr unsigned int OutputBurstFramesPerSecond{ 10 };
+        std::atomic<bool> _inOutputBurst{ false };
+        // Owned by _renderer.
+        std::atomic<::Microsoft::Console::Render::RenderThread*> _renderThread{ nullptr };
+
+        // Incremented for every new search, so that searches which are
+        // still running in the background know they've been superseded.
+        std::atomic<uint64_t> _searchGeneration{ 0 };
+        std::optional<std::tuple<winrt::hstring, bool, bool>> _highlightedSearch{ std::nullopt };
+
+        // Held while the connection is started or closed on a background
+        // thread, so that the two never overlap. It's shared with those
+        // threads because they may outlive us.
+        std::shared_ptr<std::mutex> _connectionLifetimeLock{ std::make_shared<std::mutex>() };
+
+        // The time it takes from a key press to the frame that shows what the
+        // application echoed back, split up into the hops within our process.
+        // Only measured while someone's listening to our trace provider, and
+        // only for one key press at a time. The timestamps are steady_clock
+        // ticks, 0 if that hop hasn't been reached yet. They're advanced by
+        // the UI, connection, parser and render thread, in this order.
+        struct InputLatency
+        {
+            static constexpr size_t BucketCount = 10;
+            static constexpr size_t HopCount = 5;
+            std::atomic<int64_t> keyPressed{ 0 };
+            std::atomic<int64_t> inputWritten{ 0 };
+            std::atomic<int64_t> outputReceived{ 0 };
+            std::atomic<int64_t> outputParsed{ 0 };
+            // Histograms of KeyToInput, InputToOutput, OutputToParsed,
+            // ParsedToPresent and the total, in buckets of 125us << i.
+            std::array<std::array<std::atomic<uint32_t>, BucketCount>, HopCount> histograms{};
+        };
+        InputLatency _inputLatency;
+
+        winrt::fire_and_forget _asyncStartConnection();
         winrt::fire_and_forget _asyncCloseConnection();
+        winrt::fire_and_forget _highlightAllMatchesAsync(const winrt::hstring text, const bool caseSensitive, const bool regularExpression);
+        winrt::fire_and_forget _copyToClipboardAsync(TextBuffer::TextAndColor bufferData,
+                                                     const int fontHeightPoints,
+                                                     const std::wstring fontFaceName,
+                                                     const COLORREF backgroundColor,
+                                                     const Windows::Foundation::IReference<CopyFormat> formats);
 
         void _setFontSize(int fontSize);
         void _updateFont(const bool initialUpdate = false);
@@ -240,8 +322,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 #pragma endregion
 
         void _raiseReadOnlyWarning();
+        void _traceWriteLockStatistics();
+        void _startInputLatencyMeasurement() noexcept;
+        void _advanceInputLatencyMeasurement(const std::atomic<int64_t>& previous, std::atomic<int64_t>& next) noexcept;
+        void _finishInputLatencyMeasurement(const std::chrono::steady_clock::time_point frameCaptured) noexcept;
+        void _traceInputLatencyStatistics();
         void _updateAntiAliasingMode(::Microsoft::Console::Render::DxEngine* const dxEngine);
         void _connectionOutputHandler(const hstring& hstr);
+        void _outputThreadMain(const til::spsc::consumer<winrt::hstring>& consumer);
+        void _setOutputBurst(const bool inBurst, std::optional<unsigned int>& normalFramesPerSecond);
         void _updateHoveredCell(const std::optional<til::point> terminalPosition);
 
         inline bool _IsClosing() const noexcept
@@ -48,6 +48,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _core = winrt::make_self<ControlCore>(settings, connection);
     }
 
+    ControlInteractivity::~ControlInteractivity()
+    {
+        // Our core is destroyed on a background thread, and its renderer keeps
+        // using the UiaEngine until then. Hand the engine over to it.
+        if (_core)
+        {
+            _core->DetachUiaEngine(std::move(_uiaEngine));
+        }
+    }
+
     // Method Description:
     // - Updates our internal settings. These settings should be
     //   interactivity-specific. Right now, we primarily update _rowsToScroll
@@ -59,6 +69,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     void ControlInteractivity::UpdateSettings()
     {
         _updateSystemParameterSettings();
+
+        if (_uiaEngine)
+        {
+            _uiaEngine->SetNotificationInterval(_core->AccessibilityNotificationInterval());
+        }
     }
 
     void ControlInteractivity::Initialize()
@@ -195,6 +210,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                               const til::point pixelPosition)
     {
         const til::point terminalPosition = _getTerminalPosition(pixelPosition);
+        _lastPointerMove = std::nullopt;
 
         const auto altEnabled = modifiers.IsAltPressed();
         const auto shiftEnabled = modifiers.IsShiftPressed();
@@ -284,6 +300,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         const til::point terminalPosition = _getTerminalPosition(pixelPosition);
 
+        // The touchdown point is tracked in pixels, so until a selection has
+        // started, every move counts.
+        const PointerMove move{ terminalPosition, buttonState, pointerUpdateKind, modifiers, _core->ScrollOffset(), focused, pointerPressedInBounds };
+        if (!_singleClickTouchdownPos && _lastPointerMove == move)
+        {
+            return;
+        }
+        _lastPointerMove = move;
+
         // Short-circuit isReadOnly check to avoid warning dialog
         if (focused && !_core->IsInReadOnlyMode() && _canSendVTMouseInput(modifiers))
         {
@@ -367,6 +392,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                                const til::point pixelPosition)
     {
         const til::point terminalPosition = _getTerminalPosition(pixelPosition);
+        _lastPointerMove = std::nullopt;
         // Short-circuit isReadOnly check to avoid warning dialog
         if (!_core->IsInReadOnlyMode() && _canSendVTMouseInput(modifiers))
         {
@@ -617,6 +643,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         auto autoPeer = winrt::make_self<implementation::InteractivityAutomationPeer>(this);
 
         _uiaEngine = std::make_unique<::Microsoft::Console::Render::UiaEngine>(autoPeer.get());
+        _uiaEngine->SetNotificationInterval(_core->AccessibilityNotificationInterval());
         _core->AttachUiaEngine(_uiaEngine.get());
         return *autoPeer;
     }
@@ -36,6 +36,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     public:
         ControlInteractivity(IControlSettings settings,
                              TerminalConnection::ITerminalConnection connection);
+        ~ControlInteractivity();
 
         void GotFocus();
         void LostFocus();
@@ -88,13 +89,13 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         TYPED_EVENT(ScrollPositionChanged, IInspectable, Control::ScrollPositionChangedArgs);
 
     private:
-        // NOTE: _uiaEngine must be ordered before _core.
+        // NOTE: _uiaEngine is handed over to the _core when we're destroyed.
         //
         // ControlCore::AttachUiaEngine receives a IRenderEngine as a raw pointer, which we own.
-        // We must ensure that we first destroy the ControlCore before the UiaEngine instance
-        // in order to safely resolve this unsafe pointer dependency. Otherwise a deallocated
-        // IRenderEngine is accessed when ControlCore calls Renderer::TriggerTeardown.
-        // (C++ class members are destroyed in reverse order.)
+        // The ControlCore is destroyed on a background thread, so it may outlive us. We must
+        // ensure that the UiaEngine instance lives as long as it does, in order to safely
+        // resolve this unsafe pointer dependency. Otherwise a deallocated IRenderEngine is
+        // accessed when ControlCore calls Renderer::TriggerTeardown.
         std::unique_ptr<::Microsoft::Console::Render::UiaEngine> _uiaEngine;
 
         winrt::com_ptr<ControlCore> _core{ nullptr };
@@ -115,6 +116,32 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         std::optional<til::point> _lastMouseClickPos;
         std::optional<til::point> _singleClickTouchdownPos;
         std::optional<til::point> _lastMouseClickPosNoSelection;
+
+        // The last pointer move that was acted upon. High polling rate mice report
+        // many moves per cell, and the ones that don't leave the cell (with the
+        // same buttons and modifiers, and without scrolling in between) are dropped.
+        struct PointerMove
+        {
+            til::point terminalPosition;
+            Control::MouseButtonState buttonState;
+            unsigned int pointerUpdateKind;
+            ::Microsoft::Terminal::Core::ControlKeyStates modifiers;
+            int scrollOffset;
+            bool focused;
+            bool pointerPressedInBounds;
+
+            bool operator==(const PointerMove& other) const noexcept
+            {
+                return terminalPosition == other.terminalPosition &&
+                       buttonState == other.buttonState &&
+                       pointerUpdateKind == other.pointerUpdateKind &&
+                       modifiers == other.modifiers &&
+                       scrollOffset == other.scrollOffset &&
+                       focused == other.focused &&
+                       pointerPressedInBounds == other.pointerPressedInBounds;
+            }
+        };
+        std::optional<PointerMove> _lastPointerMove;
         // This field tracks whether the selection has changed meaningfully
         // since it was last copied. It's generally used to prevent copyOnSelect
         // from firing when the pointer _just happens_ to be released over the
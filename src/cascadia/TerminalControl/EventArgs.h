@@ -39,15 +39,41 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _rtf(rtf),
             _formats(formats) {}
 
+        // HTML and RTF are expensive to generate for large selections, and
+        // most pastes only want the text. These are generated the first time
+        // they're asked for.
+        CopyToClipboardEventArgs(hstring text, std::function<hstring()> htmlGenerator, std::function<hstring()> rtfGenerator, Windows::Foundation::IReference<CopyFormat> formats) :
+            _text(text),
+            _html(),
+            _rtf(),
+            _htmlGenerator(std::move(htmlGenerator)),
+            _rtfGenerator(std::move(rtfGenerator)),
+            _formats(formats) {}
+
         hstring Text() { return _text; };
-        hstring Html() { return _html; };
-        hstring Rtf() { return _rtf; };
+        hstring Html() { return _generate(_html, _htmlGenerator); };
+        hstring Rtf() { return _generate(_rtf, _rtfGenerator); };
         Windows::Foundation::IReference<CopyFormat> Formats() { return _formats; };
 
     private:
+        hstring _generate(hstring& value, std::function<hstring()>& generator)
+        {
+            // The clipboard may ask for a format from any thread.
+            std::lock_guard<std::mutex> guard{ _generatorLock };
+            if (generator)
+            {
+                value = generator();
+                generator = nullptr;
+            }
+            return value;
+        }
+
         hstring _text;
         hstring _html;
         hstring _rtf;
+        std::mutex _generatorLock;
+        std::function<hstring()> _htmlGenerator;
+        std::function<hstring()> _rtfGenerator;
         Windows::Foundation::IReference<CopyFormat> _formats;
     };
 
@@ -9,6 +9,7 @@
 #include <Utf16Parser.hpp>
 #include <Utils.h>
 #include <LibraryResources.h>
+#include "WeakReferenceCache.h"
 #include "../../types/inc/GlyphWidth.hpp"
 #include "../../types/inc/Utils.hpp"
 
@@ -42,6 +43,9 @@ constexpr const auto UpdatePatternLocationsInterval = std::chrono::milliseconds(
 // The minimum delay between emitting warning bells
 constexpr const auto TerminalWarningBellInterval = std::chrono::milliseconds(1000);
 
+// How long a control has to be hidden before its rendering resources are released
+constexpr const auto ReleaseRenderingResourcesDelay = std::chrono::seconds(30);
+
 DEFINE_ENUM_FLAG_OPERATORS(winrt::Microsoft::Terminal::Control::CopyFormat);
 
 DEFINE_ENUM_FLAG_OPERATORS(winrt::Microsoft::Terminal::Control::MouseButtonState);
@@ -145,6 +149,20 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _autoScrollTimer.Interval(AutoScrollUpdateInterval);
         _autoScrollTimer.Tick({ this, &TermControl::_UpdateAutoScroll });
 
+        _releaseRenderingResourcesTimer.Interval(ReleaseRenderingResourcesDelay);
+        _releaseRenderingResourcesTimer.Tick([this](auto&&, auto&&) {
+            _releaseRenderingResourcesTimer.Stop();
+            if (!_IsClosing())
+            {
+                _core.ReleaseRenderingResources();
+            }
+        });
+
+        // Switching tabs removes the control from the tree, so Loaded and
+        // Unloaded tell us whether we're in a background tab.
+        Loaded([this](auto&&, auto&&) { _updateRenderingSuspension(); });
+        Unloaded([this](auto&&, auto&&) { _updateRenderingSuspension(); });
+
         _ApplyUISettings(_settings);
     }
 
@@ -193,7 +211,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
         else
         {
-            _core.Search(_searchBox->TextBox().Text(), goForward, false);
+            _core.Search(_searchBox->TextBox().Text(), goForward, false, false);
         }
     }
 
@@ -204,13 +222,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     // - text: the text to search
     // - goForward: boolean that represents if the current search direction is forward
     // - caseSensitive: boolean that represents if the current search is case sensitive
+    // - regularExpression: boolean that represents if the text is a regular expression
     // Return Value:
     // - <none>
     void TermControl::_Search(const winrt::hstring& text,
                               const bool goForward,
-                              const bool caseSensitive)
+                              const bool caseSensitive,
+                              const bool regularExpression)
     {
-        _core.Search(text, goForward, caseSensitive);
+        _core.Search(text, goForward, caseSensitive, regularExpression);
     }
 
     // Method Description:
@@ -225,6 +245,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                              RoutedEventArgs const& /*args*/)
     {
         _searchBox->Visibility(Visibility::Collapsed);
+        _core.ClearSearchHighlights();
 
         // Set focus back to terminal control
         this->Focus(FocusState::Programmatic);
@@ -314,7 +335,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 // which is especially important since the image
                 // may well be both large and somewhere out on the
                 // internet.
-                Media::Imaging::BitmapImage image(imageUri);
+                // All the controls on this thread that use the same image
+                // share one BitmapImage, so that it's only loaded and
+                // decoded once. XAML decodes it at the size it's displayed
+                // at, so the path is all we need to key it on.
+                static thread_local WeakReferenceCache<winrt::hstring, Media::Imaging::BitmapImage> s_backgroundImages;
+                const auto image{ s_backgroundImages.GetOrCreate(imageUri.RawUri(), [&]() {
+                    return Media::Imaging::BitmapImage{ imageUri };
+                }) };
                 BackgroundImage().Source(image);
             }
 
@@ -336,7 +364,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // Set TSF Foreground
         Media::SolidColorBrush foregroundBrush{};
         foregroundBrush.Color(static_cast<til::color>(newAppearance.DefaultForeground()));
-        TSFInputControl().Foreground(foregroundBrush);
+        _tsfForegroundBrush = foregroundBrush;
+        if (const auto tsfInputControl{ TSFInputControl() })
+        {
+            tsfInputControl.Foreground(foregroundBrush);
+        }
 
         _core.UpdateAppearance(newAppearance);
     }
@@ -357,6 +389,21 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         _core.ToggleShaderEffects();
     }
 
+    void TermControl::ToggleRenderStatistics()
+    {
+        _core.ToggleRenderStatistics();
+    }
+
+    uint64_t TermControl::ReportMemoryUsage()
+    {
+        return _core.ReportMemoryUsage();
+    }
+
+    Windows::Foundation::IAsyncAction TermControl::ExportBuffer(const winrt::hstring& path, const bool includeAttributes)
+    {
+        return _core.ExportBuffer(path, includeAttributes);
+    }
+
     // Method Description:
     // - Style our UI elements based on the values in our _settings, and set up
     //   other control-specific settings. This method will be called whenever
@@ -380,7 +427,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         auto newMargin = ParseThicknessFromPadding(newSettings.Padding());
         SwapChainPanel().Margin(newMargin);
 
-        TSFInputControl().Margin(newMargin);
+        if (const auto tsfInputControl{ TSFInputControl() })
+        {
+            tsfInputControl.Margin(newMargin);
+        }
 
         // Apply settings for scrollbar
         if (newSettings.ScrollState() == ScrollbarState::Hidden)
@@ -675,6 +725,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             cursorTimer.Tick({ get_weak(), &TermControl::_CursorTimerTick });
             cursorTimer.Start();
             _cursorTimer.emplace(std::move(cursorTimer));
+
+            // Like the system's own text boxes, stop blinking when nothing
+            // has happened for a while (the "caret timeout", 5s by default).
+            // An idle terminal then doesn't wake up to draw the cursor at all.
+            DWORD blinkTimeout = 5000;
+            SystemParametersInfoW(SPI_GETCARETTIMEOUT, 0, &blinkTimeout, 0);
+            _cursorBlinksUntilIdle = blinkTimeout == INFINITE ? 0 : std::max<uint32_t>(blinkTimeout / blinkTime, 2);
+            _cursorBlinksLeft = _cursorBlinksUntilIdle;
         }
         else
         {
@@ -971,7 +1029,10 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         if (vkey == VK_ESCAPE ||
             vkey == VK_RETURN)
         {
-            TSFInputControl().ClearBuffer();
+            if (const auto tsfInputControl{ TSFInputControl() })
+            {
+                tsfInputControl.ClearBuffer();
+            }
         }
 
         // If the terminal translated the key, mark the event as handled.
@@ -988,8 +1049,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         {
             // Manually show the cursor when a key is pressed. Restarting
             // the timer prevents flickering.
-            _core.CursorOn(true);
-            _cursorTimer->Start();
+            _RestartCursorBlinking();
         }
 
         return handled;
@@ -1447,16 +1507,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             return;
         }
 
-        if (TSFInputControl() != nullptr)
+        if (const auto tsfInputControl{ _LoadTSFInputControl() })
         {
-            TSFInputControl().NotifyFocusEnter();
+            tsfInputControl.NotifyFocusEnter();
         }
 
         if (_cursorTimer)
         {
             // When the terminal focuses, show the cursor immediately
-            _core.CursorOn(true);
-            _cursorTimer->Start();
+            _RestartCursorBlinking();
         }
 
         if (_blinkTimer)
@@ -1584,10 +1643,37 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         if (!_IsClosing())
         {
+            // Once we've been idle long enough, leave the cursor on and stop
+            // ticking until there's input or output again.
+            if (_cursorBlinksUntilIdle != 0 && _cursorBlinksLeft == 0)
+            {
+                _core.CursorOn(true);
+                _cursorTimer->Stop();
+                return;
+            }
+
+            if (_cursorBlinksLeft != 0)
+            {
+                --_cursorBlinksLeft;
+            }
             _core.BlinkCursor();
         }
     }
 
+    // Method Description:
+    // - Shows the cursor and starts blinking it again, from the beginning of
+    //   the idle timeout.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TermControl::_RestartCursorBlinking()
+    {
+        _cursorBlinksLeft = _cursorBlinksUntilIdle;
+        _core.CursorOn(true);
+        _cursorTimer->Start();
+    }
+
     // Method Description:
     // - Toggle the blinking rendition state when called by the blink timer.
     // Arguments:
@@ -1651,7 +1737,20 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         co_await resume_foreground(Dispatcher());
         if (auto control{ weakThis.get() }; !control->_IsClosing())
         {
-            control->TSFInputControl().TryRedrawCanvas();
+            if (const auto tsfInputControl{ control->TSFInputControl() })
+            {
+                tsfInputControl.TryRedrawCanvas();
+            }
+
+            // Output counts as activity, so resume blinking if we had stopped.
+            if (control->_cursorTimer && control->_focused)
+            {
+                control->_cursorBlinksLeft = control->_cursorBlinksUntilIdle;
+                if (!control->_cursorTimer->IsEnabled())
+                {
+                    control->_cursorTimer->Start();
+                }
+            }
         }
     }
 
@@ -1709,13 +1808,60 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             _RestorePointerCursorHandlers(*this, nullptr);
 
             // Disconnect the TSF input control so it doesn't receive EditContext events.
-            TSFInputControl().Close();
+            if (const auto tsfInputControl{ TSFInputControl() })
+            {
+                tsfInputControl.Close();
+            }
             _autoScrollTimer.Stop();
+            _releaseRenderingResourcesTimer.Stop();
 
             _core.Close();
         }
     }
 
+    // Method Description:
+    // - Called when the window we're in is minimized or restored.
+    // Arguments:
+    // - showOrHide: false if the window was minimized
+    // Return Value:
+    // - <none>
+    void TermControl::WindowVisibilityChanged(const bool showOrHide)
+    {
+        _windowVisible = showOrHide;
+        _updateRenderingSuspension();
+    }
+
+    // Method Description:
+    // - Suspends rendering while we can't be seen, either because we're in a
+    //   background tab or because the window is minimized, and resumes it once
+    //   we can. If we stay hidden for a while, the render engine's device
+    //   resources are released as well.
+    // - When a pane is moved, XAML may raise Loaded for the new parent before
+    //   Unloaded for the old one, so we check IsLoaded instead of trusting
+    //   whichever event fired last.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void TermControl::_updateRenderingSuspension()
+    {
+        if (_IsClosing())
+        {
+            return;
+        }
+
+        if (_windowVisible && IsLoaded())
+        {
+            _releaseRenderingResourcesTimer.Stop();
+            _core.ResumeRendering();
+        }
+        else
+        {
+            _core.SuspendRendering();
+            _releaseRenderingResourcesTimer.Start();
+        }
+    }
+
     // Method Description:
     // - Scrolls the viewport of the terminal and updates the scroll bar accordingly
     // Arguments:
@@ -2068,6 +2214,34 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return relativeToMarginInPixels;
     }
 
+    // Method Description:
+    // - Loads the TSF input control from the xaml UI, if it isn't loaded yet.
+    // - Nothing can be composed before we have focus, so we wait until then to
+    //   load it. It gets the padding and the foreground that were applied to
+    //   the control in the meantime.
+    // Return Value:
+    // - the TSF input control, or nullptr if it couldn't be loaded
+    Control::TSFInputControl TermControl::_LoadTSFInputControl()
+    {
+        if (const auto tsfInputControl{ TSFInputControl() })
+        {
+            return tsfInputControl;
+        }
+
+        if (!FindName(L"TSFInputControl"))
+        {
+            return nullptr;
+        }
+
+        const auto tsfInputControl{ TSFInputControl() };
+        tsfInputControl.Margin(SwapChainPanel().Margin());
+        if (_tsfForegroundBrush)
+        {
+            tsfInputControl.Foreground(_tsfForegroundBrush);
+        }
+        return tsfInputControl;
+    }
+
     // Method Description:
     // - Composition Completion handler for the TSFInputControl that
     //   handles writing text out to TerminalConnection
@@ -35,6 +35,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         bool CopySelectionToClipboard(bool singleLine, const Windows::Foundation::IReference<CopyFormat>& formats);
         void PasteTextFromClipboard();
         void Close();
+        void WindowVisibilityChanged(const bool showOrHide);
         Windows::Foundation::Size CharacterDimensions() const;
         Windows::Foundation::Size MinimumSize();
         float SnapDimensionToGrid(const bool widthOrHeight, const float dimension);
@@ -64,6 +65,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         void SendInput(const winrt::hstring& input);
         void ToggleShaderEffects();
+        void ToggleRenderStatistics();
+        Windows::Foundation::IAsyncAction ExportBuffer(const winrt::hstring& path, const bool includeAttributes);
+        uint64_t ReportMemoryUsage();
 
         winrt::fire_and_forget RenderEngineSwapChainChanged(IInspectable sender, IInspectable args);
         void _AttachDxgiSwapChainToXaml(HANDLE swapChainHandle);
@@ -147,6 +151,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         Control::ControlCore _core{ nullptr };
 
         winrt::com_ptr<SearchBoxControl> _searchBox;
+        // The brush for the TSF input control's text, kept around for when
+        // it's loaded. See _LoadTSFInputControl.
+        Windows::UI::Xaml::Media::SolidColorBrush _tsfForegroundBrush{ nullptr };
 
         IControlSettings _settings;
         bool _closing{ false };
@@ -179,10 +186,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         Windows::UI::Xaml::DispatcherTimer _bellLightTimer{ nullptr };
 
         std::optional<Windows::UI::Xaml::DispatcherTimer> _cursorTimer;
+        uint32_t _cursorBlinksUntilIdle{ 0 };
+        uint32_t _cursorBlinksLeft{ 0 };
         std::optional<Windows::UI::Xaml::DispatcherTimer> _blinkTimer;
+        Windows::UI::Xaml::DispatcherTimer _releaseRenderingResourcesTimer;
+        bool _windowVisible{ true };
 
         winrt::Windows::UI::Xaml::Controls::SwapChainPanel::LayoutUpdated_revoker _layoutUpdatedRevoker;
 
+        void _updateRenderingSuspension();
+
         inline bool _IsClosing() const noexcept
         {
             // _closing isn't atomic and may only be accessed from the main thread.
@@ -220,6 +233,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         winrt::fire_and_forget _HyperlinkHandler(Windows::Foundation::IInspectable sender, Control::OpenHyperlinkEventArgs e);
 
         void _CursorTimerTick(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
+        void _RestartCursorBlinking();
         void _BlinkTimerTick(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
         void _BellLightOff(Windows::Foundation::IInspectable const& sender, Windows::Foundation::IInspectable const& e);
 
@@ -249,10 +263,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const til::point _toTerminalOrigin(winrt::Windows::Foundation::Point cursorPosition);
         double _GetAutoScrollSpeed(double cursorDistanceFromBorder) const;
 
-        void _Search(const winrt::hstring& text, const bool goForward, const bool caseSensitive);
+        void _Search(const winrt::hstring& text, const bool goForward, const bool caseSensitive, const bool regularExpression);
         void _CloseSearchBoxControl(const winrt::Windows::Foundation::IInspectable& sender, Windows::UI::Xaml::RoutedEventArgs const& args);
 
         // TSFInputControl Handlers
+        Control::TSFInputControl _LoadTSFInputControl();
         void _CompositionCompleted(winrt::hstring text);
         void _CurrentCursorPositionHandler(const IInspectable& sender, const CursorPositionEventArgs& eventArgs);
         void _FontInfoHandler(const IInspectable& sender, const FontInfoEventArgs& eventArgs);
@@ -18,6 +18,7 @@ namespace Microsoft::Terminal::Core
         ITerminalApi& operator=(ITerminalApi&&) = default;
 
         virtual bool PrintString(std::wstring_view string) noexcept = 0;
+        virtual bool PrintRepeated(wchar_t wch, size_t count) noexcept = 0;
         virtual bool ExecuteChar(wchar_t wch) noexcept = 0;
 
         virtual TextAttribute GetTextAttributes() const noexcept = 0;
@@ -58,6 +59,7 @@ namespace Microsoft::Terminal::Core
         virtual bool EnableAnyEventMouseMode(const bool enabled) noexcept = 0;
         virtual bool EnableAlternateScrollMode(const bool enabled) noexcept = 0;
         virtual bool EnableXtermBracketedPasteMode(const bool enabled) noexcept = 0;
+        virtual bool EnableSynchronizedOutput(const bool enabled) noexcept = 0;
         virtual bool IsXtermBracketedPasteModeEnabled() const = 0;
 
         virtual bool IsVtInputEnabled() const = 0;
@@ -21,21 +21,6 @@ using namespace Microsoft::Console::VirtualTerminal;
 
 using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 
-static std::wstring _KeyEventsToText(std::deque<std::unique_ptr<IInputEvent>>& inEventsToWrite)
-{
-    std::wstring wstr = L"";
-    for (const auto& ev : inEventsToWrite)
-    {
-        if (ev->EventType() == InputEventType::KeyEvent)
-        {
-            const auto& k = static_cast<KeyEvent&>(*ev);
-            const auto wch = k.GetCharData();
-            wstr += wch;
-        }
-    }
-    return wstr;
-}
-
 #pragma warning(suppress : 26455) // default constructor is throwing, too much effort to rearrange at this time.
 Terminal::Terminal() :
     _mutableViewport{ Viewport::Empty() },
@@ -48,6 +33,7 @@ Terminal::Terminal() :
     _scrollOffset{ 0 },
     _snapOnInput{ true },
     _altGrAliasing{ true },
+    _predictiveEcho{ false },
     _blockSelection{ false },
     _selection{ std::nullopt },
     _taskbarState{ 0 },
@@ -59,13 +45,13 @@ Terminal::Terminal() :
 
     _stateMachine = std::make_unique<StateMachine>(std::move(engine));
 
-    auto passAlongInput = [&](std::deque<std::unique_ptr<IInputEvent>>& inEventsToWrite) {
-        if (!_pfnWriteInput)
+    // The input is sent as text straight to the connection. There's no need
+    // for TerminalInput to make a key event out of every character first.
+    auto passAlongInput = [&](const std::wstring_view text) {
+        if (_pfnWriteInput)
         {
-            return;
+            _pfnWriteInput(text);
         }
-        std::wstring wstr = _KeyEventsToText(inEventsToWrite);
-        _pfnWriteInput(wstr);
     };
 
     _terminalInput = std::make_unique<TerminalInput>(passAlongInput);
@@ -82,6 +68,7 @@ void Terminal::Create(COORD viewportSize, SHORT scrollbackLines, IRenderTarget&
     const TextAttribute attr{};
     const UINT cursorSize = 12;
     _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, renderTarget);
+    _selectionRectsCache.Clear();
 }
 
 // Method Description:
@@ -112,6 +99,11 @@ void Terminal::UpdateSettings(ICoreSettings settings)
 
     _snapOnInput = settings.SnapOnInput();
     _altGrAliasing = settings.AltGrAliasing();
+    _predictiveEcho = settings.PredictiveEcho();
+    if (!_predictiveEcho)
+    {
+        _ClearPredictions();
+    }
     _wordDelimiters = settings.WordDelimiters();
     _suppressApplicationTitle = settings.SuppressApplicationTitle();
     _startingTitle = settings.StartingTitle();
@@ -229,6 +221,10 @@ void Terminal::UpdateAppearance(const ICoreAppearance& appearance)
         return S_FALSE;
     }
 
+    // The text is about to be reflowed. Whatever we predicted would end up
+    // in the wrong place.
+    _ClearPredictions();
+
     const auto dx = ::base::ClampSub(viewportSize.X, oldDimensions.X);
     const short newBufferHeight = ::base::ClampAdd(viewportSize.Y, _scrollbackLines);
 
@@ -397,6 +393,7 @@ void Terminal::UpdateAppearance(const ICoreAppearance& appearance)
     _mutableViewport = Viewport::FromDimensions({ 0, proposedTop }, viewportSize);
 
     _buffer.swap(newTextBuffer);
+    _selectionRectsCache.Clear();
 
     // GH#3494: Maintain scrollbar position during resize
     // Make sure that we don't scroll past the mutableViewport at the bottom of the buffer
@@ -419,11 +416,129 @@ void Terminal::UpdateAppearance(const ICoreAppearance& appearance)
     return S_OK;
 }
 
+// Method Description:
+// - Writes the given string through the state machine.
+// - Large writes are processed in slices of WriteSliceSize characters. If
+//   another thread (usually the renderer) is waiting for the lock once
+//   WriteSliceDuration has passed, we briefly release the lock between two
+//   slices. The ticket_lock is fair, so the waiting thread gets to go first,
+//   and the screen keeps updating during long bursts of output.
+// Arguments:
+// - stringView: the string to write.
+// Return Value:
+// - <none>
 void Terminal::Write(std::wstring_view stringView)
 {
-    auto lock = LockForWriting();
+    using clock = std::chrono::steady_clock;
+
+    while (!stringView.empty())
+    {
+        const auto waitStart = clock::now();
+        auto lock = LockForWriting();
+        const auto holdStart = clock::now();
+
+        _deferNotifications = true;
+        auto sendScrollEvent = wil::scope_exit([&]() noexcept {
+            _deferNotifications = false;
+            if (_scrollEventPending)
+            {
+                _NotifyScrollEvent();
+            }
+            if (_cursorPositionChangedPending)
+            {
+                _NotifyTerminalCursorPositionChanged();
+            }
+            if (_colorsChangedPending)
+            {
+                _NotifyColorsChanged(false);
+            }
+        });
+
+        do
+        {
+            auto sliceSize = std::min(stringView.size(), WriteSliceSize);
+            // Don't split surrogate pairs between two calls to ProcessString(),
+            // as each call prints its text in one go.
+            if (sliceSize < stringView.size() && IS_HIGH_SURROGATE(stringView[sliceSize - 1]))
+            {
+                --sliceSize;
+            }
+
+            _stateMachine->ProcessString(stringView.substr(0, sliceSize));
+            stringView = stringView.substr(sliceSize);
+        } while (!stringView.empty() && (!_readWriteLock.is_contended() || clock::now() - holdStart < WriteSliceDuration));
+
+        _ReconcilePredictions();
+
+        // Send the scroll event (if any) while we still hold the lock,
+        // so it reflects the viewport at the end of this slice. Palette
+        // changes are applied with a single redraw at the same time.
+        sendScrollEvent.reset();
+
+        const auto holdEnd = clock::now();
+        _RecordWriteLockDuration(_writeLockStatistics.waitHistogram, holdStart - waitStart);
+        _RecordWriteLockDuration(_writeLockStatistics.holdHistogram, holdEnd - holdStart);
+        if (!stringView.empty())
+        {
+            ++_writeLockStatistics.slicesYielded;
+        }
+    }
+}
+
+// Method Description:
+// - Returns the lock wait/hold histograms collected by Write() so far.
+//   The caller must hold the terminal lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - the statistics
+Terminal::WriteLockStatistics Terminal::GetWriteLockStatistics() const noexcept
+{
+    auto statistics = _writeLockStatistics;
+    const auto contentions = _readWriteLock.contentions();
+    statistics.exclusiveContentions = contentions.exclusive;
+    statistics.sharedContentions = contentions.shared;
+    return statistics;
+}
+
+// Method Description:
+// - Adds up the memory held by the buffers of this terminal, including the
+//   prediction buffer, the pattern tree and the search highlights.
+//   The caller must hold the terminal lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - the memory in use, in bytes
+TextBuffer::MemoryUsage Terminal::GetMemoryUsage() const noexcept
+{
+    auto usage = _buffer->GetMemoryUsage();
+    if (_predictionBuffer)
+    {
+        const auto prediction = _predictionBuffer->GetMemoryUsage();
+        usage.cells += prediction.cells;
+        usage.rows += prediction.rows;
+        usage.attributes += prediction.attributes;
+        usage.unicodeStorage += prediction.unicodeStorage;
+        usage.hyperlinks += prediction.hyperlinks;
+        usage.patterns += prediction.patterns;
+    }
+
+    size_t intervals = 0;
+    _patternIntervalTree.visit_all([&](const auto&) { ++intervals; });
+    usage.patterns += intervals * sizeof(interval_tree::IntervalTree<til::point, size_t>::interval);
+    usage.patterns += _searchHighlights.capacity() * sizeof(decltype(_searchHighlights)::value_type);
+    return usage;
+}
 
-    _stateMachine->ProcessString(stringView);
+void Terminal::_RecordWriteLockDuration(std::array<uint32_t, WriteLockStatistics::BucketCount>& histogram, const std::chrono::steady_clock::duration duration) noexcept
+{
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    size_t bucket = 0;
+    while (bucket < histogram.size() - 1 && us >= (64ll << bucket))
+    {
+        ++bucket;
+    }
+    ++til::at(histogram, bucket);
 }
 
 void Terminal::WritePastedText(std::wstring_view stringView)
@@ -537,6 +652,39 @@ std::optional<PointTree::interval> Terminal::GetHyperlinkIntervalFromPosition(co
     return std::nullopt;
 }
 
+// Method Description:
+// - Redraws the visible cells that are drawn differently while the given
+//   hyperlink is hovered: all the cells that link to the given OSC 8 ID, and
+//   the cells of the given URI pattern match. Call this for both the link
+//   that was hovered before and the one that's hovered now.
+// Arguments:
+// - id - The OSC 8 hyperlink ID, or 0 for none
+// - interval - The URI pattern match, as returned by GetHyperlinkIntervalFromPosition
+// Return value:
+// - <none>
+void Terminal::InvalidateHyperlink(const uint16_t id, const std::optional<PointTree::interval>& interval)
+{
+    if (interval.has_value())
+    {
+        const auto vis = _VisibleStartIndex();
+        _InvalidateFromCoords({ gsl::narrow<SHORT>(interval->start.x()), gsl::narrow<SHORT>(interval->start.y() + vis) },
+                              { gsl::narrow<SHORT>(interval->stop.x()), gsl::narrow<SHORT>(interval->stop.y() + vis) });
+    }
+
+    if (id != 0)
+    {
+        const auto& buffer = std::as_const(*_buffer);
+        for (auto row = _VisibleStartIndex(); row <= _VisibleEndIndex(); ++row)
+        {
+            for (const auto& [begin, end] : buffer.GetRowByOffset(row).GetAttrRow().GetHyperlinkRuns(id))
+            {
+                const SMALL_RECT region{ gsl::narrow<SHORT>(begin), gsl::narrow<SHORT>(row), gsl::narrow<SHORT>(end - 1), gsl::narrow<SHORT>(row) };
+                _buffer->GetRenderTarget().TriggerRedraw(Viewport::FromInclusive(region));
+            }
+        }
+    }
+}
+
 // Method Description:
 // - Send this particular (non-character) key event to the terminal.
 // - The terminal will translate the key and the modifiers pressed into the
@@ -620,6 +768,14 @@ bool Terminal::SendKeyEvent(const WORD vkey,
         return false;
     }
 
+    // Keys like Enter, Backspace or the arrows move the cursor around in
+    // ways we can't predict. Start over once their echo arrives.
+    if (_predictiveEcho && keyDown && !KeyEvent::IsModifierKey(vkey))
+    {
+        auto lock = LockForWriting();
+        _ClearPredictions();
+    }
+
     KeyEvent keyEv{ keyDown, 1, vkey, sc, ch, states.Value() };
     return _terminalInput->HandleKey(&keyEv);
 }
@@ -682,9 +838,146 @@ bool Terminal::SendCharEvent(const wchar_t ch, const WORD scanCode, const Contro
     KeyEvent keyUp{ false, 1, vkey, scanCode, ch, states.Value() };
     const auto handledDown = _terminalInput->HandleKey(&keyDown);
     const auto handledUp = _terminalInput->HandleKey(&keyUp);
+
+    if (_predictiveEcho)
+    {
+        auto lock = LockForWriting();
+        // Alt+key is sent as an escape sequence, which isn't echoed as is.
+        if (states.IsAltPressed() && !states.IsCtrlPressed())
+        {
+            _ClearPredictions();
+        }
+        else
+        {
+            _PredictCharacter(ch);
+        }
+    }
+
     return handledDown || handledUp;
 }
 
+// Method Description:
+// - Speculatively echoes a character the user typed, if predictive echo is
+//   enabled. The character is drawn after the cursor (or after the previous
+//   predictions) as an overlay, until _ReconcilePredictions() finds that the
+//   connection echoed it. Anything we can't reliably predict, like control
+//   characters, wide glyphs or a line wrap, throws away all predictions.
+// - The caller must hold the terminal lock.
+// Arguments:
+// - ch: The UTF-16 code unit the user typed.
+// Return Value:
+// - <none>
+void Terminal::_PredictCharacter(const wchar_t ch)
+{
+    const auto& cursor = _buffer->GetCursor();
+    const auto printable = ch >= L' ' && ch != L'\x7f' && !IS_SURROGATE(ch) && !IsGlyphFullWidth(ch);
+    const auto start = _predictedText.empty() ? cursor.GetPosition() : _predictionStart;
+    const auto predictedX = start.X + gsl::narrow_cast<SHORT>(_predictedText.size());
+
+    if (!printable || !cursor.IsVisible() || predictedX + 1 >= _buffer->GetSize().Width())
+    {
+        _ClearPredictions();
+        return;
+    }
+
+    _predictionStart = start;
+    _predictedText.push_back(ch);
+    _UpdatePredictionBuffer();
+}
+
+// Method Description:
+// - Compares our predictions with what the connection actually wrote. The
+//   leading predicted characters that now sit between the prediction's start
+//   and the cursor are confirmed and dropped. If the cursor isn't right after
+//   them, the application did something else with our input (a password
+//   prompt, a full screen application, ...) and all predictions are thrown
+//   away.
+// - The caller must hold the terminal lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Terminal::_ReconcilePredictions()
+{
+    if (_predictedText.empty())
+    {
+        return;
+    }
+
+    const auto cursorPos = _buffer->GetCursor().GetPosition();
+    if (cursorPos.Y != _predictionStart.Y || cursorPos.X < _predictionStart.X)
+    {
+        _ClearPredictions();
+        return;
+    }
+
+    const auto written = std::min<size_t>(cursorPos.X - _predictionStart.X, _predictedText.size());
+    size_t confirmed = 0;
+    while (confirmed < written)
+    {
+        const COORD pos{ gsl::narrow_cast<SHORT>(_predictionStart.X + confirmed), _predictionStart.Y };
+        const auto text = *_buffer->GetTextDataAt(pos);
+        if (text.size() != 1 || text.front() != til::at(_predictedText, confirmed))
+        {
+            break;
+        }
+        ++confirmed;
+    }
+
+    if (confirmed == 0 && written == 0)
+    {
+        // Nothing echoed yet. Redraw anyway, in case the output overwrote us.
+        _InvalidatePredictions();
+        return;
+    }
+
+    if (confirmed != written || confirmed == _predictedText.size())
+    {
+        _ClearPredictions();
+        return;
+    }
+
+    _InvalidatePredictions();
+    _predictedText.erase(0, confirmed);
+    _predictionStart.X += gsl::narrow_cast<SHORT>(confirmed);
+    _UpdatePredictionBuffer();
+}
+
+// Method Description:
+// - Throws away all predictions and erases them from the screen.
+// - The caller must hold the terminal lock.
+void Terminal::_ClearPredictions() noexcept
+{
+    if (!_predictedText.empty())
+    {
+        try
+        {
+            _InvalidatePredictions();
+        }
+        CATCH_LOG();
+        _predictedText.clear();
+    }
+    _predictionBuffer.reset();
+}
+
+// Method Description:
+// - Rebuilds the overlay buffer from _predictedText and invalidates it.
+//   The renderer paints an overlay row up to the end of the overlay's
+//   buffer, so the buffer is exactly as wide as the predicted text.
+void Terminal::_UpdatePredictionBuffer()
+{
+    const COORD size{ gsl::narrow_cast<SHORT>(_predictedText.size()), 1 };
+    _predictionBuffer = std::make_unique<TextBuffer>(size, _buffer->GetCurrentAttributes(), 0, _predictionRenderTarget);
+    _predictionBuffer->Write(OutputCellIterator{ _predictedText, _buffer->GetCurrentAttributes() }, { 0, 0 }, false);
+    _InvalidatePredictions();
+}
+
+void Terminal::_InvalidatePredictions()
+{
+    const auto width = gsl::narrow_cast<SHORT>(_predictedText.size());
+    _buffer->GetRenderTarget().TriggerRedraw(Viewport::FromDimensions(_predictionStart, width, 1));
+}
+
 // Method Description:
 // - Invalidates the regions described in the given pattern tree for the rendering purposes
 // Arguments:
@@ -841,13 +1134,15 @@ WORD Terminal::_TakeVirtualKeyFromLastKeyEvent(const WORD scanCode) noexcept
 }
 
 // Method Description:
-// - Acquire a read lock on the terminal.
+// - Acquire a read lock on the terminal. Any number of readers can hold it at
+//   once, so everything done under it must leave the terminal untouched.
+//   The renderer locks exclusively (see LockConsole), since painting updates caches.
 // Return Value:
 // - a shared_lock which can be used to unlock the terminal. The shared_lock
 //      will release this lock when it's destructed.
-[[nodiscard]] std::unique_lock<til::ticket_lock> Terminal::LockForReading()
+[[nodiscard]] std::shared_lock<til::shared_ticket_lock> Terminal::LockForReading()
 {
-    return std::unique_lock{ _readWriteLock };
+    return std::shared_lock{ _readWriteLock };
 }
 
 // Method Description:
@@ -855,7 +1150,7 @@ WORD Terminal::_TakeVirtualKeyFromLastKeyEvent(const WORD scanCode) noexcept
 // Return Value:
 // - a unique_lock which can be used to unlock the terminal. The unique_lock
 //      will release this lock when it's destructed.
-[[nodiscard]] std::unique_lock<til::ticket_lock> Terminal::LockForWriting()
+[[nodiscard]] std::unique_lock<til::shared_ticket_lock> Terminal::LockForWriting()
 {
     return std::unique_lock{ _readWriteLock };
 }
@@ -903,10 +1198,9 @@ Viewport Terminal::_GetVisibleViewport() const noexcept
 //      in accordance with the written text.
 // This method is our proverbial `WriteCharsLegacy`, and great care should be made to
 //      keep it minimal and orderly, lest it become WriteCharsLegacy2ElectricBoogaloo
-// TODO: MSFT 21006766
-//       This needs to become stream logic on the buffer itself sooner rather than later
-//       because it's otherwise impossible to avoid the Electric Boogaloo-ness here.
-//       I had to make a bunch of hacks to get Japanese and emoji to work-ish.
+// The text is written one row segment at a time: as much of it as fits in
+//      the rest of the cursor's row goes into a single WriteLine, and the
+//      cursor is adjusted once per segment rather than once per glyph.
 void Terminal::_WriteBuffer(const std::wstring_view& stringView)
 {
     auto& cursor = _buffer->GetCursor();
@@ -915,49 +1209,46 @@ void Terminal::_WriteBuffer(const std::wstring_view& stringView)
     // We can not waste time displaying a cursor event when we know more text is coming right behind it.
     cursor.StartDeferDrawing();
 
-    for (size_t i = 0; i < stringView.size(); i++)
+    // Similarly, tell the renderer about the cells we wrote once we're done,
+    // instead of after every single row.
+    _buffer->StartDeferPaint();
+    auto endDeferPaint = wil::scope_exit([&]() noexcept {
+        _buffer->EndDeferPaint();
+    });
+
+    size_t i = 0;
+    while (i < stringView.size())
     {
-        const auto wch = stringView.at(i);
         const COORD cursorPosBefore = cursor.GetPosition();
         COORD proposedCursorPosition = cursorPosBefore;
 
-        // TODO: MSFT 21006766
-        // This is not great but I need it demoable. Fix by making a buffer stream writer.
-        //
-        // If wch is a surrogate character we need to read 2 code units
-        // from the stringView to form a single code point.
-        const auto isSurrogate = wch >= 0xD800 && wch <= 0xDFFF;
-        const auto view = stringView.substr(i, isSurrogate ? 2 : 1);
-        const OutputCellIterator it{ view, _buffer->GetCurrentAttributes() };
-        const auto end = _buffer->Write(it);
+        // The iterator measures each glyph for us, so surrogate pairs and
+        // wide glyphs are never split. If a wide glyph would only have the
+        // last column of the row left, that column is padded and the glyph
+        // is left for the next row.
+        const OutputCellIterator it{ stringView.substr(i), _buffer->GetCurrentAttributes() };
+        const auto end = _buffer->WriteLine(it, cursorPosBefore, true);
         const auto cellDistance = end.GetCellDistance(it);
         const auto inputDistance = end.GetInputDistance(it);
 
         if (inputDistance > 0)
         {
-            // If "wch" was a surrogate character, we just consumed 2 code units above.
-            // -> Increment "i" by 1 in that case and thus by 2 in total in this iteration.
             proposedCursorPosition.X += gsl::narrow<SHORT>(cellDistance);
-            i += inputDistance - 1;
+            i += inputDistance;
         }
         else
         {
-            // If _WriteBuffer() is called with a consecutive string longer than the viewport/buffer width
-            // the call to _buffer->Write() will refuse to write anything on the current line.
-            // GetInputDistance() thus returns 0, which would in turn cause i to be
-            // decremented by 1 below and force the outer loop to loop forever.
-            // This if() basically behaves as if "\r\n" had been encountered above and retries the write.
-            // With well behaving shells during normal operation this safeguard should normally not be encountered.
+            // Nothing fit on the rest of this row, either because the cursor
+            // is already past its last column or because only a padded
+            // column was left. Behave as if "\r\n" had been encountered and
+            // retry the write on the next row.
             proposedCursorPosition.X = 0;
             proposedCursorPosition.Y++;
 
-            // Try the character again.
-            i--;
-
-            // If we write the last cell of the row here, TextBuffer::Write will
-            // mark this line as wrapped for us. If the next character we
-            // process is a newline, the Terminal::CursorLineFeed will unmark
-            // this line as wrapped.
+            // If we wrote the last cell of the row, WriteLine marked this
+            // line as wrapped for us. If the next character we process is a
+            // newline, the Terminal::CursorLineFeed will unmark this line as
+            // wrapped.
 
             // TODO: GH#780 - This should really be a _deferred_ newline. If
             // the next character to come in is a newline or a cursor
@@ -971,6 +1262,65 @@ void Terminal::_WriteBuffer(const std::wstring_view& stringView)
     cursor.EndDeferDrawing();
 }
 
+// Method Description:
+// - Writes count copies of wch to the buffer, with the same result as passing
+//   them to _WriteBuffer as a string, but without building and measuring a
+//   string of count copies first: each row is filled from a single cell.
+// - Only narrow characters can be written this way. They take up exactly one
+//   cell each, so they never need to be split across rows.
+// Arguments:
+// - wch: the character to repeat
+// - count: how many times to write it
+// Return Value:
+// - false if wch isn't a narrow character. Nothing was written in that case.
+bool Terminal::_WriteBufferRepeated(const wchar_t wch, const size_t count)
+{
+    if (wch < L' ' || IS_SURROGATE(wch) || IsGlyphFullWidth(wch))
+    {
+        return false;
+    }
+
+    auto& cursor = _buffer->GetCursor();
+    const auto width = _buffer->GetSize().Width();
+
+    cursor.StartDeferDrawing();
+    _buffer->StartDeferPaint();
+    auto endDeferPaint = wil::scope_exit([&]() noexcept {
+        _buffer->EndDeferPaint();
+    });
+
+    auto remaining = count;
+    while (remaining > 0)
+    {
+        auto proposedCursorPosition = cursor.GetPosition();
+        const auto cellsLeft = std::max(0, width - proposedCursorPosition.X);
+        const auto fill = std::min(remaining, gsl::narrow_cast<size_t>(cellsLeft));
+
+        const OutputCellIterator it{ wch, _buffer->GetCurrentAttributes(), fill };
+        const auto end = fill > 0 ? _buffer->WriteLine(it, proposedCursorPosition, true) : it;
+        const auto written = gsl::narrow_cast<size_t>(end.GetInputDistance(it));
+
+        if (written > 0)
+        {
+            proposedCursorPosition.X += gsl::narrow<SHORT>(end.GetCellDistance(it));
+            remaining -= written;
+        }
+        else
+        {
+            // The cursor is past the end of the row. Move to the next row and
+            // try again, the same as _WriteBuffer does. If we filled the row
+            // up to its last cell, WriteLine marked it as wrapped for us.
+            proposedCursorPosition.X = 0;
+            proposedCursorPosition.Y++;
+        }
+
+        _AdjustCursorPosition(proposedCursorPosition);
+    }
+
+    cursor.EndDeferDrawing();
+    return true;
+}
+
 void Terminal::_AdjustCursorPosition(const COORD proposedPosition)
 {
 #pragma warning(suppress : 26496) // cpp core checks wants this const but it's modified below.
@@ -1083,6 +1433,13 @@ int Terminal::GetScrollOffset() noexcept
 void Terminal::_NotifyScrollEvent() noexcept
 try
 {
+    if (_deferNotifications)
+    {
+        _scrollEventPending = true;
+        return;
+    }
+
+    _scrollEventPending = false;
     if (_pfnScrollPositionChanged)
     {
         const auto visible = _GetVisibleViewport();
@@ -1094,8 +1451,43 @@ try
 }
 CATCH_LOG()
 
+// Method Description:
+// - Repaints everything after the color table or the default colors changed.
+//   During Write(), this only notes the change, so that a script that sets
+//   the whole palette in one go causes a single redraw when the slice is done.
+// Arguments:
+// - backgroundChanged: true if the default background color was among them,
+//   so that the control updates its own background as well.
+void Terminal::_NotifyColorsChanged(const bool backgroundChanged) noexcept
+try
+{
+    _backgroundColorPending = _backgroundColorPending || backgroundChanged;
+    if (_deferNotifications)
+    {
+        _colorsChangedPending = true;
+        return;
+    }
+
+    _colorsChangedPending = false;
+    if (std::exchange(_backgroundColorPending, false) && _pfnBackgroundColorChanged)
+    {
+        _pfnBackgroundColorChanged(_defaultBg);
+    }
+
+    // Repaint everything - the colors might have changed
+    _buffer->GetRenderTarget().TriggerRedrawAll();
+}
+CATCH_LOG()
+
 void Terminal::_NotifyTerminalCursorPositionChanged() noexcept
 {
+    if (_deferNotifications)
+    {
+        _cursorPositionChangedPending = true;
+        return;
+    }
+
+    _cursorPositionChangedPending = false;
     if (_pfnCursorPositionChanged)
     {
         try
@@ -1106,7 +1498,7 @@ void Terminal::_NotifyTerminalCursorPositionChanged() noexcept
     }
 }
 
-void Terminal::SetWriteInputCallback(std::function<void(std::wstring&)> pfn) noexcept
+void Terminal::SetWriteInputCallback(std::function<void(std::wstring_view)> pfn) noexcept
 {
     _pfnWriteInput.swap(pfn);
 }
@@ -1217,6 +1609,51 @@ void Terminal::ClearPatternTree() noexcept
     _InvalidatePatternTree(oldTree);
 }
 
+// Method Description:
+// - Adds matches of the current search to be highlighted. Only the visible
+//   ones are painted, so this can hold every match in the buffer.
+// - INVARIANT: this function can only be called if the caller has the writing lock on the terminal
+// Arguments:
+// - highlights: the [start, end] buffer positions of the matches, in buffer
+//   order and after any matches that were added before.
+void Terminal::AddSearchHighlights(const std::vector<std::pair<COORD, COORD>>& highlights)
+{
+    const auto previousSize = _searchHighlights.size();
+    _searchHighlights.insert(_searchHighlights.end(), highlights.begin(), highlights.end());
+    _InvalidateVisibleSearchHighlights(_searchHighlights.cbegin() + previousSize, _searchHighlights.cend());
+}
+
+// Method Description:
+// - Removes all search highlights
+// - INVARIANT: this function can only be called if the caller has the writing lock on the terminal
+void Terminal::ClearSearchHighlights() noexcept
+{
+    try
+    {
+        _InvalidateVisibleSearchHighlights(_searchHighlights.cbegin(), _searchHighlights.cend());
+    }
+    CATCH_LOG();
+    _searchHighlights.clear();
+}
+
+// Method Description:
+// - Invalidates the given search highlights if they're in the visible region
+// Arguments:
+// - begin, end: the range of _searchHighlights to invalidate
+void Terminal::_InvalidateVisibleSearchHighlights(const std::vector<std::pair<COORD, COORD>>::const_iterator begin,
+                                                  const std::vector<std::pair<COORD, COORD>>::const_iterator end)
+{
+    const auto visibleStart = _VisibleStartIndex();
+    const auto visibleEnd = _VisibleEndIndex();
+    for (auto it = begin; it != end; ++it)
+    {
+        if (it->second.Y >= visibleStart && it->first.Y <= visibleEnd)
+        {
+            _InvalidateFromCoords(it->first, it->second);
+        }
+    }
+}
+
 // Method Description:
 // - Returns the tab color
 // If the starting color exits, it's value is preferred
@@ -9,6 +9,7 @@
 #include "../../buffer/out/textBuffer.hpp"
 #include "../../types/inc/sgrStack.hpp"
 #include "../../renderer/inc/BlinkingState.hpp"
+#include "../../renderer/inc/DummyRenderTarget.hpp"
 #include "../../terminal/parser/StateMachine.hpp"
 #include "../../terminal/input/terminalInput.hpp"
 
@@ -76,11 +77,28 @@ public:
     // Write goes through the parser
     void Write(std::wstring_view stringView);
 
+    // Histograms of how long Write() waited for and held the write lock.
+    // Bucket i counts durations below (64us << i), the last bucket everything beyond.
+    struct WriteLockStatistics
+    {
+        static constexpr size_t BucketCount = 8;
+        std::array<uint32_t, BucketCount> waitHistogram;
+        std::array<uint32_t, BucketCount> holdHistogram;
+        uint32_t slicesYielded;
+        // How many times anyone had to wait for the lock, exclusively or shared.
+        uint32_t exclusiveContentions;
+        uint32_t sharedContentions;
+    };
+
+    WriteLockStatistics GetWriteLockStatistics() const noexcept;
+
+    TextBuffer::MemoryUsage GetMemoryUsage() const noexcept;
+
     // WritePastedText goes directly to the connection
     void WritePastedText(std::wstring_view stringView);
 
-    [[nodiscard]] std::unique_lock<til::ticket_lock> LockForReading();
-    [[nodiscard]] std::unique_lock<til::ticket_lock> LockForWriting();
+    [[nodiscard]] std::shared_lock<til::shared_ticket_lock> LockForReading();
+    [[nodiscard]] std::unique_lock<til::shared_ticket_lock> LockForWriting();
 
     short GetBufferHeight() const noexcept;
 
@@ -90,6 +108,7 @@ public:
 #pragma region ITerminalApi
     // These methods are defined in TerminalApi.cpp
     bool PrintString(std::wstring_view stringView) noexcept override;
+    bool PrintRepeated(wchar_t wch, size_t count) noexcept override;
     bool ExecuteChar(wchar_t wch) noexcept override;
     TextAttribute GetTextAttributes() const noexcept override;
     void SetTextAttributes(const TextAttribute& attrs) noexcept override;
@@ -123,6 +142,7 @@ public:
     bool EnableAnyEventMouseMode(const bool enabled) noexcept override;
     bool EnableAlternateScrollMode(const bool enabled) noexcept override;
     bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override;
+    bool EnableSynchronizedOutput(const bool enabled) noexcept override;
     bool IsXtermBracketedPasteModeEnabled() const noexcept override;
 
     bool IsVtInputEnabled() const noexcept override;
@@ -157,6 +177,7 @@ public:
     std::wstring GetHyperlinkAtPosition(const COORD position);
     uint16_t GetHyperlinkIdAtPosition(const COORD position);
     std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> GetHyperlinkIntervalFromPosition(const COORD position);
+    void InvalidateHyperlink(const uint16_t id, const std::optional<interval_tree::IntervalTree<til::point, size_t>::interval>& interval);
 #pragma endregion
 
 #pragma region IBaseData(base to IRenderData and IUiaData)
@@ -187,6 +208,7 @@ public:
     const std::wstring GetHyperlinkUri(uint16_t id) const noexcept override;
     const std::wstring GetHyperlinkCustomId(uint16_t id) const noexcept override;
     const std::vector<size_t> GetPatternId(const COORD location) const noexcept override;
+    std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects() noexcept override;
 #pragma endregion
 
 #pragma region IUiaData
@@ -201,7 +223,7 @@ public:
     void ColorSelection(const COORD coordSelectionStart, const COORD coordSelectionEnd, const TextAttribute) override;
 #pragma endregion
 
-    void SetWriteInputCallback(std::function<void(std::wstring&)> pfn) noexcept;
+    void SetWriteInputCallback(std::function<void(std::wstring_view)> pfn) noexcept;
     void SetWarningBellCallback(std::function<void()> pfn) noexcept;
     void SetTitleChangedCallback(std::function<void(std::wstring_view)> pfn) noexcept;
     void SetTabColorChangedCallback(std::function<void(const std::optional<til::color>)> pfn) noexcept;
@@ -217,6 +239,9 @@ public:
     void UpdatePatternsUnderLock() noexcept;
     void ClearPatternTree() noexcept;
 
+    void AddSearchHighlights(const std::vector<std::pair<COORD, COORD>>& highlights);
+    void ClearSearchHighlights() noexcept;
+
     const std::optional<til::color> GetTabColor() const noexcept;
     til::color GetDefaultBackground() const noexcept;
 
@@ -242,7 +267,7 @@ public:
 #pragma endregion
 
 private:
-    std::function<void(std::wstring&)> _pfnWriteInput;
+    std::function<void(std::wstring_view)> _pfnWriteInput;
     std::function<void()> _pfnWarningBell;
     std::function<void(std::wstring_view)> _pfnTitleChanged;
     std::function<void(std::wstring_view)> _pfnCopyToClipboard;
@@ -253,7 +278,18 @@ private:
     //
     // But we can abuse the fact that the surrounding members rarely change and are huge
     // (std::function is like 64 bytes) to create some natural padding without wasting space.
-    til::ticket_lock _readWriteLock;
+    til::shared_ticket_lock _readWriteLock;
+    WriteLockStatistics _writeLockStatistics{};
+    static constexpr size_t WriteSliceSize = 16 * 1024;
+    static constexpr auto WriteSliceDuration = std::chrono::milliseconds(2);
+    // While Write() processes a slice, scroll notifications, cursor moves and
+    // color changes are only noted here and sent once at the end of it,
+    // instead of once for every line of output or every palette entry.
+    bool _deferNotifications{ false };
+    bool _scrollEventPending{ false };
+    bool _cursorPositionChangedPending{ false };
+    bool _colorsChangedPending{ false };
+    bool _backgroundColorPending{ false };
 
     std::function<void(const int, const int, const int)> _pfnScrollPositionChanged;
     std::function<void(const til::color)> _pfnBackgroundColorChanged;
@@ -279,6 +315,7 @@ private:
 
     bool _snapOnInput;
     bool _altGrAliasing;
+    bool _predictiveEcho;
     bool _suppressApplicationTitle;
     bool _bracketedPasteMode;
     bool _trimBlockSelection;
@@ -288,6 +325,15 @@ private:
 
     size_t _hyperlinkPatternId;
 
+    // Characters typed by the user that haven't been echoed by the
+    // connection yet. They're drawn at _predictionStart (a buffer position)
+    // as an overlay, from the single row _predictionBuffer, until the echo
+    // arrives and replaces them.
+    std::wstring _predictedText;
+    COORD _predictionStart{};
+    std::unique_ptr<TextBuffer> _predictionBuffer;
+    DummyRenderTarget _predictionRenderTarget;
+
     std::wstring _workingDirectory;
 
     // This default fake font value is only used to check if the font is a raster font.
@@ -306,6 +352,8 @@ private:
     };
     std::optional<SelectionAnchors> _selection;
     bool _blockSelection;
+    // The selection is redrawn every frame, but its rows rarely change from one to the next.
+    mutable TextBuffer::TextRectsCache _selectionRectsCache;
     std::wstring _wordDelimiters;
     SelectionExpansionMode _multiClickSelectionMode;
 #pragma endregion
@@ -336,6 +384,11 @@ private:
     void _InvalidatePatternTree(interval_tree::IntervalTree<til::point, size_t>& tree);
     void _InvalidateFromCoords(const COORD start, const COORD end);
 
+    // The [start, end] buffer positions of every match of the current search, in buffer order.
+    std::vector<std::pair<COORD, COORD>> _searchHighlights;
+    void _InvalidateVisibleSearchHighlights(const std::vector<std::pair<COORD, COORD>>::const_iterator begin,
+                                            const std::vector<std::pair<COORD, COORD>>::const_iterator end);
+
     // Since virtual keys are non-zero, you assume that this field is empty/invalid if it is.
     struct KeyEventCodes
     {
@@ -361,10 +414,19 @@ private:
     void _InitializeColorTable();
 
     void _WriteBuffer(const std::wstring_view& stringView);
+    bool _WriteBufferRepeated(const wchar_t wch, const size_t count);
+    static void _RecordWriteLockDuration(std::array<uint32_t, WriteLockStatistics::BucketCount>& histogram, const std::chrono::steady_clock::duration duration) noexcept;
 
     void _AdjustCursorPosition(const COORD proposedPosition);
 
+    void _PredictCharacter(const wchar_t ch);
+    void _ReconcilePredictions();
+    void _ClearPredictions() noexcept;
+    void _UpdatePredictionBuffer();
+    void _InvalidatePredictions();
+
     void _NotifyScrollEvent() noexcept;
+    void _NotifyColorsChanged(const bool backgroundChanged) noexcept;
 
     void _NotifyTerminalCursorPositionChanged() noexcept;
 
@@ -18,6 +18,14 @@ try
 }
 CATCH_RETURN_FALSE()
 
+// PrintRepeated puts count copies of wch in the buffer, a row at a time
+bool Terminal::PrintRepeated(wchar_t wch, size_t count) noexcept
+try
+{
+    return _WriteBufferRepeated(wch, count);
+}
+CATCH_RETURN_FALSE()
+
 bool Terminal::ExecuteChar(wchar_t wch) noexcept
 try
 {
@@ -116,37 +124,22 @@ CATCH_RETURN_FALSE()
 bool Terminal::DeleteCharacter(const size_t count) noexcept
 try
 {
-    SHORT dist;
-    if (!SUCCEEDED(SizeTToShort(count, &dist)))
-    {
-        return false;
-    }
     const auto cursorPos = _buffer->GetCursor().GetPosition();
-    const auto copyToPos = cursorPos;
-    const COORD copyFromPos{ cursorPos.X + dist, cursorPos.Y };
-    const auto sourceWidth = _mutableViewport.RightExclusive() - copyFromPos.X;
-    SHORT width;
-    if (!SUCCEEDED(UIntToShort(sourceWidth, &width)))
+    const auto remaining = gsl::narrow_cast<size_t>(std::max(0, _mutableViewport.RightExclusive() - cursorPos.X));
+    const auto dist = std::min(count, remaining);
+    if (dist == 0)
     {
-        return false;
+        return true;
     }
 
-    // Get a rectangle of the source
-    auto source = Viewport::FromDimensions(copyFromPos, width, 1);
-
-    // Get a rectangle of the target
-    const auto target = Viewport::FromDimensions(copyToPos, source.Dimensions());
-    const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-
-    auto sourcePos = source.GetWalkOrigin(walkDirection);
-    auto targetPos = target.GetWalkOrigin(walkDirection);
-
-    // Iterate over the source cell data and copy it over to the target
-    do
+    // Shift the rest of the line over in one go and blank what's revealed at its end.
+    const COORD copyFromPos{ gsl::narrow_cast<SHORT>(cursorPos.X + dist), cursorPos.Y };
+    if (dist < remaining)
     {
-        const auto data = OutputCell(*(_buffer->GetCellDataAt(sourcePos)));
-        _buffer->Write(OutputCellIterator({ &data, 1 }), targetPos);
-    } while (source.WalkInBounds(sourcePos, walkDirection) && target.WalkInBounds(targetPos, walkDirection));
+        _buffer->MoveCells(copyFromPos, remaining - dist, cursorPos.X);
+    }
+    const COORD fillPos{ gsl::narrow_cast<SHORT>(_mutableViewport.RightExclusive() - dist), cursorPos.Y };
+    _buffer->FillCells(fillPos, dist, _buffer->GetCurrentAttributes());
 
     return true;
 }
@@ -164,44 +157,20 @@ CATCH_RETURN_FALSE()
 bool Terminal::InsertCharacter(const size_t count) noexcept
 try
 {
-    // NOTE: the code below is _extremely_ similar to DeleteCharacter
-    // We will want to use this same logic and implement a helper function instead
-    // that does the 'move a region from here to there' operation
-    // TODO: Github issue #2163
-    SHORT dist;
-    if (!SUCCEEDED(SizeTToShort(count, &dist)))
-    {
-        return false;
-    }
     const auto cursorPos = _buffer->GetCursor().GetPosition();
-    const auto copyFromPos = cursorPos;
-    const COORD copyToPos{ cursorPos.X + dist, cursorPos.Y };
-    const auto sourceWidth = _mutableViewport.RightExclusive() - copyFromPos.X;
-    SHORT width;
-    if (!SUCCEEDED(UIntToShort(sourceWidth, &width)))
+    const auto remaining = gsl::narrow_cast<size_t>(std::max(0, _mutableViewport.RightExclusive() - cursorPos.X));
+    const auto dist = std::min(count, remaining);
+    if (dist == 0)
     {
-        return false;
+        return true;
     }
 
-    // Get a rectangle of the source
-    auto source = Viewport::FromDimensions(copyFromPos, width, 1);
-    const auto sourceOrigin = source.Origin();
-
-    // Get a rectangle of the target
-    const auto target = Viewport::FromDimensions(copyToPos, source.Dimensions());
-    const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-
-    auto sourcePos = source.GetWalkOrigin(walkDirection);
-    auto targetPos = target.GetWalkOrigin(walkDirection);
-
-    // Iterate over the source cell data and copy it over to the target
-    do
+    // Shift the rest of the line over in one go (dropping what falls off its end) and blank the gap.
+    if (dist < remaining)
     {
-        const auto data = OutputCell(*(_buffer->GetCellDataAt(sourcePos)));
-        _buffer->Write(OutputCellIterator({ &data, 1 }), targetPos);
-    } while (source.WalkInBounds(sourcePos, walkDirection) && target.WalkInBounds(targetPos, walkDirection));
-    const auto eraseIter = OutputCellIterator(UNICODE_SPACE, _buffer->GetCurrentAttributes(), dist);
-    _buffer->Write(eraseIter, cursorPos);
+        _buffer->MoveCells(cursorPos, remaining - dist, gsl::narrow_cast<SHORT>(cursorPos.X + dist));
+    }
+    _buffer->FillCells(cursorPos, dist, _buffer->GetCurrentAttributes());
 
     return true;
 }
@@ -211,11 +180,7 @@ bool Terminal::EraseCharacters(const size_t numChars) noexcept
 try
 {
     const auto absoluteCursorPos = _buffer->GetCursor().GetPosition();
-    const auto viewport = _GetMutableViewport();
-    const short distanceToRight = viewport.RightExclusive() - absoluteCursorPos.X;
-    const short fillLimit = std::min(static_cast<short>(numChars), distanceToRight);
-    const auto eraseIter = OutputCellIterator(UNICODE_SPACE, _buffer->GetCurrentAttributes(), fillLimit);
-    _buffer->Write(eraseIter, absoluteCursorPos);
+    _buffer->FillCells(absoluteCursorPos, numChars, _buffer->GetCurrentAttributes());
     return true;
 }
 CATCH_RETURN_FALSE()
@@ -304,10 +269,10 @@ try
 
         // Increment the circular buffer only if the new location of the viewport would be 'below' the buffer
         const short delta = (sNewTop + _mutableViewport.Height()) - (_buffer->GetSize().Height());
-        for (auto i = 0; i < delta; i++)
+        if (delta > 0)
         {
-            _buffer->IncrementCircularBuffer();
-            sNewTop--;
+            _buffer->AdvanceCircularBuffer(delta);
+            sNewTop -= delta;
         }
 
         newWin.Top = sNewTop;
@@ -322,13 +287,9 @@ try
         _buffer->ScrollRows(scrollFromPos.Y, _mutableViewport.Height(), -scrollFromPos.Y);
 
         // Since we only did a rotation, the text that was in the scrollback is now _below_ where we are going to move the viewport
-        // and we have to make sure we erase that text
-        const auto eraseStart = _mutableViewport.Height();
-        const auto eraseEnd = _buffer->GetLastNonSpaceCharacter(_mutableViewport).Y;
-        for (SHORT i = eraseStart; i <= eraseEnd; i++)
-        {
-            _buffer->GetRowByOffset(i).Reset(_buffer->GetCurrentAttributes());
-        }
+        // and we have to make sure we erase that text. Release those rows altogether, so that the memory
+        // they took up is given back until the scrollback fills up again.
+        _buffer->ReleaseRows(_mutableViewport.Height(), _buffer->GetCurrentAttributes());
 
         // Reset the scroll offset now because there's nothing for the user to 'scroll' to
         _scrollOffset = 0;
@@ -382,9 +343,7 @@ bool Terminal::SetColorTableEntry(const size_t tableIndex, const COLORREF color)
 try
 {
     _colorTable.at(tableIndex) = color;
-
-    // Repaint everything - the colors might have changed
-    _buffer->GetRenderTarget().TriggerRedrawAll();
+    _NotifyColorsChanged(false);
     return true;
 }
 CATCH_RETURN_FALSE()
@@ -452,9 +411,7 @@ bool Terminal::SetDefaultForeground(const COLORREF color) noexcept
 try
 {
     _defaultFg = color;
-
-    // Repaint everything - the colors might have changed
-    _buffer->GetRenderTarget().TriggerRedrawAll();
+    _NotifyColorsChanged(false);
     return true;
 }
 CATCH_RETURN_FALSE()
@@ -469,10 +426,7 @@ bool Terminal::SetDefaultBackground(const COLORREF color) noexcept
 try
 {
     _defaultBg = color;
-    _pfnBackgroundColorChanged(color);
-
-    // Repaint everything - the colors might have changed
-    _buffer->GetRenderTarget().TriggerRedrawAll();
+    _NotifyColorsChanged(true);
     return true;
 }
 CATCH_RETURN_FALSE()
@@ -547,6 +501,12 @@ bool Terminal::EnableAlternateScrollMode(const bool enabled) noexcept
     return true;
 }
 
+bool Terminal::EnableSynchronizedOutput(const bool enabled) noexcept
+{
+    _buffer->GetRenderTarget().SynchronizedOutputChanged(enabled);
+    return true;
+}
+
 bool Terminal::EnableXtermBracketedPasteMode(const bool enabled) noexcept
 {
     _bracketedPasteMode = enabled;
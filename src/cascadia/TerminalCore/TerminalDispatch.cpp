@@ -33,6 +33,11 @@ void TerminalDispatch::PrintString(const std::wstring_view string) noexcept
     _terminalApi.PrintString(string);
 }
 
+bool TerminalDispatch::RepeatCharacter(const wchar_t wchPrintable, const size_t count) noexcept
+{
+    return _terminalApi.PrintRepeated(wchPrintable, count);
+}
+
 bool TerminalDispatch::CursorPosition(const size_t line,
                                       const size_t column) noexcept
 try
@@ -439,6 +444,19 @@ bool TerminalDispatch::EnableAlternateScroll(const bool enabled) noexcept
     return true;
 }
 
+//Routine Description:
+// Enable Synchronized Output Mode - While set, the renderer holds back frames
+//      so that an application's redraw is presented all at once.
+//Arguments:
+// - enabled - true to start a synchronized update, false to end it.
+// Return value:
+// True if handled successfully. False otherwise.
+bool TerminalDispatch::EnableSynchronizedOutput(const bool enabled) noexcept
+{
+    _terminalApi.EnableSynchronizedOutput(enabled);
+    return true;
+}
+
 //Routine Description:
 // Enable Bracketed Paste Mode -  this changes the behavior of pasting.
 //      See: https://www.xfree86.org/current/ctlseqs.html#Bracketed%20Paste%20Mode
@@ -607,6 +625,9 @@ bool TerminalDispatch::_ModeParamsHelper(const DispatchTypes::ModeParams param,
     case DispatchTypes::ModeParams::XTERM_BracketedPasteMode:
         success = EnableXtermBracketedPasteMode(enable);
         break;
+    case DispatchTypes::ModeParams::SO_SynchronizedOutput:
+        success = EnableSynchronizedOutput(enable);
+        break;
     case DispatchTypes::ModeParams::W32IM_Win32InputMode:
         success = EnableWin32InputMode(enable);
         break;
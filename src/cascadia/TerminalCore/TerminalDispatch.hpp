@@ -3,6 +3,7 @@
 
 #include "../../terminal/adapter/termDispatch.hpp"
 #include "ITerminalApi.hpp"
+#include "../../types/inc/sgrCache.hpp"
 
 static constexpr size_t TaskbarMaxState{ 4 };
 static constexpr size_t TaskbarMaxProgress{ 100 };
@@ -15,6 +16,7 @@ public:
     void Execute(const wchar_t wchControl) noexcept override;
     void Print(const wchar_t wchPrintable) noexcept override;
     void PrintString(const std::wstring_view string) noexcept override;
+    bool RepeatCharacter(const wchar_t wchPrintable, const size_t count) noexcept override; // REP
 
     bool SetGraphicsRendition(const ::Microsoft::Console::VirtualTerminal::VTParameters options) noexcept override;
 
@@ -72,6 +74,7 @@ public:
     bool EnableAnyEventMouseMode(const bool enabled) noexcept override; // ?1003
     bool EnableAlternateScroll(const bool enabled) noexcept override; // ?1007
     bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override; // ?2004
+    bool EnableSynchronizedOutput(const bool enabled) noexcept override; // ?2026
 
     bool SetMode(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::ModeParams /*param*/) noexcept override; // DECSET
     bool ResetMode(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::ModeParams /*param*/) noexcept override; // DECRST
@@ -87,6 +90,8 @@ private:
     std::vector<bool> _tabStopColumns;
     bool _initDefaultTabStops = true;
 
+    ::Microsoft::Console::VirtualTerminal::SgrCache _sgrCache;
+
     size_t _SetRgbColorsHelper(const ::Microsoft::Console::VirtualTerminal::VTParameters options,
                                TextAttribute& attr,
                                const bool isForeground) noexcept;
@@ -94,6 +94,15 @@ bool TerminalDispatch::SetGraphicsRendition(const VTParameters options) noexcept
 {
     TextAttribute attr = _terminalApi.GetTextAttributes();
 
+    // Applications repeat the same few SGR sequences over and over, so
+    // check whether we already know what this one does to these attributes.
+    const auto before = attr;
+    if (_sgrCache.TryLookup(before, options, attr))
+    {
+        _terminalApi.SetTextAttributes(attr);
+        return true;
+    }
+
     // Run through the graphics options and apply them
     for (size_t i = 0; i < options.size(); i++)
     {
@@ -272,6 +281,7 @@ bool TerminalDispatch::SetGraphicsRendition(const VTParameters options) noexcept
             break;
         }
     }
+    _sgrCache.Store(before, options, attr);
 
     _terminalApi.SetTextAttributes(attr);
     return true;
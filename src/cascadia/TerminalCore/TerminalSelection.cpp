@@ -54,7 +54,7 @@ std::vector<SMALL_RECT> Terminal::_GetSelectionRects() const noexcept
 
     try
     {
-        return _buffer->GetTextRects(_selection->start, _selection->end, _blockSelection, false);
+        return _buffer->GetTextRects(_selection->start, _selection->end, _blockSelection, false, &_selectionRectsCache);
     }
     CATCH_LOG();
     return result;
@@ -251,7 +251,8 @@ void Terminal::ClearSelection()
 // - wstring text from buffer. If extended to multiple lines, each line is separated by \r\n
 const TextBuffer::TextAndColor Terminal::RetrieveSelectedTextFromBuffer(bool singleLine)
 {
-    auto lock = LockForReading();
+    // Not LockForReading: _GetSelectionRects updates the selection rects cache.
+    auto lock = LockForWriting();
 
     const auto selectionRects = _GetSelectionRects();
 
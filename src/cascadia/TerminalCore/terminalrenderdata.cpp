@@ -107,7 +107,27 @@ bool Terminal::IsCursorDoubleWidth() const
 }
 
 const std::vector<RenderOverlay> Terminal::GetOverlays() const noexcept
+try
+{
+    if (!_predictionBuffer || _predictedText.empty())
+    {
+        return {};
+    }
+
+    // The overlay's origin is relative to the visible viewport.
+    const auto viewport = _GetVisibleViewport();
+    const COORD origin{ _predictionStart.X, gsl::narrow_cast<SHORT>(_predictionStart.Y - viewport.Top()) };
+    if (origin.Y < 0 || origin.Y >= viewport.Height())
+    {
+        return {};
+    }
+
+    const auto right = gsl::narrow_cast<SHORT>(_predictedText.size());
+    return { RenderOverlay{ *_predictionBuffer, origin, Viewport::FromInclusive({ 0, 0, right, 1 }) } };
+}
+catch (...)
 {
+    LOG_CAUGHT_EXCEPTION();
     return {};
 }
 
@@ -152,6 +172,45 @@ const std::vector<size_t> Terminal::GetPatternId(const COORD location) const noe
     return {};
 }
 
+// Method Description:
+// - Gets the rectangles of the search matches that are in the visible region
+// Return value:
+// - The rectangles to highlight, in buffer coordinates
+std::vector<Microsoft::Console::Types::Viewport> Terminal::GetSearchHighlightRects() noexcept
+try
+{
+    std::vector<Viewport> result;
+
+    const auto visibleStart = _VisibleStartIndex();
+    const auto visibleEnd = _VisibleEndIndex();
+
+    // The highlights are sorted by where they start. Find the first one that
+    // starts in the viewport, then step back over any that start above it but
+    // wrap down into it.
+    auto it = std::lower_bound(_searchHighlights.cbegin(), _searchHighlights.cend(), visibleStart, [](const auto& highlight, const int row) {
+        return highlight.first.Y < row;
+    });
+    while (it != _searchHighlights.cbegin() && std::prev(it)->second.Y >= visibleStart)
+    {
+        --it;
+    }
+
+    for (; it != _searchHighlights.cend() && it->first.Y <= visibleEnd; ++it)
+    {
+        for (const auto& lineRect : _buffer->GetTextRects(it->first, it->second, false, false))
+        {
+            result.emplace_back(Viewport::FromInclusive(lineRect));
+        }
+    }
+
+    return result;
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    return {};
+}
+
 std::vector<Microsoft::Console::Types::Viewport> Terminal::GetSelectionRects() noexcept
 try
 {
@@ -209,11 +209,16 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
     {
         if (Appearance())
         {
+            // Hand the list all the schemes at once, so that the combo box
+            // bound to it is only told about the change once.
             const auto& colorSchemeMap{ Appearance().Schemes() };
+            std::vector<ColorScheme> colorSchemes;
+            colorSchemes.reserve(colorSchemeMap.Size());
             for (const auto& pair : colorSchemeMap)
             {
-                _ColorSchemeList.Append(pair.Value());
+                colorSchemes.push_back(pair.Value());
             }
+            _ColorSchemeList.ReplaceAll(colorSchemes);
 
             const auto& biAlignmentVal{ static_cast<int32_t>(Appearance().BackgroundImageAlignment()) };
             for (const auto& biButton : _BIAlignmentButtons)
@@ -206,11 +206,16 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
     {
         // Surprisingly, though this is called every time we navigate to the page,
         // the list does not keep growing on each navigation.
+        // All the schemes are handed over at once, so that the controls bound
+        // to the list are only told about the change once.
         const auto& colorSchemeMap{ _State.Settings().GlobalSettings().ColorSchemes() };
+        std::vector<Model::ColorScheme> colorSchemes;
+        colorSchemes.reserve(colorSchemeMap.Size());
         for (const auto& pair : colorSchemeMap)
         {
-            _ColorSchemeList.Append(pair.Value());
+            colorSchemes.push_back(pair.Value());
         }
+        _ColorSchemeList.ReplaceAll(colorSchemes);
     }
 
     // Function Description:
@@ -71,6 +71,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
     {
         _settingsSource = settings;
         _settingsClone = settings.Copy();
+        _profileViewModels.clear();
 
         // Deduce information about the currently selected item
         IInspectable selectedItemTag;
@@ -101,7 +102,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                     {
                         if (const auto& tag{ navViewItem.Tag() })
                         {
-                            if (tag.try_as<Editor::ProfileViewModel>())
+                            if (tag.try_as<Model::Profile>())
                             {
                                 // remove NavViewItem pointing to a Profile
                                 return true;
@@ -151,15 +152,15 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                                 }
                             }
                         }
-                        else if (const auto& profileTag{ tag.try_as<ProfileViewModel>() })
+                        else if (const auto& profileTag{ tag.try_as<Model::Profile>() })
                         {
-                            if (const auto& selectedItemProfileTag{ selectedItemTag.try_as<ProfileViewModel>() })
+                            if (const auto& selectedItemProfileTag{ selectedItemTag.try_as<Model::Profile>() })
                             {
-                                if (profileTag->OriginalProfileGuid() == selectedItemProfileTag->OriginalProfileGuid())
+                                if (profileTag.Guid() == selectedItemProfileTag.Guid())
                                 {
                                     // found the one that was selected before the refresh
                                     SettingsNav().SelectedItem(item);
-                                    _Navigate(*profileTag);
+                                    _Navigate(_ProfileViewModelForNavItem(menuItem));
                                     return;
                                 }
                             }
@@ -269,10 +270,13 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
             {
                 _Navigate(*navString);
             }
-            else if (const auto profile = clickedItemContainer.Tag().try_as<Editor::ProfileViewModel>())
+            else if (const auto profileNavItem = clickedItemContainer.try_as<MUX::Controls::NavigationViewItem>())
             {
                 // Navigate to a page with the given profile
-                _Navigate(profile);
+                if (const auto profile = _ProfileViewModelForNavItem(profileNavItem))
+                {
+                    _Navigate(profile);
+                }
             }
         }
     }
@@ -393,7 +397,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         // profile changes.
         for (const auto& profile : _settingsClone.AllProfiles())
         {
-            auto navItem = _CreateProfileNavViewItem(_viewModelForProfile(profile, _settingsClone));
+            auto navItem = _CreateProfileNavViewItem(profile);
             SettingsNav().MenuItems().Append(navItem);
         }
 
@@ -413,46 +417,80 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
     void MainPage::_CreateAndNavigateToNewProfile(const uint32_t index, const Model::Profile& profile)
     {
         const auto newProfile{ profile ? profile : _settingsClone.CreateNewProfile() };
-        const auto profileViewModel{ _viewModelForProfile(newProfile, _settingsClone) };
-        const auto navItem{ _CreateProfileNavViewItem(profileViewModel) };
+        const auto navItem{ _CreateProfileNavViewItem(newProfile) };
         SettingsNav().MenuItems().InsertAt(index, navItem);
 
         // Select and navigate to the new profile
         SettingsNav().SelectedItem(navItem);
-        _Navigate(profileViewModel);
+        _Navigate(_ProfileViewModelForNavItem(navItem));
     }
 
-    MUX::Controls::NavigationViewItem MainPage::_CreateProfileNavViewItem(const Editor::ProfileViewModel& profile)
+    // Method Description:
+    // - Creates the nav item for a profile. Its Tag is the profile itself. The
+    //   profile's view model isn't created until it's navigated to (see
+    //   _ProfileViewModelForNavItem), so that opening the settings UI doesn't
+    //   pay for a view model per profile.
+    MUX::Controls::NavigationViewItem MainPage::_CreateProfileNavViewItem(const Model::Profile& profile)
     {
         MUX::Controls::NavigationViewItem profileNavItem;
         profileNavItem.Content(box_value(profile.Name()));
-        profileNavItem.Tag(box_value<Editor::ProfileViewModel>(profile));
+        profileNavItem.Tag(profile);
 
         const auto iconSource{ IconPathConverter::IconSourceWUX(profile.Icon()) };
         WUX::Controls::IconSourceElement icon;
         icon.IconSource(iconSource);
         profileNavItem.Icon(icon);
 
+        return profileNavItem;
+    }
+
+    // Method Description:
+    // - Gets the view model of the profile that's the Tag of navItem, creating
+    //   it the first time it's asked for.
+    // Arguments:
+    // - navItem - a nav item created by _CreateProfileNavViewItem
+    // Return Value:
+    // - The view model, or nullptr if navItem isn't a profile's nav item.
+    Editor::ProfileViewModel MainPage::_ProfileViewModelForNavItem(const MUX::Controls::NavigationViewItem& navItem)
+    {
+        const auto profile{ navItem.Tag().try_as<Model::Profile>() };
+        if (!profile)
+        {
+            return nullptr;
+        }
+
+        const auto guid{ profile.Guid() };
+        if (const auto it{ _profileViewModels.find(guid) }; it != _profileViewModels.end())
+        {
+            return it->second;
+        }
+
+        const auto profileViewModel{ _viewModelForProfile(profile, _settingsClone) };
+
         // Update the menu item when the icon/name changes
-        auto weakMenuItem{ make_weak(profileNavItem) };
-        profile.PropertyChanged([weakMenuItem](const auto&, const WUX::Data::PropertyChangedEventArgs& args) {
-            if (auto menuItem{ weakMenuItem.get() })
+        auto weakMenuItem{ make_weak(navItem) };
+        auto weakViewModel{ make_weak(profileViewModel) };
+        profileViewModel.PropertyChanged([weakMenuItem, weakViewModel](const auto&, const WUX::Data::PropertyChangedEventArgs& args) {
+            auto menuItem{ weakMenuItem.get() };
+            auto viewModel{ weakViewModel.get() };
+            if (menuItem && viewModel)
             {
-                const auto& tag{ menuItem.Tag().as<Editor::ProfileViewModel>() };
                 if (args.PropertyName() == L"Icon")
                 {
-                    const auto iconSource{ IconPathConverter::IconSourceWUX(tag.Icon()) };
+                    const auto iconSource{ IconPathConverter::IconSourceWUX(viewModel.Icon()) };
                     WUX::Controls::IconSourceElement icon;
                     icon.IconSource(iconSource);
                     menuItem.Icon(icon);
                 }
                 else if (args.PropertyName() == L"Name")
                 {
-                    menuItem.Content(box_value(tag.Name()));
+                    menuItem.Content(box_value(viewModel.Name()));
                 }
             }
         });
-        return profileNavItem;
+
+        _profileViewModels.emplace(guid, profileViewModel);
+        return profileViewModel;
     }
 
     void MainPage::_DeleteProfile(const IInspectable /*sender*/, const Editor::DeleteProfileEventArgs& args)
@@ -468,6 +506,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
                 break;
             }
         }
+        _profileViewModels.erase(guid);
 
         // remove selected item
         uint32_t index;
@@ -479,7 +518,7 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
         // navigate to the profile next to this one
         const auto newSelectedItem{ menuItems.GetAt(index < menuItems.Size() - 1 ? index : index - 1) };
         SettingsNav().SelectedItem(newSelectedItem);
-        _Navigate(newSelectedItem.try_as<MUX::Controls::NavigationViewItem>().Tag().try_as<Editor::ProfileViewModel>());
+        _Navigate(_ProfileViewModelForNavItem(newSelectedItem.as<MUX::Controls::NavigationViewItem>()));
     }
 
     bool MainPage::ShowBaseLayerMenuItem() const noexcept
@@ -38,7 +38,8 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
 
         void _InitializeProfilesList();
         void _CreateAndNavigateToNewProfile(const uint32_t index, const Model::Profile& profile);
-        winrt::Microsoft::UI::Xaml::Controls::NavigationViewItem _CreateProfileNavViewItem(const Editor::ProfileViewModel& profile);
+        winrt::Microsoft::UI::Xaml::Controls::NavigationViewItem _CreateProfileNavViewItem(const Model::Profile& profile);
+        Editor::ProfileViewModel _ProfileViewModelForNavItem(const winrt::Microsoft::UI::Xaml::Controls::NavigationViewItem& navItem);
         void _DeleteProfile(const Windows::Foundation::IInspectable sender, const Editor::DeleteProfileEventArgs& args);
         void _AddProfileHandler(const winrt::guid profileGuid);
 
@@ -47,6 +48,11 @@ namespace winrt::Microsoft::Terminal::Settings::Editor::implementation
 
         winrt::Microsoft::Terminal::Settings::Editor::ColorSchemesPageNavigationState _colorSchemesNavState{ nullptr };
         winrt::Microsoft::Terminal::Settings::Editor::ProfilePageNavigationState _lastProfilesNavState{ nullptr };
+
+        // The view models of the profiles that have been navigated to so far.
+        // The others only have a nav item, and get their view model when
+        // they're first navigated to.
+        std::unordered_map<winrt::guid, Editor::ProfileViewModel> _profileViewModels;
     };
 }
 
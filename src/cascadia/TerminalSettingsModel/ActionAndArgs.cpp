@@ -64,6 +64,9 @@ static constexpr std::string_view OpenWindowRenamerKey{ "openWindowRenamer" };
 static constexpr std::string_view GlobalSummonKey{ "globalSummon" };
 static constexpr std::string_view QuakeModeKey{ "quakeMode" };
 static constexpr std::string_view FocusPaneKey{ "focusPane" };
+static constexpr std::string_view ToggleRenderStatisticsKey{ "toggleRenderStatistics" };
+static constexpr std::string_view ExportBufferKey{ "exportBuffer" };
+static constexpr std::string_view ReportMemoryUsageKey{ "reportMemoryUsage" };
 
 static constexpr std::string_view ActionKey{ "action" };
 
@@ -364,6 +367,9 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
                 { ShortcutAction::GlobalSummon, L"" }, // Intentionally omitted, must be generated by GenerateName
                 { ShortcutAction::QuakeMode, RS_(L"QuakeModeCommandKey") },
                 { ShortcutAction::FocusPane, L"" }, // Intentionally omitted, must be generated by GenerateName
+                { ShortcutAction::ToggleRenderStatistics, RS_(L"ToggleRenderStatisticsCommandKey") },
+                { ShortcutAction::ExportBuffer, L"" }, // Intentionally omitted, must be generated by GenerateName
+                { ShortcutAction::ReportMemoryUsage, RS_(L"ReportMemoryUsageCommandKey") },
             };
         }();
 
@@ -33,6 +33,7 @@
 #include "RenameWindowArgs.g.cpp"
 #include "GlobalSummonArgs.g.cpp"
 #include "FocusPaneArgs.g.cpp"
+#include "ExportBufferArgs.g.cpp"
 
 #include <LibraryResources.h>
 
@@ -665,4 +666,26 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
                         Id())
         };
     }
+
+    winrt::hstring ExportBufferArgs::GenerateName() const
+    {
+        // "Export text"
+        // "Export text to {Path}"
+        // ..., followed by ", with colors" if the attributes are included.
+        std::wstringstream ss;
+        if (Path().empty())
+        {
+            ss << std::wstring_view(RS_(L"ExportBufferCommandKey"));
+        }
+        else
+        {
+            ss << fmt::format(std::wstring_view(RS_(L"ExportBufferToPathCommandKey")), Path().c_str());
+        }
+
+        if (IncludeAttributes())
+        {
+            ss << L", " << std::wstring_view(RS_(L"ExportBufferWithAttributesCommandKey"));
+        }
+        return winrt::hstring{ ss.str() };
+    }
 }
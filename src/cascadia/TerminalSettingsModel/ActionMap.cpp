@@ -396,11 +396,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             actionMap->_IterableCommands.Append(*(get_self<Command>(cmd)->Copy()));
         }
 
-        // repeat this for each of our parents
+        // Our parents are shared with the copy, rather than copied. Nothing
+        //   ever modifies a parent through its child: the child copies any
+        //   inherited command it needs to change into _MaskingActions first.
         FAIL_FAST_IF(_parents.size() > 1);
         for (const auto& parent : _parents)
         {
-            actionMap->_parents.emplace_back(parent->Copy());
+            actionMap->_parents.emplace_back(parent);
         }
 
         return actionMap;
@@ -422,6 +424,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _NameMapCache = nullptr;
         _GlobalHotkeysCache = nullptr;
         _KeyBindingMapCache = nullptr;
+        _ResolvedKeyChordCache.reset();
 
         // Handle nested commands
         const auto cmdImpl{ get_self<Command>(cmd) };
@@ -619,7 +622,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             const auto conflictingCmdImpl{ get_self<implementation::Command>(conflictingCmd) };
             conflictingCmdImpl->EraseKey(keys);
         }
-        else if (const auto& conflictingCmd{ GetActionByKeyChord(keys) })
+        else if (const auto& conflictingCmd{ _FindActionByKeyChordInLayers(keys).value_or(nullptr) })
         {
             // Collision with ancestor: The key chord was already in use, but by an action in another layer
             //
@@ -739,6 +742,55 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // - nullptr if the key chord is explicitly unbound
     // - nullopt if it was not bound in this layer
     std::optional<Model::Command> ActionMap::_GetActionByKeyChordInternal(Control::KeyChord const& keys) const
+    {
+        if (!_ResolvedKeyChordCache)
+        {
+            auto& resolvedKeys{ _ResolvedKeyChordCache.emplace() };
+            _PopulateResolvedKeyChordMap(resolvedKeys);
+        }
+
+        if (const auto it{ _ResolvedKeyChordCache->find(keys) }; it != _ResolvedKeyChordCache->end())
+        {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    // Method Description:
+    // - Populates resolvedKeys with every key chord bound in this layer or
+    //    in one of our parents. The closest layer that binds a key chord wins,
+    //    and resolves it with its own _GetActionByID(), exactly like
+    //    _FindActionByKeyChordInLayers() does.
+    // Arguments:
+    // - resolvedKeys: the map we're populating
+    void ActionMap::_PopulateResolvedKeyChordMap(std::unordered_map<Control::KeyChord, std::optional<Model::Command>, KeyChordHash, KeyChordEquality>& resolvedKeys) const
+    {
+        for (const auto& [keys, actionID] : _KeyMap)
+        {
+            if (resolvedKeys.find(keys) == resolvedKeys.end())
+            {
+                resolvedKeys.emplace(keys, _GetActionByID(actionID));
+            }
+        }
+
+        FAIL_FAST_IF(_parents.size() > 1);
+        for (const auto& parent : _parents)
+        {
+            parent->_PopulateResolvedKeyChordMap(resolvedKeys);
+        }
+    }
+
+    // Method Description:
+    // - Retrieves the assigned command with the given key chord, by walking
+    //    up the layers. Unlike _GetActionByKeyChordInternal(), this doesn't use
+    //    the cache, so it's safe to use while the ActionMap is being modified.
+    // Arguments:
+    // - keys: the key chord of the command to search for
+    // Return Value:
+    // - the command with the given key chord
+    // - nullptr if the key chord is explicitly unbound
+    // - nullopt if it was not bound in this layer
+    std::optional<Model::Command> ActionMap::_FindActionByKeyChordInLayers(Control::KeyChord const& keys) const
     {
         // Check the current layer
         if (const auto actionIDPair = _KeyMap.find(keys); actionIDPair != _KeyMap.end())
@@ -753,7 +805,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         FAIL_FAST_IF(_parents.size() > 1);
         for (const auto& parent : _parents)
         {
-            const auto& inheritedCmd{ parent->_GetActionByKeyChordInternal(keys) };
+            const auto& inheritedCmd{ parent->_FindActionByKeyChordInLayers(keys) };
             if (inheritedCmd)
             {
                 return *inheritedCmd;
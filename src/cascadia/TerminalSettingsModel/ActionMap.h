@@ -81,6 +81,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     private:
         std::optional<Model::Command> _GetActionByID(const InternalActionID actionID) const;
         std::optional<Model::Command> _GetActionByKeyChordInternal(const Control::KeyChord& keys) const;
+        std::optional<Model::Command> _FindActionByKeyChordInLayers(const Control::KeyChord& keys) const;
+        void _PopulateResolvedKeyChordMap(std::unordered_map<Control::KeyChord, std::optional<Model::Command>, KeyChordHash, KeyChordEquality>& resolvedKeys) const;
 
         void _PopulateAvailableActionsWithStandardCommands(std::unordered_map<hstring, Model::ActionAndArgs>& availableActions, std::unordered_set<InternalActionID>& visitedActionIDs) const;
         void _PopulateNameMapWithSpecialCommands(std::unordered_map<hstring, Model::Command>& nameMap) const;
@@ -96,6 +98,11 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         Windows::Foundation::Collections::IMap<hstring, Model::Command> _NameMapCache{ nullptr };
         Windows::Foundation::Collections::IMap<Control::KeyChord, Model::Command> _GlobalHotkeysCache{ nullptr };
         Windows::Foundation::Collections::IMap<Control::KeyChord, Model::Command> _KeyBindingMapCache{ nullptr };
+
+        // Every key chord bound in this layer or in one of our parents, mapped
+        // to what _FindActionByKeyChordInLayers() would return for it. Built on
+        // the first lookup after a change, so a key press costs one probe.
+        mutable std::optional<std::unordered_map<Control::KeyChord, std::optional<Model::Command>, KeyChordHash, KeyChordEquality>> _ResolvedKeyChordCache;
         Windows::Foundation::Collections::IMap<hstring, Model::Command> _NestedCommands{ nullptr };
         Windows::Foundation::Collections::IVector<Model::Command> _IterableCommands{ nullptr };
         std::unordered_map<Control::KeyChord, InternalActionID, KeyChordHash, KeyChordEquality> _KeyMap;
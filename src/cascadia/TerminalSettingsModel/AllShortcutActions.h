@@ -77,7 +77,10 @@
     ON_ALL_ACTIONS(OpenWindowRenamer)      \
     ON_ALL_ACTIONS(GlobalSummon)           \
     ON_ALL_ACTIONS(QuakeMode)              \
-    ON_ALL_ACTIONS(FocusPane)
+    ON_ALL_ACTIONS(FocusPane)              \
+    ON_ALL_ACTIONS(ToggleRenderStatistics) \
+    ON_ALL_ACTIONS(ExportBuffer)           \
+    ON_ALL_ACTIONS(ReportMemoryUsage)
 
 #define ALL_SHORTCUT_ACTIONS_WITH_ARGS             \
     ON_ALL_ACTIONS_WITH_ARGS(AdjustFontSize)       \
@@ -86,6 +89,7 @@
     ON_ALL_ACTIONS_WITH_ARGS(CloseTab)             \
     ON_ALL_ACTIONS_WITH_ARGS(CopyText)             \
     ON_ALL_ACTIONS_WITH_ARGS(ExecuteCommandline)   \
+    ON_ALL_ACTIONS_WITH_ARGS(ExportBuffer)         \
     ON_ALL_ACTIONS_WITH_ARGS(FindMatch)            \
     ON_ALL_ACTIONS_WITH_ARGS(GlobalSummon)         \
     ON_ALL_ACTIONS_WITH_ARGS(MoveFocus)            \
@@ -109,6 +109,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         {                                                   \
             auto state = _state.lock();                     \
             state->name.emplace(value);                     \
+            state->name##Changed = true;                    \
         }                                                   \
                                                             \
         _throttler();                                       \
@@ -119,11 +120,15 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // Deserializes the state.json at _path into this ApplicationState.
     // * ANY errors during app state will result in the creation of a new empty state.
     // * ANY errors during runtime will result in changes being partially ignored.
+    // * Fields that were set since the last _write() keep their new value.
+    //   They're still waiting to be written, and will be.
+    // * Every window gets a change notification for state.json, including the
+    //   one that wrote it. If the file is what we wrote last, nothing changed.
     void ApplicationState::_read() const noexcept
     try
     {
         const auto data = ReadUTF8FileIfExists(_path).value_or(std::string{});
-        if (data.empty())
+        if (data.empty() || data == _state.lock_shared()->content)
         {
             return;
         }
@@ -143,30 +148,45 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         // * return std::optional<T> by value
         // At the time of writing the former version skips missing fields in the json,
         // but we want to explicitly clear state fields that were removed from state.json.
-#define MTSM_APPLICATION_STATE_GEN(type, name, key, ...) state->name = JsonUtils::GetValueForKey<std::optional<type>>(root, key);
+#define MTSM_APPLICATION_STATE_GEN(type, name, key, ...)                         \
+    if (!state->name##Changed)                                                   \
+    {                                                                            \
+        state->name = JsonUtils::GetValueForKey<std::optional<type>>(root, key); \
+    }
         MTSM_APPLICATION_STATE_FIELDS(MTSM_APPLICATION_STATE_GEN)
 #undef MTSM_APPLICATION_STATE_GEN
+        state->content = data;
     }
     CATCH_LOG()
 
     // Serialized this ApplicationState (in `context`) into the state.json at _path.
     // * Errors are only logged.
-    // * _state->_writeScheduled is set to false, signaling our
-    //   setters that _synchronize() needs to be called again.
+    // * This runs on the throttler's thread, at most once a second, so any
+    //   number of setter calls in between are coalesced into one write.
+    // * A write that wouldn't change the file is skipped.
     void ApplicationState::_write() const noexcept
     try
     {
         Json::Value root{ Json::objectValue };
+        std::string content;
 
         {
-            auto state = _state.lock_shared();
-#define MTSM_APPLICATION_STATE_GEN(type, name, key, ...) JsonUtils::SetValueForKey(root, key, state->name);
+            auto state = _state.lock();
+#define MTSM_APPLICATION_STATE_GEN(type, name, key, ...) \
+    JsonUtils::SetValueForKey(root, key, state->name);   \
+    state->name##Changed = false;
             MTSM_APPLICATION_STATE_FIELDS(MTSM_APPLICATION_STATE_GEN)
 #undef MTSM_APPLICATION_STATE_GEN
+
+            Json::StreamWriterBuilder wbuilder;
+            content = Json::writeString(wbuilder, root);
+            if (content == state->content)
+            {
+                return;
+            }
+            state->content = content;
         }
 
-        Json::StreamWriterBuilder wbuilder;
-        const auto content = Json::writeString(wbuilder, root);
         WriteUTF8FileAtomic(_path, content);
     }
     CATCH_LOG()
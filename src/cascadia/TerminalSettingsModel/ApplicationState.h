@@ -52,6 +52,15 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 #define MTSM_APPLICATION_STATE_GEN(type, name, key, ...) std::optional<type> name{ __VA_ARGS__ };
             MTSM_APPLICATION_STATE_FIELDS(MTSM_APPLICATION_STATE_GEN)
 #undef MTSM_APPLICATION_STATE_GEN
+
+            // Set by the setters until the next _write(). A _read() in the
+            // meantime (another window wrote state.json) leaves these alone.
+#define MTSM_APPLICATION_STATE_GEN(type, name, key, ...) bool name##Changed{ false };
+            MTSM_APPLICATION_STATE_FIELDS(MTSM_APPLICATION_STATE_GEN)
+#undef MTSM_APPLICATION_STATE_GEN
+
+            // What we wrote last (or read). Reading it back is a no-op.
+            std::string content;
         };
 
         void _write() const noexcept;
@@ -94,40 +94,49 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
 // - <none>
 void CascadiaSettings::_CopyProfileInheritanceTree(winrt::com_ptr<CascadiaSettings>& cloneSettings) const
 {
-    // Our profiles inheritance graph doesn't have a formal root.
-    // However, if we create a dummy Profile, and set _profiles as the parent,
-    //  we now have a root. So we'll do just that, then copy the inheritance graph
-    //  from the dummyRoot.
-    auto dummyRootSource{ winrt::make_self<Profile>() };
+    // Only the user's layer of the tree can be modified: the profiles in
+    //  _allProfiles and profile.defaults. Everything they inherit from
+    //  (defaults.json, fragments and dynamic profiles) doesn't change once
+    //  the settings are loaded. So only the user's layer is copied, and the
+    //  copies share the rest of the tree with us.
+    std::unordered_map<const Profile*, winrt::com_ptr<Profile>> clones;
+    std::vector<std::pair<winrt::com_ptr<Profile>, winrt::com_ptr<Profile>>> copied;
+    copied.reserve(_allProfiles.Size() + 1);
+
+    if (_userDefaultProfileSettings)
+    {
+        // profile.defaults must be saved to CascadiaSettings
+        cloneSettings->_userDefaultProfileSettings = Profile::CopySettings(_userDefaultProfileSettings);
+        clones.emplace(_userDefaultProfileSettings.get(), cloneSettings->_userDefaultProfileSettings);
+        copied.emplace_back(_userDefaultProfileSettings, cloneSettings->_userDefaultProfileSettings);
+    }
+
     for (const auto& profile : _allProfiles)
     {
         winrt::com_ptr<Profile> profileImpl;
         profileImpl.copy_from(winrt::get_self<Profile>(profile));
-        Profile::InsertParentHelper(dummyRootSource, profileImpl);
+        auto clone{ Profile::CopySettings(profileImpl) };
+        clones.emplace(profileImpl.get(), clone);
+        copied.emplace_back(std::move(profileImpl), std::move(clone));
     }
 
-    auto dummyRootClone{ winrt::make_self<Profile>() };
-    std::unordered_map<void*, winrt::com_ptr<Profile>> visited{};
-
-    if (_userDefaultProfileSettings)
+    // Hook the copies up to the same parents, or to the copies of them.
+    for (const auto& [source, clone] : copied)
     {
-        // profile.defaults must be saved to CascadiaSettings
-        // So let's do that manually first, and add that to visited
-        cloneSettings->_userDefaultProfileSettings = Profile::CopySettings(_userDefaultProfileSettings);
-        visited[_userDefaultProfileSettings.get()] = cloneSettings->_userDefaultProfileSettings;
+        for (const auto& parent : source->Parents())
+        {
+            const auto it{ clones.find(parent.get()) };
+            Profile::InsertParentHelper(clone, it != clones.end() ? it->second : parent);
+        }
     }
 
-    Profile::CloneInheritanceGraph(dummyRootSource, dummyRootClone, visited);
-
-    // All of the parents of the dummy root clone are _profiles.
-    // Get the parents and add them to the settings clone.
-    const auto cloneParents{ dummyRootClone->Parents() };
-    for (const auto& profile : cloneParents)
+    for (const auto& profile : _allProfiles)
     {
-        cloneSettings->_allProfiles.Append(*profile);
-        if (!profile->Hidden())
+        const auto& clone{ clones.at(winrt::get_self<Profile>(profile)) };
+        cloneSettings->_allProfiles.Append(*clone);
+        if (!clone->Hidden())
         {
-            cloneSettings->_activeProfiles.Append(*profile);
+            cloneSettings->_activeProfiles.Append(*clone);
         }
     }
 }
@@ -327,6 +336,8 @@ winrt::Microsoft::Terminal::Settings::Model::Profile CascadiaSettings::Duplicate
     DUPLICATE_SETTING_MACRO(HistorySize);
     DUPLICATE_SETTING_MACRO(SnapOnInput);
     DUPLICATE_SETTING_MACRO(AltGrAliasing);
+    DUPLICATE_SETTING_MACRO(ConnectionPassthroughMode);
+    DUPLICATE_SETTING_MACRO(PredictiveEcho);
     DUPLICATE_SETTING_MACRO(BellStyle);
 
     {
@@ -117,18 +117,45 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         Windows::Foundation::Collections::IObservableVector<Model::DefaultTerminal> _defaultTerminals;
         Model::DefaultTerminal _currentDefaultTerminal;
 
-        std::vector<std::unique_ptr<::Microsoft::Terminal::Settings::Model::IDynamicProfileGenerator>> _profileGenerators;
+        // These are shared_ptrs because a generator that misses the
+        // _LoadDynamicProfiles deadline keeps running on the thread pool, and
+        // has to outlive us if we're destroyed before it finishes.
+        std::vector<std::shared_ptr<::Microsoft::Terminal::Settings::Model::IDynamicProfileGenerator>> _profileGenerators;
 
         std::string _userSettingsString;
         Json::Value _userSettings;
         Json::Value _defaultSettings;
         winrt::com_ptr<Profile> _userDefaultProfileSettings{ nullptr };
 
+        // The TerminalSettings resolved from each profile, shared by every pane
+        // that's made from it. See TerminalSettings::CreateWithProfileByID.
+        std::unordered_map<winrt::guid, Model::TerminalSettingsCreateResult> _terminalSettingsCache;
+
+        // A fragment file and the source (the app or package) it belongs to.
+        struct FragmentFile
+        {
+            winrt::hstring source;
+            std::filesystem::path path;
+        };
+
+        // Fragments are parsed again only when they've been written to since
+        // the last time we loaded the settings. See _LoadFragmentFile.
+        struct CachedFragment
+        {
+            std::filesystem::file_time_type lastWriteTime;
+            std::shared_ptr<const Json::Value> json;
+        };
+        struct FragmentCache
+        {
+            wil::srwlock lock;
+            std::unordered_map<std::wstring, CachedFragment> entries;
+        };
+
         void _LayerOrCreateProfile(const Json::Value& profileJson);
         winrt::com_ptr<implementation::Profile> _FindMatchingProfile(const Json::Value& profileJson);
         std::optional<uint32_t> _FindMatchingProfileIndex(const Json::Value& profileJson);
         void _LayerOrCreateColorScheme(const Json::Value& schemeJson);
-        Json::Value _ParseUtf8JsonString(std::string_view fileData);
+        static Json::Value _ParseUtf8JsonString(std::string_view fileData);
 
         winrt::com_ptr<implementation::ColorScheme> _FindMatchingColorScheme(const Json::Value& schemeJson);
         void _ParseJsonString(std::string_view fileData, const bool isDefaultSettings);
@@ -143,9 +170,12 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         void _LoadDynamicProfiles();
         void _LoadFragmentExtensions();
-        void _ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces);
-        std::unordered_set<std::string> _AccumulateJsonFilesInDirectory(const std::wstring_view directory);
-        void _ParseAndLayerFragmentFiles(const std::unordered_set<std::string> files, const winrt::hstring source);
+        static void _ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces, std::vector<FragmentFile>& files);
+        static void _AccumulateJsonFilesInDirectory(const std::wstring_view directory, const winrt::hstring& source, std::vector<FragmentFile>& files);
+        static std::shared_ptr<const Json::Value> _LoadFragmentFile(const std::filesystem::path& path);
+        static void _PruneFragmentCache(const std::vector<FragmentFile>& files);
+        static FragmentCache& _FragmentCache();
+        void _ParseAndLayerFragmentFile(const Json::Value& fullFile, const winrt::hstring& source);
 
         static const std::filesystem::path& _SettingsPath();
         static std::optional<std::string> _ReadUserSettings();
@@ -168,6 +198,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         bool _HasInvalidColorScheme(const Model::Command& command);
 
+        friend struct TerminalSettings;
         friend class SettingsModelLocalTests::SerializationTests;
         friend class SettingsModelLocalTests::DeserializationTests;
         friend class SettingsModelLocalTests::ProfileTests;
@@ -5,6 +5,7 @@
 #include "CascadiaSettings.h"
 
 #include <fmt/chrono.h>
+#include <future>
 #include <shlobj.h>
 
 // defaults.h is a file containing the default json settings in a std::string_view
@@ -27,6 +28,10 @@ static constexpr std::wstring_view LegacySettingsFilename{ L"profiles.json" };
 
 static constexpr std::wstring_view DefaultsFilename{ L"defaults.json" };
 
+// How long _LoadDynamicProfiles waits for all the generators (combined) before
+// giving up on the stragglers. wsl.exe alone is already allowed 2s.
+static constexpr std::chrono::milliseconds DynamicProfileGeneratorTimeout{ 5000 };
+
 static constexpr std::string_view SchemaKey{ "$schema" };
 static constexpr std::string_view SchemaValue{ "https://aka.ms/terminal-profiles-schema" };
 static constexpr std::string_view ProfilesKey{ "profiles" };
@@ -77,6 +82,36 @@ static auto _extractValueFromTaskWithoutMainThreadAwait(TTask&& task) -> decltyp
     return *finalVal;
 }
 
+// Function Description:
+// - Runs the given function on the thread pool and returns a future for its
+//   result. If we can't get onto the thread pool, it's just run right here.
+// - The function is moved into the work item, so it has to hold its own
+//   references to anything it uses, in case its caller stops waiting for it.
+template<typename TFunc>
+static auto _runOnThreadPool(TFunc&& func) -> std::future<decltype(func())>
+{
+    using Task = std::packaged_task<decltype(func())()>;
+    auto task = std::make_unique<Task>(std::forward<TFunc>(func));
+    auto future = task->get_future();
+
+    const auto callback = [](PTP_CALLBACK_INSTANCE, void* context) noexcept {
+        std::unique_ptr<Task> task{ static_cast<Task*>(context) };
+        (*task)();
+    };
+    if (TrySubmitThreadpoolCallback(callback, task.get(), nullptr))
+    {
+        task.release();
+    }
+    else
+    {
+        // Couldn't get onto the thread pool. Just run it here.
+        LOG_LAST_ERROR();
+        (*task)();
+    }
+
+    return future;
+}
+
 static std::tuple<size_t, size_t> _LineAndColumnFromPosition(const std::string_view string, ptrdiff_t position)
 {
     size_t line = 1, column = position + 1;
@@ -352,29 +387,55 @@ void CascadiaSettings::_LoadDynamicProfiles()
         }
     }
 
-    const GUID nullGuid{ 0 };
-    for (auto& generator : _profileGenerators)
+    // The generators are independent of each other and mostly wait on I/O
+    // (a child process, the file system, the registry), so kick them all off
+    // on the thread pool at once. Startup then costs as much as the slowest
+    // generator, rather than the sum of all of them.
+    std::vector<std::pair<std::wstring, std::future<std::vector<Model::Profile>>>> pending;
+    pending.reserve(_profileGenerators.size());
+    for (const auto& generator : _profileGenerators)
     {
-        const std::wstring generatorNamespace{ generator->GetNamespace() };
+        std::wstring generatorNamespace{ generator->GetNamespace() };
 
         if (ignoredNamespaces.find(generatorNamespace) != ignoredNamespaces.end())
         {
             // namespace should be ignored
+            continue;
         }
-        else
+
+        try
         {
-            try
+            // The task holds its own reference to the generator, so that one
+            // which misses the deadline below can finish safely after we've
+            // moved on (or been destroyed).
+            auto future = _runOnThreadPool([generator]() { return generator->GenerateProfiles(); });
+            pending.emplace_back(std::move(generatorNamespace), std::move(future));
+        }
+        CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
+    }
+
+    // Collect the results in generator order, so that the resulting list of
+    // profiles is the same no matter which generator finished first.
+    const auto deadline = std::chrono::steady_clock::now() + DynamicProfileGeneratorTimeout;
+    for (auto& [generatorNamespace, future] : pending)
+    {
+        try
+        {
+            if (future.wait_until(deadline) != std::future_status::ready)
             {
-                auto profiles = generator->GenerateProfiles();
-                for (auto& profile : profiles)
-                {
-                    profile.Source(generatorNamespace);
+                LOG_HR_MSG(HRESULT_FROM_WIN32(ERROR_TIMEOUT), "Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
+                continue;
+            }
 
-                    _allProfiles.Append(profile);
-                }
+            auto profiles = future.get();
+            for (auto& profile : profiles)
+            {
+                profile.Source(generatorNamespace);
+
+                _allProfiles.Append(profile);
             }
-            CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
         }
+        CATCH_LOG_MSG("Dynamic Profile Namespace: \"%ls\"", generatorNamespace.data());
     }
 }
 
@@ -384,6 +445,8 @@ void CascadiaSettings::_LoadDynamicProfiles()
 //   modify existing profiles or add new color schemes
 // - If the user settings has any namespaces in the "disabledProfileSources"
 //   property, we'll ensure that the corresponding folders do not get searched
+// - The files are read and parsed concurrently, but applied one after another,
+//   in the order we found them in.
 void CascadiaSettings::_LoadFragmentExtensions()
 {
     // First, accumulate the namespaces the user wants to ignore
@@ -397,6 +460,8 @@ void CascadiaSettings::_LoadFragmentExtensions()
         }
     }
 
+    std::vector<FragmentFile> files;
+
     // Search through the local app data folder
     wil::unique_cotaskmem_string localAppDataFolder;
     THROW_IF_FAILED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &localAppDataFolder));
@@ -404,7 +469,7 @@ void CascadiaSettings::_LoadFragmentExtensions()
 
     if (std::filesystem::exists(localAppDataFragments))
     {
-        _ApplyJsonStubsHelper(localAppDataFragments, ignoredNamespaces);
+        _ApplyJsonStubsHelper(localAppDataFragments, ignoredNamespaces, files);
     }
 
     // Search through the program data folder
@@ -413,7 +478,7 @@ void CascadiaSettings::_LoadFragmentExtensions()
     auto programDataFragments = std::wstring(programDataFolder.get()) + FragmentsPath.data();
     if (std::filesystem::exists(programDataFragments))
     {
-        _ApplyJsonStubsHelper(programDataFragments, ignoredNamespaces);
+        _ApplyJsonStubsHelper(programDataFragments, ignoredNamespaces, files);
     }
 
     // Search through app extensions
@@ -444,14 +509,36 @@ void CascadiaSettings::_LoadFragmentExtensions()
                 // If the directory exists, use the fragments in it
                 if (std::filesystem::exists(path))
                 {
-                    const auto jsonFiles = _AccumulateJsonFilesInDirectory(til::u8u16(path));
-
                     // Provide the package name as the source
-                    _ParseAndLayerFragmentFiles(jsonFiles, ext.Package().Id().FamilyName().c_str());
+                    _AccumulateJsonFilesInDirectory(til::u8u16(path), ext.Package().Id().FamilyName(), files);
                 }
             }
         }
     }
+
+    // Reading and parsing a file doesn't depend on any other file, so do all
+    // of them at once on the thread pool.
+    std::vector<std::future<std::shared_ptr<const Json::Value>>> parsed;
+    parsed.reserve(files.size());
+    for (const auto& file : files)
+    {
+        parsed.emplace_back(_runOnThreadPool([path = file.path]() { return _LoadFragmentFile(path); }));
+    }
+
+    // Apply them in the order we found them in, so that the result doesn't
+    // depend on which file was parsed first.
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+        const auto& file = til::at(files, i);
+        try
+        {
+            const auto json = til::at(parsed, i).get();
+            _ParseAndLayerFragmentFile(*json, file.source);
+        }
+        CATCH_LOG_MSG("Fragment: \"%ls\"", file.path.c_str());
+    }
+
+    _PruneFragmentCache(files);
 }
 
 // Method Description:
@@ -459,7 +546,8 @@ void CascadiaSettings::_LoadFragmentExtensions()
 // Arguments:
 // - The directory to find json files in
 // - The set of ignored namespaces
-void CascadiaSettings::_ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces)
+// - files: receives the json files that were found
+void CascadiaSettings::_ApplyJsonStubsHelper(const std::wstring_view directory, const std::unordered_set<std::wstring>& ignoredNamespaces, std::vector<FragmentFile>& files)
 {
     // The json files should be within subdirectories where the subdirectory name is the app name
     for (const auto& fragmentExtFolder : std::filesystem::directory_iterator(directory))
@@ -471,122 +559,177 @@ void CascadiaSettings::_ApplyJsonStubsHelper(const std::wstring_view directory,
         // (also make sure this is a directory for sanity)
         if (std::filesystem::is_directory(fragmentExtFolder) && ignoredNamespaces.find(source) == ignoredNamespaces.end())
         {
-            const auto jsonFiles = _AccumulateJsonFilesInDirectory(fragmentExtFolder.path().c_str());
-            _ParseAndLayerFragmentFiles(jsonFiles, winrt::hstring{ source });
+            _AccumulateJsonFilesInDirectory(fragmentExtFolder.path().c_str(), winrt::hstring{ source }, files);
         }
     }
 }
 
 // Method Description:
 // - Finds all the json files within the given directory
+// - The files are added sorted by their path, so that they're always applied
+//   in the same order, whatever order the file system returns them in.
 // Arguments:
 // - directory: the directory to search
-// Return Value:
-// - A set containing all the found file data
-std::unordered_set<std::string> CascadiaSettings::_AccumulateJsonFilesInDirectory(const std::wstring_view directory)
+// - source: the location the files came from
+// - files: receives the json files that were found
+void CascadiaSettings::_AccumulateJsonFilesInDirectory(const std::wstring_view directory, const winrt::hstring& source, std::vector<FragmentFile>& files)
 {
-    std::unordered_set<std::string> jsonFiles;
+    const auto first = files.size();
 
     for (const auto& fragmentExt : std::filesystem::directory_iterator(directory))
     {
         if (fragmentExt.path().extension() == jsonExtension)
         {
-            try
-            {
-                jsonFiles.emplace(ReadUTF8File(fragmentExt.path()));
-            }
-            CATCH_LOG();
+            files.push_back({ source, fragmentExt.path() });
         }
     }
-    return jsonFiles;
+
+    std::sort(files.begin() + first, files.end(), [](const FragmentFile& lhs, const FragmentFile& rhs) {
+        return lhs.path < rhs.path;
+    });
 }
 
 // Method Description:
-// - Given a set of json files, uses them to modify existing profiles,
-//   create new profiles, and create new color schemes
+// - Reads and parses the given fragment file. Fragments that haven't been
+//   written to since we last parsed them are returned from a cache instead.
+// - This is called on the thread pool, for many files at once.
 // Arguments:
-// - files: the set of json files (each item in the set is the file data)
-// - source: the location the files came from
-void CascadiaSettings::_ParseAndLayerFragmentFiles(const std::unordered_set<std::string> files, const winrt::hstring source)
+// - path: the file to load
+// Return Value:
+// - The parsed contents of the file
+std::shared_ptr<const Json::Value> CascadiaSettings::_LoadFragmentFile(const std::filesystem::path& path)
 {
+    const auto lastWriteTime = std::filesystem::last_write_time(path);
+
+    auto& cache = _FragmentCache();
+    {
+        const auto lock = cache.lock.lock_shared();
+        if (const auto it = cache.entries.find(path.native()); it != cache.entries.end() && it->second.lastWriteTime == lastWriteTime)
+        {
+            return it->second.json;
+        }
+    }
+
+    auto json = std::make_shared<const Json::Value>(_ParseUtf8JsonString(ReadUTF8File(path)));
+
+    const auto lock = cache.lock.lock_exclusive();
+    cache.entries.insert_or_assign(path.native(), CachedFragment{ lastWriteTime, json });
+    return json;
+}
+
+// Method Description:
+// - Drops the cached fragments of files that don't exist (or aren't used)
+//   anymore, so the cache doesn't grow with every fragment ever seen.
+// Arguments:
+// - files: the fragment files that were just loaded
+void CascadiaSettings::_PruneFragmentCache(const std::vector<FragmentFile>& files)
+{
+    std::unordered_set<std::wstring_view> paths;
     for (const auto& file : files)
     {
-        // A file could have many new profiles/many profiles it wants to modify/many new color schemes
-        // so we first parse the entire file into one json object
-        auto fullFile = _ParseUtf8JsonString(file.data());
+        paths.emplace(file.path.native());
+    }
+
+    auto& cache = _FragmentCache();
+    const auto lock = cache.lock.lock_exclusive();
+    for (auto it = cache.entries.begin(); it != cache.entries.end();)
+    {
+        it = paths.count(it->first) ? std::next(it) : cache.entries.erase(it);
+    }
+}
 
-        if (fullFile.isMember(JsonKey(ProfilesKey)))
+// Method Description:
+// - Returns the cache of parsed fragment files. It's shared by every load of
+//   the settings, including the ones that happen when the settings reload.
+CascadiaSettings::FragmentCache& CascadiaSettings::_FragmentCache()
+{
+    static FragmentCache cache;
+    return cache;
+}
+
+// Method Description:
+// - Given a parsed fragment file, uses it to modify existing profiles,
+//   create new profiles, and create new color schemes
+// Arguments:
+// - fullFile: the parsed contents of the file
+// - source: the location the file came from
+void CascadiaSettings::_ParseAndLayerFragmentFile(const Json::Value& fullFile, const winrt::hstring& source)
+{
+    // A file could have many new profiles/many profiles it wants to modify/many new color schemes
+    // so the entire file was parsed into one json object
+    if (fullFile.isMember(JsonKey(ProfilesKey)))
+    {
+        // Now we separately get each stub that modifies/adds a profile
+        for (const auto& profileStub : fullFile[JsonKey(ProfilesKey)])
         {
-            // Now we separately get each stub that modifies/adds a profile
-            // We intentionally don't use a const reference here because we modify
-            // the profile stub by giving it a guid so we can call _FindMatchingProfile
-            for (auto& profileStub : fullFile[JsonKey(ProfilesKey)])
+            if (profileStub.isMember(JsonKey(UpdatesKey)))
             {
-                if (profileStub.isMember(JsonKey(UpdatesKey)))
+                // This stub is meant to be a modification to an existing profile,
+                // try to find the matching profile
+                // We make a copy here because we modify the profile stub by giving
+                // it a guid so we can call _FindMatchingProfile. The parsed file
+                // may be cached and used again.
+                auto updateStub = profileStub;
+                updateStub[JsonKey(GuidKey)] = updateStub[JsonKey(UpdatesKey)];
+                auto matchingProfile = _FindMatchingProfile(updateStub);
+                if (matchingProfile)
                 {
-                    // This stub is meant to be a modification to an existing profile,
-                    // try to find the matching profile
-                    profileStub[JsonKey(GuidKey)] = profileStub[JsonKey(UpdatesKey)];
-                    auto matchingProfile = _FindMatchingProfile(profileStub);
-                    if (matchingProfile)
+                    try
+                    {
+                        // We found a matching profile, create a child of it and put the modifications there
+                        // (we add a new inheritance layer)
+                        auto childImpl{ matchingProfile->CreateChild() };
+                        childImpl->LayerJson(updateStub);
+                        childImpl->Origin(OriginTag::Fragment);
+
+                        // replace parent in _profiles with child
+                        _allProfiles.SetAt(_FindMatchingProfileIndex(matchingProfile->ToJson()).value(), *childImpl);
+                    }
+                    catch (...)
                     {
-                        try
-                        {
-                            // We found a matching profile, create a child of it and put the modifications there
-                            // (we add a new inheritance layer)
-                            auto childImpl{ matchingProfile->CreateChild() };
-                            childImpl->LayerJson(profileStub);
-                            childImpl->Origin(OriginTag::Fragment);
-
-                            // replace parent in _profiles with child
-                            _allProfiles.SetAt(_FindMatchingProfileIndex(matchingProfile->ToJson()).value(), *childImpl);
-                        }
-                        catch (...)
-                        {
-                        }
                     }
                 }
-                else
+            }
+            else
+            {
+                // This is a new profile, check that it meets our minimum requirements first
+                // (it must have at least a name)
+                if (profileStub.isMember(JsonKey(NameKey)))
                 {
-                    // This is a new profile, check that it meets our minimum requirements first
-                    // (it must have at least a name)
-                    if (profileStub.isMember(JsonKey(NameKey)))
+                    try
+                    {
+                        auto newProfile = Profile::FromJson(profileStub);
+                        // Make sure to give the new profile a source, then we add it to our list of profiles
+                        // We don't make modifications to the user's settings file yet, that will happen when
+                        // _AppendDynamicProfilesToUserSettings() is called later
+                        newProfile->Source(source);
+                        newProfile->Origin(OriginTag::Fragment);
+                        _allProfiles.Append(*newProfile);
+                    }
+                    catch (...)
                     {
-                        try
-                        {
-                            auto newProfile = Profile::FromJson(profileStub);
-                            // Make sure to give the new profile a source, then we add it to our list of profiles
-                            // We don't make modifications to the user's settings file yet, that will happen when
-                            // _AppendDynamicProfilesToUserSettings() is called later
-                            newProfile->Source(source);
-                            newProfile->Origin(OriginTag::Fragment);
-                            _allProfiles.Append(*newProfile);
-                        }
-                        catch (...)
-                        {
-                        }
                     }
                 }
             }
         }
+    }
 
-        if (fullFile.isMember(JsonKey(SchemesKey)))
+    if (fullFile.isMember(JsonKey(SchemesKey)))
+    {
+        // Now we separately get each stub that adds a color scheme
+        for (const auto& schemeStub : fullFile[JsonKey(SchemesKey)])
         {
-            // Now we separately get each stub that adds a color scheme
-            for (const auto& schemeStub : fullFile[JsonKey(SchemesKey)])
+            if (_FindMatchingColorScheme(schemeStub))
             {
-                if (_FindMatchingColorScheme(schemeStub))
-                {
-                    // We do not allow modifications to existing color schemes
-                }
-                else
+                // We do not allow modifications to existing color schemes
+            }
+            else
+            {
+                // This is a new color scheme, add it only if it specifies _all_ the fields
+                if (ColorScheme::ValidateColorScheme(schemeStub))
                 {
-                    // This is a new color scheme, add it only if it specifies _all_ the fields
-                    if (ColorScheme::ValidateColorScheme(schemeStub))
-                    {
-                        const auto newScheme = ColorScheme::FromJson(schemeStub);
-                        _globals->AddColorScheme(*newScheme);
-                    }
+                    const auto newScheme = ColorScheme::FromJson(schemeStub);
+                    _globals->AddColorScheme(*newScheme);
                 }
             }
         }
@@ -48,6 +48,7 @@ static constexpr std::string_view StartupActionsKey{ "startupActions" };
 static constexpr std::string_view FocusFollowMouseKey{ "focusFollowMouse" };
 static constexpr std::string_view WindowingBehaviorKey{ "windowingBehavior" };
 static constexpr std::string_view TrimBlockSelectionKey{ "trimBlockSelection" };
+static constexpr std::string_view AccessibilityNotificationIntervalKey{ "accessibilityNotificationInterval" };
 
 static constexpr std::string_view DebugFeaturesKey{ "debugFeatures" };
 
@@ -55,6 +56,7 @@ static constexpr std::string_view ForceFullRepaintRenderingKey{ "experimental.re
 static constexpr std::string_view SoftwareRenderingKey{ "experimental.rendering.software" };
 static constexpr std::string_view ForceVTInputKey{ "experimental.input.forceVT" };
 static constexpr std::string_view DetectURLsKey{ "experimental.detectURLs" };
+static constexpr std::string_view WarmTabCountKey{ "experimental.warmTabCount" };
 
 #ifdef _DEBUG
 static constexpr bool debugFeaturesDefault{ true };
@@ -129,6 +131,8 @@ winrt::com_ptr<GlobalAppSettings> GlobalAppSettings::Copy() const
     globals->_WindowingBehavior = _WindowingBehavior;
     globals->_TrimBlockSelection = _TrimBlockSelection;
     globals->_DetectURLs = _DetectURLs;
+    globals->_AccessibilityNotificationInterval = _AccessibilityNotificationInterval;
+    globals->_WarmTabCount = _WarmTabCount;
 
     globals->_UnparsedDefaultProfile = _UnparsedDefaultProfile;
     globals->_validDefaultProfile = _validDefaultProfile;
@@ -145,11 +149,12 @@ winrt::com_ptr<GlobalAppSettings> GlobalAppSettings::Copy() const
         }
     }
 
-    // Globals only ever has 1 parent
+    // Globals only ever has 1 parent. It's the defaults.json layer, which
+    // is never modified after loading, so the copy shares it with us.
     FAIL_FAST_IF(_parents.size() > 1);
     for (auto parent : _parents)
     {
-        globals->InsertParent(parent->Copy());
+        globals->InsertParent(parent);
     }
     return globals;
 }
@@ -319,6 +324,10 @@ void GlobalAppSettings::LayerJson(const Json::Value& json)
 
     JsonUtils::GetValueForKey(json, DetectURLsKey, _DetectURLs);
 
+    JsonUtils::GetValueForKey(json, AccessibilityNotificationIntervalKey, _AccessibilityNotificationInterval);
+
+    JsonUtils::GetValueForKey(json, WarmTabCountKey, _WarmTabCount);
+
     // This is a helper lambda to get the keybindings and commands out of both
     // and array of objects. We'll use this twice, once on the legacy
     // `keybindings` key, and again on the newer `bindings` key.
@@ -414,6 +423,8 @@ Json::Value GlobalAppSettings::ToJson() const
     JsonUtils::SetValueForKey(json, WindowingBehaviorKey,           _WindowingBehavior);
     JsonUtils::SetValueForKey(json, TrimBlockSelectionKey,          _TrimBlockSelection);
     JsonUtils::SetValueForKey(json, DetectURLsKey,                  _DetectURLs);
+    JsonUtils::SetValueForKey(json, AccessibilityNotificationIntervalKey, _AccessibilityNotificationInterval);
+    JsonUtils::SetValueForKey(json, WarmTabCountKey,                _WarmTabCount);
     // clang-format on
 
     json[JsonKey(ActionsKey)] = _actionMap->ToJson();
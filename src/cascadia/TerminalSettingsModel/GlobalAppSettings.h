@@ -98,6 +98,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         INHERITABLE_SETTING(Model::GlobalAppSettings, Model::WindowingMode, WindowingBehavior, Model::WindowingMode::UseNew);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, TrimBlockSelection, false);
         INHERITABLE_SETTING(Model::GlobalAppSettings, bool, DetectURLs, true);
+        INHERITABLE_SETTING(Model::GlobalAppSettings, int32_t, AccessibilityNotificationInterval, 100);
+        INHERITABLE_SETTING(Model::GlobalAppSettings, int32_t, WarmTabCount, 0);
 
     private:
         guid _defaultProfile;
@@ -3,6 +3,7 @@
 #include "IconPathConverter.g.cpp"
 
 #include "Utils.h"
+#include "../inc/WeakReferenceCache.h"
 
 using namespace winrt::Windows;
 using namespace winrt::Windows::UI::Xaml;
@@ -66,14 +67,21 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         {
             try
             {
-                winrt::Windows::Foundation::Uri iconUri{ path };
-                BitmapIconSource<TIconSource>::type iconSource;
-                // Make sure to set this to false, so we keep the RGB data of the
-                // image. Otherwise, the icon will be white for all the
-                // non-transparent pixels in the image.
-                iconSource.ShowAsMonochrome(false);
-                iconSource.UriSource(iconUri);
-                return iconSource;
+                // Every tab of a profile, and its entry in the new tab
+                // dropdown, asks for the same icon. IconSources can be shared
+                // between elements, so they all get the same one, and the
+                // image is only loaded once.
+                static thread_local WeakReferenceCache<winrt::hstring, typename BitmapIconSource<TIconSource>::type> s_icons;
+                return s_icons.GetOrCreate(path, [&]() {
+                    winrt::Windows::Foundation::Uri iconUri{ path };
+                    typename BitmapIconSource<TIconSource>::type iconSource;
+                    // Make sure to set this to false, so we keep the RGB data of the
+                    // image. Otherwise, the icon will be white for all the
+                    // non-transparent pixels in the image.
+                    iconSource.ShowAsMonochrome(false);
+                    iconSource.UriSource(iconUri);
+                    return iconSource;
+                });
             }
             CATCH_LOG();
         }
@@ -32,6 +32,8 @@ static constexpr std::string_view SuppressApplicationTitleKey{ "suppressApplicat
 static constexpr std::string_view HistorySizeKey{ "historySize" };
 static constexpr std::string_view SnapOnInputKey{ "snapOnInput" };
 static constexpr std::string_view AltGrAliasingKey{ "altGrAliasing" };
+static constexpr std::string_view ConnectionPassthroughModeKey{ "experimental.connection.passthroughMode" };
+static constexpr std::string_view PredictiveEchoKey{ "experimental.predictiveEcho" };
 
 static constexpr std::string_view ConnectionTypeKey{ "connectionType" };
 static constexpr std::string_view CommandlineKey{ "commandline" };
@@ -105,6 +107,8 @@ winrt::com_ptr<Profile> Profile::CopySettings(winrt::com_ptr<Profile> source)
     profile->_HistorySize = source->_HistorySize;
     profile->_SnapOnInput = source->_SnapOnInput;
     profile->_AltGrAliasing = source->_AltGrAliasing;
+    profile->_ConnectionPassthroughMode = source->_ConnectionPassthroughMode;
+    profile->_PredictiveEcho = source->_PredictiveEcho;
     profile->_BellStyle = source->_BellStyle;
     profile->_ConnectionType = source->_ConnectionType;
     profile->_Origin = source->_Origin;
@@ -142,55 +146,6 @@ winrt::com_ptr<Profile> Profile::CopySettings(winrt::com_ptr<Profile> source)
     return profile;
 }
 
-// Method Description:
-// - Creates a copy of the inheritance graph by performing a depth-first traversal recursively.
-//   Profiles are recorded as visited via the "visited" parameter.
-//   Unvisited Profiles are copied into the "cloneGraph" parameter, then marked as visited.
-// Arguments:
-// - sourceGraph - the graph of Profile's we're cloning
-// - cloneGraph - the clone of sourceGraph that is being constructed
-// - visited - a map of which Profiles have been visited, and, if so, a reference to the Profile's clone
-// Return Value:
-// - a clone in both inheritance structure and Profile values of sourceGraph
-winrt::com_ptr<Profile> Profile::CloneInheritanceGraph(winrt::com_ptr<Profile> sourceGraph, winrt::com_ptr<Profile> cloneGraph, std::unordered_map<void*, winrt::com_ptr<Profile>>& visited)
-{
-    // If this is an unexplored Profile
-    //   and we have parents...
-    if (visited.find(sourceGraph.get()) == visited.end() && !sourceGraph->_parents.empty())
-    {
-        // iterate through all of our parents to copy them
-        for (const auto& sourceParent : sourceGraph->_parents)
-        {
-            // If we visited this Profile already...
-            auto kv{ visited.find(sourceParent.get()) };
-            if (kv != visited.end())
-            {
-                // add this Profile's clone as a parent
-                InsertParentHelper(cloneGraph, kv->second);
-            }
-            else
-            {
-                // We have not visited this Profile yet,
-                // copy contents of sourceParent to clone
-                winrt::com_ptr<Profile> clone{ CopySettings(sourceParent) };
-
-                // add the new copy to the cloneGraph
-                InsertParentHelper(cloneGraph, clone);
-
-                // copy the sub-graph at "clone"
-                CloneInheritanceGraph(sourceParent, clone, visited);
-
-                // mark clone as "visited"
-                // save it to the map in case somebody else references it
-                visited[sourceParent.get()] = clone;
-            }
-        }
-    }
-
-    // we have no more to explore down this path.
-    return cloneGraph;
-}
-
 // Method Description:
 // - Inserts a parent profile into a child profile, at the specified index if one was provided
 // - Makes sure to call _FinalizeInheritance after inserting the parent
@@ -350,6 +305,8 @@ void Profile::LayerJson(const Json::Value& json)
     JsonUtils::GetValueForKey(json, HistorySizeKey, _HistorySize);
     JsonUtils::GetValueForKey(json, SnapOnInputKey, _SnapOnInput);
     JsonUtils::GetValueForKey(json, AltGrAliasingKey, _AltGrAliasing);
+    JsonUtils::GetValueForKey(json, ConnectionPassthroughModeKey, _ConnectionPassthroughMode);
+    JsonUtils::GetValueForKey(json, PredictiveEchoKey, _PredictiveEcho);
     JsonUtils::GetValueForKey(json, TabTitleKey, _TabTitle);
 
     // Control Settings
@@ -542,6 +499,8 @@ Json::Value Profile::ToJson() const
     JsonUtils::SetValueForKey(json, HistorySizeKey, _HistorySize);
     JsonUtils::SetValueForKey(json, SnapOnInputKey, _SnapOnInput);
     JsonUtils::SetValueForKey(json, AltGrAliasingKey, _AltGrAliasing);
+    JsonUtils::SetValueForKey(json, ConnectionPassthroughModeKey, _ConnectionPassthroughMode);
+    JsonUtils::SetValueForKey(json, PredictiveEchoKey, _PredictiveEcho);
     JsonUtils::SetValueForKey(json, TabTitleKey, _TabTitle);
 
     // Control Settings
@@ -3,6 +3,7 @@
 
 #include "pch.h"
 #include "TerminalSettings.h"
+#include "CascadiaSettings.h"
 #include "../../types/inc/colorTable.hpp"
 
 #include "TerminalSettings.g.cpp"
@@ -88,6 +89,10 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     //   use the guid to look up the profile that should be used to
     //   create these TerminalSettings. Then, we'll apply settings contained in the
     //   global and profile settings to the instance.
+    // - Resolving the profile is only done once for each profile, until the
+    //   settings are reloaded. The settings we return are children of those
+    //   cached ones, so that the caller and the control can override what
+    //   they want without changing them for the other panes.
     // Arguments:
     // - appSettings: the set of settings being used to construct the new terminal
     // - profileGuid: the unique identifier (guid) of the profile
@@ -97,9 +102,43 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     //   one for when the terminal is focused and the other for when the terminal is unfocused
     Model::TerminalSettingsCreateResult TerminalSettings::CreateWithProfileByID(const Model::CascadiaSettings& appSettings, winrt::guid profileGuid, const IKeyBindings& keybindings)
     {
-        const auto profile = appSettings.FindProfile(profileGuid);
-        THROW_HR_IF_NULL(E_INVALIDARG, profile);
-        return CreateWithProfile(appSettings, profile, keybindings);
+        auto& cache{ winrt::get_self<CascadiaSettings>(appSettings)->_terminalSettingsCache };
+        auto cached{ cache.find(profileGuid) };
+        if (cached == cache.end())
+        {
+            const auto profile = appSettings.FindProfile(profileGuid);
+            THROW_HR_IF_NULL(E_INVALIDARG, profile);
+            cached = cache.emplace(profileGuid, CreateWithProfile(appSettings, profile, nullptr)).first;
+        }
+        return _CreateWithCachedSettings(cached->second, keybindings);
+    }
+
+    // Method Description:
+    // - Create a TerminalSettingsCreateResult from the cached settings of a
+    //   profile. The default settings are a child of the cached ones. The
+    //   unfocused settings can't be, since the pane sets their parent to the
+    //   control's settings, so they get a copy of the cached appearance
+    //   instead.
+    // Arguments:
+    // - cached: the settings resolved from the profile
+    // - keybindings: the keybinding handler
+    // Return Value:
+    // - A TerminalSettingsCreateResult that doesn't share any object the
+    //   caller could modify with the other ones created from the cache.
+    Model::TerminalSettingsCreateResult TerminalSettings::_CreateWithCachedSettings(const Model::TerminalSettingsCreateResult& cached, const IKeyBindings& keybindings)
+    {
+        auto settings{ get_self<TerminalSettings>(cached.DefaultSettings())->CreateChild() };
+        settings->_KeyBindings = keybindings;
+
+        Model::TerminalSettings child{ nullptr };
+        if (const auto& unfocusedSettings{ cached.UnfocusedSettings() })
+        {
+            auto childImpl = settings->CreateChild();
+            childImpl->_CopyAppearanceSettings(*get_self<TerminalSettings>(unfocusedSettings));
+            child = *childImpl;
+        }
+
+        return winrt::make<TerminalSettingsCreateResult>(*settings, child);
     }
 
     // Method Description:
@@ -204,6 +243,32 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _PixelShaderPath = winrt::hstring{ wil::ExpandEnvironmentStringsW<std::wstring>(appearance.PixelShaderPath().c_str()) };
     }
 
+    // Method Description:
+    // - Copy the settings that _ApplyAppearanceSettings sets from the given
+    //   object. Only the values set on the object itself are copied, not the
+    //   ones it inherits.
+    // Arguments:
+    // - source: the settings to copy the appearance of
+    // Return Value:
+    // - <none>
+    void TerminalSettings::_CopyAppearanceSettings(const TerminalSettings& source)
+    {
+        _CursorShape = source._CursorShape;
+        _CursorHeight = source._CursorHeight;
+        _DefaultForeground = source._DefaultForeground;
+        _DefaultBackground = source._DefaultBackground;
+        _SelectionBackground = source._SelectionBackground;
+        _CursorColor = source._CursorColor;
+        _ColorTable = source._ColorTable;
+        _BackgroundImage = source._BackgroundImage;
+        _BackgroundImageOpacity = source._BackgroundImageOpacity;
+        _BackgroundImageStretchMode = source._BackgroundImageStretchMode;
+        _BackgroundImageHorizontalAlignment = source._BackgroundImageHorizontalAlignment;
+        _BackgroundImageVerticalAlignment = source._BackgroundImageVerticalAlignment;
+        _RetroTerminalEffect = source._RetroTerminalEffect;
+        _PixelShaderPath = source._PixelShaderPath;
+    }
+
     // Method Description:
     // - Creates a TerminalSettingsCreateResult from a parent TerminalSettingsCreateResult
     // - The returned defaultSettings inherits from the parent's defaultSettings, and the
@@ -270,6 +335,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _HistorySize = profile.HistorySize();
         _SnapOnInput = profile.SnapOnInput();
         _AltGrAliasing = profile.AltGrAliasing();
+        _PredictiveEcho = profile.PredictiveEcho();
 
         // Fill in the remaining properties from the profile
         _ProfileName = profile.Name();
@@ -321,6 +387,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         _WordDelimiters = globalSettings.WordDelimiters();
         _CopyOnSelect = globalSettings.CopyOnSelect();
         _FocusFollowMouse = globalSettings.FocusFollowMouse();
+        _AccessibilityNotificationInterval = globalSettings.AccessibilityNotificationInterval();
         _ForceFullRepaintRendering = globalSettings.ForceFullRepaintRendering();
         _SoftwareRendering = globalSettings.SoftwareRendering();
         _ForceVTInput = globalSettings.ForceVTInput();
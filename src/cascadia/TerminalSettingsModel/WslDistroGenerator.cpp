@@ -15,6 +15,13 @@
 
 static constexpr std::wstring_view DockerDistributionPrefix{ L"docker-desktop" };
 
+// Non-Localizable strings
+namespace RegKeys
+{
+    static constexpr std::wstring_view WslDistrosKey{ L"Software\\Microsoft\\Windows\\CurrentVersion\\Lxss" };
+    static constexpr std::wstring_view DistributionNameValue{ L"DistributionName" };
+}
+
 using namespace ::Microsoft::Terminal::Settings::Model;
 using namespace winrt::Microsoft::Terminal::Settings::Model;
 
@@ -30,14 +37,17 @@ std::wstring_view WslDistroGenerator::GetNamespace()
 }
 
 // Method Description:
-// -  Enumerates all the installed WSL distros to create profiles for them.
+// - Enumerates the installed WSL distros by shelling out to `wsl.exe --list`.
+//   This is the slow path: it spins up a process and waits for it, which can
+//   take hundreds of milliseconds. It's only used when the distros can't be
+//   read out of the registry.
 // Arguments:
 // - <none>
 // Return Value:
-// - a vector with all distros for all the installed WSL distros
-std::vector<Profile> WslDistroGenerator::GenerateProfiles()
+// - the names of all the installed WSL distros, unfiltered
+static std::vector<std::wstring> _getWslDistroNamesFromWslExe()
 {
-    std::vector<Profile> profiles;
+    std::vector<std::wstring> names;
 
     wil::unique_handle readPipe;
     wil::unique_handle writePipe;
@@ -70,7 +80,7 @@ std::vector<Profile> WslDistroGenerator::GenerateProfiles()
         break;
     case WAIT_ABANDONED:
     case WAIT_TIMEOUT:
-        return profiles;
+        return names;
     case WAIT_FAILED:
         THROW_LAST_ERROR();
     default:
@@ -83,7 +93,7 @@ std::vector<Profile> WslDistroGenerator::GenerateProfiles()
     }
     else if (exitCode != 0)
     {
-        return profiles;
+        return names;
     }
     DWORD bytesAvailable;
     THROW_IF_WIN32_BOOL_FALSE(PeekNamedPipe(readPipe.get(), nullptr, NULL, nullptr, &bytesAvailable, nullptr));
@@ -110,13 +120,6 @@ std::vector<Profile> WslDistroGenerator::GenerateProfiles()
             std::wstring distName;
             std::getline(wlinestream, distName, L'\r');
 
-            if (distName.substr(0, std::min(distName.size(), DockerDistributionPrefix.size())) == DockerDistributionPrefix)
-            {
-                // Docker for Windows creates some utility distributions to handle Docker commands.
-                // Pursuant to GH#3556, because they are _not_ user-facing we want to hide them.
-                continue;
-            }
-
             const size_t firstChar = distName.find_first_of(L"( ");
             // Some localizations don't have a space between the name and "(Default)"
             // https://github.com/microsoft/terminal/issues/1168#issuecomment-500187109
@@ -124,14 +127,106 @@ std::vector<Profile> WslDistroGenerator::GenerateProfiles()
             {
                 distName.resize(firstChar);
             }
-            auto WSLDistro{ CreateDefaultProfile(distName) };
+            names.emplace_back(std::move(distName));
+        }
+    }
+
+    return names;
+}
+
+// Method Description:
+// - Enumerates the installed WSL distros by reading them out of
+//   HKCU\Software\Microsoft\Windows\CurrentVersion\Lxss. Every distro
+//   registered for the current user has a subkey there (named by its GUID),
+//   with a DistributionName value. This doesn't need to start any process, so
+//   it's much cheaper than asking wsl.exe on every launch.
+// Arguments:
+// - names: receives the names of all the installed WSL distros, unfiltered
+// Return Value:
+// - true if the Lxss key exists and was enumerated. false if we need to fall
+//   back to wsl.exe.
+static bool _tryGetWslDistroNamesFromRegistry(std::vector<std::wstring>& names)
+{
+    wil::unique_hkey wslRootKey{};
+    if (RegOpenKeyExW(HKEY_CURRENT_USER, RegKeys::WslDistrosKey.data(), 0, KEY_READ, &wslRootKey) != ERROR_SUCCESS)
+    {
+        return false;
+    }
+
+    DWORD subKeyCount = 0;
+    DWORD maxSubKeyLength = 0;
+    if (RegQueryInfoKeyW(wslRootKey.get(), nullptr, nullptr, nullptr, &subKeyCount, &maxSubKeyLength, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS)
+    {
+        return false;
+    }
+
+    // The returned maximum length doesn't include the terminating null.
+    std::wstring subKeyName(maxSubKeyLength + 1, L'\0');
+    for (DWORD i = 0; i < subKeyCount; ++i)
+    {
+        DWORD length = gsl::narrow_cast<DWORD>(subKeyName.size());
+        if (RegEnumKeyExW(wslRootKey.get(), i, subKeyName.data(), &length, nullptr, nullptr, nullptr, nullptr) != ERROR_SUCCESS)
+        {
+            continue;
+        }
 
-            WSLDistro.Commandline(L"wsl.exe -d " + distName);
-            WSLDistro.DefaultAppearance().ColorSchemeName(L"Campbell");
-            WSLDistro.StartingDirectory(DEFAULT_STARTING_DIRECTORY);
-            WSLDistro.Icon(L"ms-appx:///ProfileIcons/{9acb9455-ca41-5af7-950f-6bca1bc9722f}.png");
-            profiles.emplace_back(WSLDistro);
+        DWORD valueSize = 0;
+        if (RegGetValueW(wslRootKey.get(), subKeyName.c_str(), RegKeys::DistributionNameValue.data(), RRF_RT_REG_SZ, nullptr, nullptr, &valueSize) != ERROR_SUCCESS || valueSize < sizeof(wchar_t))
+        {
+            continue;
+        }
+
+        std::wstring distName(valueSize / sizeof(wchar_t), L'\0');
+        if (RegGetValueW(wslRootKey.get(), subKeyName.c_str(), RegKeys::DistributionNameValue.data(), RRF_RT_REG_SZ, nullptr, distName.data(), &valueSize) != ERROR_SUCCESS)
+        {
+            continue;
+        }
+
+        // valueSize includes the terminating null.
+        distName.resize(valueSize / sizeof(wchar_t) - 1);
+        if (!distName.empty())
+        {
+            names.emplace_back(std::move(distName));
+        }
+    }
+
+    return true;
+}
+
+// Method Description:
+// -  Enumerates all the installed WSL distros to create profiles for them.
+//    The distros are read from the registry, which lets us skip launching
+//    wsl.exe on every startup. wsl.exe is only used if the registry key
+//    doesn't exist (e.g. on older builds of WSL).
+// Arguments:
+// - <none>
+// Return Value:
+// - a vector with all distros for all the installed WSL distros
+std::vector<Profile> WslDistroGenerator::GenerateProfiles()
+{
+    std::vector<std::wstring> names;
+    if (!_tryGetWslDistroNamesFromRegistry(names))
+    {
+        names = _getWslDistroNamesFromWslExe();
+    }
+
+    std::vector<Profile> profiles;
+    for (const auto& distName : names)
+    {
+        if (distName.substr(0, std::min(distName.size(), DockerDistributionPrefix.size())) == DockerDistributionPrefix)
+        {
+            // Docker for Windows creates some utility distributions to handle Docker commands.
+            // Pursuant to GH#3556, because they are _not_ user-facing we want to hide them.
+            continue;
         }
+
+        auto WSLDistro{ CreateDefaultProfile(distName) };
+
+        WSLDistro.Commandline(L"wsl.exe -d " + distName);
+        WSLDistro.DefaultAppearance().ColorSchemeName(L"Campbell");
+        WSLDistro.StartingDirectory(DEFAULT_STARTING_DIRECTORY);
+        WSLDistro.Icon(L"ms-appx:///ProfileIcons/{9acb9455-ca41-5af7-950f-6bca1bc9722f}.png");
+        profiles.emplace_back(WSLDistro);
     }
 
     return profiles;
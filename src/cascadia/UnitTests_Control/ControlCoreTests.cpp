@@ -31,6 +31,7 @@ namespace ControlUnitTests
         TEST_METHOD(TestFreeAfterClose);
 
         TEST_METHOD(TestFontInitializedInCtor);
+        TEST_METHOD(TestUpdateSettingsSkipsUnchangedFont);
 
         TEST_CLASS_SETUP(ModuleSetup)
         {
@@ -202,4 +203,40 @@ namespace ControlUnitTests
         VERIFY_ARE_EQUAL(L"Impact", std::wstring_view{ core->_actualFont.GetFaceName() });
     }
 
+    void ControlCoreTests::TestUpdateSettingsSkipsUnchangedFont()
+    {
+        auto [settings, conn] = _createSettingsAndConnection();
+
+        auto core = createCore(*settings, *conn);
+        VERIFY_IS_NOT_NULL(core);
+        core->Initialize(270, 420, 1.0);
+        VERIFY_IS_TRUE(core->_initializedTerminal);
+
+        int fontSizeChanges = 0;
+        core->FontSizeChanged([&](auto&&...) { ++fontSizeChanges; });
+
+        Log::Comment(L"Reapplying the same settings shouldn't touch the font");
+        core->UpdateSettings(*settings);
+        VERIFY_ARE_EQUAL(0, fontSizeChanges);
+
+        Log::Comment(L"Changing an unrelated setting shouldn't touch the font either");
+        settings->HistorySize(settings->HistorySize() + 1);
+        core->UpdateSettings(*settings);
+        VERIFY_ARE_EQUAL(0, fontSizeChanges);
+
+        Log::Comment(L"Changing the font size should update the font");
+        settings->FontSize(settings->FontSize() + 2);
+        core->UpdateSettings(*settings);
+        VERIFY_ARE_EQUAL(1, fontSizeChanges);
+
+        Log::Comment(L"New settings that only add a font feature should update the font");
+        auto features = winrt::single_threaded_map<winrt::hstring, uint32_t>();
+        features.Insert(L"calt", 0);
+        auto newSettings = winrt::make_self<MockControlSettings>();
+        newSettings->FontSize(settings->FontSize());
+        newSettings->FontFeatures(features);
+        core->UpdateSettings(*newSettings);
+        VERIFY_ARE_EQUAL(2, fontSizeChanges);
+    }
+
 }
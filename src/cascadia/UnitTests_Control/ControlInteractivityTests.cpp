@@ -34,6 +34,7 @@ namespace ControlUnitTests
         TEST_METHOD(TestQuickDragOnSelect);
 
         TEST_METHOD(TestDragSelectOutsideBounds);
+        TEST_METHOD(TestPointerMovesWithinCell);
 
         TEST_METHOD(PointerClickOutsideActiveRegion);
 
@@ -631,6 +632,57 @@ namespace ControlUnitTests
         VERIFY_ARE_EQUAL(expectedEnd, core->_terminal->GetSelectionEnd());
     }
 
+    void ControlInteractivityTests::TestPointerMovesWithinCell()
+    {
+        auto [settings, conn] = _createSettingsAndConnection();
+        auto [core, interactivity] = _createCoreAndInteractivity(*settings, *conn);
+        _standardInit(core, interactivity);
+
+        const auto modifiers = ControlKeyStates();
+        const Control::MouseButtonState leftMouseDown{ Control::MouseButtonState::IsLeftButtonDown };
+
+        const til::size fontSize{ 9, 21 };
+        Log::Comment(L"Click on the terminal and drag to start a selection");
+        const til::point cursorPosition0{ 6, 0 };
+        interactivity->PointerPressed(leftMouseDown,
+                                      WM_LBUTTONDOWN, //pointerUpdateKind
+                                      0, // timestamp
+                                      modifiers,
+                                      cursorPosition0);
+        const til::point cursorPosition1{ 6 + fontSize.width<int>() * 2, 0 };
+        interactivity->PointerMoved(leftMouseDown,
+                                    WM_LBUTTONDOWN, //pointerUpdateKind
+                                    modifiers,
+                                    true, // focused,
+                                    cursorPosition1,
+                                    true);
+        VERIFY_IS_TRUE(core->HasSelection());
+        VERIFY_IS_TRUE(interactivity->_lastPointerMove.has_value());
+        COORD expectedEnd{ 2, 0 };
+        VERIFY_ARE_EQUAL(expectedEnd, core->_terminal->GetSelectionEnd());
+
+        Log::Comment(L"Moves within the same cell are dropped");
+        const auto lastMove = *interactivity->_lastPointerMove;
+        interactivity->PointerMoved(leftMouseDown,
+                                    WM_LBUTTONDOWN, //pointerUpdateKind
+                                    modifiers,
+                                    true, // focused,
+                                    cursorPosition1 + til::point{ 1, 1 },
+                                    true);
+        VERIFY_IS_TRUE(lastMove == *interactivity->_lastPointerMove);
+        VERIFY_ARE_EQUAL(expectedEnd, core->_terminal->GetSelectionEnd());
+
+        Log::Comment(L"Moving to another cell still extends the selection");
+        interactivity->PointerMoved(leftMouseDown,
+                                    WM_LBUTTONDOWN, //pointerUpdateKind
+                                    modifiers,
+                                    true, // focused,
+                                    cursorPosition1 + til::point{ 0, fontSize.height<int>() },
+                                    true);
+        expectedEnd = { 2, 1 };
+        VERIFY_ARE_EQUAL(expectedEnd, core->_terminal->GetSelectionEnd());
+    }
+
     void ControlInteractivityTests::PointerClickOutsideActiveRegion()
     {
         // This is a test for GH#10642
@@ -30,6 +30,7 @@ namespace ControlUnitTests
 
         WINRT_PROPERTY(bool, SnapOnInput, true);
         WINRT_PROPERTY(bool, AltGrAliasing, true);
+        WINRT_PROPERTY(bool, PredictiveEcho, false);
         WINRT_PROPERTY(til::color, CursorColor, DEFAULT_CURSOR_COLOR);
         WINRT_PROPERTY(winrt::Microsoft::Terminal::Core::CursorStyle, CursorShape, winrt::Microsoft::Terminal::Core::CursorStyle::Vintage);
         WINRT_PROPERTY(uint32_t, CursorHeight, DEFAULT_CURSOR_HEIGHT);
@@ -37,6 +38,7 @@ namespace ControlUnitTests
         WINRT_PROPERTY(bool, CopyOnSelect, false);
         WINRT_PROPERTY(bool, InputServiceWarning, true);
         WINRT_PROPERTY(bool, FocusFollowMouse, false);
+        WINRT_PROPERTY(int32_t, AccessibilityNotificationInterval, 100);
 
         WINRT_PROPERTY(winrt::Windows::Foundation::IReference<winrt::Microsoft::Terminal::Core::Color>, TabColor, nullptr);
 
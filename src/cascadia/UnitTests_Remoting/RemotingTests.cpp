@@ -77,6 +77,7 @@ namespace RemotingUnitTests
         TYPED_EVENT(DisplayWindowIdRequested, winrt::Windows::Foundation::IInspectable, winrt::Windows::Foundation::IInspectable);
         TYPED_EVENT(RenameRequested, winrt::Windows::Foundation::IInspectable, Remoting::RenameRequestArgs);
         TYPED_EVENT(SummonRequested, winrt::Windows::Foundation::IInspectable, Remoting::SummonWindowBehavior);
+        TYPED_EVENT(WindowNameChanged, winrt::Windows::Foundation::IInspectable, winrt::hstring);
     };
 
     class RemotingTests
@@ -1107,8 +1108,8 @@ namespace RemotingUnitTests
     void RemotingTests::LookupNamedPeasantWhenOthersDied()
     {
         Log::Comment(L"Test that looking for a peasant by name when a different"
-                     L" peasant has died cleans up the corpses of any peasants "
-                     L"we may have tripped over.");
+                     L" peasant has died doesn't call into the dead peasant. "
+                     L"The monarch knows the names of all the peasants.");
 
         const auto monarch0PID = 12345u;
         const auto peasant1PID = 23456u;
@@ -1138,15 +1139,15 @@ namespace RemotingUnitTests
         Log::Comment(L"Kill peasant 1. Make sure that it gets removed from the monarch.");
         RemotingTests::_killPeasant(m0, p1->GetID());
 
-        // By killing 1, then looking for "two", we happen to iterate over the
-        // corpse of 1 when looking for the peasant named "two". This causes us
-        // to remove 1 while looking for "two". Technically, we shouldn't be
-        // relying on any sort of ordering for an unordered_map iterator, but
-        // this one just so happens to work.
         VERIFY_ARE_EQUAL(p2->GetID(), m0->_lookupPeasantIdForName(L"two"));
 
-        Log::Comment(L"Peasant 1 should have been pruned");
+        Log::Comment(L"Peasant 1 wasn't asked for its name, so it's still around");
+        VERIFY_ARE_EQUAL(2u, m0->_peasants.size());
+
+        Log::Comment(L"Looking for peasant 1 finds it's dead, and prunes it");
+        VERIFY_ARE_EQUAL(0, m0->_lookupPeasantIdForName(L"one"));
         VERIFY_ARE_EQUAL(1u, m0->_peasants.size());
+        VERIFY_ARE_EQUAL(1u, m0->_peasantInfos.size());
     }
 
     void RemotingTests::LookupNamedPeasantWhenItDied()
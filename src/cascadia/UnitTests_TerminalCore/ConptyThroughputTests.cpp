@@ -0,0 +1,376 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// This test class measures how fast VT output makes it through the whole
+// conpty pipeline: into the host's state machine, out of the host through the
+// VtEngine, and into the Terminal's state machine. It's set up the same way as
+// ConptyRoundtripTests, but instead of validating the output it times each
+// stage and logs the throughput.
+//
+// These tests are ignored by default. Run them with:
+//   te.exe UnitTests_TerminalCore.dll /name:*ConptyThroughputTests* /p:DevTest=true
+// and optionally replay a recorded stream (e.g. captured with `script`) with:
+//   /p:VtReplayFile=C:\path\to\recording.txt
+// or replay every file of a corpus of slow inputs (see the slow input mode of
+// the host fuzzer, src/host/ft_fuzzer/fuzzmain.cpp) with:
+//   /p:VtCorpusDir=C:\path\to\corpus
+
+#include "pch.h"
+#include "../../types/inc/Viewport.hpp"
+#include "../../types/inc/convert.hpp"
+
+#include "../renderer/inc/DummyRenderTarget.hpp"
+#include "../../renderer/base/Renderer.hpp"
+#include "../../renderer/vt/Xterm256Engine.hpp"
+#include "../../renderer/vt/XtermEngine.hpp"
+
+class InputBuffer; // This for some reason needs to be fwd-decl'd
+#include "../host/inputBuffer.hpp"
+#include "../host/readDataCooked.hpp"
+#include "../host/output.h"
+#include "test/CommonState.hpp"
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace Microsoft::Console::Types;
+using namespace Microsoft::Console::Interactivity;
+using namespace Microsoft::Console::VirtualTerminal;
+
+using namespace Microsoft::Console;
+using namespace Microsoft::Console::Render;
+
+using namespace Microsoft::Terminal::Core;
+
+namespace TerminalCoreUnitTests
+{
+    class ConptyThroughputTests;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::ConptyThroughputTests final
+{
+    static const SHORT TerminalViewWidth = 120;
+    static const SHORT TerminalViewHeight = 30;
+
+    // The host is fed this many characters before each frame is painted.
+    // That roughly matches one read of the conpty input pipe per frame.
+    static constexpr size_t CharsPerFrame = 16 * 1024;
+
+    TEST_CLASS(ConptyThroughputTests);
+
+    TEST_CLASS_SETUP(ClassSetup)
+    {
+        m_state = std::make_unique<CommonState>();
+
+        m_state->InitEvents();
+        m_state->PrepareGlobalFont();
+        m_state->PrepareGlobalScreenBuffer(TerminalViewWidth, TerminalViewHeight, TerminalViewWidth, TerminalViewHeight);
+        m_state->PrepareGlobalInputBuffer();
+
+        return true;
+    }
+
+    TEST_CLASS_CLEANUP(ClassCleanup)
+    {
+        m_state->CleanupGlobalScreenBuffer();
+        m_state->CleanupGlobalFont();
+        m_state->CleanupGlobalInputBuffer();
+
+        m_state.release();
+
+        return true;
+    }
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        term = std::make_unique<Terminal>();
+        term->Create({ TerminalViewWidth, TerminalViewHeight }, 9001, emptyRT);
+
+        auto& g = ServiceLocator::LocateGlobals();
+        auto& gci = g.getConsoleInformation();
+
+        gci.SetDefaultForegroundColor(INVALID_COLOR);
+        gci.SetDefaultBackgroundColor(INVALID_COLOR);
+        gci.SetFillAttribute(0x07); // DARK_WHITE on DARK_BLACK
+
+        m_state->PrepareNewTextBufferInfo(true, TerminalViewWidth, TerminalViewHeight);
+        auto& currentBuffer = gci.GetActiveOutputBuffer();
+
+        g.pRender = new Renderer(&gci.renderData, nullptr, 0, nullptr);
+
+        wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+        Viewport initialViewport = currentBuffer.GetViewport();
+
+        auto vtRenderEngine = std::make_unique<Xterm256Engine>(std::move(hFile),
+                                                               initialViewport);
+        auto pfn = std::bind(&ConptyThroughputTests::_writeCallback, this, std::placeholders::_1, std::placeholders::_2);
+        vtRenderEngine->SetTestCallback(pfn);
+        vtRenderEngine->SetResizeQuirk(true);
+
+        g.pRender->AddRenderEngine(vtRenderEngine.get());
+        gci.GetActiveOutputBuffer().SetTerminalConnection(vtRenderEngine.get());
+
+        g.EnableConptyModeForTests(std::move(vtRenderEngine));
+
+        _stats = {};
+
+        return true;
+    }
+
+    TEST_METHOD_CLEANUP(MethodCleanup)
+    {
+        m_state->CleanupNewTextBufferInfo();
+
+        auto& g = ServiceLocator::LocateGlobals();
+        delete g.pRender;
+
+        term = nullptr;
+
+        return true;
+    }
+
+    BEGIN_TEST_METHOD(PlainTextThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(ColorizedLogThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(FullScreenRedrawThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(ReplayFileThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(PathologicalInputThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(SlowInputCorpusThroughput)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct Stats
+    {
+        clock::duration hostParse;
+        clock::duration conptyPaint;
+        clock::duration terminalParse;
+        size_t conptyBytes;
+        size_t frames;
+    };
+
+    bool _writeCallback(const char* const pch, size_t const cch);
+    void _replay(const std::wstring_view name, const std::wstring_view text);
+
+    std::unique_ptr<CommonState> m_state;
+
+    DummyRenderTarget emptyRT;
+    std::unique_ptr<Terminal> term;
+
+    Stats _stats{};
+};
+
+bool ConptyThroughputTests::_writeCallback(const char* const pch, size_t const cch)
+{
+    // This is called from inside the host's PaintFrame, so the time spent
+    // here is subtracted from the conpty stage again in _replay.
+    const auto start = clock::now();
+    const auto converted = ConvertToW(CP_UTF8, { pch, cch });
+    term->Write(converted);
+    _stats.terminalParse += clock::now() - start;
+    _stats.conptyBytes += cch;
+    return true;
+}
+
+// Method Description:
+// - Pushes the given text through the host in frame sized chunks, painting a
+//   conpty frame after each one, and logs how long each stage took.
+// Arguments:
+// - name: the name of the scenario, for the log.
+// - text: the VT stream to replay.
+// Return Value:
+// - <none>
+void ConptyThroughputTests::_replay(const std::wstring_view name, const std::wstring_view text)
+{
+    auto& g = ServiceLocator::LocateGlobals();
+    auto& renderer = *g.pRender;
+    auto& gci = g.getConsoleInformation();
+    auto& hostSm = gci.GetActiveOutputBuffer().GetStateMachine();
+
+    for (size_t offset = 0; offset < text.size(); offset += CharsPerFrame)
+    {
+        const auto chunk = text.substr(offset, CharsPerFrame);
+
+        auto start = clock::now();
+        hostSm.ProcessString(chunk);
+        _stats.hostParse += clock::now() - start;
+
+        const auto terminalParseBefore = _stats.terminalParse;
+        start = clock::now();
+        VERIFY_SUCCEEDED(renderer.PaintFrame());
+        _stats.conptyPaint += (clock::now() - start) - (_stats.terminalParse - terminalParseBefore);
+        ++_stats.frames;
+    }
+
+    const auto megabytes = static_cast<double>(text.size() * sizeof(wchar_t)) / (1024.0 * 1024.0);
+    const auto toMs = [](const clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+    const auto total = _stats.hostParse + _stats.conptyPaint + _stats.terminalParse;
+
+    Log::Comment(NoThrowString().Format(L"%s: %zu chars in %zu frames, %zu bytes of conpty output",
+                                        std::wstring{ name }.c_str(),
+                                        text.size(),
+                                        _stats.frames,
+                                        _stats.conptyBytes));
+    Log::Comment(NoThrowString().Format(L"  host parse:     %10.2f ms", toMs(_stats.hostParse)));
+    Log::Comment(NoThrowString().Format(L"  conpty paint:   %10.2f ms", toMs(_stats.conptyPaint)));
+    Log::Comment(NoThrowString().Format(L"  terminal parse: %10.2f ms", toMs(_stats.terminalParse)));
+    Log::Comment(NoThrowString().Format(L"  total:          %10.2f ms, %.2f MB/s (UTF-16)",
+                                        toMs(total),
+                                        megabytes / std::max(toMs(total) / 1000.0, 1e-9)));
+}
+
+void ConptyThroughputTests::PlainTextThroughput()
+{
+    // Like `cat` on a large source file: many short lines of printable ASCII.
+    std::wstring text;
+    const std::wstring_view line{ L"    const auto result = SomeFunctionCall(argumentOne, argumentTwo, 42);\r\n" };
+    text.reserve(line.size() * 100000);
+    for (auto i = 0; i < 100000; ++i)
+    {
+        text.append(line);
+    }
+
+    _replay(L"PlainText", text);
+}
+
+void ConptyThroughputTests::ColorizedLogThroughput()
+{
+    // Like a colorized build log: SGR changes every few words.
+    std::wstring text;
+    for (auto i = 0; i < 50000; ++i)
+    {
+        text.append(L"\x1b[32m[build]\x1b[m ");
+        text.append(L"\x1b[1;35msrc/host/_stream.cpp\x1b[m(");
+        text.append(std::to_wstring(i % 1000));
+        text.append(L"): \x1b[1;31mwarning C4996\x1b[m: '\x1b[38;2;200;150;50mwcscpy\x1b[m': deprecated\r\n");
+    }
+
+    _replay(L"ColorizedLog", text);
+}
+
+void ConptyThroughputTests::FullScreenRedrawThroughput()
+{
+    // Like a full screen TUI (htop, tmux): home the cursor and repaint every
+    // cell of the viewport with positioned, colored text, over and over.
+    std::wstring text;
+    for (auto frame = 0; frame < 500; ++frame)
+    {
+        text.append(L"\x1b[H");
+        for (auto row = 1; row <= TerminalViewHeight; ++row)
+        {
+            text.append(L"\x1b[");
+            text.append(std::to_wstring(row));
+            text.append(L";1H\x1b[48;5;");
+            text.append(std::to_wstring((frame + row) % 256));
+            text.append(L"m");
+            text.append(TerminalViewWidth, static_cast<wchar_t>(L'A' + (frame + row) % 26));
+        }
+        text.append(L"\x1b[m");
+    }
+
+    _replay(L"FullScreenRedraw", text);
+}
+
+void ConptyThroughputTests::ReplayFileThroughput()
+{
+    String path;
+    if (FAILED(RuntimeParameters::TryGetValue(L"VtReplayFile", path)) || path.IsEmpty())
+    {
+        Log::Result(TestResults::Skipped, L"Pass /p:VtReplayFile=<path> to replay a recorded VT stream.");
+        return;
+    }
+
+    std::ifstream file{ static_cast<const wchar_t*>(path), std::ios::binary };
+    VERIFY_IS_TRUE(file.good(), NoThrowString().Format(L"Couldn't open %s", static_cast<const wchar_t*>(path)));
+
+    const std::string contents{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+    _replay(static_cast<const wchar_t*>(path), ConvertToW(CP_UTF8, contents));
+}
+
+void ConptyThroughputTests::PathologicalInputThroughput()
+{
+    // The kinds of input the parser has been slow on before. Each of these
+    // should be about as fast per character as plain text.
+    const auto repeat = [](const std::wstring_view s, const size_t count) {
+        std::wstring text;
+        text.reserve(s.size() * count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            text.append(s);
+        }
+        return text;
+    };
+
+    // Parameters with thousands of digits, and with thousands of parameters.
+    _replay(L"HugeParameter", repeat(L"\x1b[" + std::wstring(4096, L'9') + L"m", 200));
+    _stats = {};
+    _replay(L"ManyParameters", repeat(L"\x1b[" + repeat(L"1;", 4096) + L"m", 200));
+    _stats = {};
+
+    // An OSC string that's never terminated.
+    _replay(L"EndlessOsc", L"\x1b]8;;" + std::wstring(1024 * 1024, L'x'));
+    _stats = {};
+
+    // A DCS string that's never terminated, full of nested introducers.
+    _replay(L"EndlessDcs", L"\x1bP" + repeat(L"\x1bP1$q", 128 * 1024));
+    _stats = {};
+
+    // REP with the largest count, over and over.
+    _replay(L"RepeatedRep", repeat(L"x\x1b[32767b\r", 200));
+}
+
+void ConptyThroughputTests::SlowInputCorpusThroughput()
+{
+    String path;
+    if (FAILED(RuntimeParameters::TryGetValue(L"VtCorpusDir", path)) || path.IsEmpty())
+    {
+        Log::Result(TestResults::Skipped, L"Pass /p:VtCorpusDir=<path> to replay a corpus of slow inputs.");
+        return;
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator{ static_cast<const wchar_t*>(path) })
+    {
+        if (!entry.is_regular_file())
+        {
+            continue;
+        }
+
+        std::ifstream file{ entry.path(), std::ios::binary };
+        const std::string contents{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        _stats = {};
+        _replay(entry.path().filename().native(), ConvertToW(CP_UTF8, contents));
+    }
+}
@@ -0,0 +1,275 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// This test class times the hot paths of the buffer, the parser and til in
+// isolation, so that a performance change can be measured before and after.
+// Each benchmark runs its operation a number of times after a warm-up and
+// logs the time and the heap allocations (see AllocationCounter.hpp) per
+// operation.
+//
+// These tests are ignored by default. Run them with:
+//   te.exe UnitTests_TerminalCore.dll /name:*MicroBenchmarks* /p:DevTest=true
+// and optionally change the number of iterations with:
+//   /p:BenchmarkIterations=1000
+
+#include "pch.h"
+
+#include "../../inc/test/AllocationCounter.hpp"
+#include "../../buffer/out/search.h"
+#include "../../terminal/adapter/termDispatch.hpp"
+#include "../../terminal/parser/OutputStateMachineEngine.hpp"
+#include "../../terminal/parser/stateMachine.hpp"
+#include "../renderer/inc/DummyRenderTarget.hpp"
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+
+#include <til/u8u16convert.h>
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Types;
+using namespace Microsoft::Console::VirtualTerminal;
+using namespace Microsoft::Terminal::Core;
+
+namespace TerminalCoreUnitTests
+{
+    class MicroBenchmarks;
+};
+using namespace TerminalCoreUnitTests;
+
+namespace
+{
+    // Throws away everything the parser dispatches, so that only
+    // StateMachine::ProcessString itself is measured.
+    class NullDispatch final : public TermDispatch
+    {
+    public:
+        void Execute(const wchar_t) override {}
+        void Print(const wchar_t) override {}
+        void PrintString(const std::wstring_view) override {}
+    };
+}
+
+class TerminalCoreUnitTests::MicroBenchmarks final
+{
+    static constexpr SHORT BufferWidth = 120;
+    static constexpr SHORT BufferHeight = 9001;
+
+    TEST_CLASS(MicroBenchmarks);
+
+    TEST_CLASS_SETUP(ClassSetup)
+    {
+        _iterations = 200;
+        RuntimeParameters::TryGetValue(L"BenchmarkIterations", _iterations);
+        _iterations = std::max<size_t>(_iterations, 1);
+
+        // A line that looks like source code, used by most benchmarks below.
+        _line = L"    const auto result = SomeFunctionCall(argumentOne, argumentTwo, 42); // comment";
+        _line.resize(BufferWidth, L' ');
+        return true;
+    }
+
+    BEGIN_TEST_METHOD(RowWriteCells)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(TextBufferWrite)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(TextBufferReflow)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(StateMachineProcessString)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(SearchFindNext)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(U8U16)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(RleReplace)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(BitmapSet)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+private:
+    void _measure(const std::wstring_view name, const std::function<void()>& operation);
+
+    DummyRenderTarget _renderTarget;
+    std::wstring _line;
+    size_t _iterations{};
+};
+
+// Method Description:
+// - Runs the operation once to warm up caches and lazily allocated state,
+//   then _iterations more times, and logs the time and the allocations per run.
+// Arguments:
+// - name: the name of the benchmark, for the log.
+// - operation: the code to measure.
+// Return Value:
+// - <none>
+void MicroBenchmarks::_measure(const std::wstring_view name, const std::function<void()>& operation)
+{
+    using clock = std::chrono::steady_clock;
+
+    operation();
+
+    const Microsoft::Console::Test::AllocationCounter allocations;
+    const auto start = clock::now();
+    for (size_t i = 0; i < _iterations; ++i)
+    {
+        operation();
+    }
+    const auto elapsed = clock::now() - start;
+    const auto allocationCount = allocations.Count();
+
+    const auto us = std::chrono::duration<double, std::micro>(elapsed).count() / _iterations;
+    Log::Comment(NoThrowString().Format(L"%s: %zu iterations, %.3f us and %.1f allocations per iteration",
+                                        std::wstring{ name }.c_str(),
+                                        _iterations,
+                                        us,
+                                        static_cast<double>(allocationCount) / _iterations));
+}
+
+void MicroBenchmarks::RowWriteCells()
+{
+    TextBuffer buffer{ { BufferWidth, 1 }, {}, 0, _renderTarget };
+    auto& row = buffer.GetRowByOffset(0);
+    const TextAttribute attr{ 3 };
+
+    _measure(L"ROW::WriteCells", [&]() {
+        row.WriteCells(OutputCellIterator{ _line, attr }, 0);
+    });
+}
+
+void MicroBenchmarks::TextBufferWrite()
+{
+    TextBuffer buffer{ { BufferWidth, BufferHeight }, {}, 0, _renderTarget };
+    const TextAttribute attr{ 3 };
+    SHORT y = 0;
+
+    _measure(L"TextBuffer::Write", [&]() {
+        buffer.Write(OutputCellIterator{ _line, attr }, { 0, y });
+        y = gsl::narrow_cast<SHORT>((y + 1) % BufferHeight);
+    });
+}
+
+void MicroBenchmarks::TextBufferReflow()
+{
+    TextBuffer oldBuffer{ { BufferWidth, 1000 }, {}, 0, _renderTarget };
+    const TextAttribute attr{ 3 };
+    for (SHORT y = 0; y < 1000; ++y)
+    {
+        oldBuffer.Write(OutputCellIterator{ _line, attr }, { 0, y });
+    }
+    oldBuffer.GetCursor().SetPosition({ 0, 999 });
+
+    _measure(L"TextBuffer::Reflow", [&]() {
+        TextBuffer newBuffer{ { BufferWidth - 37, 1000 }, {}, 0, _renderTarget };
+        THROW_IF_FAILED(TextBuffer::Reflow(oldBuffer, newBuffer, std::nullopt, std::nullopt));
+    });
+}
+
+void MicroBenchmarks::StateMachineProcessString()
+{
+    StateMachine stateMachine{ std::make_unique<OutputStateMachineEngine>(std::make_unique<NullDispatch>()) };
+
+    // A colorized build log: SGR changes every few words.
+    std::wstring text;
+    for (auto i = 0; i < 100; ++i)
+    {
+        text.append(L"\x1b[32m[build]\x1b[m \x1b[1;35msrc/host/_stream.cpp\x1b[m(");
+        text.append(std::to_wstring(i));
+        text.append(L"): \x1b[1;31mwarning C4996\x1b[m: '\x1b[38;2;200;150;50mwcscpy\x1b[m': deprecated\r\n");
+    }
+
+    _measure(L"StateMachine::ProcessString", [&]() {
+        stateMachine.ProcessString(text);
+    });
+}
+
+void MicroBenchmarks::SearchFindNext()
+{
+    Terminal term;
+    term.Create({ BufferWidth, 30 }, 9001, _renderTarget);
+    for (auto i = 0; i < 5000; ++i)
+    {
+        term.Write(_line);
+    }
+    term.Write(L"needle");
+
+    _measure(L"Search::FindNext", [&]() {
+        Search search{ term, L"needle", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive, COORD{ 0, 0 } };
+        search.FindNext();
+    });
+}
+
+void MicroBenchmarks::U8U16()
+{
+    std::string text;
+    for (auto i = 0; i < 100; ++i)
+    {
+        text.append("plain ASCII text, followed by some that isn't: \xc3\xa4\xc3\xb6\xc3\xbc \xe2\x82\xac \xf0\x9f\x98\x80\r\n");
+    }
+    std::wstring out;
+
+    _measure(L"til::u8u16", [&]() {
+        THROW_IF_FAILED(til::u8u16(text, out));
+    });
+}
+
+void MicroBenchmarks::RleReplace()
+{
+    til::small_rle<TextAttribute, uint16_t, 1> attributes{ gsl::narrow_cast<uint16_t>(BufferWidth), TextAttribute{} };
+    size_t shift = 0;
+
+    _measure(L"til::basic_rle::replace", [&]() {
+        // Like a colorized line: a short run of a different color every few cells.
+        for (size_t x = 0; x + 4 < BufferWidth; x += 8)
+        {
+            const auto color = gsl::narrow_cast<WORD>((x + shift) % 16);
+            attributes.replace(gsl::narrow_cast<uint16_t>(x), gsl::narrow_cast<uint16_t>(x + 4), TextAttribute{ color });
+        }
+        shift = (shift + 1) % 16;
+    });
+}
+
+void MicroBenchmarks::BitmapSet()
+{
+    til::bitmap bitmap{ til::size{ BufferWidth, 30 } };
+
+    _measure(L"til::bitmap::set", [&]() {
+        // Like the renderer invalidating a few lines and a cursor every frame.
+        bitmap.reset_all();
+        bitmap.set(til::rectangle{ til::point{ 0, 3 }, til::size{ BufferWidth, 4 } });
+        bitmap.set(til::point{ 17, 20 });
+        bitmap.set(til::rectangle{ til::point{ 10, 25 }, til::size{ 40, 1 } });
+    });
+}
@@ -30,6 +30,7 @@ namespace TerminalCoreUnitTests
         til::color DefaultBackground() { return COLOR_BLACK; }
         bool SnapOnInput() { return false; }
         bool AltGrAliasing() { return true; }
+        bool PredictiveEcho() { return _predictiveEcho; }
         til::color CursorColor() { return COLOR_WHITE; }
         CursorStyle CursorShape() const noexcept { return CursorStyle::Vintage; }
         uint32_t CursorHeight() { return 42UL; }
@@ -57,6 +58,7 @@ namespace TerminalCoreUnitTests
         void DefaultBackground(til::color) {}
         void SnapOnInput(bool) {}
         void AltGrAliasing(bool) {}
+        void PredictiveEcho(bool value) { _predictiveEcho = value; }
         void CursorColor(til::color) {}
         void CursorShape(CursorStyle const&) noexcept {}
         void CursorHeight(uint32_t) {}
@@ -80,6 +82,7 @@ namespace TerminalCoreUnitTests
         bool _copyOnSelect{ false };
         bool _focusFollowMouse{ false };
         bool _suppressApplicationTitle{ false };
+        bool _predictiveEcho{ false };
         winrt::hstring _startingTitle;
     };
 }
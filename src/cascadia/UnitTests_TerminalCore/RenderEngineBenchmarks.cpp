@@ -0,0 +1,313 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+// This test class measures render engines in isolation. A Terminal serves as
+// the IRenderData, and a Renderer without a render thread drives one engine at
+// a time through a set of synthetic workloads. Only Renderer::PaintFrame is
+// measured; feeding the workload into the Terminal happens between frames.
+//
+// For every frame we record the wall clock time, the CPU cycles the thread
+// spent, and the number of heap allocations made through operator new. The
+// GDI and VT engines don't use the GPU, so there's no GPU time to report.
+//
+// These tests are ignored by default. Run them with:
+//   te.exe UnitTests_TerminalCore.dll /name:*RenderEngineBenchmarks* /p:DevTest=true
+// and optionally change the number of frames per workload with:
+//   /p:BenchmarkFrames=1000
+
+#include "pch.h"
+
+#include <random>
+
+// MicroBenchmarks.cpp reads the same counter, but only this file hooks operator new.
+#define ALLOCATION_COUNTER_HOOK_NEW
+#include "../../inc/test/AllocationCounter.hpp"
+
+#include "../renderer/base/Renderer.hpp"
+#include "../renderer/gdi/gdirenderer.hpp"
+#include "../renderer/vt/Xterm256Engine.hpp"
+
+#include "../cascadia/TerminalCore/Terminal.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Types;
+using namespace Microsoft::Terminal::Core;
+
+namespace TerminalCoreUnitTests
+{
+    class RenderEngineBenchmarks;
+};
+using namespace TerminalCoreUnitTests;
+
+class TerminalCoreUnitTests::RenderEngineBenchmarks final
+{
+    static const SHORT TerminalViewWidth = 120;
+    static const SHORT TerminalViewHeight = 30;
+
+    static constexpr size_t DefaultFrames = 300;
+    static constexpr std::wstring_view WindowClassName{ L"RenderEngineBenchmarks" };
+
+    TEST_CLASS(RenderEngineBenchmarks);
+
+    TEST_CLASS_SETUP(ClassSetup)
+    {
+        WNDCLASSEXW wc{};
+        wc.cbSize = sizeof(wc);
+        wc.lpfnWndProc = DefWindowProcW;
+        wc.hInstance = GetModuleHandleW(nullptr);
+        wc.lpszClassName = WindowClassName.data();
+        VERIFY_WIN32_BOOL_SUCCEEDED(RegisterClassExW(&wc));
+        return true;
+    }
+
+    TEST_CLASS_CLEANUP(ClassCleanup)
+    {
+        UnregisterClassW(WindowClassName.data(), GetModuleHandleW(nullptr));
+        return true;
+    }
+
+    TEST_METHOD_SETUP(MethodSetup)
+    {
+        // The renderer reads the viewport when it's created, which a Terminal
+        // has even before it's hooked up to its render target.
+        _term = std::make_unique<Terminal>();
+        _renderer = std::make_unique<Renderer>(_term.get(), nullptr, 0, nullptr);
+        _term->Create({ TerminalViewWidth, TerminalViewHeight }, 1000, *_renderer);
+
+        size_t frames = DefaultFrames;
+        RuntimeParameters::TryGetValue(L"BenchmarkFrames", frames);
+        _frames = std::max<size_t>(frames, 1);
+
+        return true;
+    }
+
+    TEST_METHOD_CLEANUP(MethodCleanup)
+    {
+        _renderer.reset();
+        _engine.reset();
+        _window.reset();
+        _term.reset();
+        return true;
+    }
+
+    BEGIN_TEST_METHOD(VtEngineBenchmark)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+    BEGIN_TEST_METHOD(GdiEngineBenchmark)
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Ignore[@DevTest=true]", L"false")
+        TEST_METHOD_PROPERTY(L"Ignore[default]", L"true")
+    END_TEST_METHOD()
+
+private:
+    struct Workload
+    {
+        std::wstring_view name;
+        std::function<void(Terminal&, std::mt19937&, size_t)> prepareFrame;
+    };
+
+    static const std::vector<Workload>& _Workloads();
+
+    void _AttachEngine(std::unique_ptr<IRenderEngine> engine);
+    void _RunWorkloads(const std::wstring_view engineName);
+
+    std::unique_ptr<Terminal> _term;
+    std::unique_ptr<Renderer> _renderer;
+    std::unique_ptr<IRenderEngine> _engine;
+    wil::unique_hwnd _window;
+    size_t _frames{ DefaultFrames };
+};
+
+// Method Description:
+// - The standard workloads. Each one is given the frame number and writes
+//   whatever should change in that frame into the terminal.
+const std::vector<RenderEngineBenchmarks::Workload>& RenderEngineBenchmarks::_Workloads()
+{
+    static const std::vector<Workload> workloads{
+        // Every cell of the viewport with a random foreground and background.
+        { L"FullScreenRandomColors", [](Terminal& term, std::mt19937& rng, size_t) {
+             std::wstring text{ L"\x1b[H" };
+             std::uniform_int_distribution<int> color{ 0, 255 };
+             std::uniform_int_distribution<int> letter{ L'!', L'~' };
+             for (auto row = 1; row <= TerminalViewHeight; ++row)
+             {
+                 text.append(fmt::format(L"\x1b[{};1H", row));
+                 for (auto col = 0; col < TerminalViewWidth; ++col)
+                 {
+                     text.append(fmt::format(L"\x1b[38;5;{};48;5;{}m", color(rng), color(rng)));
+                     text.push_back(static_cast<wchar_t>(letter(rng)));
+                 }
+             }
+             text.append(L"\x1b[m");
+             term.Write(text);
+         } },
+        // Like `tail -f` on a busy log: a few new lines, scrolling everything up.
+        { L"ScrollingText", [](Terminal& term, std::mt19937&, size_t frame) {
+             for (auto i = 0; i < 3; ++i)
+             {
+                 term.Write(fmt::format(L"\r\n[{:08}] INFO  Request handled in {} ms by worker {}", frame * 3 + i, (frame * 7 + i) % 250, i));
+             }
+         } },
+        // Wide CJK glyphs and emoji, which need font fallback and two cells each.
+        { L"CjkEmoji", [](Terminal& term, std::mt19937&, size_t frame) {
+             term.Write(fmt::format(L"\r\n{} 漢字とカタカナ、한국어 텍스트 😀🎉👍🏽🚀 繁體中文 ✨🔥 {}", frame, frame % 10));
+         } },
+        // Source code full of sequences that programming fonts turn into ligatures.
+        { L"LigatureCode", [](Terminal& term, std::mt19937&, size_t frame) {
+             term.Write(fmt::format(L"\r\n\x1b[35mif\x1b[m (a != b && c >= d || e <= f) {{ return x => x ?? y; }} \x1b[32m// --> <=> :: === !== /* {} */\x1b[m", frame));
+         } },
+        // Nothing changes but the cursor blinking on and off.
+        { L"CursorBlinkOnly", [](Terminal& term, std::mt19937&, size_t frame) {
+             term.SetCursorOn(frame % 2 == 0);
+         } },
+    };
+    return workloads;
+}
+
+// Method Description:
+// - Hands the engine to the renderer, gives it a font, and paints a first
+//   frame, so that setting up doesn't count towards the first workload.
+// Arguments:
+// - engine: the engine to benchmark.
+// Return Value:
+// - <none>
+void RenderEngineBenchmarks::_AttachEngine(std::unique_ptr<IRenderEngine> engine)
+{
+    _engine = std::move(engine);
+    _renderer->AddRenderEngine(_engine.get());
+
+    const FontInfoDesired desired{ L"Consolas", 0, FW_NORMAL, { 0, 16 }, CP_UTF8 };
+    FontInfo actual{ L"Consolas", 0, FW_NORMAL, { 0, 16 }, CP_UTF8 };
+    _renderer->TriggerFontChange(USER_DEFAULT_SCREEN_DPI, desired, actual);
+    _term->SetFontInfo(actual);
+
+    if (_window)
+    {
+        const auto fontSize = actual.GetSize();
+        VERIFY_WIN32_BOOL_SUCCEEDED(SetWindowPos(_window.get(),
+                                                 nullptr,
+                                                 0,
+                                                 0,
+                                                 TerminalViewWidth * fontSize.X,
+                                                 TerminalViewHeight * fontSize.Y,
+                                                 SWP_NOZORDER | SWP_NOACTIVATE | SWP_SHOWWINDOW));
+    }
+
+    _renderer->TriggerRedrawAll();
+    VERIFY_SUCCEEDED(_renderer->PaintFrame());
+}
+
+// Method Description:
+// - Runs every workload against the attached engine and logs, per workload,
+//   the mean, median, 95th percentile and worst frame.
+// Arguments:
+// - engineName: the name of the engine, for the log.
+// Return Value:
+// - <none>
+void RenderEngineBenchmarks::_RunWorkloads(const std::wstring_view engineName)
+{
+    using clock = std::chrono::steady_clock;
+
+    struct Frame
+    {
+        double us;
+        ULONG64 cycles;
+        size_t allocations;
+    };
+
+    for (const auto& workload : _Workloads())
+    {
+        // A fixed seed keeps runs comparable with each other.
+        std::mt19937 rng{ 42 };
+        std::vector<Frame> frames;
+        frames.reserve(_frames);
+
+        for (size_t i = 0; i < _frames; ++i)
+        {
+            workload.prepareFrame(*_term, rng, i);
+
+            ULONG64 cyclesBefore = 0;
+            ULONG64 cyclesAfter = 0;
+            QueryThreadCycleTime(GetCurrentThread(), &cyclesBefore);
+            const Microsoft::Console::Test::AllocationCounter allocations;
+            const auto start = clock::now();
+
+            VERIFY_SUCCEEDED(_renderer->PaintFrame());
+
+            const auto end = clock::now();
+            const auto allocationCount = allocations.Count();
+            QueryThreadCycleTime(GetCurrentThread(), &cyclesAfter);
+
+            frames.push_back({ std::chrono::duration<double, std::micro>(end - start).count(),
+                               cyclesAfter - cyclesBefore,
+                               allocationCount });
+        }
+
+        const auto statistic = [&](auto member) {
+            std::vector<double> values;
+            values.reserve(frames.size());
+            for (const auto& frame : frames)
+            {
+                values.push_back(static_cast<double>(frame.*member));
+            }
+            std::sort(values.begin(), values.end());
+
+            const auto mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+            const auto at = [&](double fraction) {
+                return values[std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()))];
+            };
+            return fmt::format(L"mean {:10.1f}  p50 {:10.1f}  p95 {:10.1f}  max {:10.1f}", mean, at(0.5), at(0.95), values.back());
+        };
+
+        Log::Comment(NoThrowString().Format(L"%s / %s: %zu frames",
+                                            std::wstring{ engineName }.c_str(),
+                                            std::wstring{ workload.name }.c_str(),
+                                            frames.size()));
+        Log::Comment(NoThrowString().Format(L"  time (us):   %s", statistic(&Frame::us).c_str()));
+        Log::Comment(NoThrowString().Format(L"  CPU cycles:  %s", statistic(&Frame::cycles).c_str()));
+        Log::Comment(NoThrowString().Format(L"  allocations: %s", statistic(&Frame::allocations).c_str()));
+    }
+}
+
+void RenderEngineBenchmarks::VtEngineBenchmark()
+{
+    auto engine = std::make_unique<Xterm256Engine>(wil::unique_hfile{ INVALID_HANDLE_VALUE }, Viewport::FromDimensions({}, { TerminalViewWidth, TerminalViewHeight }));
+
+    // Throw the output away. Only producing it is measured.
+    engine->SetTestCallback([](const char* const, size_t const) { return true; });
+
+    _AttachEngine(std::move(engine));
+    _RunWorkloads(L"VtEngine");
+}
+
+void RenderEngineBenchmarks::GdiEngineBenchmark()
+{
+    // The GDI engine doesn't paint into windows that aren't visible, so give it
+    // one that is, but without stealing the focus.
+    _window.reset(CreateWindowExW(WS_EX_NOACTIVATE | WS_EX_TOOLWINDOW,
+                                  WindowClassName.data(),
+                                  L"RenderEngineBenchmarks",
+                                  WS_POPUP,
+                                  0,
+                                  0,
+                                  1,
+                                  1,
+                                  nullptr,
+                                  nullptr,
+                                  GetModuleHandleW(nullptr),
+                                  nullptr));
+    VERIFY_IS_NOT_NULL(_window.get());
+
+    auto engine = std::make_unique<GdiEngine>();
+    VERIFY_SUCCEEDED(engine->SetHwnd(_window.get()));
+
+    _AttachEngine(std::move(engine));
+    _RunWorkloads(L"GdiEngine");
+}
@@ -52,8 +52,10 @@ namespace
         {
             _triggerScrollDelta = { *delta };
         };
+        virtual void TriggerScrollRegion(const Microsoft::Console::Types::Viewport&, const COORD* const){};
         virtual void TriggerCircling(){};
         void TriggerTitleChange(){};
+        void SynchronizedOutputChanged(const bool) noexcept {};
 
     private:
         std::optional<COORD> _triggerScrollDelta;
@@ -87,6 +89,7 @@ class TerminalCoreUnitTests::ScrollTest final
     TEST_CLASS(ScrollTest);
 
     TEST_METHOD(TestNotifyScrolling);
+    TEST_METHOD(TestScrollEventsCoalescedPerWrite);
 
     TEST_METHOD_SETUP(MethodSetup)
     {
@@ -118,6 +121,39 @@ private:
     std::shared_ptr<std::optional<ScrollBarNotification>> _scrollBarNotification;
 };
 
+void ScrollTest::TestScrollEventsCoalescedPerWrite()
+{
+    auto notifications = 0;
+    _term->SetScrollPositionChangedCallback([&](const int top, const int height, const int bottom) {
+        ++notifications;
+        ScrollBarNotification tmp;
+        tmp.ViewportTop = top;
+        tmp.ViewportHeight = height;
+        tmp.BufferHeight = bottom;
+        *_scrollBarNotification = { tmp };
+    });
+
+    std::wstring output;
+    for (auto i = 0; i < TerminalViewHeight * 3; ++i)
+    {
+        output += L"X\r\n";
+    }
+
+    Log::Comment(L"Every line past the first screen scrolls, but a write only notifies once");
+    _term->Write(output);
+    VERIFY_ARE_EQUAL(1, notifications);
+
+    Log::Comment(L"The notification is up to date with the end of the write");
+    const auto tmp = _scrollBarNotification->value();
+    VERIFY_ARE_EQUAL(TerminalViewHeight * 2 + 1, tmp.ViewportTop);
+    VERIFY_ARE_EQUAL(TerminalViewHeight, tmp.ViewportHeight);
+    VERIFY_ARE_EQUAL(TerminalViewHeight * 3 + 1, tmp.BufferHeight);
+
+    Log::Comment(L"A write that doesn't scroll doesn't notify");
+    _term->Write(L"X");
+    VERIFY_ARE_EQUAL(1, notifications);
+}
+
 void ScrollTest::TestNotifyScrolling()
 {
     // See https://github.com/microsoft/terminal/pull/5630
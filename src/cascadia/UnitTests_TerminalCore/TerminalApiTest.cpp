@@ -25,6 +25,7 @@ namespace TerminalCoreUnitTests
         TEST_CLASS(TerminalApiTest);
 
         TEST_METHOD(SetColorTableEntry);
+        TEST_METHOD(ColorChangesAreBatchedByWrite);
 
         TEST_METHOD(CursorVisibility);
         TEST_METHOD(CursorVisibilityViaStateMachine);
@@ -34,6 +35,10 @@ namespace TerminalCoreUnitTests
         // PrintString() is called with more code units than the buffer width.
         TEST_METHOD(PrintStringOfSurrogatePairs);
         TEST_METHOD(CheckDoubleWidthCursor);
+        TEST_METHOD(WriteDoesntSplitSurrogatePairs);
+        TEST_METHOD(PredictiveEchoIsReconciledByWrite);
+        TEST_METHOD(RepeatCharacterMatchesPrintedCharacters);
+        TEST_METHOD(WriteWrapsRowSegments);
 
         TEST_METHOD(AddHyperlink);
         TEST_METHOD(AddHyperlinkCustomId);
@@ -63,6 +68,31 @@ void TerminalApiTest::SetColorTableEntry()
     VERIFY_IS_FALSE(term.SetColorTableEntry(512, 100));
 }
 
+void TerminalApiTest::ColorChangesAreBatchedByWrite()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    term.Create({ 100, 100 }, 0, emptyRT);
+
+    std::vector<til::color> backgrounds;
+    term.SetBackgroundCallback([&](const til::color color) { backgrounds.push_back(color); });
+
+    Log::Comment(L"A palette set in one write is reported once, with the final colors.");
+    term.Write(L"\x1b]4;0;rgb:11/11/11;1;rgb:22/22/22\x1b\\\x1b]11;rgb:33/33/33\x1b\\\x1b]11;rgb:44/44/44\x1b\\");
+    VERIFY_ARE_EQUAL(1u, backgrounds.size());
+    VERIFY_ARE_EQUAL(til::color{ 0x44, 0x44, 0x44 }, backgrounds.back());
+    VERIFY_ARE_EQUAL(til::color{ 0x22, 0x22, 0x22 }, til::color{ term._colorTable.at(1) });
+
+    Log::Comment(L"A write without color changes doesn't report any.");
+    term.Write(L"text");
+    VERIFY_ARE_EQUAL(1u, backgrounds.size());
+
+    Log::Comment(L"Outside of a write, changes are reported right away.");
+    VERIFY_IS_TRUE(term.SetDefaultBackground(RGB(0x55, 0x55, 0x55)));
+    VERIFY_ARE_EQUAL(2u, backgrounds.size());
+    VERIFY_ARE_EQUAL(til::color{ 0x55, 0x55, 0x55 }, backgrounds.back());
+}
+
 // Terminal::_WriteBuffer used to enter infinite loops under certain conditions.
 // This test ensures that Terminal::_WriteBuffer doesn't get stuck when
 // PrintString() is called with more code units than the buffer width.
@@ -259,6 +289,136 @@ void TerminalApiTest::CheckDoubleWidthCursor()
     VERIFY_IS_TRUE(term.IsCursorDoubleWidth());
 }
 
+void TerminalApiTest::WriteDoesntSplitSurrogatePairs()
+{
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 100, 100 }, 0, renderTarget);
+
+    // Write() processes its input in slices of WriteSliceSize characters.
+    // Put a surrogate pair right across the first slice boundary and make
+    // sure it still ends up in the buffer as a single glyph. The carriage
+    // returns keep the cursor at the origin, so we know where it lands.
+    std::wstring text(Terminal::WriteSliceSize - 1, L'\r');
+    text.append(L"\xD801\xDC0C");
+    term.Write(text);
+
+    const auto& tbi = *(term._buffer);
+    VERIFY_ARE_EQUAL(L"\xD801\xDC0C", tbi.GetCellDataAt({ 0, 0 })->Chars());
+    VERIFY_ARE_EQUAL(1, tbi.GetCursor().GetPosition().X);
+}
+
+void TerminalApiTest::RepeatCharacterMatchesPrintedCharacters()
+{
+    DummyRenderTarget renderTarget;
+    Terminal repeated;
+    repeated.Create({ 10, 5 }, 0, renderTarget);
+    Terminal printed;
+    printed.Create({ 10, 5 }, 0, renderTarget);
+
+    // REP fills whole rows at once, so make it wrap across a few rows, scroll
+    // the buffer, and start off in the middle of a row. The wide character
+    // can't be filled in bulk, so it's printed one glyph at a time instead.
+    // The last run ends exactly at the right margin, so its row has to be
+    // marked as wrapped before the next character goes on the next row.
+    repeated.Write(L"ab\x1b[47b\x1b[31m\u4e2d\x1b[2b\r\nc\x1b[9bd");
+    printed.Write(L"a" + std::wstring(48, L'b') + L"\x1b[31m\u4e2d\u4e2d\u4e2d\r\nc" + std::wstring(9, L'c') + L"d");
+
+    const auto& expected = *(printed._buffer);
+    const auto& actual = *(repeated._buffer);
+    for (SHORT y = 0; y < 5; ++y)
+    {
+        for (SHORT x = 0; x < 10; ++x)
+        {
+            const auto expectedCell = expected.GetCellDataAt({ x, y });
+            const auto actualCell = actual.GetCellDataAt({ x, y });
+            VERIFY_ARE_EQUAL(expectedCell->Chars(), actualCell->Chars());
+            VERIFY_ARE_EQUAL(expectedCell->TextAttr(), actualCell->TextAttr());
+        }
+        VERIFY_ARE_EQUAL(expected.GetRowByOffset(y).WasWrapForced(), actual.GetRowByOffset(y).WasWrapForced());
+    }
+    VERIFY_ARE_EQUAL(expected.GetCursor().GetPosition(), actual.GetCursor().GetPosition());
+
+    const auto cursorRow = gsl::narrow_cast<size_t>(actual.GetCursor().GetPosition().Y);
+    VERIFY_IS_TRUE(actual.GetRowByOffset(cursorRow - 1).WasWrapForced());
+    VERIFY_IS_FALSE(actual.GetRowByOffset(cursorRow).WasWrapForced());
+}
+
+void TerminalApiTest::WriteWrapsRowSegments()
+{
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 10, 5 }, 0, renderTarget);
+
+    Log::Comment(L"A wide glyph that exactly fills the row stays on it.");
+    Log::Comment(L"A wide glyph with only the last column left goes to the next row.");
+    term.Write(L"12345678\u4e2d\u4e2dxy\r\n123456789\u4e2dz");
+
+    const auto& buffer = *(term._buffer);
+    VERIFY_ARE_EQUAL(L"8", std::wstring{ buffer.GetCellDataAt({ 7, 0 })->Chars() });
+    VERIFY_ARE_EQUAL(L"\u4e2d", std::wstring{ buffer.GetCellDataAt({ 8, 0 })->Chars() });
+    VERIFY_IS_TRUE(buffer.GetCellDataAt({ 8, 0 })->DbcsAttr().IsLeading());
+    VERIFY_IS_TRUE(buffer.GetCellDataAt({ 9, 0 })->DbcsAttr().IsTrailing());
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(0).WasWrapForced());
+
+    VERIFY_ARE_EQUAL(L"\u4e2d", std::wstring{ buffer.GetCellDataAt({ 0, 1 })->Chars() });
+    VERIFY_ARE_EQUAL(L"x", std::wstring{ buffer.GetCellDataAt({ 2, 1 })->Chars() });
+    VERIFY_ARE_EQUAL(L"y", std::wstring{ buffer.GetCellDataAt({ 3, 1 })->Chars() });
+    VERIFY_IS_FALSE(buffer.GetRowByOffset(1).WasWrapForced());
+
+    VERIFY_ARE_EQUAL(L"9", std::wstring{ buffer.GetCellDataAt({ 8, 2 })->Chars() });
+    VERIFY_ARE_EQUAL(L" ", std::wstring{ buffer.GetCellDataAt({ 9, 2 })->Chars() });
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(2).WasWrapForced());
+
+    VERIFY_ARE_EQUAL(L"\u4e2d", std::wstring{ buffer.GetCellDataAt({ 0, 3 })->Chars() });
+    VERIFY_ARE_EQUAL(L"z", std::wstring{ buffer.GetCellDataAt({ 2, 3 })->Chars() });
+    const COORD expectedCursor{ 3, 3 };
+    VERIFY_ARE_EQUAL(expectedCursor, buffer.GetCursor().GetPosition());
+}
+
+void TerminalApiTest::PredictiveEchoIsReconciledByWrite()
+{
+    DummyRenderTarget renderTarget;
+    Terminal term;
+    term.Create({ 100, 100 }, 0, renderTarget);
+
+    auto settings = winrt::make<MockTermSettings>(0, 100, 100);
+    settings.PredictiveEcho(true);
+    term.UpdateSettings(settings);
+    term.SetWriteInputCallback([](std::wstring_view) {});
+
+    Log::Comment(L"Typed characters are drawn as an overlay at the cursor.");
+    term.SendCharEvent(L'a', 0, {});
+    term.SendCharEvent(L'b', 0, {});
+    term.SendCharEvent(L'c', 0, {});
+    VERIFY_ARE_EQUAL(L"abc", term._predictedText);
+    {
+        const auto overlays = term.GetOverlays();
+        VERIFY_ARE_EQUAL(1u, overlays.size());
+        VERIFY_ARE_EQUAL(COORD{}, overlays.at(0).origin);
+    }
+
+    Log::Comment(L"A partial echo confirms the leading predictions.");
+    term.Write(L"a");
+    VERIFY_ARE_EQUAL(L"bc", term._predictedText);
+    VERIFY_ARE_EQUAL(1, term._predictionStart.X);
+
+    Log::Comment(L"The full echo confirms the rest.");
+    term.Write(L"bc");
+    VERIFY_IS_TRUE(term._predictedText.empty());
+    VERIFY_IS_TRUE(term.GetOverlays().empty());
+
+    Log::Comment(L"Output that doesn't match throws the predictions away.");
+    term.SendCharEvent(L'd', 0, {});
+    VERIFY_ARE_EQUAL(L"d", term._predictedText);
+    term.Write(L"*");
+    VERIFY_IS_TRUE(term._predictedText.empty());
+
+    Log::Comment(L"Alt+key isn't predicted.");
+    term.SendCharEvent(L'e', 0, ControlKeyStates::LeftAltPressed);
+    VERIFY_IS_TRUE(term._predictedText.empty());
+}
+
 void TerminalCoreUnitTests::TerminalApiTest::AddHyperlink()
 {
     // This is a nearly literal copy-paste of ScreenBufferTests::TestAddHyperlink, adapted for the Terminal
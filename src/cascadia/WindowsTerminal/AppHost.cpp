@@ -79,6 +79,7 @@ AppHost::AppHost() noexcept :
                                                 std::placeholders::_2));
     _window->MouseScrolled({ this, &AppHost::_WindowMouseWheeled });
     _window->WindowActivated({ this, &AppHost::_WindowActivated });
+    _window->WindowVisibilityChanged([this](bool showOrHide) { _logic.WindowVisibilityChanged(showOrHide); });
     _window->HotkeyPressed({ this, &AppHost::_GlobalHotkeyPressed });
     _window->NotifyTrayIconPressed({ this, &AppHost::_HandleTrayIconPressed });
     _window->SetAlwaysOnTop(_logic.GetInitialAlwaysOnTop());
@@ -245,6 +246,15 @@ void AppHost::Initialize()
 {
     _window->Initialize();
 
+    TraceLoggingWrite(
+        g_hWindowsTerminalProvider,
+        "StartupMilestone",
+        TraceLoggingDescription("Event emitted when a step of starting up is complete"),
+        TraceLoggingWideString(L"WindowCreated", "Milestone"),
+        TraceLoggingFloat64(::Microsoft::Console::Utils::MillisecondsSinceProcessStart(), "MillisecondsSinceProcessStart"),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+
     if (auto withWindow{ _logic.try_as<IInitializeWithWindow>() })
     {
         withWindow->Initialize(_window->GetHandle());
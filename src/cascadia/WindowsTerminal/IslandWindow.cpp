@@ -451,6 +451,15 @@ long IslandWindow::_calculateTotalSize(const bool isWidth, const long clientSize
     }
     case WM_SIZE:
     {
+        // Let the app know when we're minimized or restored, so it can stop
+        // rendering content nobody can see.
+        const bool isMinimized = wparam == SIZE_MINIMIZED;
+        if (isMinimized != _isMinimized)
+        {
+            _isMinimized = isMinimized;
+            _WindowVisibilityChangedHandlers(!isMinimized);
+        }
+
         if (wparam == SIZE_MINIMIZED && _isQuakeWindow)
         {
             _NotifyWindowHiddenHandlers();
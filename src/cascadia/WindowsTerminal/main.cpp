@@ -5,6 +5,7 @@
 #include "AppHost.h"
 #include "resource.h"
 #include "../types/inc/User32Utils.hpp"
+#include "../types/inc/utils.hpp"
 #include <WilErrorReporting.h>
 
 using namespace winrt;
@@ -96,6 +97,14 @@ int __stdcall wWinMain(HINSTANCE, HINSTANCE, LPWSTR, int)
         TraceLoggingDescription("Event emitted immediately on startup"),
         TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES),
         TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance));
+    TraceLoggingWrite(
+        g_hWindowsTerminalProvider,
+        "StartupMilestone",
+        TraceLoggingDescription("Event emitted when a step of starting up is complete"),
+        TraceLoggingWideString(L"wWinMain", "Milestone"),
+        TraceLoggingFloat64(::Microsoft::Console::Utils::MillisecondsSinceProcessStart(), "MillisecondsSinceProcessStart"),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TIL_KEYWORD_TRACE));
     ::Microsoft::Console::ErrorReporting::EnableFallbackFailureReporting(g_hWindowsTerminalProvider);
 
     // If Terminal is spawned by a shortcut that requests that it run in a new process group
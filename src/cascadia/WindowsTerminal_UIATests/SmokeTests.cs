@@ -118,6 +118,93 @@ namespace WindowsTerminal.UIA.Tests
             }
         }
 
+        [TestMethod]
+        [TestProperty("IsPGO", "true")]
+        public void RunTuiRedrawPowershell()
+        {
+            using (TerminalApp app = new TerminalApp(TestContext))
+            {
+                var root = app.GetRoot();
+
+                // Repaints the whole alternate screen in changing colors, like a full screen TUI does.
+                root.SendKeys("$e=[char]27; [Console]::Write(\"$e[?1049h\"); " +
+                              "foreach ($f in 1..300) { $s=''; foreach ($r in 1..25) { $s+=\"$e[$r;1H$e[3$(($f+$r)%8)m$e[4$(($f*$r)%8)m\"+('#'*80) }; [Console]::Write($s) }; " +
+                              "[Console]::Write(\"$e[m$e[?1049l\")");
+                root.SendKeys(Keys.Enter);
+                System.Threading.Thread.Sleep(15000);
+            }
+        }
+
+        [TestMethod]
+        [TestProperty("IsPGO", "true")]
+        public void RunResizePanesWithOutput()
+        {
+            using (TerminalApp app = new TerminalApp(TestContext))
+            {
+                var root = app.GetRoot();
+                root.SendKeys("1..3000 | % { \"line $_ \" * 12 }");
+                root.SendKeys(Keys.Enter);
+                Globals.WaitForLongTimeout();
+
+                // Splitting and resizing the panes reflows the buffer that was just filled.
+                root.SendKeys(Keys.LeftAlt + Keys.LeftShift + "+");
+                Globals.WaitForTimeout();
+                for (int i = 0; i < 10; ++i)
+                {
+                    root.SendKeys(Keys.LeftAlt + Keys.LeftShift + Keys.ArrowLeft);
+                    root.SendKeys(Keys.LeftAlt + Keys.LeftShift + Keys.ArrowRight);
+                }
+                root.SendKeys(Keys.LeftControl + Keys.LeftShift + "W");
+                Globals.WaitForLongTimeout();
+            }
+        }
+
+        [TestMethod]
+        [TestProperty("IsPGO", "true")]
+        public void RunSearchPowershell()
+        {
+            using (TerminalApp app = new TerminalApp(TestContext))
+            {
+                var root = app.GetRoot();
+                root.SendKeys("1..5000 | % { \"line $_ of the search training text\" }");
+                root.SendKeys(Keys.Enter);
+                Globals.WaitForLongTimeout();
+
+                root.SendKeys(Keys.LeftControl + Keys.LeftShift + "F");
+                Globals.WaitForTimeout();
+                root.SendKeys("training");
+                for (int i = 0; i < 20; ++i)
+                {
+                    root.SendKeys(Keys.Enter);
+                }
+                root.SendKeys(Keys.Escape);
+                Globals.WaitForLongTimeout();
+            }
+        }
+
+        [TestMethod]
+        [TestProperty("IsPGO", "true")]
+        public void RunPastePowershell()
+        {
+            using (TerminalApp app = new TerminalApp(TestContext))
+            {
+                var root = app.GetRoot();
+
+                // A single line, below the large paste warning's threshold, so that no dialog comes up.
+                root.SendKeys("Set-Clipboard -Value ('#' + 'paste training ' * 250)");
+                root.SendKeys(Keys.Enter);
+                Globals.WaitForTimeout();
+
+                for (int i = 0; i < 5; ++i)
+                {
+                    root.SendKeys(Keys.LeftControl + Keys.LeftShift + "V");
+                    root.SendKeys(Keys.Enter);
+                    Globals.WaitForTimeout();
+                }
+                Globals.WaitForLongTimeout();
+            }
+        }
+
         [TestMethod]
         [TestProperty("IsPGO", "true")]
         public void RunMakeKillPanes()
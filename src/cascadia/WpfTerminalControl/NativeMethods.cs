@@ -19,6 +19,9 @@ namespace Microsoft.Terminal.Wpf
         [UnmanagedFunctionPointer(CallingConvention.StdCall)]
         public delegate void WriteCallback([In, MarshalAs(UnmanagedType.LPWStr)] string data);
 
+        [UnmanagedFunctionPointer(CallingConvention.StdCall)]
+        public delegate void WriteBufferCallback(IntPtr data, UIntPtr length);
+
         public enum WindowMessage : int
         {
             /// <summary>
@@ -185,6 +188,12 @@ namespace Microsoft.Terminal.Wpf
         [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
         public static extern void TerminalSendOutput(IntPtr terminal, string lpdata);
 
+        [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
+        public static extern void TerminalSendOutputBuffer(IntPtr terminal, string data, UIntPtr length);
+
+        [DllImport("PublicTerminalCore.dll", CallingConvention = CallingConvention.StdCall)]
+        public static extern uint TerminalSendOutputUtf8Buffer(IntPtr terminal, byte[] data, UIntPtr length);
+
         [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
         public static extern uint TerminalTriggerResize(IntPtr terminal, short width, short height, out COORD dimensions);
 
@@ -203,6 +212,9 @@ namespace Microsoft.Terminal.Wpf
         [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
         public static extern void TerminalRegisterWriteCallback(IntPtr terminal, [MarshalAs(UnmanagedType.FunctionPtr)]WriteCallback callback);
 
+        [DllImport("PublicTerminalCore.dll", CallingConvention = CallingConvention.StdCall)]
+        public static extern void TerminalRegisterWriteBufferCallback(IntPtr terminal, [MarshalAs(UnmanagedType.FunctionPtr)]WriteBufferCallback callback);
+
         [DllImport("PublicTerminalCore.dll", CharSet = CharSet.Unicode, CallingConvention = CallingConvention.StdCall)]
         public static extern void TerminalUserScroll(IntPtr terminal, int viewTop);
 
@@ -0,0 +1,60 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- WeakReferenceCache.h
+
+Abstract:
+- A cache of winrt objects that only holds weak references to them. Whoever
+  asks for the same key while the object is still in use gets that same
+  object, rather than a new one. Once nobody uses it anymore, it's gone.
+- We use this to share (and decode once) the images that every tab and pane
+  of a profile loads from the same path.
+- XAML objects can only be used on the thread that created them, so the
+  caches for them need to be thread_local.
+--*/
+
+#pragma once
+
+template<typename TKey, typename TValue>
+class WeakReferenceCache
+{
+public:
+    // Method Description:
+    // - Get the object for the given key. If there isn't one, or it's been
+    //   released already, we'll call create to make a new one.
+    // Arguments:
+    // - key: the key to look up the object with
+    // - create: a function that returns a new object for this key
+    // Return Value:
+    // - the object for this key
+    template<typename TCreate>
+    TValue GetOrCreate(const TKey& key, TCreate&& create)
+    {
+        if (const auto it{ _entries.find(key) }; it != _entries.end())
+        {
+            if (auto value{ it->second.get() })
+            {
+                return value;
+            }
+        }
+
+        // Drop the entries for the objects that were released, so that the
+        // cache doesn't grow with every path that was ever used.
+        for (auto it{ _entries.begin() }; it != _entries.end();)
+        {
+            it = it->second.get() ? std::next(it) : _entries.erase(it);
+        }
+
+        TValue value{ create() };
+        if (value)
+        {
+            _entries.insert_or_assign(key, winrt::make_weak(value));
+        }
+        return value;
+    }
+
+private:
+    std::unordered_map<TKey, winrt::weak_ref<TValue>> _entries;
+};
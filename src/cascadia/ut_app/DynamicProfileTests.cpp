@@ -37,6 +37,9 @@ namespace TerminalAppUnitTests
         // Simple test of CascadiaSettings generating profiles with _LoadDynamicProfiles
         TEST_METHOD(TestSimpleGenerateMultipleGenerators);
 
+        // Generators run concurrently, but their profiles are still added in generator order
+        TEST_METHOD(TestGeneratorsKeepOrderWhenRunConcurrently);
+
         // Make sure we gen GUIDs for profiles without guids
         TEST_METHOD(TestGenGuidsForProfiles);
 
@@ -108,6 +111,46 @@ namespace TerminalAppUnitTests
         VERIFY_IS_FALSE(settings->_allProfiles.GetAt(1).HasGuid());
     }
 
+    void DynamicProfileTests::TestGeneratorsKeepOrderWhenRunConcurrently()
+    {
+        // gen0 finishes last, but its profile should still come first.
+        auto gen0 = std::make_unique<TestDynamicProfileGenerator>(L"Terminal.App.UnitTest.0");
+        gen0->pfnGenerate = []() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            std::vector<Profile> profiles;
+            Profile p0;
+            p0.Name(L"profile0");
+            profiles.push_back(p0);
+            return profiles;
+        };
+        auto gen1 = std::make_unique<TestDynamicProfileGenerator>(L"Terminal.App.UnitTest.1");
+        gen1->pfnGenerate = []() {
+            std::vector<Profile> profiles;
+            Profile p0;
+            p0.Name(L"profile1");
+            profiles.push_back(p0);
+            return profiles;
+        };
+        auto gen2 = std::make_unique<TestDynamicProfileGenerator>(L"Terminal.App.UnitTest.2");
+        gen2->pfnGenerate = []() -> std::vector<Profile> {
+            THROW_HR(E_FAIL);
+        };
+
+        auto settings = winrt::make_self<implementation::CascadiaSettings>(false);
+        settings->_profileGenerators.emplace_back(std::move(gen0));
+        settings->_profileGenerators.emplace_back(std::move(gen1));
+        settings->_profileGenerators.emplace_back(std::move(gen2));
+
+        settings->_LoadDynamicProfiles();
+        VERIFY_ARE_EQUAL(2u, settings->_allProfiles.Size());
+
+        VERIFY_ARE_EQUAL(L"profile0", settings->_allProfiles.GetAt(0).Name());
+        VERIFY_ARE_EQUAL(L"Terminal.App.UnitTest.0", settings->_allProfiles.GetAt(0).Source());
+
+        VERIFY_ARE_EQUAL(L"profile1", settings->_allProfiles.GetAt(1).Name());
+        VERIFY_ARE_EQUAL(L"Terminal.App.UnitTest.1", settings->_allProfiles.GetAt(1).Source());
+    }
+
     void DynamicProfileTests::TestGenGuidsForProfiles()
     {
         // We'll generate GUIDs in the Profile::Guid getter. We should make sure that
@@ -21,6 +21,12 @@ const std::wstring_view ConsoleArguments::HEIGHT_ARG = L"--height";
 const std::wstring_view ConsoleArguments::INHERIT_CURSOR_ARG = L"--inheritcursor";
 const std::wstring_view ConsoleArguments::RESIZE_QUIRK = L"--resizeQuirk";
 const std::wstring_view ConsoleArguments::WIN32_INPUT_MODE = L"--win32input";
+const std::wstring_view ConsoleArguments::PASSTHROUGH_MODE = L"--passthrough";
+const std::wstring_view ConsoleArguments::TEXT_STREAM_MODE = L"--textstream";
+const std::wstring_view ConsoleArguments::TERMINAL_REFLOW = L"--terminalReflow";
+const std::wstring_view ConsoleArguments::REPEAT_CHARACTER = L"--repeatCharacter";
+const std::wstring_view ConsoleArguments::VT_FLUSH_SIZE_ARG = L"--vtflushsize";
+const std::wstring_view ConsoleArguments::VT_FLUSH_LATENCY_ARG = L"--vtflushlatency";
 const std::wstring_view ConsoleArguments::FEATURE_ARG = L"--feature";
 const std::wstring_view ConsoleArguments::FEATURE_PTY_ARG = L"pty";
 const std::wstring_view ConsoleArguments::COM_SERVER_ARG = L"-Embedding";
@@ -480,6 +486,14 @@ void ConsoleArguments::s_ConsumeArg(_Inout_ std::vector<std::wstring>& args, _In
         {
             hr = s_GetArgumentValue(args, i, &_height);
         }
+        else if (arg == VT_FLUSH_SIZE_ARG)
+        {
+            hr = s_GetArgumentValue(args, i, &_vtFlushSize);
+        }
+        else if (arg == VT_FLUSH_LATENCY_ARG)
+        {
+            hr = s_GetArgumentValue(args, i, &_vtFlushLatency);
+        }
         else if (arg == FEATURE_ARG)
         {
             hr = s_HandleFeatureValue(args, i);
@@ -508,6 +522,30 @@ void ConsoleArguments::s_ConsumeArg(_Inout_ std::vector<std::wstring>& args, _In
             s_ConsumeArg(args, i);
             hr = S_OK;
         }
+        else if (arg == PASSTHROUGH_MODE)
+        {
+            _passthroughMode = true;
+            s_ConsumeArg(args, i);
+            hr = S_OK;
+        }
+        else if (arg == TEXT_STREAM_MODE)
+        {
+            _textStreamMode = true;
+            s_ConsumeArg(args, i);
+            hr = S_OK;
+        }
+        else if (arg == TERMINAL_REFLOW)
+        {
+            _terminalReflow = true;
+            s_ConsumeArg(args, i);
+            hr = S_OK;
+        }
+        else if (arg == REPEAT_CHARACTER)
+        {
+            _repeatCharacter = true;
+            s_ConsumeArg(args, i);
+            hr = S_OK;
+        }
         else if (arg == CLIENT_COMMANDLINE_ARG)
         {
             // Everything after this is the explicit commandline
@@ -663,6 +701,30 @@ bool ConsoleArguments::IsWin32InputModeEnabled() const
 {
     return _win32InputMode;
 }
+bool ConsoleArguments::IsPassthroughModeEnabled() const
+{
+    return _passthroughMode;
+}
+bool ConsoleArguments::IsTextStreamModeEnabled() const
+{
+    return _textStreamMode;
+}
+bool ConsoleArguments::IsTerminalReflowEnabled() const
+{
+    return _terminalReflow;
+}
+bool ConsoleArguments::IsRepeatCharacterEnabled() const
+{
+    return _repeatCharacter;
+}
+short ConsoleArguments::GetVtFlushSize() const
+{
+    return _vtFlushSize;
+}
+short ConsoleArguments::GetVtFlushLatency() const
+{
+    return _vtFlushLatency;
+}
 
 #ifdef UNIT_TESTING
 // Method Description:
@@ -55,6 +55,12 @@ public:
     bool GetInheritCursor() const;
     bool IsResizeQuirkEnabled() const;
     bool IsWin32InputModeEnabled() const;
+    bool IsPassthroughModeEnabled() const;
+    bool IsTextStreamModeEnabled() const;
+    bool IsTerminalReflowEnabled() const;
+    bool IsRepeatCharacterEnabled() const;
+    short GetVtFlushSize() const;
+    short GetVtFlushLatency() const;
 
 #ifdef UNIT_TESTING
     void EnableConptyModeForTests();
@@ -74,6 +80,12 @@ public:
     static const std::wstring_view INHERIT_CURSOR_ARG;
     static const std::wstring_view RESIZE_QUIRK;
     static const std::wstring_view WIN32_INPUT_MODE;
+    static const std::wstring_view PASSTHROUGH_MODE;
+    static const std::wstring_view TEXT_STREAM_MODE;
+    static const std::wstring_view TERMINAL_REFLOW;
+    static const std::wstring_view REPEAT_CHARACTER;
+    static const std::wstring_view VT_FLUSH_SIZE_ARG;
+    static const std::wstring_view VT_FLUSH_LATENCY_ARG;
     static const std::wstring_view FEATURE_ARG;
     static const std::wstring_view FEATURE_PTY_ARG;
     static const std::wstring_view COM_SERVER_ARG;
@@ -140,6 +152,12 @@ private:
     bool _inheritCursor;
     bool _resizeQuirk{ false };
     bool _win32InputMode{ false };
+    bool _passthroughMode{ false };
+    bool _textStreamMode{ false };
+    bool _terminalReflow{ false };
+    bool _repeatCharacter{ false };
+    short _vtFlushSize{ 0 };
+    short _vtFlushLatency{ 0 };
 
     [[nodiscard]] HRESULT _GetClientCommandline(_Inout_ std::vector<std::wstring>& args,
                                                 const size_t index,
@@ -12,7 +12,9 @@ using namespace Microsoft::Console::Interactivity;
 CursorBlinker::CursorBlinker() :
     _hCaretBlinkTimer(INVALID_HANDLE_VALUE),
     _hCaretBlinkTimerQueue(THROW_LAST_ERROR_IF_NULL(CreateTimerQueue())),
-    _uCaretBlinkTime(INFINITE) // default to no blink
+    _uCaretBlinkTime(INFINITE), // default to no blink
+    _uCaretBlinkTimeout(INFINITE),
+    _cBlinksLeft(0)
 {
 }
 
@@ -28,6 +30,7 @@ void CursorBlinker::UpdateSystemMetrics()
 {
     // This can be -1 in a TS session
     _uCaretBlinkTime = ServiceLocator::LocateSystemConfigurationProvider()->GetCaretBlinkTime();
+    _uCaretBlinkTimeout = ServiceLocator::LocateSystemConfigurationProvider()->GetCaretBlinkTimeout();
 
     // If animations are disabled, or the blink rate is infinite, blinking is not allowed.
     BOOL animationsEnabled = TRUE;
@@ -39,6 +42,7 @@ void CursorBlinker::UpdateSystemMetrics()
 void CursorBlinker::SettingsChanged()
 {
     DWORD const dwCaretBlinkTime = ServiceLocator::LocateSystemConfigurationProvider()->GetCaretBlinkTime();
+    _uCaretBlinkTimeout = ServiceLocator::LocateSystemConfigurationProvider()->GetCaretBlinkTimeout();
 
     if (dwCaretBlinkTime != _uCaretBlinkTime)
     {
@@ -55,9 +59,24 @@ void CursorBlinker::FocusEnd()
 
 void CursorBlinker::FocusStart()
 {
+    _RestartIdleTimeout();
     SetCaretTimer();
 }
 
+// Routine Description:
+// - Lets the cursor blink for another caret timeout's worth of blinks.
+void CursorBlinker::_RestartIdleTimeout() noexcept
+{
+    if (_uCaretBlinkTimeout == INFINITE || _uCaretBlinkTime == 0 || _uCaretBlinkTime == INFINITE)
+    {
+        _cBlinksLeft = 0;
+    }
+    else
+    {
+        _cBlinksLeft = std::max(_uCaretBlinkTimeout / _uCaretBlinkTime, 2u);
+    }
+}
+
 // Routine Description:
 // - This routine is called when the timer in the console with the focus goes off.
 //   It blinks the cursor and also toggles the rendition of any blinking attributes.
@@ -114,6 +133,14 @@ void CursorBlinker::TimerRoutine(SCREEN_INFORMATION& ScreenInfo)
         }
     }
 
+    // Anything that moved the cursor or wrote to the buffer restarts the
+    // idle timeout (see _cBlinksLeft below).
+    if (cursor.GetDelay() || til::point{ cursor.GetPosition() } != _lastCursorPosition)
+    {
+        _lastCursorPosition = til::point{ cursor.GetPosition() };
+        _RestartIdleTimeout();
+    }
+
     // If the DelayCursor flag has been set, wait one more tick before toggle.
     // This is used to guarantee the cursor is on for a finite period of time
     // after a move and off for a finite period of time after a WriteString.
@@ -132,6 +159,19 @@ void CursorBlinker::TimerRoutine(SCREEN_INFORMATION& ScreenInfo)
         goto DoBlinkingRenditionAndScroll;
     }
 
+    // Once nothing has happened for the system's caret timeout, leave the
+    // cursor on instead of invalidating it on every tick. The timer keeps
+    // running for blinking text and auto scrolling, which are cheap when
+    // there's neither.
+    if (_uCaretBlinkTimeout != INFINITE && _cBlinksLeft == 0 && cursor.IsOn())
+    {
+        goto DoBlinkingRenditionAndScroll;
+    }
+    if (_cBlinksLeft != 0)
+    {
+        --_cBlinksLeft;
+    }
+
     // Blink only if the cursor isn't turned off via the API
     if (cursor.IsVisible())
     {
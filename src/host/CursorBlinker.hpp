@@ -33,7 +33,11 @@ namespace Microsoft::Console
         HANDLE _hCaretBlinkTimer; // timer used to periodically blink the cursor
         HANDLE _hCaretBlinkTimerQueue; // timer queue where the blink timer lives
         UINT _uCaretBlinkTime;
+        UINT _uCaretBlinkTimeout;
+        UINT _cBlinksLeft; // blinks until the cursor stops blinking, after the last activity
+        til::point _lastCursorPosition;
         void SetCaretTimer();
         void KillCaretTimer();
+        void _RestartIdleTimeout() noexcept;
     };
 }
@@ -4,6 +4,7 @@
 #include "precomp.h"
 
 #include "PtySignalInputThread.hpp"
+#include "VtInputThread.hpp"
 
 #include "output.h"
 #include "handle.h"
@@ -87,6 +88,15 @@ void PtySignalInputThread::ConnectConsole() noexcept
             ResizeWindowData resizeMsg = { 0 };
             _GetData(&resizeMsg, sizeof(resizeMsg));
 
+            // Dragging the window sends a storm of resizes. Every one of them
+            // reflows the buffer and repaints the screen, so if more of them
+            // are already waiting in the pipe, skip ahead to the last one.
+            while (_IsResizePending())
+            {
+                _GetData(&signalId, sizeof(signalId));
+                _GetData(&resizeMsg, sizeof(resizeMsg));
+            }
+
             LockConsole();
             auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
@@ -128,6 +138,27 @@ void PtySignalInputThread::_DoResizeWindow(const ResizeWindowData& data)
     }
 }
 
+// Method Description:
+// - Checks whether a complete resize message is waiting in the pipe, without
+//   removing it or blocking.
+// Arguments:
+// - <none>
+// Return Value:
+// - True if the next _GetData calls will return a whole resize message.
+bool PtySignalInputThread::_IsResizePending() const noexcept
+{
+    PtySignal signalId{};
+    DWORD dwRead = 0;
+    DWORD dwAvailable = 0;
+    if (!PeekNamedPipe(_hFile.get(), &signalId, sizeof(signalId), &dwRead, &dwAvailable, nullptr))
+    {
+        return false;
+    }
+    return dwRead == sizeof(signalId) &&
+           signalId == PtySignal::ResizeWindow &&
+           dwAvailable >= sizeof(signalId) + sizeof(ResizeWindowData);
+}
+
 // Method Description:
 // - Retrieves bytes from the file stream and exits or throws errors should the pipe state
 //   be compromised.
@@ -176,11 +207,12 @@ bool PtySignalInputThread::_GetData(_Out_writes_bytes_(cbBuffer) void* const pBu
     // 0 is the right value, https://blogs.msdn.microsoft.com/oldnewthing/20040223-00/?p=40503
     DWORD dwThreadId = 0;
 
+    // Like the VT input thread, this one doesn't need the default stack size.
     hThread = CreateThread(nullptr,
-                           0,
+                           VtInputThread::ThreadStackReservation,
                            PtySignalInputThread::StaticThreadProc,
                            this,
-                           0,
+                           STACK_SIZE_PARAM_IS_A_RESERVATION,
                            &dwThreadId);
 
     RETURN_LAST_ERROR_IF_NULL(hThread);
@@ -46,6 +46,7 @@ namespace Microsoft::Console
 
         [[nodiscard]] HRESULT _InputThread();
         bool _GetData(_Out_writes_bytes_(cbBuffer) void* const pBuffer, const DWORD cbBuffer);
+        bool _IsResizePending() const noexcept;
         void _DoResizeWindow(const ResizeWindowData& data);
         void _Shutdown();
 
@@ -91,6 +91,16 @@ void ScreenBufferRenderTarget::TriggerScroll(const COORD* const pcoordDelta)
     }
 }
 
+void ScreenBufferRenderTarget::TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const COORD* const pcoordDelta)
+{
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    const auto* pActive = &ServiceLocator::LocateGlobals().getConsoleInformation().GetActiveOutputBuffer().GetActiveBuffer();
+    if (pRenderer != nullptr && pActive == &_owner)
+    {
+        pRenderer->TriggerScrollRegion(region, pcoordDelta);
+    }
+}
+
 void ScreenBufferRenderTarget::TriggerCircling()
 {
     auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
@@ -110,3 +120,15 @@ void ScreenBufferRenderTarget::TriggerTitleChange()
         pRenderer->TriggerTitleChange();
     }
 }
+
+void ScreenBufferRenderTarget::SynchronizedOutputChanged(const bool enabled) noexcept
+{
+    // Synchronized output isn't a property of any one buffer: an application
+    // may well switch to the alternate buffer in the middle of an update.
+    // So unlike the triggers above, this doesn't check which buffer is active.
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    if (pRenderer != nullptr)
+    {
+        pRenderer->SynchronizedOutputChanged(enabled);
+    }
+}
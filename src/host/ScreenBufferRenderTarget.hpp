@@ -37,8 +37,10 @@ public:
     void TriggerSelection() override;
     void TriggerScroll() override;
     void TriggerScroll(const COORD* const pcoordDelta) override;
+    void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const COORD* const pcoordDelta) override;
     void TriggerCircling() override;
     void TriggerTitleChange() override;
+    void SynchronizedOutputChanged(const bool enabled) noexcept override;
 
 private:
     SCREEN_INFORMATION& _owner;
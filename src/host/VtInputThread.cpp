@@ -72,14 +72,20 @@ VtInputThread::VtInputThread(_In_ wil::unique_hfile hPipe,
 
     try
     {
-        std::wstring wstr{};
-        auto hr = til::u8u16(u8Str, wstr, _u8State);
+        // _wstr keeps its allocation between calls.
+        auto hr = til::u8u16(u8Str, _wstr, _u8State);
         // If we hit a parsing error, eat it. It's bad utf-8, we can't do anything with it.
         if (FAILED(hr))
         {
             return S_FALSE;
         }
-        _pInputStateMachine->ProcessString(wstr);
+        // A single read can hold thousands of keys, for instance a
+        // paste in win32-input-mode. Wake up readers once for all of them.
+        auto& inputBuffer = *ServiceLocator::LocateGlobals().getConsoleInformation().pInputBuffer;
+        inputBuffer.StartDeferringWakeups();
+        auto endDeferWakeups = wil::scope_exit([&]() noexcept { inputBuffer.EndDeferringWakeups(); });
+
+        _pInputStateMachine->ProcessString(_wstr);
     }
     CATCH_RETURN();
 
@@ -108,9 +114,8 @@ DWORD WINAPI VtInputThread::StaticVtInputThreadProc(_In_ LPVOID lpParameter)
 // - <none>
 void VtInputThread::DoReadInput(const bool throwOnFail)
 {
-    char buffer[256];
     DWORD dwRead = 0;
-    bool fSuccess = !!ReadFile(_hFile.get(), buffer, ARRAYSIZE(buffer), &dwRead, nullptr);
+    bool fSuccess = !!ReadFile(_hFile.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), &dwRead, nullptr);
 
     // If we failed to read because the terminal broke our pipe (usually due
     //      to dying itself), close gracefully with ERROR_BROKEN_PIPE.
@@ -123,7 +128,7 @@ void VtInputThread::DoReadInput(const bool throwOnFail)
         return;
     }
 
-    HRESULT hr = _HandleRunInput({ buffer, gsl::narrow_cast<size_t>(dwRead) });
+    HRESULT hr = _HandleRunInput({ _buffer.data(), gsl::narrow_cast<size_t>(dwRead) });
     if (FAILED(hr))
     {
         if (throwOnFail)
@@ -156,6 +161,14 @@ DWORD VtInputThread::_InputThread()
     return _exitResult;
 }
 
+// Method Description:
+// - Returns whether we're being called from the VT input thread, for instance
+//      by the InteractDispatch while it handles the input we read.
+bool VtInputThread::IsCurrentThread() const noexcept
+{
+    return _hThread && GetCurrentThreadId() == _dwThreadId;
+}
+
 // Method Description:
 // - Starts the VT input thread.
 [[nodiscard]] HRESULT VtInputThread::Start()
@@ -167,10 +180,10 @@ DWORD VtInputThread::_InputThread()
     DWORD dwThreadId = 0;
 
     hThread = CreateThread(nullptr,
-                           0,
+                           ThreadStackReservation,
                            VtInputThread::StaticVtInputThreadProc,
                            this,
-                           0,
+                           STACK_SIZE_PARAM_IS_A_RESERVATION,
                            &dwThreadId);
 
     RETURN_LAST_ERROR_IF_NULL(hThread);
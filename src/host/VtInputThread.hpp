@@ -26,6 +26,12 @@ namespace Microsoft::Console
         [[nodiscard]] HRESULT Start();
         static DWORD WINAPI StaticVtInputThreadProc(_In_ LPVOID lpParameter);
         void DoReadInput(const bool throwOnFail);
+        bool IsCurrentThread() const noexcept;
+
+        // The thread only parses input and writes it to the input buffer, which
+        // is nowhere near the default 1MB of stack. A smaller reservation keeps
+        // the address space used by each pseudoconsole down.
+        static constexpr SIZE_T ThreadStackReservation = 256 * 1024;
 
     private:
         [[nodiscard]] HRESULT _HandleRunInput(const std::string_view u8Str);
@@ -40,5 +46,12 @@ namespace Microsoft::Console
 
         std::unique_ptr<Microsoft::Console::VirtualTerminal::StateMachine> _pInputStateMachine;
         til::u8state _u8State;
+
+        // Input is read in chunks of this many bytes. Since ReadFile returns
+        // whatever is available, a large paste is processed with one console
+        // lock per chunk, instead of one every few characters.
+        static constexpr size_t _bufferSize = 4096;
+        std::array<char, _bufferSize> _buffer{};
+        std::wstring _wstr;
     };
 }
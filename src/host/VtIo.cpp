@@ -10,6 +10,7 @@
 
 #include "../renderer/base/renderer.hpp"
 #include "../types/inc/utils.hpp"
+#include "handle.h" // LockConsole
 #include "input.h" // ProcessCtrlEvents
 #include "output.h" // CloseConsoleProcessState
 
@@ -69,7 +70,13 @@ VtIo::VtIo() :
 {
     _lookingForCursorPosition = pArgs->GetInheritCursor();
     _resizeQuirk = pArgs->IsResizeQuirkEnabled();
+    _terminalReflow = pArgs->IsTerminalReflowEnabled();
+    _repeatCharacter = pArgs->IsRepeatCharacterEnabled();
     _win32InputMode = pArgs->IsWin32InputModeEnabled();
+    _passthrough = pArgs->IsPassthroughModeEnabled();
+    _textStream = pArgs->IsTextStreamModeEnabled();
+    _flushSize = std::max<short>(pArgs->GetVtFlushSize(), 0);
+    _flushLatency = std::chrono::milliseconds{ std::max<short>(pArgs->GetVtFlushLatency(), 0) };
 
     // If we were already given VT handles, set up the VT IO engine to use those.
     if (pArgs->InConptyMode())
@@ -146,7 +153,14 @@ VtIo::VtIo() :
             _pVtInputThread = std::make_unique<VtInputThread>(std::move(_hInput), _lookingForCursorPosition);
         }
 
-        if (IsValidHandle(_hOutput.get()))
+        // In text stream mode the client's text goes straight to the output pipe
+        // as it's written (see WriteTextStream), and there's no VT renderer.
+        _textStream = _textStream && IsValidHandle(_hOutput.get());
+        if (_textStream)
+        {
+            _passthrough = false;
+        }
+        else if (IsValidHandle(_hOutput.get()))
         {
             Viewport initialViewport = Viewport::FromDimensions({ 0, 0 },
                                                                 gci.GetWindowSize().X,
@@ -174,6 +188,14 @@ VtIo::VtIo() :
             {
                 _pVtRenderEngine->SetTerminalOwner(this);
                 _pVtRenderEngine->SetResizeQuirk(_resizeQuirk);
+                _pVtRenderEngine->SetShadowFrameDiffing(true);
+                _pVtRenderEngine->SetFlushPolicy(_flushSize, _flushLatency);
+                _pVtRenderEngine->SetRepeatCharacter(_repeatCharacter);
+
+                // Passthrough writes the client's output as UTF-8, verbatim.
+                // That's only what the other end expects in the default mode.
+                _passthrough = _passthrough && _IoMode == VtIoMode::XTERM_256;
+                _pVtRenderEngine->SetPassthroughMode(_passthrough);
             }
         }
     }
@@ -212,7 +234,9 @@ bool VtIo::IsUsingVt() const
         try
         {
             g.pRender->AddRenderEngine(_pVtRenderEngine.get());
-            g.getConsoleInformation().GetActiveOutputBuffer().SetTerminalConnection(_pVtRenderEngine.get());
+            // In passthrough mode, the terminal already gets every sequence
+            // the state machine would pass through to it.
+            g.getConsoleInformation().GetActiveOutputBuffer().SetTerminalConnection(_passthrough ? nullptr : _pVtRenderEngine.get());
             g.getConsoleInformation().GetActiveInputBuffer()->SetTerminalConnection(_pVtRenderEngine.get());
         }
         CATCH_RETURN();
@@ -222,27 +246,44 @@ bool VtIo::IsUsingVt() const
     // win32-input-mode from them. This will enable the connected terminal to
     // send us full INPUT_RECORDs as input. If the terminal doesn't understand
     // this sequence, it'll just ignore it.
-    if (_win32InputMode)
+    if (_win32InputMode && _pVtRenderEngine)
     {
         LOG_IF_FAILED(_pVtRenderEngine->RequestWin32Input());
     }
 
     // MSFT: 15813316
     // If the terminal application wants us to inherit the cursor position,
-    //  we're going to emit a VT sequence to ask for the cursor position, then
-    //  read input until we get a response. Terminals who request this behavior
-    //  but don't respond will hang.
-    // If we get a response, the InteractDispatch will call SetCursorPosition,
-    //      which will call to our VtIo::SetCursorPosition method.
+    //  we're going to emit a VT sequence to ask for the cursor position.
+    //  We don't wait for the response here, the client can connect and write
+    //  right away. The renderer holds back painting until the response arrives,
+    //  or until _cursorInheritanceTimeout passes for terminals that don't respond.
+    // If we get a response, the VT input thread's InteractDispatch will call
+    //      SetCursorPosition, which will call to our VtIo::SetCursorPosition method.
     // We need both handles for this initialization to work. If we don't have
     //      both, we'll skip it. They either aren't going to be reading output
     //      (so they can't get the DSR) or they can't write the response to us.
     if (_lookingForCursorPosition && _pVtRenderEngine && _pVtInputThread)
     {
-        LOG_IF_FAILED(_pVtRenderEngine->RequestCursor());
-        while (_lookingForCursorPosition)
+        try
         {
-            _pVtInputThread->DoReadInput(false);
+            _cursorInheritanceTimer.reset(CreateThreadpoolTimer(&_CursorInheritanceTimerCallback, this, nullptr));
+            THROW_LAST_ERROR_IF(!_cursorInheritanceTimer);
+
+            _pVtRenderEngine->SetInheritingCursor(true);
+            LOG_IF_FAILED(_pVtRenderEngine->RequestCursor());
+            _cursorRequestTime = std::chrono::steady_clock::now();
+
+            // A negative due time is relative to now, in 100ns units.
+            const auto delay = -std::chrono::duration_cast<std::chrono::duration<int64_t, std::ratio<1, 10000000>>>(_cursorInheritanceTimeout).count();
+            FILETIME dueTime;
+            memcpy(&dueTime, &delay, sizeof(delay));
+            SetThreadpoolTimer(_cursorInheritanceTimer.get(), &dueTime, 0, 0);
+        }
+        catch (...)
+        {
+            LOG_CAUGHT_EXCEPTION();
+            _pVtRenderEngine->SetInheritingCursor(false);
+            _cursorInheritanceExpired = true;
         }
     }
 
@@ -317,25 +358,103 @@ bool VtIo::IsUsingVt() const
 // Method Description:
 // - Attempts to set the initial cursor position, if we're looking for it.
 //      If we're not trying to inherit the cursor, does nothing.
+// - Only the terminal's response to our request (which the VT input thread
+//      reads) is inherited. If we already gave up on it, because it took too
+//      long or because the client has already moved the cursor, the response
+//      is swallowed instead.
+// - This is called with the console lock held.
 // Arguments:
 // - coordCursor: The initial position of the cursor.
 // Return Value:
-// - S_OK if we successfully inherited the cursor or did nothing, else an
-//      appropriate HRESULT
+// - S_OK if we successfully inherited the cursor or did nothing, S_FALSE if
+//      this was the response to our request, but the caller shouldn't move
+//      the cursor there, else an appropriate HRESULT
 [[nodiscard]] HRESULT VtIo::SetCursorPosition(const COORD coordCursor)
 {
-    HRESULT hr = S_OK;
-    if (_lookingForCursorPosition)
+    if (!_lookingForCursorPosition || !_pVtInputThread || !_pVtInputThread->IsCurrentThread())
+    {
+        return S_OK;
+    }
+
+    _lookingForCursorPosition = false;
+
+    // Cancel the timer, without waiting for its callback: it needs the lock we're holding.
+    if (_cursorInheritanceTimer)
+    {
+        SetThreadpoolTimer(_cursorInheritanceTimer.get(), nullptr, 0, 0);
+    }
+
+    if (_cursorInheritanceExpired)
+    {
+        return S_FALSE;
+    }
+
+    // The client's output so far was laid out from the top of the buffer.
+    // If it moved the cursor already, moving it again would put the rest of
+    // its output in the wrong place, so we give up and paint as usual instead.
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    const auto inherit = gci.GetActiveOutputBuffer().GetTextBuffer().GetCursor().GetPosition() == COORD{ 0, 0 };
+
+    auto hr = S_OK;
+    if (inherit && _pVtRenderEngine)
+    {
+        hr = _pVtRenderEngine->InheritCursor(coordCursor);
+    }
+    _EndCursorInheritance(inherit);
+
+    RETURN_IF_FAILED(hr);
+    return inherit ? S_OK : S_FALSE;
+}
+
+// Method Description:
+// - Stops holding back the renderer for the cursor position, and lets it
+//      paint what the client wrote in the meantime.
+// - This is called with the console lock held.
+// Arguments:
+// - inherited: whether we inherited the cursor position.
+// Return Value:
+// - <none>
+void VtIo::_EndCursorInheritance(const bool inherited)
+{
+    _cursorInheritanceExpired = true;
+
+    const auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _cursorRequestTime);
+    Tracing::s_TraceCursorInheritance(waited, inherited);
+
+    if (_pVtRenderEngine)
     {
-        if (_pVtRenderEngine)
+        _pVtRenderEngine->SetInheritingCursor(false);
+
+        // Nothing may have been invalidated since the client stopped writing,
+        // so give the renderer a reason to paint what's been kept.
+        auto& g = ServiceLocator::LocateGlobals();
+        if (g.pRender)
         {
-            hr = _pVtRenderEngine->InheritCursor(coordCursor);
+            const auto position = g.getConsoleInformation().GetActiveOutputBuffer().GetTextBuffer().GetCursor().GetPosition();
+            g.pRender->TriggerRedrawCursor(&position);
         }
+    }
+}
+
+// Method Description:
+// - Called on the thread pool when the terminal didn't tell us where its
+//      cursor is within _cursorInheritanceTimeout. We stop waiting for it,
+//      and paint as if we weren't asked to inherit the cursor. If the response
+//      does arrive later, SetCursorPosition will swallow it.
+void CALLBACK VtIo::_CursorInheritanceTimerCallback(PTP_CALLBACK_INSTANCE /*instance*/, PVOID context, PTP_TIMER /*timer*/) noexcept
+try
+{
+    const auto self = static_cast<VtIo*>(context);
+
+    LockConsole();
+    auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
 
-        _lookingForCursorPosition = false;
+    if (self->_lookingForCursorPosition && !self->_cursorInheritanceExpired)
+    {
+        self->_EndCursorInheritance(false);
     }
-    return hr;
 }
+CATCH_LOG()
 
 void VtIo::CloseInput()
 {
@@ -368,7 +487,7 @@ void VtIo::_ShutdownIfNeeded()
 {
     // The callers should have both acquired the _shutdownLock at this point -
     //      we dont want a race on who is actually responsible for closing it.
-    if (_objectsCreated && _pVtInputThread == nullptr && _pVtRenderEngine == nullptr)
+    if (_objectsCreated && _pVtInputThread == nullptr && _pVtRenderEngine == nullptr && !_hOutput)
     {
         // At this point, we no longer have a renderer or inthread. So we've
         //      effectively been disconnected from the terminal.
@@ -456,6 +575,143 @@ bool VtIo::IsResizeQuirkEnabled() const
     return _resizeQuirk;
 }
 
+// Method Description:
+// - Returns true if the terminal reflows its own buffer when it's resized.
+//   We then don't reflow ours: the terminal already has the reflowed text,
+//   and whatever we would come up with on our own frequently disagrees with
+//   it, which only made us send the whole viewport again. Instead we cut or
+//   extend our rows as they are, like a console with wrapping disabled does.
+// - This only makes sense together with the resize quirk, which keeps us
+//   from invalidating the entire viewport on a resize, too.
+// Arguments:
+// - <none>
+// Return Value:
+// - true iff we were started with the `--terminalReflow` flag enabled.
+bool VtIo::IsTerminalReflowEnabled() const noexcept
+{
+    return _terminalReflow;
+}
+
+// Method Description:
+// - Returns true if we're in passthrough mode. In passthrough mode, text the
+//   client writes with ENABLE_VIRTUAL_TERMINAL_PROCESSING is sent to the
+//   terminal as is, instead of being painted again from our buffer by the VT
+//   renderer. We still parse it into our buffer, so that APIs that read the
+//   buffer keep working, and so that we can leave passthrough mode at any time.
+// Arguments:
+// - <none>
+// Return Value:
+// - true iff we were started with `--passthrough` and haven't left passthrough mode.
+bool VtIo::IsPassthrough() const noexcept
+{
+    return _passthrough;
+}
+
+// Method Description:
+// - Sends the client's VT output to the terminal, verbatim.
+// - The console lock must be held when calling this method.
+// Arguments:
+// - str: the text the client wrote.
+// Return Value:
+// - S_OK if we wrote the string successfully, otherwise an appropriate HRESULT
+[[nodiscard]] HRESULT VtIo::PassthroughString(const std::wstring_view str) noexcept
+{
+    RETURN_HR_IF(E_UNEXPECTED, !_passthrough || !_pVtRenderEngine);
+    return _pVtRenderEngine->PassthroughString(str);
+}
+
+// Method Description:
+// - Leaves passthrough mode for good. This is called when the client changes
+//   the buffer through an API that doesn't produce any VT, like
+//   WriteConsoleOutput: the terminal won't ever hear about those changes
+//   unless we paint them. From then on the VT renderer repaints from our
+//   buffer as usual, starting with the whole viewport.
+// - The console lock must be held when calling this method.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtIo::EndPassthrough() noexcept
+try
+{
+    if (!_passthrough)
+    {
+        return;
+    }
+    _passthrough = false;
+
+    if (_pVtRenderEngine)
+    {
+        auto& g = ServiceLocator::LocateGlobals();
+        _pVtRenderEngine->SetPassthroughMode(false);
+        g.getConsoleInformation().GetActiveOutputBuffer().SetTerminalConnection(_pVtRenderEngine.get());
+        if (g.pRender)
+        {
+            g.pRender->TriggerRedrawAll();
+        }
+    }
+}
+CATCH_LOG()
+
+// Method Description:
+// - Returns true if we're in text stream mode. In text stream mode there's no
+//   VT renderer: the text the client writes is sent to the terminal as plain
+//   lines, without any cursor movement or colors, as it's written into the
+//   buffer. This is meant for output that's only logged.
+// Arguments:
+// - <none>
+// Return Value:
+// - true iff we were started with `--textstream` and were given an output pipe.
+bool VtIo::IsTextStream() const noexcept
+{
+    return _textStream;
+}
+
+// Method Description:
+// - Sends text that was written into the buffer down the output pipe, in text
+//   stream mode. Line feeds become CRLFs, and all other control characters but
+//   tabs are dropped. If the pipe broke, we treat it like a closed VT output.
+// - The console lock must be held when calling this method.
+// Arguments:
+// - str: the text that was written into the buffer.
+// Return Value:
+// - <none>
+void VtIo::WriteTextStream(const std::wstring_view str) noexcept
+try
+{
+    if (!_textStream || !_hOutput)
+    {
+        return;
+    }
+
+    _textStreamLine.clear();
+    for (const auto wch : str)
+    {
+        if (wch == L'\n')
+        {
+            _textStreamLine.append(L"\r\n");
+        }
+        else if (wch >= L' ' || wch == L'\t')
+        {
+            _textStreamLine.push_back(wch);
+        }
+    }
+    if (_textStreamLine.empty())
+    {
+        return;
+    }
+
+    THROW_IF_FAILED(til::u16u8(std::wstring_view{ _textStreamLine }, _textStreamBuffer));
+    if (!WriteFile(_hOutput.get(), _textStreamBuffer.data(), gsl::narrow<DWORD>(_textStreamBuffer.size()), nullptr, nullptr))
+    {
+        LOG_LAST_ERROR();
+        std::lock_guard<std::mutex> lk(_shutdownLock);
+        _hOutput.reset();
+        _ShutdownIfNeeded();
+    }
+}
+CATCH_LOG()
+
 // Method Description:
 // - Manually tell the renderer that it should emit a "Erase Scrollback"
 //   sequence to the connected terminal. We need to do this in certain cases
@@ -44,11 +44,20 @@ namespace Microsoft::Console::VirtualTerminal
 #endif
 
         bool IsResizeQuirkEnabled() const;
+        bool IsTerminalReflowEnabled() const noexcept;
+
+        bool IsPassthrough() const noexcept;
+        [[nodiscard]] HRESULT PassthroughString(const std::wstring_view str) noexcept;
+        void EndPassthrough() noexcept;
+
+        bool IsTextStream() const noexcept;
+        void WriteTextStream(const std::wstring_view str) noexcept;
 
         [[nodiscard]] HRESULT ManuallyClearScrollback() const noexcept;
 
     private:
         // After CreateIoHandlers is called, these will be invalid.
+        // Except for _hOutput in text stream mode, which we write to ourselves.
         wil::unique_hfile _hInput;
         wil::unique_hfile _hOutput;
         // After CreateAndStartSignalThread is called, this will be invalid.
@@ -61,8 +70,23 @@ namespace Microsoft::Console::VirtualTerminal
         bool _lookingForCursorPosition;
         std::mutex _shutdownLock;
 
+        // How long we hold back the client's output for the terminal to tell us
+        // where its cursor is, before we give up on inheriting it.
+        static constexpr std::chrono::milliseconds _cursorInheritanceTimeout{ 500 };
+        bool _cursorInheritanceExpired{ false };
+        std::chrono::steady_clock::time_point _cursorRequestTime{};
+        wil::unique_threadpool_timer _cursorInheritanceTimer;
+
         bool _resizeQuirk{ false };
+        bool _terminalReflow{ false };
+        bool _repeatCharacter{ false };
         bool _win32InputMode{ false };
+        bool _passthrough{ false };
+        bool _textStream{ false };
+        std::wstring _textStreamLine;
+        std::string _textStreamBuffer;
+        size_t _flushSize{ 0 };
+        std::chrono::milliseconds _flushLatency{ 0 };
 
         std::unique_ptr<Microsoft::Console::Render::VtEngine> _pVtRenderEngine;
         std::unique_ptr<Microsoft::Console::VtInputThread> _pVtInputThread;
@@ -72,6 +96,9 @@ namespace Microsoft::Console::VirtualTerminal
 
         void _ShutdownIfNeeded();
 
+        void _EndCursorInheritance(const bool inherited);
+        static void CALLBACK _CursorInheritanceTimerCallback(PTP_CALLBACK_INSTANCE instance, PVOID context, PTP_TIMER timer) noexcept;
+
 #ifdef UNIT_TESTING
         friend class VtIoTests;
 #endif
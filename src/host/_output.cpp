@@ -14,6 +14,7 @@
 #include "../interactivity/inc/ServiceLocator.hpp"
 #include "../types/inc/Viewport.hpp"
 #include "../types/inc/convert.hpp"
+#include "../types/inc/GlyphWidth.hpp"
 #include "../types/inc/Utf16Parser.hpp"
 
 #include <algorithm>
@@ -218,11 +219,9 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
 
     try
     {
-        TextAttribute useThisAttr(attribute);
-        const OutputCellIterator it(useThisAttr, lengthToWrite);
-        const auto done = screenBuffer.Write(it, startingCoordinate);
-
-        cellsModified = done.GetCellDistance(it);
+        // Each row gets a single run of the attribute, rather than one cell at a time.
+        const TextAttribute useThisAttr(attribute);
+        cellsModified = screenBuffer.GetTextBuffer().Fill(startingCoordinate, lengthToWrite, std::nullopt, useThisAttr);
 
         if (screenBuffer.HasAccessibilityEventing())
         {
@@ -279,12 +278,21 @@ void WriteToScreen(SCREEN_INFORMATION& screenInfo, const Viewport& region)
     HRESULT hr = S_OK;
     try
     {
-        const OutputCellIterator it(character, lengthToWrite);
+        if (IsGlyphFullWidth(character))
+        {
+            const OutputCellIterator it(character, lengthToWrite);
 
-        // when writing to the buffer, specifically unset wrap if we get to the last column.
-        // a fill operation should UNSET wrap in that scenario. See GH #1126 for more details.
-        const auto done = screenInfo.Write(it, startingCoordinate, false);
-        cellsModified = done.GetInputDistance(it);
+            // when writing to the buffer, specifically unset wrap if we get to the last column.
+            // a fill operation should UNSET wrap in that scenario. See GH #1126 for more details.
+            const auto done = screenInfo.Write(it, startingCoordinate, false);
+            cellsModified = done.GetInputDistance(it);
+        }
+        else
+        {
+            // Narrow glyphs fill one cell each, so each row can be filled in one block.
+            // This unsets the wrap the same way.
+            cellsModified = screenInfo.GetTextBuffer().Fill(startingCoordinate, lengthToWrite, character, std::nullopt);
+        }
 
         // Notify accessibility
         if (screenInfo.HasAccessibilityEventing())
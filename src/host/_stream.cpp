@@ -339,6 +339,12 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
     COORD CursorPosition = cursor.GetPosition();
     NTSTATUS Status = STATUS_SUCCESS;
     SHORT XPosition;
+
+    // Everything this call writes is sent to the renderer in one go, at the end.
+    textBuffer.StartDeferPaint();
+    auto endDeferPaint = wil::scope_exit([&]() noexcept {
+        textBuffer.EndDeferPaint();
+    });
     WCHAR LocalBuffer[LOCAL_BUFFER_SIZE];
     size_t TempNumSpaces = 0;
     const bool fUnprocessed = WI_IsFlagClear(screenInfo.OutputMode, ENABLE_PROCESSED_OUTPUT);
@@ -388,6 +394,32 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         XPosition = cursor.GetPosition().X;
         size_t i = 0;
         wchar_t* LocalBufPtr = LocalBuffer;
+
+        // Most legacy output is plain printable ASCII. Such text contains no control
+        // characters and no wide glyphs, so none of the processing below applies to
+        // it and it takes up exactly one column per code unit. Commit these runs
+        // straight into the row instead of copying them through LocalBuffer.
+        std::wstring_view asciiRun;
+        if (XPosition < coordScreenBufferSize.X)
+        {
+            const auto remaining = std::min((BufferSize - *pcb) / sizeof(WCHAR), gsl::narrow_cast<size_t>(coordScreenBufferSize.X - XPosition));
+            const auto runEnd = std::find_if_not(lpString, lpString + remaining, [](const wchar_t wch) noexcept {
+                return wch >= L' ' && wch <= L'~';
+            });
+            asciiRun = { lpString, gsl::narrow_cast<size_t>(runEnd - lpString) };
+        }
+
+        if (!asciiRun.empty())
+        {
+            i = asciiRun.size();
+            XPosition += gsl::narrow_cast<SHORT>(i);
+            lpString += i;
+            pwchRealUnicode += i;
+            pwchBuffer += i;
+            *pcb += i * sizeof(WCHAR);
+            goto EndWhile;
+        }
+
         while (*pcb < BufferSize && i < LOCAL_BUFFER_SIZE && XPosition < coordScreenBufferSize.X)
         {
 #pragma prefast(suppress : 26019, "Buffer is taken in multiples of 2. Validation is ok.")
@@ -553,8 +585,17 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
             }
 
             // line was wrapped if we're writing up to the end of the current row
-            OutputCellIterator it(std::wstring_view(LocalBuffer, i), Attributes);
-            const auto itEnd = screenInfo.Write(it);
+            size_t cellsWritten;
+            if (!asciiRun.empty())
+            {
+                cellsWritten = textBuffer.WriteAsciiRun(asciiRun, CursorPosition, Attributes);
+            }
+            else
+            {
+                OutputCellIterator it(std::wstring_view(LocalBuffer, i), Attributes);
+                const auto itEnd = screenInfo.Write(it);
+                cellsWritten = itEnd.GetCellDistance(it);
+            }
 
             // Notify accessibility
             if (screenInfo.HasAccessibilityEventing())
@@ -564,7 +605,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
 
             // The number of "spaces" or "cells" we have consumed needs to be reported and stored for later
             // when/if we need to erase the command line.
-            TempNumSpaces += itEnd.GetCellDistance(it);
+            TempNumSpaces += cellsWritten;
             // WCL-NOTE: We are using the "estimated" X position delta instead of the actual delta from
             // WCL-NOTE: the iterator. It is not clear why. If they differ, the cursor ends up in the
             // WCL-NOTE: wrong place (typically inside another character).
@@ -937,9 +978,23 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
                                   const DWORD dwFlags,
                                   _Inout_opt_ PSHORT const psScrollY)
 {
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    const auto passthrough = gci.IsInVtIoMode() && gci.GetVtIo()->IsPassthrough();
+
     if (!WI_IsFlagSet(screenInfo.OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING) ||
         !WI_IsFlagSet(screenInfo.OutputMode, ENABLE_PROCESSED_OUTPUT))
     {
+        // This text isn't VT, so the terminal has to get it from our buffer.
+        if (passthrough)
+        {
+            gci.GetVtIo()->EndPassthrough();
+        }
+
+        if (gci.IsInVtIoMode() && gci.GetVtIo()->IsTextStream() && screenInfo.IsActiveScreenBuffer())
+        {
+            gci.GetVtIo()->WriteTextStream({ pwchRealUnicode, *pcb / sizeof(wchar_t) });
+        }
+
         return WriteCharsLegacy(screenInfo,
                                 pwchBufferBackupLimit,
                                 pwchBuffer,
@@ -972,6 +1027,13 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
                 StateMachine& machine = screenInfo.GetStateMachine();
                 size_t const cch = BufferSize / sizeof(WCHAR);
 
+                // In passthrough mode the terminal gets the client's VT as is.
+                // We still parse it, to keep our own buffer up to date.
+                if (passthrough)
+                {
+                    LOG_IF_FAILED(gci.GetVtIo()->PassthroughString({ pwchRealUnicode, cch }));
+                }
+
                 machine.ProcessString({ pwchRealUnicode, cch });
                 *pcb += BufferSize;
             }
@@ -986,6 +1048,47 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
     return Status;
 }
 
+// Routine Description:
+// - Writes the given text right away, without checking whether output is
+//   blocked. See DoWriteConsole.
+// Arguments:
+// - pwchBuffer - wide character text to be inserted into buffer
+// - pcbBuffer - byte count of pwchBuffer on the way in, number of bytes consumed on the way out.
+// - screenInfo - Screen Information class to write the text into at the current cursor position
+// - requiresVtQuirk - Whether the legacy equivalent VT attributes are to be ignored.
+// Return Value:
+// - STATUS_SUCCESS if OK.
+// - Or a suitable NTSTATUS format error code for memory/string/math failures.
+[[nodiscard]] static NTSTATUS _DoWriteConsoleNow(_In_reads_bytes_(*pcbBuffer) PWCHAR pwchBuffer,
+                                                 _Inout_ size_t* const pcbBuffer,
+                                                 SCREEN_INFORMATION& screenInfo,
+                                                 bool requiresVtQuirk)
+{
+    auto restoreVtQuirk{
+        wil::scope_exit([&]() { screenInfo.ResetIgnoreLegacyEquivalentVTAttributes(); })
+    };
+
+    if (requiresVtQuirk)
+    {
+        screenInfo.SetIgnoreLegacyEquivalentVTAttributes();
+    }
+    else
+    {
+        restoreVtQuirk.release();
+    }
+
+    const auto& textBuffer = screenInfo.GetTextBuffer();
+    return WriteChars(screenInfo,
+                      pwchBuffer,
+                      pwchBuffer,
+                      pwchBuffer,
+                      pcbBuffer,
+                      nullptr,
+                      textBuffer.GetCursor().GetPosition().X,
+                      WC_LIMIT_BACKSPACE,
+                      nullptr);
+}
+
 // Routine Description:
 // - Takes the given text and inserts it into the given screen buffer.
 // Note:
@@ -1026,29 +1129,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         return CONSOLE_STATUS_WAIT;
     }
 
-    auto restoreVtQuirk{
-        wil::scope_exit([&]() { screenInfo.ResetIgnoreLegacyEquivalentVTAttributes(); })
-    };
-
-    if (requiresVtQuirk)
-    {
-        screenInfo.SetIgnoreLegacyEquivalentVTAttributes();
-    }
-    else
-    {
-        restoreVtQuirk.release();
-    }
-
-    const auto& textBuffer = screenInfo.GetTextBuffer();
-    return WriteChars(screenInfo,
-                      pwchBuffer,
-                      pwchBuffer,
-                      pwchBuffer,
-                      pcbBuffer,
-                      nullptr,
-                      textBuffer.GetCursor().GetPosition().X,
-                      WC_LIMIT_BACKSPACE,
-                      nullptr);
+    return _DoWriteConsoleNow(pwchBuffer, pcbBuffer, screenInfo, requiresVtQuirk);
 }
 
 // Routine Description:
@@ -1097,6 +1178,97 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
     CATCH_RETURN();
 }
 
+// Routine Description:
+// - Writes the text to the active buffer of the given console output object
+//   like WriteConsoleWImplHelper does, but large writes are split into chunks.
+//   The console lock is released in between, so that the render thread and
+//   input handling aren't held up until the entire write is done. Only the IO
+//   thread services API calls, so no other client's output can end up in
+//   between the chunks of a write.
+// - If the write has to wait, all of it waits. Once the first chunk went
+//   through, the rest doesn't wait anymore, as if it had been written all at once.
+// Arguments:
+// - context - the console output object to write the new text into
+// - buffer - wide character text to insert
+// - read - character count of the number of characters we were able to insert before returning
+// - waiter - If we are blocked from writing now and need to wait, this is filled with contextual data for the server to restore the call later
+// Return Value:
+// - S_OK if successful.
+// - S_OK if we need to wait (check if waiter is not nullptr).
+// - Or a suitable HRESULT code for math/string/memory failures.
+[[nodiscard]] static HRESULT _WriteConsoleWInChunks(IConsoleOutputObject& context,
+                                                    const std::wstring_view buffer,
+                                                    size_t& read,
+                                                    bool requiresVtQuirk,
+                                                    std::unique_ptr<WriteData>& waiter) noexcept
+{
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    try
+    {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        // If the caller holds the lock as well, releasing ours wouldn't let anyone in.
+        if (buffer.size() <= ChunkSize || gci.GetCSRecursionCount() != 1)
+        {
+            return WriteConsoleWImplHelper(context.GetActiveBuffer(), buffer, read, requiresVtQuirk, waiter);
+        }
+
+        read = 0;
+        waiter.reset();
+
+        auto remaining = buffer;
+        while (!remaining.empty())
+        {
+            auto chunk = remaining.substr(0, ChunkSize);
+            // Don't split surrogate pairs between chunks.
+            if (chunk.size() < remaining.size() && IS_HIGH_SURROGATE(chunk.back()))
+            {
+                chunk.remove_suffix(1);
+            }
+
+            size_t chunkRead = 0;
+            HRESULT hr;
+            if (remaining.size() == buffer.size())
+            {
+                hr = WriteConsoleWImplHelper(context.GetActiveBuffer(), chunk, chunkRead, requiresVtQuirk, waiter);
+                if (SUCCEEDED(hr) && waiter)
+                {
+                    // Nothing was written. Make the entire write wait instead.
+                    waiter.reset();
+                    return WriteConsoleWImplHelper(context.GetActiveBuffer(), buffer, read, requiresVtQuirk, waiter);
+                }
+            }
+            else
+            {
+                // Let anyone waiting for the lock have it.
+                UnlockConsole();
+                SwitchToThread();
+                LockConsole();
+
+                // The active buffer may have been switched by the previous chunk.
+                auto cbChunk = chunk.size() * sizeof(wchar_t);
+                const auto status = _DoWriteConsoleNow(const_cast<wchar_t*>(chunk.data()), &cbChunk, context.GetActiveBuffer(), requiresVtQuirk);
+                hr = NT_SUCCESS(status) ? S_OK : HRESULT_FROM_NT(status);
+                chunkRead = cbChunk / sizeof(wchar_t);
+            }
+
+            // Like any write, this may have written part of the text before it failed.
+            read += chunkRead;
+            RETURN_IF_FAILED(hr);
+
+            if (chunkRead < chunk.size())
+            {
+                break;
+            }
+            remaining.remove_prefix(chunkRead);
+        }
+
+        return S_OK;
+    }
+    CATCH_RETURN();
+}
+
 // Routine Description:
 // - Writes non-Unicode formatted data into the given console output object.
 // - This method will convert from the given input into wide characters before chain calling the wide character version of the function.
@@ -1136,9 +1308,21 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         const auto codepage{ consoleInfo.OutputCP };
         auto leadByteCaptured{ false };
         auto leadByteConsumed{ false };
-        std::wstring wstr{};
         static til::u8state u8State{};
 
+        // The converted text goes into a buffer that's kept between calls, so
+        // that a client writing a line at a time doesn't cause a heap allocation
+        // per call. It's protected by the console lock, and WriteData makes its
+        // own copy if the write has to wait.
+        static std::wstring wstr{};
+        // If we were previously called with a huge buffer we have an equally large wstr.
+        // We shouldn't just keep this huge buffer around, if no one needs it anymore.
+        if (wstr.capacity() > 16 * 1024 && (wstr.capacity() >> 1) > buffer.size())
+        {
+            wstr.clear();
+            wstr.shrink_to_fit();
+        }
+
         // Convert our input parameters to Unicode
         if (codepage == CP_UTF8)
         {
@@ -1226,7 +1410,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
 
         // Make the W version of the call
         size_t wcBufferWritten{};
-        const auto hr{ WriteConsoleWImplHelper(screenInfo, wstr, wcBufferWritten, requiresVtQuirk, writeDataWaiter) };
+        const auto hr{ _WriteConsoleWInChunks(context, wstr, wcBufferWritten, requiresVtQuirk, writeDataWaiter) };
 
         // If there is no waiter, process the byte count now.
         if (nullptr == writeDataWaiter.get())
@@ -1313,7 +1497,7 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
         auto unlock = wil::scope_exit([&] { UnlockConsole(); });
 
         std::unique_ptr<WriteData> writeDataWaiter;
-        RETURN_IF_FAILED(WriteConsoleWImplHelper(context.GetActiveBuffer(), buffer, read, requiresVtQuirk, writeDataWaiter));
+        RETURN_IF_FAILED(_WriteConsoleWInChunks(context, buffer, read, requiresVtQuirk, writeDataWaiter));
 
         // Transfer specific waiter pointer into the generic interface wrapper.
         waiter.reset(writeDataWaiter.release());
@@ -18,6 +18,7 @@
 #include "handle.h"
 #include "misc.h"
 #include "../types/inc/convert.hpp"
+#include "../types/inc/GlyphWidth.hpp"
 #include "srvinit.h"
 
 #include "ApiRoutines.h"
@@ -279,28 +280,143 @@ void RedrawCommandLine(COOKED_READ_DATA& cookedReadData)
 }
 
 // Routine Description:
-// - This routine copies the commandline specified by Index into the cooked read buffer
-void SetCurrentCommandLine(COOKED_READ_DATA& cookedReadData, _In_ SHORT Index) // index, not command number
+// - Updates the command line on the screen after its contents changed, without
+//   touching the characters in front of the first one that changed. Only the
+//   rest of the line is erased and written again, so that editing a long line
+//   doesn't redraw (and over conpty, re-send) all of it for every keystroke.
+// Arguments:
+// - cookedReadData - The cooked read data, which already holds the new contents.
+//   Its VisibleCharCount is still that of the line that's on the screen.
+// - firstChanged - The index of the first character that differs from the screen.
+// - dwFlags - The flags to pass to WriteCharsLegacy.
+// - psScrollY - Receives the number of lines the buffer scrolled, if any.
+// Return Value:
+// - The status of writing the changed characters.
+// Note:
+// - Leaves the cursor after the end of the command line.
+[[nodiscard]] NTSTATUS RedrawCommandLineFrom(COOKED_READ_DATA& cookedReadData,
+                                             size_t firstChanged,
+                                             const DWORD dwFlags,
+                                             _Inout_opt_ PSHORT const psScrollY)
 {
-    DeleteCommandLine(cookedReadData, TRUE);
-    FAIL_FAST_IF_FAILED(cookedReadData.History().RetrieveNth(Index,
-                                                             cookedReadData.SpanWholeBuffer(),
-                                                             cookedReadData.BytesRead()));
-    FAIL_FAST_IF(!(cookedReadData.BufferStartPtr() == cookedReadData.BufferCurrentPtr()));
-    if (cookedReadData.IsEchoInput())
+    auto& screenInfo = cookedReadData.ScreenInfo();
+    const auto buffer = cookedReadData.BufferStartPtr();
+    const auto length = cookedReadData.BytesRead() / sizeof(WCHAR);
+    firstChanged = std::min(firstChanged, length);
+
+    // We can only tell which cell the unchanged part ends in if it didn't scroll
+    // off the top of the buffer, and if none of it is a wide glyph, which could
+    // have been pushed to the next line.
+    if (cookedReadData.OriginalCursorPosition().Y < 0 ||
+        std::any_of(buffer, buffer + firstChanged, [](const WCHAR wch) { return IsGlyphFullWidth(wch); }))
+    {
+        firstChanged = 0;
+    }
+
+    size_t unchangedCells = 0;
+    if (firstChanged == 0)
+    {
+        DeleteCommandLine(cookedReadData, false);
+    }
+    else
+    {
+        const auto originalCursor = cookedReadData.OriginalCursorPosition();
+        const SHORT sScreenBufferSizeX = screenInfo.GetBufferSize().Width();
+        unchangedCells = RetrieveTotalNumberOfSpaces(originalCursor.X, buffer, firstChanged);
+
+        const auto offset = originalCursor.X + unchangedCells;
+        const COORD position{ gsl::narrow_cast<SHORT>(offset % sScreenBufferSizeX),
+                              gsl::narrow_cast<SHORT>(originalCursor.Y + offset / sScreenBufferSizeX) };
+
+        // Erase up to the same cell DeleteCommandLine would have.
+        size_t CharsToWrite = cookedReadData.VisibleCharCount();
+        if (!CheckBisectStringW(buffer, CharsToWrite, sScreenBufferSizeX - originalCursor.X))
+        {
+            CharsToWrite++;
+        }
+        if (CharsToWrite > unchangedCells)
+        {
+            try
+            {
+                screenInfo.Write(OutputCellIterator(UNICODE_SPACE, CharsToWrite - unchangedCells), position);
+            }
+            CATCH_LOG();
+        }
+
+        LOG_IF_FAILED(screenInfo.SetCursorPosition(position, true));
+    }
+
+    size_t NumToWrite = (length - firstChanged) * sizeof(WCHAR);
+    size_t NumSpaces = 0;
+    if (NumToWrite != 0)
+    {
+        const auto status = WriteCharsLegacy(screenInfo,
+                                             buffer,
+                                             buffer + firstChanged,
+                                             buffer + firstChanged,
+                                             &NumToWrite,
+                                             &NumSpaces,
+                                             cookedReadData.OriginalCursorPosition().X,
+                                             dwFlags,
+                                             psScrollY);
+        if (!NT_SUCCESS(status))
+        {
+            return status;
+        }
+    }
+    cookedReadData.VisibleCharCount() = unchangedCells + NumSpaces;
+    return STATUS_SUCCESS;
+}
+
+// Routine Description:
+// - Replaces the contents of the command line, e.g. with a command from the
+//   history, and redraws the part of it that changed.
+// Arguments:
+// - cookedReadData - The cooked read data to operate on
+// - retrieve - Fills the (erased) cooked read buffer with the new contents.
+// Note:
+// - May throw exceptions. The command line is left empty if retrieve throws.
+template<typename T>
+static void ReplaceCommandLine(COOKED_READ_DATA& cookedReadData, T&& retrieve)
+{
+    if (!cookedReadData.IsEchoInput())
     {
+        DeleteCommandLine(cookedReadData, true);
+        retrieve();
+        return;
+    }
+
+    const std::wstring previous{ cookedReadData.BufferStartPtr(), cookedReadData.BytesRead() / sizeof(WCHAR) };
+    const auto visibleCharCount = cookedReadData.VisibleCharCount();
+    cookedReadData.Erase();
+    // The old contents are still on the screen.
+    cookedReadData.VisibleCharCount() = visibleCharCount;
+
+    auto redraw = wil::scope_exit([&]() noexcept {
+        const auto current = cookedReadData.BufferStartPtr();
+        const auto currentEnd = current + cookedReadData.BytesRead() / sizeof(WCHAR);
+        const auto firstChanged = std::mismatch(previous.begin(), previous.end(), current, currentEnd).first - previous.begin();
+
         SHORT ScrollY = 0;
-        FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(cookedReadData.ScreenInfo(),
-                                                      cookedReadData.BufferStartPtr(),
-                                                      cookedReadData.BufferCurrentPtr(),
-                                                      cookedReadData.BufferCurrentPtr(),
-                                                      &cookedReadData.BytesRead(),
-                                                      &cookedReadData.VisibleCharCount(),
-                                                      cookedReadData.OriginalCursorPosition().X,
-                                                      WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
-                                                      &ScrollY));
+        FAIL_FAST_IF_NTSTATUS_FAILED(RedrawCommandLineFrom(cookedReadData,
+                                                           gsl::narrow_cast<size_t>(firstChanged),
+                                                           WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
+                                                           &ScrollY));
         cookedReadData.OriginalCursorPosition().Y += ScrollY;
-    }
+    });
+    retrieve();
+}
+
+// Routine Description:
+// - This routine copies the commandline specified by Index into the cooked read buffer
+void SetCurrentCommandLine(COOKED_READ_DATA& cookedReadData, _In_ SHORT Index) // index, not command number
+{
+    ReplaceCommandLine(cookedReadData, [&]() {
+        FAIL_FAST_IF_FAILED(cookedReadData.History().RetrieveNth(Index,
+                                                                 cookedReadData.SpanWholeBuffer(),
+                                                                 cookedReadData.BytesRead()));
+    });
+    FAIL_FAST_IF(!(cookedReadData.BufferStartPtr() == cookedReadData.BufferCurrentPtr()));
 
     size_t const CharsToWrite = cookedReadData.BytesRead() / sizeof(WCHAR);
     cookedReadData.InsertionPoint() = CharsToWrite;
@@ -446,25 +562,12 @@ void CommandLine::_processHistoryCycling(COOKED_READ_DATA& cookedReadData,
         return;
     }
 
-    DeleteCommandLine(cookedReadData, true);
-    THROW_IF_FAILED(cookedReadData.History().Retrieve(searchDirection,
-                                                      cookedReadData.SpanWholeBuffer(),
-                                                      cookedReadData.BytesRead()));
+    ReplaceCommandLine(cookedReadData, [&]() {
+        THROW_IF_FAILED(cookedReadData.History().Retrieve(searchDirection,
+                                                          cookedReadData.SpanWholeBuffer(),
+                                                          cookedReadData.BytesRead()));
+    });
     FAIL_FAST_IF(!(cookedReadData.BufferStartPtr() == cookedReadData.BufferCurrentPtr()));
-    if (cookedReadData.IsEchoInput())
-    {
-        short ScrollY = 0;
-        FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(cookedReadData.ScreenInfo(),
-                                                      cookedReadData.BufferStartPtr(),
-                                                      cookedReadData.BufferCurrentPtr(),
-                                                      cookedReadData.BufferCurrentPtr(),
-                                                      &cookedReadData.BytesRead(),
-                                                      &cookedReadData.VisibleCharCount(),
-                                                      cookedReadData.OriginalCursorPosition().X,
-                                                      WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
-                                                      &ScrollY));
-        cookedReadData.OriginalCursorPosition().Y += ScrollY;
-    }
     const size_t CharsToWrite = cookedReadData.BytesRead() / sizeof(WCHAR);
     cookedReadData.InsertionPoint() = CharsToWrite;
     cookedReadData.SetBufferCurrentPtr(cookedReadData.BufferStartPtr() + CharsToWrite);
@@ -480,26 +583,13 @@ void CommandLine::_setPromptToOldestCommand(COOKED_READ_DATA& cookedReadData)
 {
     if (cookedReadData.HasHistory() && cookedReadData.History().GetNumberOfCommands())
     {
-        DeleteCommandLine(cookedReadData, true);
         const short commandNumber = 0;
-        THROW_IF_FAILED(cookedReadData.History().RetrieveNth(commandNumber,
-                                                             cookedReadData.SpanWholeBuffer(),
-                                                             cookedReadData.BytesRead()));
+        ReplaceCommandLine(cookedReadData, [&]() {
+            THROW_IF_FAILED(cookedReadData.History().RetrieveNth(commandNumber,
+                                                                 cookedReadData.SpanWholeBuffer(),
+                                                                 cookedReadData.BytesRead()));
+        });
         FAIL_FAST_IF(!(cookedReadData.BufferStartPtr() == cookedReadData.BufferCurrentPtr()));
-        if (cookedReadData.IsEchoInput())
-        {
-            short ScrollY = 0;
-            FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(cookedReadData.ScreenInfo(),
-                                                          cookedReadData.BufferStartPtr(),
-                                                          cookedReadData.BufferCurrentPtr(),
-                                                          cookedReadData.BufferCurrentPtr(),
-                                                          &cookedReadData.BytesRead(),
-                                                          &cookedReadData.VisibleCharCount(),
-                                                          cookedReadData.OriginalCursorPosition().X,
-                                                          WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
-                                                          &ScrollY));
-            cookedReadData.OriginalCursorPosition().Y += ScrollY;
-        }
         size_t CharsToWrite = cookedReadData.BytesRead() / sizeof(WCHAR);
         cookedReadData.InsertionPoint() = CharsToWrite;
         cookedReadData.SetBufferCurrentPtr(cookedReadData.BufferStartPtr() + CharsToWrite);
@@ -514,32 +604,23 @@ void CommandLine::_setPromptToOldestCommand(COOKED_READ_DATA& cookedReadData)
 // - May throw exceptions
 void CommandLine::_setPromptToNewestCommand(COOKED_READ_DATA& cookedReadData)
 {
-    DeleteCommandLine(cookedReadData, true);
     if (cookedReadData.HasHistory() && cookedReadData.History().GetNumberOfCommands())
     {
         const short commandNumber = (SHORT)(cookedReadData.History().GetNumberOfCommands() - 1);
-        THROW_IF_FAILED(cookedReadData.History().RetrieveNth(commandNumber,
-                                                             cookedReadData.SpanWholeBuffer(),
-                                                             cookedReadData.BytesRead()));
+        ReplaceCommandLine(cookedReadData, [&]() {
+            THROW_IF_FAILED(cookedReadData.History().RetrieveNth(commandNumber,
+                                                                 cookedReadData.SpanWholeBuffer(),
+                                                                 cookedReadData.BytesRead()));
+        });
         FAIL_FAST_IF(!(cookedReadData.BufferStartPtr() == cookedReadData.BufferCurrentPtr()));
-        if (cookedReadData.IsEchoInput())
-        {
-            short ScrollY = 0;
-            FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(cookedReadData.ScreenInfo(),
-                                                          cookedReadData.BufferStartPtr(),
-                                                          cookedReadData.BufferCurrentPtr(),
-                                                          cookedReadData.BufferCurrentPtr(),
-                                                          &cookedReadData.BytesRead(),
-                                                          &cookedReadData.VisibleCharCount(),
-                                                          cookedReadData.OriginalCursorPosition().X,
-                                                          WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
-                                                          &ScrollY));
-            cookedReadData.OriginalCursorPosition().Y += ScrollY;
-        }
         size_t CharsToWrite = cookedReadData.BytesRead() / sizeof(WCHAR);
         cookedReadData.InsertionPoint() = CharsToWrite;
         cookedReadData.SetBufferCurrentPtr(cookedReadData.BufferStartPtr() + CharsToWrite);
     }
+    else
+    {
+        DeleteCommandLine(cookedReadData, true);
+    }
 }
 
 // Routine Description:
@@ -548,19 +629,18 @@ void CommandLine::_setPromptToNewestCommand(COOKED_READ_DATA& cookedReadData)
 // - cookedReadData - The cooked read data to operate on
 void CommandLine::DeletePromptAfterCursor(COOKED_READ_DATA& cookedReadData) noexcept
 {
-    DeleteCommandLine(cookedReadData, false);
     cookedReadData.BytesRead() = cookedReadData.InsertionPoint() * sizeof(WCHAR);
     if (cookedReadData.IsEchoInput())
     {
-        FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(cookedReadData.ScreenInfo(),
-                                                      cookedReadData.BufferStartPtr(),
-                                                      cookedReadData.BufferStartPtr(),
-                                                      cookedReadData.BufferStartPtr(),
-                                                      &cookedReadData.BytesRead(),
-                                                      &cookedReadData.VisibleCharCount(),
-                                                      cookedReadData.OriginalCursorPosition().X,
-                                                      WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
-                                                      nullptr));
+        // Nothing in front of the cursor changed, only the rest needs to be erased.
+        FAIL_FAST_IF_NTSTATUS_FAILED(RedrawCommandLineFrom(cookedReadData,
+                                                           cookedReadData.InsertionPoint(),
+                                                           WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
+                                                           nullptr));
+    }
+    else
+    {
+        DeleteCommandLine(cookedReadData, false);
     }
 }
 
@@ -1003,25 +1083,18 @@ COORD CommandLine::_cycleMatchingCommandHistoryToPrompt(COOKED_READ_DATA& cooked
             // save cursor position
             CurrentPos = (SHORT)cookedReadData.InsertionPoint();
 
-            DeleteCommandLine(cookedReadData, true);
-            THROW_IF_FAILED(cookedReadData.History().RetrieveNth((SHORT)index,
-                                                                 cookedReadData.SpanWholeBuffer(),
-                                                                 cookedReadData.BytesRead()));
+            // The matching command starts with what's in front of the cursor,
+            // so only the rest of the line gets redrawn.
+            const auto originalCursorY = cookedReadData.OriginalCursorPosition().Y;
+            ReplaceCommandLine(cookedReadData, [&]() {
+                THROW_IF_FAILED(cookedReadData.History().RetrieveNth((SHORT)index,
+                                                                     cookedReadData.SpanWholeBuffer(),
+                                                                     cookedReadData.BytesRead()));
+            });
             FAIL_FAST_IF(!(cookedReadData.BufferStartPtr() == cookedReadData.BufferCurrentPtr()));
             if (cookedReadData.IsEchoInput())
             {
-                short ScrollY = 0;
-                FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(cookedReadData.ScreenInfo(),
-                                                              cookedReadData.BufferStartPtr(),
-                                                              cookedReadData.BufferCurrentPtr(),
-                                                              cookedReadData.BufferCurrentPtr(),
-                                                              &cookedReadData.BytesRead(),
-                                                              &cookedReadData.VisibleCharCount(),
-                                                              cookedReadData.OriginalCursorPosition().X,
-                                                              WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
-                                                              &ScrollY));
-                cookedReadData.OriginalCursorPosition().Y += ScrollY;
-                cursorPosition.Y += ScrollY;
+                cursorPosition.Y += cookedReadData.OriginalCursorPosition().Y - originalCursorY;
             }
 
             // restore cursor position
@@ -1046,12 +1119,6 @@ COORD CommandLine::DeleteFromRightOfCursor(COOKED_READ_DATA& cookedReadData) noe
 
     if (!cookedReadData.AtEol())
     {
-        // Delete commandline.
-        // clang-format off
-#pragma prefast(suppress: __WARNING_BUFFER_OVERFLOW, "Not sure why prefast is getting confused here")
-        // clang-format on
-        DeleteCommandLine(cookedReadData, false);
-
         // Delete char.
         cookedReadData.BytesRead() -= sizeof(WCHAR);
         memmove(cookedReadData.BufferCurrentPtr(),
@@ -1063,18 +1130,17 @@ COORD CommandLine::DeleteFromRightOfCursor(COOKED_READ_DATA& cookedReadData) noe
             *buf = (WCHAR)' ';
         }
 
-        // Write commandline.
+        // Write the part of the commandline after the cursor.
         if (cookedReadData.IsEchoInput())
         {
-            FAIL_FAST_IF_NTSTATUS_FAILED(WriteCharsLegacy(cookedReadData.ScreenInfo(),
-                                                          cookedReadData.BufferStartPtr(),
-                                                          cookedReadData.BufferStartPtr(),
-                                                          cookedReadData.BufferStartPtr(),
-                                                          &cookedReadData.BytesRead(),
-                                                          &cookedReadData.VisibleCharCount(),
-                                                          cookedReadData.OriginalCursorPosition().X,
-                                                          WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
-                                                          nullptr));
+            FAIL_FAST_IF_NTSTATUS_FAILED(RedrawCommandLineFrom(cookedReadData,
+                                                               cookedReadData.InsertionPoint(),
+                                                               WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
+                                                               nullptr));
+        }
+        else
+        {
+            DeleteCommandLine(cookedReadData, false);
         }
 
         // restore cursor position
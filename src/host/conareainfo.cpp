@@ -116,6 +116,78 @@ void ConversionAreaInfo::WriteText(const std::vector<OutputCell>& text,
     _screenBuffer->Write(view, { column, 0 });
 }
 
+// Routine Description:
+// - Replaces the line shown by the conversion area and makes it visible.
+// - If the area is already visible at the same position, only the cells that
+//   changed are repainted. That includes cells that the line grew into or
+//   shrank away from. Otherwise, the area is moved and painted as a whole.
+// Arguments:
+// - text - Text for the conversion area. Must not be empty.
+// - column - Column to start at (X position). The visible window starts here too.
+// - viewPos - Position of the conversion area buffer relative to the viewport
+void ConversionAreaInfo::Update(const std::vector<OutputCell>& text,
+                                const SHORT column,
+                                const COORD viewPos)
+{
+    const SMALL_RECT window{ column, 0, gsl::narrow<SHORT>(column + text.size() - 1), 0 };
+
+    if (IsHidden() || viewPos.X != _caInfo.coordConView.X || viewPos.Y != _caInfo.coordConView.Y)
+    {
+        WriteText(text, column);
+        SetWindowInfo(window);
+        SetViewPos(viewPos);
+        SetHidden(false);
+        Paint();
+        return;
+    }
+
+    // Narrow the span that needs painting down from both ends, skipping over
+    // cells that both the old and the new window show with the same contents.
+    const auto oldWindow = _caInfo.rcViewCaWindow;
+    const auto& buffer = GetTextBuffer();
+    const auto unchanged = [&](const SHORT x) {
+        if (x < window.Left || x > window.Right || x < oldWindow.Left || x > oldWindow.Right)
+        {
+            return false;
+        }
+        const auto& cell = til::at(text, x - column);
+        const auto current = buffer.GetCellDataAt({ x, 0 });
+        return cell.Chars() == current->Chars() &&
+               cell.DbcsAttr() == current->DbcsAttr() &&
+               cell.TextAttr() == current->TextAttr();
+    };
+
+    auto first = std::min(window.Left, oldWindow.Left);
+    auto last = std::max(window.Right, oldWindow.Right);
+    while (first <= last && unchanged(first))
+    {
+        ++first;
+    }
+    while (last >= first && unchanged(last))
+    {
+        --last;
+    }
+
+    WriteText(text, column);
+    _caInfo.rcViewCaWindow = window;
+
+    if (first <= last)
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& ScreenInfo = gci.GetActiveOutputBuffer();
+        const auto viewport = ScreenInfo.GetViewport();
+
+        SMALL_RECT ChangedRegion;
+        ChangedRegion.Left = viewport.Left() + _caInfo.coordConView.X + first;
+        ChangedRegion.Right = viewport.Left() + _caInfo.coordConView.X + last;
+        ChangedRegion.Top = viewport.Top() + _caInfo.coordConView.Y;
+        ChangedRegion.Bottom = ChangedRegion.Top;
+
+        // This repaints both the screen buffer and any conversion area on top.
+        WriteToScreen(ScreenInfo, Viewport::FromInclusive(ChangedRegion));
+    }
+}
+
 // Routine Description:
 // - Clears out a conversion area
 void ConversionAreaInfo::ClearArea() noexcept
@@ -43,7 +43,17 @@ void ConsoleImeInfo::RedrawCompMessage()
 {
     if (!_text.empty())
     {
-        ClearAllAreas();
+        // Hide the areas without discarding the composition. The viewport
+        // might have moved, so everything has to be painted again.
+        for (auto& area : ConvAreaCompStr)
+        {
+            if (!area.IsHidden())
+            {
+                area.SetHidden(true);
+                area.Paint();
+            }
+        }
+
         _WriteUndeterminedChars(_text, _attributes, _colorArray);
     }
 }
@@ -60,7 +70,8 @@ void ConsoleImeInfo::WriteCompMessage(const std::wstring_view text,
                                       const gsl::span<const BYTE> attributes,
                                       const gsl::span<const WORD> colorArray)
 {
-    ClearAllAreas();
+    // The conversion areas aren't cleared here. _WriteUndeterminedChars
+    // reuses them and only repaints what changed since the last message.
 
     // MSFT:29219348 only hide the cursor after the IME produces a string.
     // See notes in convarea.cpp ImeStartComposition().
@@ -303,6 +314,8 @@ std::vector<OutputCell> ConsoleImeInfo::s_ConvertToCells(const std::wstring_view
 //       - Updated to set up the next conversion area down a line (and to the left viewport edge)
 // - view - The rectangle representing the viewable area of the screen right now to let us know how many cells can fit.
 // - screenInfo - A reference to the screen information we will use for accessibility notifications
+// - areaIndex - The index of the conversion area to use for this line. Areas from a previous
+//               composition message are reused, and new ones are only added when there are more lines.
 // Return Value:
 // - Updated begin position for the next call. It will normally be >begin and <= end.
 //   However, if text couldn't fit in our line (full-width character starting at the very last cell)
@@ -312,7 +325,8 @@ std::vector<OutputCell>::const_iterator ConsoleImeInfo::_WriteConversionArea(con
                                                                              const std::vector<OutputCell>::const_iterator end,
                                                                              COORD& pos,
                                                                              const Microsoft::Console::Types::Viewport view,
-                                                                             SCREEN_INFORMATION& screenInfo)
+                                                                             SCREEN_INFORMATION& screenInfo,
+                                                                             const size_t areaIndex)
 {
     // The position in the viewport where we will start inserting cells for this conversion area
     // NOTE: We might exit early if there's not enough space to fit here, so we take a copy of
@@ -356,24 +370,17 @@ std::vector<OutputCell>::const_iterator ConsoleImeInfo::_WriteConversionArea(con
     // Copy out the substring into a vector.
     const std::vector<OutputCell> lineVec(lineBegin, lineEnd);
 
-    // Add a conversion area to the internal state to hold this line.
-    THROW_IF_FAILED(_AddConversionArea());
-
-    // Get the added conversion area.
-    auto& area = ConvAreaCompStr.back();
-
-    // Write our text into the conversion area.
-    area.WriteText(lineVec, insertionPos.X);
+    // Add a conversion area to the internal state to hold this line, unless we still have one.
+    if (areaIndex >= ConvAreaCompStr.size())
+    {
+        THROW_IF_FAILED(_AddConversionArea());
+    }
 
-    // Set the viewport and positioning parameters for the conversion area to describe to the renderer
-    // the appropriate location to overlay this conversion area on top of the main screen buffer inside the viewport.
-    const SMALL_RECT region{ insertionPos.X, 0, gsl::narrow<SHORT>(insertionPos.X + lineVec.size() - 1), 0 };
-    area.SetWindowInfo(region);
-    area.SetViewPos({ 0 - view.Left(), insertionPos.Y - view.Top() });
+    auto& area = ConvAreaCompStr.at(areaIndex);
 
-    // Make it visible and paint it.
-    area.SetHidden(false);
-    area.Paint();
+    // Write our text into the conversion area, positioned so that the renderer overlays it on top of
+    // the main screen buffer at the appropriate location inside the viewport. This only paints what changed.
+    area.Update(lineVec, insertionPos.X, { 0 - view.Left(), insertionPos.Y - view.Top() });
 
     // Notify accessibility that we have updated the text in this display region within the viewport.
     if (screenInfo.HasAccessibilityEventing())
@@ -405,14 +412,24 @@ void ConsoleImeInfo::_WriteUndeterminedChars(const std::wstring_view text,
     // Ensure cursor is visible for prompt line
     screenInfo.MakeCurrentCursorVisible();
 
-    // Clear out existing conversion areas.
-    ConvAreaCompStr.clear();
-
     // If the text length and attribute length don't match,
     // it's a programming error on our part. We control the sizes here.
     FAIL_FAST_IF(text.size() != attributes.size());
 
-    // If we have no text, return. We've already cleared above.
+    // Any conversion areas we don't use for this message are hidden once we're done.
+    size_t areaIndex = 0;
+    auto hideUnusedAreas = wil::scope_exit([&]() noexcept {
+        for (auto i = areaIndex; i < ConvAreaCompStr.size(); ++i)
+        {
+            auto& area = til::at(ConvAreaCompStr, i);
+            if (!area.IsHidden())
+            {
+                area.ClearArea();
+            }
+        }
+    });
+
+    // If we have no text, return. The scope exit above hides all the areas.
     if (text.empty())
     {
         return;
@@ -441,7 +458,8 @@ void ConsoleImeInfo::_WriteUndeterminedChars(const std::wstring_view text,
     // Write over and over updating the beginning iterator until we reach the end.
     do
     {
-        begin = _WriteConversionArea(begin, end, pos, view, screenInfo);
+        begin = _WriteConversionArea(begin, end, pos, view, screenInfo, areaIndex);
+        ++areaIndex;
     } while (begin < end);
 }
 
@@ -786,7 +786,6 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
 {
     try
     {
-        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         const auto& storageBuffer = context.GetActiveBuffer();
         const auto storageSize = storageBuffer.GetBufferSize().Dimensions();
 
@@ -825,41 +824,25 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
         // We will start reading the buffer at the point of the top left corner (origin) of the (potentially adjusted) request
         const auto sourcePoint = clippedRequestRectangle.Origin();
 
-        // Get an iterator to the beginning of the return buffer
-        // We might have to seek this forward or skip around if we clipped the request.
-        auto targetIter = targetBuffer.begin();
-        COORD targetPos = { 0 };
-        const auto targetLimit = Viewport::FromDimensions(targetPoint, clippedRequestRectangle.Dimensions());
-
-        // Get an iterator to the beginning of the request inside the screen buffer
-        // This should walk exactly along every cell of the clipped request.
-        auto sourceIter = storageBuffer.GetCellDataAt(sourcePoint, clippedRequestRectangle);
-
-        // Walk through every cell of the target, advancing the buffer.
-        // Validate that we always still have a valid iterator to the backing store,
-        // that we always are writing inside the user's buffer (before the end)
-        // and we're always targeting the user's buffer inside its original bounds.
-        while (sourceIter && targetIter < targetBuffer.end())
+        // Copy the clipped request a row at a time into the matching part of the user's buffer.
+        // Cells of the user's buffer outside of the clipped request are left untouched.
+        const auto& textBuffer = storageBuffer.GetTextBuffer();
+        const auto width = gsl::narrow_cast<size_t>(std::max<SHORT>(clippedRequestRectangle.Width(), 0));
+        for (SHORT y = 0; width != 0 && y < clippedRequestRectangle.Height(); y++)
         {
-            // If the point we're trying to write is inside the limited buffer write zone...
-            if (targetLimit.IsInBounds(targetPos))
-            {
-                // Copy the data into position...
-                *targetIter = gci.AsCharInfo(*sourceIter);
-                // ... and advance the read iterator.
-                sourceIter++;
-            }
+            // Find the offset of this row in the user's buffer by the dimensions of the original request.
+            size_t targetOffset = 0;
+            RETURN_IF_FAILED(SizeTMult(gsl::narrow_cast<size_t>(targetPoint.Y + y), gsl::narrow_cast<size_t>(targetSize.X), &targetOffset));
+            RETURN_IF_FAILED(SizeTAdd(targetOffset, targetPoint.X, &targetOffset));
 
-            // Always advance the write iterator, we might have skipped it due to clipping.
-            targetIter++;
-
-            // Increment the target
-            targetPos.X++;
-            if (targetPos.X >= targetSize.X)
+            // Stop once we've run out of user buffer to write into.
+            if (targetOffset >= targetBuffer.size())
             {
-                targetPos.X = 0;
-                targetPos.Y++;
+                break;
             }
+
+            const auto rowTarget = targetBuffer.subspan(targetOffset, std::min(width, targetBuffer.size() - targetOffset));
+            textBuffer.ReadCharInfos({ sourcePoint.X, gsl::narrow_cast<SHORT>(sourcePoint.Y + y) }, rowTarget);
         }
 
         // Reply with the region we read out of the backing buffer (potentially clipped)
@@ -1006,12 +989,9 @@ void EventsToUnicode(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents,
             // Now we make a subspan starting from that offset for as much of the original request as would fit
             const auto subspan = buffer.subspan(totalOffset, writeRectangle.Width());
 
-            // Convert to a CHAR_INFO view to fit into the iterator
+            // Convert to a read-only CHAR_INFO view and copy it straight into the row.
             const auto charInfos = gsl::span<const CHAR_INFO>(subspan.data(), subspan.size());
-
-            // Make the iterator and write to the target position.
-            OutputCellIterator it(charInfos);
-            storageBuffer.Write(it, target);
+            storageBuffer.GetTextBuffer().WriteCharInfos(charInfos, target);
         }
 
         // Since we've managed to write part of the request, return the clamped part that we actually used.
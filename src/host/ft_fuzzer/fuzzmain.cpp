@@ -13,6 +13,52 @@
 #include "../getset.h"
 #include <til/u8u16convert.h>
 
+// Slow input mode:
+//   When CONSOLE_FUZZ_SLOW_INPUTS is set to a directory, every input is fed to
+//   the VT state machine (and through it AdaptDispatch) instead of
+//   WriteCharsLegacy, and timed. Inputs that take longer than
+//   CONSOLE_FUZZ_SLOW_NS_PER_BYTE (default: SlowInputDefaultNsPerByte) per
+//   byte are saved to that directory. The result is a corpus of pathological
+//   inputs (huge parameters, unterminated OSC strings, long DCS strings,
+//   repeated REP, ...) that ConptyThroughputTests::SlowInputCorpusThroughput
+//   replays with /p:VtCorpusDir=<dir>.
+static constexpr unsigned long long SlowInputDefaultNsPerByte = 2000;
+// Tiny inputs are dominated by fixed per-call costs, not by the parser.
+static constexpr size_t SlowInputMinimumSize = 64;
+
+static std::filesystem::path slowInputDirectory;
+static unsigned long long slowInputNsPerByte = SlowInputDefaultNsPerByte;
+
+static void InitializeSlowInputMode()
+{
+    const auto directory{ wil::TryGetEnvironmentVariableW<std::wstring>(L"CONSOLE_FUZZ_SLOW_INPUTS") };
+    if (directory.empty())
+    {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    slowInputDirectory = directory;
+
+    const auto threshold{ wil::TryGetEnvironmentVariableW<std::wstring>(L"CONSOLE_FUZZ_SLOW_NS_PER_BYTE") };
+    if (!threshold.empty())
+    {
+        slowInputNsPerByte = std::max(1ull, wcstoull(threshold.c_str(), nullptr, 10));
+    }
+}
+
+static void SaveSlowInput(const std::string_view input, const unsigned long long nsPerByte) noexcept
+try
+{
+    // Name the file after its content, so that the same input found twice
+    // doesn't end up in the corpus twice.
+    const auto name = fmt::format(L"slow-{:016x}-{}nspb.vt", std::hash<std::string_view>{}(input), nsPerByte);
+    std::ofstream file{ slowInputDirectory / name, std::ios::binary };
+    file.write(input.data(), gsl::narrow_cast<std::streamsize>(input.size()));
+}
+CATCH_LOG()
+
 struct NullDeviceComm : public IDeviceComm
 {
     HRESULT SetServerInformation(CD_IO_SERVER_INFORMATION* const) const override
@@ -124,6 +170,7 @@ int main(int /*argc*/, char** /*argv*/)
 #endif
 {
     RETURN_IF_FAILED(RunConhost());
+    InitializeSlowInputMode();
     return 0;
 }
 
@@ -136,6 +183,25 @@ extern "C" __declspec(dllexport) int LLVMFuzzerTestOneInput(const uint8_t* data,
     size_t sizeInBytes{ u16String.size() * 2 };
     gci.LockConsole();
     auto u = wil::scope_exit([&]() { gci.UnlockConsole(); });
+
+    if (!slowInputDirectory.empty())
+    {
+        const auto start = std::chrono::steady_clock::now();
+        gci.GetActiveOutputBuffer().GetStateMachine().ProcessString(u16String);
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        if (size >= SlowInputMinimumSize)
+        {
+            const auto ns = gsl::narrow_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            const auto nsPerByte = ns / size;
+            if (nsPerByte > slowInputNsPerByte)
+            {
+                SaveSlowInput({ reinterpret_cast<const char*>(data), size }, nsPerByte);
+            }
+        }
+        return 0;
+    }
+
     (void)WriteCharsLegacy(gci.GetActiveOutputBuffer(),
                            u16String.data(),
                            u16String.data(),
@@ -702,7 +702,14 @@ void ApiRoutines::GetLargestConsoleWindowSizeImpl(const SCREEN_INFORMATION& cont
         // clang-format on
 
         // MSFT: 15813316 - Try to use this SetCursorPosition call to inherit the cursor position.
-        RETURN_IF_FAILED(gci.GetVtIo()->SetCursorPosition(position));
+        // S_FALSE means that this was the terminal's response to our request,
+        // but it came too late to be used.
+        const auto inheritResult = gci.GetVtIo()->SetCursorPosition(position);
+        RETURN_IF_FAILED(inheritResult);
+        if (inheritResult == S_FALSE)
+        {
+            return S_OK;
+        }
 
         RETURN_IF_NTSTATUS_FAILED(buffer.SetCursorPosition(position, true));
 
@@ -1597,6 +1604,19 @@ void DoSrvPrivateEnableAlternateScroll(const bool fEnable)
     gci.GetActiveInputBuffer()->GetTerminalInput().EnableAlternateScroll(fEnable);
 }
 
+// Routine Description:
+// - A private API call for starting or ending a synchronized update.
+//   The renderer holds back frames while one is in progress.
+// Parameters:
+// - fEnable - true to start a synchronized update, false to end it.
+// Return value:
+// None
+void DoSrvPrivateEnableSynchronizedOutput(const bool fEnable)
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.GetActiveOutputBuffer().GetRenderTarget().SynchronizedOutputChanged(fEnable);
+}
+
 // Routine Description:
 // - A private API call for performing a VT-style erase all operation on the buffer.
 //      See SCREEN_INFORMATION::VtEraseAll's description for details.
@@ -2226,8 +2246,9 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
             fillAttrs.SetStandardErase();
         }
 
-        const auto fillData = OutputCellIterator{ fillChar, fillAttrs, fillLength };
-        screenInfo.Write(fillData, startPosition, false);
+        // The VT fill characters are all narrow, so the buffer can fill a
+        // row at a time instead of cell by cell.
+        screenInfo.GetTextBuffer().Fill(startPosition, fillLength, fillChar, fillAttrs);
 
         // Notify accessibility
         if (screenInfo.HasAccessibilityEventing())
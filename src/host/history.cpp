@@ -282,14 +282,9 @@ void CommandHistory::Realloc(const size_t commands)
         return;
     }
 
-    const auto oldCommands = _commands;
+    // Keep the oldest commands, like before.
     const auto newNumberOfCommands = gsl::narrow<SHORT>(std::min(_commands.size(), commands));
-
-    _commands.clear();
-    for (SHORT i = 0; i < newNumberOfCommands; i++)
-    {
-        _commands.emplace_back(oldCommands[i]);
-    }
+    _commands.resize(newNumberOfCommands);
 
     WI_SetFlag(Flags, CLE_RESET);
     LastDisplayed = gsl::narrow<SHORT>(_commands.size()) - 1;
@@ -302,11 +297,10 @@ void CommandHistory::s_ReallocExeToFront(const std::wstring_view appName, const
     {
         if (WI_IsFlagSet(it->Flags, CLE_ALLOCATED) && it->IsAppNameMatch(appName))
         {
-            CommandHistory backup = *it;
-            backup.Realloc(commands);
+            it->Realloc(commands);
 
-            s_historyLists.erase(it);
-            s_historyLists.push_front(backup);
+            // Move the history to the front without copying its commands.
+            s_historyLists.splice(s_historyLists.begin(), s_historyLists, it);
 
             return;
         }
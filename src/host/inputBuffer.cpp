@@ -27,10 +27,10 @@ InputBuffer::InputBuffer() :
     InputMode{ INPUT_BUFFER_DEFAULT_INPUT_MODE },
     WaitQueue{},
     _pTtyConnection(nullptr),
-    _termInput(std::bind(&InputBuffer::_HandleTerminalInputCallback, this, std::placeholders::_1))
+    _termInput([this](std::deque<std::unique_ptr<IInputEvent>>& inEvents) { _HandleTerminalInputCallback(inEvents); })
 {
-    // The _termInput's constructor takes a reference to this object's _HandleTerminalInputCallback.
-    // We need to use std::bind to create a reference to that function without a reference to this InputBuffer
+    // The _termInput's constructor takes a callback into this object's _HandleTerminalInputCallback.
+    // It has to be spelled out as a lambda taking the events, since TerminalInput can take text callbacks as well.
 
     // initialize buffer header
     fInComposition = false;
@@ -163,6 +163,12 @@ void InputBuffer::ReinitializeInputBuffer()
 // - None
 void InputBuffer::WakeUpReadersWaitingForData()
 {
+    if (_deferWakeups)
+    {
+        _wakeupPending = true;
+        return;
+    }
+
     WaitQueue.NotifyWaiters(false);
 }
 
@@ -174,9 +180,44 @@ void InputBuffer::WakeUpReadersWaitingForData()
 // - None
 void InputBuffer::TerminateRead(_In_ WaitTerminationReason Flag)
 {
+    // Readers have to see the input written before the ctrl-c or ctrl-break
+    // first, the same as if we hadn't deferred waking them up.
+    if (_wakeupPending)
+    {
+        _wakeupPending = false;
+        WaitQueue.NotifyWaiters(false);
+    }
+
     WaitQueue.NotifyWaiters(true, Flag);
 }
 
+// Routine Description:
+// - Holds back waking up readers until EndDeferringWakeups is called, so that
+//   a batch of writes only wakes them up once, instead of once per write.
+// Note:
+// - The console lock must be held from here until EndDeferringWakeups.
+void InputBuffer::StartDeferringWakeups() noexcept
+{
+    _deferWakeups = true;
+}
+
+// Routine Description:
+// - Stops deferring wakeups, and wakes up readers if any of the writes since
+//   StartDeferringWakeups would have.
+void InputBuffer::EndDeferringWakeups() noexcept
+{
+    _deferWakeups = false;
+    if (_wakeupPending)
+    {
+        _wakeupPending = false;
+        try
+        {
+            WaitQueue.NotifyWaiters(false);
+        }
+        CATCH_LOG();
+    }
+}
+
 // Routine Description:
 // - Returns the number of events in the input buffer.
 // Arguments:
@@ -214,8 +255,8 @@ void InputBuffer::Flush()
 // - The console lock must be held when calling this routine.
 void InputBuffer::FlushAllButKeys()
 {
-    auto newEnd = std::remove_if(_storage.begin(), _storage.end(), [](const std::unique_ptr<IInputEvent>& event) {
-        return event->EventType() != InputEventType::KeyEvent;
+    auto newEnd = std::remove_if(_storage.begin(), _storage.end(), [](const INPUT_RECORD& record) {
+        return record.EventType != KEY_EVENT;
     });
     _storage.erase(newEnd, _storage.end());
 }
@@ -378,94 +419,59 @@ void InputBuffer::_ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& ou
     FAIL_FAST_IF(streamRead && readCount != 1);
 
     resetWaitEvent = false;
+    eventsRead = 0;
 
-    std::deque<std::unique_ptr<IInputEvent>> readEvents;
     // we need another var to keep track of how many we've read
     // because dbcs records count for two when we aren't doing a
     // unicode read but the eventsRead count should return the number
     // of events actually put into outRecords.
     size_t virtualReadCount = 0;
 
-    while (!_storage.empty() && virtualReadCount < readCount)
+    // The events are read out of the front of the storage and we only remove them once we're done,
+    // so that peeking (the common case for ReadConsoleInput callers waiting on input) doesn't need
+    // to put them back. When stream reading a key event with a repeat count we instead split off a
+    // single repetition and leave the rest where it is. Stream reads only ever read one event.
+    size_t storageRead = 0;
+    std::optional<INPUT_RECORD> streamRecord;
+
+    while (storageRead < _storage.size() && virtualReadCount < readCount)
     {
-        bool performNormalRead = true;
+        const auto& record = _storage[storageRead];
+        const INPUT_RECORD* readRecord = &record;
+
         // for stream reads we need to split any key events that have been coalesced
-        if (streamRead)
+        if (streamRead && record.EventType == KEY_EVENT && record.Event.KeyEvent.wRepeatCount > 1)
         {
-            if (_storage.front()->EventType() == InputEventType::KeyEvent)
-            {
-                KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.front().get());
-                if (pKeyEvent->GetRepeatCount() > 1)
-                {
-                    // split the key event
-                    std::unique_ptr<KeyEvent> streamKeyEvent = std::make_unique<KeyEvent>(*pKeyEvent);
-                    streamKeyEvent->SetRepeatCount(1);
-                    readEvents.push_back(std::move(streamKeyEvent));
-                    pKeyEvent->SetRepeatCount(pKeyEvent->GetRepeatCount() - 1);
-                    performNormalRead = false;
-                }
-            }
+            streamRecord = record;
+            streamRecord->Event.KeyEvent.wRepeatCount = 1;
+            readRecord = &*streamRecord;
         }
-
-        if (performNormalRead)
+        else
         {
-            readEvents.push_back(std::move(_storage.front()));
-            _storage.pop_front();
+            ++storageRead;
         }
 
+        outEvents.push_back(IInputEvent::Create(*readRecord));
+        ++eventsRead;
+
         ++virtualReadCount;
         if (!unicode)
         {
-            if (readEvents.back()->EventType() == InputEventType::KeyEvent)
+            if (readRecord->EventType == KEY_EVENT && IsGlyphFullWidth(readRecord->Event.KeyEvent.uChar.UnicodeChar))
             {
-                const KeyEvent* const pKeyEvent = static_cast<const KeyEvent* const>(readEvents.back().get());
-                if (IsGlyphFullWidth(pKeyEvent->GetCharData()))
-                {
-                    ++virtualReadCount;
-                }
+                ++virtualReadCount;
             }
         }
     }
 
-    // the amount of events that were actually read
-    eventsRead = readEvents.size();
-
-    // copy the events back if we were supposed to peek
-    if (peek)
+    // remove the events we've read unless we were supposed to peek
+    if (!peek)
     {
-        if (streamRead)
+        if (streamRecord)
         {
-            // we need to check and see if the event was split from a coalesced key event
-            // or if it was unrelated to the current front event in storage
-            if (!readEvents.empty() &&
-                !_storage.empty() &&
-                readEvents.back()->EventType() == InputEventType::KeyEvent &&
-                _storage.front()->EventType() == InputEventType::KeyEvent &&
-                _CanCoalesce(static_cast<const KeyEvent&>(*readEvents.back()),
-                             static_cast<const KeyEvent&>(*_storage.front())))
-            {
-                KeyEvent& keyEvent = static_cast<KeyEvent&>(*_storage.front());
-                keyEvent.SetRepeatCount(keyEvent.GetRepeatCount() + 1);
-            }
-            else
-            {
-                _storage.push_front(IInputEvent::Create(readEvents.back()->ToInputRecord()));
-            }
-        }
-        else
-        {
-            for (auto it = readEvents.crbegin(); it != readEvents.crend(); ++it)
-            {
-                _storage.push_front(IInputEvent::Create((*it)->ToInputRecord()));
-            }
+            _storage.front().Event.KeyEvent.wRepeatCount -= 1;
         }
-    }
-
-    // move events read to proper deque
-    while (!readEvents.empty())
-    {
-        outEvents.push_back(std::move(readEvents.front()));
-        readEvents.pop_front();
+        _storage.erase(_storage.begin(), _storage.begin() + storageRead);
     }
 
     // signal if we emptied the buffer
@@ -500,8 +506,9 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         // this way to handle any coalescing that might occur.
 
         // get all of the existing records, "emptying" the buffer
-        std::deque<std::unique_ptr<IInputEvent>> existingStorage;
-        existingStorage.swap(_storage);
+        decltype(_storage) existingRecords;
+        existingRecords.swap(_storage);
+        const bool initiallyEmptyQueue = existingRecords.empty();
 
         // We will need this variable to pass to _WriteBuffer so it can attempt to determine wait status.
         // However, because we swapped the storage out from under it with an empty deque, it will always
@@ -515,6 +522,11 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         FAIL_FAST_IF(!(unusedWaitStatus));
 
         // write all previously existing records
+        std::deque<std::unique_ptr<IInputEvent>> existingStorage;
+        for (const auto& record : existingRecords)
+        {
+            existingStorage.push_back(IInputEvent::Create(record));
+        }
         size_t existingEventsWritten;
         _WriteBuffer(existingStorage, existingEventsWritten, unusedWaitStatus);
         FAIL_FAST_IF(!(!unusedWaitStatus));
@@ -526,7 +538,7 @@ size_t InputBuffer::Prepend(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& in
         // and instead need to set the event if the original backing
         // buffer (the one we swapped out at the top) was empty
         // when this whole thing started.
-        if (existingStorage.empty())
+        if (initiallyEmptyQueue)
         {
             ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
         }
@@ -609,6 +621,61 @@ size_t InputBuffer::Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEv
     }
 }
 
+// Routine Description:
+// - Writes a block of text to the input buffer, as one key down record per
+//   UTF-16 code unit. That's what the VT input module turns plain text into
+//   anyway, but this skips allocating a KeyEvent per character and running
+//   each of them through TerminalInput. Meant for pasting text, when the
+//   reader is in VT input mode and doesn't care about virtual key codes.
+// Arguments:
+// - text - the text to store in the buffer.
+// Return Value:
+// - The number of events that were written to input buffer.
+// Note:
+// - The console lock must be held when calling this routine.
+size_t InputBuffer::WriteString(const std::wstring_view text)
+{
+    try
+    {
+        if (text.empty())
+        {
+            return 0;
+        }
+
+        // Like typing, pasting resumes output that was paused.
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        if (WI_IsFlagSet(gci.Flags, CONSOLE_SUSPENDED))
+        {
+            UnblockWriteConsole(CONSOLE_OUTPUT_SUSPENDED);
+        }
+
+        const bool initiallyEmptyQueue = _storage.empty();
+
+        INPUT_RECORD record{};
+        record.EventType = KEY_EVENT;
+        record.Event.KeyEvent.bKeyDown = TRUE;
+        record.Event.KeyEvent.wRepeatCount = 1;
+        for (const auto wch : text)
+        {
+            record.Event.KeyEvent.uChar.UnicodeChar = wch;
+            _storage.push_back(record);
+        }
+
+        if (initiallyEmptyQueue)
+        {
+            ServiceLocator::LocateGlobals().hInputEvent.SetEvent();
+        }
+
+        WakeUpReadersWaitingForData();
+        return text.size();
+    }
+    catch (...)
+    {
+        LOG_HR(wil::ResultFromCaughtException());
+        return 0;
+    }
+}
+
 // Routine Description:
 // - Coalesces input events and transfers them to storage queue.
 // Arguments:
@@ -689,7 +756,7 @@ void InputBuffer::_WriteBuffer(_Inout_ std::deque<std::unique_ptr<IInputEvent>>&
             }
         }
         // At this point, the event was neither coalesced, nor processed by VT.
-        _storage.push_back(std::move(inEvent));
+        _storage.push_back(inEvent->ToInputRecord());
         ++eventsWritten;
     }
     if (initiallyEmptyQueue && !_storage.empty())
@@ -718,21 +785,17 @@ bool InputBuffer::_CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<I
     FAIL_FAST_IF(!(inEvents.size() == 1));
     FAIL_FAST_IF(_storage.empty());
     const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
+    INPUT_RECORD& lastStoredRecord = _storage.back();
     if (pFirstInEvent->EventType() == InputEventType::MouseEvent &&
-        pLastStoredEvent->EventType() == InputEventType::MouseEvent)
+        lastStoredRecord.EventType == MOUSE_EVENT)
     {
         const MouseEvent* const pInMouseEvent = static_cast<const MouseEvent* const>(pFirstInEvent);
-        const MouseEvent* const pLastMouseEvent = static_cast<const MouseEvent* const>(pLastStoredEvent);
 
         if (pInMouseEvent->IsMouseMoveEvent() &&
-            pLastMouseEvent->IsMouseMoveEvent())
+            lastStoredRecord.Event.MouseEvent.dwEventFlags == MOUSE_MOVED)
         {
             // update mouse moved position
-            MouseEvent* const pMouseEvent = static_cast<MouseEvent* const>(_storage.back().release());
-            pMouseEvent->SetPosition(pInMouseEvent->GetPosition());
-            std::unique_ptr<IInputEvent> tempPtr(pMouseEvent);
-            tempPtr.swap(_storage.back());
+            lastStoredRecord.Event.MouseEvent.dwMousePosition = pInMouseEvent->GetPosition();
 
             inEvents.pop_front();
             return true;
@@ -742,24 +805,24 @@ bool InputBuffer::_CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<I
 }
 
 // Routine Description:
-// - checks two KeyEvents to see if they're similar enough to be coalesced
+// - checks two key event records to see if they're similar enough to be coalesced
 // Arguments:
-// - a - the first KeyEvent
-// - b - the other KeyEvent
+// - a - the first key event record
+// - b - the other key event record
 // Return Value:
 // - true if the events could be coalesced, false otherwise
-bool InputBuffer::_CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept
+bool InputBuffer::_CanCoalesce(const KEY_EVENT_RECORD& a, const KEY_EVENT_RECORD& b) const noexcept
 {
-    if (WI_IsFlagSet(a.GetActiveModifierKeys(), NLS_IME_CONVERSION) &&
-        a.GetCharData() == b.GetCharData() &&
-        a.GetActiveModifierKeys() == b.GetActiveModifierKeys())
+    if (WI_IsFlagSet(a.dwControlKeyState, NLS_IME_CONVERSION) &&
+        a.uChar.UnicodeChar == b.uChar.UnicodeChar &&
+        a.dwControlKeyState == b.dwControlKeyState)
     {
         return true;
     }
     // other key events check
-    else if (a.GetVirtualScanCode() == b.GetVirtualScanCode() &&
-             a.GetCharData() == b.GetCharData() &&
-             a.GetActiveModifierKeys() == b.GetActiveModifierKeys())
+    else if (a.wVirtualScanCode == b.wVirtualScanCode &&
+             a.uChar.UnicodeChar == b.uChar.UnicodeChar &&
+             a.dwControlKeyState == b.dwControlKeyState)
     {
         return true;
     }
@@ -784,25 +847,21 @@ bool InputBuffer::_CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique
 {
     FAIL_FAST_IF(!(inEvents.size() == 1));
     FAIL_FAST_IF(_storage.empty());
-    const IInputEvent* const pFirstInEvent = inEvents.front().get();
-    const IInputEvent* const pLastStoredEvent = _storage.back().get();
-    if (pFirstInEvent->EventType() == InputEventType::KeyEvent &&
-        pLastStoredEvent->EventType() == InputEventType::KeyEvent)
+    const INPUT_RECORD inRecord = inEvents.front()->ToInputRecord();
+    INPUT_RECORD& lastStoredRecord = _storage.back();
+    if (inRecord.EventType == KEY_EVENT &&
+        lastStoredRecord.EventType == KEY_EVENT)
     {
-        const KeyEvent* const pInKeyEvent = static_cast<const KeyEvent* const>(pFirstInEvent);
-        const KeyEvent* const pLastKeyEvent = static_cast<const KeyEvent* const>(pLastStoredEvent);
+        const KEY_EVENT_RECORD& inKeyEvent = inRecord.Event.KeyEvent;
+        KEY_EVENT_RECORD& lastKeyEvent = lastStoredRecord.Event.KeyEvent;
 
-        if (pInKeyEvent->IsKeyDown() &&
-            pLastKeyEvent->IsKeyDown() &&
-            !IsGlyphFullWidth(pInKeyEvent->GetCharData()) &&
-            _CanCoalesce(*pInKeyEvent, *pLastKeyEvent))
+        if (inKeyEvent.bKeyDown &&
+            lastKeyEvent.bKeyDown &&
+            !IsGlyphFullWidth(inKeyEvent.uChar.UnicodeChar) &&
+            _CanCoalesce(inKeyEvent, lastKeyEvent))
         {
             // increment repeat count
-            KeyEvent* const pKeyEvent = static_cast<KeyEvent* const>(_storage.back().release());
-            WORD repeatCount = pKeyEvent->GetRepeatCount() + pInKeyEvent->GetRepeatCount();
-            pKeyEvent->SetRepeatCount(repeatCount);
-            std::unique_ptr<IInputEvent> tempPtr(pKeyEvent);
-            tempPtr.swap(_storage.back());
+            lastKeyEvent.wRepeatCount += inKeyEvent.wRepeatCount;
 
             inEvents.pop_front();
             return true;
@@ -877,9 +936,8 @@ void InputBuffer::_HandleTerminalInputCallback(std::deque<std::unique_ptr<IInput
         // add all input events to the storage queue
         while (!inEvents.empty())
         {
-            std::unique_ptr<IInputEvent> inEvent = std::move(inEvents.front());
+            _storage.push_back(inEvents.front()->ToInputRecord());
             inEvents.pop_front();
-            _storage.push_back(std::move(inEvent));
         }
 
         if (!_vtInputShouldSuppress)
@@ -30,6 +30,8 @@ Revision History:
 
 #include <deque>
 
+#include "boost/container/deque.hpp"
+
 class InputBuffer final : public ConsoleObjectHeader
 {
 public:
@@ -53,6 +55,9 @@ public:
     void ReinitializeInputBuffer();
     void WakeUpReadersWaitingForData();
     void TerminateRead(_In_ WaitTerminationReason Flag);
+
+    void StartDeferringWakeups() noexcept;
+    void EndDeferringWakeups() noexcept;
     size_t GetNumberOfReadyEvents() const noexcept;
     void Flush();
     void FlushAllButKeys();
@@ -74,6 +79,7 @@ public:
 
     size_t Write(_Inout_ std::unique_ptr<IInputEvent> inEvent);
     size_t Write(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
+    size_t WriteString(const std::wstring_view text);
 
     bool IsInVirtualTerminalInputMode() const;
     Microsoft::Console::VirtualTerminal::TerminalInput& GetTerminalInput();
@@ -81,7 +87,10 @@ public:
     void PassThroughWin32MouseRequest(bool enable);
 
 private:
-    std::deque<std::unique_ptr<IInputEvent>> _storage;
+    // Events are stored by value, in blocks of many records each. std::deque
+    // would allocate a block per INPUT_RECORD, as it's larger than 8 bytes.
+    using StorageOptions = boost::container::deque_options_t<boost::container::block_size<256u>>;
+    boost::container::deque<INPUT_RECORD, void, StorageOptions> _storage;
     std::unique_ptr<IInputEvent> _readPartialByteSequence;
     std::unique_ptr<IInputEvent> _writePartialByteSequence;
     Microsoft::Console::VirtualTerminal::TerminalInput _termInput;
@@ -93,6 +102,9 @@ private:
     // Otherwise, we should be calling them.
     bool _vtInputShouldSuppress{ false };
 
+    bool _deferWakeups{ false };
+    bool _wakeupPending{ false };
+
     void _ReadBuffer(_Out_ std::deque<std::unique_ptr<IInputEvent>>& outEvents,
                      const size_t readCount,
                      _Out_ size_t& eventsRead,
@@ -105,7 +117,7 @@ private:
                       _Out_ size_t& eventsWritten,
                       _Out_ bool& setWaitEvent);
 
-    bool _CanCoalesce(const KeyEvent& a, const KeyEvent& b) const noexcept;
+    bool _CanCoalesce(const KEY_EVENT_RECORD& a, const KEY_EVENT_RECORD& b) const noexcept;
     bool _CoalesceMouseMovedEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
     bool _CoalesceRepeatedKeyPressEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
     void _HandleConsoleSuspensionEvents(_Inout_ std::deque<std::unique_ptr<IInputEvent>>& inEvents);
@@ -92,23 +92,33 @@ static void _CopyRectangle(SCREEN_INFORMATION& screenInfo,
         }
     }
 
-    // 2. We can move any other scenario in-place without copying. We just have to carefully
-    //    choose which direction we walk through filling up the target so it doesn't accidentally
-    //    erase the source material before it can be copied/moved to the new location.
+    // 2. If we're only moving cells left or right within their rows (like inserting or
+    //    deleting characters does), each row can be shifted over in one block.
+    if (targetOrigin.Y == source.Top())
     {
-        const auto target = Viewport::FromDimensions(targetOrigin, source.Dimensions());
-        const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-
-        auto sourcePos = source.GetWalkOrigin(walkDirection);
-        auto targetPos = target.GetWalkOrigin(walkDirection);
-
-        do
+        auto& textBuffer = screenInfo.GetTextBuffer();
+        for (auto row = source.Top(); row <= source.BottomInclusive(); ++row)
         {
-            const auto data = OutputCell(*screenInfo.GetCellDataAt(sourcePos));
-            screenInfo.Write(OutputCellIterator({ &data, 1 }), targetPos);
+            textBuffer.MoveCells({ source.Left(), row }, source.Width(), targetOrigin.X);
+        }
+        return;
+    }
 
-            source.WalkInBounds(sourcePos, walkDirection);
-        } while (target.WalkInBounds(targetPos, walkDirection));
+    // 3. Anything else moves up or down (and maybe sideways, too), so every row of the source
+    //    can be copied over to its target row in one block. We just have to walk the rows in
+    //    the right direction, so we don't overwrite a source row before it's been copied.
+    {
+        auto& textBuffer = screenInfo.GetTextBuffer();
+        const auto width = gsl::narrow_cast<size_t>(source.Width());
+        const auto height = source.Height();
+        const auto movingUp = targetOrigin.Y < source.Top();
+        for (SHORT i = 0; i < height; ++i)
+        {
+            const auto offset = gsl::narrow_cast<SHORT>(movingUp ? i : height - 1 - i);
+            textBuffer.CopyCells({ source.Left(), gsl::narrow_cast<SHORT>(source.Top() + offset) },
+                                 width,
+                                 { targetOrigin.X, gsl::narrow_cast<SHORT>(targetOrigin.Y + offset) });
+        }
     }
 }
 
@@ -283,6 +293,18 @@ static void _ScrollScreen(SCREEN_INFORMATION& screenInfo, const Viewport& source
     // Get the render target and send it commands.
     // It will figure out whether or not we're active and where the messages need to go.
     auto& render = screenInfo.GetRenderTarget();
+
+    // Entire rows that moved up or down (like the ones between the scrolling margins)
+    // are a pure scroll, which the engines can apply to what they've already drawn.
+    // The rows that were filled are invalidated by the text buffer as they're written.
+    const auto width = screenInfo.GetBufferSize().Width();
+    if (source.Left() == 0 && target.Left() == 0 && source.Width() == width && target.Width() == width && source.Top() != target.Top())
+    {
+        const COORD delta{ 0, gsl::narrow_cast<SHORT>(target.Top() - source.Top()) };
+        render.TriggerScrollRegion(Viewport::Union(source, target), &delta);
+        return;
+    }
+
     // Redraw anything in the target area
     render.TriggerRedraw(target);
     // Also redraw anything that was filled.
@@ -382,13 +404,15 @@ void ScrollRegion(SCREEN_INFORMATION& screenInfo,
 
     // Determine the cell we will use to fill in any revealed/uncovered space.
     // We generally use exactly what was given to us.
-    OutputCellIterator fillData(fillCharGiven, fillAttrsGiven);
+    auto fillChar = fillCharGiven;
+    auto fillAttrs = fillAttrsGiven;
 
     // However, if the character is null and we were given a null attribute (represented as legacy 0),
     // then we'll just fill with spaces and whatever the buffer's default colors are.
     if (fillCharGiven == UNICODE_NULL && fillAttrsGiven == TextAttribute{ 0 })
     {
-        fillData = OutputCellIterator(UNICODE_SPACE, screenInfo.GetAttributes());
+        fillChar = UNICODE_SPACE;
+        fillAttrs = screenInfo.GetAttributes();
     }
 
     // ------ 4. PREP TARGET ------
@@ -450,7 +474,20 @@ void ScrollRegion(SCREEN_INFORMATION& screenInfo,
     for (size_t i = 0; i < remaining.size(); i++)
     {
         const auto& view = remaining.at(i);
-        screenInfo.WriteRect(fillData, view);
+
+        // A narrow fill character can be filled into each row in one block.
+        if (!IsGlyphFullWidth(fillChar))
+        {
+            auto& textBuffer = screenInfo.GetTextBuffer();
+            for (auto row = view.Top(); row < view.BottomExclusive(); ++row)
+            {
+                textBuffer.Fill({ view.Left(), row }, gsl::narrow_cast<size_t>(view.Width()), fillChar, fillAttrs);
+            }
+        }
+        else
+        {
+            screenInfo.WriteRect(OutputCellIterator(fillChar, fillAttrs), view);
+        }
 
         // If we're scrolling an area that encompasses the full buffer width,
         // then the filled rows should also have their line rendition reset.
@@ -82,6 +82,12 @@ void WriteBuffer::_DefaultStringCase(const std::wstring_view string)
         cursor.SetIsOn(true);
     }
 
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    if (gci.IsInVtIoMode() && gci.GetVtIo()->IsTextStream())
+    {
+        gci.GetVtIo()->WriteTextStream(string);
+    }
+
     // Defer the cursor drawing while we are iterating the string, for a better performance.
     // We can not waste time displaying a cursor event when we know more text is coming right behind it.
     cursor.StartDeferDrawing();
@@ -391,6 +397,12 @@ bool ConhostInternalGetSet::PrivateGetLineFeedMode() const
 // - true if successful (see DoSrvPrivateLineFeed). false otherwise.
 bool ConhostInternalGetSet::PrivateLineFeed(const bool withReturn)
 {
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    if (gci.IsInVtIoMode() && gci.GetVtIo()->IsTextStream())
+    {
+        gci.GetVtIo()->WriteTextStream(L"\n");
+    }
+
     return NT_SUCCESS(DoSrvPrivateLineFeed(_io.GetActiveOutputBuffer(), withReturn));
 }
 
@@ -532,6 +544,20 @@ bool ConhostInternalGetSet::PrivateEnableAlternateScroll(const bool enabled)
     return true;
 }
 
+// Routine Description:
+// - Connects the PrivateEnableSynchronizedOutput call directly into our Driver Message servicing call inside Conhost.exe
+//   PrivateEnableSynchronizedOutput is an internal-only "API" call that the vt commands can execute,
+//     but it is not represented as a function call on out public API surface.
+// Arguments:
+// - enabled - set to true to start a synchronized update, false to end it
+// Return Value:
+// - true if successful (see DoSrvPrivateEnableSynchronizedOutput). false otherwise.
+bool ConhostInternalGetSet::PrivateEnableSynchronizedOutput(const bool enabled)
+{
+    DoSrvPrivateEnableSynchronizedOutput(enabled);
+    return true;
+}
+
 // Routine Description:
 // - Connects the PrivateEraseAll call directly into our Driver Message servicing call inside Conhost.exe
 //   PrivateEraseAll is an internal-only "API" call that the vt commands can execute,
@@ -833,3 +859,17 @@ bool ConhostInternalGetSet::PrivateUpdateSoftFont(const gsl::span<const uint16_t
 {
     return SUCCEEDED(DoSrvUpdateSoftFont(bitPattern, cellSize, centeringHint));
 }
+
+// Method Description:
+// - Draws a slice of an image over the row of the active screen buffer that
+//   the cursor is on.
+// Arguments:
+// - imageSlice - the slice to draw
+// Return Value:
+// - true if successful. false otherwise.
+bool ConhostInternalGetSet::PrivateAddImageSlice(std::shared_ptr<const ImageSlice> imageSlice)
+{
+    auto& textBuffer = _io.GetActiveOutputBuffer().GetTextBuffer();
+    textBuffer.SetCurrentImageSlice(std::move(imageSlice));
+    return true;
+}
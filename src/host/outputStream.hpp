@@ -103,6 +103,7 @@ public:
     bool PrivateEnableButtonEventMouseMode(const bool enabled) override;
     bool PrivateEnableAnyEventMouseMode(const bool enabled) override;
     bool PrivateEnableAlternateScroll(const bool enabled) override;
+    bool PrivateEnableSynchronizedOutput(const bool enabled) override;
     bool PrivateEraseAll() override;
 
     bool GetUserDefaultCursorStyle(CursorType& style) override;
@@ -151,6 +152,8 @@ public:
                                const SIZE cellSize,
                                const size_t centeringHint) noexcept override;
 
+    bool PrivateAddImageSlice(std::shared_ptr<const ImageSlice> imageSlice) override;
+
 private:
     Microsoft::Console::IIoProvider& _io;
 };
@@ -578,6 +578,8 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
     {
         bool CallWrite = true;
         const SHORT sScreenBufferSizeX = _screenInfo.GetBufferSize().Width();
+        // Nothing in front of the cursor changes, unless backspace moves it.
+        const auto firstChanged = _currentPosition;
 
         // processing in the middle of the line is more complex:
 
@@ -707,29 +709,16 @@ bool COOKED_READ_DATA::ProcessInput(const wchar_t wchOrig,
             CursorPosition = _screenInfo.GetTextBuffer().GetCursor().GetPosition();
             CursorPosition.X = (SHORT)(CursorPosition.X + NumSpaces);
 
-            // clear the current command line from the screen
-            // clang-format off
-#pragma prefast(suppress: __WARNING_BUFFER_OVERFLOW, "Not sure why prefast doesn't like this call.")
-            // clang-format on
-            DeleteCommandLine(*this, FALSE);
-
-            // write the new command line to the screen
-            NumToWrite = _bytesRead;
-
+            // redraw the command line from the first character that changed
             DWORD dwFlags = WC_DESTRUCTIVE_BACKSPACE | WC_PRINTABLE_CONTROL_CHARS;
             if (wch == UNICODE_CARRIAGERETURN)
             {
                 dwFlags |= WC_KEEP_CURSOR_VISIBLE;
             }
-            status = WriteCharsLegacy(_screenInfo,
-                                      _backupLimit,
-                                      _backupLimit,
-                                      _backupLimit,
-                                      &NumToWrite,
-                                      &_visibleCharCount,
-                                      _originalCursorPosition.X,
-                                      dwFlags,
-                                      &ScrollY);
+            status = RedrawCommandLineFrom(*this,
+                                           std::min(firstChanged, _currentPosition),
+                                           dwFlags,
+                                           &ScrollY);
             if (!NT_SUCCESS(status))
             {
                 RIPMSG1(RIP_WARNING, "WriteCharsLegacy failed 0x%x", status);
@@ -7,20 +7,29 @@
 
 #pragma hdrstop
 
-RenderFontDefaults::RenderFontDefaults()
-{
-    LOG_IF_NTSTATUS_FAILED(TrueTypeFontList::s_Initialize());
-}
+// The TrueType font list is read from the registry on first use, not here.
+// Every conhost creates one of these at startup, but many never need a
+// default font: conpty sessions, and sessions that are handed off before
+// they get a window.
+RenderFontDefaults::RenderFontDefaults() = default;
 
 RenderFontDefaults::~RenderFontDefaults()
 {
-    LOG_IF_FAILED(TrueTypeFontList::s_Destroy());
+    if (_loaded)
+    {
+        LOG_IF_FAILED(TrueTypeFontList::s_Destroy());
+    }
 }
 
 [[nodiscard]] HRESULT RenderFontDefaults::RetrieveDefaultFontNameForCodepage(const unsigned int codePage,
                                                                              std::wstring& outFaceName)
 try
 {
+    std::call_once(_initialized, [this]() {
+        LOG_IF_NTSTATUS_FAILED(TrueTypeFontList::s_Initialize());
+        _loaded = true;
+    });
+
     // GH#3123: Propagate font length changes up through Settings and propsheet
     wchar_t faceName[LF_FACESIZE]{ 0 };
     NTSTATUS status = TrueTypeFontList::s_SearchByCodePage(codePage, faceName, ARRAYSIZE(faceName));
@@ -89,6 +89,7 @@ SCREEN_INFORMATION::~SCREEN_INFORMATION()
 // - coordWindowSize - the initial size of screen buffer's window (in rows/columns)
 // - nFont - the initial font to generate text with.
 // - dwScreenBufferSize - the initial size of the screen buffer (in rows/columns).
+// - storageResource - where the text buffer allocates its rows and cells from.
 // Return Value:
 [[nodiscard]] NTSTATUS SCREEN_INFORMATION::CreateInstance(_In_ COORD coordWindowSize,
                                                           const FontInfo fontInfo,
@@ -96,7 +97,8 @@ SCREEN_INFORMATION::~SCREEN_INFORMATION()
                                                           const TextAttribute defaultAttributes,
                                                           const TextAttribute popupAttributes,
                                                           const UINT uiCursorSize,
-                                                          _Outptr_ SCREEN_INFORMATION** const ppScreen)
+                                                          _Outptr_ SCREEN_INFORMATION** const ppScreen,
+                                                          std::pmr::memory_resource* const storageResource)
 {
     *ppScreen = nullptr;
 
@@ -120,7 +122,8 @@ SCREEN_INFORMATION::~SCREEN_INFORMATION()
         pScreen->_textBuffer = std::make_unique<TextBuffer>(coordScreenBufferSize,
                                                             defaultAttributes,
                                                             uiCursorSize,
-                                                            pScreen->_renderTarget);
+                                                            pScreen->_renderTarget,
+                                                            storageResource);
 
         const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         pScreen->_textBuffer->GetCursor().SetColor(gci.GetCursorColor());
@@ -534,6 +537,7 @@ void SCREEN_INFORMATION::RefreshFontWithRenderer()
                                                                        GetCurrentFont());
 
             NotifyGlyphWidthFontChanged();
+            PrewarmGlyphWidthFallback();
         }
     }
 }
@@ -1094,6 +1098,13 @@ void SCREEN_INFORMATION::_InternalSetViewportSize(const COORD* const pcoordSize,
     const short DeltaY = pcoordSize->Y - _viewport.Height();
     const COORD coordScreenBufferSize = GetBufferSize().Dimensions();
 
+    // Alternate buffers are as large as the viewport. Whatever the last one
+    // left behind won't fit the next one anymore, so don't hold on to it.
+    if (DeltaX != 0 || DeltaY != 0)
+    {
+        _altStorageResource.Release();
+    }
+
     // do adjustments on a copy that's easily manipulated.
     SMALL_RECT srNewViewport = _viewport.ToInclusive();
 
@@ -1530,8 +1541,12 @@ bool SCREEN_INFORMATION::IsMaximizedY() const
     // cancel any popups before resizing or they will not necessarily line up with new buffer positions
     CommandLine::Instance().EndAllPopups();
 
+    // If the connected terminal reflows its own buffer, it already has the
+    // text where it wants it. A traditional resize of our (viewport sized)
+    // buffer is then enough, and doesn't produce anything we'd need to send.
+    const bool terminalReflows = gci.IsInVtIoMode() && gci.GetVtIo()->IsTerminalReflowEnabled();
     const bool fWrapText = gci.GetWrapText();
-    if (fWrapText)
+    if (fWrapText && !terminalReflows)
     {
         status = ResizeWithReflow(coordNewScreenSize);
     }
@@ -1901,7 +1916,8 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
                                                          initAttributes,
                                                          GetPopupAttributes(),
                                                          Cursor::CURSOR_SMALL_SIZE,
-                                                         ppsiNewScreenBuffer);
+                                                         ppsiNewScreenBuffer,
+                                                         &GetMainBuffer()._altStorageResource);
     if (NT_SUCCESS(Status))
     {
         // Update the alt buffer's cursor style, visibility, and position to match our own.
@@ -2249,11 +2265,11 @@ void SCREEN_INFORMATION::SetViewport(const Viewport& newViewport,
     COORD relativeCursor = oldCursorPos;
     oldViewport.ConvertToOrigin(&relativeCursor);
 
-    short delta = (sNewTop + _viewport.Height()) - (GetBufferSize().Height());
-    for (auto i = 0; i < delta; i++)
+    const short delta = (sNewTop + _viewport.Height()) - (GetBufferSize().Height());
+    if (delta > 0)
     {
-        _textBuffer->IncrementCircularBuffer();
-        sNewTop--;
+        _textBuffer->AdvanceCircularBuffer(delta);
+        sNewTop -= delta;
     }
 
     const COORD coordNewOrigin = { 0, sNewTop };
@@ -2266,10 +2282,7 @@ void SCREEN_INFORMATION::SetViewport(const Viewport& newViewport,
     // i.e. the current background color, but with no meta attributes set.
     auto fillAttributes = GetAttributes();
     fillAttributes.SetStandardErase();
-    auto fillPosition = COORD{ 0, _viewport.Top() };
-    auto fillLength = gsl::narrow_cast<size_t>(_viewport.Height() * GetBufferSize().Width());
-    auto fillData = OutputCellIterator{ fillAttributes, fillLength };
-    Write(fillData, fillPosition, false);
+    _textBuffer->ClearRows(_viewport.Top(), _viewport.Height(), fillAttributes);
 
     // Also reset the line rendition for the erased rows.
     _textBuffer->ResetLineRenditionRange(_viewport.Top(), _viewport.BottomExclusive());
@@ -25,6 +25,7 @@ Revision History:
 #include "ScreenBufferRenderTarget.hpp"
 
 #include "../buffer/out/OutputCellRect.hpp"
+#include "../buffer/out/SpareBlockResource.hpp"
 #include "../buffer/out/TextAttribute.hpp"
 #include "../buffer/out/textBuffer.hpp"
 #include "../buffer/out/textBufferCellIterator.hpp"
@@ -67,7 +68,8 @@ public:
                                                  const TextAttribute defaultAttributes,
                                                  const TextAttribute popupAttributes,
                                                  const UINT uiCursorSize,
-                                                 _Outptr_ SCREEN_INFORMATION** const ppScreen);
+                                                 _Outptr_ SCREEN_INFORMATION** const ppScreen,
+                                                 std::pmr::memory_resource* const storageResource = til::pmr::get_default_resource());
 
     ~SCREEN_INFORMATION();
 
@@ -291,6 +293,11 @@ private:
     RECT _rcAltSavedClientOld;
     bool _fAltWindowChanged;
 
+    // The rows and cells of the alternate buffer are allocated from here. The last
+    // alternate buffer's storage is kept when it's deleted, so switching back to the
+    // alternate buffer at the same size doesn't have to allocate it again.
+    SpareBlockResource _altStorageResource;
+
     TextAttribute _PopupAttributes;
 
     FontInfo _currentFont;
@@ -62,8 +62,11 @@ try
 
     // Check if this conhost is allowed to delegate its activities to another.
     // If so, look up the registered default console handler.
+    // If we're receiving a handoff, ConsoleEstablishHandoff already looked
+    // these up, and we won't hand off again anyway.
     bool isEnabled = false;
-    if (SUCCEEDED(Microsoft::Console::Internal::DefaultApp::CheckDefaultAppPolicy(isEnabled)) && isEnabled)
+    if (!Globals.handoffTarget &&
+        SUCCEEDED(Microsoft::Console::Internal::DefaultApp::CheckDefaultAppPolicy(isEnabled)) && isEnabled)
     {
         IID delegationClsid;
         if (SUCCEEDED(DelegationConfig::s_GetDefaultConsoleId(delegationClsid)))
@@ -82,7 +85,9 @@ try
     // for the terminal user interface, so we should set ourselves up to skip all
     // those notifications and the mathematical calculations required to send those events
     // for performance reasons.
-    if (!args->InConptyMode())
+    // If there's a console to hand off to, the session most likely won't be hosted here at all.
+    // ConsoleHandleConnectionRequest creates the notifier once it knows that we're keeping it.
+    if (!args->InConptyMode() && !Globals.handoffConsoleClsid)
     {
         RETURN_IF_FAILED(ServiceLocator::CreateAccessibilityNotifier());
     }
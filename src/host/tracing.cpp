@@ -415,6 +415,37 @@ void Tracing::s_TraceCookedRead(_In_z_ const wchar_t* pwszCookedBuffer)
         TraceLoggingKeyword(TraceKeywords::CookedRead));
 }
 
+void Tracing::s_TraceDeviceCommStatistics(const uint64_t messages, const uint64_t transitions)
+{
+    // Do all logic outside macros.
+    const auto messagesPerTransition = transitions ? static_cast<double>(messages) / transitions : 0.0;
+
+    TraceLoggingWrite(
+        g_hConhostV2EventTraceProvider,
+        "DeviceCommStatistics",
+        TraceLoggingUInt64(messages, "Messages"),
+        TraceLoggingUInt64(transitions, "KernelTransitions"),
+        TraceLoggingFloat64(messagesPerTransition, "MessagesPerTransition"),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TIL_KEYWORD_TRACE),
+        TraceLoggingKeyword(TraceKeywords::API));
+}
+
+void Tracing::s_TraceCursorInheritance(const std::chrono::milliseconds waited, const bool inherited)
+{
+    // Do all logic outside macros.
+    const auto waitedMs = gsl::narrow_cast<uint64_t>(waited.count());
+
+    TraceLoggingWrite(
+        g_hConhostV2EventTraceProvider,
+        "CursorInheritance",
+        TraceLoggingUInt64(waitedMs, "WaitedMs"),
+        TraceLoggingBool(inherited, "Inherited"),
+        TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+        TraceLoggingKeyword(TIL_KEYWORD_TRACE),
+        TraceLoggingKeyword(TraceKeywords::General));
+}
+
 void __stdcall Tracing::TraceFailure(const wil::FailureInfo& failure) noexcept
 {
     TraceLoggingWrite(
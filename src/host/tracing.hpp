@@ -64,6 +64,10 @@ public:
 
     static void s_TraceCookedRead(_In_z_ const wchar_t* pwszCookedBuffer);
 
+    static void s_TraceDeviceCommStatistics(const uint64_t messages, const uint64_t transitions);
+
+    static void s_TraceCursorInheritance(const std::chrono::milliseconds waited, const bool inherited);
+
     static void __stdcall TraceFailure(const wil::FailureInfo& failure) noexcept;
 
 private:
@@ -877,4 +877,67 @@ class ApiRoutinesTests
 
         ValidateComplexScreen(si, background, fill, scrollRect, Viewport::FromInclusive(scroll), destination, clipViewport);
     }
+
+    TEST_METHOD(ApiWriteReadConsoleOutputW)
+    {
+        CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer();
+
+        const WORD blueOnWhite = FOREGROUND_BLUE | BACKGROUND_RED | BACKGROUND_GREEN | BACKGROUND_BLUE;
+        const WORD greenOnBlack = FOREGROUND_GREEN;
+
+        // Two rows of four cells, with a change of colors and a double byte pair in the first one.
+        std::array<CHAR_INFO, 8> cells;
+        cells[0] = { L'A', blueOnWhite };
+        cells[1] = { L'B', blueOnWhite };
+        cells[2] = { L'\x304b', gsl::narrow_cast<WORD>(greenOnBlack | COMMON_LVB_LEADING_BYTE) };
+        cells[3] = { L'\x304b', gsl::narrow_cast<WORD>(greenOnBlack | COMMON_LVB_TRAILING_BYTE) };
+        cells[4] = { L'C', greenOnBlack };
+        cells[5] = { L'D', greenOnBlack };
+        cells[6] = { L'E', blueOnWhite };
+        cells[7] = { L'F', blueOnWhite };
+
+        const auto request = Viewport::FromDimensions({ 2, 1 }, { 4, 2 });
+        Viewport written;
+        VERIFY_SUCCEEDED(_pApiRoutines->WriteConsoleOutputWImpl(si, cells, request, written));
+        VERIFY_ARE_EQUAL(request.ToInclusive(), written.ToInclusive());
+
+        Log::Comment(L"Read back exactly what we wrote.");
+        {
+            std::array<CHAR_INFO, 8> readBack{};
+            Viewport read;
+            VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, readBack, request, read));
+            VERIFY_ARE_EQUAL(request.ToInclusive(), read.ToInclusive());
+
+            for (size_t i = 0; i < cells.size(); ++i)
+            {
+                VERIFY_ARE_EQUAL(cells[i].Char.UnicodeChar, readBack[i].Char.UnicodeChar);
+                VERIFY_ARE_EQUAL(cells[i].Attributes, readBack[i].Attributes);
+            }
+        }
+
+        Log::Comment(L"Read a request that hangs off the top left of the buffer.");
+        {
+            // This reads the 3x2 cells at 0,0 into the bottom right of a 4x3 buffer.
+            // The cells that fall outside of the screen buffer must be left alone.
+            const CHAR_INFO sentinel{ L'?', 0 };
+            std::array<CHAR_INFO, 12> readBack;
+            readBack.fill(sentinel);
+
+            const auto hanging = Viewport::FromDimensions({ -1, -1 }, { 4, 3 });
+            Viewport read;
+            VERIFY_SUCCEEDED(_pApiRoutines->ReadConsoleOutputWImpl(si, readBack, hanging, read));
+            VERIFY_ARE_EQUAL(Viewport::FromDimensions({ 0, 0 }, { 3, 2 }).ToInclusive(), read.ToInclusive());
+
+            for (size_t i = 0; i < 5; ++i)
+            {
+                VERIFY_ARE_EQUAL(sentinel.Char.UnicodeChar, readBack[i].Char.UnicodeChar);
+            }
+            VERIFY_ARE_EQUAL(sentinel.Char.UnicodeChar, readBack[8].Char.UnicodeChar);
+
+            // The last row of the buffer holds row 1 of the screen, which starts with the first row we wrote at column 2.
+            VERIFY_ARE_EQUAL(L'A', readBack[11].Char.UnicodeChar);
+            VERIFY_ARE_EQUAL(blueOnWhite, readBack[11].Attributes);
+        }
+    }
 };
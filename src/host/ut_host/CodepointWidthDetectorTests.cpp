@@ -62,6 +62,50 @@ class CodepointWidthDetectorTests
         }
     }
 
+    TEST_METHOD(BmpTableMatchesRanges)
+    {
+        CodepointWidthDetector widthDetector;
+        for (unsigned int codepoint = 0; codepoint <= 0xFFFF; ++codepoint)
+        {
+            const auto wch = static_cast<wchar_t>(codepoint);
+            const auto expected = CodepointWidthDetector::_lookupRangeWidth(codepoint);
+            const auto result = widthDetector._lookupGlyphWidth({ &wch, 1 });
+            if (result != expected)
+            {
+                VERIFY_FAIL(WEX::Common::NoThrowString().Format(L"U+%04X is %d in the BMP table, but %d in the ranges", codepoint, static_cast<int>(result), static_cast<int>(expected)));
+            }
+        }
+    }
+
+    TEST_METHOD(CanGetWidthsInBulk)
+    {
+        CodepointWidthDetector widthDetector;
+
+        // Mix runs of ASCII that are long enough to be classified 8 at a time
+        // with wide, ambiguous and non-BMP glyphs and a lone surrogate.
+        std::wstring text{ L"ab\x306A" L"cdefghijklmnop" };
+        text.append(emoji);
+        text.append(ambiguous);
+        text.append(L"0123456789\a\x72D7\xD83D" L"qrstuvwx");
+
+        std::vector<CodepointWidth> widths(text.size(), CodepointWidth::Invalid);
+        widthDetector.GetWidths(text, widths);
+
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            if (IS_HIGH_SURROGATE(text[i]) && i + 1 < text.size() && IS_LOW_SURROGATE(text[i + 1]))
+            {
+                VERIFY_ARE_EQUAL(widthDetector.GetWidth({ &text[i], 2 }), widths[i]);
+                VERIFY_ARE_EQUAL(CodepointWidth::Invalid, widths[i + 1]);
+                ++i;
+            }
+            else
+            {
+                VERIFY_ARE_EQUAL(widthDetector.GetWidth({ &text[i], 1 }), widths[i]);
+            }
+        }
+    }
+
     static bool FallbackMethod(const std::wstring_view glyph)
     {
         if (glyph.size() < 1)
@@ -80,22 +124,67 @@ class CodepointWidthDetectorTests
         CodepointWidthDetector widthDetector;
         widthDetector.SetFallbackMethod(std::bind(&FallbackMethod, std::placeholders::_1));
 
+        const auto codepoint = CodepointWidthDetector::_extractCodepoint(ambiguous);
+        bool isWide = false;
+
         // Ensure fallback cache is empty.
-        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.size());
+        VERIFY_IS_FALSE(widthDetector._tryGetCachedFallback(codepoint, isWide));
 
         // Lookup ambiguous width character.
         widthDetector.IsWide(ambiguous);
 
-        // Cache should hold it.
-        VERIFY_ARE_EQUAL(1u, widthDetector._fallbackCache.size());
-
-        // Cached item should match what we expect
-        const auto it = widthDetector._fallbackCache.begin();
-        VERIFY_ARE_EQUAL(ambiguous, it->first);
-        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), it->second);
+        // Cache should hold it, and the cached item should match what we expect.
+        VERIFY_IS_TRUE(widthDetector._tryGetCachedFallback(codepoint, isWide));
+        VERIFY_ARE_EQUAL(FallbackMethod(ambiguous), isWide);
 
         // Cache should empty when font changes.
         widthDetector.NotifyFontChanged();
-        VERIFY_ARE_EQUAL(0u, widthDetector._fallbackCache.size());
+        VERIFY_IS_FALSE(widthDetector._tryGetCachedFallback(codepoint, isWide));
+    }
+
+    TEST_METHOD(AmbiguousCacheCollisions)
+    {
+        // Store more results than fit in the cache, so that codepoints collide
+        // and get evicted. Whatever is still cached must be correct.
+        CodepointWidthDetector widthDetector;
+        widthDetector.SetFallbackMethod(std::bind(&FallbackMethod, std::placeholders::_1));
+
+        for (unsigned int codepoint = 0xE000; codepoint < 0xE000 + 2 * CodepointWidthDetector::s_fallbackCacheSize; ++codepoint)
+        {
+            widthDetector._storeCachedFallback(codepoint, (codepoint % 2) == 1);
+        }
+
+        size_t hits = 0;
+        for (unsigned int codepoint = 0xE000; codepoint < 0xE000 + 2 * CodepointWidthDetector::s_fallbackCacheSize; ++codepoint)
+        {
+            bool isWide = false;
+            if (widthDetector._tryGetCachedFallback(codepoint, isWide))
+            {
+                VERIFY_ARE_EQUAL((codepoint % 2) == 1, isWide);
+                ++hits;
+            }
+        }
+        VERIFY_IS_GREATER_THAN(hits, 0u);
+        VERIFY_IS_LESS_THAN_OR_EQUAL(hits, CodepointWidthDetector::s_fallbackCacheSize);
+    }
+
+    TEST_METHOD(PrewarmFallbackCache)
+    {
+        CodepointWidthDetector widthDetector;
+
+        size_t calls = 0;
+        widthDetector.SetFallbackMethod([&](const std::wstring_view glyph) {
+            ++calls;
+            return FallbackMethod(glyph);
+        });
+
+        widthDetector.PrewarmFallbackCache();
+        VERIFY_IS_GREATER_THAN(calls, 0u);
+
+        // U+2500 box drawings light horizontal is ambiguous and prewarmed,
+        // so asking for it must not call the fallback again.
+        const auto before = calls;
+        VERIFY_ARE_EQUAL(FallbackMethod(L"\x2500"), widthDetector.IsWide(L"\x2500"));
+        VERIFY_ARE_EQUAL(before, calls);
     }
 };
@@ -147,6 +147,42 @@ class CommandLineTests
         VerifyPromptText(cookedReadData, L"echo 2");
     }
 
+    TEST_METHOD(HistoryCyclingOnlyRedrawsChangedText)
+    {
+        auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
+        VERIFY_IS_NOT_NULL(buffer.get());
+
+        auto& consoleInfo = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& screenInfo = consoleInfo.GetActiveOutputBuffer();
+        auto& cookedReadData = consoleInfo.CookedReadData();
+        InitCookedReadData(cookedReadData, m_pHistory, buffer.get(), PROMPT_SIZE);
+        const auto origin = screenInfo.GetTextBuffer().GetCursor().GetPosition();
+        cookedReadData.OriginalCursorPosition() = origin;
+
+        VERIFY_SUCCEEDED(m_pHistory->Add(L"echo hi", false));
+        VERIFY_SUCCEEDED(m_pHistory->Add(L"echo hello world", false));
+
+        auto& commandLine = CommandLine::Instance();
+        commandLine._processHistoryCycling(cookedReadData, CommandHistory::SearchDirection::Previous);
+        VerifyPromptText(cookedReadData, L"echo hello world");
+        commandLine._processHistoryCycling(cookedReadData, CommandHistory::SearchDirection::Previous);
+        VerifyPromptText(cookedReadData, L"echo hi");
+        VERIFY_ARE_EQUAL(7u, cookedReadData.VisibleCharCount());
+
+        Log::Comment(L"The tail of the longer command must have been erased.");
+        std::wstring text;
+        auto cellIterator = screenInfo.GetCellDataAt(origin);
+        for (size_t i = 0; i < 16; ++i, ++cellIterator)
+        {
+            text += cellIterator->Chars();
+        }
+        VERIFY_ARE_EQUAL(std::wstring{ L"echo hi         " }, text);
+
+        auto cursorExpected = origin;
+        cursorExpected.X += 7;
+        VERIFY_ARE_EQUAL(cursorExpected, screenInfo.GetTextBuffer().GetCursor().GetPosition());
+    }
+
     TEST_METHOD(CanSetPromptToOldestHistory)
     {
         auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
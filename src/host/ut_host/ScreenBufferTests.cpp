@@ -150,6 +150,7 @@ class ScreenBufferTests
 
     TEST_METHOD(BackspaceDefaultAttrs);
     TEST_METHOD(BackspaceDefaultAttrsWriteCharsLegacy);
+    TEST_METHOD(WriteCharsLegacyAsciiRuns);
 
     TEST_METHOD(BackspaceDefaultAttrsInPrompt);
 
@@ -2612,6 +2613,63 @@ void ScreenBufferTests::BackspaceDefaultAttrsWriteCharsLegacy()
     VERIFY_ARE_EQUAL(magenta, gci.LookupAttributeColors(attrB).second);
 }
 
+void ScreenBufferTests::WriteCharsLegacyAsciiRuns()
+{
+    // Printable ASCII is committed straight into the row by WriteCharsLegacy.
+    // Make sure it lands in the same place, with the same attributes and wrap
+    // state, as text that goes through the regular per character processing.
+
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    SCREEN_INFORMATION& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    const TextBuffer& tbi = si.GetTextBuffer();
+    Cursor& cursor = si.GetTextBuffer().GetCursor();
+    const auto bufferWidth = si.GetBufferSize().Width();
+
+    VERIFY_SUCCEEDED(si.SetViewportOrigin(true, COORD({ 0, 0 }), true));
+    cursor.SetPosition({ 0, 0 });
+
+    TextAttribute attr{ FOREGROUND_GREEN | BACKGROUND_BLUE };
+    si.SetAttributes(attr);
+
+    Log::Comment(L"Mix ASCII runs with a tab and a wide glyph.");
+    {
+        std::wstring_view str{ L"AB\tC\x304bD" };
+        size_t seqCb = str.size() * sizeof(wchar_t);
+        VERIFY_SUCCESS_NTSTATUS(WriteCharsLegacy(si, str.data(), str.data(), str.data(), &seqCb, nullptr, cursor.GetPosition().X, 0, nullptr));
+        VERIFY_ARE_EQUAL(str.size() * sizeof(wchar_t), seqCb);
+    }
+
+    VERIFY_ARE_EQUAL(COORD({ 12, 0 }), cursor.GetPosition());
+    {
+        const ROW& row = tbi.GetRowByOffset(0);
+        const auto text = row.GetText();
+        VERIFY_ARE_EQUAL(L"AB      C\x304bD", text.substr(0, 11));
+        for (uint16_t x = 0; x < 12; ++x)
+        {
+            VERIFY_ARE_EQUAL(attr, row.GetAttrRow().GetAttrByColumn(x));
+        }
+        VERIFY_IS_TRUE(row.GetCharRow().DbcsAttrAt(0).IsSingle());
+        VERIFY_IS_TRUE(row.GetCharRow().DbcsAttrAt(9).IsLeading());
+        VERIFY_IS_TRUE(row.GetCharRow().DbcsAttrAt(10).IsTrailing());
+        VERIFY_IS_TRUE(row.GetCharRow().DbcsAttrAt(11).IsSingle());
+    }
+
+    Log::Comment(L"Write an ASCII run that's longer than a line.");
+    cursor.SetPosition({ 0, 1 });
+    {
+        const std::wstring str(bufferWidth + 5, L'x');
+        size_t seqCb = str.size() * sizeof(wchar_t);
+        VERIFY_SUCCESS_NTSTATUS(WriteCharsLegacy(si, str.data(), str.data(), str.data(), &seqCb, nullptr, cursor.GetPosition().X, 0, nullptr));
+        VERIFY_ARE_EQUAL(str.size() * sizeof(wchar_t), seqCb);
+    }
+
+    VERIFY_ARE_EQUAL(COORD({ 5, 2 }), cursor.GetPosition());
+    VERIFY_IS_TRUE(tbi.GetRowByOffset(1).WasWrapForced());
+    VERIFY_ARE_EQUAL(std::wstring(bufferWidth, L'x'), tbi.GetRowByOffset(1).GetText());
+    VERIFY_ARE_EQUAL(L"xxxxx ", tbi.GetRowByOffset(2).GetText().substr(0, 6));
+    VERIFY_ARE_EQUAL(attr, tbi.GetRowByOffset(2).GetAttrRow().GetAttrByColumn(4));
+}
+
 void ScreenBufferTests::BackspaceDefaultAttrsInPrompt()
 {
     // Tests MSFT:19853701 - when you edit the prompt line at a bash prompt,
@@ -156,4 +156,61 @@ class SearchTests
         Search s(gci.renderData, L"\x304b", Search::Direction::Backward, Search::Sensitivity::CaseInsensitive);
         DoFoundChecks(s, coordStartExpected, -1);
     }
+
+    TEST_METHOD(FindAllCaseInsensitive)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        Search s(gci.renderData, L"ab", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive);
+
+        const auto all = s.FindAll(0, SHRT_MAX);
+        VERIFY_ARE_EQUAL(4u, all.size());
+        for (SHORT i = 0; i < 4; ++i)
+        {
+            VERIFY_ARE_EQUAL((COORD{ 0, i }), all.at(i).first);
+            VERIFY_ARE_EQUAL((COORD{ 1, i }), all.at(i).second);
+        }
+
+        Log::Comment(L"Searching a range of rows should only find the matches that start in it.");
+        const auto some = s.FindAll(1, 2);
+        VERIFY_ARE_EQUAL(2u, some.size());
+        VERIFY_ARE_EQUAL((COORD{ 0, 1 }), some.at(0).first);
+        VERIFY_ARE_EQUAL((COORD{ 0, 2 }), some.at(1).first);
+
+        Log::Comment(L"FindAll shouldn't move where FindNext continues from.");
+        COORD coordStartExpected = { 0 };
+        DoFoundChecks(s, coordStartExpected, 1);
+    }
+
+    TEST_METHOD(FindAllRegularExpression)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        Log::Comment(L"'.' should match the wide \x304d, which covers two cells.");
+        Search wide(gci.renderData, L"C.D", Search::Direction::Forward, Search::Sensitivity::CaseSensitive, Search::Syntax::RegularExpression);
+        const auto wideMatches = wide.FindAll(0, SHRT_MAX);
+        VERIFY_ARE_EQUAL(4u, wideMatches.size());
+        for (SHORT i = 0; i < 4; ++i)
+        {
+            VERIFY_ARE_EQUAL((COORD{ 4, i }), wideMatches.at(i).first);
+            VERIFY_ARE_EQUAL((COORD{ 7, i }), wideMatches.at(i).second);
+        }
+
+        Log::Comment(L"'$' should match before the spaces that pad the end of the row.");
+        Search end(gci.renderData, L"e$", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive, Search::Syntax::RegularExpression);
+        const auto endMatches = end.FindAll(0, SHRT_MAX);
+        VERIFY_ARE_EQUAL(4u, endMatches.size());
+        VERIFY_ARE_EQUAL((COORD{ 8, 0 }), endMatches.at(0).first);
+        VERIFY_ARE_EQUAL((COORD{ 8, 0 }), endMatches.at(0).second);
+
+        Log::Comment(L"FindNext should find the same matches.");
+        COORD coordStartExpected = { 7, 0 };
+        Search next(gci.renderData, L"[d-e]+", Search::Direction::Forward, Search::Sensitivity::CaseSensitive, Search::Syntax::RegularExpression);
+        VERIFY_IS_FALSE(next.FindNext());
+        Search nextInsensitive(gci.renderData, L"[d-e]+", Search::Direction::Forward, Search::Sensitivity::CaseInsensitive, Search::Syntax::RegularExpression);
+        DoFoundChecks(nextInsensitive, coordStartExpected, 1);
+
+        Log::Comment(L"Invalid patterns should be rejected.");
+        VERIFY_THROWS(Search(gci.renderData, L"(AB", Search::Direction::Forward, Search::Sensitivity::CaseSensitive, Search::Syntax::RegularExpression), wil::ResultException);
+    }
 };
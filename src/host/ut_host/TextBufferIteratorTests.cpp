@@ -266,6 +266,8 @@ class TextBufferIteratorTests
 
     TEST_METHOD(ConstructedNoLimit);
     TEST_METHOD(ConstructedLimits);
+
+    TEST_METHOD(AttrRunLength);
 };
 
 template<typename T>
@@ -587,3 +589,36 @@ void TextBufferIteratorTests::ConstructedLimits()
                            wil::ResultException,
                            [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
 }
+
+void TextBufferIteratorTests::AttrRunLength()
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    auto& textBuffer = gci.GetActiveOutputBuffer().GetTextBuffer();
+    const auto width = textBuffer.GetSize().Width();
+
+    // Row 1 is |default ... |red 10-19|default ...|
+    auto& attrRow = textBuffer.GetRowByOffset(1).GetAttrRow();
+    attrRow.Replace(10, 20, TextAttribute{ FOREGROUND_RED });
+
+    TextBufferCellIterator it(textBuffer, { 0, 1 });
+    VERIFY_ARE_EQUAL(10u, it.AttrRunLength());
+
+    it += 12;
+    VERIFY_ARE_EQUAL(8u, it.AttrRunLength());
+
+    it += 8;
+    VERIFY_ARE_EQUAL(gsl::narrow_cast<size_t>(width - 20), it.AttrRunLength());
+
+    Log::Comment(L"The run is cut short by the limits of the iterator.");
+    const auto limits = Microsoft::Console::Types::Viewport::FromInclusive({ 0, 1, 15, 2 });
+    TextBufferCellIterator limited(textBuffer, { 12, 1 }, limits);
+    VERIFY_ARE_EQUAL(4u, limited.AttrRunLength());
+
+    limited += 4;
+    VERIFY_ARE_EQUAL(COORD{ 0, 2 }, limited.Pos());
+    VERIFY_ARE_EQUAL(16u, limited.AttrRunLength());
+
+    limited += 32;
+    VERIFY_IS_FALSE(limited);
+    VERIFY_ARE_EQUAL(0u, limited.AttrRunLength());
+}
@@ -10,6 +10,7 @@
 #include "globals.h"
 #include "../buffer/out/textBuffer.hpp"
 #include "../buffer/out/CharRow.hpp"
+#include "../buffer/out/SpareBlockResource.hpp"
 
 #include "input.h"
 #include "_stream.h"
@@ -107,6 +108,10 @@ class TextBufferTests
 
     TEST_METHOD(TestIncrementCircularBuffer);
 
+    TEST_METHOD(TestRowGenerations);
+    TEST_METHOD(TestRowGenerationsOfNewBuffers);
+    TEST_METHOD(TestExportChangedRows);
+
     TEST_METHOD(TestMixedRgbAndLegacyForeground);
     TEST_METHOD(TestMixedRgbAndLegacyBackground);
     TEST_METHOD(TestMixedRgbAndLegacyUnderline);
@@ -138,24 +143,39 @@ class TextBufferTests
 
     TEST_METHOD(ResizeTraditional);
 
+    TEST_METHOD(RecreatedBufferReusesCellStorage);
+    TEST_METHOD(MoveAndFillCellsWithinRow);
+    TEST_METHOD(CopyCellsBetweenRows);
     TEST_METHOD(ResizeTraditionalRotationPreservesHighUnicode);
     TEST_METHOD(ScrollBufferRotationPreservesHighUnicode);
+    TEST_METHOD(ScrollRowsWithoutRotatingStorage);
+    TEST_METHOD(AdvanceCircularBufferAndClearRows);
+    TEST_METHOD(RowsAreCreatedWhenWrittenTo);
+    TEST_METHOD(ClearingRowsDoesNotCreateThem);
+    TEST_METHOD(FillAcrossRows);
 
     TEST_METHOD(ResizeTraditionalHighUnicodeRowRemoval);
     TEST_METHOD(ResizeTraditionalHighUnicodeColumnRemoval);
+    TEST_METHOD(WriteRunsOverHighUnicode);
 
     TEST_METHOD(TestBurrito);
 
     void WriteLinesToBuffer(const std::vector<std::wstring>& text, TextBuffer& buffer);
     TEST_METHOD(GetWordBoundaries);
+    TEST_METHOD(GetWordBoundariesAfterRowChanges);
     TEST_METHOD(MoveByWord);
     TEST_METHOD(GetGlyphBoundaries);
 
     TEST_METHOD(GetTextRects);
+    TEST_METHOD(GetTextRectsWithCache);
     TEST_METHOD(GetText);
+    TEST_METHOD(SerializeRows);
+    TEST_METHOD(LineRenditionsAreCounted);
+    TEST_METHOD(GetMemoryUsage);
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
+    TEST_METHOD(HyperlinkTrimAfterOverwrite);
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -634,6 +654,95 @@ void TextBufferTests::TestIncrementCircularBuffer()
     }
 }
 
+void TextBufferTests::TestRowGenerations()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const auto height = gsl::narrow_cast<size_t>(textBuffer.GetSize().Height());
+
+    std::vector<uint64_t> before(height);
+    textBuffer.SnapshotRowGenerations(0, before);
+
+    Log::Comment(L"Only the row we write to should get a new generation.");
+    textBuffer.WriteLine(OutputCellIterator{ L"ABC" }, { 0, 1 });
+
+    std::vector<uint64_t> after(height);
+    textBuffer.SnapshotRowGenerations(0, after);
+    VERIFY_ARE_EQUAL(before[0], after[0]);
+    VERIFY_ARE_NOT_EQUAL(before[1], after[1]);
+    VERIFY_ARE_EQUAL(before[2], after[2]);
+    VERIFY_ARE_EQUAL(after[1], textBuffer.GetRowGeneration(1));
+
+    Log::Comment(L"Reading the buffer shouldn't change any generation.");
+    const auto& constBuffer = textBuffer;
+    VERIFY_IS_TRUE(constBuffer.GetRowByOffset(1).GetCharRow().ContainsText());
+    VERIFY_ARE_EQUAL(after[1], textBuffer.GetRowGeneration(1));
+
+    Log::Comment(L"Rotating the buffer moves the rows along with their generations,");
+    Log::Comment(L"and the recycled row at the bottom gets a brand new generation.");
+    textBuffer.IncrementCircularBuffer();
+
+    std::vector<uint64_t> rotated(height);
+    textBuffer.SnapshotRowGenerations(0, rotated);
+    VERIFY_ARE_EQUAL(after[1], rotated[0]);
+    VERIFY_ARE_EQUAL(after[2], rotated[1]);
+    VERIFY_IS_TRUE(std::find(after.begin(), after.end(), rotated[height - 1]) == after.end());
+}
+
+void TextBufferTests::TestRowGenerationsOfNewBuffers()
+{
+    const COORD bufferSize{ 10, 3 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    const TextBuffer first{ bufferSize, attr, cursorSize, _renderTarget };
+    const TextBuffer second{ bufferSize, attr, cursorSize, _renderTarget };
+
+    Log::Comment(L"Rows that haven't been created yet don't share a generation across buffers.");
+    for (size_t y = 0; y < 3; ++y)
+    {
+        VERIFY_ARE_NOT_EQUAL(first.GetRowGeneration(y), second.GetRowGeneration(y));
+    }
+
+    Log::Comment(L"Not even with a buffer that has the same size and attributes.");
+    TextBuffer third{ bufferSize, attr, cursorSize, _renderTarget };
+    third.WriteLine(OutputCellIterator{ L"ABC" }, { 0, 1 });
+    VERIFY_ARE_NOT_EQUAL(first.GetRowGeneration(0), third.GetRowGeneration(0));
+    VERIFY_ARE_NOT_EQUAL(first.GetRowGeneration(2), third.GetRowGeneration(2));
+}
+
+void TextBufferTests::TestExportChangedRows()
+{
+    TextBuffer& textBuffer = GetTbi();
+    const auto height = gsl::narrow_cast<size_t>(textBuffer.GetSize().Height());
+    const auto width = gsl::narrow_cast<size_t>(textBuffer.GetSize().Width());
+    const auto rowBytes = sizeof(TextBuffer::ExportedRowHeader) + width * sizeof(CHAR_INFO);
+
+    Log::Comment(L"An unknown snapshot exports every row.");
+    std::vector<uint64_t> generations(height, TextBuffer::UnknownRowGeneration);
+    std::vector<std::byte> frame;
+    textBuffer.ExportChangedRows(0, generations, frame);
+    VERIFY_ARE_EQUAL(height * rowBytes, frame.size());
+
+    Log::Comment(L"Without any changes, nothing is exported.");
+    frame.clear();
+    textBuffer.ExportChangedRows(0, generations, frame);
+    VERIFY_ARE_EQUAL(0u, frame.size());
+
+    Log::Comment(L"Only the row that was written to is exported, along with its contents.");
+    textBuffer.WriteLine(OutputCellIterator{ L"ABC" }, { 0, 2 });
+    textBuffer.ExportChangedRows(0, generations, frame);
+    VERIFY_ARE_EQUAL(rowBytes, frame.size());
+
+    TextBuffer::ExportedRowHeader header{};
+    memcpy(&header, frame.data(), sizeof(header));
+    VERIFY_ARE_EQUAL(2, header.row);
+    VERIFY_ARE_EQUAL(width, static_cast<size_t>(header.width));
+
+    std::vector<CHAR_INFO> expected(width);
+    textBuffer.ReadCharInfos({ 0, 2 }, expected);
+    VERIFY_ARE_EQUAL(0, memcmp(frame.data() + sizeof(header), expected.data(), width * sizeof(CHAR_INFO)));
+    VERIFY_ARE_EQUAL(L'A', expected[0].Char.UnicodeChar);
+}
+
 void TextBufferTests::TestMixedRgbAndLegacyForeground()
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -1828,6 +1937,122 @@ void TextBufferTests::ResizeTraditional()
     }
 }
 
+// This tests that a buffer that's created after another one of the same size was
+// deleted reuses its cells through a SpareBlockResource, and that they start out blank.
+void TextBufferTests::RecreatedBufferReusesCellStorage()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    SpareBlockResource resource;
+
+    const CharRowCell* firstCells = nullptr;
+    const ROW* firstRows = nullptr;
+    {
+        TextBuffer first{ bufferSize, attr, cursorSize, _renderTarget, &resource };
+        first.GetRowByOffset(1).GetCharRow().GlyphAt(2) = L"A";
+        firstCells = first._charBuffer.data();
+        firstRows = first._storage.data();
+    }
+
+    TextBuffer second{ bufferSize, attr, cursorSize, _renderTarget, &resource };
+    VERIFY_ARE_EQUAL(firstCells, second._charBuffer.data());
+    VERIFY_ARE_EQUAL(firstRows, second._storage.data());
+
+    const auto text = *second.GetTextDataAt({ 2, 1 });
+    VERIFY_ARE_EQUAL(String(L" "), String(text.data(), gsl::narrow<int>(text.size())));
+
+    Log::Comment(L"A buffer of a different size gets fresh cells.");
+    const CharRowCell* secondCells = second._charBuffer.data();
+    VERIFY_NT_SUCCESS(second.ResizeTraditional({ 40, 10 }));
+    TextBuffer third{ { 40, 30 }, attr, cursorSize, _renderTarget, &resource };
+    VERIFY_ARE_NOT_EQUAL(secondCells, third._charBuffer.data());
+}
+
+void TextBufferTests::MoveAndFillCellsWithinRow()
+{
+    const COORD bufferSize{ 10, 2 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    const TextAttribute red{ FOREGROUND_RED };
+    const TextAttribute blue{ FOREGROUND_BLUE };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+    auto& row = buffer.GetRowByOffset(0);
+
+    buffer.WriteAsciiRun(L"abcde", { 0, 0 }, red);
+    buffer.WriteAsciiRun(L"fghij", { 5, 0 }, blue);
+
+    Log::Comment(L"Deleting two characters at column 2 shifts the rest of the line left.");
+    buffer.MoveCells({ 4, 0 }, 6, 2);
+    buffer.FillCells({ 8, 0 }, 2, attr);
+    VERIFY_ARE_EQUAL(String(L"abefghij  "), String(row.GetText().c_str()));
+    VERIFY_ARE_EQUAL(red, row.GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(blue, row.GetAttrRow().GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(blue, row.GetAttrRow().GetAttrByColumn(7));
+    VERIFY_ARE_EQUAL(attr, row.GetAttrRow().GetAttrByColumn(8));
+
+    Log::Comment(L"Inserting three characters at column 1 pushes text off the end of the line.");
+    buffer.MoveCells({ 1, 0 }, 7, 4);
+    buffer.FillCells({ 1, 0 }, 3, attr);
+    VERIFY_ARE_EQUAL(String(L"a   befghi"), String(row.GetText().c_str()));
+    VERIFY_ARE_EQUAL(red, row.GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(attr, row.GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(red, row.GetAttrRow().GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(blue, row.GetAttrRow().GetAttrByColumn(6));
+
+    Log::Comment(L"Glyphs in the unicode storage move along with their cells.");
+    row.GetCharRow().GlyphAt(9) = L"\xD83C\xDD71";
+    buffer.MoveCells({ 9, 0 }, 1, 0);
+    const auto moved = *buffer.GetTextDataAt({ 0, 0 });
+    VERIFY_ARE_EQUAL(String(L"\xD83C\xDD71"), String(moved.data(), gsl::narrow<int>(moved.size())));
+
+    Log::Comment(L"Filling half of a wide glyph clears its other half, too.");
+    row.GetCharRow().GlyphAt(5) = L"\x3042";
+    row.GetCharRow().DbcsAttrAt(5).SetLeading();
+    row.GetCharRow().GlyphAt(6) = L"\x3042";
+    row.GetCharRow().DbcsAttrAt(6).SetTrailing();
+    buffer.FillCells({ 6, 0 }, 1, attr);
+    VERIFY_IS_TRUE(row.GetCharRow().DbcsAttrAt(5).IsSingle());
+    const auto cleared = *buffer.GetTextDataAt({ 5, 0 });
+    VERIFY_ARE_EQUAL(String(L" "), String(cleared.data(), gsl::narrow<int>(cleared.size())));
+}
+
+void TextBufferTests::CopyCellsBetweenRows()
+{
+    const COORD bufferSize{ 10, 3 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    const TextAttribute red{ FOREGROUND_RED };
+    const TextAttribute blue{ FOREGROUND_BLUE };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    buffer.WriteAsciiRun(L"abcde", { 0, 0 }, red);
+    buffer.WriteAsciiRun(L"fghij", { 5, 0 }, blue);
+    buffer.WriteAsciiRun(L"0123456789", { 0, 1 }, attr);
+
+    Log::Comment(L"Copying part of a row to another row only replaces the target columns.");
+    buffer.CopyCells({ 3, 0 }, 4, { 2, 1 });
+    const auto& target = buffer.GetRowByOffset(1);
+    VERIFY_ARE_EQUAL(String(L"01defg6789"), String(target.GetText().c_str()));
+    VERIFY_ARE_EQUAL(attr, target.GetAttrRow().GetAttrByColumn(1));
+    VERIFY_ARE_EQUAL(red, target.GetAttrRow().GetAttrByColumn(3));
+    VERIFY_ARE_EQUAL(blue, target.GetAttrRow().GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(blue, target.GetAttrRow().GetAttrByColumn(5));
+    VERIFY_ARE_EQUAL(attr, target.GetAttrRow().GetAttrByColumn(6));
+
+    Log::Comment(L"The source row is left alone.");
+    VERIFY_ARE_EQUAL(String(L"abcdefghij"), String(buffer.GetRowByOffset(0).GetText().c_str()));
+
+    Log::Comment(L"Copies are clipped to the end of the row, and glyphs come along.");
+    buffer.GetRowByOffset(0).GetCharRow().GlyphAt(9) = L"\xD83C\xDD71";
+    buffer.CopyCells({ 8, 0 }, 5, { 0, 2 });
+    VERIFY_ARE_EQUAL(String(L"i"), String(buffer.GetRowByOffset(2).GetText().substr(0, 1).c_str()));
+    const auto copied = *buffer.GetTextDataAt({ 1, 2 });
+    VERIFY_ARE_EQUAL(String(L"\xD83C\xDD71"), String(copied.data(), gsl::narrow<int>(copied.size())));
+    VERIFY_ARE_EQUAL(blue, buffer.GetRowByOffset(2).GetAttrRow().GetAttrByColumn(1));
+    VERIFY_ARE_EQUAL(attr, buffer.GetRowByOffset(2).GetAttrRow().GetAttrByColumn(2));
+}
+
 // This tests that when buffer storage rows are rotated around during a resize traditional operation,
 // that the Unicode Storage-held high unicode items like emoji rotate properly with it.
 void TextBufferTests::ResizeTraditionalRotationPreservesHighUnicode()
@@ -1840,7 +2065,7 @@ void TextBufferTests::ResizeTraditionalRotationPreservesHighUnicode()
 
     // Get a position inside the buffer
     const COORD pos{ 2, 1 };
-    auto position = _buffer->_storage[pos.Y].GetCharRow().GlyphAt(pos.X);
+    auto position = _buffer->GetRowByOffset(pos.Y).GetCharRow().GlyphAt(pos.X);
 
     // Fill it up with a sequence that will have to hit the high unicode storage.
     // This is the negative squared latin capital letter B emoji: 🅱
@@ -1882,7 +2107,7 @@ void TextBufferTests::ScrollBufferRotationPreservesHighUnicode()
 
     // Get a position inside the buffer
     const COORD pos{ 2, 1 };
-    auto position = _buffer->_storage[pos.Y].GetCharRow().GlyphAt(pos.X);
+    auto position = _buffer->GetRowByOffset(pos.Y).GetCharRow().GlyphAt(pos.X);
 
     // Fill it up with a sequence that will have to hit the high unicode storage.
     // This is the fire emoji: 🔥
@@ -1910,6 +2135,214 @@ void TextBufferTests::ScrollBufferRotationPreservesHighUnicode()
     VERIFY_ARE_EQUAL(String(fire), String(shouldBeFireText.data(), gsl::narrow<int>(shouldBeFireText.size())));
 }
 
+void TextBufferTests::ScrollRowsWithoutRotatingStorage()
+{
+    const COORD bufferSize{ 10, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    for (SHORT row = 0; row < bufferSize.Y; ++row)
+    {
+        buffer.WriteAsciiRun(std::wstring(1, gsl::narrow_cast<wchar_t>(L'0' + row)), { 0, row }, attr);
+    }
+
+    // Move the start of the circular buffer away from the front of the storage.
+    for (auto i = 0; i < 3; ++i)
+    {
+        VERIFY_IS_TRUE(buffer.IncrementCircularBuffer());
+    }
+    buffer.WriteAsciiRun(L"a", { 0, 7 }, attr);
+    buffer.WriteAsciiRun(L"b", { 0, 8 }, attr);
+    buffer.WriteAsciiRun(L"c", { 0, 9 }, attr);
+    // The buffer now reads 3456789abc, with row 0 stored at index 3.
+    VERIFY_ARE_EQUAL(3, buffer.GetFirstRowIndex());
+
+    const auto readColumn = [&]() {
+        std::wstring text;
+        for (SHORT row = 0; row < bufferSize.Y; ++row)
+        {
+            text += *buffer.GetTextDataAt({ 0, row });
+        }
+        return text;
+    };
+
+    Log::Comment(L"Scrolling a region that doesn't wrap around the storage rotates it in place.");
+    buffer.ScrollRows(3, 3, -1);
+    VERIFY_ARE_EQUAL(String(L"3467859abc"), String(readColumn().c_str()));
+    VERIFY_ARE_EQUAL(3, buffer.GetFirstRowIndex());
+
+    Log::Comment(L"Scrolling one that does has to straighten out the circular buffer first.");
+    buffer.ScrollRows(5, 4, 1);
+    VERIFY_ARE_EQUAL(String(L"34678c59ab"), String(readColumn().c_str()));
+    VERIFY_ARE_EQUAL(0, buffer.GetFirstRowIndex());
+
+    Log::Comment(L"Either way, every row knows where it's stored.");
+    for (size_t i = 0; i < buffer._storage.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(gsl::narrow<SHORT>(i), buffer._storage[i].GetId());
+    }
+}
+
+void TextBufferTests::AdvanceCircularBufferAndClearRows()
+{
+    const COORD bufferSize{ 10, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    const auto fillRows = [&]() {
+        for (SHORT row = 0; row < bufferSize.Y; ++row)
+        {
+            buffer.WriteAsciiRun(std::wstring(bufferSize.X, gsl::narrow_cast<wchar_t>(L'0' + row)), { 0, row }, attr);
+        }
+    };
+    const auto readColumn = [&]() {
+        std::wstring text;
+        for (SHORT row = 0; row < bufferSize.Y; ++row)
+        {
+            text += *buffer.GetTextDataAt({ 0, row });
+        }
+        return text;
+    };
+
+    Log::Comment(L"Advancing by more than the buffer's height clears all of it, and ends up where count increments would.");
+    fillRows();
+    VERIFY_IS_TRUE(buffer.AdvanceCircularBuffer(13));
+    VERIFY_ARE_EQUAL(3, buffer.GetFirstRowIndex());
+    VERIFY_ARE_EQUAL(String(L"          "), String(readColumn().c_str()));
+
+    Log::Comment(L"Clearing rows resets their text and attributes, but keeps their line rendition.");
+    fillRows();
+    buffer.GetRowByOffset(2).SetLineRendition(LineRendition::DoubleWidth);
+    const TextAttribute clearAttr{ 0x1e };
+    buffer.ClearRows(1, 3, clearAttr);
+    VERIFY_ARE_EQUAL(String(L"0   456789"), String(readColumn().c_str()));
+    for (SHORT row = 1; row < 4; ++row)
+    {
+        const auto& attrRow = buffer.GetRowByOffset(row).GetAttrRow();
+        VERIFY_ARE_EQUAL(clearAttr, attrRow.GetAttrByColumn(0));
+        VERIFY_ARE_EQUAL(clearAttr, attrRow.GetAttrByColumn(bufferSize.X - 1));
+    }
+    VERIFY_ARE_EQUAL(attr, buffer.GetRowByOffset(4).GetAttrRow().GetAttrByColumn(0));
+    VERIFY_IS_TRUE(buffer.IsDoubleWidthLine(2));
+
+    Log::Comment(L"Rows past the end of the buffer are ignored.");
+    buffer.ClearRows(8, 5, clearAttr);
+    VERIFY_ARE_EQUAL(String(L"0   4567  "), String(readColumn().c_str()));
+}
+
+void TextBufferTests::RowsAreCreatedWhenWrittenTo()
+{
+    const COORD bufferSize{ 10, 100 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    Log::Comment(L"A new buffer has room for all of its rows, but none of them exist yet.");
+    VERIFY_ARE_EQUAL(0u, buffer._storage.size());
+    VERIFY_ARE_EQUAL(100u, buffer.TotalRowCount());
+    VERIFY_ARE_EQUAL(String(L" "), String(std::wstring{ *buffer.GetTextDataAt({ 0, 50 }) }.c_str()));
+    VERIFY_ARE_EQUAL(attr, std::as_const(buffer).GetRowByOffset(50).GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(0u, buffer._storage.size());
+
+    Log::Comment(L"Writing to a row creates it and every row before it.");
+    const auto cells = buffer._storage.data();
+    buffer.WriteAsciiRun(L"0123456789", { 0, 1 }, attr);
+    buffer.WriteAsciiRun(L"abc", { 0, 5 }, attr);
+    VERIFY_ARE_EQUAL(6u, buffer._storage.size());
+    VERIFY_ARE_EQUAL(cells, buffer._storage.data());
+    VERIFY_ARE_EQUAL(String(L"a"), String(std::wstring{ *buffer.GetTextDataAt({ 0, 5 }) }.c_str()));
+
+    Log::Comment(L"Releasing rows drops them again, and they're filled with the given attributes.");
+    const TextAttribute releaseAttr{ 0x1e };
+    buffer.ReleaseRows(3, releaseAttr);
+    VERIFY_ARE_EQUAL(3u, buffer._storage.size());
+    VERIFY_ARE_EQUAL(String(L"5"), String(std::wstring{ *buffer.GetTextDataAt({ 5, 1 }) }.c_str()));
+    VERIFY_ARE_EQUAL(String(L" "), String(std::wstring{ *buffer.GetTextDataAt({ 0, 5 }) }.c_str()));
+    VERIFY_ARE_EQUAL(releaseAttr, std::as_const(buffer).GetRowByOffset(5).GetAttrRow().GetAttrByColumn(0));
+
+    Log::Comment(L"Rows created afterwards start out the same way.");
+    buffer.WriteAsciiRun(L"x", { 0, 7 }, attr);
+    VERIFY_ARE_EQUAL(releaseAttr, buffer.GetRowByOffset(6).GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(releaseAttr, buffer.GetRowByOffset(7).GetAttrRow().GetAttrByColumn(1));
+}
+
+void TextBufferTests::ClearingRowsDoesNotCreateThem()
+{
+    const COORD bufferSize{ 10, 100 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    const TextAttribute otherAttr{ 0x1e };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+    buffer.WriteAsciiRun(L"abc", { 0, 2 }, attr);
+    VERIFY_ARE_EQUAL(3u, buffer._storage.size());
+
+    Log::Comment(L"Filling rows that don't exist yet with blanks leaves them that way.");
+    VERIFY_ARE_EQUAL(1000u, buffer.Fill({ 0, 0 }, 1000, UNICODE_SPACE, attr));
+    VERIFY_ARE_EQUAL(3u, buffer._storage.size());
+    VERIFY_ARE_EQUAL(String(L" "), String(std::wstring{ *buffer.GetTextDataAt({ 0, 2 }) }.c_str()));
+    buffer.ClearRows(1, 50, attr);
+    VERIFY_ARE_EQUAL(3u, buffer._storage.size());
+
+    Log::Comment(L"Filling them with anything else creates them.");
+    buffer.Fill({ 0, 10 }, 5, L'x', attr);
+    VERIFY_ARE_EQUAL(11u, buffer._storage.size());
+
+    Log::Comment(L"Clearing all the rows to the bottom in another attribute only changes what they look like.");
+    buffer.ClearRows(5, 95, otherAttr);
+    VERIFY_ARE_EQUAL(11u, buffer._storage.size());
+    VERIFY_ARE_EQUAL(String(L" "), String(std::wstring{ *buffer.GetTextDataAt({ 0, 10 }) }.c_str()));
+    VERIFY_ARE_EQUAL(otherAttr, std::as_const(buffer).GetRowByOffset(10).GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(otherAttr, std::as_const(buffer).GetRowByOffset(50).GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(attr, std::as_const(buffer).GetRowByOffset(4).GetAttrRow().GetAttrByColumn(0));
+}
+
+void TextBufferTests::FillAcrossRows()
+{
+    const COORD bufferSize{ 10, 4 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    const auto readRow = [&](const SHORT row) {
+        std::wstring text;
+        for (SHORT col = 0; col < bufferSize.X; ++col)
+        {
+            text += *buffer.GetTextDataAt({ col, row });
+        }
+        return text;
+    };
+
+    for (SHORT row = 0; row < bufferSize.Y; ++row)
+    {
+        buffer.WriteAsciiRun(L"abcdefghij", { 0, row }, attr, true);
+    }
+
+    Log::Comment(L"A fill of text and attributes continues onto the next rows.");
+    const TextAttribute fillAttr{ 0x1e };
+    VERIFY_ARE_EQUAL(14u, buffer.Fill({ 8, 0 }, 14, L'x', fillAttr));
+    VERIFY_ARE_EQUAL(String(L"abcdefghxx"), String(readRow(0).c_str()));
+    VERIFY_ARE_EQUAL(String(L"xxxxxxxxxx"), String(readRow(1).c_str()));
+    VERIFY_ARE_EQUAL(String(L"xxcdefghij"), String(readRow(2).c_str()));
+    VERIFY_ARE_EQUAL(attr, buffer.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(7));
+    VERIFY_ARE_EQUAL(fillAttr, buffer.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(8));
+    VERIFY_ARE_EQUAL(fillAttr, buffer.GetRowByOffset(2).GetAttrRow().GetAttrByColumn(1));
+    VERIFY_ARE_EQUAL(attr, buffer.GetRowByOffset(2).GetAttrRow().GetAttrByColumn(2));
+
+    Log::Comment(L"Rows filled up to the last column are no longer wrapped.");
+    VERIFY_IS_FALSE(buffer.GetRowByOffset(0).WasWrapForced());
+    VERIFY_IS_FALSE(buffer.GetRowByOffset(1).WasWrapForced());
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(2).WasWrapForced());
+
+    Log::Comment(L"An attribute fill keeps the text, and stops at the end of the buffer.");
+    VERIFY_ARE_EQUAL(5u, buffer.Fill({ 5, 3 }, 100, std::nullopt, fillAttr));
+    VERIFY_ARE_EQUAL(String(L"abcdefghij"), String(readRow(3).c_str()));
+    VERIFY_ARE_EQUAL(attr, buffer.GetRowByOffset(3).GetAttrRow().GetAttrByColumn(4));
+    VERIFY_ARE_EQUAL(fillAttr, buffer.GetRowByOffset(3).GetAttrRow().GetAttrByColumn(9));
+    VERIFY_IS_TRUE(buffer.GetRowByOffset(3).WasWrapForced());
+}
+
 // This tests that rows removed from the buffer while resizing traditionally will also drop the high unicode
 // characters from the Unicode Storage buffer
 void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
@@ -1922,7 +2355,7 @@ void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
 
     // Get a position inside the buffer in the bottom row
     const COORD pos{ 0, bufferSize.Y - 1 };
-    auto position = _buffer->_storage[pos.Y].GetCharRow().GlyphAt(pos.X);
+    auto position = _buffer->GetRowByOffset(pos.Y).GetCharRow().GlyphAt(pos.X);
 
     // Fill it up with a sequence that will have to hit the high unicode storage.
     // This is the eggplant emoji: 🍆
@@ -1935,14 +2368,17 @@ void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->GetRowByOffset(pos.Y).GetUnicodeStorage()._glyphs.size(), L"There should be one item in the row's storage.");
 
     // Perform resize to trim off the row of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X, bufferSize.Y - 1 };
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    for (const auto& row : _buffer->_storage)
+    {
+        VERIFY_IS_TRUE(row.GetUnicodeStorage()._glyphs.empty(), L"No row should have any items in its storage now.");
+    }
 }
 
 // This tests that columns removed from the buffer while resizing traditionally will also drop the high unicode
@@ -1957,7 +2393,7 @@ void TextBufferTests::ResizeTraditionalHighUnicodeColumnRemoval()
 
     // Get a position inside the buffer in the last column
     const COORD pos{ bufferSize.X - 1, 0 };
-    auto position = _buffer->_storage[pos.Y].GetCharRow().GlyphAt(pos.X);
+    auto position = _buffer->GetRowByOffset(pos.Y).GetCharRow().GlyphAt(pos.X);
 
     // Fill it up with a sequence that will have to hit the high unicode storage.
     // This is the peach emoji: 🍑
@@ -1970,14 +2406,50 @@ void TextBufferTests::ResizeTraditionalHighUnicodeColumnRemoval()
     const auto readBackText = *readBack;
     VERIFY_ARE_EQUAL(String(emoji), String(readBackText.data(), gsl::narrow<int>(readBackText.size())));
 
-    VERIFY_ARE_EQUAL(1u, _buffer->GetUnicodeStorage()._map.size(), L"There should be one item in the map.");
+    VERIFY_ARE_EQUAL(1u, _buffer->GetRowByOffset(pos.Y).GetUnicodeStorage()._glyphs.size(), L"There should be one item in the row's storage.");
 
     // Perform resize to trim off the column of the buffer that included the emoji
     COORD trimmedBufferSize{ bufferSize.X - 1, bufferSize.Y };
 
     VERIFY_NT_SUCCESS(_buffer->ResizeTraditional(trimmedBufferSize));
 
-    VERIFY_IS_TRUE(_buffer->GetUnicodeStorage()._map.empty(), L"The map should now be empty.");
+    VERIFY_IS_TRUE(_buffer->GetRowByOffset(pos.Y).GetUnicodeStorage()._glyphs.empty(), L"The row's storage should now be empty.");
+}
+
+void TextBufferTests::WriteRunsOverHighUnicode()
+{
+    const COORD bufferSize{ 10, 2 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+    const auto& storage0 = buffer.GetRowByOffset(0).GetUnicodeStorage();
+    const auto& storage1 = buffer.GetRowByOffset(1).GetUnicodeStorage();
+
+    // This is the burrito emoji: 🌯
+    // It's a wide glyph, and it's kept in the row's storage.
+    const auto burrito = L"\xD83C\xDF2F";
+    buffer.WriteLine(OutputCellIterator{ burrito }, { 2, 0 });
+    buffer.WriteLine(OutputCellIterator{ burrito }, { 2, 1 });
+    VERIFY_IS_TRUE(buffer.GetCellDataAt({ 2, 0 })->DbcsAttr().IsLeading());
+    VERIFY_ARE_EQUAL(1u, storage0._glyphs.size());
+    VERIFY_ARE_EQUAL(1u, storage1._glyphs.size());
+
+    Log::Comment(L"ASCII written over the trailing half erases the glyph and clears its leading half.");
+    buffer.WriteAsciiRun(L"x", { 3, 0 }, attr);
+    VERIFY_IS_TRUE(storage0._glyphs.empty());
+    VERIFY_ARE_EQUAL(L" ", std::wstring{ buffer.GetCellDataAt({ 2, 0 })->Chars() });
+    VERIFY_IS_TRUE(buffer.GetCellDataAt({ 2, 0 })->DbcsAttr().IsSingle());
+    VERIFY_ARE_EQUAL(L"x", std::wstring{ buffer.GetCellDataAt({ 3, 0 })->Chars() });
+
+    Log::Comment(L"CHAR_INFOs written over the leading half erase the glyph and clear its trailing half.");
+    CHAR_INFO charInfo{};
+    charInfo.Char.UnicodeChar = L'y';
+    charInfo.Attributes = 0x7f;
+    buffer.WriteCharInfos({ &charInfo, 1 }, { 2, 1 });
+    VERIFY_IS_TRUE(storage1._glyphs.empty());
+    VERIFY_ARE_EQUAL(L"y", std::wstring{ buffer.GetCellDataAt({ 2, 1 })->Chars() });
+    VERIFY_ARE_EQUAL(L" ", std::wstring{ buffer.GetCellDataAt({ 3, 1 })->Chars() });
+    VERIFY_IS_TRUE(buffer.GetCellDataAt({ 3, 1 })->DbcsAttr().IsSingle());
 }
 
 void TextBufferTests::TestBurrito()
@@ -2133,6 +2605,30 @@ void TextBufferTests::GetWordBoundaries()
     }
 }
 
+void TextBufferTests::GetWordBoundariesAfterRowChanges()
+{
+    COORD bufferSize{ 80, 9001 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // The delimiter classes of a row are cached between calls. Make sure we
+    // notice when the row is rewritten, or when the delimiters change.
+    WriteLinesToBuffer({ L"word other" }, *_buffer);
+    VERIFY_ARE_EQUAL(COORD({ 5, 0 }), _buffer->GetWordStart({ 7, 0 }, L" ", false));
+
+    WriteLinesToBuffer({ L"wordXother" }, *_buffer);
+    VERIFY_ARE_EQUAL(COORD({ 0, 0 }), _buffer->GetWordStart({ 7, 0 }, L" ", false));
+    VERIFY_ARE_EQUAL(COORD({ 5, 0 }), _buffer->GetWordStart({ 7, 0 }, L"X", false));
+
+    // Scrolling the buffer moves other rows into the same offsets.
+    WriteLinesToBuffer({ L"word other", L"a b" }, *_buffer);
+    VERIFY_ARE_EQUAL(COORD({ 5, 0 }), _buffer->GetWordStart({ 7, 0 }, L" ", false));
+    _buffer->IncrementCircularBuffer();
+    VERIFY_ARE_EQUAL(COORD({ 2, 0 }), _buffer->GetWordStart({ 2, 0 }, L" ", false));
+    VERIFY_ARE_EQUAL(COORD({ 3, 0 }), _buffer->GetWordStart({ 7, 0 }, L" ", false));
+}
+
 void TextBufferTests::MoveByWord()
 {
     COORD bufferSize{ 80, 9001 };
@@ -2332,6 +2828,50 @@ void TextBufferTests::GetTextRects()
     }
 }
 
+void TextBufferTests::GetTextRectsWithCache()
+{
+    const auto burrito = std::wstring(L"\xD83C\xDF2F");
+
+    COORD bufferSize{ 20, 50 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    const std::vector<std::wstring> text = { L"0123456789",
+                                             L" " + burrito + L"3456" + burrito,
+                                             L"  " + burrito + L"45" + burrito,
+                                             burrito + L"234567" + burrito,
+                                             L"0123456789" };
+    WriteLinesToBuffer(text, *_buffer);
+
+    TextBuffer::TextRectsCache cache;
+    const auto verifyAgainstUncached = [&](const COORD start, const COORD end) {
+        const auto expected = _buffer->GetTextRects(start, end, true, false);
+        const auto result = _buffer->GetTextRects(start, end, true, false, &cache);
+        VERIFY_ARE_EQUAL(expected.size(), result.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            VERIFY_ARE_EQUAL(expected.at(i), result.at(i));
+        }
+        return result;
+    };
+
+    Log::Comment(L"Fill the cache, then reuse it for the same selection.");
+    verifyAgainstUncached({ 1, 0 }, { 7, 4 });
+    auto result = verifyAgainstUncached({ 1, 0 }, { 7, 4 });
+    VERIFY_ARE_EQUAL((SMALL_RECT{ 1, 1, 8, 1 }), result.at(1)); // expand right
+
+    Log::Comment(L"Drag the selection around. Rows that were cached at a different range mustn't be reused.");
+    verifyAgainstUncached({ 1, 0 }, { 6, 4 });
+    verifyAgainstUncached({ 0, 1 }, { 7, 3 });
+
+    Log::Comment(L"Overwrite a cached row. The burritos are gone, so it must not expand anymore.");
+    verifyAgainstUncached({ 1, 0 }, { 7, 4 });
+    _buffer->WriteLine(OutputCellIterator{ std::wstring_view{ L"0123456789" } }, { 0, 1 });
+    result = verifyAgainstUncached({ 1, 0 }, { 7, 4 });
+    VERIFY_ARE_EQUAL((SMALL_RECT{ 1, 1, 7, 1 }), result.at(1));
+}
+
 void TextBufferTests::GetText()
 {
     // GetText() is used by...
@@ -2580,8 +3120,111 @@ void TextBufferTests::GetText()
     }
 }
 
+void TextBufferTests::LineRenditionsAreCounted()
+{
+    const COORD bufferSize{ 10, 5 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    Log::Comment(L"A new buffer is all single width.");
+    VERIFY_IS_FALSE(buffer.HasLineRenditions());
+
+    Log::Comment(L"Setting the same line rendition twice counts the row once.");
+    buffer.GetCursor().SetPosition({ 0, 1 });
+    buffer.SetCurrentLineRendition(LineRendition::DoubleWidth);
+    buffer.SetCurrentLineRendition(LineRendition::DoubleHeightTop);
+    buffer.GetRowByOffset(3).SetLineRendition(LineRendition::DoubleHeightBottom);
+    VERIFY_ARE_EQUAL(2u, buffer._lineRenditionRowCount);
+
+    buffer.ResetLineRenditionRange(0, 2);
+    VERIFY_ARE_EQUAL(1u, buffer._lineRenditionRowCount);
+
+    Log::Comment(L"Rows scrolled out of the buffer are reset.");
+    for (auto i = 0; i < 4; ++i)
+    {
+        VERIFY_IS_TRUE(buffer.IncrementCircularBuffer());
+    }
+    VERIFY_IS_FALSE(buffer.HasLineRenditions());
+
+    Log::Comment(L"Rows cut off by a resize are no longer counted.");
+    buffer.GetRowByOffset(4).SetLineRendition(LineRendition::DoubleWidth);
+    buffer.GetCursor().SetPosition({ 0, 0 });
+    VERIFY_SUCCEEDED(buffer.ResizeTraditional({ 10, 3 }));
+    VERIFY_IS_FALSE(buffer.HasLineRenditions());
+
+    buffer.GetRowByOffset(0).SetLineRendition(LineRendition::DoubleWidth);
+    buffer.Reset();
+    VERIFY_IS_FALSE(buffer.HasLineRenditions());
+}
+
+void TextBufferTests::GetMemoryUsage()
+{
+    const COORD bufferSize{ 10, 5 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    Log::Comment(L"The cells are allocated up front, but rows with a single attribute run allocate nothing else.");
+    const auto empty = buffer.GetMemoryUsage();
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(empty.cells, size_t{ 10 * 5 } * sizeof(CharRowCell));
+    buffer.WriteAsciiRun(L"abc", { 0, 0 }, attr);
+    VERIFY_ARE_EQUAL(0u, buffer.GetMemoryUsage().attributes);
+    VERIFY_ARE_EQUAL(0u, buffer.GetMemoryUsage().unicodeStorage);
+
+    Log::Comment(L"A second attribute run, a glyph outside of the cells and a hyperlink are counted.");
+    buffer.WriteAsciiRun(L"de", { 3, 0 }, TextAttribute{ 0x1e });
+    buffer.GetRowByOffset(1).GetUnicodeStorage().StoreGlyph(0, { L'\xD83D', L'\xDE00' });
+    const auto id = buffer.GetHyperlinkId(L"https://example.com", L"");
+    buffer.AddHyperlinkToMap(L"https://example.com", id);
+
+    const auto usage = buffer.GetMemoryUsage();
+    VERIFY_IS_GREATER_THAN(usage.attributes, 0u);
+    VERIFY_IS_GREATER_THAN(usage.unicodeStorage, 0u);
+    VERIFY_IS_GREATER_THAN(usage.hyperlinks, empty.hyperlinks);
+    VERIFY_ARE_EQUAL(empty.cells, usage.cells);
+}
+
 // This tests that when we increment the circular buffer, obsolete hyperlink references
 // are removed from the hyperlink map
+void TextBufferTests::SerializeRows()
+{
+    COORD bufferSize{ 10, 5 };
+    UINT cursorSize = 12;
+    TextAttribute attr{};
+    TextBuffer buffer{ bufferSize, attr, cursorSize, _renderTarget };
+
+    TextAttribute red{};
+    // Index 4 is red in the Windows color table, but 1 in the ANSI one.
+    red.SetIndexedForeground(4);
+    red.SetBold(true);
+
+    OutputCellIterator first{ L"abc  " };
+    buffer.Write(first, { 0, 0 }, false);
+    OutputCellIterator second{ L"0123456789" };
+    buffer.Write(second, { 0, 1 }, true);
+    OutputCellIterator third{ L"xyz", red };
+    buffer.Write(third, { 0, 2 }, false);
+
+    Log::Comment(L"Trailing spaces are trimmed, and wrapped rows are joined.");
+    std::wstring plain;
+    buffer.SerializeRows(0, 2, false, plain);
+    const std::wstring expectedPlain{ L"abc\r\n0123456789xyz\r\n" };
+    VERIFY_ARE_EQUAL(expectedPlain, plain);
+
+    Log::Comment(L"Attributes are written as SGR sequences, and reset at the end of the row.");
+    std::wstring attributed;
+    buffer.SerializeRows(2, 2, true, attributed);
+    const std::wstring expectedAttributed{ L"\x1b[0;1;31mxyz\x1b[m\r\n" };
+    VERIFY_ARE_EQUAL(expectedAttributed, attributed);
+
+    Log::Comment(L"Rows past the end of the buffer are ignored.");
+    std::wstring clamped;
+    buffer.SerializeRows(4, 100, false, clamped);
+    const std::wstring expectedClamped{ L"\r\n" };
+    VERIFY_ARE_EQUAL(expectedClamped, clamped);
+}
+
 void TextBufferTests::HyperlinkTrim()
 {
     // Set up a text buffer for us
@@ -2660,3 +3303,43 @@ void TextBufferTests::NoHyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalCustomId], id);
 }
+
+// This tests that a hyperlink reference that was overwritten elsewhere in the buffer
+// doesn't keep the hyperlink alive once its last row is recycled
+void TextBufferTests::HyperlinkTrimAfterOverwrite()
+{
+    // Set up a text buffer for us
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    const auto url = L"test.url";
+
+    // Set the same hyperlink id in two runs of the first row and in another row
+    const auto id = _buffer->GetHyperlinkId(url, L"");
+    TextAttribute newAttr{ 0x7f };
+    newAttr.SetHyperlinkId(id);
+    _buffer->GetRowByOffset(0).GetAttrRow().SetAttrToEnd(10, newAttr);
+    _buffer->GetRowByOffset(0).GetAttrRow().SetAttrToEnd(20, attr);
+    _buffer->GetRowByOffset(0).GetAttrRow().SetAttrToEnd(30, newAttr);
+    _buffer->GetRowByOffset(5).GetAttrRow().SetAttrToEnd(70, newAttr);
+    _buffer->AddHyperlinkToMap(url, id);
+
+    // Scroll a row out while the other row still references the hyperlink
+    _buffer->IncrementCircularBuffer();
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
+
+    // Move the other reference to a different row, and scroll up to it
+    _buffer->GetRowByOffset(4).GetAttrRow().SetAttrToEnd(0, attr);
+    _buffer->GetRowByOffset(3).GetAttrRow().SetAttrToEnd(0, newAttr);
+    for (auto i = 0; i < 3; ++i)
+    {
+        _buffer->IncrementCircularBuffer();
+    }
+    VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
+
+    // Scrolling out the last reference deletes the hyperlink
+    _buffer->IncrementCircularBuffer();
+    VERIFY_ARE_EQUAL(_buffer->_hyperlinkMap.find(id), _buffer->_hyperlinkMap.end());
+}
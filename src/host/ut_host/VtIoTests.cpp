@@ -406,6 +406,11 @@ public:
     {
         return {};
     }
+
+    std::vector<Microsoft::Console::Types::Viewport> GetSearchHighlightRects() noexcept
+    {
+        return {};
+    }
 };
 
 void VtIoTests::RendererDtorAndThread()
@@ -79,8 +79,14 @@ class Microsoft::Console::Render::VtRendererTest
 
     TEST_METHOD(TestWrapping);
 
+    TEST_METHOD(TestShadowFrameDiffing);
+    TEST_METHOD(TestRepeatCharacter);
+    TEST_METHOD(TestSgrTransitionCache);
+
     TEST_METHOD(TestResize);
 
+    TEST_METHOD(TestInheritingCursorDefersPaint);
+
     TEST_METHOD(TestCursorVisibility);
 
     void Test16Colors(VtEngine* engine);
@@ -1427,6 +1433,184 @@ void VtRendererTest::TestWrapping()
     });
 }
 
+void VtRendererTest::TestShadowFrameDiffing()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+    engine->SetShadowFrameDiffing(true);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Make sure the cursor is at 0,0"));
+        qExpectedInput.push_back("\x1b[H");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 0, 0 }));
+    });
+
+    const auto makeClusters = [](const wchar_t* const line) {
+        std::vector<Cluster> clusters;
+        for (size_t i = 0; i < wcslen(line); i++)
+        {
+            clusters.emplace_back(std::wstring_view{ &line[i], 1 }, static_cast<size_t>(1));
+        }
+        return clusters;
+    };
+    const auto original = makeClusters(L"asdfghjkl");
+    const auto changed = makeClusters(L"asdfXhjkl");
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"The first time, the whole line is sent."));
+        qExpectedInput.push_back("asdfghjkl");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ original.data(), original.size() }, { 0, 0 }, false, false));
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Painting the same line again sends nothing."));
+        qExpectedInput.push_back(EMPTY_CALLBACK_SENTINEL);
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ original.data(), original.size() }, { 0, 0 }, false, false));
+        WriteCallback(EMPTY_CALLBACK_SENTINEL, 1);
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Changing a single character only sends that character."));
+        qExpectedInput.push_back("\x1b[1;5H");
+        qExpectedInput.push_back("X");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ changed.data(), changed.size() }, { 0, 0 }, false, false));
+    });
+}
+
+void VtRendererTest::TestRepeatCharacter()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+    engine->SetRepeatCharacter(true);
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Make sure the cursor is at 0,0"));
+        qExpectedInput.push_back("\x1b[H");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 0, 0 }));
+    });
+
+    const auto makeClusters = [](const wchar_t* const line) {
+        std::vector<Cluster> clusters;
+        for (size_t i = 0; i < wcslen(line); i++)
+        {
+            clusters.emplace_back(std::wstring_view{ &line[i], 1 }, static_cast<size_t>(1));
+        }
+        return clusters;
+    };
+    const auto border = makeClusters(L"+==========+==+");
+    const auto shortRun = makeClusters(L"a=======b");
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"A long run of one character is sent with REP."));
+        qExpectedInput.push_back("+=");
+        qExpectedInput.push_back("\x1b[9b");
+        qExpectedInput.push_back("+==+");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ border.data(), border.size() }, { 0, 0 }, false, false));
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"A run that's shorter than the sequence is sent as is."));
+        qExpectedInput.push_back("\r\n");
+        qExpectedInput.push_back("a=======b");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ shortRun.data(), shortRun.size() }, { 0, 1 }, false, false));
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Wrapped rows are sent as is, to preserve their wrapped state."));
+        qExpectedInput.push_back("\r\n");
+        qExpectedInput.push_back("+==========+==+");
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ border.data(), border.size() }, { 0, 2 }, false, true));
+    });
+}
+
+void VtRendererTest::TestSgrTransitionCache()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+    RenderData renderData;
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    TextAttribute plain{ 0x00030201, 0x00070605 };
+    TextAttribute bold = plain;
+    bold.SetBold(true);
+    bold.SetForeground(TextColor{ 0x000c0b0a });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Alternate between two attributes a few times."));
+        for (auto i = 0; i < 3; i++)
+        {
+            qExpectedInput.push_back("\x1b[38;2;1;2;3m");
+            if (i == 0)
+            {
+                qExpectedInput.push_back("\x1b[48;2;5;6;7m");
+            }
+            else
+            {
+                qExpectedInput.push_back("\x1b[22m");
+            }
+            VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(plain, &renderData, false, false));
+            VERIFY_ARE_EQUAL(plain, engine->_lastTextAttributes);
+
+            qExpectedInput.push_back("\x1b[38;2;10;11;12m");
+            qExpectedInput.push_back("\x1b[1m");
+            VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(bold, &renderData, false, false));
+            VERIFY_ARE_EQUAL(bold, engine->_lastTextAttributes);
+        }
+
+        Log::Comment(NoThrowString().Format(
+            L"Only the three different transitions were formatted."));
+        VERIFY_ARE_EQUAL(3u, engine->_sgrTransitionCount);
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"The cached transitions don't lose the current hyperlink."));
+        auto link = plain;
+        link.SetHyperlinkId(1);
+        engine->_lastTextAttributes.SetHyperlinkId(1);
+        qExpectedInput.push_back("\x1b[38;2;1;2;3m");
+        qExpectedInput.push_back("\x1b[22m");
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(link, &renderData, false, false));
+        VERIFY_ARE_EQUAL(link, engine->_lastTextAttributes);
+        VERIFY_ARE_EQUAL(3u, engine->_sgrTransitionCount);
+    });
+}
+
 void VtRendererTest::TestResize()
 {
     Viewport view = SetUpViewport();
@@ -1464,6 +1648,30 @@ void VtRendererTest::TestResize()
     });
 }
 
+void VtRendererTest::TestInheritingCursorDefersPaint()
+{
+    Viewport view = SetUpViewport();
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    auto engine = std::make_unique<Xterm256Engine>(std::move(hFile), view);
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+
+    Log::Comment(L"While we wait for the cursor position, nothing is painted, not even the first clear.");
+    engine->SetInheritingCursor(true);
+    VERIFY_SUCCEEDED(engine->InvalidateAll());
+    VERIFY_ARE_EQUAL(S_FALSE, engine->StartPaint());
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    VERIFY_IS_TRUE(engine->_invalidMap.all());
+
+    Log::Comment(L"Once we inherited the cursor, what was invalidated in the meantime is painted, without a clear.");
+    VERIFY_SUCCEEDED(engine->InheritCursor({ 0, 10 }));
+    engine->SetInheritingCursor(false);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+        VERIFY_IS_TRUE(engine->_invalidMap.all());
+    });
+}
+
 void VtRendererTest::TestCursorVisibility()
 {
     Viewport view = SetUpViewport();
@@ -17,6 +17,10 @@ extern "C" {
 
 #define PSEUDOCONSOLE_RESIZE_QUIRK (2u)
 #define PSEUDOCONSOLE_WIN32_INPUT_MODE (4u)
+#define PSEUDOCONSOLE_PASSTHROUGH_MODE (8u)
+#define PSEUDOCONSOLE_TEXT_STREAM_MODE (16u)
+#define PSEUDOCONSOLE_TERMINAL_REFLOW (32u)
+#define PSEUDOCONSOLE_REPEAT_CHARACTER (64u)
 
 HRESULT WINAPI ConptyCreatePseudoConsole(COORD size, HANDLE hInput, HANDLE hOutput, DWORD dwFlags, HPCON* phPC);
 
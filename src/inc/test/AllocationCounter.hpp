@@ -0,0 +1,64 @@
+/*++
+
+Copyright (c) Microsoft Corporation.
+Licensed under the MIT license.
+
+Module Name:
+- AllocationCounter.hpp
+
+Abstract:
+- Counts the heap allocations a test module makes through operator new, so
+  that benchmarks can report allocations next to their timings.
+- The counter itself can be read from anywhere. The operator new and delete
+  replacements that feed it must only be compiled once per module: define
+  ALLOCATION_COUNTER_HOOK_NEW before including this header in exactly one
+  translation unit of the test module.
+--*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Microsoft::Console::Test
+{
+    inline std::atomic<size_t> g_allocationCount{ 0 };
+
+    // Counts the allocations made between its construction and a call to Count().
+    class AllocationCounter
+    {
+    public:
+        AllocationCounter() noexcept :
+            _start{ g_allocationCount.load(std::memory_order_relaxed) }
+        {
+        }
+
+        size_t Count() const noexcept
+        {
+            return g_allocationCount.load(std::memory_order_relaxed) - _start;
+        }
+
+    private:
+        size_t _start;
+    };
+}
+
+#ifdef ALLOCATION_COUNTER_HOOK_NEW
+
+void* operator new(size_t size)
+{
+    Microsoft::Console::Test::g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (const auto p = malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+#endif
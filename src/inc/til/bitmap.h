@@ -11,6 +11,232 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 {
     namespace details
     {
+        // The bits of a bitmap, stored in 64-bit words. Everything the bitmap
+        // does often (setting ranges, and finding the next set or unset bit
+        // while iterating runs) works on a whole word at a time.
+        template<typename Allocator>
+        class _bitmap_bits
+        {
+        public:
+            using block_type = unsigned long long;
+            static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+            explicit _bitmap_bits(const Allocator& allocator) noexcept :
+                _blocks{ allocator },
+                _size{}
+            {
+            }
+
+            _bitmap_bits(const size_t bits, const bool fill, const Allocator& allocator) :
+                _blocks((bits + bitsPerBlock - 1) / bitsPerBlock, fill ? ones : 0, allocator),
+                _size{ bits }
+            {
+                _trim();
+            }
+
+            constexpr size_t size() const noexcept
+            {
+                return _size;
+            }
+
+            bool operator[](const size_t pos) const noexcept
+            {
+                return (_blocks[pos / bitsPerBlock] >> (pos % bitsPerBlock)) & 1;
+            }
+
+            bool operator==(const _bitmap_bits& other) const noexcept
+            {
+                return _size == other._size && std::equal(_blocks.begin(), _blocks.end(), other._blocks.begin(), other._blocks.end());
+            }
+
+            void set(const size_t pos) noexcept
+            {
+                _blocks[pos / bitsPerBlock] |= block_type{ 1 } << (pos % bitsPerBlock);
+            }
+
+            // Sets or resets the bits [pos, pos + len).
+            void set(size_t pos, size_t len, const bool value) noexcept
+            {
+                while (len != 0)
+                {
+                    const auto offset = pos % bitsPerBlock;
+                    const auto count = std::min(len, bitsPerBlock - offset);
+                    const auto mask = _lowMask(count) << offset;
+                    auto& block = _blocks[pos / bitsPerBlock];
+                    block = value ? block | mask : block & ~mask;
+                    pos += count;
+                    len -= count;
+                }
+            }
+
+            void set() noexcept
+            {
+                std::fill(_blocks.begin(), _blocks.end(), ones);
+                _trim();
+            }
+
+            void reset() noexcept
+            {
+                std::fill(_blocks.begin(), _blocks.end(), block_type{ 0 });
+            }
+
+            bool none() const noexcept
+            {
+                return std::all_of(_blocks.begin(), _blocks.end(), [](const block_type block) { return block == 0; });
+            }
+
+            bool all() const noexcept
+            {
+                if (_blocks.empty())
+                {
+                    return true;
+                }
+                const auto last = _blocks.end() - 1;
+                return std::all_of(_blocks.begin(), last, [](const block_type block) { return block == ones; }) &&
+                       *last == _lowMask(_size - (_blocks.size() - 1) * bitsPerBlock);
+            }
+
+            bool one() const noexcept
+            {
+                const auto first = std::find_if(_blocks.begin(), _blocks.end(), [](const block_type block) { return block != 0; });
+                return first != _blocks.end() &&
+                       (*first & (*first - 1)) == 0 &&
+                       std::all_of(first + 1, _blocks.end(), [](const block_type block) { return block == 0; });
+            }
+
+            // The first set bit at or after pos, or npos.
+            size_t find_next_set(const size_t pos) const noexcept
+            {
+                if (pos >= _size)
+                {
+                    return npos;
+                }
+                auto i = pos / bitsPerBlock;
+                auto block = _blocks[i] & ~_lowMask(pos % bitsPerBlock);
+                while (block == 0)
+                {
+                    if (++i == _blocks.size())
+                    {
+                        return npos;
+                    }
+                    block = _blocks[i];
+                }
+                return i * bitsPerBlock + _lowestBit(block);
+            }
+
+            // The first unset bit at or after pos, but no further than limit.
+            size_t find_next_unset(const size_t pos, const size_t limit) const noexcept
+            {
+                if (pos >= limit)
+                {
+                    return limit;
+                }
+                auto i = pos / bitsPerBlock;
+                const auto last = (limit - 1) / bitsPerBlock;
+                auto block = ~_blocks[i] & ~_lowMask(pos % bitsPerBlock);
+                while (block == 0)
+                {
+                    if (++i > last)
+                    {
+                        return limit;
+                    }
+                    block = ~_blocks[i];
+                }
+                return std::min(limit, i * bitsPerBlock + _lowestBit(block));
+            }
+
+            // Moves every bit n positions towards the end (bit i becomes bit i + n).
+            void shift_up(const size_t n) noexcept
+            {
+                if (n >= _size)
+                {
+                    reset();
+                    return;
+                }
+                const auto blockShift = n / bitsPerBlock;
+                const auto bitShift = n % bitsPerBlock;
+                for (auto i = _blocks.size(); i-- > 0;)
+                {
+                    block_type value = 0;
+                    if (i >= blockShift)
+                    {
+                        value = _blocks[i - blockShift] << bitShift;
+                        if (bitShift != 0 && i > blockShift)
+                        {
+                            value |= _blocks[i - blockShift - 1] >> (bitsPerBlock - bitShift);
+                        }
+                    }
+                    _blocks[i] = value;
+                }
+                _trim();
+            }
+
+            // Moves every bit n positions towards the start (bit i + n becomes bit i).
+            void shift_down(const size_t n) noexcept
+            {
+                if (n >= _size)
+                {
+                    reset();
+                    return;
+                }
+                const auto blockShift = n / bitsPerBlock;
+                const auto bitShift = n % bitsPerBlock;
+                for (size_t i = 0; i < _blocks.size(); ++i)
+                {
+                    block_type value = 0;
+                    const auto source = i + blockShift;
+                    if (source < _blocks.size())
+                    {
+                        value = _blocks[source] >> bitShift;
+                        if (bitShift != 0 && source + 1 < _blocks.size())
+                        {
+                            value |= _blocks[source + 1] << (bitsPerBlock - bitShift);
+                        }
+                    }
+                    _blocks[i] = value;
+                }
+            }
+
+        private:
+            static constexpr size_t bitsPerBlock = 64;
+            static constexpr block_type ones = ~block_type{ 0 };
+
+            // The lowest count bits set. count may be 0 or bitsPerBlock.
+            static constexpr block_type _lowMask(const size_t count) noexcept
+            {
+                return count >= bitsPerBlock ? ones : (block_type{ 1 } << count) - 1;
+            }
+
+            // The index of the lowest set bit. block must not be 0.
+            static unsigned long _lowestBit(const block_type block) noexcept
+            {
+                unsigned long index = 0;
+#if defined(_M_X64) || defined(_M_ARM64)
+                _BitScanForward64(&index, block);
+#else
+                if (!_BitScanForward(&index, static_cast<unsigned long>(block)))
+                {
+                    _BitScanForward(&index, static_cast<unsigned long>(block >> 32));
+                    index += 32;
+                }
+#endif
+                return index;
+            }
+
+            // Keeps the bits past _size in the last block unset, which
+            // none(), all(), one() and the shifts rely on.
+            void _trim() noexcept
+            {
+                if (const auto extra = _size % bitsPerBlock; extra != 0 && !_blocks.empty())
+                {
+                    _blocks.back() &= _lowMask(extra);
+                }
+            }
+
+            std::vector<block_type, Allocator> _blocks;
+            size_t _size;
+        };
+
         template<typename Allocator>
         class _bitmap_const_iterator
         {
@@ -21,7 +247,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             using pointer = typename const til::rectangle*;
             using reference = typename const til::rectangle&;
 
-            _bitmap_const_iterator(const dynamic_bitset<unsigned long long, Allocator>& values, til::rectangle rc, ptrdiff_t pos) :
+            _bitmap_const_iterator(const _bitmap_bits<Allocator>& values, til::rectangle rc, ptrdiff_t pos) :
                 _values(values),
                 _rc(rc),
                 _pos(pos),
@@ -46,7 +272,9 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
             constexpr bool operator==(const _bitmap_const_iterator& other) const noexcept
             {
-                return _pos == other._pos && _values == other._values;
+                // Comparing the bits themselves would make every step of a
+                // range-based for loop over the bitmap O(n).
+                return _pos == other._pos && &_values == &other._values;
             }
 
             constexpr bool operator!=(const _bitmap_const_iterator& other) const noexcept
@@ -75,7 +303,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             }
 
         private:
-            const dynamic_bitset<unsigned long long, Allocator>& _values;
+            const _bitmap_bits<Allocator>& _values;
             const til::rectangle _rc;
             ptrdiff_t _pos;
             ptrdiff_t _nextPos;
@@ -88,11 +316,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             {
                 // The following logic first finds the next set bit in this bitmap and the next unset bit past that.
                 // The area in between those positions are thus all set bits and will end up being the next _run.
-
-                // dynamic_bitset allows you to quickly find the next set bit using find_next(prev),
-                // where "prev" is the position _past_ which should be searched (i.e. excluding position "prev").
-                // If _pos is still 0, we thus need to use the counterpart find_first().
-                const auto nextPos = _pos == 0 ? _values.find_first() : _values.find_next(_pos - 1);
+                // Both searches skip over whole words of unset (or set) bits at a time.
+                const auto nextPos = _values.find_next_set(static_cast<size_t>(_pos));
                 // If no next set bit can be found, npos is returned, which is SIZE_T_MAX.
                 // saturated_cast can ensure that this will be converted to PTRDIFF_T_MAX (which is greater than _end).
                 _nextPos = base::saturated_cast<ptrdiff_t>(nextPos);
@@ -107,16 +332,10 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                     // a run can be a max of one row tall.
                     const ptrdiff_t rowEndIndex = _rc.index_of(til::point(_rc.right() - 1, runStart.y())) + 1;
 
-                    // Find the length for the rectangle.
-                    ptrdiff_t runLength = 0;
-
-                    // We have at least 1 so start with a do/while.
-                    do
-                    {
-                        ++_nextPos;
-                        ++runLength;
-                    } while (_nextPos < rowEndIndex && _values[_nextPos]);
                     // Keep going until we reach end of row, end of the buffer, or the next bit is off.
+                    const auto runEnd = static_cast<ptrdiff_t>(_values.find_next_unset(static_cast<size_t>(_nextPos), static_cast<size_t>(rowEndIndex)));
+                    const auto runLength = runEnd - _nextPos;
+                    _nextPos = runEnd;
 
                     // Assemble and store that run.
                     _run = til::rectangle{ runStart, til::size{ runLength, static_cast<ptrdiff_t>(1) } };
@@ -171,7 +390,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 _alloc{ allocator },
                 _sz(sz),
                 _rc(sz),
-                _bits(_sz.area(), fill ? std::numeric_limits<unsigned long long>::max() : 0, _alloc),
+                _bits(static_cast<size_t>(_sz.area()), fill, _alloc),
                 _runs{ _alloc }
             {
             }
@@ -240,7 +459,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 std::swap(_rc, other._rc);
             }
 
-            constexpr bool operator==(const bitmap& other) const noexcept
+            bool operator==(const bitmap& other) const noexcept
             {
                 return _sz == other._sz &&
                        _rc == other._rc &&
@@ -248,7 +467,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 // _runs excluded because it's a cache of generated state.
             }
 
-            constexpr bool operator!=(const bitmap& other) const noexcept
+            bool operator!=(const bitmap& other) const noexcept
             {
                 return !(*this == other);
             }
@@ -353,7 +572,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 THROW_HR_IF(E_INVALIDARG, !_rc.contains(pt));
                 _runs.reset(); // reset cached runs on any non-const method
 
-                _bits.set(_rc.index_of(pt));
+                _bits.set(static_cast<size_t>(_rc.index_of(pt)));
             }
 
             void set(const til::rectangle rc)
@@ -361,9 +580,21 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 THROW_HR_IF(E_INVALIDARG, !_rc.contains(rc));
                 _runs.reset(); // reset cached runs on any non-const method
 
+                if (rc.empty())
+                {
+                    return;
+                }
+
+                // Rows as wide as the bitmap are one contiguous range of bits.
+                if (rc.width() == _sz.width())
+                {
+                    _bits.set(static_cast<size_t>(_rc.index_of(rc.origin())), static_cast<size_t>(rc.size().area()), true);
+                    return;
+                }
+
                 for (auto row = rc.top(); row < rc.bottom(); ++row)
                 {
-                    _bits.set(_rc.index_of(til::point{ rc.left(), row }), rc.width(), true);
+                    _bits.set(static_cast<size_t>(_rc.index_of(til::point{ rc.left(), row })), static_cast<size_t>(rc.width()), true);
                 }
             }
 
@@ -432,22 +663,22 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 }
             }
 
-            constexpr bool one() const noexcept
+            bool one() const noexcept
             {
-                return _bits.count() == 1;
+                return _bits.one();
             }
 
-            constexpr bool any() const noexcept
+            bool any() const noexcept
             {
                 return !none();
             }
 
-            constexpr bool none() const noexcept
+            bool none() const noexcept
             {
                 return _bits.none();
             }
 
-            constexpr bool all() const noexcept
+            bool all() const noexcept
             {
                 return _bits.all();
             }
@@ -506,11 +737,11 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 {
                     // This operator doesn't modify the size of `_bits`: the
                     // new bits are set to 0.
-                    _bits <<= newBits;
+                    _bits.shift_up(newBits);
                 }
                 else
                 {
-                    _bits >>= newBits;
+                    _bits.shift_down(newBits);
                 }
 
                 if (fill)
@@ -531,7 +762,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             allocator_type _alloc;
             til::size _sz;
             til::rectangle _rc;
-            dynamic_bitset<unsigned long long, allocator_type> _bits;
+            details::_bitmap_bits<allocator_type> _bits;
 
             mutable std::optional<std::vector<til::rectangle, run_allocator_type>> _runs;
 
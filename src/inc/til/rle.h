@@ -197,6 +197,13 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 return *operator+(offset);
             }
 
+            // The number of items from this one up to the end of its run,
+            // including itself. All of them have the same value.
+            [[nodiscard]] size_type run_remaining() const noexcept
+            {
+                return _it->length - _pos;
+            }
+
             [[nodiscard]] bool operator==(const rle_iterator& right) const noexcept
             {
                 return _it == right._it && _pos == right._pos;
@@ -854,6 +861,19 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
             rle_scanner scanner{ _runs.begin(), _runs.end() };
             auto [begin, begin_pos] = scanner.scan(start_index);
+
+            // Most writes don't change the attributes of the cells they hit. Writing a value
+            // into a run that already consists of it changes nothing, and needs no moves at all.
+            if (replacements.size() == 1 && begin != _runs.end())
+            {
+                const auto& replacement = replacements.front();
+                const size_type length = end_index - start_index;
+                if (replacement.length == length && replacement.value == begin->value && begin->length - begin_pos >= length)
+                {
+                    return;
+                }
+            }
+
             auto [end, end_pos] = scanner.scan(end_index);
 
             // This condition handles pure removals, where replacements.size() == 0.
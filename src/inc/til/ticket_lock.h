@@ -41,6 +41,16 @@ namespace til
             til::atomic_notify_all(_now_serving);
         }
 
+        // Returns true if another thread is waiting to acquire the lock.
+        // This may only be called while holding the lock and allows
+        // long running operations to briefly yield the lock when needed.
+        bool is_contended() const noexcept
+        {
+            const auto next = _next_ticket.load(std::memory_order_relaxed);
+            const auto current = _now_serving.load(std::memory_order_relaxed);
+            return next - current > 1;
+        }
+
     private:
         // You may be inclined to add alignas(std::hardware_destructive_interference_size)
         // here to force the two atomics on separate cache lines, but I suggest to carefully
@@ -53,4 +63,151 @@ namespace til
         std::atomic<uint32_t> _next_ticket{ 0 };
         std::atomic<uint32_t> _now_serving{ 0 };
     };
+
+    // shared_ticket_lock is a ticket_lock that can also be held by any number of readers at once.
+    //
+    // Exclusive lockers are served in the order they arrived, just like with ticket_lock.
+    // Readers prefer writers: they don't start while any writer holds or waits for the lock,
+    // so a steady stream of readers can't starve them. Both briefly spin before they park
+    // on WaitOnAddress, since the lock is usually only held for short stretches.
+    //
+    // The same caveats as for ticket_lock apply. On top of that, everything done under lock_shared()
+    // must be truly read-only, including what looks like a const cache update.
+    struct shared_ticket_lock
+    {
+        // How many lock attempts had to wait so far. The counters are only approximate,
+        // but good enough to tell whether the lock is a bottleneck.
+        struct contention_counters
+        {
+            uint32_t exclusive;
+            uint32_t shared;
+        };
+
+        void lock() noexcept
+        {
+            const auto ticket = _next_ticket.fetch_add(1, std::memory_order_seq_cst);
+
+            auto contended = false;
+            for (auto spin = 0;;)
+            {
+                const auto current = _now_serving.load(std::memory_order_acquire);
+                if (current == ticket)
+                {
+                    break;
+                }
+
+                contended = true;
+                if (++spin < spin_count)
+                {
+                    YieldProcessor();
+                }
+                else
+                {
+                    til::atomic_wait(_now_serving, current);
+                }
+            }
+
+            // It's our turn, but readers that started before we took our ticket may still be at it.
+            for (auto spin = 0;;)
+            {
+                const auto readers = _readers.load(std::memory_order_seq_cst);
+                if (readers == 0)
+                {
+                    break;
+                }
+
+                contended = true;
+                if (++spin < spin_count)
+                {
+                    YieldProcessor();
+                }
+                else
+                {
+                    til::atomic_wait(_readers, readers);
+                }
+            }
+
+            if (contended)
+            {
+                _exclusive_contentions.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void unlock() noexcept
+        {
+            _now_serving.fetch_add(1, std::memory_order_release);
+            til::atomic_notify_all(_now_serving);
+        }
+
+        void lock_shared() noexcept
+        {
+            auto contended = false;
+            for (auto spin = 0;;)
+            {
+                const auto current = _now_serving.load(std::memory_order_seq_cst);
+                if (_next_ticket.load(std::memory_order_seq_cst) == current)
+                {
+                    // No writer holds or waits for the lock. Register as a reader and check again, since
+                    // a writer may have taken a ticket in between. It'll then wait for us to back off.
+                    _readers.fetch_add(1, std::memory_order_seq_cst);
+                    if (_next_ticket.load(std::memory_order_seq_cst) == current)
+                    {
+                        break;
+                    }
+                    unlock_shared();
+                }
+
+                contended = true;
+                if (++spin < spin_count)
+                {
+                    YieldProcessor();
+                }
+                else
+                {
+                    _waiting_readers.fetch_add(1, std::memory_order_relaxed);
+                    til::atomic_wait(_now_serving, current);
+                    _waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+
+            if (contended)
+            {
+                _shared_contentions.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void unlock_shared() noexcept
+        {
+            if (_readers.fetch_sub(1, std::memory_order_release) == 1)
+            {
+                til::atomic_notify_all(_readers);
+            }
+        }
+
+        // Returns true if another thread is waiting to acquire the lock, exclusively or shared.
+        // This may only be called while holding the lock exclusively and allows
+        // long running operations to briefly yield the lock when needed.
+        bool is_contended() const noexcept
+        {
+            const auto next = _next_ticket.load(std::memory_order_relaxed);
+            const auto current = _now_serving.load(std::memory_order_relaxed);
+            return next - current > 1 || _waiting_readers.load(std::memory_order_relaxed) != 0;
+        }
+
+        contention_counters contentions() const noexcept
+        {
+            return { _exclusive_contentions.load(std::memory_order_relaxed), _shared_contentions.load(std::memory_order_relaxed) };
+        }
+
+    private:
+        // Roughly a microsecond or two of YieldProcessor() on current hardware.
+        static constexpr int spin_count = 64;
+
+        std::atomic<uint32_t> _next_ticket{ 0 };
+        std::atomic<uint32_t> _now_serving{ 0 };
+        std::atomic<uint32_t> _readers{ 0 };
+        std::atomic<uint32_t> _waiting_readers{ 0 };
+        std::atomic<uint32_t> _exclusive_contentions{ 0 };
+        std::atomic<uint32_t> _shared_contentions{ 0 };
+    };
 }
@@ -13,7 +13,10 @@ Tests have been made in order to investigate whether or not own algorithms
 could overcome disadvantages of syscalls. Test results can be read up
 in PR #4093 and the test algorithms are available in src\tools\U8U16Test.
 Based on the results the decision was made to keep using the platform
-functions MultiByteToWideChar and WideCharToMultiByte.
+functions MultiByteToWideChar and WideCharToMultiByte. Most of the text that
+goes through a terminal is ASCII though, which is converted inline, 16
+characters at a time, and only the non-ASCII runs in between are handed to
+the platform functions.
 
 Author(s):
 - Steffen Illhardt (german-one) 2020
@@ -21,8 +24,131 @@ Author(s):
 
 #pragma once
 
+#if defined(_M_AMD64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
 namespace til // Terminal Implementation Library. Also: "Today I Learned"
 {
+    namespace details
+    {
+        // The ASCII fast paths convert this many characters at once. A run of
+        // non-ASCII text only ends once it's followed by this many ASCII
+        // characters in a row, so that mixed text doesn't end up making a
+        // syscall per character.
+        constexpr size_t asciiBlockSize{ 16u };
+
+        // Routine Description:
+        // - Converts the ASCII characters at the start of a UTF-8 string to UTF-16.
+        // Arguments:
+        // - in - UTF-8 string to be converted
+        // - out - buffer with room for at least in.length() UTF-16 code units
+        // Return Value:
+        // - The number of characters that were converted.
+        inline size_t u8u16_ascii(const std::string_view in, wchar_t* const out) noexcept
+        {
+            size_t i{};
+#if defined(_M_AMD64) || defined(_M_IX86)
+            const auto zero = _mm_setzero_si128();
+            for (; i + asciiBlockSize <= in.length(); i += asciiBlockSize)
+            {
+#pragma warning(suppress : 26481 26490) // Don't use pointer arithmetic. Don't use reinterpret_cast.
+                const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+                // Every byte of a multi-byte sequence has its high bit set.
+                if (_mm_movemask_epi8(bytes) != 0)
+                {
+                    break;
+                }
+#pragma warning(suppress : 26481 26490) // Don't use pointer arithmetic. Don't use reinterpret_cast.
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi8(bytes, zero));
+#pragma warning(suppress : 26481 26490) // Don't use pointer arithmetic. Don't use reinterpret_cast.
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpackhi_epi8(bytes, zero));
+            }
+#endif
+            for (; i < in.length(); ++i)
+            {
+                const auto ch = static_cast<unsigned char>(til::at(in, i));
+                if (ch >= 0x80u)
+                {
+                    break;
+                }
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+                out[i] = static_cast<wchar_t>(ch);
+            }
+            return i;
+        }
+
+        // Routine Description:
+        // - Converts the ASCII characters at the start of a UTF-16 string to UTF-8.
+        // Arguments:
+        // - in - UTF-16 string to be converted
+        // - out - buffer with room for at least in.length() UTF-8 code units
+        // Return Value:
+        // - The number of characters that were converted.
+        inline size_t u16u8_ascii(const std::wstring_view in, char* const out) noexcept
+        {
+            size_t i{};
+#if defined(_M_AMD64) || defined(_M_IX86)
+            const auto nonAscii = _mm_set1_epi16(static_cast<short>(0xff80));
+            const auto zero = _mm_setzero_si128();
+            for (; i + asciiBlockSize <= in.length(); i += asciiBlockSize)
+            {
+#pragma warning(suppress : 26481 26490) // Don't use pointer arithmetic. Don't use reinterpret_cast.
+                const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i));
+#pragma warning(suppress : 26481 26490) // Don't use pointer arithmetic. Don't use reinterpret_cast.
+                const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in.data() + i + 8));
+                const auto isAscii = _mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(lo, hi), nonAscii), zero);
+                if (_mm_movemask_epi8(isAscii) != 0xffff)
+                {
+                    break;
+                }
+                // All values are < 0x80, so the saturation never kicks in.
+#pragma warning(suppress : 26481 26490) // Don't use pointer arithmetic. Don't use reinterpret_cast.
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+            }
+#endif
+            for (; i < in.length(); ++i)
+            {
+                const auto ch = til::at(in, i);
+                if (ch >= 0x80u)
+                {
+                    break;
+                }
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+                out[i] = static_cast<char>(ch);
+            }
+            return i;
+        }
+
+        // Routine Description:
+        // - Finds the end of the non-ASCII text at the start of a string, which
+        //   is where the next asciiBlockSize ASCII characters in a row begin.
+        //   ASCII characters are never part of a UTF-8 multi-byte sequence or
+        //   of a UTF-16 surrogate pair, so cutting the string right in front of
+        //   one never splits a code point.
+        // Arguments:
+        // - in - UTF-8 or UTF-16 string
+        // Return Value:
+        // - The length of the non-ASCII text, or in.length() if it doesn't end.
+        template<class charT>
+        size_t non_ascii_length(const std::basic_string_view<charT> in) noexcept
+        {
+            size_t asciiCount{};
+            for (size_t i{}; i < in.length(); ++i)
+            {
+                if (static_cast<std::make_unsigned_t<charT>>(til::at(in, i)) >= 0x80u)
+                {
+                    asciiCount = 0;
+                }
+                else if (++asciiCount == asciiBlockSize)
+                {
+                    return i + 1 - asciiBlockSize;
+                }
+            }
+            return in.length();
+        }
+    }
+
     template<class charT>
     class u8u16state final
     {
@@ -287,10 +413,35 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // The worst ratio of UTF-8 code units to UTF-16 code units is 1 to 1 if UTF-8 consists of ASCII only.
             RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthRequired));
             out.resize(in.length()); // avoid to call MultiByteToWideChar twice only to get the required size
-            const int lengthOut = MultiByteToWideChar(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, in.data(), lengthRequired, out.data(), lengthRequired);
-            out.resize(gsl::narrow_cast<size_t>(lengthOut));
 
-            return lengthOut == 0 ? E_UNEXPECTED : S_OK;
+            const std::string_view input{ in.data(), in.length() };
+            size_t inPos{};
+            size_t outPos{};
+            while (inPos < input.length())
+            {
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+                const auto ascii = details::u8u16_ascii(input.substr(inPos), out.data() + outPos);
+                inPos += ascii;
+                outPos += ascii;
+                if (inPos == input.length())
+                {
+                    break;
+                }
+
+                const auto length = details::non_ascii_length(input.substr(inPos));
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+                const int lengthOut = MultiByteToWideChar(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, input.data() + inPos, gsl::narrow_cast<int>(length), out.data() + outPos, gsl::narrow_cast<int>(out.length() - outPos));
+                if (lengthOut == 0)
+                {
+                    out.clear();
+                    return E_UNEXPECTED;
+                }
+                inPos += length;
+                outPos += gsl::narrow_cast<size_t>(lengthOut);
+            }
+            out.resize(outPos);
+
+            return S_OK;
         }
         catch (std::length_error&)
         {
@@ -356,10 +507,35 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // Thus, the worst ratio of UTF-16 code units to UTF-8 code units is 1 to 3.
             RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthIn) || !base::CheckMul(lengthIn, 3).AssignIfValid(&lengthRequired));
             out.resize(gsl::narrow_cast<size_t>(lengthRequired)); // avoid to call WideCharToMultiByte twice only to get the required size
-            const int lengthOut = WideCharToMultiByte(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, in.data(), lengthIn, out.data(), lengthRequired, nullptr, nullptr);
-            out.resize(gsl::narrow_cast<size_t>(lengthOut));
 
-            return lengthOut == 0 ? E_UNEXPECTED : S_OK;
+            const std::wstring_view input{ in.data(), in.length() };
+            size_t inPos{};
+            size_t outPos{};
+            while (inPos < input.length())
+            {
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+                const auto ascii = details::u16u8_ascii(input.substr(inPos), out.data() + outPos);
+                inPos += ascii;
+                outPos += ascii;
+                if (inPos == input.length())
+                {
+                    break;
+                }
+
+                const auto length = details::non_ascii_length(input.substr(inPos));
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+                const int lengthOut = WideCharToMultiByte(gsl::narrow_cast<UINT>(CP_UTF8), 0ul, input.data() + inPos, gsl::narrow_cast<int>(length), out.data() + outPos, gsl::narrow_cast<int>(out.length() - outPos), nullptr, nullptr);
+                if (lengthOut == 0)
+                {
+                    out.clear();
+                    return E_UNEXPECTED;
+                }
+                inPos += length;
+                outPos += gsl::narrow_cast<size_t>(lengthOut);
+            }
+            out.resize(outPos);
+
+            return S_OK;
         }
         catch (std::length_error&)
         {
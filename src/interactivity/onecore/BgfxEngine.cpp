@@ -7,6 +7,7 @@
 
 #include "ConIoSrvComm.hpp"
 #include "../inc/ServiceLocator.hpp"
+#include "../../types/inc/Viewport.hpp"
 
 #pragma hdrstop
 
@@ -19,12 +20,14 @@
 using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::Interactivity;
 using namespace Microsoft::Console::Interactivity::OneCore;
+using namespace Microsoft::Console::Types;
 
 BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWidth, LONG FontWidth, LONG FontHeight) :
     RenderEngineBase(),
     _sharedViewBase((ULONG_PTR)SharedViewBase),
     _displayHeight(DisplayHeight),
     _displayWidth(DisplayWidth),
+    _invalidMap(til::size{ gsl::narrow_cast<int>(std::max<LONG>(DisplayWidth, 0)), gsl::narrow_cast<int>(std::max<LONG>(DisplayHeight, 0)) }, true),
     _currentLegacyColorAttribute(DEFAULT_COLOR_ATTRIBUTE)
 {
     _runLength = sizeof(CD_IO_CHARACTER) * DisplayWidth;
@@ -33,40 +36,72 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     _fontSize.Y = FontHeight > SHORT_MAX ? SHORT_MAX : (SHORT)FontHeight;
 }
 
-[[nodiscard]] HRESULT BgfxEngine::Invalidate(const SMALL_RECT* const /*psrRegion*/) noexcept
+// Routine Description:
+// - Marks the given cells as needing to be painted in the next frame.
+// Arguments:
+// - rect - the cells, which may extend past the display
+// Return Value:
+// - <none>
+void BgfxEngine::_InvalidateRect(const til::rectangle& rect)
 {
+    _invalidMap.set(rect & til::rectangle{ _invalidMap.size() });
+}
+
+[[nodiscard]] HRESULT BgfxEngine::Invalidate(const SMALL_RECT* const psrRegion) noexcept
+try
+{
+    _InvalidateRect(til::rectangle{ Viewport::FromExclusive(*psrRegion).ToInclusive() });
     return S_OK;
 }
+CATCH_RETURN();
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateCursor(const SMALL_RECT* const /*psrRegion*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept
+try
 {
+    // The cursor is drawn by ConIoSrv, but a frame needs to happen
+    // for us to tell it where it went.
+    _InvalidateRect(til::rectangle{ Viewport::FromExclusive(*psrRegion).ToInclusive() });
     return S_OK;
 }
+CATCH_RETURN();
 
 [[nodiscard]] HRESULT BgfxEngine::InvalidateSystem(const RECT* const /*prcDirtyClient*/) noexcept
 {
-    return S_OK;
+    return InvalidateAll();
 }
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateSelection(const std::vector<SMALL_RECT>& /*rectangles*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
 {
+    for (const auto& rect : rectangles)
+    {
+        RETURN_IF_FAILED(Invalidate(&rect));
+    }
+
     return S_OK;
 }
 
-[[nodiscard]] HRESULT BgfxEngine::InvalidateScroll(const COORD* const /*pcoordDelta*/) noexcept
+[[nodiscard]] HRESULT BgfxEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
 {
+    // The shared view can't be scrolled in place. Every cell changes.
+    if (pcoordDelta->X != 0 || pcoordDelta->Y != 0)
+    {
+        return InvalidateAll();
+    }
+
     return S_OK;
 }
 
 [[nodiscard]] HRESULT BgfxEngine::InvalidateAll() noexcept
 {
+    _invalidMap.set_all();
     return S_OK;
 }
 
 [[nodiscard]] HRESULT BgfxEngine::InvalidateCircling(_Out_ bool* const pForcePaint) noexcept
 {
+    // Every row of the buffer moved up by one, and so did what's displayed.
     *pForcePaint = false;
-    return S_FALSE;
+    return InvalidateAll();
 }
 
 [[nodiscard]] HRESULT BgfxEngine::PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept
@@ -75,11 +110,26 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
     return S_FALSE;
 }
 
+// Routine Description:
+// - Prepares to paint a frame. If nothing was invalidated, there's nothing to
+//   paint, and we don't bother ConIoSrv with an update either.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, or S_FALSE if there's nothing to paint.
 [[nodiscard]] HRESULT BgfxEngine::StartPaint() noexcept
 {
-    return S_OK;
+    return _invalidMap.any() ? S_OK : S_FALSE;
 }
 
+// Routine Description:
+// - Asks ConIoSrv to display the new contents of the shared view, and then
+//   makes them the old contents for the next frame. Only the rows we painted
+//   this frame can differ, so only those need to be copied.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, or the failure from updating the display.
 [[nodiscard]] HRESULT BgfxEngine::EndPaint() noexcept
 {
     NTSTATUS Status;
@@ -91,14 +141,26 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
 
     if (NT_SUCCESS(Status))
     {
-        for (SHORT i = 0; i < _displayHeight; i++)
+        try
         {
-            OldRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength));
-            NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
-            memcpy_s(OldRunBase, _runLength, NewRunBase, _runLength);
+            auto lastRow = -1;
+            for (const auto& run : _invalidMap.runs())
+            {
+                // The runs are sorted by row. Copy each of the rows only once.
+                for (auto i = std::max(run.top<int>(), lastRow + 1); i < run.bottom<int>(); i++)
+                {
+                    OldRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength));
+                    NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
+                    memcpy_s(OldRunBase, _runLength, NewRunBase, _runLength);
+                    lastRow = i;
+                }
+            }
         }
+        CATCH_LOG();
     }
 
+    _invalidMap.reset_all();
+
     return HRESULT_FROM_NT(Status);
 }
 
@@ -120,30 +182,33 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
 }
 
 [[nodiscard]] HRESULT BgfxEngine::PaintBackground() noexcept
+try
 {
-    PVOID OldRunBase;
     PVOID NewRunBase;
 
-    PCD_IO_CHARACTER OldRun;
     PCD_IO_CHARACTER NewRun;
 
-    for (SHORT i = 0; i < _displayHeight; i++)
+    // Only clear the cells we're about to paint. The others keep showing
+    // what we painted in an earlier frame.
+    for (const auto& run : _invalidMap.runs())
     {
-        OldRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength));
-        NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
+        for (auto i = run.top<int>(); i < run.bottom<int>(); i++)
+        {
+            NewRunBase = (PVOID)(_sharedViewBase + (i * 2 * _runLength) + _runLength);
 
-        OldRun = (PCD_IO_CHARACTER)OldRunBase;
-        NewRun = (PCD_IO_CHARACTER)NewRunBase;
+            NewRun = (PCD_IO_CHARACTER)NewRunBase;
 
-        for (SHORT j = 0; j < _displayWidth; j++)
-        {
-            NewRun[j].Character = L' ';
-            NewRun[j].Attribute = 0;
+            for (auto j = run.left<int>(); j < run.right<int>(); j++)
+            {
+                NewRun[j].Character = L' ';
+                NewRun[j].Attribute = 0;
+            }
         }
     }
 
     return S_OK;
 }
+CATCH_RETURN();
 
 [[nodiscard]] HRESULT BgfxEngine::PaintBufferLine(const gsl::span<const Cluster> clusters,
                                                   const COORD coord,
@@ -232,20 +297,12 @@ BgfxEngine::BgfxEngine(PVOID SharedViewBase, LONG DisplayHeight, LONG DisplayWid
 }
 
 [[nodiscard]] HRESULT BgfxEngine::GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept
+try
 {
-    SMALL_RECT r;
-    r.Bottom = _displayHeight > 0 ? (SHORT)(_displayHeight - 1) : 0;
-    r.Top = 0;
-    r.Left = 0;
-    r.Right = _displayWidth > 0 ? (SHORT)(_displayWidth - 1) : 0;
-
-    _dirtyArea = r;
-
-    area = { &_dirtyArea,
-             1 };
-
+    area = _invalidMap.runs();
     return S_OK;
 }
+CATCH_RETURN();
 
 [[nodiscard]] HRESULT BgfxEngine::GetFontSize(_Out_ COORD* const pFontSize) noexcept
 {
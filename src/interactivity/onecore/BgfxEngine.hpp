@@ -76,12 +76,16 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _DoUpdateTitle(_In_ const std::wstring_view newTitle) noexcept override;
 
     private:
+        void _InvalidateRect(const til::rectangle& rect);
+
         ULONG_PTR _sharedViewBase;
         SIZE_T _runLength;
 
         LONG _displayHeight;
         LONG _displayWidth;
-        til::rectangle _dirtyArea;
+        // The cells that need to be painted in the next frame. Everything else
+        // in the shared view still shows what we painted before.
+        til::bitmap _invalidMap;
 
         COORD _fontSize;
 
@@ -12,6 +12,11 @@ UINT SystemConfigurationProvider::GetCaretBlinkTime()
     return s_DefaultCaretBlinkTime;
 }
 
+UINT SystemConfigurationProvider::GetCaretBlinkTimeout()
+{
+    return s_DefaultCaretBlinkTimeout;
+}
+
 bool SystemConfigurationProvider::IsCaretBlinkingEnabled()
 {
     return s_DefaultIsCaretBlinkingEnabled;
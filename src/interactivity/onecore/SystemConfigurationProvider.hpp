@@ -28,6 +28,7 @@ namespace Microsoft::Console::Interactivity::OneCore
         bool IsCaretBlinkingEnabled();
 
         UINT GetCaretBlinkTime();
+        UINT GetCaretBlinkTimeout();
         int GetNumberOfMouseButtons();
         ULONG GetCursorWidth() override;
         ULONG GetNumberOfWheelScrollLines();
@@ -41,6 +42,7 @@ namespace Microsoft::Console::Interactivity::OneCore
 
     private:
         static const UINT s_DefaultCaretBlinkTime = 530; // milliseconds
+        static const UINT s_DefaultCaretBlinkTimeout = 5000; // milliseconds
         static const bool s_DefaultIsCaretBlinkingEnabled = true;
         static const int s_DefaultNumberOfMouseButtons = 3;
         static const ULONG s_DefaultCursorWidth = 1;
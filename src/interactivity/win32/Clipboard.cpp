@@ -108,8 +108,18 @@ void Clipboard::StringPaste(_In_reads_(cchData) const wchar_t* const pData,
 
     try
     {
-        std::deque<std::unique_ptr<IInputEvent>> inEvents = TextToKeyEvents(pData, cchData);
-        gci.pInputBuffer->Write(inEvents);
+        // An application in VT input mode only looks at the characters, so
+        // there's no point in synthesizing a key down and key up event
+        // (or a win32-input-mode sequence) for each one of them.
+        if (gci.pInputBuffer->IsInVirtualTerminalInputMode())
+        {
+            gci.pInputBuffer->WriteString(FilterTextForPaste(pData, cchData));
+        }
+        else
+        {
+            std::deque<std::unique_ptr<IInputEvent>> inEvents = TextToKeyEvents(pData, cchData);
+            gci.pInputBuffer->Write(inEvents);
+        }
     }
     catch (...)
     {
@@ -137,6 +147,37 @@ std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(c
     THROW_HR_IF_NULL(E_INVALIDARG, pData);
 
     std::deque<std::unique_ptr<IInputEvent>> keyEvents;
+    const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
+
+    for (const auto wch : FilterTextForPaste(pData, cchData))
+    {
+        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(wch, codepage);
+        while (!convertedEvents.empty())
+        {
+            keyEvents.push_back(std::move(convertedEvents.front()));
+            convertedEvents.pop_front();
+        }
+    }
+    return keyEvents;
+}
+
+// Routine Description:
+// - Removes the characters that shouldn't be pasted from a string, and
+//   normalizes its line endings.
+// Arguments:
+// - pData - the text to filter
+// - cchData - the size of pData, in wchars
+// Return Value:
+// - The text to paste.
+// Note:
+// - will throw exception on error
+std::wstring Clipboard::FilterTextForPaste(_In_reads_(cchData) const wchar_t* const pData,
+                                           const size_t cchData)
+{
+    THROW_HR_IF_NULL(E_INVALIDARG, pData);
+
+    std::wstring text;
+    text.reserve(cchData);
 
     for (size_t i = 0; i < cchData; ++i)
     {
@@ -174,15 +215,9 @@ std::deque<std::unique_ptr<IInputEvent>> Clipboard::TextToKeyEvents(_In_reads_(c
             currentChar = UNICODE_CARRIAGERETURN;
         }
 
-        const UINT codepage = ServiceLocator::LocateGlobals().getConsoleInformation().OutputCP;
-        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = CharToKeyEvents(currentChar, codepage);
-        while (!convertedEvents.empty())
-        {
-            keyEvents.push_back(std::move(convertedEvents.front()));
-            convertedEvents.pop_front();
-        }
+        text.push_back(currentChar);
     }
-    return keyEvents;
+    return text;
 }
 
 // Routine Description:
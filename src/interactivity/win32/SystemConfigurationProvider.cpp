@@ -15,6 +15,19 @@ UINT SystemConfigurationProvider::GetCaretBlinkTime()
     return ::GetCaretBlinkTime();
 }
 
+// Routine Description:
+// - Gets how long the caret keeps blinking after the last input or output,
+//   before it stays on. This can be INFINITE.
+UINT SystemConfigurationProvider::GetCaretBlinkTimeout()
+{
+    DWORD timeout;
+    if (SystemParametersInfoW(SPI_GETCARETTIMEOUT, 0, &timeout, FALSE))
+    {
+        return timeout;
+    }
+    return s_DefaultCaretBlinkTimeout;
+}
+
 bool SystemConfigurationProvider::IsCaretBlinkingEnabled()
 {
     return GetSystemMetrics(SM_CARETBLINKINGENABLED) ? true : false;
@@ -28,6 +28,7 @@ namespace Microsoft::Console::Interactivity::Win32
         bool IsCaretBlinkingEnabled();
 
         UINT GetCaretBlinkTime();
+        UINT GetCaretBlinkTimeout();
         int GetNumberOfMouseButtons();
         ULONG GetCursorWidth() override;
         ULONG GetNumberOfWheelScrollLines();
@@ -40,6 +41,7 @@ namespace Microsoft::Console::Interactivity::Win32
                                  _In_ PCWSTR pwszAppName);
 
     private:
+        static const UINT s_DefaultCaretBlinkTimeout = 5000; // milliseconds
         static const ULONG s_DefaultCursorWidth = 1;
     };
 }
@@ -51,13 +51,31 @@ RECT WindowMetrics::GetMinClientRectInPixels()
 // - RECT of client area positions in pixels.
 RECT WindowMetrics::GetMaxClientRectInPixels()
 {
-    // This will retrieve the outer window rect. We need the client area to calculate characters.
-    RECT rc = GetMaxWindowRectInPixels();
+    if (!_maxClientRect)
+    {
+        // This will retrieve the outer window rect. We need the client area to calculate characters.
+        RECT rc = GetMaxWindowRectInPixels();
 
-    // convert to client rect
-    ConvertWindowRectToClientRect(&rc);
+        // convert to client rect
+        ConvertWindowRectToClientRect(&rc);
 
-    return rc;
+        _maxClientRect = rc;
+    }
+
+    return *_maxClientRect;
+}
+
+// Routine Description:
+// - Forgets the rectangle GetMaxClientRectInPixels last returned, so that the
+//   next call measures it again. Call this when the window moves, or when
+//   the display configuration, DPI or system metrics change.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void WindowMetrics::InvalidateMaxClientRect() noexcept
+{
+    _maxClientRect.reset();
 }
 
 // Routine Description:
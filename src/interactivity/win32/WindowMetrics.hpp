@@ -41,7 +41,15 @@ namespace Microsoft::Console::Interactivity::Win32
         void ConvertClientRectToWindowRect(_Inout_ RECT* const prc);
         void ConvertWindowRectToClientRect(_Inout_ RECT* const prc);
 
+        void InvalidateMaxClientRect() noexcept;
+
     private:
+        // GetConsoleScreenBufferInfoEx asks for the max client rect on every
+        // call, and finding it means asking about the monitor, its DPI and
+        // the window's frame. The result only changes when the window moves
+        // or the display or system metrics change, so it's kept around until then.
+        std::optional<RECT> _maxClientRect;
+
         enum ConvertRectangle
         {
             CLIENT_TO_WINDOW,
@@ -180,6 +180,8 @@ void Window::_UpdateSystemMetrics() const
     const auto sysConfig = ServiceLocator::LocateSystemConfigurationProvider();
 
     g.cursorPixelWidth = sysConfig->GetCursorWidth();
+
+    ServiceLocator::LocateWindowMetrics<WindowMetrics>()->InvalidateMaxClientRect();
 }
 
 // Routine Description:
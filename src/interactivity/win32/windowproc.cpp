@@ -456,6 +456,9 @@ using namespace Microsoft::Console::Types;
 
     case WM_WINDOWPOSCHANGED:
     {
+        // The window may have moved onto another monitor.
+        ServiceLocator::LocateWindowMetrics<WindowMetrics>()->InvalidateMaxClientRect();
+
         // Only handle this if the DPI is the same as last time.
         // If the DPI is different, assume we're about to get a DPICHANGED notification
         // which will have a better suggested rectangle than this one.
@@ -22,9 +22,6 @@ namespace
     static constexpr DWORD DFF_256COLOR = 0x0040;
     static constexpr DWORD DFF_RGBCOLOR = 0x0080;
 
-    // DRCS soft fonts only require 96 characters at most.
-    static constexpr size_t CHAR_COUNT = 96;
-
 #pragma pack(push, 1)
     struct GLYPHENTRY
     {
@@ -70,7 +67,7 @@ namespace
         WORD dfCspace;
         DWORD dfColorPointer;
         DWORD dfReserved1[4];
-        GLYPHENTRY dfCharTable[CHAR_COUNT];
+        GLYPHENTRY dfCharTable[FontResource::CharCount];
         CHAR szFaceName[LF_FACESIZE];
     };
 #pragma pack(pop)
@@ -111,7 +108,7 @@ void FontResource::_regenerateFont()
     const auto targetHeight = _targetSize.height<WORD>();
     const auto charSizeInBytes = (targetWidth + 7) / 8 * targetHeight;
 
-    const DWORD fontBitmapSize = charSizeInBytes * CHAR_COUNT;
+    const DWORD fontBitmapSize = charSizeInBytes * CharCount;
     const DWORD fontResourceSize = sizeof(FONTINFO) + fontBitmapSize;
 
     auto fontResourceBuffer = std::vector<byte>(fontResourceSize);
@@ -128,7 +125,7 @@ void FontResource::_regenerateFont()
     fontResource.dfAvgWidth = targetWidth;
     fontResource.dfMaxWidth = targetWidth;
     fontResource.dfFirstChar = L' ';
-    fontResource.dfLastChar = fontResource.dfFirstChar + CHAR_COUNT - 1;
+    fontResource.dfLastChar = fontResource.dfFirstChar + CharCount - 1;
     fontResource.dfFace = offsetof(FONTINFO, szFaceName);
     fontResource.dfBitsOffset = sizeof(FONTINFO);
     fontResource.dfFlags = DFF_FIXED | DFF_1COLOR;
@@ -169,7 +166,14 @@ void FontResource::_regenerateFont()
     LOG_HR_IF_NULL(E_FAIL, _fontHandle.get());
 }
 
-void FontResource::_resizeBitPattern(gsl::span<byte> targetBuffer)
+// Routine Description:
+// - Scales the bit patterns of all the glyphs to the target size, and calls
+//   the given function for every pixel that ends up being set.
+// Arguments:
+// - setPixel - called with the character index and the x and y offsets of
+//   the pixel in the target cell.
+template<typename T>
+void FontResource::_scaleGlyphs(T&& setPixel) const
 {
     auto sourceWidth = _sourceSize.width<int>();
     auto targetWidth = _targetSize.width<int>();
@@ -216,70 +220,124 @@ void FontResource::_resizeBitPattern(gsl::span<byte> targetBuffer)
     // into account, we reset the target width back to its original value.
     targetWidth = _targetSize.width<int>();
 
-    auto targetBufferPointer = targetBuffer.begin();
-    for (auto ch = 0; ch < CHAR_COUNT; ch++)
+    // The mapping is the same for every glyph, so we work it out up front.
+    // Bits are read from the source from left to right - MSB to LSB. The source
+    // column is a single bit representing the 1-based position. For each target
+    // column we calculate the span of source columns from which it is derived.
+    // We shift our source column position right by that amount to determine the
+    // next column position, then subtract those two values to obtain a mask. For
+    // example, if we're reading from columns 6 to 3 (exclusively), the initial
+    // column position is 1<<6, the next column position is 1<<3, so the mask is
+    // 64-8=56, or 00111000. We don't want this mask to be zero, though, so if the
+    // span is zero, we need to shift an additional bit to make sure we cover at
+    // least one column.
+    auto columnMasks = std::vector<int>(targetWidth);
+    auto sourceColumn = 1 << 16;
+    auto sourceColumnError = 0;
+    for (auto& sourceMask : columnMasks)
     {
-        // Bits are read from the source from left to right - MSB to LSB. The source
-        // column is a single bit representing the 1-based position. The reason for
-        // this will become clear in the mask calculation below.
-        auto sourceColumn = 1 << 16;
-        auto sourceColumnError = 0;
-
-        // The target format expects the character bitmaps to be laid out in columns
-        // of 8 bits. So we generate 8 bits from each scanline until we've covered
-        // the full target height. Then we start again from the top with the next 8
-        // bits of the line, until we've covered the full target width.
-        for (auto targetX = 0; targetX < targetWidth; targetX += 8)
-        {
-            auto sourceLine = std::next(_bitPattern.begin(), ch * sourceHeight);
-            auto sourceLineError = 0;
+        const auto columnSpan = columnIncrement(sourceColumnError);
+        const auto nextSourceColumn = sourceColumn >> columnSpan;
+        sourceMask = sourceColumn - (nextSourceColumn >> (columnSpan ? 0 : 1));
+        sourceColumn = nextSourceColumn;
+    }
 
-            // Since we're going to be reading from the same horizontal offset for each
-            // target line, we save the state here so we can reset it every iteration.
-            const auto initialSourceColumn = sourceColumn;
-            const auto initialSourceColumnError = sourceColumnError;
+    // Similarly, each target line is derived from a span of source lines, which
+    // are ORed together. Again we must read at least one line.
+    auto lineSpans = std::vector<std::pair<int, int>>(targetHeight);
+    auto sourceLine = 0;
+    auto sourceLineError = 0;
+    for (auto& [firstLine, lineCount] : lineSpans)
+    {
+        const auto lineSpan = lineIncrement(sourceLineError);
+        firstLine = sourceLine;
+        lineCount = std::max(lineSpan, 1);
+        sourceLine += lineSpan;
+    }
 
-            for (auto targetY = 0; targetY < targetHeight; targetY++)
+    const auto bitPattern = gsl::make_span(_bitPattern);
+    for (size_t ch = 0; ch < CharCount; ch++)
+    {
+        const auto glyph = bitPattern.subspan(gsl::narrow_cast<ptrdiff_t>(ch) * sourceHeight, sourceHeight);
+        for (size_t targetY = 0; targetY < lineSpans.size(); targetY++)
+        {
+            const auto [firstLine, lineCount] = til::at(lineSpans, targetY);
+            auto sourceValue = 0;
+            for (auto i = firstLine; i < std::min(firstLine + lineCount, sourceHeight); i++)
             {
-                sourceColumn = initialSourceColumn;
-                sourceColumnError = initialSourceColumnError;
-
-                // For a particular target line, we calculate the span of source lines from
-                // which it is derived, then OR those values together. We don't want the
-                // source value to be zero, though, so we must read at least one line.
-                const auto lineSpan = lineIncrement(sourceLineError);
-                auto sourceValue = 0;
-                for (auto i = 0; i < std::max(lineSpan, 1); i++)
-                {
-                    sourceValue |= sourceLine[i];
-                }
-                std::advance(sourceLine, lineSpan);
+                sourceValue |= til::at(glyph, i);
+            }
 
-                // From the combined value of the source lines, we now need to extract eight
-                // bits to make up the next byte in the target at the current X offset.
-                byte targetValue = 0;
-                for (auto targetBit = 0; targetBit < 8; targetBit++)
+            for (size_t targetX = 0; targetX < columnMasks.size(); targetX++)
+            {
+                if (sourceValue & til::at(columnMasks, targetX))
                 {
-                    targetValue <<= 1;
-                    if (targetX + targetBit < targetWidth)
-                    {
-                        // As with the line iteration, we first need to calculate the span of source
-                        // columns from which the target bit is derived. We shift our source column
-                        // position right by that amount to determine the next column position, then
-                        // subtract those two values to obtain a mask. For example, if we're reading
-                        // from columns 6 to 3 (exclusively), the initial column position is 1<<6,
-                        // the next column position is 1<<3, so the mask is 64-8=56, or 00111000.
-                        // Again we don't want this mask to be zero, so if the span is zero, we need
-                        // to shift an additional bit to make sure we cover at least one column.
-                        const auto columnSpan = columnIncrement(sourceColumnError);
-                        const auto nextSourceColumn = sourceColumn >> columnSpan;
-                        const auto sourceMask = sourceColumn - (nextSourceColumn >> (columnSpan ? 0 : 1));
-                        sourceColumn = nextSourceColumn;
-                        targetValue |= (sourceValue & sourceMask) ? 1 : 0;
-                    }
+                    setPixel(ch, targetX, targetY);
                 }
-                *(targetBufferPointer++) = targetValue;
             }
         }
     }
 }
+
+void FontResource::_resizeBitPattern(gsl::span<byte> targetBuffer)
+{
+    const auto targetWidth = _targetSize.width<size_t>();
+    const auto targetHeight = _targetSize.height<size_t>();
+    const auto charSizeInBytes = (targetWidth + 7) / 8 * targetHeight;
+
+    // The target format expects the character bitmaps to be laid out in columns
+    // of 8 bits. So each scanline contributes 8 bits to a column, until we've
+    // covered the full target height. Then the next 8 bits of every line follow
+    // in the next column, until we've covered the full target width.
+    _scaleGlyphs([&](const size_t ch, const size_t x, const size_t y) {
+        auto& targetValue = til::at(targetBuffer, ch * charSizeInBytes + x / 8 * targetHeight + y);
+        targetValue |= gsl::narrow_cast<byte>(0x80 >> (x % 8));
+    });
+}
+
+// Routine Description:
+// - Returns an 8bpp alpha mask with every glyph of the font, scaled to the
+//   target size. The glyphs are arranged in rows of AtlasColumns glyphs, in
+//   character order, and each of them takes up exactly one target cell.
+// Arguments:
+// - <none>
+// Return Value:
+// - The alpha values, 0 or 255, in rows of AtlasSize().width bytes. Empty
+//   if there's no soft font.
+std::vector<byte> FontResource::CreateAtlas() const
+{
+    if (_bitPattern.empty())
+    {
+        return {};
+    }
+
+    const auto atlasSize = AtlasSize();
+    const auto stride = atlasSize.width<size_t>();
+    const auto targetWidth = _targetSize.width<size_t>();
+    const auto targetHeight = _targetSize.height<size_t>();
+
+    auto atlas = std::vector<byte>(atlasSize.area<size_t>());
+    _scaleGlyphs([&](const size_t ch, const size_t x, const size_t y) {
+        const auto atlasX = ch % AtlasColumns * targetWidth + x;
+        const auto atlasY = ch / AtlasColumns * targetHeight + y;
+        til::at(atlas, atlasY * stride + atlasX) = 0xFF;
+    });
+    return atlas;
+}
+
+til::size FontResource::AtlasSize() const noexcept
+{
+    constexpr auto columns = gsl::narrow_cast<ptrdiff_t>(AtlasColumns);
+    constexpr auto rows = gsl::narrow_cast<ptrdiff_t>(CharCount / AtlasColumns);
+    return { _targetSize.width() * columns, _targetSize.height() * rows };
+}
+
+til::size FontResource::GetTargetSize() const noexcept
+{
+    return _targetSize;
+}
+
+bool FontResource::IsEmpty() const noexcept
+{
+    return _bitPattern.empty();
+}
@@ -36,6 +36,19 @@ HRESULT RenderEngineBase::UpdateTitle(const std::wstring_view newTitle) noexcept
     return hr;
 }
 
+// Method Description:
+// - By default, a region that scrolled is simply repainted. Engines that can
+//   move what they've already drawn can do better.
+// Arguments:
+// - psrRegion - the region that scrolled, in viewport coordinates (exclusive)
+// - pcoordDelta - how far the contents of the region moved
+// Return Value:
+// - See Invalidate.
+HRESULT RenderEngineBase::InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const COORD* const /*pcoordDelta*/) noexcept
+{
+    return Invalidate(psrRegion);
+}
+
 HRESULT RenderEngineBase::UpdateSoftFont(const gsl::span<const uint16_t> /*bitPattern*/,
                                          const SIZE /*cellSize*/,
                                          const size_t /*centeringHint*/) noexcept
@@ -48,6 +61,49 @@ HRESULT RenderEngineBase::PrepareRenderInfo(const RenderFrameInfo& /*info*/) noe
     return S_FALSE;
 }
 
+// Method Description:
+// - By default, runs are painted one after the other, exactly like the
+//   Renderer used to do it itself: update the brushes, then paint the line.
+// Arguments:
+// - runs - the runs to paint
+// - pData - the render data, for UpdateDrawingBrushes
+// Return Value:
+// - S_OK, or the first failure of UpdateDrawingBrushes or PaintBufferLine.
+HRESULT RenderEngineBase::PaintBufferLines(gsl::span<const BufferLineRun> const runs,
+                                           const gsl::not_null<IRenderData*> pData) noexcept
+{
+    for (const auto& run : runs)
+    {
+        RETURN_IF_FAILED(UpdateDrawingBrushes(run.attributes, pData, run.usingSoftFont, false));
+        RETURN_IF_FAILED(PaintBufferLine(run.clusters, run.target, run.trimLeft, run.lineWrapped));
+    }
+    return S_OK;
+}
+
+// Method Description:
+// - By default, no rows are kept, so every row has to be painted from its text.
+// Arguments:
+// - targetRow - the row of the viewport to paint
+// Return Value:
+// - S_FALSE
+HRESULT RenderEngineBase::PaintCachedRow(const size_t /*targetRow*/) noexcept
+{
+    return S_FALSE;
+}
+
+// Method Description:
+// - By default, images aren't drawn at all. Only the text under them is.
+// Arguments:
+// - imageSlice - the slice to paint
+// - target - the screen position of the first cell the slice covers
+// Return Value:
+// - S_FALSE
+HRESULT RenderEngineBase::PaintImageSlice(const ImageSlice& /*imageSlice*/,
+                                          const COORD /*target*/) noexcept
+{
+    return S_FALSE;
+}
+
 HRESULT RenderEngineBase::ResetLineTransform() noexcept
 {
     return S_FALSE;
@@ -5,11 +5,20 @@
 
 #include "renderer.hpp"
 
+#include <TraceLoggingProvider.h>
+
 #pragma hdrstop
 
 using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::Types;
 
+static std::atomic<size_t> s_tracelogCount{ 0 };
+#pragma warning(suppress : 26477) // We don't control tracelogging macros
+TRACELOGGING_DEFINE_PROVIDER(g_hRendererProvider,
+                             "Microsoft.Windows.Terminal.Renderer",
+                             // {93d62bf4-821d-5bbd-228b-7ec39d39e9ea}
+                             (0x93d62bf4, 0x821d, 0x5bbd, 0x22, 0x8b, 0x7e, 0xc3, 0x9d, 0x39, 0xe9, 0xea), );
+
 using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 
 static constexpr auto maxRetriesForRenderEngine = 3;
@@ -34,6 +43,11 @@ Renderer::Renderer(IRenderData* pData,
     _clusterBuffer{},
     _viewport{ pData->GetViewport() }
 {
+    if (0 == s_tracelogCount.fetch_add(1))
+    {
+        TraceLoggingRegister(g_hRendererProvider);
+    }
+
     for (size_t i = 0; i < cEngines; i++)
     {
         IRenderEngine* engine = rgpEngines[i];
@@ -52,6 +66,11 @@ Renderer::~Renderer()
 {
     _destructing = true;
     _pThread.reset();
+
+    if (1 == s_tracelogCount.fetch_sub(1))
+    {
+        TraceLoggingUnregister(g_hRendererProvider);
+    }
 }
 
 // Routine Description:
@@ -111,14 +130,28 @@ try
 {
     FAIL_FAST_IF_NULL(pEngine); // This is a programming error. Fail fast.
 
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::steady_clock;
+
+    const auto lockStart = steady_clock::now();
     _pData->LockConsole();
     auto unlock = wil::scope_exit([&]() {
         _pData->UnlockConsole();
     });
 
+    const auto locked = steady_clock::now();
+    _frameMetrics = {};
+    _frameMetrics.lockWait = duration_cast<microseconds>(locked - lockStart);
+
     // Last chance check if anything scrolled without an explicit invalidate notification since the last frame.
     _CheckViewportAndScroll();
 
+    if (_debugOverlayEnabled.load(std::memory_order_relaxed))
+    {
+        _InvalidateDebugOverlay(pEngine);
+    }
+
     // Try to start painting a frame
     HRESULT const hr = pEngine->StartPaint();
     RETURN_IF_FAILED(hr);
@@ -128,9 +161,17 @@ try
     //      engine won't know that.
     if (S_FALSE == hr)
     {
+        // An engine can have work pending that doesn't depend on anything
+        // being invalid, like the VtEngine's coalesced output. Keep ticking.
+        if (pEngine->RequiresContinuousRedraw())
+        {
+            _NotifyPaintFrame();
+        }
         return S_OK;
     }
 
+    const auto paintStart = steady_clock::now();
+
     auto endPaint = wil::scope_exit([&]() {
         LOG_IF_FAILED(pEngine->EndPaint());
 
@@ -156,7 +197,10 @@ try
     RETURN_IF_FAILED(_PaintBackground(pEngine));
 
     // 2. Paint Rows of Text
+    const auto bufferOutputStart = steady_clock::now();
     _PaintBufferOutput(pEngine);
+    _PaintImageSlices(pEngine);
+    _frameMetrics.bufferOutput = duration_cast<microseconds>(steady_clock::now() - bufferOutputStart);
 
     // 3. Paint overlays that reside above the text buffer
     _PaintOverlays(pEngine);
@@ -170,14 +214,30 @@ try
     // 6. Paint window title
     RETURN_IF_FAILED(_PaintTitle(pEngine));
 
+    // 7. Paint the statistics of the previous frame, if asked to
+    if (_debugOverlayEnabled.load(std::memory_order_relaxed))
+    {
+        _PaintDebugOverlay(pEngine);
+    }
+
     // Force scope exit end paint to finish up collecting information and possibly painting
     endPaint.reset();
+    _frameMetrics.paint = duration_cast<microseconds>(steady_clock::now() - paintStart);
 
     // Force scope exit unlock to let go of global lock so other threads can run
     unlock.reset();
 
     // Trigger out-of-lock presentation for renderers that can support it
+    const auto presentStart = steady_clock::now();
     RETURN_IF_FAILED(pEngine->Present());
+    _frameMetrics.present = duration_cast<microseconds>(steady_clock::now() - presentStart);
+
+    _FinishFrameMetrics(pEngine);
+
+    if (_pfnFramePresented)
+    {
+        _pfnFramePresented(locked);
+    }
 
     // As we leave the scope, EndPaint will be called (declared above)
     return S_OK;
@@ -321,6 +381,9 @@ void Renderer::TriggerRedrawAll()
 // - <none>
 void Renderer::TriggerTeardown() noexcept
 {
+    // Don't let an unfinished synchronized update hold up the paint thread.
+    SynchronizedOutputChanged(false);
+
     // We need to shut down the paint thread on teardown.
     _pThread->WaitForPaintCompletionAndDisable(INFINITE);
 
@@ -457,6 +520,44 @@ void Renderer::TriggerScroll(const COORD* const pcoordDelta)
     _NotifyPaintFrame();
 }
 
+// Routine Description:
+// - Called when the contents of a region of the buffer have moved by the given
+//   distance, like the rows between the scrolling margins do, while the viewport
+//   stays where it is. Engines can move what they've already drawn there, instead
+//   of repainting the whole region.
+// Arguments:
+// - region - the region that scrolled, in buffer coordinates
+// - pcoordDelta - how far the contents of the region moved
+// Return Value:
+// - <none>
+void Renderer::TriggerScrollRegion(const Viewport& region, const COORD* const pcoordDelta)
+{
+    Viewport view = _viewport;
+    SMALL_RECT srUpdateRegion = region.ToExclusive();
+
+    // Double width lines need the same treatment as in TriggerRedraw,
+    // which engines don't do for cells that moved.
+    const auto& buffer = _pData->GetTextBuffer();
+    for (auto row = srUpdateRegion.Top; row < srUpdateRegion.Bottom; row++)
+    {
+        if (buffer.IsDoubleWidthLine(row))
+        {
+            TriggerRedraw(region);
+            return;
+        }
+    }
+
+    if (view.TrimToViewport(&srUpdateRegion))
+    {
+        view.ConvertToOrigin(&srUpdateRegion);
+        std::for_each(_rgpEngines.begin(), _rgpEngines.end(), [&](IRenderEngine* const pEngine) {
+            LOG_IF_FAILED(pEngine->InvalidateScrollRegion(&srUpdateRegion, pcoordDelta));
+        });
+
+        _NotifyPaintFrame();
+    }
+}
+
 // Routine Description:
 // - Called when the text buffer is about to circle its backing buffer.
 //      A renderer might want to get painted before that happens.
@@ -496,6 +597,31 @@ void Renderer::TriggerTitleChange()
     _NotifyPaintFrame();
 }
 
+// Routine Description:
+// - Called when an application starts or ends a synchronized update
+//   (DECSET/DECRST 2026). While one is in progress, WaitUntilCanRender holds
+//   the paint thread back, so everything the application draws in between is
+//   presented together in one frame.
+// Arguments:
+// - enabled - true when the update starts, false when it ends.
+// Return Value:
+// - <none>
+void Renderer::SynchronizedOutputChanged(const bool enabled) noexcept
+{
+    if (enabled)
+    {
+        // Reset the event before raising the flag, so that the paint thread
+        // can't see the flag and then sail through a still signaled event.
+        _synchronizedOutputEvent.ResetEvent();
+        _isSynchronizingOutput.store(true, std::memory_order_release);
+    }
+    else
+    {
+        _isSynchronizingOutput.store(false, std::memory_order_release);
+        _synchronizedOutputEvent.SetEvent();
+    }
+}
+
 // Routine Description:
 // - Update the title for a particular engine.
 // Arguments:
@@ -649,6 +775,29 @@ void Renderer::WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs)
     _pThread->WaitForPaintCompletionAndDisable(dwTimeoutMs);
 }
 
+// Routine Description:
+// - Frees the buffers that only hold anything halfway through a frame. They
+//   grow to fit the largest frame painted so far, and they grow back on the
+//   next frame. The caller must hold the console lock, so that no frame is
+//   being painted.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::ReleaseScratchBuffers() noexcept
+{
+    _clusterBuffer.clear();
+    _clusterBuffer.shrink_to_fit();
+    _pendingRuns.clear();
+    _pendingRuns.shrink_to_fit();
+    _pendingGridLines.clear();
+    _pendingGridLines.shrink_to_fit();
+    _bufferLineRuns.clear();
+    _bufferLineRuns.shrink_to_fit();
+    _debugOverlayClusters.clear();
+    _debugOverlayClusters.shrink_to_fit();
+}
+
 // Routine Description:
 // - Paint helper to fill in the background color of the invalid area within the frame.
 // Arguments:
@@ -680,11 +829,44 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
     gsl::span<const til::rectangle> dirtyAreas;
     LOG_IF_FAILED(pEngine->GetDirtyArea(dirtyAreas));
 
+    _frameMetrics.dirtyRectangles = dirtyAreas.size();
+    for (const auto& dirtyRect : dirtyAreas)
+    {
+        _frameMetrics.dirtyCells += dirtyRect.size().area();
+    }
+
+    // Retrieve the text buffer so we can read information out of it.
+    const auto& buffer = _pData->GetTextBuffer();
+
+    // Most buffers never contain a double width or double height row. Then
+    // every row is painted without a line transform, and the engine doesn't
+    // need to hear about transforms at all.
+    const auto hasLineRenditions = buffer.HasLineRenditions();
+
     // This is to make sure any transforms are reset when this paint is finished.
     auto resetLineTransform = wil::scope_exit([&]() {
-        LOG_IF_FAILED(pEngine->ResetLineTransform());
+        if (hasLineRenditions)
+        {
+            LOG_IF_FAILED(pEngine->ResetLineTransform());
+        }
     });
 
+    // Runs of consecutive single width rows are all painted in one go. Rows
+    // with any other line rendition have a transform specific to that row,
+    // and so they have to be painted on their own.
+    auto batchRendition = LineRendition::SingleWidth;
+
+    // The engine can only paint rows from what it kept of earlier frames, if
+    // nothing else is painted over them. Overlays are painted from their own
+    // buffer, so not even the engine could tell which rows they've touched.
+    // The same goes for the debug overlay.
+    const auto rowCacheAllowed = _pData->GetOverlays().empty() && !_debugOverlayEnabled.load(std::memory_order_relaxed);
+
+    // Drop anything left behind by a previous paint that threw halfway through.
+    _pendingRuns.clear();
+    _pendingGridLines.clear();
+    _clusterBuffer.clear();
+
     for (const auto& dirtyRect : dirtyAreas)
     {
         auto dirty = Viewport::FromInclusive(dirtyRect);
@@ -701,19 +883,25 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
         // Shortcut: don't bother redrawing if the width is 0.
         if (redraw.Width() > 0)
         {
-            // Retrieve the text buffer so we can read information out of it.
-            const auto& buffer = _pData->GetTextBuffer();
-
             // Now walk through each row of text that we need to redraw.
             for (auto row = redraw.Top(); row < redraw.BottomExclusive(); row++)
             {
+                // If the engine still has this row the way it painted it before, there's
+                // no need to go through its text again.
+                if (rowCacheAllowed && _IsRowCacheable(buffer, view, redraw, row) &&
+                    pEngine->PaintCachedRow(gsl::narrow_cast<size_t>(row - view.Top())) == S_OK)
+                {
+                    _frameMetrics.cachedRows++;
+                    continue;
+                }
+
                 // Calculate the boundaries of a single line. This is from the left to right edge of the dirty
                 // area in width and exactly 1 tall.
                 const auto screenLine = SMALL_RECT{ redraw.Left(), row, redraw.RightInclusive(), row };
 
                 // Convert the screen coordinates of the line to an equivalent
                 // range of buffer cells, taking line rendition into account.
-                const auto lineRendition = buffer.GetLineRendition(row);
+                const auto lineRendition = hasLineRenditions ? buffer.GetLineRendition(row) : LineRendition::SingleWidth;
                 const auto bufferLine = Viewport::FromInclusive(ScreenToBufferLine(screenLine, lineRendition));
 
                 // Find where on the screen we should place this line information. This requires us to re-map
@@ -733,14 +921,93 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
                 const auto lineWrapped = (buffer.GetRowByOffset(bufferLine.Origin().Y).WasWrapForced()) &&
                                          (bufferLine.RightExclusive() == buffer.GetSize().Width());
 
-                // Prepare the appropriate line transform for the current row and viewport offset.
-                LOG_IF_FAILED(pEngine->PrepareLineTransform(lineRendition, screenPosition.Y, view.Left()));
+                if (hasLineRenditions)
+                {
+                    // Paint what we've got so far, before the line transform changes.
+                    if (lineRendition != LineRendition::SingleWidth || lineRendition != batchRendition)
+                    {
+                        _FlushBufferLineRuns(pEngine);
+                    }
+                    batchRendition = lineRendition;
+
+                    // Prepare the appropriate line transform for the current row and viewport offset.
+                    LOG_IF_FAILED(pEngine->PrepareLineTransform(lineRendition, screenPosition.Y, view.Left()));
+                }
 
-                // Ask the helper to paint through this specific line.
-                _PaintBufferOutputHelper(pEngine, it, screenPosition, lineWrapped);
+                // Ask the helper to queue up this specific line.
+                _PaintBufferOutputHelper(it, screenPosition, lineWrapped);
             }
         }
     }
+
+    _FlushBufferLineRuns(pEngine);
+}
+
+// Routine Description:
+// - Paints the slices of images drawn over the dirty rows, on top of the text
+//   that _PaintBufferOutput painted.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_PaintImageSlices(_In_ IRenderEngine* const pEngine)
+{
+    const auto view = _pData->GetViewport();
+    const auto& buffer = _pData->GetTextBuffer();
+
+    gsl::span<const til::rectangle> dirtyAreas;
+    LOG_IF_FAILED(pEngine->GetDirtyArea(dirtyAreas));
+
+    for (const auto& dirtyRect : dirtyAreas)
+    {
+        const auto dirty = Viewport::Offset(Viewport::FromInclusive(dirtyRect), view.Origin());
+        const auto redraw = Viewport::Intersect(dirty, view);
+        for (auto row = redraw.Top(); row < redraw.BottomExclusive(); row++)
+        {
+            // Most rows don't have an image, and that's cheap to check.
+            const auto& slice = buffer.GetRowByOffset(row).GetImageSlice();
+            if (slice &&
+                slice->ColumnBegin() < gsl::narrow_cast<size_t>(redraw.RightExclusive()) &&
+                slice->ColumnEnd() > gsl::narrow_cast<size_t>(redraw.Left()))
+            {
+                const auto left = gsl::narrow_cast<SHORT>(slice->ColumnBegin());
+                const auto target = COORD{ gsl::narrow_cast<SHORT>(left - view.Left()),
+                                           gsl::narrow_cast<SHORT>(row - view.Top()) };
+                LOG_IF_FAILED(pEngine->PaintImageSlice(*slice, target));
+            }
+        }
+    }
+}
+
+// Routine Description:
+// - Determines whether a row may be painted from a copy the engine kept of an
+//   earlier frame. That's the case if the whole row is to be painted, and if
+//   its look depends on nothing but its generation and the row appearance.
+// Arguments:
+// - buffer - the text buffer
+// - view - the viewport
+// - redraw - the part of the viewport being painted
+// - row - the row of the buffer
+// Return Value:
+// - true if the engine may paint the row from its copy
+bool Renderer::_IsRowCacheable(const TextBuffer& buffer, const Viewport& view, const Viewport& redraw, const SHORT row) const
+{
+    if (redraw.Left() != view.Left() || redraw.Width() != view.Width())
+    {
+        return false;
+    }
+
+    // Hovered links are underlined by the renderer, not the buffer.
+    const auto screenRow = row - view.Top();
+    if (_hoveredInterval && _hoveredInterval->start.y() <= screenRow && screenRow <= _hoveredInterval->stop.y())
+    {
+        return false;
+    }
+
+    // Double width rows are painted with a transform, and images are painted
+    // over the text after the fact.
+    const auto& bufferRow = buffer.GetRowByOffset(row);
+    return bufferRow.GetLineRendition() == LineRendition::SingleWidth && !bufferRow.GetImageSlice();
 }
 
 static bool _IsAllSpaces(const std::wstring_view v)
@@ -749,8 +1016,16 @@ static bool _IsAllSpaces(const std::wstring_view v)
     return v.find_first_not_of(L" ") == decltype(v)::npos;
 }
 
-void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                        TextBufferCellIterator it,
+// Routine Description:
+// - Splits one line of text into runs of identical attributes and queues them
+//   up, along with their gridlines, to be painted by _FlushBufferLineRuns.
+// Arguments:
+// - it - the cells of the line
+// - target - where the line should be painted on the screen
+// - lineWrapped - whether the line wrapped
+// Return Value:
+// - <none>
+void Renderer::_PaintBufferOutputHelper(TextBufferCellIterator it,
                                         const COORD target,
                                         const bool lineWrapped)
 {
@@ -787,8 +1062,8 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             // Hold onto the current pattern id as well
             const auto currentPatternId = patternIds;
 
-            // Update the drawing brushes with our color and font usage.
-            THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, currentRunColor, usingSoftFont, false));
+            // Hold onto the font usage for this run, too, for when it's painted.
+            const auto currentRunUsingSoftFont = usingSoftFont;
 
             // Advance the point by however many columns we've just outputted and reset the accumulator.
             screenPoint.X += gsl::narrow<SHORT>(cols);
@@ -799,8 +1074,9 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             const auto currentRunItStart = it;
             const auto currentRunTargetStart = screenPoint;
 
-            // Ensure that our cluster vector is clear.
-            _clusterBuffer.clear();
+            // The clusters of this run are appended to the ones of the runs
+            // that are still waiting to be painted.
+            const auto clusterOffset = _clusterBuffer.size();
 
             // Reset our flag to know when we're in the special circumstance
             // of attempting to draw only the right-half of a two-column character
@@ -810,6 +1086,10 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             // Run contains wide character (>1 columns)
             bool containsWideCharacter = false;
 
+            // The number of cells ahead of the iterator that are known to have the attributes
+            // of this run. Their attributes don't need to be compared one by one.
+            size_t sameAttrCells = 0;
+
             // This inner loop will accumulate clusters until the color changes.
             // When the color changes, it will save the new color off and break.
             // We also accumulate clusters according to regex patterns
@@ -819,7 +1099,11 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                 const auto thisPointPatterns = _pData->GetPatternId(thisPoint);
                 const auto thisUsingSoftFont = s_IsSoftFontChar(it->Chars(), _firstSoftFontChar, _lastSoftFontChar);
                 const auto changedPatternOrFont = patternIds != thisPointPatterns || usingSoftFont != thisUsingSoftFont;
-                if (color != it->TextAttr() || changedPatternOrFont)
+                if (sameAttrCells == 0 && color == it->TextAttr())
+                {
+                    sameAttrCells = it.AttrRunLength();
+                }
+                if ((sameAttrCells == 0 && color != it->TextAttr()) || changedPatternOrFont)
                 {
                     auto newAttr{ it->TextAttr() };
                     // foreground doesn't matter for runs of spaces (!)
@@ -839,7 +1123,7 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
 
                 // If we're on the first cluster to be added and it's marked as "trailing"
                 // (a.k.a. the right half of a two column character), then we need some special handling.
-                if (_clusterBuffer.empty() && it->DbcsAttr().IsTrailing())
+                if (_clusterBuffer.size() == clusterOffset && it->DbcsAttr().IsTrailing())
                 {
                     // Move left to the one so the whole character can be struck correctly.
                     --screenPoint.X;
@@ -862,15 +1146,17 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                 }
 
                 // Advance the cluster and column counts.
-                it += std::max<size_t>(it->Columns(), 1); // prevent infinite loop for no visible columns
+                const auto advance = std::max<size_t>(it->Columns(), 1); // prevent infinite loop for no visible columns
+                it += advance;
                 cols += columnCount;
+                sameAttrCells = sameAttrCells > advance ? sameAttrCells - advance : 0;
 
             } while (it);
 
-            // Do the painting.
-            THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, screenPoint, trimLeft, lineWrapped));
+            // Queue up the run. It's painted by _FlushBufferLineRuns along with the other runs of the frame.
+            _pendingRuns.push_back({ clusterOffset, _clusterBuffer.size() - clusterOffset, currentRunColor, screenPoint, trimLeft, lineWrapped, currentRunUsingSoftFont });
 
-            // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
+            // If we're allowed to do grid drawing, queue that up too (since it will be coupled with the color data)
             // We're only allowed to draw the grid lines under certain circumstances.
             if (_pData->IsGridLineDrawingAllowed())
             {
@@ -893,20 +1179,64 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                     // Do that in the future if some WPR trace points you to this spot as super bad.
                     for (auto colsPainted = 0u; colsPainted < cols; ++colsPainted, ++lineIt, ++lineTarget.X)
                     {
-                        auto lines = lineIt->TextAttr();
-                        _PaintBufferOutputGridLineHelper(pEngine, lines, 1, lineTarget);
+                        _pendingGridLines.push_back({ lineIt->TextAttr(), 1, lineTarget });
                     }
                 }
                 else
                 {
                     // If nothing exciting is going on, draw the lines in bulk.
-                    _PaintBufferOutputGridLineHelper(pEngine, currentRunColor, cols, screenPoint);
+                    _pendingGridLines.push_back({ currentRunColor, cols, screenPoint });
                 }
             }
         }
     }
 }
 
+// Routine Description:
+// - Paints all the runs queued up by _PaintBufferOutputHelper in a single call
+//   to the engine, followed by their gridlines.
+// Arguments:
+// - pEngine - The render engine that we're targeting.
+// Return Value:
+// - <none>
+void Renderer::_FlushBufferLineRuns(_In_ IRenderEngine* const pEngine)
+{
+    // Whatever happens, don't let these runs leak into the next flush.
+    const auto clearPending = wil::scope_exit([&]() noexcept {
+        _pendingRuns.clear();
+        _pendingGridLines.clear();
+        _clusterBuffer.clear();
+    });
+
+    if (_pendingRuns.empty())
+    {
+        return;
+    }
+
+    // Only now that the cluster buffer won't grow anymore, can we hand out spans into it.
+    _bufferLineRuns.clear();
+    _bufferLineRuns.reserve(_pendingRuns.size());
+    for (const auto& run : _pendingRuns)
+    {
+        _bufferLineRuns.push_back({ { _clusterBuffer.data() + run.clusterOffset, run.clusterCount },
+                                    run.attributes,
+                                    run.target,
+                                    run.trimLeft,
+                                    run.lineWrapped,
+                                    run.usingSoftFont });
+    }
+
+    _frameMetrics.bufferLineRuns += _bufferLineRuns.size();
+    _frameMetrics.clusters += _clusterBuffer.size();
+
+    THROW_IF_FAILED(pEngine->PaintBufferLines(_bufferLineRuns, _pData));
+
+    for (const auto& gridLines : _pendingGridLines)
+    {
+        _PaintBufferOutputGridLineHelper(pEngine, gridLines.attributes, gridLines.cchLine, gridLines.target);
+    }
+}
+
 // Method Description:
 // - Generates a IRenderEngine::GridLines structure from the values in the
 //      provided textAttribute
@@ -1091,16 +1421,62 @@ void Renderer::_PaintCursor(_In_ IRenderEngine* const pEngine)
 //   * Namely, the DX renderer uses this to know the cursor position and state
 //     before PaintCursor is called, so it can draw the cursor underneath the
 //     text.
+//   * The row generations let engines tell which rows of the viewport have
+//     changed since their last frame.
 // Arguments:
 // - engine - The render engine that we're targeting.
 // Return Value:
 // - S_OK if the engine prepared successfully, or a relevant error via HRESULT.
 [[nodiscard]] HRESULT Renderer::_PrepareRenderInfo(_In_ IRenderEngine* const pEngine)
+try
 {
+    const auto view = _pData->GetViewport();
+    _rowGenerations.resize(gsl::narrow_cast<size_t>(view.Height()));
+    _pData->GetTextBuffer().SnapshotRowGenerations(gsl::narrow_cast<size_t>(view.Top()), _rowGenerations);
+
     RenderFrameInfo info;
     info.cursorInfo = _GetCursorInfo();
+    info.rowGenerations = _rowGenerations;
+    info.rowAppearance = _GetRowAppearance();
     return pEngine->PrepareRenderInfo(info);
 }
+CATCH_RETURN()
+
+// Routine Description:
+// - Hashes everything outside of the buffer that the rows' look depends on:
+//   the colors every attribute resolves to, including the current phase of
+//   the blinking rendition, and the horizontal scroll position.
+// Arguments:
+// - <none>
+// Return Value:
+// - The hash. See RenderFrameInfo::rowAppearance.
+uint64_t Renderer::_GetRowAppearance() const
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    const auto add = [&](const uint64_t value) noexcept {
+        hash = (hash ^ value) * 1099511628211ull;
+    };
+    const auto addColors = [&](const TextAttribute& attr) {
+        const auto [fg, bg] = _pData->GetAttributeColors(attr);
+        add(static_cast<uint64_t>(fg) << 32 | bg);
+    };
+
+    add(gsl::narrow_cast<uint16_t>(_pData->GetViewport().Left()));
+    add(_pData->IsScreenReversed());
+
+    TextAttribute attr;
+    addColors(attr);
+    attr.SetBlinking(true);
+    addColors(attr);
+    attr.SetBlinking(false);
+    for (auto index = 0; index < 256; index++)
+    {
+        attr.SetIndexedForeground256(gsl::narrow_cast<BYTE>(index));
+        addColors(attr);
+    }
+    return hash;
+}
 
 // Routine Description:
 // - Paint helper to draw text that overlays the main buffer to provide user interactivity regions
@@ -1149,10 +1525,12 @@ void Renderer::_PaintOverlay(IRenderEngine& engine,
 
                     auto it = overlay.buffer.GetCellLineDataAt(source);
 
-                    _PaintBufferOutputHelper(&engine, it, target, false);
+                    _PaintBufferOutputHelper(it, target, false);
                 }
             }
         }
+
+        _FlushBufferLineRuns(&engine);
     }
     CATCH_LOG();
 }
@@ -1180,7 +1558,8 @@ void Renderer::_PaintOverlays(_In_ IRenderEngine* const pEngine)
 }
 
 // Routine Description:
-// - Paint helper to draw the selected area of the window.
+// - Paint helper to draw the selected area of the window, as well as the
+//   highlighted matches of a search.
 // Arguments:
 // - <none>
 // Return Value:
@@ -1192,8 +1571,11 @@ void Renderer::_PaintSelection(_In_ IRenderEngine* const pEngine)
         gsl::span<const til::rectangle> dirtyAreas;
         LOG_IF_FAILED(pEngine->GetDirtyArea(dirtyAreas));
 
-        // Get selection rectangles
-        const auto rectangles = _GetSelectionRects();
+        // Get search highlight and selection rectangles. The highlights go
+        // first, so that a selected match is drawn on top of its highlight.
+        auto rectangles = _ToViewportRects(_pData->GetSearchHighlightRects());
+        const auto selectionRects = _GetSelectionRects();
+        rectangles.insert(rectangles.end(), selectionRects.begin(), selectionRects.end());
         for (auto rect : rectangles)
         {
             for (auto& dirtyRect : dirtyAreas)
@@ -1252,9 +1634,20 @@ void Renderer::_PaintSelection(_In_ IRenderEngine* const pEngine)
 // Return Value:
 // - A vector of rectangles representing the regions to select, line by line.
 std::vector<SMALL_RECT> Renderer::_GetSelectionRects() const
+{
+    return _ToViewportRects(_pData->GetSelectionRects());
+}
+
+// Routine Description:
+// - Helper to convert rectangles of the buffer into the equivalent rectangles
+//   of the viewport.
+// Arguments:
+// - rects - The rectangles in buffer coordinates.
+// Return Value:
+// - A vector of rectangles relative to the viewport, line by line.
+std::vector<SMALL_RECT> Renderer::_ToViewportRects(const std::vector<Viewport>& rects) const
 {
     const auto& buffer = _pData->GetTextBuffer();
-    auto rects = _pData->GetSelectionRects();
     // Adjust rectangles to viewport
     Viewport view = _pData->GetViewport();
 
@@ -1333,6 +1726,20 @@ void Renderer::SetRendererEnteredErrorStateCallback(std::function<void()> pfn)
     _pfnRendererEnteredErrorState = std::move(pfn);
 }
 
+// Method Description:
+// - Registers a callback that will be called on the render thread, whenever
+//   a frame has been presented. It's given the time the frame's contents
+//   were captured at, that is when the renderer acquired the console lock.
+//   Anything that was written to the buffer before that is on screen now.
+// Arguments:
+// - pfn: the callback
+// Return Value:
+// - <none>
+void Renderer::SetFramePresentedCallback(std::function<void(std::chrono::steady_clock::time_point)> pfn)
+{
+    _pfnFramePresented = std::move(pfn);
+}
+
 // Method Description:
 // - Attempts to restart the renderer.
 void Renderer::ResetErrorStateAndResume()
@@ -1346,10 +1753,154 @@ void Renderer::UpdateLastHoveredInterval(const std::optional<PointTree::interval
     _hoveredInterval = newInterval;
 }
 
+// Method Description:
+// - Shows or hides the statistics of the last frame in the top right corner
+//   of the viewport. Only the first engine draws them, because that's the
+//   one that draws to the screen.
+// Arguments:
+// - enabled - whether to show the overlay
+void Renderer::SetDebugOverlayEnabled(const bool enabled)
+{
+    if (_debugOverlayEnabled.exchange(enabled) != enabled)
+    {
+        // Draw it, or redraw what it covered.
+        TriggerRedrawAll();
+    }
+}
+
+bool Renderer::IsDebugOverlayEnabled() const noexcept
+{
+    return _debugOverlayEnabled.load(std::memory_order_relaxed);
+}
+
+// Routine Description:
+// - Invalidates the top row of the viewport, so the debug overlay is part of
+//   every frame. Its own cells are then part of each frame's dirty area.
+// Arguments:
+// - pEngine - The render engine that we're targeting.
+// Return Value:
+// - <none>
+void Renderer::_InvalidateDebugOverlay(_In_ IRenderEngine* const pEngine)
+{
+    if (_rgpEngines.empty() || pEngine != _rgpEngines.front())
+    {
+        return;
+    }
+
+    const SMALL_RECT topRow{ 0, 0, gsl::narrow_cast<SHORT>(_viewport.Width() - 1), 0 };
+    LOG_IF_FAILED(pEngine->Invalidate(&topRow));
+}
+
+// Routine Description:
+// - Paints the statistics of the previous frame, right aligned in the top row
+//   of the viewport, in reverse video.
+// Arguments:
+// - pEngine - The render engine that we're targeting.
+// Return Value:
+// - <none>
+void Renderer::_PaintDebugOverlay(_In_ IRenderEngine* const pEngine)
+try
+{
+    if (_rgpEngines.empty() || pEngine != _rgpEngines.front())
+    {
+        return;
+    }
+
+    const auto& metrics = _lastFrameMetrics;
+    _debugOverlayText = fmt::format(FMT_COMPILE(L" #{} dirty {}/{} runs {}/{} cached {} lock {}us paint {}us text {}us present {}us coalesced {} "),
+                                    metrics.frame,
+                                    metrics.dirtyRectangles,
+                                    metrics.dirtyCells,
+                                    metrics.bufferLineRuns,
+                                    metrics.clusters,
+                                    metrics.cachedRows,
+                                    metrics.lockWait.count(),
+                                    metrics.paint.count(),
+                                    metrics.bufferOutput.count(),
+                                    metrics.present.count(),
+                                    metrics.paintRequestsCoalesced);
+
+    const auto width = gsl::narrow_cast<size_t>(std::max<int>(0, _viewport.Width()));
+    const auto text = std::wstring_view{ _debugOverlayText }.substr(0, width);
+
+    _debugOverlayClusters.clear();
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        _debugOverlayClusters.emplace_back(text.substr(i, 1), 1);
+    }
+
+    TextAttribute attributes;
+    attributes.SetReverseVideo(true);
+    LOG_IF_FAILED(_UpdateDrawingBrushes(pEngine, attributes, false, false));
+
+    const COORD target{ gsl::narrow_cast<SHORT>(width - text.size()), 0 };
+    LOG_IF_FAILED(pEngine->PaintBufferLine(_debugOverlayClusters, target, false, false));
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Completes the metrics of the frame that was just presented, and writes
+//   them to the Microsoft.Windows.Terminal.Renderer ETW provider.
+// Arguments:
+// - pEngine - The render engine that painted the frame.
+// Return Value:
+// - <none>
+void Renderer::_FinishFrameMetrics(_In_ IRenderEngine* const pEngine)
+{
+    _frameMetrics.frame = ++_framesMeasured;
+
+    // If we're running in the unittests, we might not have a render thread.
+    if (_pThread)
+    {
+        const auto coalesced = _pThread->GetFrameStatistics().paintRequestsCoalesced;
+        _frameMetrics.paintRequestsCoalesced = coalesced - _lastPaintRequestsCoalesced;
+        _lastPaintRequestsCoalesced = coalesced;
+    }
+
+    if (TraceLoggingProviderEnabled(g_hRendererProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+    {
+        const auto& metrics = _frameMetrics;
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+        TraceLoggingWrite(g_hRendererProvider,
+                          "Frame",
+                          TraceLoggingPointer(pEngine, "engine"),
+                          TraceLoggingUInt64(metrics.frame, "frame"),
+                          TraceLoggingUInt64(static_cast<uint64_t>(metrics.dirtyRectangles), "dirtyRectangles"),
+                          TraceLoggingInt64(static_cast<int64_t>(metrics.dirtyCells), "dirtyCells"),
+                          TraceLoggingUInt64(static_cast<uint64_t>(metrics.bufferLineRuns), "bufferLineRuns"),
+                          TraceLoggingUInt64(static_cast<uint64_t>(metrics.clusters), "clusters"),
+                          TraceLoggingUInt64(static_cast<uint64_t>(metrics.cachedRows), "cachedRows"),
+                          TraceLoggingInt64(metrics.lockWait.count(), "lockWaitUs"),
+                          TraceLoggingInt64(metrics.paint.count(), "paintUs"),
+                          TraceLoggingInt64(metrics.bufferOutput.count(), "bufferOutputUs"),
+                          TraceLoggingInt64(metrics.present.count(), "presentUs"),
+                          TraceLoggingUInt64(metrics.paintRequestsCoalesced, "paintRequestsCoalesced"),
+                          TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                          TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+    }
+
+    if (!_rgpEngines.empty() && pEngine == _rgpEngines.front())
+    {
+        _lastFrameMetrics = _frameMetrics;
+    }
+}
+
 // Method Description:
 // - Blocks until the engines are able to render without blocking.
+// - Also blocks while an application is in the middle of a synchronized
+//   update. Anything invalidated meanwhile is coalesced into the frame that
+//   follows. If the application never ends the update (it might have crashed
+//   half way through), we give up on it after s_SynchronizedOutputTimeoutMs.
 void Renderer::WaitUntilCanRender()
 {
+    if (_isSynchronizingOutput.load(std::memory_order_acquire))
+    {
+        if (WaitForSingleObject(_synchronizedOutputEvent.get(), s_SynchronizedOutputTimeoutMs) == WAIT_TIMEOUT)
+        {
+            _isSynchronizingOutput.store(false, std::memory_order_relaxed);
+        }
+    }
+
     for (const auto pEngine : _rgpEngines)
     {
         pEngine->WaitUntilCanRender();
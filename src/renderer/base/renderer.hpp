@@ -57,10 +57,13 @@ namespace Microsoft::Console::Render
         void TriggerSelection() override;
         void TriggerScroll() override;
         void TriggerScroll(const COORD* const pcoordDelta) override;
+        void TriggerScrollRegion(const Microsoft::Console::Types::Viewport& region, const COORD* const pcoordDelta) override;
 
         void TriggerCircling() override;
         void TriggerTitleChange() override;
 
+        void SynchronizedOutputChanged(const bool enabled) noexcept override;
+
         void TriggerFontChange(const int iDpi,
                                const FontInfoDesired& FontInfoDesired,
                                _Out_ FontInfo& FontInfo) override;
@@ -82,10 +85,36 @@ namespace Microsoft::Console::Render
         void AddRenderEngine(_In_ IRenderEngine* const pEngine) override;
 
         void SetRendererEnteredErrorStateCallback(std::function<void()> pfn);
+        void SetFramePresentedCallback(std::function<void(std::chrono::steady_clock::time_point)> pfn);
         void ResetErrorStateAndResume();
 
         void UpdateLastHoveredInterval(const std::optional<interval_tree::IntervalTree<til::point, size_t>::interval>& newInterval);
 
+        // What it took to paint a single frame for a single engine. Every frame
+        // is reported as a "Frame" event of the Microsoft.Windows.Terminal.Renderer
+        // ETW provider, and the last one is shown by the debug overlay.
+        struct FrameMetrics
+        {
+            uint64_t frame;
+            size_t dirtyRectangles;
+            ptrdiff_t dirtyCells;
+            size_t bufferLineRuns;
+            size_t clusters;
+            // Rows the engine painted from its copy of an earlier frame.
+            size_t cachedRows;
+            std::chrono::microseconds lockWait;
+            std::chrono::microseconds paint;
+            std::chrono::microseconds bufferOutput;
+            std::chrono::microseconds present;
+            // Paint requests since the previous frame that were merged into this one.
+            uint64_t paintRequestsCoalesced;
+        };
+
+        void SetDebugOverlayEnabled(const bool enabled);
+        bool IsDebugOverlayEnabled() const noexcept;
+
+        void ReleaseScratchBuffers() noexcept;
+
     private:
         std::deque<IRenderEngine*> _rgpEngines;
 
@@ -94,6 +123,12 @@ namespace Microsoft::Console::Render
         std::unique_ptr<IRenderThread> _pThread;
         bool _destructing = false;
 
+        // Set while an application is in the middle of a synchronized update
+        // (DECSET 2026). The event is signaled whenever it's not.
+        static constexpr DWORD s_SynchronizedOutputTimeoutMs = 100;
+        std::atomic<bool> _isSynchronizingOutput{ false };
+        wil::unique_event _synchronizedOutputEvent{ wil::EventOptions::ManualReset | wil::EventOptions::Signaled };
+
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _hoveredInterval;
 
         void _NotifyPaintFrame();
@@ -106,10 +141,10 @@ namespace Microsoft::Console::Render
 
         void _PaintBufferOutput(_In_ IRenderEngine* const pEngine);
 
-        void _PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                      TextBufferCellIterator it,
+        void _PaintBufferOutputHelper(TextBufferCellIterator it,
                                       const COORD target,
                                       const bool lineWrapped);
+        void _FlushBufferLineRuns(_In_ IRenderEngine* const pEngine);
 
         static IRenderEngine::GridLines s_GetGridlines(const TextAttribute& textAttribute) noexcept;
 
@@ -118,12 +153,20 @@ namespace Microsoft::Console::Render
                                               const size_t cchLine,
                                               const COORD coordTarget);
 
+        void _PaintImageSlices(_In_ IRenderEngine* const pEngine);
+        uint64_t _GetRowAppearance() const;
+        bool _IsRowCacheable(const TextBuffer& buffer, const Microsoft::Console::Types::Viewport& view, const Microsoft::Console::Types::Viewport& redraw, const SHORT row) const;
+
         void _PaintSelection(_In_ IRenderEngine* const pEngine);
         void _PaintCursor(_In_ IRenderEngine* const pEngine);
 
         void _PaintOverlays(_In_ IRenderEngine* const pEngine);
         void _PaintOverlay(IRenderEngine& engine, const RenderOverlay& overlay);
 
+        void _InvalidateDebugOverlay(_In_ IRenderEngine* const pEngine);
+        void _PaintDebugOverlay(_In_ IRenderEngine* const pEngine);
+        void _FinishFrameMetrics(_In_ IRenderEngine* const pEngine);
+
         [[nodiscard]] HRESULT _UpdateDrawingBrushes(_In_ IRenderEngine* const pEngine,
                                                     const TextAttribute attr,
                                                     const bool usingSoftFont,
@@ -134,9 +177,32 @@ namespace Microsoft::Console::Render
         Microsoft::Console::Types::Viewport _viewport;
 
         static constexpr float _shrinkThreshold = 0.8f;
+        // The runs queued up by _PaintBufferOutputHelper. Their clusters are
+        // stored in _clusterBuffer, which is why they only refer to them by offset.
+        struct PendingBufferLineRun
+        {
+            size_t clusterOffset;
+            size_t clusterCount;
+            TextAttribute attributes;
+            COORD target;
+            bool trimLeft;
+            bool lineWrapped;
+            bool usingSoftFont;
+        };
+        struct PendingGridLines
+        {
+            TextAttribute attributes;
+            size_t cchLine;
+            COORD target;
+        };
         std::vector<Cluster> _clusterBuffer;
+        std::vector<PendingBufferLineRun> _pendingRuns;
+        std::vector<PendingGridLines> _pendingGridLines;
+        std::vector<BufferLineRun> _bufferLineRuns;
+        std::vector<uint64_t> _rowGenerations;
 
         std::vector<SMALL_RECT> _GetSelectionRects() const;
+        std::vector<SMALL_RECT> _ToViewportRects(const std::vector<Microsoft::Console::Types::Viewport>& rects) const;
         void _ScrollPreviousSelection(const til::point delta);
         std::vector<SMALL_RECT> _previousSelection;
 
@@ -153,7 +219,18 @@ namespace Microsoft::Console::Render
         // These are only actually effective/on in Debug builds when the flag is set using an attached debugger.
         bool _fDebug = false;
 
+        // The frame being painted, and the last one painted by the first
+        // engine, which is the one the debug overlay is drawn by.
+        FrameMetrics _frameMetrics{};
+        FrameMetrics _lastFrameMetrics{};
+        uint64_t _framesMeasured = 0;
+        uint64_t _lastPaintRequestsCoalesced = 0;
+        std::atomic<bool> _debugOverlayEnabled{ false };
+        std::vector<Cluster> _debugOverlayClusters;
+        std::wstring _debugOverlayText;
+
         std::function<void()> _pfnRendererEnteredErrorState;
+        std::function<void(std::chrono::steady_clock::time_point)> _pfnFramePresented;
 
 #ifdef UNIT_TESTING
         friend class ConptyOutputTests;
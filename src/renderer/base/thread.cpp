@@ -17,7 +17,10 @@ RenderThread::RenderThread() :
     _fKeepRunning(true),
     _hPaintEnabledEvent(nullptr),
     _fNextFrameRequested(false),
-    _fWaiting(false)
+    _fWaiting(false),
+    _frameIntervalMs(s_FrameLimitMilliseconds),
+    _framesPainted(0),
+    _paintRequestsCoalesced(0)
 {
 }
 
@@ -210,14 +213,28 @@ DWORD WINAPI RenderThread::_ThreadProc()
         ResetEvent(_hPaintCompletedEvent);
 
         _pRenderer->WaitUntilCanRender();
+
+        // The frame interval is measured from the start of this frame, so
+        // that the time we spent painting counts against it. Sleeping for a
+        // whole interval after painting would make a slow frame delay the
+        // next one by its own duration on top of the interval.
+        const auto frameStart = std::chrono::steady_clock::now();
         LOG_IF_FAILED(_pRenderer->PaintFrame());
+        _framesPainted.fetch_add(1, std::memory_order_relaxed);
 
         SetEvent(_hPaintCompletedEvent);
 
         // extra check before we sleep since it's a "long" activity, relatively speaking.
+        // Any NotifyPaint calls that arrive while we sleep are coalesced into the next frame.
         if (_fKeepRunning)
         {
-            Sleep(s_FrameLimitMilliseconds);
+            const auto frameInterval = std::chrono::milliseconds(_frameIntervalMs.load(std::memory_order_relaxed));
+            const auto elapsed = std::chrono::steady_clock::now() - frameStart;
+            if (elapsed < frameInterval)
+            {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(frameInterval - elapsed);
+                Sleep(gsl::narrow_cast<DWORD>(remaining.count()));
+            }
         }
     }
 
@@ -230,9 +247,11 @@ void RenderThread::NotifyPaint()
     {
         SetEvent(_hEvent);
     }
-    else
+    else if (_fNextFrameRequested.exchange(true, std::memory_order_acq_rel))
     {
-        _fNextFrameRequested.store(true, std::memory_order_release);
+        // A frame was already requested and hasn't been painted yet,
+        // so this request will be satisfied by that frame.
+        _paintRequestsCoalesced.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
@@ -302,3 +321,41 @@ void RenderThread::WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs)
     ResetEvent(_hPaintEnabledEvent);
     WaitForSingleObject(_hPaintCompletedEvent, dwTimeoutMs);
 }
+
+// Method Description:
+// - Sets the maximum rate at which this thread will paint frames. Requests
+//      to paint that arrive faster than this are coalesced into one frame.
+// Arguments:
+// - maxFps: the maximum number of frames per second, or 0 to paint as soon
+//      as the engine allows it (the engine may still block in WaitUntilCanRender).
+// Return Value:
+// - <none>
+void RenderThread::SetMaxFramesPerSecond(const unsigned int maxFps) noexcept
+{
+    _frameIntervalMs.store(maxFps == 0 ? 0 : std::max(1000u / maxFps, 1u), std::memory_order_relaxed);
+}
+
+// Method Description:
+// - Gets the maximum rate at which this thread will paint frames.
+// Arguments:
+// - <none>
+// Return Value:
+// - the maximum number of frames per second, or 0 if it isn't limited.
+unsigned int RenderThread::GetMaxFramesPerSecond() const noexcept
+{
+    const auto frameIntervalMs = _frameIntervalMs.load(std::memory_order_relaxed);
+    return frameIntervalMs == 0 ? 0 : 1000u / frameIntervalMs;
+}
+
+// Method Description:
+// - Gets the number of frames painted so far and the number of paint
+//      requests that were folded into an already pending frame.
+// Arguments:
+// - <none>
+// Return Value:
+// - The frame counters of this thread.
+RenderThread::FrameStatistics RenderThread::GetFrameStatistics() const noexcept
+{
+    return { _framesPainted.load(std::memory_order_relaxed),
+             _paintRequestsCoalesced.load(std::memory_order_relaxed) };
+}
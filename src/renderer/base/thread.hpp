@@ -33,12 +33,20 @@ namespace Microsoft::Console::Render
         void DisablePainting() override;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) override;
 
+        void SetMaxFramesPerSecond(const unsigned int maxFps) noexcept;
+        unsigned int GetMaxFramesPerSecond() const noexcept;
+        FrameStatistics GetFrameStatistics() const noexcept override;
+
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
         DWORD WINAPI _ThreadProc();
 
         static DWORD const s_FrameLimitMilliseconds = 8;
 
+        std::atomic<DWORD> _frameIntervalMs;
+        std::atomic<uint64_t> _framesPainted;
+        std::atomic<uint64_t> _paintRequestsCoalesced;
+
         HANDLE _hThread;
         HANDLE _hEvent;
 
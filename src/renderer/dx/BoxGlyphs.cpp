@@ -0,0 +1,312 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "BoxGlyphs.h"
+
+using namespace Microsoft::Console::Render;
+
+namespace
+{
+    enum Weight : uint8_t
+    {
+        None = 0,
+        Light = 1,
+        Heavy = 2,
+        Double = 3,
+    };
+
+    // The lines of U+2500-U+257F. Each entry packs the weights of the arms
+    // that go up, right, down and left from the center of the cell into one
+    // nibble each, in that order. 0 leaves the character to the font.
+    constexpr std::array<uint16_t, 0x80> s_lines{
+        // U+2500
+        0x0101, 0x0202, 0x1010, 0x2020, 0x0000, 0x0000, 0x0000, 0x0000,
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0110, 0x0210, 0x0120, 0x0220,
+        // U+2510
+        0x0011, 0x0012, 0x0021, 0x0022, 0x1100, 0x1200, 0x2100, 0x2200,
+        0x1001, 0x1002, 0x2001, 0x2002, 0x1110, 0x1210, 0x2110, 0x1120,
+        // U+2520
+        0x2120, 0x2210, 0x1220, 0x2220, 0x1011, 0x1012, 0x2011, 0x1021,
+        0x2021, 0x2012, 0x1022, 0x2022, 0x0111, 0x0112, 0x0211, 0x0212,
+        // U+2530
+        0x0121, 0x0122, 0x0221, 0x0222, 0x1101, 0x1102, 0x1201, 0x1202,
+        0x2101, 0x2102, 0x2201, 0x2202, 0x1111, 0x1112, 0x1211, 0x1212,
+        // U+2540
+        0x2111, 0x1121, 0x2121, 0x2112, 0x2211, 0x1122, 0x1221, 0x2212,
+        0x1222, 0x2122, 0x2221, 0x2222, 0x0000, 0x0000, 0x0000, 0x0000,
+        // U+2550
+        0x0303, 0x3030, 0x0310, 0x0130, 0x0330, 0x0013, 0x0031, 0x0033,
+        0x1300, 0x3100, 0x3300, 0x1003, 0x3001, 0x3003, 0x1310, 0x3130,
+        // U+2560
+        0x3330, 0x1013, 0x3031, 0x3033, 0x0313, 0x0131, 0x0333, 0x1303,
+        0x3101, 0x3303, 0x1313, 0x3131, 0x3333, 0x0000, 0x0000, 0x0000,
+        // U+2570
+        0x0000, 0x0000, 0x0000, 0x0000, 0x0001, 0x1000, 0x0100, 0x0010,
+        0x0002, 0x2000, 0x0200, 0x0020, 0x0201, 0x1020, 0x0102, 0x2010,
+    };
+
+    // The quadrants of U+2596-U+259F: 1 is upper left, 2 upper right,
+    // 4 lower left and 8 lower right.
+    constexpr std::array<uint8_t, 10> s_quadrants{ 4, 8, 1, 13, 9, 7, 11, 2, 6, 14 };
+
+    // A line's extent across the direction it runs in. Double lines have two.
+    struct Span
+    {
+        float begin;
+        float end;
+    };
+
+    struct Strokes
+    {
+        std::array<Span, 2> spans;
+        size_t count;
+    };
+
+    // Lines are centered in the cell, on whole pixels.
+    Strokes _StrokesFor(const uint8_t weight, const float size, const float light, const float heavy) noexcept
+    {
+        Strokes strokes{};
+        if (weight == Double)
+        {
+            const auto begin = std::floor((size - 3 * light) / 2);
+            strokes.spans = { Span{ begin, begin + light }, Span{ begin + 2 * light, begin + 3 * light } };
+            strokes.count = 2;
+        }
+        else if (weight != None)
+        {
+            const auto thickness = weight == Heavy ? heavy : light;
+            const auto begin = std::floor((size - thickness) / 2);
+            strokes.spans[0] = { begin, begin + thickness };
+            strokes.count = 1;
+        }
+        return strokes;
+    }
+
+    // Two arms that meet in a straight line draw the same kind of line. If
+    // either is double, both are.
+    constexpr uint8_t _CombinedWeight(const uint8_t a, const uint8_t b) noexcept
+    {
+        return a == Double || b == Double ? Double : std::max(a, b);
+    }
+
+    // Routine Description:
+    // - Finds where one stroke of an arm has to end, so that it joins the
+    //   lines that cross it without gaps, and without bridging the gap
+    //   between the two strokes of a crossing double line.
+    // Arguments:
+    // - size - the cell's size along the arm
+    // - fromStart - the arm starts at 0 (left or up), rather than at size
+    // - crossing - the strokes of the lines that cross the arm
+    // - isDouble - the arm is a double line
+    // - sideArm - for double arms, whether there's a crossing arm on this
+    //   stroke's side of the arm
+    // - opposite - the arm continues on the other side of the center
+    // - crossingThrough - the crossing line continues on both sides of the arm
+    // Return Value:
+    // - The coordinate along the arm where this stroke ends.
+    float _ArmEnd(const float size,
+                  const bool fromStart,
+                  const Strokes& crossing,
+                  const bool isDouble,
+                  const bool sideArm,
+                  const bool opposite,
+                  const bool crossingThrough) noexcept
+    {
+        if (crossing.count == 0)
+        {
+            return std::floor(size / 2);
+        }
+
+        const auto& nearest = fromStart ? crossing.spans[0] : gsl::at(crossing.spans, crossing.count - 1);
+        const auto& farthest = fromStart ? gsl::at(crossing.spans, crossing.count - 1) : crossing.spans[0];
+        const auto farEdge = [=](const Span& span) noexcept { return fromStart ? span.end : span.begin; };
+
+        if (isDouble)
+        {
+            // Inner strokes stop at the closest crossing stroke, outer ones
+            // continue up to the far one, making the corner.
+            return farEdge(sideArm ? nearest : farthest);
+        }
+        if (opposite)
+        {
+            return std::floor(size / 2);
+        }
+        return farEdge(crossingThrough ? nearest : farthest);
+    }
+}
+
+BoxGlyphs::BoxGlyphs(const D2D1_SIZE_F cellSize, const float lineWidth) :
+    _cellSize{ cellSize },
+    _light{ std::max(1.0f, std::round(lineWidth)) },
+    _heavy{ 2 * _light }
+{
+    _rects.reserve(GlyphCount * 4);
+    for (size_t i = 0; i < GlyphCount; ++i)
+    {
+        const auto wch = gsl::narrow_cast<wchar_t>(FirstGlyph + i);
+        const auto first = _rects.size();
+
+        if (i < s_lines.size())
+        {
+            _AddLines(gsl::at(s_lines, i));
+        }
+        else
+        {
+            _AddBlocks(wch);
+        }
+
+        gsl::at(_ranges, i) = { gsl::narrow_cast<uint16_t>(first), gsl::narrow_cast<uint16_t>(_rects.size()) };
+    }
+}
+
+// Routine Description:
+// - Gets the rectangles that make up a character.
+// Arguments:
+// - wch - the character
+// Return Value:
+// - The rectangles, relative to the top left corner of the cell. Empty if
+//   the character has to be drawn from the font.
+gsl::span<const BoxGlyphs::Rect> BoxGlyphs::Lookup(const wchar_t wch) const noexcept
+{
+    if (!IsBoxGlyph(wch) || _rects.empty())
+    {
+        return {};
+    }
+
+    const auto& range = gsl::at(_ranges, wch - FirstGlyph);
+    return gsl::span<const Rect>{ _rects }.subspan(range.first, range.second - range.first);
+}
+
+// Routine Description:
+// - Adds the rectangles for one of the lines in U+2500-U+257F.
+// Arguments:
+// - arms - the packed arm weights, see s_lines.
+void BoxGlyphs::_AddLines(const uint16_t arms)
+{
+    const uint8_t up = (arms >> 12) & 0xf;
+    const uint8_t right = (arms >> 8) & 0xf;
+    const uint8_t down = (arms >> 4) & 0xf;
+    const uint8_t left = arms & 0xf;
+
+    // The x extents of the vertical line, and the y extents of the horizontal one.
+    const auto vertical = _StrokesFor(_CombinedWeight(up, down), _cellSize.width, _light, _heavy);
+    const auto horizontal = _StrokesFor(_CombinedWeight(left, right), _cellSize.height, _light, _heavy);
+
+    struct Arm
+    {
+        uint8_t weight;
+        bool horizontal;
+        bool fromStart;
+        uint8_t opposite;
+    };
+    const std::array<Arm, 4> allArms{ {
+        { up, false, true, down },
+        { right, true, false, left },
+        { down, false, false, up },
+        { left, true, true, right },
+    } };
+
+    for (const auto& arm : allArms)
+    {
+        if (arm.weight == None)
+        {
+            continue;
+        }
+
+        const auto length = arm.horizontal ? _cellSize.width : _cellSize.height;
+        const auto& crossing = arm.horizontal ? vertical : horizontal;
+        // The crossing arms on the first (top or left) and second side of this one.
+        const auto sideA = arm.horizontal ? up : left;
+        const auto sideB = arm.horizontal ? down : right;
+        const auto own = _StrokesFor(arm.weight, arm.horizontal ? _cellSize.height : _cellSize.width, _light, _heavy);
+
+        for (size_t i = 0; i < own.count; ++i)
+        {
+            const auto sideArm = (i == 0 ? sideA : sideB) != None;
+            const auto end = _ArmEnd(length, arm.fromStart, crossing, arm.weight == Double, sideArm, arm.opposite != None, sideA != None && sideB != None);
+            const auto begin = arm.fromStart ? 0.0f : length;
+            const auto low = std::min(begin, end);
+            const auto high = std::max(begin, end);
+            const auto& span = gsl::at(own.spans, i);
+
+            if (arm.horizontal)
+            {
+                _Add(low, span.begin, high, span.end);
+            }
+            else
+            {
+                _Add(span.begin, low, span.end, high);
+            }
+        }
+    }
+}
+
+// Routine Description:
+// - Adds the rectangles for one of the block elements in U+2580-U+259F.
+// Arguments:
+// - wch - the character
+void BoxGlyphs::_AddBlocks(const wchar_t wch)
+{
+    const auto w = _cellSize.width;
+    const auto h = _cellSize.height;
+    const auto x = [=](const float fraction) noexcept { return std::round(w * fraction); };
+    const auto y = [=](const float fraction) noexcept { return std::round(h * fraction); };
+
+    if (wch == 0x2580) // upper half
+    {
+        _Add(0, 0, w, y(0.5f));
+    }
+    else if (wch <= 0x2588) // lower one eighth to full block
+    {
+        _Add(0, y(1.0f - (wch - 0x2580) / 8.0f), w, h);
+    }
+    else if (wch <= 0x258F) // left seven eighths to one eighth
+    {
+        _Add(0, 0, x((8 - (wch - 0x2588)) / 8.0f), h);
+    }
+    else if (wch == 0x2590) // right half
+    {
+        _Add(x(0.5f), 0, w, h);
+    }
+    else if (wch <= 0x2593) // light, medium and dark shade
+    {
+        _Add(0, 0, w, h, (wch - 0x2590) / 4.0f);
+    }
+    else if (wch == 0x2594) // upper one eighth
+    {
+        _Add(0, 0, w, y(1.0f / 8.0f));
+    }
+    else if (wch == 0x2595) // right one eighth
+    {
+        _Add(x(7.0f / 8.0f), 0, w, h);
+    }
+    else // quadrants
+    {
+        const auto quadrants = gsl::at(s_quadrants, wch - 0x2596);
+        const auto midX = x(0.5f);
+        const auto midY = y(0.5f);
+        if (WI_IsFlagSet(quadrants, 1))
+        {
+            _Add(0, 0, midX, midY);
+        }
+        if (WI_IsFlagSet(quadrants, 2))
+        {
+            _Add(midX, 0, w, midY);
+        }
+        if (WI_IsFlagSet(quadrants, 4))
+        {
+            _Add(0, midY, midX, h);
+        }
+        if (WI_IsFlagSet(quadrants, 8))
+        {
+            _Add(midX, midY, w, h);
+        }
+    }
+}
+
+void BoxGlyphs::_Add(const float left, const float top, const float right, const float bottom, const float opacity)
+{
+    _rects.push_back({ D2D1::RectF(left, top, right, bottom), opacity });
+}
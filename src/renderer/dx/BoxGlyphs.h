@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <d2d1.h>
+
+namespace Microsoft::Console::Render
+{
+    // Most box drawing and block element characters (U+2500-U+259F) are drawn
+    // from a handful of rectangles, instead of from the font's outlines. The
+    // rectangles are computed once per cell size, in whole pixels, so lines
+    // join up exactly across neighboring cells, whatever the font's glyphs
+    // look like. Dashed lines, arcs and diagonals aren't covered, and are
+    // still drawn from the font.
+    class BoxGlyphs
+    {
+    public:
+        struct Rect
+        {
+            // Relative to the top left corner of the cell.
+            D2D1_RECT_F rect;
+            float opacity;
+        };
+
+        BoxGlyphs() = default;
+        BoxGlyphs(const D2D1_SIZE_F cellSize, const float lineWidth);
+
+        [[nodiscard]] static constexpr bool IsBoxGlyph(const wchar_t wch) noexcept
+        {
+            return wch >= FirstGlyph && wch <= LastGlyph;
+        }
+
+        // The rectangles for U+2500-U+259F, in cell coordinates. The span is
+        // empty if the character isn't drawn by us.
+        [[nodiscard]] gsl::span<const Rect> Lookup(const wchar_t wch) const noexcept;
+
+    private:
+        static constexpr wchar_t FirstGlyph = 0x2500;
+        static constexpr wchar_t LastGlyph = 0x259F;
+        static constexpr size_t GlyphCount = LastGlyph - FirstGlyph + 1;
+
+        void _AddLines(const uint16_t arms);
+        void _AddBlocks(const wchar_t wch);
+        void _Add(const float left, const float top, const float right, const float bottom, const float opacity = 1.0f);
+
+        D2D1_SIZE_F _cellSize{};
+        float _light{ 1.0f };
+        float _heavy{ 2.0f };
+
+        // Each glyph's rectangles are the range [_ranges[i].first, _ranges[i].second) of _rects.
+        std::array<std::pair<uint16_t, uint16_t>, GlyphCount> _ranges{};
+        std::vector<Rect> _rects;
+    };
+}
@@ -114,6 +114,42 @@ CATCH_RETURN()
     return S_OK;
 }
 
+// Routine Description:
+// - Adds up the memory held by the cache of recently drawn layouts.
+// Arguments:
+// - <none>
+// Return Value:
+// - The size of the cache, in bytes.
+size_t CustomTextLayout::GetCacheMemoryUsage() const noexcept
+{
+    size_t usage = _layoutCacheMap.bucket_count() * sizeof(void*) + _layoutCacheMap.size() * (sizeof(decltype(_layoutCacheMap)::value_type) + 2 * sizeof(void*));
+    for (const auto& entry : _layoutCache)
+    {
+        const auto& shaped = entry.shaped;
+        usage += sizeof(entry) + 2 * sizeof(void*);
+        usage += shaped.text.capacity() * sizeof(wchar_t);
+        usage += shaped.textClusterColumns.capacity() * sizeof(UINT16);
+        usage += shaped.runs.capacity() * sizeof(LinkedRun);
+        usage += shaped.glyphOffsets.capacity() * sizeof(DWRITE_GLYPH_OFFSET);
+        usage += shaped.glyphClusters.capacity() * sizeof(UINT16);
+        usage += shaped.glyphIndices.capacity() * sizeof(UINT16);
+        usage += shaped.glyphAdvances.capacity() * sizeof(float);
+    }
+    return usage;
+}
+
+// Routine Description:
+// - Drops the cache of recently drawn layouts, for when the engine is idle.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CustomTextLayout::ClearCache() noexcept
+{
+    _layoutCacheMap.clear();
+    _layoutCache.clear();
+}
+
 // Routine Description:
 // - Implements a drawing interface similarly to the default IDWriteTextLayout which will
 //   take the string from construction, analyze it for complexity, shape up the glyphs,
@@ -137,17 +173,37 @@ try
 {
     const auto drawingContext = static_cast<const DrawingContext*>(clientDrawingContext);
 
+    RETURN_IF_FAILED(Shape(drawingContext->useBoldFont, drawingContext->useItalicFont));
+    RETURN_IF_FAILED(DrawShaped(clientDrawingContext, renderer, originX, originY));
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Analyzes the text and shapes it into glyphs, without drawing them yet.
+//   The layout doesn't touch the renderer or its drawing context for this,
+//   so that text can be shaped on any thread (see DxEngine::PaintBufferLines).
+//   DrawShaped draws the result.
+// Arguments:
+// - bold - Whether the text is to be drawn with the bold font
+// - italic - Whether the text is to be drawn with the italic font
+// Return Value:
+// - S_OK or suitable DirectX/DirectWrite/Direct2D result code.
+[[nodiscard]] HRESULT STDMETHODCALLTYPE CustomTextLayout::Shape(const bool bold, const bool italic) noexcept
+try
+{
     DWRITE_FONT_WEIGHT weight = _fontRenderData->DefaultFontWeight();
     DWRITE_FONT_STYLE style = _fontRenderData->DefaultFontStyle();
     const DWRITE_FONT_STRETCH stretch = _fontRenderData->DefaultFontStretch();
 
-    if (drawingContext->useBoldFont)
+    if (bold)
     {
         // TODO: "relative" bold?
         weight = DWRITE_FONT_WEIGHT_BOLD;
     }
 
-    if (drawingContext->useItalicFont)
+    if (italic)
     {
         style = DWRITE_FONT_STYLE_ITALIC;
     }
@@ -155,21 +211,161 @@ try
     _formatInUse = _fontRenderData->TextFormatWithAttribute(weight, style, stretch).Get();
     _fontInUse = _fontRenderData->FontFaceWithAttribute(weight, style, stretch).Get();
 
-    RETURN_IF_FAILED(_AnalyzeTextComplexity());
-    RETURN_IF_FAILED(_AnalyzeRuns());
-    RETURN_IF_FAILED(_ShapeGlyphRuns());
-    RETURN_IF_FAILED(_CorrectGlyphRuns());
-    // Correcting box drawing has to come after both font fallback and
-    // the glyph run advance correction (which will apply a font size scaling factor).
-    // We need to know all the proposed X and Y dimension metrics to get this right.
-    RETURN_IF_FAILED(_CorrectBoxDrawing());
-
-    RETURN_IF_FAILED(_DrawGlyphRuns(clientDrawingContext, renderer, { originX, originY }));
+    const auto hash = _HashLayoutKey();
+    if (!_RestoreCachedLayout(hash))
+    {
+        RETURN_IF_FAILED(_AnalyzeTextComplexity());
+        RETURN_IF_FAILED(_AnalyzeRuns());
+        RETURN_IF_FAILED(_ShapeGlyphRuns());
+        RETURN_IF_FAILED(_CorrectGlyphRuns());
+        // Correcting box drawing has to come after both font fallback and
+        // the glyph run advance correction (which will apply a font size scaling factor).
+        // We need to know all the proposed X and Y dimension metrics to get this right.
+        RETURN_IF_FAILED(_CorrectBoxDrawing());
+
+        _StoreCachedLayout(hash);
+    }
 
     return S_OK;
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Draws the text as laid out by the last call to Shape,
+//   or as swapped in with SwapShapedText.
+// Arguments:
+// - clientDrawingContext - Optional pointer to information that the renderer might need
+//                          while attempting to graphically place the text onto the screen
+// - renderer - The interface to be used for actually putting text onto the screen
+// - originX - X pixel point of top left corner on final surface for drawing
+// - originY - Y pixel point of top left corner on final surface for drawing
+// Return Value:
+// - S_OK or suitable DirectX/DirectWrite/Direct2D result code.
+[[nodiscard]] HRESULT STDMETHODCALLTYPE CustomTextLayout::DrawShaped(_In_opt_ void* clientDrawingContext,
+                                                                     _In_ IDWriteTextRenderer* renderer,
+                                                                     FLOAT originX,
+                                                                     FLOAT originY) noexcept
+{
+    return _DrawGlyphRuns(clientDrawingContext, renderer, { originX, originY });
+}
+
+// Routine Description:
+// - Exchanges the text and its shaped glyphs with the given ones. This is how
+//   text shaped by another layout is handed over to be drawn by this one.
+//   Only swapping (instead of copying) means that the buffers of both sides
+//   are reused the next time around.
+// Arguments:
+// - shaped - The shaped text to swap with ours
+// Return Value:
+// - <none>
+void CustomTextLayout::SwapShapedText(ShapedText& shaped) noexcept
+{
+    std::swap(_text, shaped.text);
+    std::swap(_textClusterColumns, shaped.textClusterColumns);
+    std::swap(_formatInUse, shaped.format);
+    std::swap(_runs, shaped.runs);
+    std::swap(_glyphOffsets, shaped.glyphOffsets);
+    std::swap(_glyphClusters, shaped.glyphClusters);
+    std::swap(_glyphIndices, shaped.glyphIndices);
+    std::swap(_glyphAdvances, shaped.glyphAdvances);
+}
+
+// Routine Description:
+// - Hashes everything the layout of the current text depends on:
+//   the text itself, the columns of its clusters, the text format and the cell width.
+// Arguments:
+// - <none> - Uses internal state
+// Return Value:
+// - The hash to look up the layout cache with.
+[[nodiscard]] size_t CustomTextLayout::_HashLayoutKey() const noexcept
+{
+    // Inspired by boost::hash_combine.
+    const auto combine = [](const size_t seed, const size_t value) noexcept {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    };
+
+    auto hash = std::hash<std::wstring_view>{}(_text);
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast. The columns are just hashed as a string of 16-bit code units.
+    const std::wstring_view columns{ reinterpret_cast<const wchar_t*>(_textClusterColumns.data()), _textClusterColumns.size() };
+    hash = combine(hash, std::hash<std::wstring_view>{}(columns));
+    hash = combine(hash, std::hash<const void*>{}(_formatInUse));
+    hash = combine(hash, _width);
+    return hash;
+}
+
+// Routine Description:
+// - Looks up the current text in the layout cache and if it's there,
+//   restores the runs and glyphs that were computed for it the last time.
+// Arguments:
+// - hash - The result of _HashLayoutKey() for the current text.
+// Return Value:
+// - true if the layout was restored and is ready to be drawn.
+[[nodiscard]] bool CustomTextLayout::_RestoreCachedLayout(const size_t hash)
+{
+    const auto it = _layoutCacheMap.find(hash);
+    if (it == _layoutCacheMap.end())
+    {
+        return false;
+    }
+
+    const auto& entry = *it->second;
+    const auto& shaped = entry.shaped;
+
+    // The hash is only a hint. Make sure it's really the same text.
+    if (shaped.text != _text ||
+        shaped.textClusterColumns != _textClusterColumns ||
+        shaped.format != _formatInUse ||
+        entry.width != _width)
+    {
+        return false;
+    }
+
+    // Move the entry to the front, since it's now the most recently used one.
+    _layoutCache.splice(_layoutCache.begin(), _layoutCache, it->second);
+
+    _runs = shaped.runs;
+    _glyphOffsets = shaped.glyphOffsets;
+    _glyphClusters = shaped.glyphClusters;
+    _glyphIndices = shaped.glyphIndices;
+    _glyphAdvances = shaped.glyphAdvances;
+    return true;
+}
+
+// Routine Description:
+// - Stores the runs and glyphs of the current text in the layout cache,
+//   evicting the least recently used entry if the cache is full.
+// Arguments:
+// - hash - The result of _HashLayoutKey() for the current text.
+// Return Value:
+// - <none>
+void CustomTextLayout::_StoreCachedLayout(const size_t hash)
+{
+    // If a different text collided with this hash, it gets replaced.
+    if (const auto it = _layoutCacheMap.find(hash); it != _layoutCacheMap.end())
+    {
+        _layoutCache.erase(it->second);
+        _layoutCacheMap.erase(it);
+    }
+
+    if (_layoutCache.size() >= _layoutCacheCapacity)
+    {
+        _layoutCacheMap.erase(_layoutCache.back().hash);
+        _layoutCache.pop_back();
+    }
+
+    _layoutCache.push_front({ hash,
+                              _width,
+                              { _text,
+                                _textClusterColumns,
+                                _formatInUse,
+                                _runs,
+                                _glyphOffsets,
+                                _glyphClusters,
+                                _glyphIndices,
+                                _glyphAdvances } });
+    _layoutCacheMap.emplace(hash, _layoutCache.begin());
+}
+
 // Routine Description:
 // - Uses the internal text information and the analyzers/font information from construction
 //   to determine the complexity of the text. If the text is determined to be entirely simple,
@@ -184,6 +380,24 @@ CATCH_RETURN()
     {
         const auto textLength = gsl::narrow<UINT32>(_text.size());
 
+        // Most of what's on a terminal is printable ASCII. If that's all this text is and it's
+        // simple in this face, we can look the glyphs up directly and not ask the analyzer.
+        if (const auto asciiGlyphs = _fontRenderData->AsciiGlyphIndices(_fontInUse))
+        {
+            const auto isAscii = std::all_of(_text.cbegin(), _text.cend(), [](const wchar_t wch) noexcept {
+                return wch >= DxFontRenderData::AsciiFirst && wch <= DxFontRenderData::AsciiLast;
+            });
+            if (isAscii)
+            {
+                _glyphIndices.resize(textLength);
+                std::transform(_text.cbegin(), _text.cend(), _glyphIndices.begin(), [&](const wchar_t wch) {
+                    return til::at(*asciiGlyphs, wch - DxFontRenderData::AsciiFirst);
+                });
+                _isEntireTextSimple = true;
+                return S_OK;
+            }
+        }
+
         BOOL isTextSimple = FALSE;
         UINT32 uiLengthRead = 0;
 
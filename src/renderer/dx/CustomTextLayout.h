@@ -21,6 +21,8 @@ namespace Microsoft::Console::Render
     public:
         // Based on the Windows 7 SDK sample at https://github.com/pauldotknopf/WindowsSDK7-Samples/tree/master/multimedia/DirectWrite/CustomLayout
 
+        struct ShapedText;
+
         CustomTextLayout(gsl::not_null<DxFontRenderData*> const fontRenderData);
 
         [[nodiscard]] HRESULT STDMETHODCALLTYPE AppendClusters(const gsl::span<const ::Microsoft::Console::Render::Cluster> clusters);
@@ -29,12 +31,23 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT STDMETHODCALLTYPE GetColumns(_Out_ UINT32* columns);
 
+        size_t GetCacheMemoryUsage() const noexcept;
+        void ClearCache() noexcept;
+
         // IDWriteTextLayout methods (but we don't actually want to implement them all, so just this one matching the existing interface)
         [[nodiscard]] HRESULT STDMETHODCALLTYPE Draw(_In_opt_ void* clientDrawingContext,
                                                      _In_ IDWriteTextRenderer* renderer,
                                                      FLOAT originX,
                                                      FLOAT originY) noexcept;
 
+        // Draw, split in two: the shaping half can run on any thread.
+        [[nodiscard]] HRESULT STDMETHODCALLTYPE Shape(const bool bold, const bool italic) noexcept;
+        [[nodiscard]] HRESULT STDMETHODCALLTYPE DrawShaped(_In_opt_ void* clientDrawingContext,
+                                                           _In_ IDWriteTextRenderer* renderer,
+                                                           FLOAT originX,
+                                                           FLOAT originY) noexcept;
+        void SwapShapedText(ShapedText& shaped) noexcept;
+
         // IDWriteTextAnalysisSource methods
         [[nodiscard]] HRESULT STDMETHODCALLTYPE GetTextAtPosition(UINT32 textPosition,
                                                                   _Outptr_result_buffer_(*textLength) WCHAR const** textString,
@@ -119,6 +132,22 @@ namespace Microsoft::Console::Render
             UINT32 nextRunIndex; // index of next run
         };
 
+    public:
+        // Some text, along with everything that shaping it turned out.
+        struct ShapedText
+        {
+            std::wstring text;
+            std::vector<UINT16> textClusterColumns;
+            IDWriteTextFormat* format{ nullptr };
+            std::vector<LinkedRun> runs;
+            std::vector<DWRITE_GLYPH_OFFSET> glyphOffsets;
+            std::vector<UINT16> glyphClusters;
+            std::vector<UINT16> glyphIndices;
+            std::vector<float> glyphAdvances;
+        };
+
+    protected:
+
         [[nodiscard]] LinkedRun& _FetchNextRun(UINT32& textLength);
         [[nodiscard]] LinkedRun& _GetCurrentRun();
         void _SetCurrentRun(const UINT32 textPosition);
@@ -148,6 +177,10 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] static constexpr UINT32 _EstimateGlyphCount(const UINT32 textLength) noexcept;
 
+        [[nodiscard]] size_t _HashLayoutKey() const noexcept;
+        [[nodiscard]] bool _RestoreCachedLayout(const size_t hash);
+        void _StoreCachedLayout(const size_t hash);
+
     private:
         // DirectWrite font render data
         DxFontRenderData* _fontRenderData;
@@ -206,6 +239,23 @@ namespace Microsoft::Console::Render
         // These are used to further break the runs apart and adjust the font size so glyphs fit inside the cells.
         std::vector<ScaleCorrection> _glyphScaleCorrections;
 
+        // Most rows look just the same as they did in the previous frame, so we keep the
+        // results of analyzing, shaping and correcting the most recently drawn texts around.
+        // Everything in here only depends on the text and the text format, since the font
+        // render data is fixed for the lifetime of this layout.
+        struct CachedLayout
+        {
+            size_t hash;
+            size_t width;
+            ShapedText shaped;
+        };
+
+        static constexpr size_t _layoutCacheCapacity{ 256 };
+
+        // The list is ordered from most to least recently used.
+        std::list<CachedLayout> _layoutCache;
+        std::unordered_map<size_t, std::list<CachedLayout>::iterator> _layoutCacheMap;
+
 #ifdef UNIT_TESTING
     public:
         CustomTextLayout() = default;
@@ -4,6 +4,7 @@
 #include "precomp.h"
 
 #include "CustomTextRenderer.h"
+#include "../../renderer/inc/FontResource.hpp"
 
 #include "../../inc/DefaultSettings.h"
 
@@ -13,6 +14,51 @@
 
 using namespace Microsoft::Console::Render;
 
+// The renderer maps the characters of a soft font to this and the following
+// private use characters. See Renderer::UpdateSoftFont.
+static constexpr wchar_t s_firstSoftFontChar = L'\xEF20';
+
+// Routine Description:
+// - Adds up the memory held by the cache of color glyph runs. The font faces
+//   are owned by the font render data, so they aren't counted.
+// Arguments:
+// - <none>
+// Return Value:
+// - The size of the cache, in bytes.
+size_t CustomTextRenderer::GetCacheMemoryUsage() const noexcept
+{
+    size_t usage = _colorGlyphCacheMap.bucket_count() * sizeof(void*) + _colorGlyphCacheMap.size() * (sizeof(decltype(_colorGlyphCacheMap)::value_type) + 2 * sizeof(void*));
+    for (const auto& entry : _colorGlyphCache)
+    {
+        usage += sizeof(entry) + 2 * sizeof(void*);
+        usage += entry.glyphIndices.capacity() * sizeof(UINT16);
+        usage += entry.glyphAdvances.capacity() * sizeof(float);
+        usage += entry.glyphOffsets.capacity() * sizeof(DWRITE_GLYPH_OFFSET);
+        usage += entry.layers.capacity() * sizeof(ColorGlyphLayer);
+        for (const auto& layer : entry.layers)
+        {
+            usage += layer.glyphIndices.capacity() * sizeof(UINT16);
+            usage += layer.glyphAdvances.capacity() * sizeof(float);
+            usage += layer.glyphOffsets.capacity() * sizeof(DWRITE_GLYPH_OFFSET);
+            usage += (layer.localeName.capacity() + layer.text.capacity()) * sizeof(wchar_t);
+            usage += layer.clusterMap.capacity() * sizeof(UINT16);
+        }
+    }
+    return usage;
+}
+
+// Routine Description:
+// - Drops the cache of color glyph runs, for when the engine is idle.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void CustomTextRenderer::ClearCache() noexcept
+{
+    _colorGlyphCacheMap.clear();
+    _colorGlyphCache.clear();
+}
+
 #pragma region IDWritePixelSnapping methods
 // Routine Description:
 // - Implementation of IDWritePixelSnapping::IsPixelSnappingDisabled
@@ -593,42 +639,28 @@ CATCH_RETURN()
     }
     // Now go onto drawing the text.
 
+    // The soft font isn't part of any font DirectWrite knows about. Its glyphs
+    // come from the atlas that was uploaded when the soft font last changed.
+    if (drawingContext->useSoftFont && _DrawSoftFontGlyphs(drawingContext, d2dContext.Get(), rect, glyphRun, glyphRunDescription))
+    {
+        RETURN_IF_FAILED(_drawCursor(d2dContext.Get(), rect, *drawingContext, false));
+        return S_OK;
+    }
+
     // First check if we want a color font and try to extract color emoji first.
     // Color emoji are only available on Windows 10+
     static const bool s_isWindows10OrGreater = IsWindows10OrGreater();
     if (WI_IsFlagSet(drawingContext->options, D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT) && s_isWindows10OrGreater)
     {
-        ::Microsoft::WRL::ComPtr<ID2D1DeviceContext4> d2dContext4;
-        RETURN_IF_FAILED(d2dContext.As(&d2dContext4));
-
-        ::Microsoft::WRL::ComPtr<IDWriteFactory4> dwriteFactory4;
-        RETURN_IF_FAILED(drawingContext->dwriteFactory->QueryInterface(dwriteFactory4.GetAddressOf()));
-
-        // The list of glyph image formats this renderer is prepared to support.
-        const DWRITE_GLYPH_IMAGE_FORMATS supportedFormats =
-            DWRITE_GLYPH_IMAGE_FORMATS_TRUETYPE |
-            DWRITE_GLYPH_IMAGE_FORMATS_CFF |
-            DWRITE_GLYPH_IMAGE_FORMATS_COLR |
-            DWRITE_GLYPH_IMAGE_FORMATS_SVG |
-            DWRITE_GLYPH_IMAGE_FORMATS_PNG |
-            DWRITE_GLYPH_IMAGE_FORMATS_JPEG |
-            DWRITE_GLYPH_IMAGE_FORMATS_TIFF |
-            DWRITE_GLYPH_IMAGE_FORMATS_PREMULTIPLIED_B8G8R8A8;
-
-        // Determine whether there are any color glyph runs within glyphRun. If
-        // there are, glyphRunEnumerator can be used to iterate through them.
-        ::Microsoft::WRL::ComPtr<IDWriteColorGlyphRunEnumerator1> glyphRunEnumerator;
-        const HRESULT hr = dwriteFactory4->TranslateColorGlyphRun(baselineOrigin,
-                                                                  glyphRun,
-                                                                  glyphRunDescription,
-                                                                  supportedFormats,
-                                                                  measuringMode,
-                                                                  nullptr,
-                                                                  0,
-                                                                  &glyphRunEnumerator);
+        const auto hash = _HashColorGlyphRun(glyphRun, measuringMode);
+        auto cached = _FindCachedColorGlyphRun(hash, glyphRun, measuringMode);
+        if (!cached)
+        {
+            RETURN_IF_FAILED(_TranslateColorGlyphRun(drawingContext, baselineOrigin, measuringMode, glyphRun, glyphRunDescription, hash, cached));
+        }
 
         // If the analysis found no color glyphs in the run, just draw normally.
-        if (hr == DWRITE_E_NOCOLOR)
+        if (cached->layers.empty())
         {
             RETURN_IF_FAILED(_DrawBasicGlyphRun(drawingContext,
                                                 baselineOrigin,
@@ -640,93 +672,7 @@ CATCH_RETURN()
         }
         else
         {
-            RETURN_IF_FAILED(hr);
-
-            ::Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> tempBrush;
-
-            // Complex case: the run has one or more color runs within it. Iterate
-            // over the sub-runs and draw them, depending on their format.
-            for (;;)
-            {
-                BOOL haveRun;
-                RETURN_IF_FAILED(glyphRunEnumerator->MoveNext(&haveRun));
-                if (!haveRun)
-                    break;
-
-                DWRITE_COLOR_GLYPH_RUN1 const* colorRun;
-                RETURN_IF_FAILED(glyphRunEnumerator->GetCurrentRun(&colorRun));
-
-                const D2D1_POINT_2F currentBaselineOrigin = D2D1::Point2F(colorRun->baselineOriginX, colorRun->baselineOriginY);
-
-                switch (colorRun->glyphImageFormat)
-                {
-                case DWRITE_GLYPH_IMAGE_FORMATS_PNG:
-                case DWRITE_GLYPH_IMAGE_FORMATS_JPEG:
-                case DWRITE_GLYPH_IMAGE_FORMATS_TIFF:
-                case DWRITE_GLYPH_IMAGE_FORMATS_PREMULTIPLIED_B8G8R8A8:
-                {
-                    // This run is bitmap glyphs. Use Direct2D to draw them.
-                    d2dContext4->DrawColorBitmapGlyphRun(colorRun->glyphImageFormat,
-                                                         currentBaselineOrigin,
-                                                         &colorRun->glyphRun,
-                                                         measuringMode);
-                }
-                break;
-
-                case DWRITE_GLYPH_IMAGE_FORMATS_SVG:
-                {
-                    // This run is SVG glyphs. Use Direct2D to draw them.
-                    d2dContext4->DrawSvgGlyphRun(currentBaselineOrigin,
-                                                 &colorRun->glyphRun,
-                                                 drawingContext->foregroundBrush,
-                                                 nullptr, // svgGlyphStyle
-                                                 0, // colorPaletteIndex
-                                                 measuringMode);
-                }
-                break;
-
-                case DWRITE_GLYPH_IMAGE_FORMATS_TRUETYPE:
-                case DWRITE_GLYPH_IMAGE_FORMATS_CFF:
-                case DWRITE_GLYPH_IMAGE_FORMATS_COLR:
-                default:
-                {
-                    // This run is solid-color outlines, either from non-color
-                    // glyphs or from COLR glyph layers. Use Direct2D to draw them.
-
-                    ID2D1Brush* layerBrush{ nullptr };
-                    // The rule is "if 0xffff, use current brush." See:
-                    // https://docs.microsoft.com/en-us/windows/desktop/api/dwrite_2/ns-dwrite_2-dwrite_color_glyph_run
-                    if (colorRun->paletteIndex == 0xFFFF)
-                    {
-                        // This run uses the current text color.
-                        layerBrush = drawingContext->foregroundBrush;
-                    }
-                    else
-                    {
-                        if (!tempBrush)
-                        {
-                            RETURN_IF_FAILED(d2dContext4->CreateSolidColorBrush(colorRun->runColor, &tempBrush));
-                        }
-                        else
-                        {
-                            // This run specifies its own color.
-                            tempBrush->SetColor(colorRun->runColor);
-                        }
-                        layerBrush = tempBrush.Get();
-                    }
-
-                    // Draw the run with the selected color.
-                    RETURN_IF_FAILED(_DrawBasicGlyphRun(drawingContext,
-                                                        currentBaselineOrigin,
-                                                        measuringMode,
-                                                        &colorRun->glyphRun,
-                                                        colorRun->glyphRunDescription,
-                                                        layerBrush,
-                                                        clientDrawingEffect));
-                }
-                break;
-                }
-            }
+            RETURN_IF_FAILED(_DrawColorGlyphLayers(drawingContext, d2dContext.Get(), baselineOrigin, measuringMode, cached->layers, clientDrawingEffect));
         }
     }
     else
@@ -764,6 +710,337 @@ try
 }
 CATCH_RETURN()
 
+// Copies an array of a glyph run, which may be null, into a vector.
+template<typename T>
+static std::vector<T> _CopyGlyphRunArray(_In_opt_ const T* data, const UINT32 count)
+{
+    return data ? std::vector<T>(data, data + count) : std::vector<T>{};
+}
+
+// Checks if a copy made by _CopyGlyphRunArray holds the same as the array.
+template<typename T, typename Equal>
+static bool _SameGlyphRunArray(const std::vector<T>& copy, _In_opt_ const T* data, const UINT32 count, Equal&& equal) noexcept
+{
+    if (!data)
+    {
+        return copy.empty();
+    }
+    return copy.size() == count && std::equal(copy.begin(), copy.end(), data, std::forward<Equal>(equal));
+}
+
+// Routine Description:
+// - Hashes everything the color layers of a glyph run depend on:
+//   the font face and its size, the glyphs and their positions.
+// Arguments:
+// - glyphRun - The glyph run to hash
+// - measuringMode - The mode the glyphs are measured in
+// Return Value:
+// - The hash to look up the color glyph cache with.
+[[nodiscard]] size_t CustomTextRenderer::_HashColorGlyphRun(_In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                            DWRITE_MEASURING_MODE measuringMode) noexcept
+{
+    // Inspired by boost::hash_combine.
+    const auto combine = [](const size_t seed, const size_t value) noexcept {
+        return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    };
+
+    auto hash = std::hash<const void*>{}(glyphRun->fontFace);
+    hash = combine(hash, std::hash<float>{}(glyphRun->fontEmSize));
+    hash = combine(hash, gsl::narrow_cast<size_t>(measuringMode));
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast. The glyph indices are just hashed as a string of 16-bit code units.
+    const std::wstring_view glyphs{ reinterpret_cast<const wchar_t*>(glyphRun->glyphIndices), glyphRun->glyphCount };
+    hash = combine(hash, std::hash<std::wstring_view>{}(glyphs));
+    if (glyphRun->glyphAdvances)
+    {
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast. The advances are just hashed as a string of bytes.
+        const std::string_view advances{ reinterpret_cast<const char*>(glyphRun->glyphAdvances), glyphRun->glyphCount * sizeof(FLOAT) };
+        hash = combine(hash, std::hash<std::string_view>{}(advances));
+    }
+    return hash;
+}
+
+// Routine Description:
+// - Looks up the color layers of a glyph run in the cache.
+// Arguments:
+// - hash - The result of _HashColorGlyphRun() for the glyph run.
+// - glyphRun - The glyph run to look up
+// - measuringMode - The mode the glyphs are measured in
+// Return Value:
+// - The cached layers, or nullptr if the run wasn't translated recently.
+[[nodiscard]] const CustomTextRenderer::CachedColorGlyphRun* CustomTextRenderer::_FindCachedColorGlyphRun(const size_t hash,
+                                                                                                        _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                                                                        DWRITE_MEASURING_MODE measuringMode) noexcept
+{
+    const auto it = _colorGlyphCacheMap.find(hash);
+    if (it == _colorGlyphCacheMap.end())
+    {
+        return nullptr;
+    }
+
+    const auto& entry = *it->second;
+
+    // The hash is only a hint. Make sure it's really the same run.
+    const auto sameOffset = [](const DWRITE_GLYPH_OFFSET& a, const DWRITE_GLYPH_OFFSET& b) noexcept {
+        return a.advanceOffset == b.advanceOffset && a.ascenderOffset == b.ascenderOffset;
+    };
+    if (entry.fontFace.Get() != glyphRun->fontFace ||
+        entry.fontEmSize != glyphRun->fontEmSize ||
+        entry.isSideways != glyphRun->isSideways ||
+        entry.bidiLevel != glyphRun->bidiLevel ||
+        entry.measuringMode != measuringMode ||
+        !_SameGlyphRunArray(entry.glyphIndices, glyphRun->glyphIndices, glyphRun->glyphCount, std::equal_to<>{}) ||
+        !_SameGlyphRunArray(entry.glyphAdvances, glyphRun->glyphAdvances, glyphRun->glyphCount, std::equal_to<>{}) ||
+        !_SameGlyphRunArray(entry.glyphOffsets, glyphRun->glyphOffsets, glyphRun->glyphCount, sameOffset))
+    {
+        return nullptr;
+    }
+
+    // Move the entry to the front, since it's now the most recently used one.
+    _colorGlyphCache.splice(_colorGlyphCache.begin(), _colorGlyphCache, it->second);
+    return &entry;
+}
+
+// Routine Description:
+// - Splits a glyph run into its color layers with TranslateColorGlyphRun,
+//   and stores them in the cache, evicting the least recently used entry
+//   if the cache is full.
+// Arguments:
+// - clientDrawingContext - Pointer to structure of information required to draw
+// - baselineOrigin - The origin of the run's baseline
+// - measuringMode - The mode the glyphs are measured in
+// - glyphRun - Information on the glyphs
+// - glyphRunDescription - Further metadata about the glyphs
+// - hash - The result of _HashColorGlyphRun() for the glyph run.
+// - result - Receives the new cache entry. It has no layers if the run has no color glyphs.
+// Return Value:
+// - S_OK or appropriate DirectWrite based error.
+[[nodiscard]] HRESULT CustomTextRenderer::_TranslateColorGlyphRun(DrawingContext* clientDrawingContext,
+                                                                  D2D1_POINT_2F baselineOrigin,
+                                                                  DWRITE_MEASURING_MODE measuringMode,
+                                                                  _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                                  _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription,
+                                                                  const size_t hash,
+                                                                  const CachedColorGlyphRun*& result) noexcept
+try
+{
+    ::Microsoft::WRL::ComPtr<IDWriteFactory4> dwriteFactory4;
+    RETURN_IF_FAILED(clientDrawingContext->dwriteFactory->QueryInterface(dwriteFactory4.GetAddressOf()));
+
+    // The list of glyph image formats this renderer is prepared to support.
+    const DWRITE_GLYPH_IMAGE_FORMATS supportedFormats =
+        DWRITE_GLYPH_IMAGE_FORMATS_TRUETYPE |
+        DWRITE_GLYPH_IMAGE_FORMATS_CFF |
+        DWRITE_GLYPH_IMAGE_FORMATS_COLR |
+        DWRITE_GLYPH_IMAGE_FORMATS_SVG |
+        DWRITE_GLYPH_IMAGE_FORMATS_PNG |
+        DWRITE_GLYPH_IMAGE_FORMATS_JPEG |
+        DWRITE_GLYPH_IMAGE_FORMATS_TIFF |
+        DWRITE_GLYPH_IMAGE_FORMATS_PREMULTIPLIED_B8G8R8A8;
+
+    // Determine whether there are any color glyph runs within glyphRun. If
+    // there are, glyphRunEnumerator can be used to iterate through them.
+    ::Microsoft::WRL::ComPtr<IDWriteColorGlyphRunEnumerator1> glyphRunEnumerator;
+    const HRESULT hr = dwriteFactory4->TranslateColorGlyphRun(baselineOrigin,
+                                                              glyphRun,
+                                                              glyphRunDescription,
+                                                              supportedFormats,
+                                                              measuringMode,
+                                                              nullptr,
+                                                              0,
+                                                              &glyphRunEnumerator);
+
+    std::vector<ColorGlyphLayer> layers;
+    if (hr != DWRITE_E_NOCOLOR)
+    {
+        RETURN_IF_FAILED(hr);
+
+        for (;;)
+        {
+            BOOL haveRun;
+            RETURN_IF_FAILED(glyphRunEnumerator->MoveNext(&haveRun));
+            if (!haveRun)
+                break;
+
+            DWRITE_COLOR_GLYPH_RUN1 const* colorRun;
+            RETURN_IF_FAILED(glyphRunEnumerator->GetCurrentRun(&colorRun));
+
+            const auto& run = colorRun->glyphRun;
+            const auto description = colorRun->glyphRunDescription;
+
+            auto& layer = layers.emplace_back();
+            layer.glyphImageFormat = colorRun->glyphImageFormat;
+            layer.baselineOffset = { colorRun->baselineOriginX - baselineOrigin.x, colorRun->baselineOriginY - baselineOrigin.y };
+            layer.fontFace = run.fontFace;
+            layer.fontEmSize = run.fontEmSize;
+            layer.isSideways = run.isSideways;
+            layer.bidiLevel = run.bidiLevel;
+            layer.glyphIndices = _CopyGlyphRunArray(run.glyphIndices, run.glyphCount);
+            layer.glyphAdvances = _CopyGlyphRunArray(run.glyphAdvances, run.glyphCount);
+            layer.glyphOffsets = _CopyGlyphRunArray(run.glyphOffsets, run.glyphCount);
+            layer.hasDescription = description != nullptr;
+            if (description)
+            {
+                layer.localeName = description->localeName ? description->localeName : L"";
+                layer.text.assign(description->string, description->stringLength);
+                layer.clusterMap = _CopyGlyphRunArray(description->clusterMap, description->stringLength);
+                layer.textPosition = description->textPosition;
+            }
+            layer.paletteIndex = colorRun->paletteIndex;
+            layer.runColor = colorRun->runColor;
+        }
+    }
+
+    // If a different run collided with this hash, it gets replaced.
+    if (const auto it = _colorGlyphCacheMap.find(hash); it != _colorGlyphCacheMap.end())
+    {
+        _colorGlyphCache.erase(it->second);
+        _colorGlyphCacheMap.erase(it);
+    }
+
+    if (_colorGlyphCache.size() >= _colorGlyphCacheCapacity)
+    {
+        _colorGlyphCacheMap.erase(_colorGlyphCache.back().hash);
+        _colorGlyphCache.pop_back();
+    }
+
+    _colorGlyphCache.push_front({ hash,
+                                  glyphRun->fontFace,
+                                  glyphRun->fontEmSize,
+                                  glyphRun->isSideways,
+                                  glyphRun->bidiLevel,
+                                  measuringMode,
+                                  _CopyGlyphRunArray(glyphRun->glyphIndices, glyphRun->glyphCount),
+                                  _CopyGlyphRunArray(glyphRun->glyphAdvances, glyphRun->glyphCount),
+                                  _CopyGlyphRunArray(glyphRun->glyphOffsets, glyphRun->glyphCount),
+                                  std::move(layers) });
+    _colorGlyphCacheMap.emplace(hash, _colorGlyphCache.begin());
+
+    result = &_colorGlyphCache.front();
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Draws the color layers of a glyph run, depending on their format.
+// Arguments:
+// - clientDrawingContext - Pointer to structure of information required to draw
+// - d2dContext - The context to draw with
+// - baselineOrigin - The origin of the run's baseline
+// - measuringMode - The mode the glyphs are measured in
+// - layers - The layers, as translated by _TranslateColorGlyphRun
+// - clientDrawingEffect - any special effect passed along for rendering
+// Return Value:
+// - S_OK or appropriate Direct2D based error.
+[[nodiscard]] HRESULT CustomTextRenderer::_DrawColorGlyphLayers(DrawingContext* clientDrawingContext,
+                                                                ID2D1DeviceContext* d2dContext,
+                                                                D2D1_POINT_2F baselineOrigin,
+                                                                DWRITE_MEASURING_MODE measuringMode,
+                                                                const std::vector<ColorGlyphLayer>& layers,
+                                                                _In_opt_ IUnknown* clientDrawingEffect) noexcept
+try
+{
+    ::Microsoft::WRL::ComPtr<ID2D1DeviceContext4> d2dContext4;
+    RETURN_IF_FAILED(d2dContext->QueryInterface(d2dContext4.GetAddressOf()));
+
+    ::Microsoft::WRL::ComPtr<ID2D1SolidColorBrush> tempBrush;
+
+    for (const auto& layer : layers)
+    {
+        const DWRITE_GLYPH_RUN glyphRun{
+            layer.fontFace.Get(),
+            layer.fontEmSize,
+            gsl::narrow_cast<UINT32>(layer.glyphIndices.size()),
+            layer.glyphIndices.data(),
+            layer.glyphAdvances.empty() ? nullptr : layer.glyphAdvances.data(),
+            layer.glyphOffsets.empty() ? nullptr : layer.glyphOffsets.data(),
+            layer.isSideways,
+            layer.bidiLevel,
+        };
+        const DWRITE_GLYPH_RUN_DESCRIPTION description{
+            layer.localeName.c_str(),
+            layer.text.c_str(),
+            gsl::narrow_cast<UINT32>(layer.text.size()),
+            layer.clusterMap.empty() ? nullptr : layer.clusterMap.data(),
+            layer.textPosition,
+        };
+        const auto glyphRunDescription = layer.hasDescription ? &description : nullptr;
+
+        const D2D1_POINT_2F currentBaselineOrigin{ baselineOrigin.x + layer.baselineOffset.x, baselineOrigin.y + layer.baselineOffset.y };
+
+        switch (layer.glyphImageFormat)
+        {
+        case DWRITE_GLYPH_IMAGE_FORMATS_PNG:
+        case DWRITE_GLYPH_IMAGE_FORMATS_JPEG:
+        case DWRITE_GLYPH_IMAGE_FORMATS_TIFF:
+        case DWRITE_GLYPH_IMAGE_FORMATS_PREMULTIPLIED_B8G8R8A8:
+        {
+            // This run is bitmap glyphs. Use Direct2D to draw them.
+            d2dContext4->DrawColorBitmapGlyphRun(layer.glyphImageFormat,
+                                                 currentBaselineOrigin,
+                                                 &glyphRun,
+                                                 measuringMode);
+        }
+        break;
+
+        case DWRITE_GLYPH_IMAGE_FORMATS_SVG:
+        {
+            // This run is SVG glyphs. Use Direct2D to draw them.
+            d2dContext4->DrawSvgGlyphRun(currentBaselineOrigin,
+                                         &glyphRun,
+                                         clientDrawingContext->foregroundBrush,
+                                         nullptr, // svgGlyphStyle
+                                         0, // colorPaletteIndex
+                                         measuringMode);
+        }
+        break;
+
+        case DWRITE_GLYPH_IMAGE_FORMATS_TRUETYPE:
+        case DWRITE_GLYPH_IMAGE_FORMATS_CFF:
+        case DWRITE_GLYPH_IMAGE_FORMATS_COLR:
+        default:
+        {
+            // This run is solid-color outlines, either from non-color
+            // glyphs or from COLR glyph layers. Use Direct2D to draw them.
+
+            ID2D1Brush* layerBrush{ nullptr };
+            // The rule is "if 0xffff, use current brush." See:
+            // https://docs.microsoft.com/en-us/windows/desktop/api/dwrite_2/ns-dwrite_2-dwrite_color_glyph_run
+            if (layer.paletteIndex == 0xFFFF)
+            {
+                // This run uses the current text color.
+                layerBrush = clientDrawingContext->foregroundBrush;
+            }
+            else
+            {
+                if (!tempBrush)
+                {
+                    RETURN_IF_FAILED(d2dContext4->CreateSolidColorBrush(layer.runColor, &tempBrush));
+                }
+                else
+                {
+                    // This run specifies its own color.
+                    tempBrush->SetColor(layer.runColor);
+                }
+                layerBrush = tempBrush.Get();
+            }
+
+            // Draw the run with the selected color.
+            RETURN_IF_FAILED(_DrawBasicGlyphRun(clientDrawingContext,
+                                                currentBaselineOrigin,
+                                                measuringMode,
+                                                &glyphRun,
+                                                glyphRunDescription,
+                                                layerBrush,
+                                                clientDrawingEffect));
+        }
+        break;
+        }
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
 [[nodiscard]] HRESULT CustomTextRenderer::_DrawBasicGlyphRun(DrawingContext* clientDrawingContext,
                                                              D2D1_POINT_2F baselineOrigin,
                                                              DWRITE_MEASURING_MODE measuringMode,
@@ -804,7 +1081,7 @@ CATCH_RETURN()
                                                               D2D1_POINT_2F baselineOrigin,
                                                               DWRITE_MEASURING_MODE /*measuringMode*/,
                                                               _In_ const DWRITE_GLYPH_RUN* glyphRun,
-                                                              _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* /*glyphRunDescription*/,
+                                                              _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription,
                                                               _In_ IBoxDrawingEffect* clientDrawingEffect) noexcept
 try
 {
@@ -812,6 +1089,13 @@ try
     RETURN_HR_IF_NULL(E_INVALIDARG, glyphRun);
     RETURN_HR_IF_NULL(E_INVALIDARG, clientDrawingEffect);
 
+    // Most box drawing characters don't need the font at all. If we can draw
+    // every glyph of this run ourselves, skip building its outline.
+    if (_DrawBuiltinBoxGlyphs(clientDrawingContext, baselineOrigin, glyphRun, glyphRunDescription))
+    {
+        return S_OK;
+    }
+
     ::Microsoft::WRL::ComPtr<ID2D1Factory> d2dFactory;
     clientDrawingContext->renderTarget->GetFactory(d2dFactory.GetAddressOf());
 
@@ -918,6 +1202,123 @@ try
 }
 CATCH_RETURN();
 
+// Routine Description:
+// - Draws a run of box drawing characters from the rectangles in the drawing
+//   context's BoxGlyphs, if it has them for every character in the run.
+// Arguments:
+// - clientDrawingContext - the drawing context, with the brush and the glyphs
+// - baselineOrigin - the baseline of the first glyph
+// - glyphRun - the glyphs, for their advances
+// - glyphRunDescription - the text of the run
+// Return Value:
+// - True if the run was drawn, false if it has to be drawn from the font.
+bool CustomTextRenderer::_DrawBuiltinBoxGlyphs(DrawingContext* clientDrawingContext,
+                                               const D2D1_POINT_2F baselineOrigin,
+                                               _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                               _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept
+{
+    const auto boxGlyphs = clientDrawingContext->boxGlyphs;
+    if (!boxGlyphs ||
+        !glyphRunDescription ||
+        !glyphRunDescription->string ||
+        glyphRunDescription->stringLength != glyphRun->glyphCount ||
+        glyphRun->bidiLevel % 2)
+    {
+        return false;
+    }
+
+    const std::wstring_view text{ glyphRunDescription->string, glyphRunDescription->stringLength };
+    if (!std::all_of(text.begin(), text.end(), [&](const wchar_t wch) { return !boxGlyphs->Lookup(wch).empty(); }))
+    {
+        return false;
+    }
+
+    const auto brush = clientDrawingContext->foregroundBrush;
+    const auto opacity = brush->GetOpacity();
+    const auto top = std::round(baselineOrigin.y - clientDrawingContext->spacing.baseline);
+    auto x = baselineOrigin.x;
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        const auto left = std::round(x);
+        for (const auto& rect : boxGlyphs->Lookup(til::at(text, i)))
+        {
+            brush->SetOpacity(opacity * rect.opacity);
+            clientDrawingContext->renderTarget->FillRectangle(D2D1::RectF(left + rect.rect.left,
+                                                                          top + rect.rect.top,
+                                                                          left + rect.rect.right,
+                                                                          top + rect.rect.bottom),
+                                                              brush);
+        }
+
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+        x += glyphRun->glyphAdvances ? glyphRun->glyphAdvances[i] : clientDrawingContext->cellSize.width;
+    }
+
+    brush->SetOpacity(opacity);
+    return true;
+}
+
+// Routine Description:
+// - Draws a run of soft font characters from the soft font atlas, one cell
+//   sized piece of the alpha mask per character, in the foreground color.
+// Arguments:
+// - clientDrawingContext - the drawing context, with the soft font atlas
+// - d2dContext - the device context to draw to
+// - runRect - the cells the run covers
+// - glyphRun - the run, for its advances
+// - glyphRunDescription - the run's characters
+// Return Value:
+// - false if the run can't be drawn from the atlas, and has to be drawn
+//   from the font instead.
+bool CustomTextRenderer::_DrawSoftFontGlyphs(DrawingContext* clientDrawingContext,
+                                             ID2D1DeviceContext* d2dContext,
+                                             const D2D1_RECT_F& runRect,
+                                             _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                             _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept
+{
+    const auto atlas = clientDrawingContext->softFontAtlas;
+    if (!atlas ||
+        !glyphRunDescription ||
+        !glyphRunDescription->string ||
+        glyphRunDescription->stringLength != glyphRun->glyphCount ||
+        glyphRun->bidiLevel % 2)
+    {
+        return false;
+    }
+
+    // Opacity masks can only be filled with aliased antialiasing.
+    const auto antialiasMode = d2dContext->GetAntialiasMode();
+    d2dContext->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+
+    const std::wstring_view text{ glyphRunDescription->string, glyphRunDescription->stringLength };
+    const auto cell = clientDrawingContext->cellSize;
+    const auto top = std::round(runRect.top);
+    auto x = runRect.left;
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        // Anything outside of the soft font is left blank.
+        const auto wch = til::at(text, i);
+        if (wch >= s_firstSoftFontChar && wch < s_firstSoftFontChar + FontResource::CharCount)
+        {
+            const size_t index = wch - s_firstSoftFontChar;
+            const auto sourceX = (index % FontResource::AtlasColumns) * cell.width;
+            const auto sourceY = (index / FontResource::AtlasColumns) * cell.height;
+            const auto left = std::round(x);
+            const auto source = D2D1::RectF(sourceX, sourceY, sourceX + cell.width, sourceY + cell.height);
+            const auto destination = D2D1::RectF(left, top, left + cell.width, top + cell.height);
+            d2dContext->FillOpacityMask(atlas, clientDrawingContext->foregroundBrush, destination, source);
+        }
+
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+        x += glyphRun->glyphAdvances ? glyphRun->glyphAdvances[i] : cell.width;
+    }
+
+    d2dContext->SetAntialiasMode(antialiasMode);
+    return true;
+}
+
 [[nodiscard]] HRESULT CustomTextRenderer::_DrawGlowGlyphRun(DrawingContext* clientDrawingContext,
                                                             D2D1_POINT_2F baselineOrigin,
                                                             DWRITE_MEASURING_MODE /*measuringMode*/,
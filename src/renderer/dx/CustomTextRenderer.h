@@ -5,6 +5,7 @@
 
 #include <wrl/implements.h>
 #include "BoxDrawingEffect.h"
+#include "BoxGlyphs.h"
 #include "../../renderer/inc/CursorOptions.h"
 
 namespace Microsoft::Console::Render
@@ -48,6 +49,9 @@ namespace Microsoft::Console::Render
         D2D_SIZE_F targetSize;
         std::optional<CursorOptions> cursorInfo;
         D2D1_DRAW_TEXT_OPTIONS options;
+        const BoxGlyphs* boxGlyphs{ nullptr };
+        ID2D1Bitmap* softFontAtlas{ nullptr };
+        bool useSoftFont{ false };
     };
 
     // Helper to choose which Direct2D method to use when drawing the cursor rectangle
@@ -67,6 +71,9 @@ namespace Microsoft::Console::Render
         // http://www.charlespetzold.com/blog/2014/01/Character-Formatting-Extensions-with-DirectWrite.html
         // https://docs.microsoft.com/en-us/windows/desktop/DirectWrite/how-to-implement-a-custom-text-renderer
 
+        size_t GetCacheMemoryUsage() const noexcept;
+        void ClearCache() noexcept;
+
         // IDWritePixelSnapping methods
         [[nodiscard]] HRESULT STDMETHODCALLTYPE IsPixelSnappingDisabled(void* clientDrawingContext,
                                                                         _Out_ BOOL* isDisabled) noexcept override;
@@ -133,12 +140,95 @@ namespace Microsoft::Console::Render
                                                   _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription,
                                                   _In_ IBoxDrawingEffect* clientDrawingEffect) noexcept;
 
+        static bool _DrawBuiltinBoxGlyphs(DrawingContext* clientDrawingContext,
+                                          const D2D1_POINT_2F baselineOrigin,
+                                          _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                          _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept;
+
+        static bool _DrawSoftFontGlyphs(DrawingContext* clientDrawingContext,
+                                        ID2D1DeviceContext* d2dContext,
+                                        const D2D1_RECT_F& runRect,
+                                        _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                        _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept;
+
         [[nodiscard]] HRESULT _DrawGlowGlyphRun(DrawingContext* clientDrawingContext,
                                                 D2D1_POINT_2F baselineOrigin,
                                                 DWRITE_MEASURING_MODE measuringMode,
                                                 _In_ const DWRITE_GLYPH_RUN* glyphRun,
                                                 _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription) noexcept;
 
+        // One of the layers TranslateColorGlyphRun splits a glyph run into,
+        // with copies of everything the layer's glyph run points to.
+        struct ColorGlyphLayer
+        {
+            DWRITE_GLYPH_IMAGE_FORMATS glyphImageFormat;
+            // Relative to the baseline origin of the whole run.
+            D2D1_POINT_2F baselineOffset;
+            ::Microsoft::WRL::ComPtr<IDWriteFontFace> fontFace;
+            float fontEmSize;
+            BOOL isSideways;
+            UINT32 bidiLevel;
+            std::vector<UINT16> glyphIndices;
+            std::vector<float> glyphAdvances;
+            std::vector<DWRITE_GLYPH_OFFSET> glyphOffsets;
+            bool hasDescription;
+            std::wstring localeName;
+            std::wstring text;
+            std::vector<UINT16> clusterMap;
+            UINT32 textPosition;
+            UINT16 paletteIndex;
+            DWRITE_COLOR_F runColor;
+        };
+
+        // Emoji in prompts are drawn again on every frame, and decomposing
+        // them into their color layers is expensive. Just like CustomTextLayout
+        // does with its layouts, the layers of the most recently drawn runs
+        // are kept around. Runs without color glyphs are kept as well (with no
+        // layers), so that plain text isn't translated over and over either.
+        // Runs are always translated with color palette 0, so the palette
+        // isn't part of the key.
+        struct CachedColorGlyphRun
+        {
+            size_t hash;
+            ::Microsoft::WRL::ComPtr<IDWriteFontFace> fontFace;
+            float fontEmSize;
+            BOOL isSideways;
+            UINT32 bidiLevel;
+            DWRITE_MEASURING_MODE measuringMode;
+            std::vector<UINT16> glyphIndices;
+            std::vector<float> glyphAdvances;
+            std::vector<DWRITE_GLYPH_OFFSET> glyphOffsets;
+            std::vector<ColorGlyphLayer> layers;
+        };
+
+        [[nodiscard]] static size_t _HashColorGlyphRun(_In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                       DWRITE_MEASURING_MODE measuringMode) noexcept;
+
+        [[nodiscard]] const CachedColorGlyphRun* _FindCachedColorGlyphRun(const size_t hash,
+                                                                          _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                                          DWRITE_MEASURING_MODE measuringMode) noexcept;
+
+        [[nodiscard]] HRESULT _TranslateColorGlyphRun(DrawingContext* clientDrawingContext,
+                                                      D2D1_POINT_2F baselineOrigin,
+                                                      DWRITE_MEASURING_MODE measuringMode,
+                                                      _In_ const DWRITE_GLYPH_RUN* glyphRun,
+                                                      _In_opt_ const DWRITE_GLYPH_RUN_DESCRIPTION* glyphRunDescription,
+                                                      const size_t hash,
+                                                      const CachedColorGlyphRun*& result) noexcept;
+
+        [[nodiscard]] HRESULT _DrawColorGlyphLayers(DrawingContext* clientDrawingContext,
+                                                    ID2D1DeviceContext* d2dContext,
+                                                    D2D1_POINT_2F baselineOrigin,
+                                                    DWRITE_MEASURING_MODE measuringMode,
+                                                    const std::vector<ColorGlyphLayer>& layers,
+                                                    _In_opt_ IUnknown* clientDrawingEffect) noexcept;
+
+        static constexpr size_t _colorGlyphCacheCapacity{ 256 };
+
+        // The list is ordered from most to least recently used.
+        std::list<CachedColorGlyphRun> _colorGlyphCache;
+        std::unordered_map<size_t, std::list<CachedColorGlyphRun>::iterator> _colorGlyphCacheMap;
+
         std::optional<D2D1_RECT_F> _clipRect;
     };
 }
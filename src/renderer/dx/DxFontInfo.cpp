@@ -13,6 +13,11 @@ static constexpr std::wstring_view FALLBACK_FONT_FACES[] = { L"Consolas", L"Luci
 
 using namespace Microsoft::Console::Render;
 
+std::mutex DxFontInfo::s_nearbyCollectionLock;
+Microsoft::WRL::ComPtr<IDWriteFontCollection1> DxFontInfo::s_nearbyCollection;
+std::mutex DxFontInfo::s_resolvedFontsLock;
+std::unordered_map<std::wstring, DxFontInfo::ResolvedFont> DxFontInfo::s_resolvedFonts;
+
 DxFontInfo::DxFontInfo() noexcept :
     _familyName(),
     _weight(DWRITE_FONT_WEIGHT_NORMAL),
@@ -120,6 +125,22 @@ void DxFontInfo::SetFromEngine(const std::wstring_view familyName,
 [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteFontFace1> DxFontInfo::ResolveFontFaceWithFallback(gsl::not_null<IDWriteFactory1*> dwriteFactory,
                                                                                                std::wstring& localeName)
 {
+    auto key = fmt::format(L"{}|{}|{}|{}|{}", _familyName, static_cast<int>(_weight), static_cast<int>(_style), static_cast<int>(_stretch), localeName);
+    {
+        const std::scoped_lock guard{ s_resolvedFontsLock };
+        if (const auto it = s_resolvedFonts.find(key); it != s_resolvedFonts.end())
+        {
+            const auto& resolved = it->second;
+            _familyName = resolved.familyName;
+            _weight = resolved.weight;
+            _style = resolved.style;
+            _stretch = resolved.stretch;
+            _didFallback = resolved.didFallback;
+            localeName = resolved.localeName;
+            return resolved.face;
+        }
+    }
+
     // First attempt to find exactly what the user asked for.
     _didFallback = false;
     Microsoft::WRL::ComPtr<IDWriteFontFace1> face{ nullptr };
@@ -199,6 +220,9 @@ void DxFontInfo::SetFromEngine(const std::wstring_view familyName,
 
     THROW_HR_IF_NULL(E_FAIL, face);
 
+    const std::scoped_lock guard{ s_resolvedFontsLock };
+    s_resolvedFonts.insert_or_assign(std::move(key), ResolvedFont{ face, _familyName, localeName, _weight, _style, _stretch, _didFallback });
+
     return face;
 }
 
@@ -223,7 +247,7 @@ void DxFontInfo::SetFromEngine(const std::wstring_view familyName,
     // If the system collection missed, try the files sitting next to our binary.
     if (withNearbyLookup && !familyExists)
     {
-        auto&& nearbyCollection = _NearbyCollection(dwriteFactory);
+        const auto nearbyCollection = s_NearbyCollection(dwriteFactory);
 
         // May be null on OS below Windows 10. If null, just skip the attempt.
         if (nearbyCollection)
@@ -332,7 +356,7 @@ void DxFontInfo::SetFromEngine(const std::wstring_view familyName,
 // - dwriteFactory - The DWrite factory to use
 // Return Value:
 // - DirectWrite font collection. May be null if one cannot be created.
-[[nodiscard]] const Microsoft::WRL::ComPtr<IDWriteFontCollection1>& DxFontInfo::_NearbyCollection(gsl::not_null<IDWriteFactory1*> dwriteFactory) const
+[[nodiscard]] Microsoft::WRL::ComPtr<IDWriteFontCollection1> DxFontInfo::s_NearbyCollection(gsl::not_null<IDWriteFactory1*> dwriteFactory)
 {
     // Magic static so we only attempt to grovel the hard disk once no matter how many instances
     // of the font collection itself we require.
@@ -343,7 +367,8 @@ void DxFontInfo::SetFromEngine(const std::wstring_view familyName,
     // Don't try to look up if below that OS version.
     static const bool s_isWindows10OrGreater = IsWindows10OrGreater();
 
-    if (s_isWindows10OrGreater && !_nearbyCollection)
+    const std::scoped_lock guard{ s_nearbyCollectionLock };
+    if (s_isWindows10OrGreater && !s_nearbyCollection)
     {
         // Factory3 has a convenience to get us a font set builder.
         ::Microsoft::WRL::ComPtr<IDWriteFactory3> factory3;
@@ -364,10 +389,10 @@ void DxFontInfo::SetFromEngine(const std::wstring_view familyName,
         ::Microsoft::WRL::ComPtr<IDWriteFontSet> fontSet;
         THROW_IF_FAILED(fontSetBuilder2->CreateFontSet(&fontSet));
 
-        THROW_IF_FAILED(factory3->CreateFontCollectionFromFontSet(fontSet.Get(), &_nearbyCollection));
+        THROW_IF_FAILED(factory3->CreateFontCollectionFromFontSet(fontSet.Get(), &s_nearbyCollection));
     }
 
-    return _nearbyCollection;
+    return s_nearbyCollection;
 }
 
 // Routine Description:
@@ -57,11 +57,30 @@ namespace Microsoft::Console::Render
         [[nodiscard]] std::wstring _GetFontFamilyName(gsl::not_null<IDWriteFontFamily*> const fontFamily,
                                                       std::wstring& localeName);
 
-        [[nodiscard]] const Microsoft::WRL::ComPtr<IDWriteFontCollection1>& _NearbyCollection(gsl::not_null<IDWriteFactory1*> dwriteFactory) const;
+        [[nodiscard]] static Microsoft::WRL::ComPtr<IDWriteFontCollection1> s_NearbyCollection(gsl::not_null<IDWriteFactory1*> dwriteFactory);
 
         [[nodiscard]] static std::vector<std::filesystem::path> s_GetNearbyFonts();
 
-        mutable ::Microsoft::WRL::ComPtr<IDWriteFontCollection1> _nearbyCollection;
+        // The nearby fonts are the same for every font, so their collection is only built once.
+        static std::mutex s_nearbyCollectionLock;
+        static ::Microsoft::WRL::ComPtr<IDWriteFontCollection1> s_nearbyCollection;
+
+        // What ResolveFontFaceWithFallback found for each request, so that rebuilding
+        // the render data for another size or DPI doesn't have to look the font up
+        // again. The system font collection doesn't change for the life of the
+        // process (it's never asked to check for updates), so neither do these.
+        struct ResolvedFont
+        {
+            ::Microsoft::WRL::ComPtr<IDWriteFontFace1> face;
+            std::wstring familyName;
+            std::wstring localeName;
+            DWRITE_FONT_WEIGHT weight;
+            DWRITE_FONT_STYLE style;
+            DWRITE_FONT_STRETCH stretch;
+            bool didFallback;
+        };
+        static std::mutex s_resolvedFontsLock;
+        static std::unordered_map<std::wstring, ResolvedFont> s_resolvedFonts;
 
         // The font name we should be looking for
         std::wstring _familyName;
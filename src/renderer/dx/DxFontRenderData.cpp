@@ -16,6 +16,9 @@ static constexpr size_t TAG_LENGTH = 4;
 
 using namespace Microsoft::Console::Render;
 
+std::mutex DxFontRenderData::s_cacheLock;
+std::unordered_map<std::wstring, DxFontRenderData::CacheEntry> DxFontRenderData::s_cache;
+
 DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwriteFactory) noexcept :
     _dwriteFactory(dwriteFactory),
     _fontSize{},
@@ -27,6 +30,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
 
 [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteTextAnalyzer1> DxFontRenderData::Analyzer()
 {
+    const std::scoped_lock guard{ _lazyLock };
     if (!_dwriteTextAnalyzer)
     {
         Microsoft::WRL::ComPtr<IDWriteTextAnalyzer> analyzer;
@@ -39,6 +43,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
 
 [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteFontFallback> DxFontRenderData::SystemFontFallback()
 {
+    const std::scoped_lock guard{ _lazyLock };
     if (!_systemFontFallback)
     {
         ::Microsoft::WRL::ComPtr<IDWriteFactory2> factory2;
@@ -51,6 +56,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
 
 [[nodiscard]] std::wstring DxFontRenderData::UserLocaleName()
 {
+    const std::scoped_lock guard{ _lazyLock };
     if (_userLocaleName.empty())
     {
         std::array<wchar_t, LOCALE_NAME_MAX_LENGTH> localeName;
@@ -111,6 +117,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
 
 [[nodiscard]] Microsoft::WRL::ComPtr<IBoxDrawingEffect> DxFontRenderData::DefaultBoxDrawingEffect()
 {
+    const std::scoped_lock guard{ _lazyLock };
     if (!_boxDrawingEffect)
     {
         // Calculate and cache the box effect for the base font. Scale is 1.0f because the base font is exactly the scale we want already.
@@ -120,10 +127,16 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     return _boxDrawingEffect;
 }
 
+[[nodiscard]] const BoxGlyphs& DxFontRenderData::BuiltinBoxGlyphs() const noexcept
+{
+    return _boxGlyphs;
+}
+
 [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteTextFormat> DxFontRenderData::TextFormatWithAttribute(DWRITE_FONT_WEIGHT weight,
                                                                                                   DWRITE_FONT_STYLE style,
                                                                                                   DWRITE_FONT_STRETCH stretch)
 {
+    const std::scoped_lock guard{ _lazyLock };
     const auto textFormatIt = _textFormatMap.find(_ToMapKey(weight, style, stretch));
     if (textFormatIt == _textFormatMap.end())
     {
@@ -156,6 +169,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
                                                                                                DWRITE_FONT_STYLE style,
                                                                                                DWRITE_FONT_STRETCH stretch)
 {
+    const std::scoped_lock guard{ _lazyLock };
     const auto fontFaceIt = _fontFaceMap.find(_ToMapKey(weight, style, stretch));
     if (fontFaceIt == _fontFaceMap.end())
     {
@@ -190,6 +204,7 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     {
         _userLocaleName.clear();
         _textFormatMap.clear();
+        _asciiGlyphsMap.clear();
         _fontFaceMap.clear();
         _boxDrawingEffect.Reset();
 
@@ -209,6 +224,105 @@ DxFontRenderData::DxFontRenderData(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwr
     return S_OK;
 }
 
+// Routine Description:
+// - Gets render data for the given font, reusing the one of another engine if
+//   it's already using the same font, or building a new one otherwise.
+// - Unlike UpdateFont, this never modifies render data that's already in use.
+// Arguments:
+// - dwriteFactory - The DirectWrite factory to build new render data with
+// - desired - Information specifying the font that is requested
+// - actual - Filled with the nearest font actually chosen for drawing
+// - dpi - The DPI of the screen
+// - features - The map of font features to use
+// - axes - The map of font axes to use
+// - fontRenderData - Receives the render data
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxFontRenderData::s_Acquire(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwriteFactory,
+                                                  const FontInfoDesired& desired,
+                                                  FontInfo& actual,
+                                                  const int dpi,
+                                                  const std::unordered_map<std::wstring_view, uint32_t>& features,
+                                                  const std::unordered_map<std::wstring_view, float>& axes,
+                                                  std::shared_ptr<DxFontRenderData>& fontRenderData) noexcept
+try
+{
+    auto key = _CacheKey(desired, dpi, features, axes);
+
+    {
+        const std::scoped_lock guard{ s_cacheLock };
+        if (const auto it = s_cache.find(key); it != s_cache.end())
+        {
+            if (auto cached = it->second.fontRenderData.lock())
+            {
+                actual = FontInfo{ it->second.actual };
+                fontRenderData = std::move(cached);
+                return S_OK;
+            }
+        }
+    }
+
+    // Building the render data does a lot of DirectWrite lookups,
+    // so don't do it while holding the lock.
+    auto built = std::make_shared<DxFontRenderData>(dwriteFactory);
+    RETURN_IF_FAILED(built->UpdateFont(desired, actual, dpi, features, axes));
+
+    const std::scoped_lock guard{ s_cacheLock };
+
+    // Drop the entries of render data that has been released in the meantime.
+    for (auto it = s_cache.begin(); it != s_cache.end();)
+    {
+        it = it->second.fontRenderData.expired() ? s_cache.erase(it) : std::next(it);
+    }
+
+    s_cache.insert_or_assign(std::move(key), CacheEntry{ built, actual });
+    fontRenderData = std::move(built);
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Turns everything that goes into building render data into a key for the cache.
+// Arguments:
+// - desired - Information specifying the font that is requested
+// - dpi - The DPI of the screen
+// - features - The map of font features to use
+// - axes - The map of font axes to use
+// Return Value:
+// - The cache key.
+std::wstring DxFontRenderData::_CacheKey(const FontInfoDesired& desired,
+                                         const int dpi,
+                                         const std::unordered_map<std::wstring_view, uint32_t>& features,
+                                         const std::unordered_map<std::wstring_view, float>& axes)
+{
+    const auto size = desired.GetEngineSize();
+    auto key = fmt::format(L"{}|{}|{}|{}|{}x{}|{}",
+                           desired.GetFaceName(),
+                           desired.GetFamily(),
+                           desired.GetWeight(),
+                           desired.GetCodePage(),
+                           size.X,
+                           size.Y,
+                           dpi);
+
+    // The maps are unordered, but the key mustn't be.
+    std::vector<std::pair<std::wstring_view, uint32_t>> sortedFeatures{ features.begin(), features.end() };
+    std::sort(sortedFeatures.begin(), sortedFeatures.end());
+    for (const auto& [tag, value] : sortedFeatures)
+    {
+        fmt::format_to(std::back_inserter(key), L"|f:{}={}", tag, value);
+    }
+
+    std::vector<std::pair<std::wstring_view, float>> sortedAxes{ axes.begin(), axes.end() };
+    std::sort(sortedAxes.begin(), sortedAxes.end());
+    for (const auto& [tag, value] : sortedAxes)
+    {
+        fmt::format_to(std::back_inserter(key), L"|a:{}={}", tag, value);
+    }
+
+    return key;
+}
+
 // Routine Description:
 // - Calculates the box drawing scale/translate matrix values to fit a box glyph into the cell as perfectly as possible.
 // Arguments:
@@ -457,6 +571,51 @@ bool DxFontRenderData::DidUserSetFeatures() const noexcept
     return _didUserSetFeatures;
 }
 
+// Routine Description:
+// - Returns the glyph indices of the printable ASCII characters in the given face, if ASCII
+//   text in it is simple: it needs no shaping and the face has a glyph for every character.
+//   Layouts of such text can then skip the text analyzer altogether.
+// - This is figured out once per face, by asking the analyzer about all of them at once.
+// Arguments:
+// - face - One of the faces returned by FontFaceWithAttribute
+// Return Value:
+// - The glyph indices, indexed by the character minus AsciiFirst, or nullptr if ASCII text
+//   in this face has to be analyzed like any other text.
+[[nodiscard]] const DxFontRenderData::AsciiGlyphs* DxFontRenderData::AsciiGlyphIndices(IDWriteFontFace1* face)
+{
+    const std::scoped_lock guard{ _lazyLock };
+    auto it = _asciiGlyphsMap.find(face);
+    if (it == _asciiGlyphsMap.end())
+    {
+        std::optional<AsciiGlyphs> glyphs;
+
+        std::array<wchar_t, std::tuple_size_v<AsciiGlyphs>> text{};
+        std::iota(text.begin(), text.end(), AsciiFirst);
+
+        AsciiGlyphs indices{};
+        BOOL isTextSimple = FALSE;
+        UINT32 textLengthRead = 0;
+        THROW_IF_FAILED(Analyzer()->GetTextComplexity(text.data(),
+                                                      gsl::narrow_cast<UINT32>(text.size()),
+                                                      face,
+                                                      &isTextSimple,
+                                                      &textLengthRead,
+                                                      indices.data()));
+
+        // A glyph index of 0 is the font's .notdef glyph, that is, the character is missing.
+        // Text with missing characters has to go through font fallback.
+        if (isTextSimple && textLengthRead == text.size() &&
+            std::find(indices.begin(), indices.end(), UINT16{ 0 }) == indices.end())
+        {
+            glyphs = indices;
+        }
+
+        it = _asciiGlyphsMap.emplace(face, glyphs).first;
+    }
+
+    return it->second ? &*it->second : nullptr;
+}
+
 // Routine Description:
 // - Updates our internal map of font features with the given features
 // - NOTE TO CALLER: Make sure to call _BuildFontRenderData after calling this for the feature changes
@@ -827,6 +986,9 @@ void DxFontRenderData::_BuildFontRenderData(const FontInfoDesired& desired, Font
     _lineMetrics = lineMetrics;
 
     _glyphCell = actual.GetSize();
+
+    // The lines of box drawing characters are about as thick as the font's underline.
+    _boxGlyphs = BoxGlyphs{ D2D1::SizeF(_glyphCell.width<float>(), _glyphCell.height<float>()), lineMetrics.underlineWidth };
 }
 
 Microsoft::WRL::ComPtr<IDWriteTextFormat> DxFontRenderData::_BuildTextFormat(const DxFontInfo fontInfo, const std::wstring_view localeName)
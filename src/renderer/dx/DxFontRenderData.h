@@ -6,6 +6,7 @@
 #include "../../renderer/inc/FontInfoDesired.hpp"
 #include "DxFontInfo.h"
 #include "BoxDrawingEffect.h"
+#include "BoxGlyphs.h"
 
 #include <dwrite.h>
 #include <dwrite_1.h>
@@ -73,6 +74,9 @@ namespace Microsoft::Console::Render
         // Box drawing scaling effects that are cached for the base font across layouts
         [[nodiscard]] Microsoft::WRL::ComPtr<IBoxDrawingEffect> DefaultBoxDrawingEffect();
 
+        // Box drawing characters that are drawn without the font, for the current cell size
+        [[nodiscard]] const BoxGlyphs& BuiltinBoxGlyphs() const noexcept;
+
         // The attributed variants of the format object representing the size and other text properties
         [[nodiscard]] Microsoft::WRL::ComPtr<IDWriteTextFormat> TextFormatWithAttribute(DWRITE_FONT_WEIGHT weight,
                                                                                         DWRITE_FONT_STYLE style,
@@ -85,10 +89,25 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& desired, FontInfo& fiFontInfo, const int dpi, const std::unordered_map<std::wstring_view, uint32_t>& features = {}, const std::unordered_map<std::wstring_view, float>& axes = {}) noexcept;
 
+        [[nodiscard]] static HRESULT s_Acquire(::Microsoft::WRL::ComPtr<IDWriteFactory1> dwriteFactory,
+                                               const FontInfoDesired& desired,
+                                               FontInfo& fiFontInfo,
+                                               const int dpi,
+                                               const std::unordered_map<std::wstring_view, uint32_t>& features,
+                                               const std::unordered_map<std::wstring_view, float>& axes,
+                                               std::shared_ptr<DxFontRenderData>& fontRenderData) noexcept;
+
         [[nodiscard]] static HRESULT STDMETHODCALLTYPE s_CalculateBoxEffect(IDWriteTextFormat* format, size_t widthPixels, IDWriteFontFace1* face, float fontScale, IBoxDrawingEffect** effect) noexcept;
 
         bool DidUserSetFeatures() const noexcept;
 
+        // The glyph indices of the printable ASCII characters (0x20 to 0x7E) in the given face,
+        // or nullptr if ASCII text in that face isn't simple and has to be analyzed.
+        static constexpr wchar_t AsciiFirst = L' ';
+        static constexpr wchar_t AsciiLast = L'~';
+        using AsciiGlyphs = std::array<UINT16, AsciiLast - AsciiFirst + 1>;
+        [[nodiscard]] const AsciiGlyphs* AsciiGlyphIndices(IDWriteFontFace1* face);
+
         std::vector<DWRITE_FONT_AXIS_VALUE> GetAxisVector(const DWRITE_FONT_WEIGHT fontWeight,
                                                           const DWRITE_FONT_STRETCH fontStretch,
                                                           const DWRITE_FONT_STYLE fontStyle,
@@ -119,17 +138,41 @@ namespace Microsoft::Console::Render
 
         std::unordered_map<FontAttributeMapKey, ::Microsoft::WRL::ComPtr<IDWriteTextFormat>> _textFormatMap;
         std::unordered_map<FontAttributeMapKey, ::Microsoft::WRL::ComPtr<IDWriteFontFace1>> _fontFaceMap;
+        // Keyed by the faces in _fontFaceMap, which keeps them alive. Empty optionals are faces
+        // that have to go through the analyzer even for ASCII.
+        std::unordered_map<IDWriteFontFace1*, std::optional<AsciiGlyphs>> _asciiGlyphsMap;
 
         ::Microsoft::WRL::ComPtr<IBoxDrawingEffect> _boxDrawingEffect;
         ::Microsoft::WRL::ComPtr<IDWriteFontFallback> _systemFontFallback;
         ::Microsoft::WRL::ComPtr<IDWriteFactory1> _dwriteFactory;
         ::Microsoft::WRL::ComPtr<IDWriteTextAnalyzer1> _dwriteTextAnalyzer;
 
+        // The text formats, font faces and such are created lazily, and since the
+        // render data may be shared by the render threads of several engines, that
+        // has to happen under this lock. It's recursive, since the lazy getters
+        // call each other.
+        std::recursive_mutex _lazyLock;
+
+        // All the render data that's in use by an engine, keyed by everything that went into building it.
+        // Opening another tab or pane with the same font then doesn't have to look it up all over again.
+        struct CacheEntry
+        {
+            std::weak_ptr<DxFontRenderData> fontRenderData;
+            FontInfo actual;
+        };
+        static std::wstring _CacheKey(const FontInfoDesired& desired,
+                                      const int dpi,
+                                      const std::unordered_map<std::wstring_view, uint32_t>& features,
+                                      const std::unordered_map<std::wstring_view, float>& axes);
+        static std::mutex s_cacheLock;
+        static std::unordered_map<std::wstring, CacheEntry> s_cache;
+
         std::wstring _userLocaleName;
         DxFontInfo _defaultFontInfo;
         til::size _glyphCell;
         DWRITE_LINE_SPACING _lineSpacing;
         LineMetrics _lineMetrics;
+        BoxGlyphs _boxGlyphs;
         float _fontSize;
     };
 }
@@ -8,6 +8,7 @@
 
 #include "../../interactivity/win32/CustomWindowMessages.h"
 #include "../../types/inc/Viewport.hpp"
+#include "../../types/inc/utils.hpp"
 #include "../../inc/unicode.hpp"
 #include "../../inc/DefaultSettings.h"
 #include <VersionHelpers.h>
@@ -64,6 +65,8 @@ DxEngine::DxEngine() :
     _pool{ til::pmr::get_default_resource() },
     _invalidMap{ &_pool },
     _invalidScroll{},
+    _invalidScrollRegion{},
+    _invalidScrollRegionDelta{ 0 },
     _allInvalid{ false },
     _firstFrame{ true },
     _presentParams{ 0 },
@@ -77,6 +80,9 @@ DxEngine::DxEngine() :
     _foregroundColor{ 0 },
     _backgroundColor{ 0 },
     _selectionBackground{},
+    _resolvedColors{},
+    _resolvedColorsCount{ 0 },
+    _resolvedColorsNext{ 0 },
     _haveDeviceResources{ false },
     _swapChainHandle{ INVALID_HANDLE_VALUE },
     _swapChainDesc{ 0 },
@@ -105,8 +111,6 @@ DxEngine::DxEngine() :
         TraceLoggingRegister(g_hDxRenderProvider);
     }
 
-    THROW_IF_FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, IID_PPV_ARGS(&_d2dFactory)));
-
     THROW_IF_FAILED(DWriteCreateFactory(
         DWRITE_FACTORY_TYPE_SHARED,
         __uuidof(_dwriteFactory),
@@ -116,7 +120,7 @@ DxEngine::DxEngine() :
     // sure to set to to a D2D1::ColorF
     SetSelectionBackground(DEFAULT_FOREGROUND);
 
-    _fontRenderData = std::make_unique<DxFontRenderData>(_dwriteFactory);
+    _fontRenderData = std::make_shared<DxFontRenderData>(_dwriteFactory);
 }
 
 // Routine Description:
@@ -173,7 +177,21 @@ DxEngine::~DxEngine()
     _isEnabled = outputEnabled;
     if (!_isEnabled)
     {
+        // Output is disabled because nobody can see it for a while. Give back
+        // as much as we can: everything is rebuilt on the next frame anyway.
+        // The device itself is shared with the other engines, which may well
+        // be drawing with it right now, so we leave its state alone. It goes
+        // away on its own once the last engine has let go of it.
         _ReleaseDeviceResources();
+        if (_customLayout)
+        {
+            _customLayout->ClearCache();
+        }
+        _shapingLayouts.clear();
+        if (_customRenderer)
+        {
+            _customRenderer->ClearCache();
+        }
     }
 
     return S_OK;
@@ -327,27 +345,10 @@ HRESULT DxEngine::_SetupTerminalEffects()
         return S_FALSE;
     }
 
-    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> swapBuffer;
-    RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (LPVOID*)&swapBuffer));
+    RETURN_IF_FAILED(_PrepareTerminalEffectsTarget());
 
-    // Setup render target.
-    RETURN_IF_FAILED(_d3dDevice->CreateRenderTargetView(swapBuffer.Get(), nullptr, &_renderTargetView));
-
-    // Setup _framebufferCapture, to where we'll copy current frame when rendering effects.
-    D3D11_TEXTURE2D_DESC framebufferCaptureDesc{};
-    swapBuffer->GetDesc(&framebufferCaptureDesc);
-    WI_SetFlag(framebufferCaptureDesc.BindFlags, D3D11_BIND_SHADER_RESOURCE);
-    RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&framebufferCaptureDesc, nullptr, &_framebufferCapture));
-
-    // Setup the viewport.
-    D3D11_VIEWPORT vp;
-    vp.Width = _displaySizePixels.width<float>();
-    vp.Height = _displaySizePixels.height<float>();
-    vp.MinDepth = 0.0f;
-    vp.MaxDepth = 1.0f;
-    vp.TopLeftX = 0;
-    vp.TopLeftY = 0;
-    _d3dDeviceContext->RSSetViewports(1, &vp);
+    // The viewport is part of the device context state, which is shared with
+    // the other engines, so it's set up right before we draw in _PaintTerminalEffects.
 
     // Prepare shaders.
     auto vertexBlob = _CompileShader(screenVertexShaderString, "vs_5_0");
@@ -372,6 +373,49 @@ HRESULT DxEngine::_SetupTerminalEffects()
         return exceptionHr;
     }
 
+    // A shader that never reads Time (the first member of the settings
+    // constant buffer at b0) doesn't animate, and doesn't need a new frame
+    // on every tick. If we can't tell, we have to assume it does.
+    _pixelShaderUsesTime = true;
+    {
+        ::Microsoft::WRL::ComPtr<ID3D11ShaderReflection> reflection;
+        D3D11_SHADER_DESC shaderDesc{};
+        if (SUCCEEDED(D3DReflect(pixelBlob->GetBufferPointer(), pixelBlob->GetBufferSize(), IID_PPV_ARGS(&reflection))) &&
+            SUCCEEDED(reflection->GetDesc(&shaderDesc)))
+        {
+            _pixelShaderUsesTime = false;
+            for (UINT i = 0; i < shaderDesc.BoundResources; ++i)
+            {
+                D3D11_SHADER_INPUT_BIND_DESC bindDesc{};
+                if (FAILED(reflection->GetResourceBindingDesc(i, &bindDesc)) ||
+                    bindDesc.Type != D3D_SIT_CBUFFER ||
+                    bindDesc.BindPoint != 0)
+                {
+                    continue;
+                }
+
+                const auto constantBuffer = reflection->GetConstantBufferByName(bindDesc.Name);
+                D3D11_SHADER_BUFFER_DESC bufferDesc{};
+                if (FAILED(constantBuffer->GetDesc(&bufferDesc)))
+                {
+                    _pixelShaderUsesTime = true;
+                    break;
+                }
+
+                for (UINT v = 0; v < bufferDesc.Variables; ++v)
+                {
+                    D3D11_SHADER_VARIABLE_DESC variableDesc{};
+                    if (FAILED(constantBuffer->GetVariableByIndex(v)->GetDesc(&variableDesc)) ||
+                        (variableDesc.StartOffset == 0 && WI_IsFlagSet(variableDesc.uFlags, D3D_SVF_USED)))
+                    {
+                        _pixelShaderUsesTime = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
     RETURN_IF_FAILED(_d3dDevice->CreateVertexShader(
         vertexBlob->GetBufferPointer(),
         vertexBlob->GetBufferSize(),
@@ -440,6 +484,62 @@ HRESULT DxEngine::_SetupTerminalEffects()
     return S_OK;
 }
 
+// Routine Description:
+// - Binds the terminal effects to the swap chain's current buffers. The render
+//   target view is recreated, since it's released when the buffers are resized,
+//   but the intermediate texture is kept for as long as its size still matches.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::_PrepareTerminalEffectsTarget() noexcept
+try
+{
+    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> swapBuffer;
+    RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&swapBuffer)));
+
+    // Setup render target.
+    _renderTargetView.Reset();
+    RETURN_IF_FAILED(_d3dDevice->CreateRenderTargetView(swapBuffer.Get(), nullptr, &_renderTargetView));
+
+    // Setup _framebufferCapture, to where we'll copy current frame when rendering effects.
+    D3D11_TEXTURE2D_DESC framebufferCaptureDesc{};
+    swapBuffer->GetDesc(&framebufferCaptureDesc);
+    WI_SetFlag(framebufferCaptureDesc.BindFlags, D3D11_BIND_SHADER_RESOURCE);
+
+    if (_framebufferCapture)
+    {
+        D3D11_TEXTURE2D_DESC existingDesc{};
+        _framebufferCapture->GetDesc(&existingDesc);
+        if (existingDesc.Width == framebufferCaptureDesc.Width &&
+            existingDesc.Height == framebufferCaptureDesc.Height &&
+            existingDesc.Format == framebufferCaptureDesc.Format)
+        {
+            return S_OK;
+        }
+        _framebufferCapture.Reset();
+    }
+
+    RETURN_IF_FAILED(_d3dDevice->CreateTexture2D(&framebufferCaptureDesc, nullptr, &_framebufferCapture));
+
+    // The new capture doesn't hold a frame yet.
+    _terminalEffectsInputChanged = true;
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Checks whether the terminal effects change on their own, without anything
+//   new being drawn under them.
+// Arguments:
+// - <none>
+// Return Value:
+// - True if the loaded shader reads the time.
+bool DxEngine::_TerminalEffectsAnimate() const noexcept
+{
+    return _HasTerminalEffects() && _pixelShaderLoaded && _pixelShaderUsesTime;
+}
+
 // Routine Description:
 // - Puts the correct values in _pixelShaderSettings, so the struct can be
 //   passed the GPU and updates the GPU resource.
@@ -525,69 +625,16 @@ try
 
     RETURN_IF_FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&_dxgiFactory2)));
 
-    const DWORD DeviceFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT |
-                              // clang-format off
-// This causes problems for folks who do not have the whole DirectX SDK installed
-// when they try to run the rest of the project in debug mode.
-// As such, I'm leaving this flag here for people doing DX-specific work to toggle it
-// only when they need it and shutting it off otherwise.
-// Find out more about the debug layer here:
-// https://docs.microsoft.com/en-us/windows/desktop/direct3d11/overviews-direct3d-11-devices-layers
-// You can find out how to install it here:
-// https://docs.microsoft.com/en-us/windows/uwp/gaming/use-the-directx-runtime-and-visual-studio-graphics-diagnostic-features
-                              // clang-format on
-                              // D3D11_CREATE_DEVICE_DEBUG |
-                              D3D11_CREATE_DEVICE_SINGLETHREADED;
-
-    const std::array<D3D_FEATURE_LEVEL, 5> FeatureLevels{ D3D_FEATURE_LEVEL_11_1,
-                                                          D3D_FEATURE_LEVEL_11_0,
-                                                          D3D_FEATURE_LEVEL_10_1,
-                                                          D3D_FEATURE_LEVEL_10_0,
-                                                          D3D_FEATURE_LEVEL_9_1 };
-
-    // Trying hardware first for maximum performance, then trying WARP (software) renderer second
-    // in case we're running inside a downlevel VM where hardware passthrough isn't enabled like
-    // for Windows 7 in a VM.
-    HRESULT hardwareResult = E_NOT_SET;
-
-    // If we're not forcing software rendering, try hardware first.
-    // Otherwise, let the error state fall down and create with the software renderer directly.
-    if (!_softwareRendering)
-    {
-        hardwareResult = D3D11CreateDevice(nullptr,
-                                           D3D_DRIVER_TYPE_HARDWARE,
-                                           nullptr,
-                                           DeviceFlags,
-                                           FeatureLevels.data(),
-                                           gsl::narrow_cast<UINT>(FeatureLevels.size()),
-                                           D3D11_SDK_VERSION,
-                                           &_d3dDevice,
-                                           nullptr,
-                                           &_d3dDeviceContext);
-    }
-
-    if (FAILED(hardwareResult))
-    {
-        RETURN_IF_FAILED(D3D11CreateDevice(nullptr,
-                                           D3D_DRIVER_TYPE_WARP,
-                                           nullptr,
-                                           DeviceFlags,
-                                           FeatureLevels.data(),
-                                           gsl::narrow_cast<UINT>(FeatureLevels.size()),
-                                           D3D11_SDK_VERSION,
-                                           &_d3dDevice,
-                                           nullptr,
-                                           &_d3dDeviceContext));
-    }
+    // The devices are shared with all the other engines in this process.
+    RETURN_IF_FAILED(DxSharedDevice::Acquire(_softwareRendering, _sharedDevice));
+    _d2dFactory = _sharedDevice->D2DFactory();
+    _d3dDevice = _sharedDevice->D3DDevice();
+    _d3dDeviceContext = _sharedDevice->D3DDeviceContext();
+    _dxgiDevice = _sharedDevice->DxgiDevice();
+    _d2dDevice = _sharedDevice->D2DDevice();
 
     _displaySizePixels = _GetClientSize();
 
-    // Get the other device types so we have deeper access to more functionality
-    // in our pipeline than by just walking straight from the D3D device.
-
-    RETURN_IF_FAILED(_d3dDevice.As(&_dxgiDevice));
-    RETURN_IF_FAILED(_d2dFactory->CreateDevice(_dxgiDevice.Get(), _d2dDevice.ReleaseAndGetAddressOf()));
-
     // Create a device context out of it (supercedes render targets)
     RETURN_IF_FAILED(_d2dDevice->CreateDeviceContext(D2D1_DEVICE_CONTEXT_OPTIONS_NONE, &_d2dDeviceContext));
 
@@ -852,6 +899,9 @@ void DxEngine::_ReleaseDeviceResources() noexcept
         _d2dBrushBackground.Reset();
 
         _d2dBitmap.Reset();
+        _softFontAtlas.Reset();
+        _imageSliceCache.clear();
+        _ClearCachedRows();
 
         if (nullptr != _d2dDeviceContext.Get() && _isPainting)
         {
@@ -871,11 +921,13 @@ void DxEngine::_ReleaseDeviceResources() noexcept
         {
             // To ensure the swap chain goes away we must unbind any views from the
             // D3D pipeline
+            const auto lock = _sharedDevice->Lock();
             _d3dDeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
         }
         _d3dDeviceContext.Reset();
 
         _d3dDevice.Reset();
+        _sharedDevice.reset();
 
         _dxgiFactory2.Reset();
     }
@@ -1042,6 +1094,47 @@ HANDLE DxEngine::GetSwapChainHandle()
     return _swapChainHandle.get();
 }
 
+// Routine Description:
+// - Estimates the memory held by this engine: the swap chain's buffers, the
+//   copy of the frame the shader effects read from, and the glyph caches.
+//   Must not be called while the engine is painting.
+// Arguments:
+// - <none>
+// Return Value:
+// - The memory in use, in bytes.
+DxEngine::MemoryUsage DxEngine::GetMemoryUsage() const noexcept
+{
+    // The capture is a copy of a swap chain buffer, and both are B8G8R8A8.
+    static constexpr size_t bytesPerPixel = 4;
+
+    MemoryUsage usage;
+    // _swapChainDesc keeps the size the swap chain was created with, not the one it was resized to.
+    DXGI_SWAP_CHAIN_DESC1 swapChainDesc{};
+    if (_dxgiSwapChain && SUCCEEDED(_dxgiSwapChain->GetDesc1(&swapChainDesc)))
+    {
+        usage.swapChain = size_t{ swapChainDesc.Width } * swapChainDesc.Height * swapChainDesc.BufferCount * bytesPerPixel;
+    }
+    if (_framebufferCapture)
+    {
+        D3D11_TEXTURE2D_DESC desc{};
+        _framebufferCapture->GetDesc(&desc);
+        usage.intermediateTargets = size_t{ desc.Width } * desc.Height * bytesPerPixel;
+    }
+    if (_customLayout)
+    {
+        usage.glyphCaches += _customLayout->GetCacheMemoryUsage();
+    }
+    for (const auto& layout : _shapingLayouts)
+    {
+        usage.glyphCaches += layout->GetCacheMemoryUsage();
+    }
+    if (_customRenderer)
+    {
+        usage.glyphCaches += _customRenderer->GetCacheMemoryUsage();
+    }
+    return usage;
+}
+
 void DxEngine::_InvalidateRectangle(const til::rectangle& rc)
 {
     const auto size = _invalidMap.size();
@@ -1145,6 +1238,13 @@ try
     {
         if (deltaCells != til::point{ 0, 0 })
         {
+            // A scroll of only some rows can't be presented together with this one.
+            if (_invalidScrollRegionDelta != 0)
+            {
+                _InvalidateRectangle(_invalidScrollRegion);
+                _invalidScrollRegionDelta = 0;
+            }
+
             // Shift the contents of the map and fill in revealed area.
             _invalidMap.translate(deltaCells, true);
             _invalidScroll += deltaCells;
@@ -1156,6 +1256,75 @@ try
 }
 CATCH_RETURN();
 
+// Routine Description:
+// - Invalidates a region whose rows scrolled, without the rest of the viewport.
+// - If possible, what's already on screen is moved by the scroll on Present,
+//   and only the rows that were revealed are repainted.
+// Arguments:
+// - psrRegion - the region that scrolled, in characters (exclusive)
+// - pcoordDelta - how far the contents of the region moved
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT DxEngine::InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const COORD* const pcoordDelta) noexcept
+try
+{
+    RETURN_HR_IF(E_INVALIDARG, !psrRegion || !pcoordDelta);
+
+    if (_allInvalid || pcoordDelta->Y == 0)
+    {
+        return S_OK;
+    }
+
+    const auto size = _invalidMap.size();
+    const auto region = til::rectangle{ Viewport::FromExclusive(*psrRegion).ToInclusive() } & til::rectangle{ size };
+    const ptrdiff_t delta = pcoordDelta->Y;
+
+    // We can only move entire rows, one region per frame, and not while the whole viewport is scrolling.
+    const auto fullRows = region.left() == 0 && region.right() == size.width();
+    const auto sameRegion = _invalidScrollRegionDelta == 0 || _invalidScrollRegion == region;
+    if (pcoordDelta->X != 0 || !fullRows || !sameRegion || _invalidScroll != til::point{ 0, 0 } || _firstFrame)
+    {
+        return Invalidate(psrRegion);
+    }
+
+    // Invalid rows in the region move along with their contents. Every invalidation
+    // covers entire rows, so it's enough to move the rows of the map.
+    const auto top = region.top();
+    const auto bottom = region.bottom();
+    const auto invalidateRows = [&](const ptrdiff_t first, const ptrdiff_t last) {
+        if (first < last)
+        {
+            _InvalidateRectangle({ ptrdiff_t{ 0 }, first, size.width(), last });
+        }
+    };
+
+    const std::vector<til::rectangle> runs{ _invalidMap.runs().begin(), _invalidMap.runs().end() };
+    _invalidMap.reset_all();
+    for (const auto& run : runs)
+    {
+        invalidateRows(run.top(), std::min(run.bottom(), top));
+        invalidateRows(std::max(run.top(), bottom), run.bottom());
+        invalidateRows(std::clamp(std::max(run.top(), top) + delta, top, bottom),
+                       std::clamp(std::min(run.bottom(), bottom) + delta, top, bottom));
+    }
+
+    // The rows the scroll revealed have to be painted.
+    if (delta < 0)
+    {
+        invalidateRows(std::max(top, bottom + delta), bottom);
+    }
+    else
+    {
+        invalidateRows(top, std::min(bottom, top + delta));
+    }
+
+    _invalidScrollRegion = region;
+    _invalidScrollRegionDelta += delta;
+
+    return S_OK;
+}
+CATCH_RETURN();
+
 // Routine Description:
 // - Invalidates the entire window area
 // Arguments:
@@ -1262,9 +1431,22 @@ try
 {
     RETURN_HR_IF(E_NOT_VALID_STATE, _isPainting); // invalid to start a paint while painting.
 
+    // The colors may have changed since the last frame.
+    _resolvedColorsCount = 0;
+    _resolvedColorsNext = 0;
+
     // If full repaints are needed then we need to invalidate everything
     // so the entire frame is repainted.
-    if (_FullRepaintNeeded())
+    // With terminal effects, a frame where nothing was invalidated is only
+    // here for the effect pass, which can work from the previous frame.
+    // Don't redraw the text under it then.
+    _terminalEffectsInputChanged = !_pixelShaderLoaded ||
+                                   _firstFrame ||
+                                   _allInvalid ||
+                                   _invalidMap.any() ||
+                                   _invalidScroll != til::point{ 0, 0 } ||
+                                   _invalidScrollRegionDelta != 0;
+    if (_FullRepaintNeeded() && (_forceFullRepaintRendering || _terminalEffectsInputChanged))
     {
         RETURN_IF_FAILED(InvalidateAll());
     }
@@ -1305,10 +1487,15 @@ try
             _dxgiSurface.Reset();
             _d2dDeviceContext->SetTarget(nullptr);
             _d2dBitmap.Reset();
+            _renderTargetView.Reset();
 
             // Change the buffer size and recreate the render target (and surface)
             RETURN_IF_FAILED(_dxgiSwapChain->ResizeBuffers(2, clientSize.width<UINT>(), clientSize.height<UINT>(), _swapChainDesc.Format, _swapChainDesc.Flags));
             RETURN_IF_FAILED(_PrepareRenderTarget());
+            if (_pixelShaderLoaded)
+            {
+                RETURN_IF_FAILED(_PrepareTerminalEffectsTarget());
+            }
 
             // OK we made it past the parts that can cause errors. We can release our failure handler.
             resetDeviceResourcesOnFailure.release();
@@ -1325,6 +1512,7 @@ try
 
         _d2dDeviceContext->BeginDraw();
         _isPainting = true;
+        _queuedGridLines.clear();
 
         {
             // Get the baseline for this font as that's where we draw from
@@ -1342,6 +1530,10 @@ try
                                                                _d2dDeviceContext->GetSize(),
                                                                std::nullopt,
                                                                D2D1_DRAW_TEXT_OPTIONS_ENABLE_COLOR_FONT);
+            _drawingContext->boxGlyphs = &_fontRenderData->BuiltinBoxGlyphs();
+
+            LOG_IF_FAILED(_PrepareSoftFontAtlas());
+            _drawingContext->softFontAtlas = _softFontAtlas.Get();
         }
     }
 
@@ -1349,6 +1541,148 @@ try
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Scales the soft font to the glyph cell and uploads it to an alpha mask
+//   bitmap, if there is a soft font and it hasn't been uploaded yet. Glyph
+//   runs in the soft font are then drawn straight from that bitmap.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxEngine::_PrepareSoftFontAtlas() noexcept
+try
+{
+    if (_softFontAtlas || _softFont.IsEmpty())
+    {
+        return S_OK;
+    }
+
+    const auto atlas = _softFont.CreateAtlas();
+    const auto atlasSize = _softFont.AtlasSize();
+    const auto properties = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+    RETURN_IF_FAILED(_d2dDeviceContext->CreateBitmap(D2D1::SizeU(atlasSize.width<UINT32>(), atlasSize.height<UINT32>()),
+                                                     atlas.data(),
+                                                     atlasSize.width<UINT32>(),
+                                                     properties,
+                                                     &_softFontAtlas));
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Drops the uploaded image slices that the frame didn't paint, if there are
+//   more of them than we want to keep around. Most of them will have
+//   scrolled out of view, or been cleared from the buffer altogether.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void DxEngine::_TrimImageSliceCache() noexcept
+{
+    if (_imageSliceCache.size() > MaxCachedImageSlices)
+    {
+        for (auto it = _imageSliceCache.begin(); it != _imageSliceCache.end();)
+        {
+            it = it->second.used ? std::next(it) : _imageSliceCache.erase(it);
+        }
+    }
+    for (auto& [id, cached] : _imageSliceCache)
+    {
+        cached.used = false;
+    }
+}
+
+// Routine Description:
+// - Whether rows may be painted from (and put into) the row cache at all.
+//   Terminal effects are rendered to a texture of their own, and so the
+//   target holds something else than what we painted.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if the row cache is in use
+bool DxEngine::_IsRowCacheEnabled() const noexcept
+{
+    return !_pixelShaderLoaded;
+}
+
+// Routine Description:
+// - Copies the rows that were painted in full this frame out of the target,
+//   so that PaintCachedRow can restore them when they're scrolled back into
+//   view. There is room for a few screens' worth of rows, and whenever it's
+//   full, the least recently used row makes room (and lends its bitmap).
+// - This has to be called after EndDraw, once everything is on the target.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::_CacheRows() noexcept
+try
+{
+    const auto glyphCell = _fontRenderData->GlyphCell();
+    const til::size rowSize{ _invalidMap.size().width() * glyphCell.width(), glyphCell.height() };
+    if (rowSize != _cachedRowSize)
+    {
+        _ClearCachedRows();
+        _cachedRowSize = rowSize;
+    }
+    if (!rowSize)
+    {
+        return S_OK;
+    }
+
+    const auto capacity = CachedRowScreens * _invalidMap.size().height<size_t>();
+    for (const auto row : _rowsToCache)
+    {
+        const CachedRowKey key{ til::at(_rowGenerations, row), _rowAppearance };
+        if (_rowsPaintedOver.at(row) || _cachedRowIndex.count(key))
+        {
+            continue;
+        }
+
+        ::Microsoft::WRL::ComPtr<ID2D1Bitmap1> bitmap;
+        if (_cachedRows.size() >= capacity)
+        {
+            bitmap = std::move(_cachedRows.back().second);
+            _cachedRowIndex.erase(_cachedRows.back().first);
+            _cachedRows.pop_back();
+        }
+        else
+        {
+            const auto properties = D2D1::BitmapProperties1(D2D1_BITMAP_OPTIONS_NONE, _d2dBitmap->GetPixelFormat());
+            RETURN_IF_FAILED(_d2dDeviceContext->CreateBitmap(D2D1::SizeU(rowSize.width<UINT32>(), rowSize.height<UINT32>()),
+                                                             nullptr,
+                                                             0,
+                                                             properties,
+                                                             &bitmap));
+        }
+
+        const auto top = gsl::narrow_cast<UINT32>(row * rowSize.height<size_t>());
+        const auto source = D2D1::RectU(0, top, rowSize.width<UINT32>(), top + rowSize.height<UINT32>());
+        RETURN_IF_FAILED(bitmap->CopyFromBitmap(nullptr, _d2dBitmap.Get(), &source));
+
+        _cachedRows.emplace_front(key, std::move(bitmap));
+        _cachedRowIndex.emplace(key, _cachedRows.begin());
+    }
+
+    _rowsToCache.clear();
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Drops all the rows in the row cache. This has to happen whenever rows
+//   would look different even though neither their generation nor their
+//   appearance changed, like with a new font.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void DxEngine::_ClearCachedRows() noexcept
+{
+    _cachedRowIndex.clear();
+    _cachedRows.clear();
+}
+
 // Routine Description:
 // - Ends batch drawing and captures any state necessary for presentation
 // Arguments:
@@ -1366,51 +1700,96 @@ try
     {
         _isPainting = false;
 
+        LOG_IF_FAILED(_FlushGridLines());
+
         // If there's still a clip hanging around, remove it. We're all done.
         LOG_IF_FAILED(_customRenderer->EndClip(_drawingContext.get()));
 
+        _TrimImageSliceCache();
+
         hr = _d2dDeviceContext->EndDraw();
 
         if (SUCCEEDED(hr))
         {
-            if (_invalidScroll != til::point{ 0, 0 })
+            if (_IsRowCacheEnabled())
             {
-                // Copy `til::rectangles` into RECT map.
-                _presentDirty.assign(_invalidMap.begin(), _invalidMap.end());
-
-                // Scale all dirty rectangles into pixels
-                std::transform(_presentDirty.begin(), _presentDirty.end(), _presentDirty.begin(), [&](til::rectangle rc) {
-                    return rc.scale_up(_fontRenderData->GlyphCell());
-                });
-
-                // Invalid scroll is in characters, convert it to pixels.
-                const auto scrollPixels = (_invalidScroll * _fontRenderData->GlyphCell());
-
-                // The scroll rect is the entire field of cells, but in pixels.
-                til::rectangle scrollArea{ _invalidMap.size() * _fontRenderData->GlyphCell() };
+                LOG_IF_FAILED(_CacheRows());
+            }
 
-                // Reduce the size of the rectangle by the scroll.
-                scrollArea -= til::size{} - scrollPixels;
+            // Present only what changed, so that DWM only has to compose
+            // that much. If everything is invalid, the whole frame is new
+            // anyway, and that includes the area past the last cell, which
+            // no dirty rect covers. Leave the parameters zeroed then, which
+            // presents everything.
+            if (!_invalidMap.all())
+            {
+                _presentDirty.clear();
+                for (const auto& run : _invalidMap.runs())
+                {
+                    const RECT rc = run.scale_up(_fontRenderData->GlyphCell());
+
+                    // Rows that changed across the same columns, like the
+                    // lines a scroll uncovers, become a single rectangle.
+                    if (!_presentDirty.empty())
+                    {
+                        auto& last = _presentDirty.back();
+                        if (last.left == rc.left && last.right == rc.right && last.bottom == rc.top)
+                        {
+                            last.bottom = rc.bottom;
+                            continue;
+                        }
+                    }
+                    _presentDirty.push_back(rc);
+                }
 
-                // Assign the area to the present storage
-                _presentScroll = scrollArea;
+                const bool scrolled = _invalidScroll != til::point{ 0, 0 };
+                const bool regionScrolled = _invalidScrollRegionDelta != 0;
 
-                // Pass the offset.
-                _presentOffset = scrollPixels;
+                // Nothing was drawn. The back buffer is still a copy of what's
+                // on screen, so there's nothing to present either, unless
+                // the effects on top of it are animated.
+                if (_presentDirty.empty() && !scrolled && !regionScrolled && !_firstFrame && !_TerminalEffectsAnimate())
+                {
+                    _invalidMap.reset_all();
+                    _allInvalid = false;
+                    _invalidScroll = {};
+                    _invalidScrollRegionDelta = 0;
+                    return hr;
+                }
 
                 // Now fill up the parameters structure from the member variables.
                 _presentParams.DirtyRectsCount = gsl::narrow<UINT>(_presentDirty.size());
                 _presentParams.pDirtyRects = _presentDirty.data();
 
-                _presentParams.pScrollOffset = &_presentOffset;
-                _presentParams.pScrollRect = &_presentScroll;
-
-                // The scroll rect will be empty if we scrolled >= 1 full screen size.
-                // Present1 doesn't like that. So clear it out. Everything will be dirty anyway.
-                if (IsRectEmpty(&_presentScroll))
+                if (scrolled || regionScrolled)
                 {
-                    _presentParams.pScrollRect = nullptr;
-                    _presentParams.pScrollOffset = nullptr;
+                    // Invalid scroll is in characters, convert it to pixels.
+                    const til::point invalidScroll = scrolled ? _invalidScroll : til::point{ 0, _invalidScrollRegionDelta };
+                    const auto scrollPixels = (invalidScroll * _fontRenderData->GlyphCell());
+
+                    // The scroll rect is the entire field of cells (or the region that scrolled), but in pixels.
+                    til::rectangle scrollArea = scrolled ? til::rectangle{ _invalidMap.size() * _fontRenderData->GlyphCell() } :
+                                                           _invalidScrollRegion.scale_up(_fontRenderData->GlyphCell());
+
+                    // Reduce the size of the rectangle by the scroll.
+                    scrollArea -= til::size{} - scrollPixels;
+
+                    // Assign the area to the present storage
+                    _presentScroll = scrollArea;
+
+                    // Pass the offset.
+                    _presentOffset = scrollPixels;
+
+                    _presentParams.pScrollOffset = &_presentOffset;
+                    _presentParams.pScrollRect = &_presentScroll;
+
+                    // The scroll rect will be empty if we scrolled >= 1 full screen size.
+                    // Present1 doesn't like that. So clear it out. Everything will be dirty anyway.
+                    if (IsRectEmpty(&_presentScroll))
+                    {
+                        _presentParams.pScrollRect = nullptr;
+                        _presentParams.pScrollOffset = nullptr;
+                    }
                 }
             }
 
@@ -1427,6 +1806,7 @@ try
     _allInvalid = false;
 
     _invalidScroll = {};
+    _invalidScrollRegionDelta = 0;
 
     return hr;
 }
@@ -1465,18 +1845,15 @@ CATCH_RETURN()
 //   a perf detriment.
 [[nodiscard]] bool DxEngine::RequiresContinuousRedraw() noexcept
 {
-    // We're only going to request continuous redraw if someone is using
-    // a pixel shader from a path because we cannot tell if those are using the
-    // time parameter or not.
-    // And if they are using time, they probably need it to tick continuously.
-    //
-    // By contrast, the in-built retro effect does NOT need it,
-    // so let's not tick for it and save some amount of performance.
+    // We're only going to request continuous redraw if the loaded pixel
+    // shader reads the time parameter. If it does, it probably needs it to
+    // tick continuously. Shaders that don't, like the in-built retro effect,
+    // only need a new frame when the text under them changes.
     //
     // Finally... if we're not using effects at all... let the render thread
     // go to sleep. It deserves it. That thread works hard. Also it sleeping
     // saves battery power and all sorts of related perf things.
-    return _terminalEffectsEnabled && !_pixelShaderPath.empty();
+    return _TerminalEffectsAnimate();
 }
 
 // Method Description:
@@ -1554,6 +1931,20 @@ void DxEngine::WaitUntilCanRender() noexcept
                 hr = _dxgiSwapChain->Present(1, 0);
                 _firstFrame = false;
 
+                // Only the first frame in the process is part of starting up.
+                static std::atomic<bool> s_reportedStartupMilestone{ false };
+                if (SUCCEEDED(hr) && !s_reportedStartupMilestone.exchange(true))
+                {
+#pragma warning(suppress : 26477 26485 26494 26482 26446 26447) // We don't control TraceLoggingWrite
+                    TraceLoggingWrite(g_hDxRenderProvider,
+                                      "StartupMilestone",
+                                      TraceLoggingDescription("Event emitted when a step of starting up is complete"),
+                                      TraceLoggingWideString(L"FirstFramePresented", "Milestone"),
+                                      TraceLoggingFloat64(::Microsoft::Console::Utils::MillisecondsSinceProcessStart(), "MillisecondsSinceProcessStart"),
+                                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+                }
+
                 // These two error codes are indicated for destroy-and-recreate
                 recreate = hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET;
             }
@@ -1654,6 +2045,48 @@ try
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Paints a row by copying it from the rows we copied out of earlier frames,
+//   if we have it with the same generation and appearance as it has now.
+//   Otherwise the row is remembered, to be cached once this frame is done.
+// Arguments:
+// - targetRow - the row of the viewport to paint
+// Return Value:
+// - S_OK if the row was painted, S_FALSE if it has to be painted as usual.
+[[nodiscard]] HRESULT DxEngine::PaintCachedRow(const size_t targetRow) noexcept
+try
+{
+    if (!_IsRowCacheEnabled() || targetRow >= _rowGenerations.size())
+    {
+        return S_FALSE;
+    }
+
+    // The cursor is drawn along with the text of its row, and so that row
+    // is neither painted from nor put into the cache.
+    const auto& cursorInfo = _drawingContext->cursorInfo;
+    if (cursorInfo.has_value() && gsl::narrow_cast<size_t>(cursorInfo->coordCursor.Y) == targetRow)
+    {
+        return S_FALSE;
+    }
+
+    const auto it = _cachedRowIndex.find({ til::at(_rowGenerations, targetRow), _rowAppearance });
+    if (it == _cachedRowIndex.end())
+    {
+        _rowsToCache.emplace_back(targetRow);
+        return S_FALSE;
+    }
+
+    _cachedRows.splice(_cachedRows.begin(), _cachedRows, it->second);
+
+    LOG_IF_FAILED(_customRenderer->EndClip(_drawingContext.get()));
+
+    // The copy replaces whatever PaintBackground put there, alpha included.
+    const auto offset = D2D1::Point2F(0.0f, static_cast<float>(targetRow * _fontRenderData->GlyphCell().height<size_t>()));
+    _d2dDeviceContext->DrawImage(it->second->second.Get(), &offset, nullptr, D2D1_INTERPOLATION_MODE_NEAREST_NEIGHBOR, D2D1_COMPOSITE_MODE_SOURCE_COPY);
+    return S_OK;
+}
+CATCH_RETURN()
+
 // Routine Description:
 // - Places one line of text onto the screen at the given position
 // Arguments:
@@ -1668,6 +2101,9 @@ CATCH_RETURN()
                                                 const bool /*lineWrapped*/) noexcept
 try
 {
+    // Text painted after gridlines, like that of an overlay, goes over them.
+    LOG_IF_FAILED(_FlushGridLines());
+
     // Calculate positioning of our origin.
     const D2D1_POINT_2F origin = til::point{ coord } * _fontRenderData->GlyphCell();
 
@@ -1682,6 +2118,154 @@ try
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Places many runs of text onto the screen at once.
+// - Shaping the text of a run doesn't depend on any other run, and it's by far
+//   the most expensive part of painting it. When there are enough runs, like on
+//   a full repaint, they're shaped in parallel on the thread pool first. Only
+//   drawing the glyphs has to happen one run after the other, on this thread.
+// Arguments:
+// - runs - the runs of text to draw
+// - pData - The interface to console data structures required for rendering
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxEngine::PaintBufferLines(gsl::span<const BufferLineRun> const runs,
+                                                 const gsl::not_null<IRenderData*> pData) noexcept
+try
+{
+    const auto workers = _PrepareShapingWorkers(runs.size());
+    if (workers == 0)
+    {
+        return RenderEngineBase::PaintBufferLines(runs, pData);
+    }
+
+    // Text painted after gridlines, like that of an overlay, goes over them.
+    LOG_IF_FAILED(_FlushGridLines());
+
+    if (_shapedRuns.size() < runs.size())
+    {
+        _shapedRuns.resize(runs.size());
+    }
+    _shapingResults.assign(runs.size(), E_UNEXPECTED);
+    _shapingRuns = runs;
+    _shapingNextRun.store(0, std::memory_order_relaxed);
+    _shapingWorkersStarted.store(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < workers; ++i)
+    {
+        SubmitThreadpoolWork(_shapingWork.get());
+    }
+    _ShapeRuns(*_customLayout.Get());
+    WaitForThreadpoolWorkCallbacks(_shapingWork.get(), FALSE);
+    _shapingRuns = {};
+
+    const auto glyphCell = _fontRenderData->GlyphCell();
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        const auto& run = til::at(runs, i);
+        RETURN_IF_FAILED(til::at(_shapingResults, i));
+        RETURN_IF_FAILED(UpdateDrawingBrushes(run.attributes, pData, run.usingSoftFont, false));
+
+        const D2D1_POINT_2F origin = til::point{ run.target } * glyphCell;
+        _customLayout->SwapShapedText(til::at(_shapedRuns, i));
+        RETURN_IF_FAILED(_customLayout->DrawShaped(_drawingContext.get(), _customRenderer.Get(), origin.x, origin.y));
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Figures out how many thread pool workers are worth waking up to help
+//   shape the given number of runs, and makes sure they're ready to go.
+// Arguments:
+// - runCount - the number of runs to shape
+// Return Value:
+// - The number of workers to submit. 0 if the runs are better off shaped
+//   one after the other by PaintBufferLine.
+[[nodiscard]] size_t DxEngine::_PrepareShapingWorkers(const size_t runCount) noexcept
+try
+{
+    // The render thread is one of the threads doing the shaping.
+    const auto threads = std::min<size_t>({ std::thread::hardware_concurrency(),
+                                            MaxShapingThreads,
+                                            runCount / MinRunsPerShapingThread });
+    if (threads < 2 || !_customLayout)
+    {
+        return 0;
+    }
+
+    if (!_shapingWork)
+    {
+        _shapingWork.reset(CreateThreadpoolWork(&_ShapingWorkCallback, this, nullptr));
+        THROW_LAST_ERROR_IF(!_shapingWork);
+    }
+
+    while (_shapingLayouts.size() < threads - 1)
+    {
+        auto layout = WRL::Make<CustomTextLayout>(_fontRenderData.get());
+        THROW_IF_NULL_ALLOC(layout.Get());
+        _shapingLayouts.emplace_back(std::move(layout));
+    }
+
+    return threads - 1;
+}
+catch (...)
+{
+    LOG_CAUGHT_EXCEPTION();
+    return 0;
+}
+
+// Routine Description:
+// - Shapes runs until there are none left, taking the next one from
+//   _shapingRuns every time. The results end up in _shapedRuns and
+//   _shapingResults, at the index of the run.
+// Arguments:
+// - layout - the layout to shape the runs with. Nobody else may use it meanwhile.
+// Return Value:
+// - <none>
+void DxEngine::_ShapeRuns(CustomTextLayout& layout) noexcept
+{
+    for (;;)
+    {
+        const auto i = _shapingNextRun.fetch_add(1, std::memory_order_relaxed);
+        if (i >= _shapingRuns.size())
+        {
+            break;
+        }
+
+        const auto& run = til::at(_shapingRuns, i);
+        auto hr = layout.Reset();
+        if (SUCCEEDED(hr))
+        {
+            hr = layout.AppendClusters(run.clusters);
+        }
+        if (SUCCEEDED(hr))
+        {
+            hr = layout.Shape(run.attributes.IsBold(), run.attributes.IsItalic());
+        }
+        if (SUCCEEDED(hr))
+        {
+            layout.SwapShapedText(til::at(_shapedRuns, i));
+        }
+        til::at(_shapingResults, i) = hr;
+    }
+}
+
+// Routine Description:
+// - The thread pool callback of the shaping workers. Every worker that's
+//   started takes the next of the shaping layouts, and shapes runs with it.
+// Arguments:
+// - context - the DxEngine
+// Return Value:
+// - <none>
+void CALLBACK DxEngine::_ShapingWorkCallback(PTP_CALLBACK_INSTANCE /*instance*/, void* context, PTP_WORK /*work*/) noexcept
+{
+    const auto engine = static_cast<DxEngine*>(context);
+    const auto worker = engine->_shapingWorkersStarted.fetch_add(1, std::memory_order_relaxed);
+    engine->_ShapeRuns(*til::at(engine->_shapingLayouts, worker).Get());
+}
+
 // Routine Description:
 // - Paints lines around cells (draws in pieces of the grid)
 // Arguments:
@@ -1698,21 +2282,19 @@ CATCH_RETURN()
                                                      COORD const coordTarget) noexcept
 try
 {
-    const auto existingColor = _d2dBrushForeground->GetColor();
-    const auto restoreBrushOnExit = wil::scope_exit([&]() noexcept { _d2dBrushForeground->SetColor(existingColor); });
-
-    _d2dBrushForeground->SetColor(_ColorFFromColorRef(color));
-
     const D2D1_SIZE_F font = _fontRenderData->GlyphCell();
     const D2D_POINT_2F target = { coordTarget.X * font.width, coordTarget.Y * font.height };
     const auto fullRunWidth = font.width * gsl::narrow_cast<unsigned>(cchLine);
 
-    const auto DrawLine = [=](const auto x0, const auto y0, const auto x1, const auto y1, const auto strokeWidth) noexcept {
-        _d2dDeviceContext->DrawLine({ x0, y0 }, { x1, y1 }, _d2dBrushForeground.Get(), strokeWidth, _strokeStyle.Get());
+    // Hyperlink-heavy output and diffs easily make for thousands of lines
+    // a frame. Instead of drawing each of them on its own, they're queued
+    // up and drawn together by _FlushGridLines.
+    const auto DrawLine = [&](const auto x0, const auto y0, const auto x1, const auto y1, const auto strokeWidth) {
+        _queuedGridLines.push_back({ { x0, y0 }, { x1, y1 }, color, strokeWidth, _strokeStyle.Get() });
     };
 
-    const auto DrawHyperlinkLine = [=](const auto x0, const auto y0, const auto x1, const auto y1, const auto strokeWidth) noexcept {
-        _d2dDeviceContext->DrawLine({ x0, y0 }, { x1, y1 }, _d2dBrushForeground.Get(), strokeWidth, _hyperlinkStrokeStyle.Get());
+    const auto DrawHyperlinkLine = [&](const auto x0, const auto y0, const auto x1, const auto y1, const auto strokeWidth) {
+        _queuedGridLines.push_back({ { x0, y0 }, { x1, y1 }, color, strokeWidth, _hyperlinkStrokeStyle.Get() });
     };
 
     // NOTE: Line coordinates are centered within the line, so they need to be
@@ -1805,6 +2387,135 @@ try
 }
 CATCH_RETURN()
 
+// Routine Description:
+// - Draws the gridlines queued up by PaintBufferGridLines. Lines of the same
+//   color, width and stroke style are drawn with a single path geometry.
+// - This must run before anything is painted that could overlap the lines,
+//   so that they keep their place in the painting order.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::_FlushGridLines() noexcept
+try
+{
+    if (_queuedGridLines.empty())
+    {
+        return S_OK;
+    }
+
+    const auto clearOnExit = wil::scope_exit([&]() noexcept { _queuedGridLines.clear(); });
+
+    const auto existingColor = _d2dBrushForeground->GetColor();
+    const auto restoreBrushOnExit = wil::scope_exit([&]() noexcept { _d2dBrushForeground->SetColor(existingColor); });
+
+    // Bring the lines that are drawn alike next to each other.
+    std::stable_sort(_queuedGridLines.begin(), _queuedGridLines.end(), [](const auto& a, const auto& b) {
+        if (a.color != b.color)
+        {
+            return a.color < b.color;
+        }
+        if (a.strokeWidth != b.strokeWidth)
+        {
+            return a.strokeWidth < b.strokeWidth;
+        }
+        return std::less<>{}(a.strokeStyle, b.strokeStyle);
+    });
+
+    for (auto begin = _queuedGridLines.begin(); begin != _queuedGridLines.end();)
+    {
+        const auto color = begin->color;
+        const auto strokeWidth = begin->strokeWidth;
+        const auto strokeStyle = begin->strokeStyle;
+        const auto end = std::find_if(begin, _queuedGridLines.end(), [&](const auto& line) {
+            return line.color != color || line.strokeWidth != strokeWidth || line.strokeStyle != strokeStyle;
+        });
+
+        _d2dBrushForeground->SetColor(_ColorFFromColorRef(color));
+
+        // A geometry isn't worth building for a single line.
+        if (end - begin == 1)
+        {
+            _d2dDeviceContext->DrawLine(begin->from, begin->to, _d2dBrushForeground.Get(), strokeWidth, strokeStyle);
+        }
+        else
+        {
+            ::Microsoft::WRL::ComPtr<ID2D1PathGeometry> geometry;
+            RETURN_IF_FAILED(_d2dFactory->CreatePathGeometry(geometry.GetAddressOf()));
+
+            ::Microsoft::WRL::ComPtr<ID2D1GeometrySink> sink;
+            RETURN_IF_FAILED(geometry->Open(sink.GetAddressOf()));
+            for (auto line = begin; line != end; ++line)
+            {
+                sink->BeginFigure(line->from, D2D1_FIGURE_BEGIN_HOLLOW);
+                sink->AddLine(line->to);
+                sink->EndFigure(D2D1_FIGURE_END_OPEN);
+            }
+            RETURN_IF_FAILED(sink->Close());
+
+            _d2dDeviceContext->DrawGeometry(geometry.Get(), _d2dBrushForeground.Get(), strokeWidth, strokeStyle);
+        }
+
+        begin = end;
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Paints a slice of an image over the text of a row. The slice is uploaded
+//   to a bitmap the first time it's painted, and drawn from the cache after
+//   that, scaled to the cells it covers.
+// Arguments:
+// - imageSlice - the slice to paint
+// - target - the screen position of the first cell the slice covers
+// Return Value:
+// - S_OK or relevant DirectX error.
+[[nodiscard]] HRESULT DxEngine::PaintImageSlice(const ImageSlice& imageSlice,
+                                                const COORD target) noexcept
+try
+{
+    // The image is painted over the text and its gridlines.
+    LOG_IF_FAILED(_FlushGridLines());
+    LOG_IF_FAILED(_customRenderer->EndClip(_drawingContext.get()));
+
+    auto& cached = _imageSliceCache[imageSlice.Id()];
+    if (!cached.bitmap)
+    {
+        const auto size = imageSlice.PixelSize();
+        const auto properties = D2D1::BitmapProperties(D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED));
+        RETURN_IF_FAILED(_d2dDeviceContext->CreateBitmap(D2D1::SizeU(size.width<UINT32>(), size.height<UINT32>()),
+                                                         imageSlice.Pixels().data(),
+                                                         size.width<UINT32>() * sizeof(uint32_t),
+                                                         properties,
+                                                         &cached.bitmap));
+    }
+    cached.used = true;
+
+    const auto columns = gsl::narrow_cast<ptrdiff_t>(imageSlice.ColumnEnd() - imageSlice.ColumnBegin());
+    const til::rectangle cells{ til::point{ target }, til::size{ columns, 1 } };
+    const D2D1_RECT_F destination = cells.scale_up(_fontRenderData->GlyphCell());
+
+    // Only the invalid parts of the row are painted. Everywhere else the
+    // image is still on screen from an earlier frame, and painting it again
+    // would blend its (filtered) edges over themselves.
+    for (const auto& run : _invalidMap.runs())
+    {
+        const auto dirty = run & cells;
+        if (!dirty.empty())
+        {
+            const D2D1_RECT_F clip = dirty.scale_up(_fontRenderData->GlyphCell());
+            _d2dDeviceContext->PushAxisAlignedClip(clip, D2D1_ANTIALIAS_MODE_ALIASED);
+            _d2dDeviceContext->DrawBitmap(cached.bitmap.Get(), destination, 1.0f, D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+            _d2dDeviceContext->PopAxisAlignedClip();
+        }
+    }
+
+    return S_OK;
+}
+CATCH_RETURN()
+
 // Routine Description:
 // - Paints an overlay highlight on a portion of the frame to represent selected text
 // Arguments:
@@ -1814,6 +2525,9 @@ CATCH_RETURN()
 [[nodiscard]] HRESULT DxEngine::PaintSelection(const SMALL_RECT rect) noexcept
 try
 {
+    // The selection is painted over the gridlines.
+    LOG_IF_FAILED(_FlushGridLines());
+
     // If a clip rectangle is in place from drawing the text layer, remove it here.
     LOG_IF_FAILED(_customRenderer->EndClip(_drawingContext.get()));
 
@@ -1826,6 +2540,13 @@ try
 
     _d2dDeviceContext->FillRectangle(draw, _d2dBrushForeground.Get());
 
+    // The rows look different now than their text does, so they mustn't
+    // end up in the row cache.
+    for (auto row = std::max<SHORT>(rect.Top, 0); row < rect.Bottom && gsl::narrow_cast<size_t>(row) < _rowsPaintedOver.size(); row++)
+    {
+        _rowsPaintedOver.at(row) = true;
+    }
+
     return S_OK;
 }
 CATCH_RETURN()
@@ -1853,10 +2574,15 @@ try
     // Should have been initialized.
     RETURN_HR_IF(E_NOT_VALID_STATE, !_framebufferCapture);
 
-    // Capture current frame in swap chain to a texture.
-    ::Microsoft::WRL::ComPtr<ID3D11Texture2D> swapBuffer;
-    RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&swapBuffer)));
-    _d3dDeviceContext->CopyResource(_framebufferCapture.Get(), swapBuffer.Get());
+    // Capture current frame in swap chain to a texture. If nothing was drawn
+    // this frame, the capture still holds the last one, without the effect
+    // applied, which is exactly what we need.
+    if (_terminalEffectsInputChanged)
+    {
+        ::Microsoft::WRL::ComPtr<ID3D11Texture2D> swapBuffer;
+        RETURN_IF_FAILED(_dxgiSwapChain->GetBuffer(0, IID_PPV_ARGS(&swapBuffer)));
+        _d3dDeviceContext->CopyResource(_framebufferCapture.Get(), swapBuffer.Get());
+    }
 
     // Prepare captured texture as input resource to shader program.
     D3D11_TEXTURE2D_DESC desc;
@@ -1875,6 +2601,22 @@ try
     const UINT stride = sizeof(ShaderInput);
     const UINT offset = 0;
 
+    // Setup the viewport.
+    D3D11_VIEWPORT vp;
+    vp.Width = _displaySizePixels.width<float>();
+    vp.Height = _displaySizePixels.height<float>();
+    vp.MinDepth = 0.0f;
+    vp.MaxDepth = 1.0f;
+    vp.TopLeftX = 0;
+    vp.TopLeftY = 0;
+
+    // The device context is shared with the other engines. Don't let them change its state halfway through.
+    const auto lock = _sharedDevice->Lock();
+
+    // Update the time, and whatever else changed since the last frame.
+    _ComputePixelShaderSettings();
+
+    _d3dDeviceContext->RSSetViewports(1, &vp);
     _d3dDeviceContext->OMSetRenderTargets(1, _renderTargetView.GetAddressOf(), nullptr);
     _d3dDeviceContext->IASetVertexBuffers(0, 1, _screenQuadVertexBuffer.GetAddressOf(), &stride, &offset);
     _d3dDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
@@ -1902,6 +2644,34 @@ CATCH_RETURN()
     return _forceFullRepaintRendering || _HasTerminalEffects();
 }
 
+// Routine Description:
+// - Retrieves the colors of the given attributes from the render data, unless
+//   they were already retrieved for this frame.
+// Arguments:
+// - textAttributes - Text attributes to get the colors of
+// - pData - The interface to console data structures required for rendering
+// Return Value:
+// - The foreground and background colors of the attributes.
+std::pair<COLORREF, COLORREF> DxEngine::_ResolveAttributeColors(const TextAttribute& textAttributes, const gsl::not_null<IRenderData*> pData) noexcept
+{
+    for (size_t i = 0; i < _resolvedColorsCount; ++i)
+    {
+        const auto& entry = til::at(_resolvedColors, i);
+        if (entry.attributes == textAttributes)
+        {
+            return entry.colors;
+        }
+    }
+
+    const auto colors = pData->GetAttributeColors(textAttributes);
+
+    til::at(_resolvedColors, _resolvedColorsNext) = { textAttributes, colors };
+    _resolvedColorsNext = (_resolvedColorsNext + 1) % ResolvedColorsCacheSize;
+    _resolvedColorsCount = std::min(_resolvedColorsCount + 1, ResolvedColorsCacheSize);
+
+    return colors;
+}
+
 // Routine Description:
 // - Updates the default brush colors used for drawing
 // Arguments:
@@ -1913,7 +2683,7 @@ CATCH_RETURN()
 // - S_OK or relevant DirectX error.
 [[nodiscard]] HRESULT DxEngine::UpdateDrawingBrushes(const TextAttribute& textAttributes,
                                                      const gsl::not_null<IRenderData*> pData,
-                                                     const bool /*usingSoftFont*/,
+                                                     const bool usingSoftFont,
                                                      const bool isSettingDefaultBrushes) noexcept
 {
     // GH#5098: If we're rendering with cleartype text, we need to always render
@@ -1927,7 +2697,9 @@ CATCH_RETURN()
     const bool usingTransparency = _defaultTextBackgroundOpacity != 1.0f;
     const bool forceOpaqueBG = usingCleartype && !usingTransparency;
 
-    const auto [colorForeground, colorBackground] = pData->GetAttributeColors(textAttributes);
+    const auto [colorForeground, colorBackground] = _isPainting && !isSettingDefaultBrushes ?
+                                                        _ResolveAttributeColors(textAttributes, pData) :
+                                                        pData->GetAttributeColors(textAttributes);
 
     _foregroundColor = _ColorFFromColorRef(OPACITY_OPAQUE | colorForeground);
     _backgroundColor = _ColorFFromColorRef((forceOpaqueBG ? OPACITY_OPAQUE : 0) | colorBackground);
@@ -1962,6 +2734,7 @@ CATCH_RETURN()
         _drawingContext->forceGrayscaleAA = _ShouldForceGrayscaleAA();
         _drawingContext->useBoldFont = textAttributes.IsBold();
         _drawingContext->useItalicFont = textAttributes.IsItalic();
+        _drawingContext->useSoftFont = usingSoftFont;
     }
 
     if (textAttributes.IsHyperlink())
@@ -1969,9 +2742,6 @@ CATCH_RETURN()
         _hyperlinkStrokeStyle = (textAttributes.GetHyperlinkId() == _hyperlinkHoveredId) ? _strokeStyle : _dashStrokeStyle;
     }
 
-    // Update pixel shader settings as background color might have changed
-    _ComputePixelShaderSettings();
-
     return S_OK;
 }
 
@@ -2000,11 +2770,51 @@ CATCH_RETURN()
 [[nodiscard]] HRESULT DxEngine::UpdateFont(const FontInfoDesired& pfiFontInfoDesired, FontInfo& fiFontInfo, const std::unordered_map<std::wstring_view, uint32_t>& features, const std::unordered_map<std::wstring_view, float>& axes) noexcept
 try
 {
-    RETURN_IF_FAILED(_fontRenderData->UpdateFont(pfiFontInfoDesired, fiFontInfo, _dpi, features, axes));
+    // Other engines using the same font share their render data with us.
+    // The render data we're replacing is kept alive for one more change, so
+    // that moving a window back to the monitor it came from doesn't have to
+    // build the fonts and their metrics for that DPI again.
+    auto previousFontRenderData = _fontRenderData;
+    RETURN_IF_FAILED(DxFontRenderData::s_Acquire(_dwriteFactory, pfiFontInfoDesired, fiFontInfo, _dpi, features, axes, _fontRenderData));
+    if (previousFontRenderData != _fontRenderData)
+    {
+        _previousFontRenderData = std::move(previousFontRenderData);
+    }
 
-    // Prepare the text layout.
+    // Prepare the text layout. The shaping workers get theirs when they're needed.
     _customLayout = WRL::Make<CustomTextLayout>(_fontRenderData.get());
+    _shapingLayouts.clear();
+    _ClearCachedRows();
+
+    // The soft font has to be scaled to the new cell size as well.
+    if (const til::size glyphCell{ _fontRenderData->GlyphCell() }; _softFont.GetTargetSize() != glyphCell)
+    {
+        _softFont.SetTargetSize(glyphCell);
+        _softFontAtlas.Reset();
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
 
+// Routine Description:
+// - This method will replace the active soft font with the given bit pattern.
+// Arguments:
+// - bitPattern - An array of scanlines representing all the glyphs in the font.
+// - cellSize - The cell size for an individual glyph.
+// - centeringHint - The horizontal extent that glyphs are offset from center.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT DxEngine::UpdateSoftFont(const gsl::span<const uint16_t> bitPattern,
+                                               const SIZE cellSize,
+                                               const size_t centeringHint) noexcept
+try
+{
+    // The glyphs are scaled and uploaded on the next frame that needs them.
+    const auto targetSize = _fontRenderData ? til::size{ _fontRenderData->GlyphCell() } : til::size{ cellSize };
+    _softFont = { bitPattern, cellSize, targetSize, centeringHint };
+    _softFontAtlas.Reset();
+    _ClearCachedRows();
     return S_OK;
 }
 CATCH_RETURN();
@@ -2038,6 +2848,7 @@ CATCH_RETURN();
     // The scale factor may be necessary for composition contexts, so save it once here.
     _scale = _dpi / static_cast<float>(USER_DEFAULT_SCREEN_DPI);
 
+    _ClearCachedRows();
     RETURN_IF_FAILED(InvalidateAll());
 
     // Update pixel shader settings as scale might have changed
@@ -2071,19 +2882,20 @@ float DxEngine::GetScaling() const noexcept
 }
 
 // Routine Description:
-// - Currently unused by this renderer
+// - Figures out which font we'd end up with for the given request.
 // Arguments:
-// - pfiFontInfoDesired - <unused>
-// - pfiFontInfo - <unused>
-// - iDpi - <unused>
+// - pfiFontInfoDesired - Information specifying the font that is requested
+// - pfiFontInfo - Filled with the nearest font actually chosen for drawing
+// - iDpi - The DPI of the screen
 // Return Value:
-// - S_OK
+// - S_OK or relevant DirectX error
 [[nodiscard]] HRESULT DxEngine::GetProposedFont(const FontInfoDesired& pfiFontInfoDesired,
                                                 FontInfo& pfiFontInfo,
                                                 int const iDpi) noexcept
 {
-    DxFontRenderData fontRenderData(_dwriteFactory);
-    return fontRenderData.UpdateFont(pfiFontInfoDesired, pfiFontInfo, iDpi);
+    // If another engine is already using this font, this doesn't have to build anything.
+    std::shared_ptr<DxFontRenderData> fontRenderData;
+    return DxFontRenderData::s_Acquire(_dwriteFactory, pfiFontInfoDesired, pfiFontInfo, iDpi, {}, {}, fontRenderData);
 }
 
 // Routine Description:
@@ -2234,6 +3046,7 @@ void DxEngine::SetDefaultTextBackgroundOpacity(const float opacity) noexcept
 try
 {
     _defaultTextBackgroundOpacity = opacity;
+    _ClearCachedRows();
 
     // Make sure we redraw all the cells, to update whether they're actually
     // drawn with cleartype or not.
@@ -2249,6 +3062,11 @@ CATCH_LOG()
 // - The new link ID we are hovering over
 void DxEngine::UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept
 {
+    // The cached rows were painted with the old link underlined.
+    if (_hyperlinkHoveredId != hoveredId)
+    {
+        _ClearCachedRows();
+    }
     _hyperlinkHoveredId = hoveredId;
 }
 
@@ -2264,7 +3082,14 @@ void DxEngine::UpdateHyperlinkHoveredId(const uint16_t hoveredId) noexcept
 // Return Value:
 // - S_OK
 [[nodiscard]] HRESULT DxEngine::PrepareRenderInfo(const RenderFrameInfo& info) noexcept
+try
 {
     _drawingContext->cursorInfo = info.cursorInfo;
+
+    _rowGenerations.assign(info.rowGenerations.begin(), info.rowGenerations.end());
+    _rowAppearance = info.rowAppearance;
+    _rowsToCache.clear();
+    _rowsPaintedOver.assign(_rowGenerations.size(), false);
     return S_OK;
 }
+CATCH_RETURN()
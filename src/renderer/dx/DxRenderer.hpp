@@ -4,8 +4,11 @@
 #pragma once
 
 #include "../../renderer/inc/RenderEngineBase.hpp"
+#include "../../renderer/inc/FontResource.hpp"
 
 #include <functional>
+#include <list>
+#include <thread>
 
 #include <dxgi.h>
 #include <dxgi1_2.h>
@@ -27,6 +30,7 @@
 #include "CustomTextLayout.h"
 #include "CustomTextRenderer.h"
 #include "DxFontRenderData.h"
+#include "DxSharedDevice.h"
 
 #include "../../types/inc/Viewport.hpp"
 
@@ -72,12 +76,24 @@ namespace Microsoft::Console::Render
 
         HANDLE GetSwapChainHandle();
 
+        // The memory this engine holds, in bytes. The GPU resources are
+        // estimated from their size and format.
+        struct MemoryUsage
+        {
+            size_t swapChain{ 0 };
+            size_t intermediateTargets{ 0 };
+            size_t glyphCaches{ 0 };
+        };
+
+        MemoryUsage GetMemoryUsage() const noexcept;
+
         // IRenderEngine Members
         [[nodiscard]] HRESULT Invalidate(const SMALL_RECT* const psrRegion) noexcept override;
         [[nodiscard]] HRESULT InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept override;
         [[nodiscard]] HRESULT InvalidateSystem(const RECT* const prcDirtyClient) noexcept override;
         [[nodiscard]] HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept override;
         [[nodiscard]] HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override;
+        [[nodiscard]] HRESULT InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const COORD* const pcoordDelta) noexcept override;
         [[nodiscard]] HRESULT InvalidateAll() noexcept override;
         [[nodiscard]] HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept override;
         [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override;
@@ -95,12 +111,17 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT PrepareRenderInfo(const RenderFrameInfo& info) noexcept override;
 
         [[nodiscard]] HRESULT PaintBackground() noexcept override;
+        [[nodiscard]] HRESULT PaintCachedRow(const size_t targetRow) noexcept override;
         [[nodiscard]] HRESULT PaintBufferLine(gsl::span<const Cluster> const clusters,
                                               COORD const coord,
                                               bool const fTrimLeft,
                                               const bool lineWrapped) noexcept override;
+        [[nodiscard]] HRESULT PaintBufferLines(gsl::span<const BufferLineRun> const runs,
+                                               const gsl::not_null<IRenderData*> pData) noexcept override;
 
         [[nodiscard]] HRESULT PaintBufferGridLines(GridLines const lines, COLORREF const color, size_t const cchLine, COORD const coordTarget) noexcept override;
+        [[nodiscard]] HRESULT PaintImageSlice(const ImageSlice& imageSlice,
+                                              const COORD target) noexcept override;
         [[nodiscard]] HRESULT PaintSelection(const SMALL_RECT rect) noexcept override;
 
         [[nodiscard]] HRESULT PaintCursor(const CursorOptions& options) noexcept override;
@@ -111,6 +132,9 @@ namespace Microsoft::Console::Render
                                                    const bool isSettingDefaultBrushes) noexcept override;
         [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo) noexcept override;
         [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo, const std::unordered_map<std::wstring_view, uint32_t>& features, const std::unordered_map<std::wstring_view, float>& axes) noexcept;
+        [[nodiscard]] HRESULT UpdateSoftFont(const gsl::span<const uint16_t> bitPattern,
+                                             const SIZE cellSize,
+                                             const size_t centeringHint) noexcept override;
         [[nodiscard]] HRESULT UpdateDpi(int const iDpi) noexcept override;
         [[nodiscard]] HRESULT UpdateViewport(const SMALL_RECT srNewViewport) noexcept override;
 
@@ -167,12 +191,29 @@ namespace Microsoft::Console::Render
         D2D1_COLOR_F _backgroundColor;
         D2D1_COLOR_F _selectionBackground;
 
+        // The colors of the attributes most recently resolved in this frame.
+        // The colors can't change while a frame is painted, and a frame
+        // usually only uses a few attributes, over and over again.
+        struct ResolvedColors
+        {
+            TextAttribute attributes;
+            std::pair<COLORREF, COLORREF> colors;
+        };
+        static constexpr size_t ResolvedColorsCacheSize = 8;
+        std::array<ResolvedColors, ResolvedColorsCacheSize> _resolvedColors;
+        size_t _resolvedColorsCount;
+        size_t _resolvedColorsNext;
+
         uint16_t _hyperlinkHoveredId;
 
         bool _firstFrame;
         std::pmr::unsynchronized_pool_resource _pool;
         til::pmr::bitmap _invalidMap;
         til::point _invalidScroll;
+        // A scroll of only some rows (like those between the scrolling margins).
+        // Only one of these can be presented per frame, and not together with _invalidScroll.
+        til::rectangle _invalidScrollRegion;
+        ptrdiff_t _invalidScrollRegionDelta;
         bool _allInvalid;
 
         bool _presentReady;
@@ -191,11 +232,26 @@ namespace Microsoft::Console::Render
         ::Microsoft::WRL::ComPtr<IDWriteFactory1> _dwriteFactory;
         ::Microsoft::WRL::ComPtr<CustomTextLayout> _customLayout;
         ::Microsoft::WRL::ComPtr<CustomTextRenderer> _customRenderer;
+
+        // Large batches of runs are shaped on the thread pool, with the render
+        // thread (and _customLayout) lending a hand. Every worker has a layout
+        // (and so a layout cache) of its own. Only drawing the shaped runs is
+        // left to the render thread. See PaintBufferLines.
+        static constexpr size_t MaxShapingThreads = 8;
+        static constexpr size_t MinRunsPerShapingThread = 16;
+        wil::unique_threadpool_work _shapingWork;
+        std::vector<::Microsoft::WRL::ComPtr<CustomTextLayout>> _shapingLayouts;
+        std::vector<CustomTextLayout::ShapedText> _shapedRuns;
+        std::vector<HRESULT> _shapingResults;
+        gsl::span<const BufferLineRun> _shapingRuns;
+        std::atomic<size_t> _shapingNextRun{ 0 };
+        std::atomic<size_t> _shapingWorkersStarted{ 0 };
         ::Microsoft::WRL::ComPtr<ID2D1StrokeStyle> _strokeStyle;
         ::Microsoft::WRL::ComPtr<ID2D1StrokeStyle> _dashStrokeStyle;
         ::Microsoft::WRL::ComPtr<ID2D1StrokeStyle> _hyperlinkStrokeStyle;
 
-        std::unique_ptr<DxFontRenderData> _fontRenderData;
+        std::shared_ptr<DxFontRenderData> _fontRenderData;
+        std::shared_ptr<DxFontRenderData> _previousFontRenderData;
 
         D2D1_STROKE_STYLE_PROPERTIES _strokeStyleProperties;
         D2D1_STROKE_STYLE_PROPERTIES _dashStrokeStyleProperties;
@@ -203,6 +259,7 @@ namespace Microsoft::Console::Render
         // Device-Dependent Resources
         bool _recreateDeviceRequested;
         bool _haveDeviceResources;
+        std::shared_ptr<DxSharedDevice> _sharedDevice;
         ::Microsoft::WRL::ComPtr<ID3D11Device> _d3dDevice;
         ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> _d3dDeviceContext;
 
@@ -222,6 +279,72 @@ namespace Microsoft::Console::Render
         wil::unique_handle _swapChainFrameLatencyWaitableObject;
         std::unique_ptr<DrawingContext> _drawingContext;
 
+        // The soft font glyphs, scaled to the glyph cell, and the alpha mask
+        // we draw them from. The mask is only rebuilt when either changes.
+        FontResource _softFont;
+        ::Microsoft::WRL::ComPtr<ID2D1Bitmap> _softFontAtlas;
+
+        // The image slices we uploaded, by their ImageSlice::Id. Slices never
+        // change, so an entry is only ever dropped to make room: once there
+        // are more than MaxCachedImageSlices, whatever the last frame didn't
+        // paint goes. See _TrimImageSliceCache.
+        struct CachedImageSlice
+        {
+            ::Microsoft::WRL::ComPtr<ID2D1Bitmap> bitmap;
+            bool used = false;
+        };
+        static constexpr size_t MaxCachedImageSlices = 256;
+        std::unordered_map<uint64_t, CachedImageSlice> _imageSliceCache;
+
+        // Copies of the rows we painted, keyed by their generation and the
+        // row appearance (see RenderFrameInfo), most recently used first.
+        // When the viewport is scrolled back to rows we've painted before,
+        // PaintCachedRow copies them back, instead of the text of every row
+        // being laid out and drawn again. Rows are copied into the cache at
+        // the end of the frame they were painted in, by _CacheRows.
+        struct CachedRowKey
+        {
+            uint64_t generation;
+            uint64_t appearance;
+
+            bool operator==(const CachedRowKey& other) const noexcept
+            {
+                return generation == other.generation && appearance == other.appearance;
+            }
+        };
+        struct CachedRowKeyHash
+        {
+            size_t operator()(const CachedRowKey& key) const noexcept
+            {
+                return std::hash<uint64_t>{}(key.generation ^ (key.appearance * 0x9E3779B97F4A7C15ull));
+            }
+        };
+        using CachedRowList = std::list<std::pair<CachedRowKey, ::Microsoft::WRL::ComPtr<ID2D1Bitmap1>>>;
+        // The cache holds this many screens' worth of rows.
+        static constexpr size_t CachedRowScreens = 4;
+        CachedRowList _cachedRows;
+        std::unordered_map<CachedRowKey, CachedRowList::iterator, CachedRowKeyHash> _cachedRowIndex;
+        til::size _cachedRowSize;
+        std::vector<uint64_t> _rowGenerations;
+        uint64_t _rowAppearance{ 0 };
+        // The rows PaintCachedRow didn't have this frame, and those that had
+        // anything painted over them (and so must not be cached).
+        std::vector<size_t> _rowsToCache;
+        std::vector<bool> _rowsPaintedOver;
+
+        // PaintBufferGridLines only queues its lines up here. They're drawn
+        // by _FlushGridLines with one geometry per color and stroke, before
+        // anything else is painted over them.
+        struct QueuedGridLine
+        {
+            D2D1_POINT_2F from;
+            D2D1_POINT_2F to;
+            COLORREF color;
+            float strokeWidth;
+            ID2D1StrokeStyle* strokeStyle;
+        };
+        std::vector<QueuedGridLine> _queuedGridLines;
+
         // Terminal effects resources.
 
         // Controls if configured terminal effects are enabled
@@ -238,6 +361,14 @@ namespace Microsoft::Console::Render
         std::wstring _pixelShaderPath;
         bool _pixelShaderLoaded{ false };
 
+        // Whether the loaded pixel shader reads the Time constant. If it
+        // doesn't, its output only changes when the frame under it does.
+        bool _pixelShaderUsesTime{ true };
+
+        // Whether anything was drawn into the frame this paint. If not, the
+        // effect pass can reuse the previous frame in _framebufferCapture.
+        bool _terminalEffectsInputChanged{ true };
+
         std::chrono::steady_clock::time_point _shaderStartTime;
 
         // DX resources needed for terminal effects
@@ -277,13 +408,24 @@ namespace Microsoft::Console::Render
         bool _HasTerminalEffects() const noexcept;
         std::string _LoadPixelShaderFile() const;
         HRESULT _SetupTerminalEffects();
+        [[nodiscard]] HRESULT _PrepareTerminalEffectsTarget() noexcept;
+        bool _TerminalEffectsAnimate() const noexcept;
         void _ComputePixelShaderSettings() noexcept;
 
         [[nodiscard]] HRESULT _PrepareRenderTarget() noexcept;
+        [[nodiscard]] HRESULT _PrepareSoftFontAtlas() noexcept;
+        void _TrimImageSliceCache() noexcept;
+        [[nodiscard]] size_t _PrepareShapingWorkers(const size_t runCount) noexcept;
+        void _ShapeRuns(CustomTextLayout& layout) noexcept;
+        static void CALLBACK _ShapingWorkCallback(PTP_CALLBACK_INSTANCE instance, void* context, PTP_WORK work) noexcept;
+        bool _IsRowCacheEnabled() const noexcept;
+        [[nodiscard]] HRESULT _CacheRows() noexcept;
+        void _ClearCachedRows() noexcept;
 
         void _ReleaseDeviceResources() noexcept;
 
         bool _ShouldForceGrayscaleAA() noexcept;
+        std::pair<COLORREF, COLORREF> _ResolveAttributeColors(const TextAttribute& textAttributes, const gsl::not_null<IRenderData*> pData) noexcept;
 
         [[nodiscard]] HRESULT _CreateTextLayout(
             _In_reads_(StringLength) PCWCHAR String,
@@ -292,6 +434,8 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT _CopyFrontToBack() noexcept;
 
+        [[nodiscard]] HRESULT _FlushGridLines() noexcept;
+
         [[nodiscard]] HRESULT _EnableDisplayAccess(const bool outputEnabled) noexcept;
 
         [[nodiscard]] til::size _GetClientSize() const;
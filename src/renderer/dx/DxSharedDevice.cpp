@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "DxSharedDevice.h"
+
+using namespace Microsoft::Console::Render;
+
+std::mutex DxSharedDevice::s_mutex;
+std::array<std::weak_ptr<DxSharedDevice>, 2> DxSharedDevice::s_devices;
+
+// Routine Description:
+// - Returns the device shared by all engines in this process, creating it if
+//   there's none yet or if the existing one has been removed (e.g. because the
+//   driver was updated or the GPU reset).
+// Arguments:
+// - softwareRendering - Whether to use the WARP software renderer instead of the GPU
+// - device - Receives the shared device
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxSharedDevice::Acquire(const bool softwareRendering, std::shared_ptr<DxSharedDevice>& device) noexcept
+try
+{
+    const std::scoped_lock guard{ s_mutex };
+
+    auto& slot = til::at(s_devices, softwareRendering ? 1 : 0);
+
+    device = slot.lock();
+    if (device && !device->_IsRemoved())
+    {
+        return S_OK;
+    }
+
+    // Engines still holding on to a removed device will find out on their own
+    // when they present, and come back here for the new one.
+    device = std::make_shared<DxSharedDevice>();
+    RETURN_IF_FAILED(device->_Create(softwareRendering));
+    slot = device;
+
+    return S_OK;
+}
+CATCH_RETURN()
+
+[[nodiscard]] ID2D1Factory1* DxSharedDevice::D2DFactory() const noexcept
+{
+    return _d2dFactory.Get();
+}
+
+[[nodiscard]] ID2D1Device* DxSharedDevice::D2DDevice() const noexcept
+{
+    return _d2dDevice.Get();
+}
+
+[[nodiscard]] ID3D11Device* DxSharedDevice::D3DDevice() const noexcept
+{
+    return _d3dDevice.Get();
+}
+
+[[nodiscard]] ID3D11DeviceContext* DxSharedDevice::D3DDeviceContext() const noexcept
+{
+    return _d3dDeviceContext.Get();
+}
+
+[[nodiscard]] IDXGIDevice* DxSharedDevice::DxgiDevice() const noexcept
+{
+    return _dxgiDevice.Get();
+}
+
+// Routine Description:
+// - Creates the D2D factory and the D3D and D2D devices.
+// Arguments:
+// - softwareRendering - Whether to skip straight to the WARP software renderer
+// Return Value:
+// - S_OK or relevant DirectX error
+[[nodiscard]] HRESULT DxSharedDevice::_Create(const bool softwareRendering) noexcept
+{
+    RETURN_IF_FAILED(D2D1CreateFactory(D2D1_FACTORY_TYPE_MULTI_THREADED, IID_PPV_ARGS(&_d2dFactory)));
+    RETURN_IF_FAILED(_d2dFactory.As(&_multithread));
+
+    // Unlike a device owned by a single engine, this one can't be created
+    // with D3D11_CREATE_DEVICE_SINGLETHREADED, as it's used from every render thread.
+    // When doing DX-specific work, add D3D11_CREATE_DEVICE_DEBUG to enable the debug layer.
+    // It's off by default, since it requires the whole DirectX SDK to be installed. Find out more here:
+    // https://docs.microsoft.com/en-us/windows/desktop/direct3d11/overviews-direct3d-11-devices-layers
+    const DWORD DeviceFlags = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
+
+    const std::array<D3D_FEATURE_LEVEL, 5> FeatureLevels{ D3D_FEATURE_LEVEL_11_1,
+                                                          D3D_FEATURE_LEVEL_11_0,
+                                                          D3D_FEATURE_LEVEL_10_1,
+                                                          D3D_FEATURE_LEVEL_10_0,
+                                                          D3D_FEATURE_LEVEL_9_1 };
+
+    // Trying hardware first for maximum performance, then trying WARP (software) renderer second
+    // in case we're running inside a downlevel VM where hardware passthrough isn't enabled like
+    // for Windows 7 in a VM.
+    HRESULT hardwareResult = E_NOT_SET;
+
+    if (!softwareRendering)
+    {
+        hardwareResult = D3D11CreateDevice(nullptr,
+                                           D3D_DRIVER_TYPE_HARDWARE,
+                                           nullptr,
+                                           DeviceFlags,
+                                           FeatureLevels.data(),
+                                           gsl::narrow_cast<UINT>(FeatureLevels.size()),
+                                           D3D11_SDK_VERSION,
+                                           &_d3dDevice,
+                                           nullptr,
+                                           &_d3dDeviceContext);
+    }
+
+    if (FAILED(hardwareResult))
+    {
+        RETURN_IF_FAILED(D3D11CreateDevice(nullptr,
+                                           D3D_DRIVER_TYPE_WARP,
+                                           nullptr,
+                                           DeviceFlags,
+                                           FeatureLevels.data(),
+                                           gsl::narrow_cast<UINT>(FeatureLevels.size()),
+                                           D3D11_SDK_VERSION,
+                                           &_d3dDevice,
+                                           nullptr,
+                                           &_d3dDeviceContext));
+    }
+
+    // D2D takes the D3D lock whenever it calls into the device, which only works if it's protected.
+    ::Microsoft::WRL::ComPtr<ID3D10Multithread> d3dMultithread;
+    RETURN_IF_FAILED(_d3dDeviceContext.As(&d3dMultithread));
+    d3dMultithread->SetMultithreadProtected(TRUE);
+
+    RETURN_IF_FAILED(_d3dDevice.As(&_dxgiDevice));
+    RETURN_IF_FAILED(_d2dFactory->CreateDevice(_dxgiDevice.Get(), _d2dDevice.ReleaseAndGetAddressOf()));
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Checks whether the D3D device has been removed and needs to be recreated.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if the device is unusable.
+[[nodiscard]] bool DxSharedDevice::_IsRemoved() const noexcept
+{
+    return !_d3dDevice || FAILED(_d3dDevice->GetDeviceRemovedReason());
+}
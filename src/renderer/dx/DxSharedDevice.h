@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include <d2d1_1.h>
+#include <d3d11.h>
+#include <dxgi1_2.h>
+
+#include <wrl.h>
+
+namespace Microsoft::Console::Render
+{
+    // The D3D device, the D2D factory and the D2D device are shared by every
+    // DxEngine in the process. With a dozen panes in a tab that's a dozen
+    // fewer devices, each with its own driver threads and video memory.
+    // The factory is multithreaded, because every engine paints from its
+    // own render thread. Direct calls into the D3D device context have to
+    // happen under Lock(), since its state is shared by all engines.
+    class DxSharedDevice
+    {
+    public:
+        [[nodiscard]] static HRESULT Acquire(const bool softwareRendering, std::shared_ptr<DxSharedDevice>& device) noexcept;
+
+        [[nodiscard]] ID2D1Factory1* D2DFactory() const noexcept;
+        [[nodiscard]] ID2D1Device* D2DDevice() const noexcept;
+        [[nodiscard]] ID3D11Device* D3DDevice() const noexcept;
+        [[nodiscard]] ID3D11DeviceContext* D3DDeviceContext() const noexcept;
+        [[nodiscard]] IDXGIDevice* DxgiDevice() const noexcept;
+
+        [[nodiscard]] auto Lock() const noexcept
+        {
+            _multithread->Enter();
+            return wil::scope_exit([this]() noexcept { _multithread->Leave(); });
+        }
+
+    private:
+        [[nodiscard]] HRESULT _Create(const bool softwareRendering) noexcept;
+        [[nodiscard]] bool _IsRemoved() const noexcept;
+
+        ::Microsoft::WRL::ComPtr<ID2D1Factory1> _d2dFactory;
+        ::Microsoft::WRL::ComPtr<ID2D1Multithread> _multithread;
+        ::Microsoft::WRL::ComPtr<ID3D11Device> _d3dDevice;
+        ::Microsoft::WRL::ComPtr<ID3D11DeviceContext> _d3dDeviceContext;
+        ::Microsoft::WRL::ComPtr<IDXGIDevice> _dxgiDevice;
+        ::Microsoft::WRL::ComPtr<ID2D1Device> _d2dDevice;
+
+        // One device for hardware and one for software rendering.
+        // They're only held weakly, so that the device goes away with its last engine.
+        static std::mutex s_mutex;
+        static std::array<std::weak_ptr<DxSharedDevice>, 2> s_devices;
+    };
+}
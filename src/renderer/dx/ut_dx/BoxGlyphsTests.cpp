@@ -0,0 +1,123 @@
+﻿// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../BoxGlyphs.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+
+class BoxGlyphsTests
+{
+    TEST_CLASS(BoxGlyphsTests);
+
+    // A 10x20 cell with 1px light lines. Single lines are centered at x=4
+    // and y=9, double lines are 3px wide with the strokes at 3 and 5 (or 8
+    // and 10). Arms that meet head on end at the cell's center (5, 10).
+    static constexpr D2D1_SIZE_F CellSize{ 10, 20 };
+
+    static void VerifyRects(const gsl::span<const BoxGlyphs::Rect> actual, const std::initializer_list<D2D1_RECT_F> expected)
+    {
+        VERIFY_ARE_EQUAL(expected.size(), static_cast<size_t>(actual.size()));
+        size_t i = 0;
+        for (const auto& rect : expected)
+        {
+            const auto& got = til::at(actual, i++).rect;
+            Log::Comment(NoThrowString().Format(L"(%g, %g, %g, %g)", got.left, got.top, got.right, got.bottom));
+            VERIFY_ARE_EQUAL(rect.left, got.left);
+            VERIFY_ARE_EQUAL(rect.top, got.top);
+            VERIFY_ARE_EQUAL(rect.right, got.right);
+            VERIFY_ARE_EQUAL(rect.bottom, got.bottom);
+        }
+    }
+
+    TEST_METHOD(LightCross)
+    {
+        const BoxGlyphs glyphs{ CellSize, 1.0f };
+
+        // ┼ up, right, down, left
+        VerifyRects(glyphs.Lookup(L'\x253C'), {
+                                                  { 4, 0, 5, 10 },
+                                                  { 5, 9, 10, 10 },
+                                                  { 4, 10, 5, 20 },
+                                                  { 0, 9, 5, 10 },
+                                              });
+    }
+
+    TEST_METHOD(LightCornerCoversJoin)
+    {
+        const BoxGlyphs glyphs{ CellSize, 1.0f };
+
+        // ┌ The right arm starts at the left edge of the vertical line,
+        // and the down arm at the top of the horizontal one.
+        VerifyRects(glyphs.Lookup(L'\x250C'), {
+                                                  { 4, 9, 10, 10 },
+                                                  { 4, 9, 5, 20 },
+                                              });
+    }
+
+    TEST_METHOD(DoubleCorner)
+    {
+        const BoxGlyphs glyphs{ CellSize, 1.0f };
+
+        // ╔ The outer strokes meet at (3, 8), the inner ones at (5, 10).
+        VerifyRects(glyphs.Lookup(L'\x2554'), {
+                                                  { 3, 8, 10, 9 },
+                                                  { 5, 10, 10, 11 },
+                                                  { 3, 8, 4, 20 },
+                                                  { 5, 10, 6, 20 },
+                                              });
+    }
+
+    TEST_METHOD(HeavyLinesAreTwiceAsThick)
+    {
+        const BoxGlyphs glyphs{ CellSize, 1.0f };
+
+        // ━
+        VerifyRects(glyphs.Lookup(L'\x2501'), {
+                                                  { 5, 9, 10, 11 },
+                                                  { 0, 9, 5, 11 },
+                                              });
+    }
+
+    TEST_METHOD(BlockElements)
+    {
+        const BoxGlyphs glyphs{ CellSize, 1.0f };
+
+        // █ ▄ ▐
+        VerifyRects(glyphs.Lookup(L'\x2588'), { { 0, 0, 10, 20 } });
+        VerifyRects(glyphs.Lookup(L'\x2584'), { { 0, 10, 10, 20 } });
+        VerifyRects(glyphs.Lookup(L'\x2590'), { { 5, 0, 10, 20 } });
+
+        // ▒ is a full cell at half opacity.
+        const auto shade = glyphs.Lookup(L'\x2592');
+        VERIFY_ARE_EQUAL(1u, static_cast<size_t>(shade.size()));
+        VERIFY_ARE_EQUAL(0.5f, til::at(shade, 0).opacity);
+
+        // ▚ upper left and lower right
+        VerifyRects(glyphs.Lookup(L'\x259A'), {
+                                                  { 0, 0, 5, 10 },
+                                                  { 5, 10, 10, 20 },
+                                              });
+    }
+
+    TEST_METHOD(UnsupportedCharactersAreLeftToTheFont)
+    {
+        const BoxGlyphs glyphs{ CellSize, 1.0f };
+
+        // ┄ dashes, ╭ arcs, ╱ diagonals, and anything outside the range.
+        VERIFY_IS_TRUE(glyphs.Lookup(L'\x2504').empty());
+        VERIFY_IS_TRUE(glyphs.Lookup(L'\x256D').empty());
+        VERIFY_IS_TRUE(glyphs.Lookup(L'\x2571').empty());
+        VERIFY_IS_TRUE(glyphs.Lookup(L'A').empty());
+
+        // A default constructed instance draws nothing itself.
+        VERIFY_IS_TRUE(BoxGlyphs{}.Lookup(L'\x2500').empty());
+    }
+};
@@ -97,4 +97,63 @@ class Microsoft::Console::Render::CustomTextLayoutTests
         VERIFY_ARE_EQUAL(1u, layout._runs.at(1).glyphStart);
         VERIFY_ARE_EQUAL(3u, layout._runs.at(1).glyphCount);
     }
+
+    TEST_METHOD(CachedLayouts)
+    {
+        CustomTextLayout layout;
+        layout._formatInUse = nullptr;
+        layout._width = 8;
+
+        const auto prepare = [&](const std::wstring_view text) {
+            VERIFY_SUCCEEDED(layout.Reset());
+            layout._text = text;
+            layout._textClusterColumns.assign(text.size(), 1);
+        };
+
+        // Pretend we've gone through analysis and shaping for this text.
+        prepare(L"abc");
+        CustomTextLayout::LinkedRun run;
+        run.textLength = 3;
+        run.glyphCount = 3;
+        layout._runs.push_back(run);
+        layout._glyphIndices = { 68, 69, 70 };
+        layout._glyphClusters = { 0, 1, 2 };
+        layout._glyphAdvances = { 8.0f, 8.0f, 8.0f };
+        layout._glyphOffsets.resize(3);
+        layout._StoreCachedLayout(layout._HashLayoutKey());
+
+        Log::Comment(L"The same text restores the stored runs and glyphs.");
+        prepare(L"abc");
+        VERIFY_IS_TRUE(layout._RestoreCachedLayout(layout._HashLayoutKey()));
+        VERIFY_ARE_EQUAL(1u, layout._runs.size());
+        VERIFY_ARE_EQUAL(3u, layout._runs.at(0).glyphCount);
+        VERIFY_ARE_EQUAL(69u, layout._glyphIndices.at(1));
+        VERIFY_ARE_EQUAL(3u, layout._glyphAdvances.size());
+
+        Log::Comment(L"Different text or different cluster columns miss the cache.");
+        prepare(L"abd");
+        VERIFY_IS_FALSE(layout._RestoreCachedLayout(layout._HashLayoutKey()));
+        prepare(L"abc");
+        layout._textClusterColumns.at(2) = 2;
+        VERIFY_IS_FALSE(layout._RestoreCachedLayout(layout._HashLayoutKey()));
+
+        Log::Comment(L"A different cell width misses the cache.");
+        prepare(L"abc");
+        layout._width = 9;
+        VERIFY_IS_FALSE(layout._RestoreCachedLayout(layout._HashLayoutKey()));
+        layout._width = 8;
+
+        Log::Comment(L"Filling up the cache evicts the least recently used entry.");
+        for (size_t i = 0; i < CustomTextLayout::_layoutCacheCapacity; ++i)
+        {
+            prepare(std::to_wstring(i));
+            layout._StoreCachedLayout(layout._HashLayoutKey());
+        }
+        VERIFY_ARE_EQUAL(CustomTextLayout::_layoutCacheCapacity, layout._layoutCache.size());
+        VERIFY_ARE_EQUAL(CustomTextLayout::_layoutCacheCapacity, layout._layoutCacheMap.size());
+        prepare(L"abc");
+        VERIFY_IS_FALSE(layout._RestoreCachedLayout(layout._HashLayoutKey()));
+        prepare(L"1");
+        VERIFY_IS_TRUE(layout._RestoreCachedLayout(layout._HashLayoutKey()));
+    }
 };
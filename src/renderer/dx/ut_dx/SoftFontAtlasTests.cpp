@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../../inc/FontResource.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+
+class SoftFontAtlasTests
+{
+    TEST_CLASS(SoftFontAtlasTests);
+
+    // An 8x4 soft font, where character 1 has only its top left pixel set,
+    // and character 17 (the second one in the second row of the atlas) only
+    // its bottom right one.
+    static constexpr til::size SourceSize{ 8, 4 };
+
+    static std::vector<uint16_t> CreatePattern()
+    {
+        auto pattern = std::vector<uint16_t>(FontResource::CharCount * SourceSize.height<size_t>());
+        til::at(pattern, 1 * 4 + 0) = 0x8000;
+        til::at(pattern, 17 * 4 + 3) = 0x0100;
+        return pattern;
+    }
+
+    static std::vector<til::point> SetPixels(const FontResource& font)
+    {
+        const auto atlas = font.CreateAtlas();
+        const auto size = font.AtlasSize();
+        VERIFY_ARE_EQUAL(size.area<size_t>(), atlas.size());
+
+        std::vector<til::point> pixels;
+        for (ptrdiff_t y = 0; y < size.height(); y++)
+        {
+            for (ptrdiff_t x = 0; x < size.width(); x++)
+            {
+                const auto value = til::at(atlas, y * size.width() + x);
+                if (value)
+                {
+                    VERIFY_ARE_EQUAL(0xFF, static_cast<int>(value));
+                    pixels.emplace_back(x, y);
+                }
+            }
+        }
+        return pixels;
+    }
+
+    TEST_METHOD(GlyphsAreLaidOutInRows)
+    {
+        const auto pattern = CreatePattern();
+        const FontResource font{ pattern, SourceSize, SourceSize, 0 };
+
+        VERIFY_ARE_EQUAL(til::size(8 * 16, 4 * 6), font.AtlasSize());
+
+        const auto pixels = SetPixels(font);
+        VERIFY_ARE_EQUAL(2u, pixels.size());
+        VERIFY_ARE_EQUAL(til::point(8, 0), til::at(pixels, 0));
+        VERIFY_ARE_EQUAL(til::point(15, 7), til::at(pixels, 1));
+    }
+
+    TEST_METHOD(GlyphsAreScaledToTheTargetSize)
+    {
+        const auto pattern = CreatePattern();
+        FontResource font{ pattern, SourceSize, SourceSize, 0 };
+        font.SetTargetSize({ 16, 8 });
+
+        VERIFY_ARE_EQUAL(til::size(16 * 16, 8 * 6), font.AtlasSize());
+
+        // Each source pixel turns into 2x2 target pixels.
+        const auto pixels = SetPixels(font);
+        VERIFY_ARE_EQUAL(8u, pixels.size());
+        VERIFY_ARE_EQUAL(til::point(16, 0), til::at(pixels, 0));
+        VERIFY_ARE_EQUAL(til::point(17, 0), til::at(pixels, 1));
+        VERIFY_ARE_EQUAL(til::point(16, 1), til::at(pixels, 2));
+        VERIFY_ARE_EQUAL(til::point(17, 1), til::at(pixels, 3));
+        VERIFY_ARE_EQUAL(til::point(30, 14), til::at(pixels, 4));
+        VERIFY_ARE_EQUAL(til::point(31, 15), til::at(pixels, 7));
+    }
+
+    TEST_METHOD(EmptyFontHasNoAtlas)
+    {
+        const FontResource font;
+        VERIFY_IS_TRUE(font.IsEmpty());
+        VERIFY_IS_TRUE(font.CreateAtlas().empty());
+    }
+};
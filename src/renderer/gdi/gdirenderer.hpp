@@ -52,6 +52,8 @@ namespace Microsoft::Console::Render
                                               const COORD coord,
                                               const bool trimLeft,
                                               const bool lineWrapped) noexcept override;
+        [[nodiscard]] HRESULT PaintBufferLines(gsl::span<const BufferLineRun> const runs,
+                                               const gsl::not_null<IRenderData*> pData) noexcept override;
         [[nodiscard]] HRESULT PaintBufferGridLines(const GridLines lines,
                                                    const COLORREF color,
                                                    const size_t cchLine,
@@ -92,7 +94,7 @@ namespace Microsoft::Console::Render
 
         bool _fPaintStarted;
 
-        til::rectangle _invalidCharacters;
+        std::vector<til::rectangle> _invalidCharacters;
         PAINTSTRUCT _psInvalidData;
         HDC _hdcMemoryContext;
         bool _isTrueTypeFont;
@@ -131,6 +133,12 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _PrepareMemoryBitmap(const HWND hwnd) noexcept;
 
         SIZE _szInvalidScroll;
+        // The invalid area is kept as a few separate rects, so that one that's
+        // far from another (like the rows a scroll exposed, and the cursor)
+        // doesn't drag everything in between into the next frame with it.
+        // _rcInvalid is their bounding rect.
+        static const size_t s_cInvalidRects = 8;
+        std::vector<RECT> _invalidRects;
         RECT _rcInvalid;
         bool _fInvalidRectUsed;
 
@@ -145,6 +153,11 @@ namespace Microsoft::Console::Render
         };
         FontType _lastFontType;
 
+        std::vector<size_t> _runOrder;
+
+        bool _backgroundPending{ false };
+        std::vector<RECT> _coveredRects;
+
         XFORM _currentLineTransform;
         LineRendition _currentLineRendition;
 
@@ -156,12 +169,14 @@ namespace Microsoft::Console::Render
         std::pmr::vector<std::pmr::basic_string<int>> _polyWidths;
 
         [[nodiscard]] HRESULT _InvalidCombine(const RECT* const prc) noexcept;
+        void _InvalidAdd(const RECT& rc);
         [[nodiscard]] HRESULT _InvalidOffset(const POINT* const ppt) noexcept;
         [[nodiscard]] HRESULT _InvalidRestrict() noexcept;
 
         [[nodiscard]] HRESULT _InvalidateRect(const RECT* const prc) noexcept;
 
         [[nodiscard]] HRESULT _PaintBackgroundColor(const RECT* const prc) noexcept;
+        [[nodiscard]] HRESULT _PaintPendingBackground(gsl::span<const BufferLineRun> const runs) noexcept;
 
         static const ULONG s_ulMinCursorHeightPercent = 25;
         static const ULONG s_ulMaxCursorHeightPercent = 100;
@@ -173,8 +188,6 @@ namespace Microsoft::Console::Render
         static int s_ScaleByDpi(const int iPx, const int iDpi);
         static int s_ShrinkByDpi(const int iPx, const int iDpi);
 
-        POINT _GetInvalidRectPoint() const;
-        SIZE _GetInvalidRectSize() const;
         SIZE _GetRectSize(const RECT* const pRect) const;
 
         void _OrRect(_In_ RECT* const pRectExisting, const RECT* const pRectToOr) const;
@@ -146,21 +146,64 @@ HRESULT GdiEngine::PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept
 // Return Value:
 // - S_OK, GDI related failure, or safemath failure.
 HRESULT GdiEngine::_InvalidCombine(const RECT* const prc) noexcept
+try
 {
-    if (!_fInvalidRectUsed)
+    _InvalidAdd(*prc);
+
+    // Ensure invalid areas remain within bounds of window.
+    RETURN_IF_FAILED(_InvalidRestrict());
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Helper to add the given rectangle to the invalid rects. Every rect it
+//   touches is merged into it. If that leaves too many rects, they're all
+//   merged into their bounding rect.
+// - The caller is responsible for calling _InvalidRestrict afterwards.
+// Arguments:
+// - rc - Pixel region (RECT) that should be repainted on the next frame
+// Return Value:
+// - <none>
+void GdiEngine::_InvalidAdd(const RECT& rc)
+{
+    if (IsRectEmpty(&rc))
     {
-        _rcInvalid = *prc;
-        _fInvalidRectUsed = true;
+        return;
     }
-    else
+
+    auto merged = rc;
+    for (auto merging = true; merging;)
     {
-        _OrRect(&_rcInvalid, prc);
+        merging = false;
+        for (auto it = _invalidRects.begin(); it != _invalidRects.end();)
+        {
+            if (it->left <= merged.right && merged.left <= it->right &&
+                it->top <= merged.bottom && merged.top <= it->bottom)
+            {
+                _OrRect(&merged, &*it);
+                it = _invalidRects.erase(it);
+                merging = true;
+            }
+            else
+            {
+                ++it;
+            }
+        }
     }
 
-    // Ensure invalid areas remain within bounds of window.
-    RETURN_IF_FAILED(_InvalidRestrict());
+    _invalidRects.push_back(merged);
 
-    return S_OK;
+    if (_invalidRects.size() > s_cInvalidRects)
+    {
+        for (const auto& other : _invalidRects)
+        {
+            _OrRect(&merged, &other);
+        }
+        _invalidRects.clear();
+        _invalidRects.push_back(merged);
+    }
 }
 
 // Routine Description:
@@ -170,19 +213,27 @@ HRESULT GdiEngine::_InvalidCombine(const RECT* const prc) noexcept
 // Return Value:
 // - S_OK, GDI related failure, or safemath failure.
 HRESULT GdiEngine::_InvalidOffset(const POINT* const ppt) noexcept
+try
 {
     if (_fInvalidRectUsed)
     {
-        RECT rcInvalidNew;
+        auto rects = std::move(_invalidRects);
+        _invalidRects.clear();
 
-        RETURN_IF_FAILED(LongAdd(_rcInvalid.left, ppt->x, &rcInvalidNew.left));
-        RETURN_IF_FAILED(LongAdd(_rcInvalid.right, ppt->x, &rcInvalidNew.right));
-        RETURN_IF_FAILED(LongAdd(_rcInvalid.top, ppt->y, &rcInvalidNew.top));
-        RETURN_IF_FAILED(LongAdd(_rcInvalid.bottom, ppt->y, &rcInvalidNew.bottom));
+        for (auto& rc : rects)
+        {
+            RECT rcInvalidNew;
 
-        // Add the scrolled invalid rectangle to what was left behind to get the new invalid area.
-        // This is the equivalent of adding in the "update rectangle" that we would get out of ScrollWindowEx/ScrollDC.
-        UnionRect(&_rcInvalid, &_rcInvalid, &rcInvalidNew);
+            RETURN_IF_FAILED(LongAdd(rc.left, ppt->x, &rcInvalidNew.left));
+            RETURN_IF_FAILED(LongAdd(rc.right, ppt->x, &rcInvalidNew.right));
+            RETURN_IF_FAILED(LongAdd(rc.top, ppt->y, &rcInvalidNew.top));
+            RETURN_IF_FAILED(LongAdd(rc.bottom, ppt->y, &rcInvalidNew.bottom));
+
+            // Add the scrolled invalid rectangle to what was left behind to get the new invalid area.
+            // This is the equivalent of adding in the "update rectangle" that we would get out of ScrollWindowEx/ScrollDC.
+            UnionRect(&rc, &rc, &rcInvalidNew);
+            _InvalidAdd(rc);
+        }
 
         // Ensure invalid areas remain within bounds of window.
         RETURN_IF_FAILED(_InvalidRestrict());
@@ -190,6 +241,7 @@ HRESULT GdiEngine::_InvalidOffset(const POINT* const ppt) noexcept
 
     return S_OK;
 }
+CATCH_RETURN();
 
 // Routine Description:
 // - Helper to ensure the invalid region remains within the bounds of the window.
@@ -205,10 +257,33 @@ HRESULT GdiEngine::_InvalidRestrict() noexcept
     // Do restriction only if retrieving the client rect was successful.
     RETURN_HR_IF(E_FAIL, !(GetClientRect(_hwndTargetWindow, &rcClient)));
 
-    _rcInvalid.left = std::clamp(_rcInvalid.left, rcClient.left, rcClient.right);
-    _rcInvalid.right = std::clamp(_rcInvalid.right, rcClient.left, rcClient.right);
-    _rcInvalid.top = std::clamp(_rcInvalid.top, rcClient.top, rcClient.bottom);
-    _rcInvalid.bottom = std::clamp(_rcInvalid.bottom, rcClient.top, rcClient.bottom);
+    _fInvalidRectUsed = false;
+    _rcInvalid = { 0 };
+
+    for (auto it = _invalidRects.begin(); it != _invalidRects.end();)
+    {
+        it->left = std::clamp(it->left, rcClient.left, rcClient.right);
+        it->right = std::clamp(it->right, rcClient.left, rcClient.right);
+        it->top = std::clamp(it->top, rcClient.top, rcClient.bottom);
+        it->bottom = std::clamp(it->bottom, rcClient.top, rcClient.bottom);
+
+        if (IsRectEmpty(&*it))
+        {
+            it = _invalidRects.erase(it);
+            continue;
+        }
+
+        if (!_fInvalidRectUsed)
+        {
+            _rcInvalid = *it;
+            _fInvalidRectUsed = true;
+        }
+        else
+        {
+            _OrRect(&_rcInvalid, &*it);
+        }
+        ++it;
+    }
 
     return S_OK;
 }
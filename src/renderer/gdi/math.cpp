@@ -10,24 +10,28 @@
 using namespace Microsoft::Console::Render;
 
 // Routine Description:
-// - Gets the size in characters of the current dirty portion of the frame.
+// - Gets the size in characters of the current dirty portions of the frame.
 // Arguments:
-// - area - The character dimensions of the current dirty area of the frame.
-//      This is an Inclusive rect.
+// - area - The character dimensions of each of the dirty rects of the frame.
 // Return Value:
 // - S_OK or math failure
 [[nodiscard]] HRESULT GdiEngine::GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept
 {
-    RECT rc = _psInvalidData.rcPaint;
-
-    SMALL_RECT sr = { 0 };
-    RETURN_IF_FAILED(_ScaleByFont(&rc, &sr));
-
-    _invalidCharacters = sr;
+    try
+    {
+        _invalidCharacters.clear();
+        for (const auto& rc : _invalidRects)
+        {
+            SMALL_RECT sr = { 0 };
+            RETURN_IF_FAILED(_ScaleByFont(&rc, &sr));
+            _invalidCharacters.emplace_back(sr);
+        }
 
-    area = { &_invalidCharacters, 1 };
+        area = _invalidCharacters;
 
-    return S_OK;
+        return S_OK;
+    }
+    CATCH_RETURN();
 }
 
 // Routine Description:
@@ -208,32 +212,6 @@ int GdiEngine::s_ShrinkByDpi(const int iPx, const int iDpi)
     return MulDiv(iPx, s_iBaseDpi, iDpi);
 }
 
-// Routine Description:
-// - Uses internal invalid structure to determine the top left pixel point of the invalid frame to be painted.
-// Arguments:
-// - <none>
-// Return Value:
-// - Top left corner in pixels of where to start repainting the frame.
-POINT GdiEngine::_GetInvalidRectPoint() const
-{
-    POINT pt;
-    pt.x = _psInvalidData.rcPaint.left;
-    pt.y = _psInvalidData.rcPaint.top;
-
-    return pt;
-}
-
-// Routine Description:
-// - Uses internal invalid structure to determine the size of the invalid area of the frame to be painted.
-// Arguments:
-// - <none>
-// Return Value:
-// - Width and height in pixels of the invalid area of the frame.
-SIZE GdiEngine::_GetInvalidRectSize() const
-{
-    return _GetRectSize(&_psInvalidData.rcPaint);
-}
-
 // Routine Description:
 // - Converts a pixel region (RECT) into its width/height (SIZE)
 // Arguments:
@@ -212,14 +212,19 @@ using namespace Microsoft::Console::Render;
     // If we try to end a paint that wasn't started, it's invalid. Return.
     RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_STATE), !(_fPaintStarted));
 
+    LOG_IF_FAILED(_PaintPendingBackground({}));
     LOG_IF_FAILED(_FlushBufferLines());
 
-    POINT const pt = _GetInvalidRectPoint();
-    SIZE const sz = _GetInvalidRectSize();
-
-    LOG_HR_IF(E_FAIL, !(BitBlt(_psInvalidData.hdc, pt.x, pt.y, sz.cx, sz.cy, _hdcMemoryContext, pt.x, pt.y, SRCCOPY)));
+    // Only copy what was invalid. Everything else on the window, including
+    // what ScrollFrame scrolled, already matches the in-memory bitmap.
+    for (const auto& rc : _invalidRects)
+    {
+        SIZE const sz = _GetRectSize(&rc);
+        LOG_HR_IF(E_FAIL, !(BitBlt(_psInvalidData.hdc, rc.left, rc.top, sz.cx, sz.cy, _hdcMemoryContext, rc.left, rc.top, SRCCOPY)));
+    }
     WHEN_DBG(_DebugBltAll());
 
+    _invalidRects.clear();
     _rcInvalid = { 0 };
     _fInvalidRectUsed = false;
     _szInvalidScroll = { 0 };
@@ -285,13 +290,124 @@ using namespace Microsoft::Console::Render;
     // "ghost" cursor instances on the screen.
     cursorInvertRects.clear();
 
-    if (_psInvalidData.fErase)
+    // The fill is deferred until we know which cells the text of this frame
+    // covers, see _PaintPendingBackground.
+    _backgroundPending = !!_psInvalidData.fErase;
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Fills the background of the invalid area, if PaintBackground asked for it
+//   and it hasn't happened yet. This must be called before anything else is
+//   drawn in the frame.
+// - Text is drawn with ETO_OPAQUE, which fills the background of its cells in
+//   the same ExtTextOutW call. The cells of the given runs are left out of the
+//   fill, instead of being painted twice.
+// Arguments:
+// - runs - the text runs that are about to be drawn with the single width
+//   line transform, or none.
+// Return Value:
+// - S_OK or suitable GDI HRESULT error.
+[[nodiscard]] HRESULT GdiEngine::_PaintPendingBackground(gsl::span<const BufferLineRun> const runs) noexcept
+try
+{
+    if (!_backgroundPending)
+    {
+        return S_OK;
+    }
+    _backgroundPending = false;
+
+    // The invalid rect is in device coordinates, so fill it untransformed.
+    const bool transformed = !(_currentLineTransform == IDENTITY_XFORM);
+    if (transformed)
+    {
+        RETURN_HR_IF(E_FAIL, !ModifyWorldTransform(_hdcMemoryContext, nullptr, MWT_IDENTITY));
+    }
+    const auto restoreTransform = wil::scope_exit([&]() noexcept {
+        if (transformed)
+        {
+            LOG_HR_IF(E_FAIL, !SetWorldTransform(_hdcMemoryContext, &_currentLineTransform));
+        }
+    });
+
+    if (runs.empty())
+    {
+        for (const auto& rc : _invalidRects)
+        {
+            RETURN_IF_FAILED(_PaintBackgroundColor(&rc));
+        }
+        return S_OK;
+    }
+
+    // Collect the cells the runs cover as device rects. Runs arrive in screen
+    // order, so neighbors on a row are merged, and so are rows with the same
+    // extent. A full repaint ends up as a single rect.
+    const auto fontSize = _GetFontSize();
+    const auto dx = gsl::narrow_cast<LONG>(_currentLineTransform.eDx);
+    _coveredRects.clear();
+    for (const auto& run : runs)
+    {
+        size_t columns = 0;
+        for (const auto& cluster : run.clusters)
+        {
+            columns += cluster.GetColumns();
+        }
+
+        RECT rc;
+        rc.left = (run.target.X + (run.trimLeft ? 1 : 0)) * fontSize.X + dx;
+        rc.right = run.target.X * fontSize.X + gsl::narrow_cast<LONG>(columns) * fontSize.X + dx;
+        rc.top = run.target.Y * fontSize.Y;
+        rc.bottom = rc.top + fontSize.Y;
+
+        if (!_coveredRects.empty())
+        {
+            auto& last = _coveredRects.back();
+            if (last.top == rc.top && last.bottom == rc.bottom && last.right == rc.left)
+            {
+                last.right = rc.right;
+                continue;
+            }
+        }
+        _coveredRects.push_back(rc);
+    }
+
+    wil::unique_hrgn fill{ CreateRectRgn(0, 0, 0, 0) };
+    RETURN_HR_IF_NULL(E_FAIL, fill.get());
+    wil::unique_hrgn covered{ CreateRectRgn(0, 0, 0, 0) };
+    RETURN_HR_IF_NULL(E_FAIL, covered.get());
+
+    for (const auto& rc : _invalidRects)
     {
-        RETURN_IF_FAILED(_PaintBackgroundColor(&_psInvalidData.rcPaint));
+        RETURN_HR_IF(E_FAIL, !SetRectRgn(covered.get(), rc.left, rc.top, rc.right, rc.bottom));
+        RETURN_HR_IF(E_FAIL, ERROR == CombineRgn(fill.get(), fill.get(), covered.get(), RGN_OR));
     }
 
+    for (size_t i = 0; i < _coveredRects.size();)
+    {
+        auto rc = til::at(_coveredRects, i);
+        for (++i; i < _coveredRects.size(); ++i)
+        {
+            const auto& next = til::at(_coveredRects, i);
+            if (next.left != rc.left || next.right != rc.right || next.top != rc.bottom)
+            {
+                break;
+            }
+            rc.bottom = next.bottom;
+        }
+
+        RETURN_HR_IF(E_FAIL, !SetRectRgn(covered.get(), rc.left, rc.top, rc.right, rc.bottom));
+        RETURN_HR_IF(E_FAIL, ERROR == CombineRgn(fill.get(), fill.get(), covered.get(), RGN_DIFF));
+    }
+
+    wil::unique_hbrush hbr(GetStockBrush(DC_BRUSH));
+    RETURN_HR_IF_NULL(E_FAIL, hbr.get());
+
+    LOG_HR_IF(E_FAIL, !(FillRgn(_hdcMemoryContext, fill.get(), hbr.get())));
+
     return S_OK;
 }
+CATCH_RETURN();
 
 // Routine Description:
 // - Draws one line of the buffer to the screen.
@@ -323,6 +439,8 @@ using namespace Microsoft::Console::Render;
         // Exit early if there are no lines to draw.
         RETURN_HR_IF(S_OK, 0 == cchLine);
 
+        RETURN_IF_FAILED(_PaintPendingBackground({}));
+
         POINT ptDraw = { 0 };
         RETURN_IF_FAILED(_ScaleByFont(&coord, &ptDraw));
 
@@ -429,6 +547,66 @@ using namespace Microsoft::Console::Render;
     CATCH_RETURN();
 }
 
+// Routine Description:
+// - Draws a whole batch of text runs onto the screen.
+// - Every brush or font change forces us to flush the PolyTextOut cache. Since
+//   the runs never overlap, we can group them by their colors and font and
+//   only change those once per group, instead of once per run.
+// Arguments:
+// - runs - the runs of text to draw
+// - pData - The interface to console data structures required for rendering
+// Return Value:
+// - S_OK or suitable GDI HRESULT error.
+[[nodiscard]] HRESULT GdiEngine::PaintBufferLines(gsl::span<const BufferLineRun> const runs,
+                                                  const gsl::not_null<IRenderData*> pData) noexcept
+try
+{
+    struct BrushKey
+    {
+        COLORREF fg;
+        COLORREF bg;
+        FontType fontType;
+
+        constexpr bool operator<(const BrushKey& other) const noexcept
+        {
+            return std::tie(fg, bg, fontType) < std::tie(other.fg, other.bg, other.fontType);
+        }
+    };
+
+    const auto keyFor = [&](const BufferLineRun& run) {
+        const auto [fg, bg] = pData->GetAttributeColors(run.attributes);
+        const auto fontType = run.usingSoftFont ? FontType::Soft : run.attributes.IsItalic() ? FontType::Italic : FontType::Default;
+        return BrushKey{ fg, bg, fontType };
+    };
+
+    std::vector<BrushKey> keys;
+    keys.reserve(runs.size());
+    _runOrder.clear();
+    for (size_t i = 0; i < runs.size(); ++i)
+    {
+        keys.push_back(keyFor(til::at(runs, i)));
+        _runOrder.push_back(i);
+    }
+
+    // The background only needs to be filled where the runs won't paint it.
+    RETURN_IF_FAILED(_PaintPendingBackground(_currentLineRendition == LineRendition::SingleWidth ? runs : gsl::span<const BufferLineRun>{}));
+
+    // A stable sort keeps runs with the same brushes in screen order.
+    std::stable_sort(_runOrder.begin(), _runOrder.end(), [&](const size_t a, const size_t b) {
+        return til::at(keys, a) < til::at(keys, b);
+    });
+
+    for (const auto i : _runOrder)
+    {
+        const auto& run = til::at(runs, i);
+        RETURN_IF_FAILED(UpdateDrawingBrushes(run.attributes, pData, run.usingSoftFont, false));
+        RETURN_IF_FAILED(PaintBufferLine(run.clusters, run.target, run.trimLeft, run.lineWrapped));
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
 // Routine Description:
 // - Flushes any buffer lines in the PolyTextOut cache by drawing them and freeing the strings.
 // - See also: PaintBufferLine
@@ -474,6 +652,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK or suitable GDI HRESULT error or E_FAIL for GDI errors in functions that don't reliably return a specific error code.
 [[nodiscard]] HRESULT GdiEngine::PaintBufferGridLines(const GridLines lines, const COLORREF color, const size_t cchLine, const COORD coordTarget) noexcept
 {
+    LOG_IF_FAILED(_PaintPendingBackground({}));
     LOG_IF_FAILED(_FlushBufferLines());
 
     // Convert the target from characters to pixels.
@@ -567,6 +746,7 @@ using namespace Microsoft::Console::Render;
     {
         return S_FALSE;
     }
+    LOG_IF_FAILED(_PaintPendingBackground({}));
     LOG_IF_FAILED(_FlushBufferLines());
 
     COORD const coordFontSize = _GetFontSize();
@@ -709,6 +889,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK or suitable GDI HRESULT error.
 [[nodiscard]] HRESULT GdiEngine::PaintSelection(const SMALL_RECT rect) noexcept
 {
+    LOG_IF_FAILED(_PaintPendingBackground({}));
     LOG_IF_FAILED(_FlushBufferLines());
 
     RECT pixelRect = { 0 };
@@ -279,13 +279,20 @@ GdiEngine::~GdiEngine()
                                                       const bool usingSoftFont,
                                                       const bool isSettingDefaultBrushes) noexcept
 {
-    RETURN_IF_FAILED(_FlushBufferLines());
-
     RETURN_HR_IF_NULL(HRESULT_FROM_WIN32(ERROR_INVALID_STATE), _hdcMemoryContext);
 
     // Set the colors for painting text
     const auto [colorForeground, colorBackground] = pData->GetAttributeColors(textAttributes);
 
+    // The cached text lines are drawn with whatever is selected into the DC when they're
+    // flushed, so they need to be flushed before anything changes, but only then.
+    const auto usingItalicFont = textAttributes.IsItalic();
+    const auto fontType = usingSoftFont ? FontType::Soft : usingItalicFont ? FontType::Italic : FontType::Default;
+    if (colorForeground != _lastFg || colorBackground != _lastBg || fontType != _lastFontType || isSettingDefaultBrushes)
+    {
+        RETURN_IF_FAILED(_FlushBufferLines());
+    }
+
     if (colorForeground != _lastFg)
     {
         RETURN_HR_IF(E_FAIL, CLR_INVALID == SetTextColor(_hdcMemoryContext, colorForeground));
@@ -307,8 +314,6 @@ GdiEngine::~GdiEngine()
     }
 
     // If the font type has changed, select an appropriate font variant or soft font.
-    const auto usingItalicFont = textAttributes.IsItalic();
-    const auto fontType = usingSoftFont ? FontType::Soft : usingItalicFont ? FontType::Italic : FontType::Default;
     if (fontType != _lastFontType)
     {
         switch (fontType)
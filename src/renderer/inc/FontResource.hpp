@@ -29,11 +29,22 @@ namespace Microsoft::Console::Render
         ~FontResource() = default;
         FontResource& operator=(FontResource&&) = default;
         void SetTargetSize(const til::size targetSize);
+        til::size GetTargetSize() const noexcept;
+        bool IsEmpty() const noexcept;
         operator HFONT();
 
+        // DRCS soft fonts only require 96 characters at most.
+        static constexpr size_t CharCount = 96;
+        static constexpr size_t AtlasColumns = 16;
+
+        til::size AtlasSize() const noexcept;
+        std::vector<byte> CreateAtlas() const;
+
     private:
         void _regenerateFont();
         void _resizeBitPattern(gsl::span<byte> targetBuffer);
+        template<typename T>
+        void _scaleGlyphs(T&& setPixel) const;
 
         std::vector<uint16_t> _bitPattern;
         til::size _sourceSize;
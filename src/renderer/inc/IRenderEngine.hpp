@@ -18,6 +18,7 @@ Author(s):
 #include "Cluster.hpp"
 #include "FontInfoDesired.hpp"
 #include "IRenderData.hpp"
+#include "../../buffer/out/ImageSlice.hpp"
 #include "../../buffer/out/LineRendition.hpp"
 
 namespace Microsoft::Console::Render
@@ -25,6 +26,26 @@ namespace Microsoft::Console::Render
     struct RenderFrameInfo
     {
         std::optional<CursorOptions> cursorInfo;
+        // The TextBuffer generation of each row in the viewport, top to bottom.
+        // An engine can keep these around and skip repainting rows whose
+        // generation is unchanged since it last presented them.
+        gsl::span<const uint64_t> rowGenerations;
+        // Changes whenever something other than the contents of the rows
+        // changes how they look, like the colors or the horizontal scroll
+        // position. A row with the same generation and appearance as before
+        // looks exactly like it did then.
+        uint64_t rowAppearance;
+    };
+
+    // A single run of text with uniform attributes, as passed to PaintBufferLines.
+    struct BufferLineRun
+    {
+        gsl::span<const Cluster> clusters;
+        TextAttribute attributes;
+        COORD target;
+        bool trimLeft;
+        bool lineWrapped;
+        bool usingSoftFont;
     };
 
     class IRenderEngine
@@ -69,6 +90,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] virtual HRESULT InvalidateSystem(const RECT* const prcDirtyClient) noexcept = 0;
         [[nodiscard]] virtual HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept = 0;
         [[nodiscard]] virtual HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept = 0;
+        [[nodiscard]] virtual HRESULT InvalidateScrollRegion(const SMALL_RECT* const psrRegion, const COORD* const pcoordDelta) noexcept = 0;
         [[nodiscard]] virtual HRESULT InvalidateAll() noexcept = 0;
         [[nodiscard]] virtual HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept = 0;
 
@@ -82,14 +104,28 @@ namespace Microsoft::Console::Render
                                                            const size_t viewportLeft) noexcept = 0;
 
         [[nodiscard]] virtual HRESULT PaintBackground() noexcept = 0;
+        // Asks the engine to paint an entire row the way it painted it in an
+        // earlier frame, if it kept a copy. It returns S_FALSE if it didn't,
+        // and the row's text has to be painted as usual.
+        [[nodiscard]] virtual HRESULT PaintCachedRow(const size_t targetRow) noexcept = 0;
         [[nodiscard]] virtual HRESULT PaintBufferLine(gsl::span<const Cluster> const clusters,
                                                       const COORD coord,
                                                       const bool fTrimLeft,
                                                       const bool lineWrapped) noexcept = 0;
+        // Paints many runs at once, for instance all the runs of a frame that
+        // share the same line transform. The runs are in the order in which they
+        // would have been passed to UpdateDrawingBrushes + PaintBufferLine, but
+        // engines are free to paint them in any order, as runs never overlap.
+        [[nodiscard]] virtual HRESULT PaintBufferLines(gsl::span<const BufferLineRun> const runs,
+                                                       const gsl::not_null<IRenderData*> pData) noexcept = 0;
         [[nodiscard]] virtual HRESULT PaintBufferGridLines(const GridLines lines,
                                                            const COLORREF color,
                                                            const size_t cchLine,
                                                            const COORD coordTarget) noexcept = 0;
+        // Paints a slice of an image over the text of a row. The target is
+        // the screen position of the first cell the slice covers.
+        [[nodiscard]] virtual HRESULT PaintImageSlice(const ImageSlice& imageSlice,
+                                                      const COORD target) noexcept = 0;
         [[nodiscard]] virtual HRESULT PaintSelection(const SMALL_RECT rect) noexcept = 0;
 
         [[nodiscard]] virtual HRESULT PaintCursor(const CursorOptions& options) noexcept = 0;
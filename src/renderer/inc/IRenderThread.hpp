@@ -18,6 +18,12 @@ namespace Microsoft::Console::Render
     class IRenderThread
     {
     public:
+        struct FrameStatistics
+        {
+            uint64_t framesPainted;
+            uint64_t paintRequestsCoalesced;
+        };
+
         virtual ~IRenderThread() = 0;
         IRenderThread(const IRenderThread&) = default;
         IRenderThread(IRenderThread&&) = default;
@@ -28,6 +34,7 @@ namespace Microsoft::Console::Render
         virtual void EnablePainting() = 0;
         virtual void DisablePainting() = 0;
         virtual void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) = 0;
+        virtual FrameStatistics GetFrameStatistics() const noexcept = 0;
 
     protected:
         IRenderThread() = default;
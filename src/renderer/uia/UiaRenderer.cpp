@@ -10,6 +10,10 @@
 using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::Types;
 
+// By default, automation clients hear about text and cursor changes at most
+// every 100ms. Screen readers can't read faster than that anyway.
+static constexpr std::chrono::milliseconds DefaultNotificationInterval{ 100 };
+
 // Routine Description:
 // - Constructs a UIA engine for console text
 //   which primarily notifies automation clients of any activity
@@ -20,6 +24,8 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
     _textBufferChanged{ false },
     _cursorChanged{ false },
     _isEnabled{ true },
+    _notificationInterval{ DefaultNotificationInterval },
+    _lastNotification{},
     _prevSelection{},
     _prevCursorRegion{},
     RenderEngineBase()
@@ -50,6 +56,21 @@ UiaEngine::UiaEngine(IUiaEventDispatcher* dispatcher) :
     return S_OK;
 }
 
+// Routine Description:
+// - Sets the minimum time between two text or cursor change notifications.
+//   Changes that happen in between are held back and signaled together once
+//   the interval has passed. Selection changes are always signaled right away,
+//   since they're the direct result of user input.
+// Arguments:
+// - interval - the minimum time between notifications. 0 signals every frame.
+// Return Value:
+// - <none>
+void UiaEngine::SetNotificationInterval(const std::chrono::milliseconds interval) noexcept
+{
+    // This is called from the UI thread while the render thread may be painting.
+    _notificationInterval.store(std::max(interval, std::chrono::milliseconds::zero()), std::memory_order_relaxed);
+}
+
 // Routine Description:
 // - Notifies us that the console has changed the character region specified.
 // - NOTE: This typically triggers on cursor or text buffer changes
@@ -236,6 +257,18 @@ CATCH_RETURN();
         }
         CATCH_LOG();
     }
+    _selectionChanged = false;
+    _isPainting = false;
+
+    // Text and cursor changes that arrive faster than the notification interval
+    // stay pending. RequiresContinuousRedraw keeps the renderer ticking until
+    // the interval has passed, so they're signaled even if output stops now.
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _lastNotification < _notificationInterval.load(std::memory_order_relaxed))
+    {
+        return S_OK;
+    }
+
     if (_textBufferChanged)
     {
         try
@@ -253,10 +286,12 @@ CATCH_RETURN();
         CATCH_LOG();
     }
 
-    _selectionChanged = false;
+    if (_textBufferChanged || _cursorChanged)
+    {
+        _lastNotification = now;
+    }
     _textBufferChanged = false;
     _cursorChanged = false;
-    _isPainting = false;
 
     return S_OK;
 }
@@ -274,6 +309,18 @@ CATCH_RETURN();
     return S_FALSE;
 }
 
+// Routine Description:
+// - Asks the renderer to keep painting while text or cursor changes are held
+//   back by the notification interval, so they're eventually signaled.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if a notification is pending.
+[[nodiscard]] bool UiaEngine::RequiresContinuousRedraw() noexcept
+{
+    return _isEnabled && (_textBufferChanged || _cursorChanged);
+}
+
 // Routine Description:
 // - This is currently unused.
 // Arguments:
@@ -33,10 +33,16 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT Enable() noexcept;
         [[nodiscard]] HRESULT Disable() noexcept;
 
+        // Text and cursor changes are coalesced so that we signal them at most
+        // once per interval. Busy output would otherwise flood automation
+        // clients with an event for every frame.
+        void SetNotificationInterval(const std::chrono::milliseconds interval) noexcept;
+
         // IRenderEngine Members
         [[nodiscard]] HRESULT StartPaint() noexcept override;
         [[nodiscard]] HRESULT EndPaint() noexcept override;
         [[nodiscard]] HRESULT Present() noexcept override;
+        [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
 
         [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override;
 
@@ -84,6 +90,9 @@ namespace Microsoft::Console::Render
         bool _textBufferChanged;
         bool _cursorChanged;
 
+        std::atomic<std::chrono::milliseconds> _notificationInterval;
+        std::chrono::steady_clock::time_point _lastNotification;
+
         Microsoft::Console::Types::IUiaEventDispatcher* _dispatcher;
 
         std::vector<SMALL_RECT> _prevSelection;
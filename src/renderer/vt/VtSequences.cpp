@@ -84,6 +84,18 @@ using namespace Microsoft::Console::Render;
     return _WriteFormatted(FMT_COMPILE("\x1b[{}X"), chars);
 }
 
+// Method Description:
+// - Formats and writes a sequence to repeat the last printed character a
+//      number of times (REP).
+// Arguments:
+// - count: the number of times to repeat the character.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_RepeatCharacter(const size_t count) noexcept
+{
+    return _WriteFormatted(FMT_COMPILE("\x1b[{}b"), count);
+}
+
 // Method Description:
 // - Moves the cursor forward (right) a number of characters.
 // Arguments:
@@ -29,13 +29,73 @@ Xterm256Engine::Xterm256Engine(_In_ wil::unique_hfile hPipe,
                                                            const gsl::not_null<IRenderData*> pData,
                                                            const bool /*usingSoftFont*/,
                                                            const bool /*isSettingDefaultBrushes*/) noexcept
+try
 {
-    RETURN_IF_FAILED(VtEngine::_RgbUpdateDrawingBrushes(textAttributes));
+    const auto& transition = _GetSgrTransition(textAttributes);
+
+    RETURN_IF_FAILED(_WriteCaptured(transition.colors));
 
     RETURN_IF_FAILED(_UpdateHyperlinkAttr(textAttributes, pData));
 
     // Only do extended attributes in xterm-256color, as to not break telnet.exe.
-    return _UpdateExtendedAttrs(textAttributes);
+    RETURN_IF_FAILED(_WriteCaptured(transition.extendedAttrs));
+
+    const auto hyperlinkId = _lastTextAttributes.GetHyperlinkId();
+    _lastTextAttributes = transition.result;
+    _lastTextAttributes.SetHyperlinkId(hyperlinkId);
+    return S_OK;
+}
+CATCH_RETURN()
+
+// Routine Description:
+// - Returns the SGR sequences that change the attributes from
+//      _lastTextAttributes to textAttributes. They're formatted the first time
+//      we see this pair of attributes, and then kept in a small cache, because
+//      colored output usually alternates between the same few attributes.
+// - This doesn't change _lastTextAttributes or write anything.
+// Arguments:
+// - textAttributes - the attributes the text should get
+// Return Value:
+// - the transition from _lastTextAttributes to textAttributes
+const Xterm256Engine::SgrTransition& Xterm256Engine::_GetSgrTransition(const TextAttribute& textAttributes)
+{
+    auto from = _lastTextAttributes;
+    from.SetHyperlinkId(0);
+    auto to = textAttributes;
+    to.SetHyperlinkId(0);
+
+    for (size_t i = 0; i < _sgrTransitionCount; ++i)
+    {
+        const auto& transition = til::at(_sgrTransitions, i);
+        if (transition.from == from && transition.to == to)
+        {
+            return transition;
+        }
+    }
+
+    // Let the usual methods format the sequences, but into the transition.
+    SgrTransition transition{ from, to };
+    {
+        const auto lastTextAttributes = _lastTextAttributes;
+        auto restore = wil::scope_exit([&]() noexcept {
+            _captureOutput = nullptr;
+            _lastTextAttributes = lastTextAttributes;
+        });
+
+        _lastTextAttributes = from;
+        _captureOutput = &transition.colors;
+        THROW_IF_FAILED(VtEngine::_RgbUpdateDrawingBrushes(to));
+        _captureOutput = &transition.extendedAttrs;
+        THROW_IF_FAILED(_UpdateExtendedAttrs(to));
+        transition.result = _lastTextAttributes;
+    }
+
+    // Replace the oldest entry, once the cache is full.
+    auto& entry = til::at(_sgrTransitions, _nextSgrTransition);
+    entry = std::move(transition);
+    _nextSgrTransition = (_nextSgrTransition + 1) % SgrTransitionCacheSize;
+    _sgrTransitionCount = std::min(_sgrTransitionCount + 1, SgrTransitionCacheSize);
+    return entry;
 }
 
 // Routine Description:
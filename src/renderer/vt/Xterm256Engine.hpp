@@ -36,6 +36,29 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT ManuallyClearScrollback() noexcept override;
 
     private:
+        // The SGR sequences that change the attributes of the text from one
+        // TextAttribute to another, as _RgbUpdateDrawingBrushes and
+        // _UpdateExtendedAttrs would write them. Hyperlinks aren't part of
+        // this, so both attributes are stored without their hyperlink ID.
+        struct SgrTransition
+        {
+            TextAttribute from;
+            TextAttribute to;
+            CapturedOutput colors;
+            CapturedOutput extendedAttrs;
+            // What _lastTextAttributes is afterwards. It isn't always `to`.
+            TextAttribute result;
+        };
+
+        // Colored output usually alternates between a handful of attributes.
+        static constexpr size_t SgrTransitionCacheSize = 16;
+
+        std::array<SgrTransition, SgrTransitionCacheSize> _sgrTransitions;
+        size_t _sgrTransitionCount{ 0 };
+        size_t _nextSgrTransition{ 0 };
+
+        const SgrTransition& _GetSgrTransition(const TextAttribute& textAttributes);
+
         [[nodiscard]] HRESULT _UpdateExtendedAttrs(const TextAttribute& textAttributes) noexcept;
         [[nodiscard]] HRESULT _UpdateHyperlinkAttr(const TextAttribute& textAttributes,
                                                    const gsl::not_null<IRenderData*> pData) noexcept;
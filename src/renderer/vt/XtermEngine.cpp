@@ -35,7 +35,15 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
 //      the pipe.
 [[nodiscard]] HRESULT XtermEngine::StartPaint() noexcept
 {
-    RETURN_IF_FAILED(VtEngine::StartPaint());
+    const auto hr = VtEngine::StartPaint();
+    RETURN_IF_FAILED(hr);
+
+    // Don't clear the screen for the first paint before we know whether
+    // we inherit the cursor.
+    if (_inheritingCursor)
+    {
+        return hr;
+    }
 
     _trace.TraceLastText(_lastText);
 
@@ -52,6 +60,7 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
         //      the screen on the first paint, just to make sure that the
         //      terminal's state is consistent with what we'll be rendering.
         RETURN_IF_FAILED(_ClearScreen());
+        _ResetShadowFrame();
         _clearedAllThisFrame = true;
         _firstPaint = false;
     }
@@ -97,10 +106,11 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
     if (_needToDisableCursor)
     {
         // If the cursor was previously visible, let's hide it for this frame,
-        // by prepending a cursor off.
+        // by prepending a cursor off. Output of earlier frames may still be
+        // in the buffer, so this goes where this frame's output starts.
         if (_lastCursorIsVisible)
         {
-            _buffer.insert(0, "\x1b[?25l");
+            _buffer.insert(_frameStart, "\x1b[?25l");
             _lastCursorIsVisible = false;
         }
         // If the cursor was NOT previously visible, then that's fine! we don't
@@ -395,6 +405,12 @@ try
         RETURN_IF_FAILED(_InsertLine(absDy));
     }
 
+    // The terminal's contents moved, so our shadow copy is out of date.
+    if (dy != 0)
+    {
+        _ResetShadowFrame();
+    }
+
     // Restore our wrap state.
     _wrappedRow = oldWrappedRow;
     _delayedEolWrap = oldDelayedEolWrap;
@@ -25,6 +25,25 @@ using namespace Microsoft::Console::Types;
         return S_FALSE;
     }
 
+    // Keep whatever was invalidated until we know where the cursor is.
+    // See SetInheritingCursor.
+    if (_inheritingCursor)
+    {
+        return S_FALSE;
+    }
+
+    // In passthrough mode the terminal has already received everything the
+    // client wrote. Throw away what the buffer changes invalidated, so it
+    // doesn't pile up until passthrough ends (which repaints everything anyway).
+    if (_passthrough)
+    {
+        _invalidMap.reset_all();
+        _scrollDelta = { 0, 0 };
+        _cursorMoved = false;
+        _titleChanged = false;
+        return S_FALSE;
+    }
+
     // If there's nothing to do, quick return
     bool somethingToDo = _invalidMap.any() ||
                          _scrollDelta != til::point{ 0, 0 } ||
@@ -32,6 +51,16 @@ using namespace Microsoft::Console::Types;
                          _titleChanged;
 
     _quickReturn = !somethingToDo;
+
+    // Output from the frames before this one may still be waiting for its
+    // latency budget. If there's nothing new to paint, that's the only thing
+    // to do. Otherwise remember where this frame starts in the buffer.
+    if (_quickReturn)
+    {
+        RETURN_IF_FAILED(_FlushIfNeeded());
+    }
+    _frameStart = _buffer.size();
+
     _trace.TraceStartPaint(_quickReturn,
                            _invalidMap,
                            _lastViewport.ToInclusive(),
@@ -72,6 +101,7 @@ using namespace Microsoft::Console::Types;
         {
             _virtualTop--;
         }
+        _ResetShadowFrame();
     }
     _circled = false;
 
@@ -82,7 +112,7 @@ using namespace Microsoft::Console::Types;
         RETURN_IF_FAILED(_MoveCursor(_deferredCursorPos));
     }
 
-    RETURN_IF_FAILED(_Flush());
+    RETURN_IF_FAILED(_FlushIfNeeded());
 
     return S_OK;
 }
@@ -356,6 +386,9 @@ using namespace Microsoft::Console::Types;
 
         RETURN_IF_FAILED(VtEngine::_WriteTerminalAscii(_bufferLine));
 
+        // Non-ASCII characters were replaced, so we don't know what the terminal shows now.
+        _InvalidateShadowCells(coord, totalWidth);
+
         // Update our internal tracker of the cursor's position
         _lastText.X += totalWidth;
 
@@ -364,6 +397,110 @@ using namespace Microsoft::Console::Types;
     CATCH_RETURN();
 }
 
+// Routine Description:
+// - Returns true if every cluster in the run is a single UTF-16 code unit
+//   occupying a single column. Only those runs map 1:1 onto shadow cells.
+// Arguments:
+// - clusters - the run to check
+// Return Value:
+// - true if the run can be diffed cell by cell.
+static bool _IsNarrowRun(gsl::span<const Cluster> const clusters) noexcept
+{
+    return std::all_of(clusters.begin(), clusters.end(), [](const Cluster& cluster) {
+        return cluster.GetColumns() == 1 && cluster.GetText().size() == 1;
+    });
+}
+
+// Routine Description:
+// - Compares the first cchActual characters of _bufferLine, which are about to
+//   be painted at coord with _lastTextAttributes, with what we've previously
+//   sent to the terminal there, and returns how many leading and trailing
+//   cells the terminal already has.
+// - Nothing is skipped if we're in one of the states in which the exact cells
+//   we print matter, such as when preserving a line's wrapped state.
+// Arguments:
+// - clusters - the run about to be painted
+// - coord - the position of the run
+// - cchActual - the number of characters that are going to be printed
+// - lineWrapped - whether the row is wrapped
+// - skipFront - receives the number of leading cells that don't need to be sent
+// - skipBack - receives the number of trailing cells that don't need to be sent
+// Return Value:
+// - <none>
+void VtEngine::_DiffAgainstShadowFrame(gsl::span<const Cluster> const clusters,
+                                       const COORD coord,
+                                       const size_t cchActual,
+                                       const bool lineWrapped,
+                                       size_t& skipFront,
+                                       size_t& skipBack) noexcept
+{
+    skipFront = 0;
+    skipBack = 0;
+
+    if (!_shadowFrameDiffing || lineWrapped || _wrappedRow.has_value() || _newBottomLine || _clearedAllThisFrame || !_IsNarrowRun(clusters))
+    {
+        return;
+    }
+
+    const auto cells = _GetShadowCell(coord);
+    if (!cells || cchActual > gsl::narrow_cast<size_t>(_lastViewport.Width() - coord.X))
+    {
+        return;
+    }
+
+    const auto matches = [&](const size_t i) {
+        const auto& cell = cells[i];
+        return cell.ch == til::at(_bufferLine, i) && cell.attr == _lastTextAttributes;
+    };
+
+    while (skipFront < cchActual && matches(skipFront))
+    {
+        ++skipFront;
+    }
+    while (skipBack < cchActual - skipFront && matches(cchActual - 1 - skipBack))
+    {
+        ++skipBack;
+    }
+}
+
+// Routine Description:
+// - Records what we've just painted at coord in the shadow frame. Cells we
+//   couldn't map 1:1 onto the text we sent, as well as trimmed trailing
+//   spaces, are marked as unknown.
+// Arguments:
+// - clusters - the run that was painted
+// - coord - the position of the run
+// - cchActual - the number of characters of _bufferLine that were printed
+// - totalWidth - the number of columns the run covers
+// Return Value:
+// - <none>
+void VtEngine::_UpdateShadowFrame(gsl::span<const Cluster> const clusters,
+                                  const COORD coord,
+                                  const size_t cchActual,
+                                  const size_t totalWidth) noexcept
+{
+    const auto cells = _GetShadowCell(coord);
+    if (!cells)
+    {
+        return;
+    }
+
+    size_t known = 0;
+    if (_IsNarrowRun(clusters))
+    {
+        known = std::min(cchActual, gsl::narrow_cast<size_t>(_lastViewport.Width() - coord.X));
+        for (size_t i = 0; i < known; ++i)
+        {
+            cells[i] = { til::at(_bufferLine, i), _lastTextAttributes };
+        }
+    }
+
+    if (totalWidth > known)
+    {
+        _InvalidateShadowCells({ gsl::narrow_cast<SHORT>(coord.X + known), coord.Y }, totalWidth - known);
+    }
+}
+
 // Routine Description:
 // - Draws one line of the buffer to the screen. Writes the characters to the
 //      pipe, encoded in UTF-8.
@@ -485,11 +622,33 @@ using namespace Microsoft::Console::Types;
         _trace.TraceClearWrapped();
     }
 
-    // Move the cursor to the start of this run.
-    RETURN_IF_FAILED(_MoveCursor(coord));
+    // If we know what the terminal already shows in these cells, skip the
+    // leading and trailing cells of the run that it already has.
+    size_t skipFront = 0;
+    size_t skipBack = 0;
+    _DiffAgainstShadowFrame(clusters, coord, cchActual, lineWrapped, skipFront, skipBack);
+    const auto cchWrite = cchActual - skipFront - skipBack;
+
+    if (cchWrite != 0 || cchActual == 0)
+    {
+        // Move the cursor to the start of this run.
+        RETURN_IF_FAILED(_MoveCursor({ gsl::narrow_cast<SHORT>(coord.X + skipFront), coord.Y }));
+
+        // Write the actual text string. Long runs of one character are sent
+        // with REP, unless we need to preserve the exact cells of a wrapped
+        // row, or some of the characters aren't a single column wide.
+        const std::wstring_view text{ _bufferLine.data() + skipFront, cchWrite };
+        if (_repeatCharacter && !lineWrapped && _IsNarrowRun(clusters))
+        {
+            RETURN_IF_FAILED(_WriteTerminalUtf8Repeated(text));
+        }
+        else
+        {
+            RETURN_IF_FAILED(VtEngine::_WriteTerminalUtf8(text));
+        }
+    }
 
-    // Write the actual text string
-    RETURN_IF_FAILED(VtEngine::_WriteTerminalUtf8({ _bufferLine.data(), cchActual }));
+    _UpdateShadowFrame(clusters, coord, cchActual, totalWidth);
 
     // GH#4415, GH#5181
     // If the renderer told us that this was a wrapped line, then mark
@@ -521,7 +680,8 @@ using namespace Microsoft::Console::Types;
     // character of the row.
     if (_lastText.X < _lastViewport.RightExclusive())
     {
-        _lastText.X += static_cast<short>(columnsActual);
+        // When diffing, every skipped cell is exactly one column wide.
+        _lastText.X += static_cast<short>(columnsActual - skipFront - skipBack);
     }
     // GH#1245: If we wrote the exactly last char of the row, then we're in the
     // "delayed EOL wrap" state. Different terminals (conhost, gnome-terminal,
@@ -543,6 +703,17 @@ using namespace Microsoft::Console::Types;
 
     if (useEraseChar)
     {
+        // If we skipped the end of the text, the cursor isn't where the
+        // spaces start yet.
+        if (skipBack != 0 || (cchWrite == 0 && cchActual != 0))
+        {
+            RETURN_IF_FAILED(_MoveCursor({ gsl::narrow_cast<SHORT>(coord.X + columnsActual), coord.Y }));
+        }
+
+        // The erased cells will have the current background, but none of the
+        // other attributes. Rather than modeling that, just forget them.
+        _InvalidateShadowCells(_lastText, numSpaces);
+
         // ECH doesn't actually move the cursor itself. However, we think that
         //   the cursor *should* be at the end of the area we just erased. Stash
         //   that position as our new deferred position. If we don't move the
@@ -75,6 +75,17 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 // - S_OK or suitable HRESULT error from writing pipe.
 [[nodiscard]] HRESULT VtEngine::_Write(std::string_view const str) noexcept
 {
+    if (_captureOutput)
+    {
+        try
+        {
+            _captureOutput->text.append(str);
+            _captureOutput->lengths.push_back(str.size());
+            return S_OK;
+        }
+        CATCH_RETURN();
+    }
+
     _trace.TraceString(str);
 #ifdef UNIT_TESTING
     if (_usingTestCallback)
@@ -96,6 +107,10 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 
     try
     {
+        if (_buffer.empty())
+        {
+            _pendingSince = std::chrono::steady_clock::now();
+        }
         _buffer.append(str);
 
         return S_OK;
@@ -103,6 +118,24 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     CATCH_RETURN();
 }
 
+// Method Description:
+// - Writes output that was previously captured with _captureOutput, one
+//      write at a time, like it was originally written.
+// Arguments:
+// - output: the captured output.
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]] HRESULT VtEngine::_WriteCaptured(const CapturedOutput& output) noexcept
+{
+    std::string_view text{ output.text };
+    for (const auto length : output.lengths)
+    {
+        RETURN_IF_FAILED(_Write(text.substr(0, length)));
+        text.remove_prefix(length);
+    }
+    return S_OK;
+}
+
 [[nodiscard]] HRESULT VtEngine::_Flush() noexcept
 {
 #ifdef UNIT_TESTING
@@ -113,10 +146,16 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     }
 #endif
 
-    if (!_pipeBroken)
+    if (!_pipeBroken && !_buffer.empty())
     {
         bool fSuccess = !!WriteFile(_hFile.get(), _buffer.data(), gsl::narrow_cast<DWORD>(_buffer.size()), nullptr, nullptr);
+
+        _flushCount++;
+        _flushedBytes += _buffer.size();
+        _trace.TraceFlush(_buffer.size(), _flushCount, _flushedBytes);
+
         _buffer.clear();
+        _frameStart = 0;
         if (!fSuccess)
         {
             _exitResult = HRESULT_FROM_WIN32(GetLastError());
@@ -132,6 +171,24 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     return S_OK;
 }
 
+// Method Description:
+// - Flushes the buffer if the flush policy says it's time to, see SetFlushPolicy.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]] HRESULT VtEngine::_FlushIfNeeded() noexcept
+{
+    // Without a latency budget, every frame is written out as it ends.
+    if (_flushLatency.count() == 0 ||
+        (_flushThreshold != 0 && _buffer.size() >= _flushThreshold) ||
+        std::chrono::steady_clock::now() - _pendingSince >= _flushLatency)
+    {
+        return _Flush();
+    }
+    return S_OK;
+}
+
 // Method Description:
 // - Wrapper for ITerminalOutputConnection. See _Write.
 [[nodiscard]] HRESULT VtEngine::WriteTerminalUtf8(const std::string_view str) noexcept
@@ -152,6 +209,56 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     return _Write(_conversionBuffer);
 }
 
+// Method Description:
+// - Writes a wstring to the tty like _WriteTerminalUtf8, but sends a long run
+//      of a single character as that character followed by a REP sequence.
+//      Box drawing borders, separator lines and progress bars become a few
+//      bytes each this way.
+// - A REP sequence is at most 6 chars for any run that fits into a row
+//      (ESC [ %d %d %d b), so the run has to repeat the character more often
+//      than that to make it worth it.
+// - Every character of str must take up exactly one column, as REP doesn't
+//      know about anything else.
+// Arguments:
+// - wstr - wstring of text to be written
+// Return Value:
+// - S_OK or suitable HRESULT error from either conversion or writing pipe.
+[[nodiscard]] HRESULT VtEngine::_WriteTerminalUtf8Repeated(const std::wstring_view wstr) noexcept
+{
+    // Control characters and surrogates can't be repeated with REP: the
+    // terminal only repeats the last graphic character it printed.
+    const auto isRepeatable = [](const wchar_t wch) noexcept {
+        return wch >= L'\x20' && wch != L'\x7f' && !IS_HIGH_SURROGATE(wch) && !IS_LOW_SURROGATE(wch);
+    };
+
+    size_t written = 0;
+    size_t start = 0;
+    while (start < wstr.size())
+    {
+        const auto wch = til::at(wstr, start);
+        auto end = start + 1;
+        while (end < wstr.size() && til::at(wstr, end) == wch)
+        {
+            ++end;
+        }
+
+        const auto repeats = end - start - 1;
+        if (repeats > REPEAT_CHARACTER_STRING_LENGTH && isRepeatable(wch))
+        {
+            RETURN_IF_FAILED(_WriteTerminalUtf8(wstr.substr(written, start + 1 - written)));
+            RETURN_IF_FAILED(_RepeatCharacter(repeats));
+            written = end;
+        }
+        start = end;
+    }
+
+    if (written < wstr.size())
+    {
+        RETURN_IF_FAILED(_WriteTerminalUtf8(wstr.substr(written)));
+    }
+    return S_OK;
+}
+
 // Method Description:
 // - Writes a wstring to the tty, encoded as "utf-8" where characters that are
 //      outside the ASCII range are encoded as '?'
@@ -221,6 +328,9 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 
     if ((oldView.Height() != newView.Height()) || (oldView.Width() != newView.Width()))
     {
+        // The terminal is going to resize (and maybe reflow) too.
+        _ResetShadowFrame();
+
         // Don't emit a resize event if we've requested it be suppressed
         if (!_suppressResizeRepaint)
         {
@@ -359,6 +469,20 @@ bool VtEngine::_AllIsInvalid() const
     return S_OK;
 }
 
+// Method Description:
+// - While we're waiting for the terminal to tell us where its cursor is, we
+//      can't paint anything yet: we don't know where it would end up. Until
+//      this is turned off again, nothing is painted, but everything that's
+//      invalidated in the meantime is kept, to be painted once it is.
+// Arguments:
+// - inheriting: true while we're waiting for the cursor position.
+// Return Value:
+// - <none>
+void VtEngine::SetInheritingCursor(const bool inheriting) noexcept
+{
+    _inheritingCursor = inheriting;
+}
+
 void VtEngine::SetTerminalOwner(Microsoft::Console::ITerminalOwner* const terminalOwner)
 {
     _terminalOwner = terminalOwner;
@@ -423,6 +547,179 @@ void VtEngine::SetResizeQuirk(const bool resizeQuirk)
     _resizeQuirk = resizeQuirk;
 }
 
+// Method Description:
+// - Enables or disables diffing painted text against a shadow copy of what we
+//   last sent to the terminal. When enabled, runs of text that only partially
+//   changed are trimmed to the cells that actually differ, and runs that
+//   didn't change at all aren't sent again. This noticeably reduces the output
+//   for apps that keep redrawing mostly identical screens (progress bars,
+//   `watch`, full screen TUIs).
+// Arguments:
+// - enabled: true to enable the diffing.
+// Return Value:
+// - <none>
+void VtEngine::SetShadowFrameDiffing(const bool enabled)
+{
+    _shadowFrameDiffing = enabled;
+    _ResetShadowFrame();
+}
+
+// Method Description:
+// - Configures how output is coalesced across frames. By default, whatever a
+//   frame painted is written to the pipe when the frame ends. With a policy,
+//   small frames are held back and written together, which saves pipe writes
+//   during bursts of tiny client writes.
+// - Output is written once the oldest pending byte has waited for
+//   latencyBudget, or earlier, once sizeThreshold bytes are pending. The
+//   renderer only ticks once per frame, so the budget is rounded up to that.
+//   Responses and other sequences we flush explicitly aren't affected.
+// Arguments:
+// - sizeThreshold: the number of pending bytes that triggers a write, or 0.
+// - latencyBudget: the longest time output may be held back. 0 disables
+//   coalescing.
+// Return Value:
+// - <none>
+void VtEngine::SetFlushPolicy(const size_t sizeThreshold, const std::chrono::milliseconds latencyBudget) noexcept
+{
+    _flushThreshold = sizeThreshold;
+    _flushLatency = latencyBudget;
+}
+
+// Method Description:
+// - Asks the renderer to keep ticking while coalesced output is pending, so
+//   it's written once its latency budget runs out, even if nothing else
+//   changes in the meantime.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if there's output waiting to be flushed.
+[[nodiscard]] bool VtEngine::RequiresContinuousRedraw() noexcept
+{
+    return !_pipeBroken && !_buffer.empty();
+}
+
+// Method Description:
+// - Enables or disables passthrough mode. While it's enabled, the client's VT
+//   output is written straight to the terminal with PassthroughString, so we
+//   don't paint anything from the buffer.
+// - When it's disabled again, the terminal's contents no longer match what we
+//   last painted, so we forget all of it and repaint the whole viewport.
+// Arguments:
+// - passthrough: true to enable passthrough mode.
+// Return Value:
+// - <none>
+void VtEngine::SetPassthroughMode(const bool passthrough) noexcept
+{
+    if (_passthrough == passthrough)
+    {
+        return;
+    }
+
+    _passthrough = passthrough;
+    if (!_passthrough)
+    {
+        // Neither the cursor position nor the attributes are what we last
+        // wrote anymore. An invalid position makes the next move a full CUP.
+        _lastText = { -1, -1 };
+        _lastTextAttributes = TextAttribute{ INVALID_COLOR, INVALID_COLOR };
+        _ResetShadowFrame();
+        LOG_IF_FAILED(InvalidateAll());
+    }
+}
+
+// Method Description:
+// - Enables or disables sending long runs of a single character with REP.
+//   Only terminals that told us they support REP may get them. Others would
+//   only print the run's first character.
+// Arguments:
+// - enabled: true to emit REP sequences.
+// Return Value:
+// - <none>
+void VtEngine::SetRepeatCharacter(const bool enabled) noexcept
+{
+    _repeatCharacter = enabled;
+}
+
+// Method Description:
+// - Writes a string the client wrote in passthrough mode to the terminal,
+//   verbatim, and flushes it immediately. It isn't painted from the buffer
+//   again, so nothing else would send it.
+// Arguments:
+// - str: the client's VT output.
+// Return Value:
+// - S_OK or suitable HRESULT error from either conversion or writing pipe.
+[[nodiscard]] HRESULT VtEngine::PassthroughString(const std::wstring_view str) noexcept
+{
+    RETURN_IF_FAILED(_WriteTerminalUtf8(str));
+    return _Flush();
+}
+
+// Method Description:
+// - Forgets everything we know about the terminal's contents. This needs to be
+//   called whenever the terminal's contents move or change in a way we don't
+//   track cell by cell, like scrolling, clearing the screen or resizing.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtEngine::_ResetShadowFrame() noexcept
+{
+    if (!_shadowFrameDiffing)
+    {
+        _shadowFrame.clear();
+        return;
+    }
+
+    try
+    {
+        const auto dimensions = _lastViewport.Dimensions();
+        _shadowFrame.assign(gsl::narrow_cast<size_t>(dimensions.X) * gsl::narrow_cast<size_t>(std::max<SHORT>(dimensions.Y, 0)), ShadowCell{});
+    }
+    catch (...)
+    {
+        // Without a shadow frame of the right size nothing will be diffed.
+        LOG_CAUGHT_EXCEPTION();
+        _shadowFrame.clear();
+    }
+}
+
+// Method Description:
+// - Marks the given cells of a row as unknown, for instance because we erased
+//   them, so they'll be sent again the next time they're painted.
+// Arguments:
+// - coord: the first cell, in viewport coordinates.
+// - count: the number of cells, clamped to the end of the row.
+// Return Value:
+// - <none>
+void VtEngine::_InvalidateShadowCells(const COORD coord, const size_t count) noexcept
+{
+    const auto width = gsl::narrow_cast<size_t>(std::max<SHORT>(_lastViewport.Width(), 0));
+    if (const auto cell = _GetShadowCell(coord))
+    {
+        const auto end = std::min(count, width - gsl::narrow_cast<size_t>(coord.X));
+        std::fill_n(cell, end, ShadowCell{});
+    }
+}
+
+// Method Description:
+// - Returns the shadow cell at the given position, or nullptr if we aren't
+//   diffing or the position is outside of the shadow frame.
+// Arguments:
+// - coord: the cell, in viewport coordinates.
+// Return Value:
+// - a pointer to the cell, the rest of the row follows it.
+VtEngine::ShadowCell* VtEngine::_GetShadowCell(const COORD coord) noexcept
+{
+    const auto width = _lastViewport.Width();
+    const auto height = _lastViewport.Height();
+    if (coord.X < 0 || coord.Y < 0 || coord.X >= width || coord.Y >= height ||
+        _shadowFrame.size() != gsl::narrow_cast<size_t>(width) * gsl::narrow_cast<size_t>(height))
+    {
+        return nullptr;
+    }
+    return &til::at(_shadowFrame, gsl::narrow_cast<size_t>(coord.Y) * width + coord.X);
+}
+
 // Method Description:
 // - Manually emit a "Erase Scrollback" sequence to the connected terminal. We
 //   need to do this in certain cases that we've identified where we believe the
@@ -212,6 +212,23 @@ void RenderTracing::TraceEndPaint() const
 #endif UNIT_TESTING
 }
 
+void RenderTracing::TraceFlush(const size_t bytes, const size_t flushCount, const size_t totalBytes) const
+{
+#ifndef UNIT_TESTING
+    TraceLoggingWrite(g_hConsoleVtRendererTraceProvider,
+                      "VtEngine_TraceFlush",
+                      TraceLoggingUInt64(static_cast<uint64_t>(bytes), "Bytes"),
+                      TraceLoggingUInt64(static_cast<uint64_t>(flushCount), "FlushCount"),
+                      TraceLoggingUInt64(static_cast<uint64_t>(flushCount ? totalBytes / flushCount : 0), "AverageBytes"),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+#else
+    UNREFERENCED_PARAMETER(bytes);
+    UNREFERENCED_PARAMETER(flushCount);
+    UNREFERENCED_PARAMETER(totalBytes);
+#endif UNIT_TESTING
+}
+
 void RenderTracing::TraceLastText(const til::point lastTextPos) const
 {
 #ifndef UNIT_TESTING
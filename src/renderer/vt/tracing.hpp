@@ -45,5 +45,6 @@ namespace Microsoft::Console::VirtualTerminal
                              const bool cursorMoved,
                              const std::optional<short>& wrappedRow) const;
         void TraceEndPaint() const;
+        void TraceFlush(const size_t bytes, const size_t flushCount, const size_t totalBytes) const;
     };
 }
@@ -38,6 +38,8 @@ namespace Microsoft::Console::Render
     public:
         // See _PaintUtf8BufferLine for explanation of this value.
         static const size_t ERASE_CHARACTER_STRING_LENGTH = 8;
+        // See _WriteTerminalUtf8Repeated for explanation of this value.
+        static const size_t REPEAT_CHARACTER_STRING_LENGTH = 6;
         static const COORD INVALID_COORDS;
 
         VtEngine(_In_ wil::unique_hfile hPipe,
@@ -57,6 +59,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] virtual HRESULT StartPaint() noexcept override;
         [[nodiscard]] virtual HRESULT EndPaint() noexcept override;
         [[nodiscard]] virtual HRESULT Present() noexcept override;
+        [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
 
         [[nodiscard]] virtual HRESULT ScrollFrame() noexcept = 0;
 
@@ -94,6 +97,7 @@ namespace Microsoft::Console::Render
 
         [[nodiscard]] HRESULT RequestCursor() noexcept;
         [[nodiscard]] HRESULT InheritCursor(const COORD coordCursor) noexcept;
+        void SetInheritingCursor(const bool inheriting) noexcept;
 
         [[nodiscard]] HRESULT WriteTerminalUtf8(const std::string_view str) noexcept;
 
@@ -104,6 +108,11 @@ namespace Microsoft::Console::Render
         void EndResizeRequest();
 
         void SetResizeQuirk(const bool resizeQuirk);
+        void SetShadowFrameDiffing(const bool enabled);
+        void SetFlushPolicy(const size_t sizeThreshold, const std::chrono::milliseconds latencyBudget) noexcept;
+        void SetPassthroughMode(const bool passthrough) noexcept;
+        void SetRepeatCharacter(const bool enabled) noexcept;
+        [[nodiscard]] HRESULT PassthroughString(const std::wstring_view str) noexcept;
 
         [[nodiscard]] virtual HRESULT ManuallyClearScrollback() noexcept;
 
@@ -113,6 +122,17 @@ namespace Microsoft::Console::Render
         wil::unique_hfile _hFile;
         std::string _buffer;
 
+        // Output that was captured instead of written, see _captureOutput.
+        // Every write is kept separately, so that it can be written the same
+        // way later on.
+        struct CapturedOutput
+        {
+            std::string text;
+            std::vector<size_t> lengths;
+        };
+        // While this is set, _Write appends to it instead of writing.
+        CapturedOutput* _captureOutput{ nullptr };
+
         std::string _formatBuffer;
         std::string _conversionBuffer;
 
@@ -152,10 +172,49 @@ namespace Microsoft::Console::Render
         bool _delayedEolWrap{ false };
 
         bool _resizeQuirk{ false };
+        bool _passthrough{ false };
+        bool _repeatCharacter{ false };
+        bool _inheritingCursor{ false };
+
+        // Output is held in _buffer until the oldest of it has waited for
+        // _flushLatency, or _flushThreshold bytes are pending. The defaults
+        // write it out at the end of every frame.
+        size_t _flushThreshold{ 0 };
+        std::chrono::milliseconds _flushLatency{ 0 };
+        std::chrono::steady_clock::time_point _pendingSince{};
+        size_t _frameStart{ 0 };
+        size_t _flushCount{ 0 };
+        size_t _flushedBytes{ 0 };
         std::optional<TextColor> _newBottomLineBG{ std::nullopt };
 
+        // A copy of what we believe the connected terminal currently shows in
+        // each cell of the viewport, so that we can avoid re-sending text it
+        // already has. A cell with a ch of 0 is unknown and always differs.
+        struct ShadowCell
+        {
+            wchar_t ch{ 0 };
+            TextAttribute attr{};
+        };
+        bool _shadowFrameDiffing{ false };
+        std::vector<ShadowCell> _shadowFrame;
+
+        void _ResetShadowFrame() noexcept;
+        void _DiffAgainstShadowFrame(gsl::span<const Cluster> const clusters,
+                                     const COORD coord,
+                                     const size_t cchActual,
+                                     const bool lineWrapped,
+                                     size_t& skipFront,
+                                     size_t& skipBack) noexcept;
+        void _UpdateShadowFrame(gsl::span<const Cluster> const clusters,
+                                const COORD coord,
+                                const size_t cchActual,
+                                const size_t totalWidth) noexcept;
+        void _InvalidateShadowCells(const COORD coord, const size_t count) noexcept;
+        ShadowCell* _GetShadowCell(const COORD coord) noexcept;
+
         [[nodiscard]] HRESULT _Write(std::string_view const str) noexcept;
         [[nodiscard]] HRESULT _Flush() noexcept;
+        [[nodiscard]] HRESULT _FlushIfNeeded() noexcept;
 
         template<typename S, typename... Args>
         [[nodiscard]] HRESULT _WriteFormatted(S&& format, Args&&... args)
@@ -180,6 +239,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _InsertLine(const short sLines) noexcept;
         [[nodiscard]] HRESULT _CursorForward(const short chars) noexcept;
         [[nodiscard]] HRESULT _EraseCharacter(const short chars) noexcept;
+        [[nodiscard]] HRESULT _RepeatCharacter(const size_t count) noexcept;
         [[nodiscard]] HRESULT _CursorPosition(const COORD coord) noexcept;
         [[nodiscard]] HRESULT _CursorHome() noexcept;
         [[nodiscard]] HRESULT _ClearScreen() noexcept;
@@ -231,7 +291,9 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _PaintAsciiBufferLine(gsl::span<const Cluster> const clusters,
                                                     const COORD coord) noexcept;
 
+        [[nodiscard]] HRESULT _WriteCaptured(const CapturedOutput& output) noexcept;
         [[nodiscard]] HRESULT _WriteTerminalUtf8(const std::wstring_view str) noexcept;
+        [[nodiscard]] HRESULT _WriteTerminalUtf8Repeated(const std::wstring_view str) noexcept;
         [[nodiscard]] HRESULT _WriteTerminalAscii(const std::wstring_view str) noexcept;
 
         [[nodiscard]] virtual HRESULT _DoUpdateTitle(const std::wstring_view newTitle) noexcept override;
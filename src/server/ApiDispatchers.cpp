@@ -11,6 +11,58 @@
 #include "../host/srvinit.h"
 #include "../host/telemetry.hpp"
 #include "../host/cmdline.h"
+#include "../host/handle.h"
+#include "../host/server.h"
+
+#include "../interactivity/inc/ServiceLocator.hpp"
+
+using Microsoft::Console::Interactivity::ServiceLocator;
+
+// Routine Description:
+// - In conpty passthrough mode (see VtIo::IsPassthrough) the terminal only sees
+//   what clients write as VT. The dispatchers of APIs that change the buffer in
+//   any other way call this after the change, with a function that describes
+//   it as a VT sequence. It's called under the console lock, and returns
+//   std::nullopt if the change can't be described that way. In that case, we
+//   leave passthrough mode, so that the VT renderer paints it instead.
+// Arguments:
+// - getSequence: returns the VT sequence for the change. An empty sequence
+//   means that the terminal didn't need to hear about it.
+// Return Value:
+// - <none>
+template<typename T>
+static void _UpdateVtPassthrough(T&& getSequence) noexcept
+try
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+    LockConsole();
+    auto Unlock = wil::scope_exit([&] { UnlockConsole(); });
+
+    if (!gci.IsInVtIoMode() || !gci.GetVtIo()->IsPassthrough())
+    {
+        return;
+    }
+
+    const std::optional<std::wstring> sequence = getSequence();
+    if (!sequence.has_value())
+    {
+        gci.GetVtIo()->EndPassthrough();
+    }
+    else if (!sequence->empty() && FAILED_LOG(gci.GetVtIo()->PassthroughString(*sequence)))
+    {
+        gci.GetVtIo()->EndPassthrough();
+    }
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Leaves conpty passthrough mode, for dispatchers of APIs that change the
+//   buffer in ways we can't describe as VT. See _UpdateVtPassthrough.
+static void _EndVtPassthrough() noexcept
+{
+    _UpdateVtPassthrough([]() -> std::optional<std::wstring> { return std::nullopt; });
+}
 
 [[nodiscard]] HRESULT ApiDispatchers::ServerGetConsoleCP(_Inout_ CONSOLE_API_MSG* const m,
                                                          _Inout_ BOOL* const /*pbReplyPending*/)
@@ -319,6 +371,12 @@
     // across multiple calls when we are simulating a command prompt input line for the client application.
     INPUT_READ_HANDLE_DATA* const pInputReadHandleData = HandleData->GetClientInput();
 
+    // A cooked read echoes what the user types without any VT, see _UpdateVtPassthrough.
+    if (WI_AreAllFlagsSet(pInputBuffer->InputMode, ENABLE_LINE_INPUT | ENABLE_ECHO_INPUT))
+    {
+        _EndVtPassthrough();
+    }
+
     std::unique_ptr<IWaitRoutine> waiter;
     size_t cbWritten;
 
@@ -462,6 +520,9 @@
 [[nodiscard]] HRESULT ApiDispatchers::ServerFillConsoleOutput(_Inout_ CONSOLE_API_MSG* const m,
                                                               _Inout_ BOOL* const /*pbReplyPending*/)
 {
+    // This changes the buffer without any VT, see _UpdateVtPassthrough.
+    auto endVtPassthrough = wil::scope_exit([]() noexcept { _EndVtPassthrough(); });
+
     PCONSOLE_FILLCONSOLEOUTPUT_MSG const a = &m->u.consoleMsgL2.FillConsoleOutput;
 
     switch (a->ElementType)
@@ -545,6 +606,7 @@
     RETURN_IF_FAILED(pObjectHandle->GetScreenBuffer(GENERIC_WRITE, &pObj));
 
     m->_pApiRoutines->SetConsoleActiveScreenBufferImpl(*pObj);
+    _EndVtPassthrough();
     return S_OK;
 }
 
@@ -609,7 +671,17 @@
     SCREEN_INFORMATION* pObj;
     RETURN_IF_FAILED(pObjectHandle->GetScreenBuffer(GENERIC_WRITE, &pObj));
 
-    return m->_pApiRoutines->SetConsoleCursorInfoImpl(*pObj, a->CursorSize, a->Visible);
+    RETURN_IF_FAILED(m->_pApiRoutines->SetConsoleCursorInfoImpl(*pObj, a->CursorSize, a->Visible));
+
+    _UpdateVtPassthrough([&]() -> std::optional<std::wstring> {
+        if (!pObj->IsActiveScreenBuffer())
+        {
+            return std::wstring{};
+        }
+        // The terminal picks its own cursor size, only the visibility matters.
+        return pObj->GetTextBuffer().GetCursor().IsVisible() ? L"\x1b[?25h" : L"\x1b[?25l";
+    });
+    return S_OK;
 }
 
 [[nodiscard]] HRESULT ApiDispatchers::ServerGetConsoleScreenBufferInfo(_Inout_ CONSOLE_API_MSG* const m,
@@ -652,6 +724,9 @@
 [[nodiscard]] HRESULT ApiDispatchers::ServerSetConsoleScreenBufferInfo(_Inout_ CONSOLE_API_MSG* const m,
                                                                        _Inout_ BOOL* const /*pbReplyPending*/)
 {
+    // This changes the buffer without any VT, see _UpdateVtPassthrough.
+    auto endVtPassthrough = wil::scope_exit([]() noexcept { _EndVtPassthrough(); });
+
     Telemetry::Instance().LogApiCall(Telemetry::ApiCall::SetConsoleScreenBufferInfoEx);
     CONSOLE_SCREENBUFFERINFO_MSG* const a = &m->u.consoleMsgL2.SetConsoleScreenBufferInfo;
 
@@ -692,7 +767,9 @@
     SCREEN_INFORMATION* pObj;
     RETURN_IF_FAILED(pObjectHandle->GetScreenBuffer(GENERIC_WRITE, &pObj));
 
-    return m->_pApiRoutines->SetConsoleScreenBufferSizeImpl(*pObj, a->Size);
+    const auto hr = m->_pApiRoutines->SetConsoleScreenBufferSizeImpl(*pObj, a->Size);
+    _EndVtPassthrough();
+    return hr;
 }
 
 [[nodiscard]] HRESULT ApiDispatchers::ServerSetConsoleCursorPosition(_Inout_ CONSOLE_API_MSG* const m,
@@ -707,7 +784,26 @@
     SCREEN_INFORMATION* pObj;
     RETURN_IF_FAILED(pObjectHandle->GetScreenBuffer(GENERIC_WRITE, &pObj));
 
-    return m->_pApiRoutines->SetConsoleCursorPositionImpl(*pObj, a->CursorPosition);
+    RETURN_IF_FAILED(m->_pApiRoutines->SetConsoleCursorPositionImpl(*pObj, a->CursorPosition));
+
+    _UpdateVtPassthrough([&]() -> std::optional<std::wstring> {
+        if (!pObj->IsActiveScreenBuffer())
+        {
+            return std::wstring{};
+        }
+
+        const auto& viewport = pObj->GetViewport();
+        const auto position = pObj->GetTextBuffer().GetCursor().GetPosition();
+        if (!viewport.IsInBounds(position))
+        {
+            // The viewport moved to follow the cursor. CUP can't do that.
+            return std::nullopt;
+        }
+
+        // CUP is 1-based and relative to the viewport.
+        return L"\x1b[" + std::to_wstring(position.Y - viewport.Top() + 1) + L";" + std::to_wstring(position.X - viewport.Left() + 1) + L"H";
+    });
+    return S_OK;
 }
 
 [[nodiscard]] HRESULT ApiDispatchers::ServerGetLargestConsoleWindowSize(_Inout_ CONSOLE_API_MSG* const m,
@@ -729,6 +825,9 @@
 [[nodiscard]] HRESULT ApiDispatchers::ServerScrollConsoleScreenBuffer(_Inout_ CONSOLE_API_MSG* const m,
                                                                       _Inout_ BOOL* const /*pbReplyPending*/)
 {
+    // This changes the buffer without any VT, see _UpdateVtPassthrough.
+    auto endVtPassthrough = wil::scope_exit([]() noexcept { _EndVtPassthrough(); });
+
     CONSOLE_SCROLLSCREENBUFFER_MSG* const a = &m->u.consoleMsgL2.ScrollConsoleScreenBuffer;
     Telemetry::Instance().LogApiCall(Telemetry::ApiCall::ScrollConsoleScreenBuffer, a->Unicode);
 
@@ -791,7 +890,9 @@
     SCREEN_INFORMATION* pObj;
     RETURN_IF_FAILED(pObjectHandle->GetScreenBuffer(GENERIC_WRITE, &pObj));
 
-    return m->_pApiRoutines->SetConsoleWindowInfoImpl(*pObj, a->Absolute, a->Window);
+    const auto hr = m->_pApiRoutines->SetConsoleWindowInfoImpl(*pObj, a->Absolute, a->Window);
+    _EndVtPassthrough();
+    return hr;
 }
 
 [[nodiscard]] HRESULT ApiDispatchers::ServerReadConsoleOutputString(_Inout_ CONSOLE_API_MSG* const m,
@@ -901,6 +1002,9 @@
 [[nodiscard]] HRESULT ApiDispatchers::ServerWriteConsoleOutput(_Inout_ CONSOLE_API_MSG* const m,
                                                                _Inout_ BOOL* const /*pbReplyPending*/)
 {
+    // This changes the buffer without any VT, see _UpdateVtPassthrough.
+    auto endVtPassthrough = wil::scope_exit([]() noexcept { _EndVtPassthrough(); });
+
     PCONSOLE_WRITECONSOLEOUTPUT_MSG const a = &m->u.consoleMsgL2.WriteConsoleOutput;
 
     Telemetry::Instance().LogApiCall(Telemetry::ApiCall::WriteConsoleOutput, a->Unicode);
@@ -947,6 +1051,9 @@
 [[nodiscard]] HRESULT ApiDispatchers::ServerWriteConsoleOutputString(_Inout_ CONSOLE_API_MSG* const m,
                                                                      _Inout_ BOOL* const /*pbReplyPending*/)
 {
+    // This changes the buffer without any VT, see _UpdateVtPassthrough.
+    auto endVtPassthrough = wil::scope_exit([]() noexcept { _EndVtPassthrough(); });
+
     PCONSOLE_WRITECONSOLEOUTPUTSTRING_MSG const a = &m->u.consoleMsgL2.WriteConsoleOutputString;
 
     auto tracing = wil::scope_exit([&]() {
@@ -1157,13 +1264,30 @@
     if (a->Unicode)
     {
         const std::wstring_view title(reinterpret_cast<wchar_t*>(pvBuffer), cbOriginalLength / sizeof(wchar_t));
-        return m->_pApiRoutines->SetConsoleTitleWImpl(title);
+        RETURN_IF_FAILED(m->_pApiRoutines->SetConsoleTitleWImpl(title));
     }
     else
     {
         const std::string_view title(reinterpret_cast<char*>(pvBuffer), cbOriginalLength);
-        return m->_pApiRoutines->SetConsoleTitleAImpl(title);
+        RETURN_IF_FAILED(m->_pApiRoutines->SetConsoleTitleAImpl(title));
     }
+
+    _UpdateVtPassthrough([]() -> std::optional<std::wstring> {
+        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        // Control characters would end the OSC early, or start another sequence.
+        std::wstring sequence{ L"\x1b]0;" };
+        for (const auto wch : gci.GetTitle())
+        {
+            if (wch >= L' ' && wch != L'\x7f')
+            {
+                sequence.push_back(wch);
+            }
+        }
+        sequence.push_back(L'\x07');
+        return sequence;
+    });
+    return S_OK;
 }
 
 [[nodiscard]] HRESULT ApiDispatchers::ServerGetConsoleMouseInfo(_Inout_ CONSOLE_API_MSG* const m,
@@ -113,7 +113,9 @@ try
             _inputBuffer.shrink_to_fit();
         }
 
-        _inputBuffer.resize(cbReadSize);
+        // The driver overwrites all of it, so don't zero it first.
+        // For a multi-megabyte write that would be a full extra pass over it.
+        _inputBuffer.resize(cbReadSize, boost::container::default_init);
 
         RETURN_IF_FAILED(ReadMessageInput(0, _inputBuffer.data(), cbReadSize));
 
@@ -152,6 +154,9 @@ try
         ULONG cbWriteSize = Descriptor.OutputSize - State.WriteOffset;
         RETURN_IF_FAILED(ULongMult(cbWriteSize, cbFactor, &cbWriteSize));
 
+        // ReleaseMessageBuffers leaves the contents of the previous message around for the driver.
+        _outputBuffer.clear();
+
         // If we were previously called with a huge buffer we have an equally large _outputBuffer.
         // We shouldn't just keep this huge buffer around, if no one needs it anymore.
         if (_outputBuffer.capacity() > 16 * 1024 && (_outputBuffer.capacity() >> 1) > cbWriteSize)
@@ -159,11 +164,9 @@ try
             _outputBuffer.shrink_to_fit();
         }
 
+        // This zeroes it out, since it was cleared above.
         _outputBuffer.resize(cbWriteSize);
 
-        // 0 it out.
-        std::fill_n(_outputBuffer.data(), _outputBuffer.size(), BYTE(0));
-
         State.OutputBuffer = _outputBuffer.data();
         State.OutputBufferSize = cbWriteSize;
     }
@@ -194,8 +197,11 @@ CATCH_RETURN();
 // Routine Description:
 // - This routine releases output or input buffers that might have been allocated
 //   during the processing of the given message. If the current completion status
-//   of the message indicates success, this routine also writes the output buffer
-//   (if any) to the message.
+//   of the message indicates success, this routine also attaches the output buffer
+//   (if any) to the completion of the message.
+// - The driver copies the attached output to the client as part of the completion,
+//   which saves us a separate IOCTL_CONDRV_WRITE_OUTPUT round trip. That means the
+//   output buffer has to stay alive until the completion has been sent.
 // Arguments:
 // - <none>
 // Return Value:
@@ -215,16 +221,13 @@ CATCH_RETURN();
     {
         if (NT_SUCCESS(Complete.IoStatus.Status))
         {
-            CD_IO_OPERATION IoOperation;
-            IoOperation.Identifier = Descriptor.Identifier;
-            IoOperation.Buffer.Offset = State.WriteOffset;
-            IoOperation.Buffer.Data = State.OutputBuffer;
-            IoOperation.Buffer.Size = (ULONG)Complete.IoStatus.Information;
-
-            LOG_IF_FAILED(_pDeviceComm->WriteOutput(&IoOperation));
+            Complete.Write.Offset = State.WriteOffset;
+            Complete.Write.Data = State.OutputBuffer;
+            Complete.Write.Size = (ULONG)Complete.IoStatus.Information;
         }
 
-        _outputBuffer.clear();
+        // Don't clear _outputBuffer: the driver reads it when the completion is sent.
+        // GetAugmentedOutputBuffer clears it when the next message needs it.
         State.OutputBuffer = nullptr;
         State.OutputBufferSize = 0;
     }
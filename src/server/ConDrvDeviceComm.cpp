@@ -4,6 +4,8 @@
 #include "precomp.h"
 #include "ConDrvDeviceComm.h"
 
+#include "../host/tracing.hpp"
+
 ConDrvDeviceComm::ConDrvDeviceComm(_In_ HANDLE Server) :
     _Server(Server)
 {
@@ -53,6 +55,15 @@ ConDrvDeviceComm::~ConDrvDeviceComm()
         hr = S_OK; // TODO: MSFT: 9115192 - ??? This isn't really relevant anymore with a switch from NtDeviceIoControlFile to DeviceIoControl...
     }
 
+    if (SUCCEEDED(hr))
+    {
+        const auto messages = _messages.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (messages % StatisticsInterval == 0)
+        {
+            Tracing::s_TraceDeviceCommStatistics(messages, _transitions.load(std::memory_order_relaxed));
+        }
+    }
+
     return hr;
 }
 
@@ -139,6 +150,7 @@ ConDrvDeviceComm::~ConDrvDeviceComm()
     // See: https://msdn.microsoft.com/en-us/library/windows/desktop/aa363216(v=vs.85).aspx
     // Written is unused but cannot be nullptr because we aren't using overlapped.
     DWORD cbWritten = 0;
+    _transitions.fetch_add(1, std::memory_order_relaxed);
     RETURN_IF_WIN32_BOOL_FALSE(DeviceIoControl(_Server.get(),
                                                dwIoControlCode,
                                                pInBuffer,
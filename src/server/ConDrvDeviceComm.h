@@ -50,4 +50,10 @@ private:
                                      _In_ DWORD cbOutBufferSize) const;
 
     wil::unique_handle _Server;
+
+    // How many messages we've read and how many round trips into the driver it took.
+    // Every StatisticsInterval messages they're written to the trace log.
+    static constexpr uint64_t StatisticsInterval{ 1024 };
+    mutable std::atomic<uint64_t> _messages{ 0 };
+    mutable std::atomic<uint64_t> _transitions{ 0 };
 };
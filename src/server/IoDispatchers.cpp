@@ -346,6 +346,13 @@ PCONSOLE_API_MSG IoDispatchers::ConsoleHandleConnectionRequest(_In_ PCONSOLE_API
         CATCH_LOG(); // Just log, don't do anything more. We'll move on to launching normally on failure.
     }
 
+    // ConsoleServerInitialization skips creating the accessibility notifier
+    // when it expects a handoff. We're hosting this session ourselves after all.
+    if (!ServiceLocator::LocateAccessibilityNotifier() && !Globals.launchArgs.InConptyMode())
+    {
+        LOG_IF_FAILED(ServiceLocator::CreateAccessibilityNotifier());
+    }
+
     Status = NTSTATUS_FROM_HRESULT(gci.ProcessHandleList.AllocProcessData(dwProcessId,
                                                                           dwThreadId,
                                                                           Cac.ProcessGroupId,
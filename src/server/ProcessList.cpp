@@ -58,14 +58,31 @@ using namespace Microsoft::Console::Interactivity;
 
     try
     {
-        pProcessData = new ConsoleProcessHandle(dwProcessId,
-                                                dwThreadId,
-                                                ulProcessGroupId);
+        std::unique_ptr<ConsoleProcessHandle> newProcessData{ new ConsoleProcessHandle(dwProcessId,
+                                                                                       dwThreadId,
+                                                                                       ulProcessGroupId) };
+
+        auto& group = _processesByGroupId[ulProcessGroupId];
+        group.push_back(newProcessData.get());
+        auto removeFromGroup = wil::scope_exit([&]() noexcept {
+            group.pop_back();
+            if (group.empty())
+            {
+                _processesByGroupId.erase(ulProcessGroupId);
+            }
+        });
 
         // Some applications, when reading the process list through the GetConsoleProcessList API, are expecting
         // the returned list of attached process IDs to be from newest to oldest.
         // As such, we have to put the newest process into the head of the list.
-        _processes.push_front(pProcessData);
+        _processes.push_front(newProcessData.get());
+        auto removeFromList = wil::scope_exit([&]() noexcept { _processes.pop_front(); });
+
+        _processesById.emplace(dwProcessId, _processes.cbegin());
+
+        removeFromList.release();
+        removeFromGroup.release();
+        pProcessData = newProcessData.release();
 
         if (nullptr != ppProcessData)
         {
@@ -87,10 +104,23 @@ void ConsoleProcessList::FreeProcessData(_In_ ConsoleProcessHandle* const pProce
 {
     FAIL_FAST_IF(!(ServiceLocator::LocateGlobals().getConsoleInformation().IsConsoleLocked()));
 
-    // Assert that the item exists in the list. If it doesn't exist, the end/last will be returned.
-    FAIL_FAST_IF(!(_processes.cend() != std::find(_processes.cbegin(), _processes.cend(), pProcessData)));
+    // Assert that the item exists in the list.
+    const auto it = _processesById.find(pProcessData->dwProcessId);
+    FAIL_FAST_IF(it == _processesById.end() || *it->second != pProcessData);
+
+    _processes.erase(it->second);
+    _processesById.erase(it);
 
-    _processes.remove(pProcessData);
+    const auto groupIt = _processesByGroupId.find(pProcessData->_ulProcessGroupId);
+    if (groupIt != _processesByGroupId.end())
+    {
+        auto& group = groupIt->second;
+        group.erase(std::remove(group.begin(), group.end(), pProcessData), group.end());
+        if (group.empty())
+        {
+            _processesByGroupId.erase(groupIt);
+        }
+    }
 
     delete pProcessData;
 }
@@ -104,31 +134,17 @@ void ConsoleProcessList::FreeProcessData(_In_ ConsoleProcessHandle* const pProce
 // - Pointer to the process handle information or nullptr if no match was found.
 ConsoleProcessHandle* ConsoleProcessList::FindProcessInList(const DWORD dwProcessId) const
 {
-    auto it = _processes.cbegin();
-
-    while (it != _processes.cend())
+    if (ROOT_PROCESS_ID != dwProcessId)
     {
-        ConsoleProcessHandle* const pProcessHandleRecord = *it;
-
-        if (ROOT_PROCESS_ID != dwProcessId)
-        {
-            if (pProcessHandleRecord->dwProcessId == dwProcessId)
-            {
-                return pProcessHandleRecord;
-            }
-        }
-        else
-        {
-            if (pProcessHandleRecord->fRootProcess)
-            {
-                return pProcessHandleRecord;
-            }
-        }
-
-        it = std::next(it);
+        const auto it = _processesById.find(dwProcessId);
+        return it != _processesById.end() ? *it->second : nullptr;
     }
 
-    return nullptr;
+    // The root process can change hands, so it isn't indexed.
+    const auto it = std::find_if(_processes.cbegin(), _processes.cend(), [](const auto pProcessHandleRecord) {
+        return pProcessHandleRecord->fRootProcess;
+    });
+    return it != _processes.cend() ? *it : nullptr;
 }
 
 // Routine Description:
@@ -139,20 +155,9 @@ ConsoleProcessHandle* ConsoleProcessList::FindProcessInList(const DWORD dwProces
 // - Pointer to first matching process handle with given group ID. nullptr if no match was found.
 ConsoleProcessHandle* ConsoleProcessList::FindProcessByGroupId(_In_ ULONG ulProcessGroupId) const
 {
-    auto it = _processes.cbegin();
-
-    while (it != _processes.cend())
-    {
-        ConsoleProcessHandle* const pProcessHandleRecord = *it;
-        if (pProcessHandleRecord->_ulProcessGroupId == ulProcessGroupId)
-        {
-            return pProcessHandleRecord;
-        }
-
-        it = std::next(it);
-    }
-
-    return nullptr;
+    // The list is ordered from newest to oldest, so the first match is the group's newest process.
+    const auto it = _processesByGroupId.find(ulProcessGroupId);
+    return it != _processesByGroupId.end() ? it->second.back() : nullptr;
 }
 
 // Routine Description:
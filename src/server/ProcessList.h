@@ -61,5 +61,10 @@ public:
 private:
     std::list<ConsoleProcessHandle*> _processes;
 
+    // Indexes of _processes, so that lookups by process or group ID don't
+    // have to walk the whole list. The groups list their processes oldest first.
+    std::unordered_map<DWORD, std::list<ConsoleProcessHandle*>::const_iterator> _processesById;
+    std::unordered_map<ULONG, std::vector<ConsoleProcessHandle*>> _processesByGroupId;
+
     void _ModifyProcessForegroundRights(const HANDLE hProcess, const bool fForeground) const;
 };
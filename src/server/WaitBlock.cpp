@@ -13,6 +13,42 @@
 
 #include "../interactivity/inc/ServiceLocator.hpp"
 
+std::array<void*, ConsoleWaitBlock::s_MaxPooledBlocks> ConsoleWaitBlock::s_pooledBlocks{};
+size_t ConsoleWaitBlock::s_pooledBlockCount = 0;
+
+// Routine Description:
+// - Allocates the storage for a ConsoleWaitBlock, reusing the storage of a
+//   block that was destroyed earlier if there is one.
+// Arguments:
+// - size - The size of the block
+// Return Value:
+// - The storage for the block. Throws on failure.
+void* ConsoleWaitBlock::operator new(const size_t size)
+{
+    if (size == sizeof(ConsoleWaitBlock) && s_pooledBlockCount > 0)
+    {
+        return til::at(s_pooledBlocks, --s_pooledBlockCount);
+    }
+    return ::operator new(size);
+}
+
+// Routine Description:
+// - Releases the storage of a ConsoleWaitBlock, keeping it for the next block
+//   if the pool isn't full.
+// Arguments:
+// - p - The storage to release
+// Return Value:
+// - <none>
+void ConsoleWaitBlock::operator delete(void* const p) noexcept
+{
+    if (p != nullptr && s_pooledBlockCount < s_MaxPooledBlocks)
+    {
+        til::at(s_pooledBlocks, s_pooledBlockCount++) = p;
+        return;
+    }
+    ::operator delete(p);
+}
+
 // Routine Description:
 // - Initializes a ConsoleWaitBlock
 // - ConsoleWaitBlocks will mostly self-manage their position in their two queues.
@@ -35,7 +35,18 @@ public:
     [[nodiscard]] static HRESULT s_CreateWait(_Inout_ CONSOLE_API_MSG* const pWaitReplymessage,
                                               _In_ IWaitRoutine* const pWaiter);
 
+    static void* operator new(const size_t size);
+    static void operator delete(void* const p) noexcept;
+
 private:
+    // Clients that keep reading create and destroy a wait block for every read
+    // that has to wait, and each block carries a copy of a whole API message.
+    // The storage of blocks that are done with is kept for the next ones.
+    // Blocks are only ever created and destroyed under the console lock.
+    static constexpr size_t s_MaxPooledBlocks = 8;
+    static std::array<void*, s_MaxPooledBlocks> s_pooledBlocks;
+    static size_t s_pooledBlockCount;
+
     ConsoleWaitBlock(_In_ ConsoleWaitQueue* const pProcessQueue,
                      _In_ ConsoleWaitQueue* const pObjectQueue,
                      const CONSOLE_API_MSG* const pWaitReplyMessage,
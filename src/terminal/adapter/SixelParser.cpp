@@ -0,0 +1,369 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "SixelParser.hpp"
+
+using namespace Microsoft::Console::VirtualTerminal;
+
+SixelParser::SixelParser(const VTParameter aspectRatio,
+                         const VTParameter backgroundSelect,
+                         const size_t columnBegin,
+                         const size_t columnCount,
+                         SliceHandler sliceHandler) :
+    _sliceHandler{ std::move(sliceHandler) },
+    _columnBegin{ columnBegin },
+    _maxWidth{ columnCount * CellSize.width<size_t>() },
+    _aspectRatio{ _aspectRatioFromParameter(aspectRatio) }
+{
+    // This is the default palette of the VT340, with its levels given as
+    // percentages. The registers above 16 repeat it.
+    static constexpr std::array<std::array<uint8_t, 3>, 16> defaultPalette{ {
+        { 0, 0, 0 },
+        { 20, 20, 80 },
+        { 80, 13, 13 },
+        { 20, 80, 20 },
+        { 80, 20, 80 },
+        { 20, 80, 80 },
+        { 80, 80, 20 },
+        { 53, 53, 53 },
+        { 26, 26, 26 },
+        { 33, 33, 60 },
+        { 60, 26, 26 },
+        { 33, 60, 33 },
+        { 60, 33, 60 },
+        { 33, 60, 60 },
+        { 60, 60, 33 },
+        { 80, 80, 80 },
+    } };
+    for (size_t i = 0; i < _palette.size(); i++)
+    {
+        const auto& color = til::at(defaultPalette, i % defaultPalette.size());
+        til::at(_palette, i) = _pixelFromRgb(color[0], color[1], color[2]);
+    }
+
+    // Pixels that aren't drawn on are transparent when the background select
+    // parameter is 1. Otherwise they're filled with color register 0.
+    _background = backgroundSelect.value_or(0) == 1 ? 0 : til::at(_palette, 0);
+    _foreground = til::at(_palette, 7);
+}
+
+void SixelParser::AddData(const wchar_t ch)
+{
+    // The parameters of a command end at the first character that isn't one.
+    if (_state != State::Data)
+    {
+        if ((ch >= L'0' && ch <= L'9') || ch == L';')
+        {
+            _addParameterData(ch);
+            return;
+        }
+        _executeCommand();
+    }
+
+    if (ch >= L'?' && ch <= L'~')
+    {
+        _addSixelValue(ch - L'?');
+    }
+    else
+    {
+        // A repeat count only applies to the sixel right after it.
+        _repeatCount = 1;
+
+        switch (ch)
+        {
+        case L'!':
+            _startCommand(State::Repeat);
+            break;
+        case L'#':
+            _startCommand(State::Color);
+            break;
+        case L'"':
+            _startCommand(State::RasterAttributes);
+            break;
+        case L'$':
+            _sixelColumn = 0;
+            break;
+        case L'-':
+            _endOfSixelBand();
+            break;
+        default:
+            // Anything else is ignored.
+            break;
+        }
+    }
+}
+
+void SixelParser::FinalizeData()
+{
+    if (_state != State::Data)
+    {
+        _executeCommand();
+    }
+
+    // Whatever is left in the buffer makes up the last rows of the image. If
+    // the background is filled, the image is at least as high as declared.
+    auto height = _bufferHeight();
+    const auto heightEmitted = _rowsEmitted * CellSize.height<size_t>();
+    if (_background && _declaredHeight > heightEmitted)
+    {
+        height = std::max(height, _declaredHeight - heightEmitted);
+    }
+    while (height > 0)
+    {
+        _emitRow();
+        height -= std::min(height, CellSize.height<size_t>());
+    }
+}
+
+void SixelParser::_startCommand(const State state) noexcept
+{
+    _state = state;
+    _parameters.fill(0);
+    _parameterCount = 0;
+}
+
+void SixelParser::_addParameterData(const wchar_t ch) noexcept
+{
+    if (ch == L';')
+    {
+        // Parameters beyond the last one we know about are ignored.
+        _parameterCount = std::min(_parameterCount + 1, MAX_PARAMETERS);
+    }
+    else if (_parameterCount < MAX_PARAMETERS)
+    {
+        auto& parameter = til::at(_parameters, _parameterCount);
+        parameter = std::min(parameter * 10 + (ch - L'0'), MAX_PARAMETER_VALUE);
+    }
+}
+
+void SixelParser::_executeCommand()
+{
+    switch (_state)
+    {
+    case State::Repeat:
+        _repeatCount = std::max<size_t>(_parameters[0], 1);
+        break;
+    case State::Color:
+        _defineColor();
+        break;
+    case State::RasterAttributes:
+        _setRasterAttributes();
+        break;
+    default:
+        break;
+    }
+    _state = State::Data;
+}
+
+void SixelParser::_defineColor() noexcept
+{
+    // The first parameter is the color register. On its own, it selects the
+    // register that following sixels are drawn with. Otherwise the register
+    // is redefined in the color coordinate system given by the second one.
+    auto& color = til::at(_palette, _parameters[0] % MAX_COLORS);
+    if (_parameterCount > 0)
+    {
+        const auto x = _parameters[2];
+        const auto y = _parameters[3];
+        const auto z = _parameters[4];
+        switch (_parameters[1])
+        {
+        case 1:
+            color = _pixelFromHls(x, y, z);
+            break;
+        case 2:
+            color = _pixelFromRgb(x, y, z);
+            break;
+        default:
+            break;
+        }
+    }
+    _foreground = color;
+}
+
+void SixelParser::_setRasterAttributes()
+{
+    // The pixel aspect ratio is given as a numerator and a denominator. We
+    // can only draw integer ratios, so it's rounded to one.
+    const auto numerator = _parameters[0];
+    const auto denominator = _parameters[1];
+    if (numerator > 0 && denominator > 0)
+    {
+        _aspectRatio = std::clamp<size_t>((numerator + denominator / 2) / denominator, 1, 10);
+    }
+
+    // The declared size only matters when the background is filled in.
+    if (_background)
+    {
+        _ensureWidth(_parameters[2]);
+        _declaredHeight = _parameters[3];
+    }
+}
+
+void SixelParser::_addSixelValue(const size_t value)
+{
+    const auto count = std::min(_repeatCount, _maxWidth - std::min(_sixelColumn, _maxWidth));
+    _repeatCount = 1;
+
+    if (value != 0 && count > 0)
+    {
+        _ensureWidth(_sixelColumn + count);
+        _ensureHeight(_bandTop + SIXEL_HEIGHT * _aspectRatio);
+
+        for (size_t bit = 0; bit < SIXEL_HEIGHT; bit++)
+        {
+            if (value & (1 << bit))
+            {
+                const auto top = _bandTop + bit * _aspectRatio;
+                for (auto y = top; y < top + _aspectRatio; y++)
+                {
+                    const auto offset = y * _width + _sixelColumn;
+                    std::fill_n(_pixels.begin() + offset, count, _foreground);
+                }
+            }
+        }
+    }
+
+    _sixelColumn += count;
+}
+
+void SixelParser::_endOfSixelBand()
+{
+    _sixelColumn = 0;
+    _bandTop += SIXEL_HEIGHT * _aspectRatio;
+
+    // Every row above the next band is complete, so there's no reason to
+    // hold on to it any longer.
+    const auto cellHeight = CellSize.height<size_t>();
+    while (_bandTop >= cellHeight)
+    {
+        _emitRow();
+        _bandTop -= cellHeight;
+    }
+}
+
+void SixelParser::_ensureWidth(const size_t width)
+{
+    const auto requiredWidth = std::min(width, _maxWidth);
+    if (requiredWidth > _width)
+    {
+        // The width is always a whole number of cells. It grows by at least
+        // as much as it already is, so that an image drawn left to right
+        // doesn't have to be laid out again for every cell.
+        const auto cellWidth = CellSize.width<size_t>();
+        const auto alignedWidth = (requiredWidth + cellWidth - 1) / cellWidth * cellWidth;
+        const auto newWidth = std::min(std::max(alignedWidth, _width * 2), _maxWidth);
+        const auto height = _bufferHeight();
+
+        std::vector<uint32_t> pixels(height * newWidth, _background);
+        for (size_t y = 0; y < height; y++)
+        {
+            std::copy_n(_pixels.begin() + y * _width, _width, pixels.begin() + y * newWidth);
+        }
+        _pixels = std::move(pixels);
+        _width = newWidth;
+    }
+}
+
+void SixelParser::_ensureHeight(const size_t height)
+{
+    if (height > _bufferHeight())
+    {
+        _pixels.resize(height * _width, _background);
+    }
+}
+
+size_t SixelParser::_bufferHeight() const noexcept
+{
+    return _width ? _pixels.size() / _width : 0;
+}
+
+void SixelParser::_emitRow()
+{
+    std::shared_ptr<ImageSlice> slice;
+    if (_width > 0)
+    {
+        const auto cellHeight = CellSize.height<size_t>();
+        slice = std::make_shared<ImageSlice>(CellSize, _columnBegin, _width / CellSize.width<size_t>());
+
+        // The buffer may not reach the bottom of the row yet, if nothing
+        // was drawn there. Then the rest of the row is background.
+        const auto pixels = slice->Pixels();
+        const auto copied = std::min(_bufferHeight(), cellHeight) * _width;
+        std::copy_n(_pixels.begin(), copied, pixels.begin());
+        std::fill(pixels.begin() + copied, pixels.end(), _background);
+        _pixels.erase(_pixels.begin(), _pixels.begin() + copied);
+    }
+    _sliceHandler(std::move(slice), _rowsEmitted++);
+}
+
+size_t SixelParser::_aspectRatioFromParameter(const VTParameter aspectRatio) noexcept
+{
+    // This is the number of pixels a sixel is high, for each value of the
+    // macro parameter the VT340 supports.
+    switch (aspectRatio.value_or(0))
+    {
+    case 2:
+        return 5;
+    case 3:
+    case 4:
+        return 3;
+    case 7:
+    case 8:
+    case 9:
+        return 1;
+    default:
+        return 2;
+    }
+}
+
+uint32_t SixelParser::_pixelFromRgb(const size_t red, const size_t green, const size_t blue) noexcept
+{
+    // The levels are percentages. The pixels are opaque BGRA.
+    const auto level = [](const size_t percent) noexcept {
+        return gsl::narrow_cast<uint32_t>((std::min<size_t>(percent, 100) * 255 + 50) / 100);
+    };
+    return 0xFF000000 | level(red) << 16 | level(green) << 8 | level(blue);
+}
+
+uint32_t SixelParser::_pixelFromHls(const size_t hue, const size_t lightness, const size_t saturation) noexcept
+{
+    // In the DEC color wheel, blue is at 0 degrees, red at 120 and green at
+    // 240. We turn it so that red is at 0, like everyone else does it.
+    const auto h = ((hue % 360) + 240) % 360 / 60.0;
+    const auto l = std::min<size_t>(lightness, 100) / 100.0;
+    const auto s = std::min<size_t>(saturation, 100) / 100.0;
+
+    const auto chroma = (1 - std::abs(2 * l - 1)) * s;
+    const auto x = chroma * (1 - std::abs(std::fmod(h, 2) - 1));
+    const auto m = l - chroma / 2;
+
+    auto rgb = std::array<double, 3>{};
+    switch (static_cast<int>(h))
+    {
+    case 0:
+        rgb = { chroma, x, 0 };
+        break;
+    case 1:
+        rgb = { x, chroma, 0 };
+        break;
+    case 2:
+        rgb = { 0, chroma, x };
+        break;
+    case 3:
+        rgb = { 0, x, chroma };
+        break;
+    case 4:
+        rgb = { x, 0, chroma };
+        break;
+    default:
+        rgb = { chroma, 0, x };
+        break;
+    }
+
+    const auto percent = [=](const double value) noexcept {
+        return static_cast<size_t>(std::lround((value + m) * 100));
+    };
+    return _pixelFromRgb(percent(rgb[0]), percent(rgb[1]), percent(rgb[2]));
+}
@@ -0,0 +1,96 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- SixelParser.hpp
+
+Abstract:
+- This decodes the sixel data of the DECSIXEL control sequence into image slices.
+- The data string is decoded as it arrives. Only the pixels of the text row
+  the image is currently on (and of the sixel band that overlaps the next
+  row) are kept around: as soon as a row is complete, it's handed out as an
+  ImageSlice, and so an image of any height can be shown while it's still
+  being received.
+--*/
+
+#pragma once
+
+#include "DispatchTypes.hpp"
+#include "../../buffer/out/ImageSlice.hpp"
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    class SixelParser
+    {
+    public:
+        // The size of a cell on a VT340, in sixel pixels.
+        static constexpr til::size CellSize{ 10, 20 };
+
+        // Called with every row of the image, top to bottom. The index is the
+        // row's offset from the first row of the image. The slice is null if
+        // nothing at all was drawn (yet) on that row.
+        using SliceHandler = std::function<void(std::shared_ptr<const ImageSlice>, const size_t)>;
+
+        SixelParser(const VTParameter aspectRatio,
+                    const VTParameter backgroundSelect,
+                    const size_t columnBegin,
+                    const size_t columnCount,
+                    SliceHandler sliceHandler);
+        ~SixelParser() = default;
+        void AddData(const wchar_t ch);
+        void FinalizeData();
+
+    private:
+        static constexpr size_t MAX_PARAMETERS = 5;
+        static constexpr size_t MAX_PARAMETER_VALUE = 32767;
+        static constexpr size_t MAX_COLORS = 256;
+        static constexpr size_t SIXEL_HEIGHT = 6;
+
+        enum class State
+        {
+            Data,
+            Repeat,
+            Color,
+            RasterAttributes
+        };
+
+        void _startCommand(const State state) noexcept;
+        void _addParameterData(const wchar_t ch) noexcept;
+        void _executeCommand();
+        void _defineColor() noexcept;
+        void _setRasterAttributes();
+        void _addSixelValue(const size_t value);
+        void _endOfSixelBand();
+        void _ensureWidth(const size_t width);
+        void _ensureHeight(const size_t height);
+        size_t _bufferHeight() const noexcept;
+        void _emitRow();
+
+        static size_t _aspectRatioFromParameter(const VTParameter aspectRatio) noexcept;
+        static uint32_t _pixelFromRgb(const size_t red, const size_t green, const size_t blue) noexcept;
+        static uint32_t _pixelFromHls(const size_t hue, const size_t lightness, const size_t saturation) noexcept;
+
+        SliceHandler _sliceHandler;
+        size_t _columnBegin;
+        size_t _maxWidth;
+
+        State _state = State::Data;
+        std::array<size_t, MAX_PARAMETERS> _parameters{};
+        size_t _parameterCount = 0;
+        size_t _repeatCount = 1;
+
+        std::array<uint32_t, MAX_COLORS> _palette{};
+        uint32_t _foreground;
+        uint32_t _background;
+        size_t _aspectRatio;
+        size_t _declaredHeight = 0;
+
+        // The pixels from the top of the current row down, _width to a line.
+        std::vector<uint32_t> _pixels;
+        size_t _width = 0;
+        size_t _sixelColumn = 0;
+        size_t _bandTop = 0;
+        size_t _rowsEmitted = 0;
+    };
+}
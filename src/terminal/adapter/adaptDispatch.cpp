@@ -87,6 +87,31 @@ void AdaptDispatch::PrintString(const std::wstring_view string)
     CATCH_LOG();
 }
 
+// Routine Description:
+// - REP - Prints the given character count times, in a single string.
+// Arguments:
+// - wchPrintable - The character to repeat
+// - count - How many times to print it
+// Return Value:
+// - True.
+bool AdaptDispatch::RepeatCharacter(const wchar_t wchPrintable, const size_t count)
+{
+    try
+    {
+        if (count > 0)
+        {
+            // The character only needs to be translated once. A pending single
+            // shift (SS2, SS3) only applies to the first of them though.
+            const auto first = _termOutput.TranslateKey(wchPrintable);
+            std::wstring string(count, _termOutput.TranslateKey(wchPrintable));
+            string.front() = first;
+            _pDefaults->PrintString(string);
+        }
+    }
+    CATCH_LOG();
+    return true;
+}
+
 // Routine Description:
 // - CUU - Handles cursor upward movement by given distance.
 // CUU and CUD are handled separately from other CUP sequences, because they are
@@ -1127,6 +1152,9 @@ bool AdaptDispatch::_ModeParamsHelper(const DispatchTypes::ModeParams param, con
     case DispatchTypes::ModeParams::ASB_AlternateScreenBuffer:
         success = enable ? UseAlternateScreenBuffer() : UseMainScreenBuffer();
         break;
+    case DispatchTypes::ModeParams::SO_SynchronizedOutput:
+        success = EnableSynchronizedOutput(enable);
+        break;
     case DispatchTypes::ModeParams::W32IM_Win32InputMode:
         success = EnableWin32InputMode(enable);
         break;
@@ -2217,6 +2245,19 @@ bool AdaptDispatch::EnableXtermBracketedPasteMode(const bool /*enabled*/) noexce
     return NoOp();
 }
 
+//Routine Description:
+// Enable "synchronized output mode". While it's set, the renderer holds back
+//      frames (up to a timeout), so that an application redrawing the whole
+//      screen is presented once it's done, rather than half way through.
+//Arguments:
+// - enabled - true to start a synchronized update, false to end it.
+// Return value:
+// True if handled successfully. False otherwise.
+bool AdaptDispatch::EnableSynchronizedOutput(const bool enabled)
+{
+    return _pConApi->PrivateEnableSynchronizedOutput(enabled);
+}
+
 //Routine Description:
 // Set Cursor Style - Changes the cursor's style to match the given Dispatch
 //      cursor style. Unix styles are a combination of the shape and the blinking state.
@@ -2527,6 +2568,66 @@ ITermDispatch::StringHandler AdaptDispatch::DownloadDRCS(const size_t fontNumber
     };
 }
 
+// Method Description:
+// - DECSIXEL - Displays a sixel image, with its top left corner at the cursor
+//   position. The image is decoded while the data string is still arriving,
+//   and each row of it is added to the buffer as soon as it's complete. The
+//   cursor is moved down with every row, scrolling the page when it reaches
+//   the bottom margin, and is left on the last row of the image.
+// Arguments:
+// - aspectRatio - the pixel aspect ratio, unless raster attributes follow
+// - backgroundSelect - 1 if pixels that aren't drawn on are transparent
+// Return value:
+// - a function to receive the data string, or nullptr to ignore it
+ITermDispatch::StringHandler AdaptDispatch::DefineSixelImage(const VTParameter aspectRatio,
+                                                             const VTParameter backgroundSelect)
+{
+    // If we're a conpty, we're just going to ignore the operation for now.
+    // The image would have to be passed through as a whole, and our own
+    // buffer would have to keep its rows clear, to stay in sync.
+    if (_pConApi->IsConsolePty())
+    {
+        return nullptr;
+    }
+
+    CONSOLE_SCREEN_BUFFER_INFOEX csbiex = { 0 };
+    csbiex.cbSize = sizeof(CONSOLE_SCREEN_BUFFER_INFOEX);
+    if (!_pConApi->GetConsoleScreenBufferInfoEx(csbiex))
+    {
+        return nullptr;
+    }
+
+    // The image is clipped at the right edge of the buffer.
+    const size_t columnBegin = csbiex.dwCursorPosition.X;
+    const auto columnCount = gsl::narrow_cast<size_t>(std::max(csbiex.dwSize.X - csbiex.dwCursorPosition.X, 0));
+    _sixelParser = std::make_unique<SixelParser>(aspectRatio, backgroundSelect, columnBegin, columnCount, [=](auto slice, const auto row) {
+        if (row > 0)
+        {
+            _pConApi->PrivateLineFeed(false);
+        }
+        if (slice)
+        {
+            _pConApi->PrivateAddImageSlice(std::move(slice));
+        }
+    });
+
+    return [=](const auto ch) {
+        // We pass the data string straight through to the sixel parser until
+        // we receive an ESC, indicating the end of the string. At that point
+        // the parser can hand out the last rows of the image.
+        if (ch != AsciiChars::ESC)
+        {
+            _sixelParser->AddData(ch);
+        }
+        else
+        {
+            _sixelParser->FinalizeData();
+            _sixelParser.reset();
+        }
+        return true;
+    };
+}
+
 // Routine Description:
 // - Determines whether we should pass any sequence that manipulates
 //   TerminalInput's input generator through the PTY. It encapsulates
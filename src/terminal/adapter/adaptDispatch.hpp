@@ -19,7 +19,9 @@ Author(s):
 #include "conGetSet.hpp"
 #include "adaptDefaults.hpp"
 #include "FontBuffer.hpp"
+#include "SixelParser.hpp"
 #include "terminalOutput.hpp"
+#include "..\..\types\inc\sgrCache.hpp"
 #include "..\..\types\inc\sgrStack.hpp"
 
 namespace Microsoft::Console::VirtualTerminal
@@ -37,6 +39,7 @@ namespace Microsoft::Console::VirtualTerminal
 
         void PrintString(const std::wstring_view string) override;
         void Print(const wchar_t wchPrintable) override;
+        bool RepeatCharacter(const wchar_t wchPrintable, const size_t count) override; // REP
 
         bool CursorUp(const size_t distance) override; // CUU
         bool CursorDown(const size_t distance) override; // CUD
@@ -112,6 +115,7 @@ namespace Microsoft::Console::VirtualTerminal
         bool EnableAnyEventMouseMode(const bool enabled) override; // ?1003
         bool EnableAlternateScroll(const bool enabled) override; // ?1007
         bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override; // ?2004
+        bool EnableSynchronizedOutput(const bool enabled) override; // ?2026
         bool SetCursorStyle(const DispatchTypes::CursorStyle cursorStyle) override; // DECSCUSR
         bool SetCursorColor(const COLORREF cursorColor) override;
 
@@ -140,6 +144,9 @@ namespace Microsoft::Console::VirtualTerminal
                                    const VTParameter cellHeight,
                                    const DispatchTypes::DrcsCharsetSize charsetSize) override; // DECDLD
 
+        StringHandler DefineSixelImage(const VTParameter aspectRatio,
+                                       const VTParameter backgroundSelect) override; // DECSIXEL
+
     private:
         enum class ScrollDirection
         {
@@ -198,6 +205,7 @@ namespace Microsoft::Console::VirtualTerminal
         std::unique_ptr<AdaptDefaults> _pDefaults;
         TerminalOutput _termOutput;
         std::unique_ptr<FontBuffer> _fontBuffer;
+        std::unique_ptr<SixelParser> _sixelParser;
         std::optional<unsigned int> _initialCodePage;
 
         // We have two instances of the saved cursor state, because we need
@@ -215,6 +223,7 @@ namespace Microsoft::Console::VirtualTerminal
         bool _isDECCOLMAllowed;
 
         SgrStack _sgrStack;
+        SgrCache _sgrCache;
 
         size_t _SetRgbColorsHelper(const VTParameters options,
                                    TextAttribute& attr,
@@ -103,6 +103,14 @@ bool AdaptDispatch::SetGraphicsRendition(const VTParameters options)
 
     if (success)
     {
+        // Applications repeat the same few SGR sequences over and over, so
+        // check whether we already know what this one does to these attributes.
+        const auto before = attr;
+        if (_sgrCache.TryLookup(before, options, attr))
+        {
+            return _pConApi->PrivateSetTextAttributes(attr);
+        }
+
         // Run through the graphics options and apply them
         for (size_t i = 0; i < options.size(); i++)
         {
@@ -281,6 +289,7 @@ bool AdaptDispatch::SetGraphicsRendition(const VTParameters options)
                 break;
             }
         }
+        _sgrCache.Store(before, options, attr);
         success = _pConApi->PrivateSetTextAttributes(attr);
     }
 
@@ -16,6 +16,7 @@ Author(s):
 #pragma once
 
 #include "../../types/inc/IInputEvent.hpp"
+#include "../../buffer/out/ImageSlice.hpp"
 #include "../../buffer/out/LineRendition.hpp"
 #include "../../buffer/out/TextAttribute.hpp"
 #include "../../inc/conattrs.hpp"
@@ -72,6 +73,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool PrivateEnableButtonEventMouseMode(const bool enabled) = 0;
         virtual bool PrivateEnableAnyEventMouseMode(const bool enabled) = 0;
         virtual bool PrivateEnableAlternateScroll(const bool enabled) = 0;
+        virtual bool PrivateEnableSynchronizedOutput(const bool enabled) = 0;
         virtual bool PrivateEraseAll() = 0;
         virtual bool GetUserDefaultCursorStyle(CursorType& style) = 0;
         virtual bool SetCursorStyle(const CursorType style) = 0;
@@ -111,5 +113,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool PrivateUpdateSoftFont(const gsl::span<const uint16_t> bitPattern,
                                            const SIZE cellSize,
                                            const size_t centeringHint) = 0;
+
+        virtual bool PrivateAddImageSlice(std::shared_ptr<const ImageSlice> imageSlice) = 0;
     };
 }
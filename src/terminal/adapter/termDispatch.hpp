@@ -23,6 +23,7 @@ public:
     void Execute(const wchar_t wchControl) override = 0;
     void Print(const wchar_t wchPrintable) override = 0;
     void PrintString(const std::wstring_view string) override = 0;
+    bool RepeatCharacter(const wchar_t /*wchPrintable*/, const size_t /*count*/) noexcept override { return false; } // REP
 
     bool CursorUp(const size_t /*distance*/) noexcept override { return false; } // CUU
     bool CursorDown(const size_t /*distance*/) noexcept override { return false; } // CUD
@@ -73,6 +74,7 @@ public:
     bool EnableAnyEventMouseMode(const bool /*enabled*/) noexcept override { return false; } // ?1003
     bool EnableAlternateScroll(const bool /*enabled*/) noexcept override { return false; } // ?1007
     bool EnableXtermBracketedPasteMode(const bool /*enabled*/) noexcept override { return false; } // ?2004
+    bool EnableSynchronizedOutput(const bool /*enabled*/) noexcept override { return false; } // ?2026
     bool SetColorTableEntry(const size_t /*tableIndex*/, const DWORD /*color*/) noexcept override { return false; } // OSCColorTable
     bool SetDefaultForeground(const DWORD /*color*/) noexcept override { return false; } // OSCDefaultForeground
     bool SetDefaultBackground(const DWORD /*color*/) noexcept override { return false; } // OSCDefaultBackground
@@ -132,4 +134,7 @@ public:
                                const DispatchTypes::DrcsFontUsage /*fontUsage*/,
                                const VTParameter /*cellHeight*/,
                                const DispatchTypes::DrcsCharsetSize /*charsetSize*/) noexcept override { return nullptr; }
+
+    StringHandler DefineSixelImage(const VTParameter /*aspectRatio*/,
+                                   const VTParameter /*backgroundSelect*/) noexcept override { return nullptr; }
 };
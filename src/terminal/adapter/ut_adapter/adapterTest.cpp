@@ -412,6 +412,16 @@ public:
         return _privateEnableAlternateScrollResult;
     }
 
+    bool PrivateEnableSynchronizedOutput(const bool enabled) override
+    {
+        Log::Comment(L"PrivateEnableSynchronizedOutput MOCK called...");
+        if (_privateEnableSynchronizedOutputResult)
+        {
+            VERIFY_ARE_EQUAL(_expectedSynchronizedOutputEnabled, enabled);
+        }
+        return _privateEnableSynchronizedOutputResult;
+    }
+
     bool PrivateEraseAll() override
     {
         Log::Comment(L"PrivateEraseAll MOCK called...");
@@ -580,6 +590,15 @@ public:
         return TRUE;
     }
 
+    bool PrivateAddImageSlice(std::shared_ptr<const ImageSlice> imageSlice) override
+    {
+        Log::Comment(L"PrivateAddImageSlice MOCK called...");
+
+        _imageSlices.push_back(std::move(imageSlice));
+
+        return TRUE;
+    }
+
     void PrepData()
     {
         PrepData(CursorDirection::UP); // if called like this, the cursor direction doesn't matter.
@@ -805,6 +824,8 @@ public:
     bool _privateEnableButtonEventMouseModeResult = false;
     bool _privateEnableAnyEventMouseModeResult = false;
     bool _privateEnableAlternateScrollResult = false;
+    bool _expectedSynchronizedOutputEnabled = false;
+    bool _privateEnableSynchronizedOutputResult = false;
     bool _setCursorStyleResult = false;
     CursorType _expectedCursorStyle;
     bool _setCursorColorResult = false;
@@ -824,6 +845,7 @@ public:
     COLORREF _expectedDefaultBackgroundColorValue = INVALID_COLOR;
 
     SIZE _expectedCellSize = {};
+    std::vector<std::shared_ptr<const ImageSlice>> _imageSlices;
 
 private:
     HANDLE _hCon;
@@ -1736,6 +1758,49 @@ public:
         VERIFY_IS_TRUE(_pDispatch->PopGraphicsRendition());
     }
 
+    TEST_METHOD(GraphicsRepeatedSequenceTests)
+    {
+        Log::Comment(L"Starting test...");
+
+        _testGetSet->PrepData(); // default color from here is gray on black, FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED
+
+        VTParameter rgOptions[16];
+        size_t cOptions = 2;
+        rgOptions[0] = DispatchTypes::GraphicsOptions::BoldBright;
+        rgOptions[1] = DispatchTypes::GraphicsOptions::ForegroundRed;
+
+        Log::Comment(L"Test 1: Apply a sequence to the default attributes");
+        _testGetSet->_attribute = {};
+        _testGetSet->_expectedAttribute = {};
+        _testGetSet->_expectedAttribute.SetBold(true);
+        _testGetSet->_expectedAttribute.SetIndexedForeground(FOREGROUND_RED);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        Log::Comment(L"Test 2: Apply the same sequence to the same attributes again");
+        _testGetSet->_attribute = {};
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        Log::Comment(L"Test 3: Apply the same sequence to different attributes");
+        _testGetSet->_attribute = {};
+        _testGetSet->_attribute.SetItalic(true);
+        _testGetSet->_expectedAttribute.SetItalic(true);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        Log::Comment(L"Test 4: An explicit 0 and an omitted index are cached separately, but give the same color");
+        cOptions = 3;
+        rgOptions[0] = DispatchTypes::GraphicsOptions::ForegroundExtended;
+        rgOptions[1] = DispatchTypes::GraphicsOptions::BlinkOrXterm256Index;
+        rgOptions[2] = 0;
+        _testGetSet->_attribute = {};
+        _testGetSet->_expectedAttribute = {};
+        _testGetSet->_expectedAttribute.SetIndexedForeground256(0);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        rgOptions[2] = {};
+        _testGetSet->_attribute = {};
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+    }
+
     TEST_METHOD(GraphicsPersistBrightnessTests)
     {
         Log::Comment(L"Starting test...");
@@ -2249,6 +2314,24 @@ public:
         VERIFY_IS_TRUE(_pDispatch.get()->EnableAlternateScroll(false));
     }
 
+    TEST_METHOD(SynchronizedOutputTest)
+    {
+        Log::Comment(L"Starting test...");
+
+        Log::Comment(L"Test 1: DECSET 2026 starts a synchronized update");
+        _testGetSet->_expectedSynchronizedOutputEnabled = true;
+        _testGetSet->_privateEnableSynchronizedOutputResult = TRUE;
+        VERIFY_IS_TRUE(_pDispatch.get()->SetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+
+        Log::Comment(L"Test 2: DECRST 2026 ends it");
+        _testGetSet->_expectedSynchronizedOutputEnabled = false;
+        VERIFY_IS_TRUE(_pDispatch.get()->ResetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+
+        Log::Comment(L"Test 3: Failure is reported back to the caller");
+        _testGetSet->_privateEnableSynchronizedOutputResult = FALSE;
+        VERIFY_IS_FALSE(_pDispatch.get()->SetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+    }
+
     TEST_METHOD(Xterm256ColorTest)
     {
         Log::Comment(L"Starting test...");
@@ -2591,6 +2674,58 @@ public:
         VERIFY_IS_TRUE(decdld(CellMatrix::Default, 0, FontSet::Size132x24, FontUsage::FullCell, bitmapOf6x18));
     }
 
+    TEST_METHOD(SixelImageStreaming)
+    {
+        _testGetSet->PrepData();
+        _testGetSet->_privateLineFeedResult = TRUE;
+        _testGetSet->_expectedLineFeedWithReturn = false;
+        _testGetSet->_imageSlices.clear();
+
+        const auto stringHandler = _pDispatch.get()->DefineSixelImage(0, 0);
+        VERIFY_IS_TRUE(stringHandler != nullptr);
+        const auto send = [&](const std::wstring_view data) {
+            for (auto ch : data)
+            {
+                stringHandler(ch);
+            }
+        };
+
+        Log::Comment(L"A 20x30 image at a 1:1 aspect ratio, in red on a filled background.");
+        send(L"\"1;1;20;30#1;2;100;0;0");
+        Log::Comment(L"Four bands of six reach past the first row, so it's handed out right away.");
+        send(L"!20~-!20~-!20~-!20~-");
+        VERIFY_ARE_EQUAL(1u, _testGetSet->_imageSlices.size());
+        Log::Comment(L"The rest of the image is handed out at the end of the string.");
+        send(L"!20~-");
+        stringHandler(L'\033');
+        VERIFY_ARE_EQUAL(2u, _testGetSet->_imageSlices.size());
+
+        const auto columnBegin = gsl::narrow_cast<size_t>(_testGetSet->_cursorPos.X);
+        const auto red = 0xFFFF0000u;
+        const auto black = 0xFF000000u;
+        for (const auto& slice : _testGetSet->_imageSlices)
+        {
+            VERIFY_IS_TRUE(slice != nullptr);
+            VERIFY_ARE_EQUAL(columnBegin, slice->ColumnBegin());
+            VERIFY_ARE_EQUAL(columnBegin + 2, slice->ColumnEnd());
+            VERIFY_ARE_EQUAL(til::size(20, 20), slice->PixelSize());
+        }
+
+        const auto firstRow = _testGetSet->_imageSlices.at(0)->Pixels();
+        VERIFY_ARE_EQUAL(red, firstRow[0]);
+        VERIFY_ARE_EQUAL(red, firstRow[19 * 20 + 19]);
+
+        Log::Comment(L"Below the last band, the second row is background.");
+        const auto secondRow = _testGetSet->_imageSlices.at(1)->Pixels();
+        VERIFY_ARE_EQUAL(red, secondRow[9 * 20]);
+        VERIFY_ARE_EQUAL(black, secondRow[10 * 20]);
+
+        Log::Comment(L"In a conpty, sixel images are ignored.");
+        _testGetSet->_isPty = true;
+        VERIFY_IS_TRUE(_pDispatch.get()->DefineSixelImage(0, 0) == nullptr);
+        _testGetSet->_isPty = false;
+    }
+
 private:
     TestGetSet* _testGetSet; // non-ownership pointer
     std::unique_ptr<AdaptDispatch> _pDispatch;
@@ -46,6 +46,8 @@ public:
     TEST_METHOD(TerminalInputNullKeyTests);
     TEST_METHOD(DifferentModifiersTest);
     TEST_METHOD(CtrlNumTest);
+    TEST_METHOD(Win32InputModeOmitsDefaultParameters);
+    TEST_METHOD(TerminalInputTextOutput);
 
     wchar_t GetModifierChar(const bool fShift, const bool fAlt, const bool fCtrl)
     {
@@ -739,3 +741,63 @@ void InputTest::CtrlNumTest()
     s_expectedInput = L"9";
     TestKey(pInput, uiKeystate, vkey);
 }
+
+void InputTest::Win32InputModeOmitsDefaultParameters()
+{
+    Log::Comment(L"Starting test...");
+
+    TerminalInput* const pInput = new TerminalInput(s_TerminalInputTestCallback);
+    pInput->ChangeWin32InputMode(true);
+
+    Log::Comment(L"A plain key down only needs the parameters that differ from their defaults.");
+    s_expectedInput = L"\x1b[65;;97;1_";
+    TestKey(pInput, 0, 'A', L'a');
+
+    Log::Comment(L"Parameters in between that match their default are left empty.");
+    s_expectedInput = L"\x1b[65;;65;1;16_";
+    TestKey(pInput, SHIFT_PRESSED, 'A', L'A');
+
+    Log::Comment(L"A key up with no modifiers drops everything after the character.");
+    INPUT_RECORD irTest = { 0 };
+    irTest.EventType = KEY_EVENT;
+    irTest.Event.KeyEvent.wRepeatCount = 1;
+    irTest.Event.KeyEvent.wVirtualKeyCode = 'A';
+    irTest.Event.KeyEvent.wVirtualScanCode = 30;
+    irTest.Event.KeyEvent.uChar.UnicodeChar = L'a';
+    s_expectedInput = L"\x1b[65;30;97_";
+    auto inputEvent = IInputEvent::Create(irTest);
+    VERIFY_ARE_EQUAL(true, pInput->HandleKey(inputEvent.get()));
+}
+
+void InputTest::TerminalInputTextOutput()
+{
+    Log::Comment(L"Starting test...");
+
+    std::wstring written;
+    TerminalInput input{ [&](const std::wstring_view text) { written += text; } };
+
+    Log::Comment(L"Characters are written as they are.");
+    TestKey(&input, 0, 'A', L'a');
+    VERIFY_ARE_EQUAL(std::wstring{ L"a" }, written);
+
+    Log::Comment(L"Alt+key is escaped.");
+    written.clear();
+    TestKey(&input, LEFT_ALT_PRESSED, 'A', L'a');
+    VERIFY_ARE_EQUAL(std::wstring{ L"\x1b" L"a" }, written);
+
+    Log::Comment(L"Keys with a mapping are written as their whole sequence at once.");
+    written.clear();
+    TestKey(&input, 0, VK_UP);
+    VERIFY_ARE_EQUAL(std::wstring{ L"\x1b[A" }, written);
+
+    Log::Comment(L"Ctrl+Space is the null character.");
+    written.clear();
+    TestKey(&input, LEFT_CTRL_PRESSED, VK_SPACE, L' ');
+    VERIFY_ARE_EQUAL(std::wstring(1, L'\0'), written);
+
+    Log::Comment(L"win32-input-mode sequences are written as text as well.");
+    written.clear();
+    input.ChangeWin32InputMode(true);
+    TestKey(&input, 0, 'A', L'a');
+    VERIFY_ARE_EQUAL(std::wstring{ L"\x1b[65;;97;1_" }, written);
+}
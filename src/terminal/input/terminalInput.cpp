@@ -25,6 +25,12 @@ TerminalInput::TerminalInput(_In_ std::function<void(std::deque<std::unique_ptr<
     _pfnWriteEvents = pfn;
 }
 
+TerminalInput::TerminalInput(_In_ std::function<void(std::wstring_view)> pfn) :
+    _pfnWriteText{ std::move(pfn) },
+    _leadingSurrogate{}
+{
+}
+
 struct TermKeyMap
 {
     const WORD vkey;
@@ -532,8 +538,9 @@ bool TerminalInput::HandleKey(const IInputEvent* const pInEvent)
     // Only do this if win32-input-mode support isn't manually disabled.
     if (_win32InputMode && !_forceDisableWin32InputMode)
     {
-        const auto seq = _GenerateWin32KeySequence(keyEvent);
-        _SendInputSequence(seq);
+        SequenceBuffer seq;
+        _GenerateWin32KeySequence(keyEvent, seq);
+        _SendInputSequence({ seq.data(), seq.size() });
         return true;
     }
 
@@ -684,8 +691,9 @@ void TerminalInput::_SendChar(const wchar_t ch)
         {
             // we already were storing a leading surrogate but we got another one. Go ahead and send the
             // saved surrogate piece and save the new one
-            const auto formatted = wil::str_printf<std::wstring>(L"%I32u", _leadingSurrogate.value());
-            _SendInputSequence(formatted);
+            SequenceBuffer formatted;
+            fmt::format_to(std::back_inserter(formatted), FMT_COMPILE(L"{}"), static_cast<uint32_t>(_leadingSurrogate.value()));
+            _SendInputSequence({ formatted.data(), formatted.size() });
         }
         // save the leading portion of a surrogate pair so that they can be sent at the same time
         _leadingSurrogate.emplace(ch);
@@ -713,6 +721,13 @@ void TerminalInput::_SendEscapedInputSequence(const wchar_t wch) const
 {
     try
     {
+        if (_pfnWriteText)
+        {
+            const std::array<wchar_t, 2> sequence{ L'\x1b', wch };
+            _pfnWriteText({ sequence.data(), sequence.size() });
+            return;
+        }
+
         std::deque<std::unique_ptr<IInputEvent>> inputEvents;
         inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, L'\x1b', 0));
         inputEvents.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, wch, 0));
@@ -728,6 +743,13 @@ void TerminalInput::_SendNullInputSequence(const DWORD controlKeyState) const
 {
     try
     {
+        // As text, all that's left of the key event is its null character.
+        if (_pfnWriteText)
+        {
+            _pfnWriteText(std::wstring_view{ L"\0", 1 });
+            return;
+        }
+
         std::deque<std::unique_ptr<IInputEvent>> inputEvents;
         inputEvents.push_back(std::make_unique<KeyEvent>(true,
                                                          1ui16,
@@ -749,6 +771,12 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
     {
         try
         {
+            if (_pfnWriteText)
+            {
+                _pfnWriteText(sequence);
+                return;
+            }
+
             std::deque<std::unique_ptr<IInputEvent>> inputEvents;
             for (const auto& wch : sequence)
             {
@@ -767,9 +795,10 @@ void TerminalInput::_SendInputSequence(const std::wstring_view sequence) const n
 // - Synthesize a win32-input-mode sequence for the given keyevent.
 // Arguments:
 // - key: the KeyEvent to serialize.
+// - seq: receives the formatted string representation of this key
 // Return Value:
-// - the formatted string representation of this key
-std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
+// - <none>
+void TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key, SequenceBuffer& seq)
 {
     // Sequences are formatted as follows:
     //
@@ -782,11 +811,39 @@ std::wstring TerminalInput::_GenerateWin32KeySequence(const KeyEvent& key)
     //      Kd: the value of bKeyDown - either a '0' or '1'. If omitted, defaults to '0'.
     //      Cs: the value of dwControlKeyState - any number. If omitted, defaults to '0'.
     //      Rc: the value of wRepeatCount - any number. If omitted, defaults to '1'.
-    return fmt::format(FMT_COMPILE(L"\x1b[{};{};{};{};{};{}_"),
-                       key.GetVirtualKeyCode(),
-                       key.GetVirtualScanCode(),
-                       static_cast<int>(key.GetCharData()),
-                       key.IsKeyDown() ? 1 : 0,
-                       key.GetActiveModifierKeys(),
-                       key.GetRepeatCount());
+    //
+    // Since every parameter has a default, we leave out the ones that match
+    // it, and drop the trailing empty ones entirely. A plain key up is then
+    // "^[[65;30;97_" instead of "^[[65;30;97;0;0;1_", which adds up quickly
+    // when a lot of input is sent through conpty at once.
+    const std::array<DWORD, 6> values{
+        key.GetVirtualKeyCode(),
+        key.GetVirtualScanCode(),
+        static_cast<DWORD>(key.GetCharData()),
+        key.IsKeyDown() ? 1ul : 0ul,
+        key.GetActiveModifierKeys(),
+        key.GetRepeatCount(),
+    };
+    static constexpr std::array<DWORD, 6> defaults{ 0, 0, 0, 0, 0, 1 };
+
+    auto count = values.size();
+    while (count > 0 && til::at(values, count - 1) == til::at(defaults, count - 1))
+    {
+        --count;
+    }
+
+    seq.push_back(L'\x1b');
+    seq.push_back(L'[');
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+        {
+            seq.push_back(L';');
+        }
+        if (til::at(values, i) != til::at(defaults, i))
+        {
+            fmt::format_to(std::back_inserter(seq), FMT_COMPILE(L"{}"), til::at(values, i));
+        }
+    }
+    seq.push_back(L'_');
 }
@@ -583,16 +583,17 @@ bool OutputStateMachineEngine::ActionCsiDispatch(const VTID id, const VTParamete
         TermTelemetry::Instance().Log(TermTelemetry::Codes::DTTERM_WM);
         break;
     case CsiActionCodes::REP_RepeatCharacter:
-        // Handled w/o the dispatch. This function is unique in that way
-        // If this were in the ITerminalDispatch, then each
-        // implementation would effectively be the same, calling only
-        // functions that are already part of the interface.
-        // Print the last graphical character a number of times.
+        // Print the last graphical character a number of times. Dispatchers
+        // that can fill a run of cells in one go do that in RepeatCharacter.
+        // For everyone else this is the same as printing the characters.
         if (_lastPrintedChar != AsciiChars::NUL)
         {
             const size_t repeatCount = parameters.at(0);
-            std::wstring wstr(repeatCount, _lastPrintedChar);
-            _dispatch->PrintString(wstr);
+            if (!_dispatch->RepeatCharacter(_lastPrintedChar, repeatCount))
+            {
+                std::wstring wstr(repeatCount, _lastPrintedChar);
+                _dispatch->PrintString(wstr);
+            }
         }
         success = true;
         TermTelemetry::Instance().Log(TermTelemetry::Codes::REP);
@@ -661,6 +662,9 @@ IStateMachineEngine::StringHandler OutputStateMachineEngine::ActionDcsDispatch(c
                                           parameters.at(6),
                                           parameters.at(7));
         break;
+    case DcsActionCodes::DECSIXEL_DefineSixelImage:
+        handler = _dispatch->DefineSixelImage(parameters.at(0), parameters.at(1));
+        break;
     default:
         handler = nullptr;
         break;
@@ -733,7 +737,10 @@ bool OutputStateMachineEngine::ActionOscDispatch(const wchar_t /*wch*/,
         {
             const auto tableIndex = til::at(tableIndexes, i);
             const auto rgb = til::at(colors, i);
-            success = success && _dispatch->SetColorTableEntry(tableIndex, rgb);
+            // Every entry is applied, even after one that wasn't handled. In
+            // conpty, the dispatch doesn't handle any of them so that the
+            // whole sequence is passed through, but it still records them.
+            success = _dispatch->SetColorTableEntry(tableIndex, rgb) && success;
         }
         TermTelemetry::Instance().Log(TermTelemetry::Codes::OSCCT);
         break;
@@ -6,8 +6,23 @@
 
 using namespace Microsoft::Console::VirtualTerminal;
 
-static const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-static const char padChar = '=';
+static constexpr char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static constexpr char padChar = '=';
+
+// Maps each ASCII character to its value in base64, or to invalidValue if it isn't one of base64Chars.
+static constexpr uint8_t invalidValue = 0xff;
+static constexpr auto base64Values = []() {
+    std::array<uint8_t, 128> values{};
+    for (auto& value : values)
+    {
+        value = invalidValue;
+    }
+    for (uint8_t i = 0; i < 64; ++i)
+    {
+        values[base64Chars[i]] = i;
+    }
+    return values;
+}();
 
 #pragma warning(disable : 26446 26447 26482 26485 26493 26494)
 
@@ -100,8 +115,26 @@ bool Base64::s_Decode(const std::wstring_view src, std::wstring& dst) noexcept
             break;
         }
 
-        auto pos = strchr(base64Chars, *iter);
-        if (!pos) // A non-base64 character found.
+        // Long payloads are mostly unbroken runs of whole quanta. Decode them four characters at a time.
+        if (state == 0 && src.cend() - iter >= 4)
+        {
+            const auto a = iter[0] < base64Values.size() ? base64Values[iter[0]] : invalidValue;
+            const auto b = iter[1] < base64Values.size() ? base64Values[iter[1]] : invalidValue;
+            const auto c = iter[2] < base64Values.size() ? base64Values[iter[2]] : invalidValue;
+            const auto d = iter[3] < base64Values.size() ? base64Values[iter[3]] : invalidValue;
+            // Whitespace and padding aren't base64 values either, so they take the slow path below.
+            if (a != invalidValue && b != invalidValue && c != invalidValue && d != invalidValue)
+            {
+                mbStr += (char)(a << 2 | b >> 4);
+                mbStr += (char)(b << 4 | c >> 2);
+                mbStr += (char)(c << 6 | d);
+                iter += 4;
+                continue;
+            }
+        }
+
+        const auto value = *iter < base64Values.size() ? base64Values[*iter] : invalidValue;
+        if (value == invalidValue) // A non-base64 character found.
         {
             return false;
         }
@@ -109,23 +142,23 @@ bool Base64::s_Decode(const std::wstring_view src, std::wstring& dst) noexcept
         switch (state)
         {
         case 0:
-            tmp = (char)(pos - base64Chars) << 2;
+            tmp = (char)value << 2;
             state = 1;
             break;
         case 1:
-            tmp |= (char)(pos - base64Chars) >> 4;
+            tmp |= (char)value >> 4;
             mbStr += tmp;
-            tmp = (char)((pos - base64Chars) & 0x0f) << 4;
+            tmp = (char)(value & 0x0f) << 4;
             state = 2;
             break;
         case 2:
-            tmp |= (char)(pos - base64Chars) >> 2;
+            tmp |= (char)value >> 2;
             mbStr += tmp;
-            tmp = (char)((pos - base64Chars) & 0x03) << 6;
+            tmp = (char)(value & 0x03) << 6;
             state = 3;
             break;
         case 3:
-            tmp |= pos - base64Chars;
+            tmp |= value;
             mbStr += tmp;
             state = 0;
             break;
@@ -7,6 +7,10 @@
 
 #include "ascii.hpp"
 
+#if defined(_M_AMD64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
 using namespace Microsoft::Console::VirtualTerminal;
 
 //Takes ownership of the pEngine.
@@ -18,9 +22,12 @@ StateMachine::StateMachine(std::unique_ptr<IStateMachineEngine> engine) :
     _parameters{},
     _parameterLimitReached(false),
     _oscString{},
-    _cachedSequence{ std::nullopt },
+    _oscStringLimitReached(false),
+    _cachedSequence{},
     _processingIndividually(false)
 {
+    _oscString.reserve(INITIAL_STRING_CAPACITY);
+    _cachedSequence.reserve(INITIAL_STRING_CAPACITY);
     _ActionClear();
 }
 
@@ -374,6 +381,54 @@ static constexpr bool _isActionableFromGround(const wchar_t wch) noexcept
 
 #pragma warning(pop)
 
+// Routine Description:
+// - Finds the next character at or after offset that is actionable from the ground state.
+//   Plain text is the bulk of what we get to see, so on x86/x64 we check 8 characters at a time.
+// Arguments:
+// - string - Characters to scan.
+// - offset - Index to begin scanning at.
+// Return Value:
+// - The index of the first actionable character, or string.size() if there isn't any.
+static size_t _findActionableFromGround(const std::wstring_view string, size_t offset) noexcept
+{
+    const auto size = string.size();
+
+#if defined(_M_AMD64) || defined(_M_IX86)
+    // A character is actionable if it's <= US or within DEL..0x9F (DEL is directly followed by the C1 range).
+    // SSE2 has no unsigned 16-bit comparisons, but a saturated a - b is only 0 if a <= b.
+    const auto maxC0 = _mm_set1_epi16(static_cast<short>(AsciiChars::US));
+    const auto minDelOrC1 = _mm_set1_epi16(static_cast<short>(AsciiChars::DEL));
+    const auto delOrC1Range = _mm_set1_epi16(static_cast<short>(L'\x9F' - AsciiChars::DEL));
+    const auto zero = _mm_setzero_si128();
+
+    for (; offset + 8 <= size; offset += 8)
+    {
+#pragma warning(suppress : 26481) // Don't use pointer arithmetic. Use span instead.
+#pragma warning(suppress : 26490) // Don't use reinterpret_cast.
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string.data() + offset));
+        const auto isC0 = _mm_cmpeq_epi16(_mm_subs_epu16(chars, maxC0), zero);
+        const auto isDelOrC1 = _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(chars, minDelOrC1), delOrC1Range), zero);
+        const auto mask = static_cast<unsigned long>(_mm_movemask_epi8(_mm_or_si128(isC0, isDelOrC1)));
+        if (mask != 0)
+        {
+            unsigned long index = 0;
+            _BitScanForward(&index, mask);
+            // Every character is 2 bytes and thus 2 bits in the mask.
+            return offset + index / 2;
+        }
+    }
+#endif
+
+    for (; offset < size; ++offset)
+    {
+        if (_isActionableFromGround(til::at(string, offset)))
+        {
+            return offset;
+        }
+    }
+    return size;
+}
+
 // Routine Description:
 // - Triggers the Execute action to indicate that the listener should immediately respond to a C0 control character.
 // Arguments:
@@ -573,8 +628,14 @@ void StateMachine::_ActionClear()
     _parameters.clear();
     _parameterLimitReached = false;
 
+    if (_oscString.capacity() > MAX_RETAINED_STRING_CAPACITY)
+    {
+        _oscString = {};
+        _oscString.reserve(INITIAL_STRING_CAPACITY);
+    }
     _oscString.clear();
     _oscParameter = 0;
+    _oscStringLimitReached = false;
 
     _dcsStringHandler = nullptr;
 
@@ -634,7 +695,33 @@ void StateMachine::_ActionOscPut(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscPut");
 
-    _oscString.push_back(wch);
+    if (_oscString.size() < MAX_OSC_STRING_LENGTH)
+    {
+        _oscString.push_back(wch);
+    }
+    else
+    {
+        _oscStringLimitReached = true;
+    }
+}
+
+// Routine Description:
+// - Stores a run of characters as part of the OSC string. This is what
+//   _ActionOscPut does for each of them, only in one go.
+// Arguments:
+// - string - Characters that don't terminate, interrupt or get ignored by the OSC string.
+// Return Value:
+// - <none>
+void StateMachine::_ActionOscPutString(const std::wstring_view string)
+{
+    _trace.TraceOnAction(L"OscPutString");
+
+    const auto room = MAX_OSC_STRING_LENGTH - std::min(_oscString.size(), MAX_OSC_STRING_LENGTH);
+    _oscString.append(string.substr(0, room));
+    if (string.size() > room)
+    {
+        _oscStringLimitReached = true;
+    }
 }
 
 // Routine Description:
@@ -648,7 +735,9 @@ void StateMachine::_ActionOscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscDispatch");
 
-    const bool success = _engine->ActionOscDispatch(wch, _oscParameter, _oscString);
+    // A truncated string would be wrong for every OSC (a partial title,
+    // a clipboard with the end cut off), so it's dropped entirely.
+    const bool success = !_oscStringLimitReached && _engine->ActionOscDispatch(wch, _oscParameter, _oscString);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -728,7 +817,7 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
 void StateMachine::_EnterGround() noexcept
 {
     _state = VTStates::Ground;
-    _cachedSequence.reset(); // entering ground means we've completed the pending sequence
+    _cachedSequence.clear(); // entering ground means we've completed the pending sequence
     _trace.TraceStateChange(L"Ground");
 }
 
@@ -1803,13 +1892,13 @@ bool StateMachine::FlushToTerminal()
 {
     bool success{ true };
 
-    if (success && _cachedSequence.has_value())
+    if (success && !_cachedSequence.empty())
     {
         // Flush the partial sequence to the terminal before we flush the rest of it.
         // We always want to clear the sequence, even if we failed, so we don't accumulate bad state
         // and dump it out elsewhere later.
-        success = _engine->ActionPassThroughString(*_cachedSequence);
-        _cachedSequence.reset();
+        success = _engine->ActionPassThroughString(_cachedSequence);
+        _cachedSequence.clear();
     }
 
     if (success)
@@ -1835,6 +1924,10 @@ bool StateMachine::FlushToTerminal()
 // - <none>
 void StateMachine::ProcessString(const std::wstring_view string)
 {
+    // Checking whether anyone is tracing once per string, instead of for
+    // every character and action, keeps the tracing out of the hot loop.
+    _trace.UpdateEnabled();
+
     size_t start = 0;
     size_t current = start;
 
@@ -1850,7 +1943,29 @@ void StateMachine::ProcessString(const std::wstring_view string)
         _runOffset = start;
         _runSize = current - start + 1;
 
-        if (_processingIndividually)
+        if (_processingIndividually && _state == VTStates::OscString)
+        {
+            // OSC strings can be long (OSC 52 carries whole clipboards), and most of their
+            // characters are simply collected. Everything up to the next control character
+            // that _EventOscString or ProcessCharacter might act upon is collected in one go.
+            // Those are a subset of what's actionable from ground, so that search works here too.
+            const auto end = _findActionableFromGround(string, current);
+            if (end > current)
+            {
+                _ActionOscPutString(string.substr(current, end - current));
+                current = end;
+                continue;
+            }
+
+            ProcessCharacter(til::at(string, current));
+            ++current;
+            if (_state == VTStates::Ground)
+            {
+                _processingIndividually = false;
+                start = current;
+            }
+        }
+        else if (_processingIndividually)
         {
             // If we're processing characters individually, send it to the state machine.
             ProcessCharacter(til::at(string, current));
@@ -1863,14 +1978,15 @@ void StateMachine::ProcessString(const std::wstring_view string)
         }
         else
         {
-            if (_isActionableFromGround(til::at(string, current))) // If the current char is the start of an escape sequence, or should be executed in ground state...
+            // Skip over all the chars that can be added to the current run to be printed,
+            // up to the next one that's the start of an escape sequence, or should be executed in ground state...
+            current = _findActionableFromGround(string, current);
+            if (current < string.size())
             {
+                // Unlike the run above, we only pass through everything before the actionable char.
+                _runSize = current - start;
                 if (_runSize > 0)
                 {
-                    // Because the run above is composed INCLUDING current, we must
-                    // trim it off here since we just determined it's actionable
-                    // and only pass through everything before it.
-                    _runSize -= 1;
                     const auto allLeadingUpTo = _CurrentRun();
 
                     _engine->ActionPrintString(allLeadingUpTo); // ... print all the chars leading up to it as part of the run...
@@ -1879,12 +1995,8 @@ void StateMachine::ProcessString(const std::wstring_view string)
 
                 _processingIndividually = true; // begin processing future characters individually...
                 start = current;
-                continue;
-            }
-            else
-            {
-                ++current; // Otherwise, add this char to the current run to be printed.
             }
+            // Otherwise the rest of the string is printable and will be printed as the final run below.
         }
     }
 
@@ -1976,13 +2088,7 @@ void StateMachine::ProcessString(const std::wstring_view string)
             // If the engine doesn't require flushing at the end of the string, we
             // want to cache the partial sequence in case we have to flush the whole
             // thing to the terminal later.
-            if (!_cachedSequence)
-            {
-                _cachedSequence.emplace(std::wstring{});
-            }
-
-            auto& cachedSequence = *_cachedSequence;
-            cachedSequence.append(run);
+            _cachedSequence.append(run);
         }
     }
 }
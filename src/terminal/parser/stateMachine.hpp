@@ -32,6 +32,79 @@ namespace Microsoft::Console::VirtualTerminal
     // that number.
     constexpr size_t MAX_PARAMETER_COUNT = 32;
 
+    // OSC strings (titles, hyperlinks, colors) and partial sequences are kept
+    // in strings that are reused from one sequence to the next, so they're
+    // only allocated once. This is how much room they start out with, which
+    // is plenty for almost all of them.
+    constexpr size_t INITIAL_STRING_CAPACITY = 256;
+
+    // OSC strings that grow past this many characters (32MB) are dropped when
+    // they're terminated, instead of growing forever while a client doesn't
+    // terminate them. OSC 52 clipboard contents are the only ones anywhere near it.
+    constexpr size_t MAX_OSC_STRING_LENGTH = 16 * 1024 * 1024;
+
+    // A buffer that grew past this for a large OSC string is given back after
+    // that sequence, rather than being kept for the titles that follow.
+    constexpr size_t MAX_RETAINED_STRING_CAPACITY = 64 * 1024;
+
+    // The parameters of the sequence that's currently being parsed. There can
+    // never be more than MAX_PARAMETER_COUNT of them, so they're kept inline
+    // in the state machine instead of in a heap allocated vector. That keeps
+    // them in the same cache lines as the rest of the parser state, and
+    // resetting them between sequences is a single store.
+    class VTParameterBuffer final
+    {
+    public:
+        bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        size_t size() const noexcept
+        {
+            return _size;
+        }
+
+        const VTParameter* data() const noexcept
+        {
+            return _values.data();
+        }
+
+        const VTParameter& at(const size_t index) const
+        {
+            if (index >= _size)
+            {
+                throw std::out_of_range("VTParameterBuffer index out of range");
+            }
+            return til::at(_values, index);
+        }
+
+        VTParameter& back() noexcept
+        {
+            return til::at(_values, _size - 1);
+        }
+
+        // Callers make sure not to add more than MAX_PARAMETER_COUNT
+        // parameters (see StateMachine::_parameterLimitReached). Anything
+        // beyond that is dropped.
+        void push_back(const VTParameter value) noexcept
+        {
+            if (_size < _values.size())
+            {
+                til::at(_values, _size++) = value;
+            }
+        }
+
+        void clear() noexcept
+        {
+            _size = 0;
+        }
+
+    private:
+        std::array<VTParameter, MAX_PARAMETER_COUNT> _values{};
+        size_t _size = 0;
+    };
+
     class StateMachine final
     {
 #ifdef UNIT_TESTING
@@ -65,6 +138,7 @@ namespace Microsoft::Console::VirtualTerminal
         void _ActionCsiDispatch(const wchar_t wch);
         void _ActionOscParam(const wchar_t wch) noexcept;
         void _ActionOscPut(const wchar_t wch);
+        void _ActionOscPutString(const std::wstring_view string);
         void _ActionOscDispatch(const wchar_t wch);
         void _ActionSs3Dispatch(const wchar_t wch);
         void _ActionDcsDispatch(const wchar_t wch);
@@ -160,15 +234,19 @@ namespace Microsoft::Console::VirtualTerminal
         }
 
         VTIDBuilder _identifier;
-        std::vector<VTParameter> _parameters;
+        VTParameterBuffer _parameters;
         bool _parameterLimitReached;
 
         std::wstring _oscString;
         size_t _oscParameter;
+        bool _oscStringLimitReached;
 
         IStateMachineEngine::StringHandler _dcsStringHandler;
 
-        std::optional<std::wstring> _cachedSequence;
+        // The partial sequence that may have to be flushed to the terminal.
+        // It's empty when there's none. It's cleared rather than reset when
+        // the sequence completes, so that its storage is reused.
+        std::wstring _cachedSequence;
 
         // This is tracked per state machine instance so that separate calls to Process*
         //   can start and finish a sequence.
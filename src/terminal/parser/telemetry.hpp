@@ -109,8 +109,38 @@ namespace Microsoft::Console::VirtualTerminal
             // Only use this last enum as a count of the number of codes.
             NUMBER_OF_CODES
         };
-        void Log(const Codes code) noexcept;
-        void LogFailed(const wchar_t wch) noexcept;
+        // Log and LogFailed are called for every sequence the parser sees, so
+        // they're inline: counting a sequence is two increments, and the
+        // counts are only sent out when the console exits.
+
+        // Logs the usage of a particular VT100 code.
+        void Log(const Codes code) noexcept
+        {
+            // Initially we wanted to pass over a string (ex. "CUU") and use a dictionary data type to hold the counts.
+            // However we would have to search through the dictionary every time we called this method, so we decided
+            // to use an array which has very quick access times.
+            // The downside is we have to create an enum type, and then convert them to strings when we finally
+            // send out the telemetry, but the upside is we should have very good performance.
+            _uiTimesUsed[code]++;
+            _uiTimesUsedCurrent++;
+        }
+
+        // Logs a particular VT100 escape code failed or was unsupported.
+        void LogFailed(const wchar_t wch) noexcept
+        {
+            if (wch > CHAR_MAX)
+            {
+                _uiTimesFailedOutsideRange++;
+                _uiTimesFailedOutsideRangeCurrent++;
+            }
+            else
+            {
+                // Even though we pass over a wide character, we only care about the ASCII single byte character.
+                _uiTimesFailed[wch]++;
+                _uiTimesFailedCurrent++;
+            }
+        }
+
         void SetShouldWriteFinalLog(const bool writeLog) noexcept;
         void SetActivityId(const GUID* activityId) noexcept;
         unsigned int GetAndResetTimesUsedCurrent() noexcept;
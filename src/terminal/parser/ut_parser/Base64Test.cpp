@@ -79,6 +79,9 @@ class Microsoft::Console::VirtualTerminal::Base64Test
         success = Base64::s_Decode(L"Z", result);
         VERIFY_ARE_EQUAL(false, success);
 
+        success = Base64::s_Decode(L"Zm9v\x00e9mFy", result);
+        VERIFY_ARE_EQUAL(false, success);
+
         success = Base64::s_Decode(L"Zm9vYg", result);
         VERIFY_ARE_EQUAL(false, success);
 
@@ -3287,6 +3287,25 @@ class StateMachineExternalTest final
         VERIFY_ARE_EQUAL(L"UNCHANGED", pDispatch->_copyContent);
 
         pDispatch->ClearState();
+
+        // A large payload, wrapped into lines and split across writes, works.
+        std::wstring encoded;
+        std::wstring expected;
+        for (auto i = 0; i < 10000; ++i)
+        {
+            encoded += L"Zm9vYmFy";
+            expected += L"foobar";
+            if (i % 100 == 99)
+            {
+                encoded += L"\r\n";
+            }
+        }
+        const auto sequence = L"\x1b]52;;" + encoded + L"\x1b\\";
+        mach.ProcessString(std::wstring_view{ sequence }.substr(0, sequence.size() / 2 + 1));
+        mach.ProcessString(std::wstring_view{ sequence }.substr(sequence.size() / 2 + 1));
+        VERIFY_ARE_EQUAL(expected, pDispatch->_copyContent);
+
+        pDispatch->ClearState();
     }
 
     TEST_METHOD(TestAddHyperlink)
@@ -159,6 +159,7 @@ class Microsoft::Console::VirtualTerminal::StateMachineTest
     TEST_METHOD(PassThroughUnhandled);
     TEST_METHOD(RunStorageBeforeEscape);
     TEST_METHOD(BulkTextPrint);
+    TEST_METHOD(BulkTextPrintStopsAtControlChars);
     TEST_METHOD(PassThroughUnhandledSplitAcrossWrites);
 
     TEST_METHOD(DcsDataStringsReceivedByHandler);
@@ -234,6 +235,34 @@ void StateMachineTest::BulkTextPrint()
     VERIFY_ARE_EQUAL(String(L"12345 Hello World"), String(engine.printed.c_str()));
 }
 
+void StateMachineTest::BulkTextPrintStopsAtControlChars()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    // The characters right at the edges of the C0, DEL and C1 ranges are printable.
+    // It's longer than a couple of vectors worth of characters, so that the
+    // control char is found no matter where it ends up relative to them.
+    const std::wstring text{ L"\x20\x7e\xa0" L"abcdefghijklmnopqrstuvwxyz" };
+
+    for (const auto control : { L'\x1f', L'\x7f' })
+    {
+        for (size_t offset = 0; offset <= text.size(); ++offset)
+        {
+            auto input{ text };
+            input.insert(offset, 1, control);
+
+            engine.ResetTestState();
+            machine.ProcessString(input);
+
+            VERIFY_ARE_EQUAL(String(text.c_str()), String(engine.printed.c_str()));
+            VERIFY_ARE_EQUAL(String(std::wstring(1, control).c_str()), String(engine.executed.c_str()));
+        }
+    }
+}
+
 void StateMachineTest::PassThroughUnhandledSplitAcrossWrites()
 {
     auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
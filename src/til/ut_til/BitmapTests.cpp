@@ -966,6 +966,59 @@ class BitmapTests
         VERIFY_ARE_EQUAL(expected, actual);
     }
 
+    TEST_METHOD(RunsAcrossWords)
+    {
+        Log::Comment(L"Set up a bitmap whose rows don't line up with the 64 bit words it's stored in.");
+        til::bitmap map{ til::size{ 100, 3 }, false };
+
+        // Straddles the first word boundary.
+        map.set(til::rectangle{ til::point{ 60, 0 }, til::size{ 10, 1 } });
+        // Full rows are set as one range, across several words.
+        map.set(til::rectangle{ til::point{ 0, 1 }, til::size{ 100, 2 } });
+
+        til::some<til::rectangle, 3> expected;
+        expected.push_back(til::rectangle{ til::point{ 60, 0 }, til::size{ 10, 1 } });
+        expected.push_back(til::rectangle{ til::point{ 0, 1 }, til::size{ 100, 1 } });
+        expected.push_back(til::rectangle{ til::point{ 0, 2 }, til::size{ 100, 1 } });
+
+        til::some<til::rectangle, 3> actual;
+        for (auto run : map.runs())
+        {
+            actual.push_back(run);
+        }
+        VERIFY_ARE_EQUAL(expected, actual);
+        VERIFY_IS_FALSE(map.all());
+
+        Log::Comment(L"Scroll down by a row, which shifts the bits across words.");
+        map.translate(til::point{ 0, 1 });
+
+        expected.clear();
+        expected.push_back(til::rectangle{ til::point{ 60, 1 }, til::size{ 10, 1 } });
+        expected.push_back(til::rectangle{ til::point{ 0, 2 }, til::size{ 100, 1 } });
+
+        actual.clear();
+        for (auto run : map.runs())
+        {
+            actual.push_back(run);
+        }
+        VERIFY_ARE_EQUAL(expected, actual);
+
+        Log::Comment(L"Scroll back up, filling the uncovered row.");
+        map.translate(til::point{ 0, -1 }, true);
+
+        expected.clear();
+        expected.push_back(til::rectangle{ til::point{ 60, 0 }, til::size{ 10, 1 } });
+        expected.push_back(til::rectangle{ til::point{ 0, 1 }, til::size{ 100, 1 } });
+        expected.push_back(til::rectangle{ til::point{ 0, 2 }, til::size{ 100, 1 } });
+
+        actual.clear();
+        for (auto run : map.runs())
+        {
+            actual.push_back(run);
+        }
+        VERIFY_ARE_EQUAL(expected, actual);
+    }
+
     TEST_METHOD(RunsWithPmr)
     {
         // This is a copy of the above test, but with a pmr::bitmap.
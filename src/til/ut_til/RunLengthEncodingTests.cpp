@@ -308,7 +308,7 @@ class RunLengthEncodingTests
             std::string_view expected;
         };
 
-        std::array<TestCase, 29> test_cases{
+        std::array<TestCase, 32> test_cases{
             {
                 // empty source
                 { "", 0, 0, "", "" },
@@ -342,6 +342,11 @@ class RunLengthEncodingTests
                 { "1|3 3|2|1 1 1|5 5", 2, 6, "6|7 7|8", "1|3|6|7 7|8|1|5 5" }, // middle, within runs
                 { "1|3 3|2|1 1 1|5 5", 2, 6, "6", "1|3|6|1|5 5" }, // middle, within runs, single run
 
+                // replace with the same value
+                { "1|3 3|2|1 1 1|5 5", 1, 3, "3 3", "1|3 3|2|1 1 1|5 5" }, // whole run
+                { "1|3 3|2|1 1 1|5 5", 5, 6, "1", "1|3 3|2|1 1 1|5 5" }, // within a run
+                { "1|3 3|2|1 1 1|5 5", 5, 8, "1 1 1", "1|3 3|2|1 1 1 1|5" }, // past the end of a run
+
                 // join with predecessor/successor run
                 { "1|3 3|2|1 1 1|5 5", 0, 3, "1|2 2", "1|2 2 2|1 1 1|5 5" }, // beginning
                 { "1|3 3|2|1 1 1|5 5", 7, 9, "1|5", "1|3 3|2|1 1 1 1|5" }, // end
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "til/ticket_lock.h"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+class TicketLockTests
+{
+    BEGIN_TEST_CLASS(TicketLockTests)
+        TEST_CLASS_PROPERTY(L"TestTimeout", L"0:0:10") // 10s timeout
+    END_TEST_CLASS()
+
+    TEST_METHOD(SharedLocksDontExcludeEachOther)
+    {
+        til::shared_ticket_lock lock;
+
+        {
+            std::shared_lock lock1{ lock };
+            std::shared_lock lock2{ lock };
+        }
+
+        // This is here just to ensure that the prior
+        // shared locks properly unlocked the lock.
+        std::unique_lock exclusive{ lock };
+        VERIFY_IS_FALSE(lock.is_contended());
+    }
+
+    TEST_METHOD(ExclusiveLocksExcludeEverything)
+    {
+        til::shared_ticket_lock lock;
+        // Deliberately not atomic. Any overlap between writers shows up as lost increments,
+        // and any overlap between a writer and a reader as an odd value.
+        uint32_t value = 0;
+        std::atomic<bool> torn{ false };
+
+        constexpr uint32_t iterations = 10000;
+        std::vector<std::thread> threads;
+        for (auto i = 0; i < 2; ++i)
+        {
+            threads.emplace_back([&]() {
+                for (uint32_t j = 0; j < iterations; ++j)
+                {
+                    std::unique_lock guard{ lock };
+                    ++value;
+                    ++value;
+                }
+            });
+            threads.emplace_back([&]() {
+                for (uint32_t j = 0; j < iterations; ++j)
+                {
+                    std::shared_lock guard{ lock };
+                    if (value % 2 != 0)
+                    {
+                        torn = true;
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        VERIFY_ARE_EQUAL(2 * 2 * iterations, value);
+        VERIFY_IS_FALSE(torn.load());
+    }
+};
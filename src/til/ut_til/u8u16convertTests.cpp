@@ -17,6 +17,7 @@ class Utf8Utf16ConvertTests
     TEST_METHOD(TestU8ToU16Partials);
     TEST_METHOD(TestU16ToU8Partials);
     TEST_METHOD(TestU8ToU16OneByOne);
+    TEST_METHOD(TestMixedAsciiRoundTrip);
 };
 
 void Utf8Utf16ConvertTests::TestU8ToU16()
@@ -191,3 +192,30 @@ void Utf8Utf16ConvertTests::TestU8ToU16OneByOne()
     VERIFY_SUCCEEDED(til::u8u16(u8String1_4, u16Out1, state));
     VERIFY_ARE_EQUAL(u16StringComp1, u16Out1);
 }
+
+void Utf8Utf16ConvertTests::TestMixedAsciiRoundTrip()
+{
+    // ASCII runs of various lengths around the 16 character blocks of the
+    // fast path, with multi-byte characters (and a surrogate pair) in between.
+    std::string u8String{};
+    std::wstring u16StringComp{};
+    for (size_t asciiLength = 0; asciiLength < 40; ++asciiLength)
+    {
+        for (size_t i = 0; i < asciiLength; ++i)
+        {
+            const auto ch = gsl::narrow_cast<char>('a' + i % 26);
+            u8String.push_back(ch);
+            u16StringComp.push_back(ch);
+        }
+        u8String.append("\xC3\xB6\xF0\xA4\xBD\x9C");
+        u16StringComp.append(L"\x00F6\xD853\xDF5C");
+    }
+
+    std::wstring u16Out{};
+    VERIFY_ARE_EQUAL(S_OK, til::u8u16(u8String, u16Out));
+    VERIFY_ARE_EQUAL(u16StringComp, u16Out);
+
+    std::string u8Out{};
+    VERIFY_ARE_EQUAL(S_OK, til::u16u8(u16Out, u8Out));
+    VERIFY_ARE_EQUAL(u8String, u8Out);
+}
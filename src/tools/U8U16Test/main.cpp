@@ -13,6 +13,12 @@
 
 #include "U8U16Test.hpp"
 
+#include <gsl/gsl>
+#include <wil/result_macros.h>
+#include <base/numerics/safe_math.h>
+#include <til/at.h>
+#include <til/u8u16convert.h>
+
 typedef NTSTATUS(WINAPI* t_RtlUTF8ToUnicodeN)(PWSTR, ULONG, PULONG, PCCH, ULONG);
 typedef NTSTATUS(WINAPI* t_RtlUnicodeToUTF8N)(PCHAR, ULONG, PULONG, PCWSTR, ULONG);
 NTSTATUS(WINAPI* p_RtlUTF8ToUnicodeN)
@@ -442,6 +448,61 @@ void CompNaturalLang_Chunks(const std::string& fileName)
     std::cout << " u16u8_ptr           length " << lenTotalU16U8 << " elapsed " << durTotalU16U8 << std::endl;
 }
 
+// Compares the platform functions with til::u8u16 and til::u16u8, which
+// convert ASCII inline and only hand the non-ASCII runs to the platform.
+void CompTil_WholeString(const std::string& name, const std::string& u8Str)
+{
+    std::string head{ __func__ };
+    head += " - " + name;
+    PrintHeader(head.c_str());
+
+    GetDuration();
+    std::unique_ptr<wchar_t[]> u16Buffer{ std::make_unique<wchar_t[]>(u8Str.length()) };
+    int length = MultiByteToWideChar(65001, 0, u8Str.data(), static_cast<int>(u8Str.length()), u16Buffer.get(), static_cast<int>(u8Str.length()));
+    double duration = GetDuration();
+    u16Buffer.reset();
+    std::cout << " MultiByteToWideChar length " << length << " elapsed " << duration << std::endl;
+
+    GetDuration();
+    std::wstring u16Str{};
+    HRESULT hRes = til::u8u16(u8Str, u16Str);
+    duration = GetDuration();
+    std::cout << " til::u8u16          length " << u16Str.length() << " elapsed " << duration << " HRESULT " << hRes << std::endl;
+
+    GetDuration();
+    std::unique_ptr<char[]> u8Buffer{ std::make_unique<char[]>(u16Str.length() * 3) };
+    length = WideCharToMultiByte(65001, 0, u16Str.data(), static_cast<int>(u16Str.length()), u8Buffer.get(), static_cast<int>(u16Str.length()) * 3, nullptr, nullptr);
+    duration = GetDuration();
+    u8Buffer.reset();
+    std::cout << " WideCharToMultiByte length " << length << " elapsed " << duration << std::endl;
+
+    GetDuration();
+    std::string u8StrOut{};
+    hRes = til::u16u8(u16Str, u8StrOut);
+    duration = GetDuration();
+    std::cout << " til::u16u8          length " << u8StrOut.length() << " elapsed " << duration << " HRESULT " << hRes << std::endl;
+}
+
+void CompTil_NaturalLang(const std::string& fileName)
+{
+    std::ostringstream u8Ss{};
+    std::ostringstream buf{};
+    buf << std::ifstream{ fileName }.rdbuf();
+    std::fill_n(std::ostream_iterator<const char*>{ u8Ss }, 300000u, buf.str().c_str());
+    CompTil_WholeString(fileName, u8Ss.str());
+}
+
+void CompTil_Log()
+{
+    // What a build or a tail -f typically prints: ASCII with a few VT sequences.
+    std::string u8Str{};
+    for (int i = 0; i < 300000; ++i)
+    {
+        u8Str += "\x1b[32m[info]\x1b[m 2020-10-14 12:34:56 compiling src/renderer/base/renderer.cpp\r\n";
+    }
+    CompTil_WholeString("log", u8Str);
+}
+
 int main()
 {
     // UTF-16 string length
@@ -519,6 +580,14 @@ int main()
     CompNaturalLang_Chunks("ru.txt");
     CompNaturalLang_Chunks("zh.txt");
 
+    std::cout << "\n\n### til ###" << std::endl;
+
+    CompTil_Log();
+    CompTil_NaturalLang("en.txt");
+    CompTil_NaturalLang("fr.txt");
+    CompTil_NaturalLang("ru.txt");
+    CompTil_NaturalLang("zh.txt");
+
     FreeLibrary(ntdll);
     return 0;
 }
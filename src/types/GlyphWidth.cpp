@@ -25,6 +25,14 @@ bool IsGlyphFullWidth(const wchar_t wch) noexcept
     return widthDetector.IsWide(wch);
 }
 
+// Function Description:
+// - determines the width of every codepoint of the given text in one pass.
+//      See CodepointWidthDetector::GetWidths
+void GetGlyphWidths(const std::wstring_view text, const gsl::span<CodepointWidth> widths)
+{
+    widthDetector.GetWidths(text, widths);
+}
+
 // Function Description:
 // - Sets a function that should be used by the global CodepointWidthDetector
 //      as the fallback mechanism for determining a particular glyph's width,
@@ -50,3 +58,15 @@ void NotifyGlyphWidthFontChanged() noexcept
 {
     widthDetector.NotifyFontChanged();
 }
+
+// Function Description:
+// - Forwards the request to pre-warm the ambiguous width cache for the new
+//      font to the glyph width detector. See CodepointWidthDetector::PrewarmFallbackCache
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void PrewarmGlyphWidthFallback() noexcept
+{
+    widthDetector.PrewarmFallbackCache();
+}
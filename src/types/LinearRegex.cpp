@@ -0,0 +1,833 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/LinearRegex.hpp"
+
+using namespace Microsoft::Console::Types;
+
+namespace
+{
+    constexpr char32_t MaxCodePoint = 0x10FFFF;
+    constexpr uint32_t Unbounded = UINT32_MAX;
+    // Repetition counts above this are rejected, instead of compiling them
+    // into ever more instructions until MaxProgramSize is reached.
+    constexpr uint32_t MaxRepeatCount = 1000;
+    // Groups are parsed recursively, so their nesting has to be limited too.
+    constexpr size_t MaxGroupDepth = 100;
+
+    using Ranges = std::vector<std::pair<char32_t, char32_t>>;
+
+    const Ranges DigitRanges{ { L'0', L'9' } };
+    const Ranges WordRanges{ { L'0', L'9' }, { L'A', L'Z' }, { L'_', L'_' }, { L'a', L'z' } };
+    const Ranges SpaceRanges{
+        { 0x0009, 0x000D }, { 0x0020, 0x0020 }, { 0x00A0, 0x00A0 }, { 0x1680, 0x1680 }, { 0x2000, 0x200A },
+        { 0x2028, 0x2029 }, { 0x202F, 0x202F }, { 0x205F, 0x205F }, { 0x3000, 0x3000 }, { 0xFEFF, 0xFEFF }
+    };
+
+    // The parsed pattern, before it's compiled into the program.
+    struct Node
+    {
+        enum class Kind
+        {
+            Concat,
+            Alternate,
+            Repeat,
+            Char,
+            Any,
+            Class,
+            LineStart,
+            LineEnd,
+            WordBoundary,
+            NotWordBoundary
+        };
+
+        Kind kind;
+        // Char: the code point. Class: the index of the class.
+        uint32_t value = 0;
+        std::vector<Node> children;
+        uint32_t min = 0;
+        uint32_t max = 0;
+        bool greedy = true;
+    };
+
+    constexpr bool _IsLeadingSurrogate(const wchar_t wch) noexcept
+    {
+        return wch >= 0xD800 && wch <= 0xDBFF;
+    }
+
+    constexpr bool _IsTrailingSurrogate(const wchar_t wch) noexcept
+    {
+        return wch >= 0xDC00 && wch <= 0xDFFF;
+    }
+
+    constexpr char32_t _CombineSurrogates(const wchar_t leading, const wchar_t trailing) noexcept
+    {
+        return ((static_cast<char32_t>(leading) - 0xD800) << 10) + (static_cast<char32_t>(trailing) - 0xDC00) + 0x10000;
+    }
+
+    // Decodes the code point at pos, and returns its length in code units.
+    char32_t _DecodeAt(const std::wstring_view text, const size_t pos, size_t& length) noexcept
+    {
+        const auto wch = til::at(text, pos);
+        if (_IsLeadingSurrogate(wch) && pos + 1 < text.size() && _IsTrailingSurrogate(til::at(text, pos + 1)))
+        {
+            length = 2;
+            return _CombineSurrogates(wch, til::at(text, pos + 1));
+        }
+        length = 1;
+        return wch;
+    }
+
+    bool _IsWordAt(const std::wstring_view text, const size_t pos) noexcept
+    {
+        if (pos >= text.size())
+        {
+            return false;
+        }
+        const auto wch = til::at(text, pos);
+        return (wch >= L'0' && wch <= L'9') || (wch >= L'A' && wch <= L'Z') || (wch >= L'a' && wch <= L'z') || wch == L'_';
+    }
+
+    char32_t _FoldCase(const char32_t ch) noexcept
+    {
+        return ch <= 0xFFFF ? ::towlower(static_cast<wchar_t>(ch)) : ch;
+    }
+
+    Ranges _Complement(Ranges ranges)
+    {
+        std::sort(ranges.begin(), ranges.end());
+        Ranges result;
+        char32_t next = 0;
+        for (const auto& [lo, hi] : ranges)
+        {
+            if (lo > next)
+            {
+                result.emplace_back(next, lo - 1);
+            }
+            next = std::max<char32_t>(next, hi + 1);
+        }
+        if (next <= MaxCodePoint)
+        {
+            result.emplace_back(next, MaxCodePoint);
+        }
+        return result;
+    }
+}
+
+// A recursive descent parser for the pattern, which also compiles the parsed
+// pattern into the program.
+class LinearRegex::Parser final
+{
+public:
+    Parser(const std::wstring_view pattern, std::vector<CharClass>& classes, const bool caseInsensitive) noexcept :
+        _pattern{ pattern },
+        _classes{ classes },
+        _caseInsensitive{ caseInsensitive }
+    {
+    }
+
+    Node Parse()
+    {
+        auto node = _ParseAlternation();
+        if (!_AtEnd())
+        {
+            // The only thing that ends an alternation early is an unmatched ')'.
+            THROW_HR(E_INVALIDARG);
+        }
+        return node;
+    }
+
+    void Compile(const Node& node, std::vector<Instruction>& program) const
+    {
+        switch (node.kind)
+        {
+        case Node::Kind::Concat:
+            for (const auto& child : node.children)
+            {
+                Compile(child, program);
+            }
+            break;
+        case Node::Kind::Alternate:
+        {
+            // split L1, L2; L1: a; jump end; L2: split L3, L4; L3: b; jump end; L4: c; end:
+            std::vector<size_t> jumps;
+            for (size_t i = 0; i + 1 < node.children.size(); ++i)
+            {
+                const auto split = _Emit(program, Op::Split);
+                program.at(split).x = gsl::narrow_cast<uint32_t>(program.size());
+                Compile(node.children.at(i), program);
+                jumps.emplace_back(_Emit(program, Op::Jump));
+                program.at(split).y = gsl::narrow_cast<uint32_t>(program.size());
+            }
+            Compile(node.children.back(), program);
+            for (const auto jump : jumps)
+            {
+                program.at(jump).x = gsl::narrow_cast<uint32_t>(program.size());
+            }
+            break;
+        }
+        case Node::Kind::Repeat:
+        {
+            const auto& body = node.children.front();
+            for (uint32_t i = 0; i < node.min; ++i)
+            {
+                Compile(body, program);
+            }
+            if (node.max == Unbounded)
+            {
+                // loop: split body, end; body: ...; jump loop; end:
+                const auto split = _Emit(program, Op::Split);
+                Compile(body, program);
+                program.at(_Emit(program, Op::Jump)).x = gsl::narrow_cast<uint32_t>(split);
+                _SetSplitTargets(program.at(split), split + 1, program.size(), node.greedy);
+            }
+            else
+            {
+                // Every optional repetition can skip all the ones after it.
+                std::vector<size_t> splits;
+                for (auto i = node.min; i < node.max; ++i)
+                {
+                    splits.emplace_back(_Emit(program, Op::Split));
+                    Compile(body, program);
+                }
+                for (const auto split : splits)
+                {
+                    _SetSplitTargets(program.at(split), split + 1, program.size(), node.greedy);
+                }
+            }
+            break;
+        }
+        case Node::Kind::Char:
+            program.at(_Emit(program, Op::Char)).x = _caseInsensitive ? _FoldCase(node.value) : node.value;
+            break;
+        case Node::Kind::Any:
+            _Emit(program, Op::Any);
+            break;
+        case Node::Kind::Class:
+            program.at(_Emit(program, Op::Class)).x = node.value;
+            break;
+        case Node::Kind::LineStart:
+            _Emit(program, Op::AssertLineStart);
+            break;
+        case Node::Kind::LineEnd:
+            _Emit(program, Op::AssertLineEnd);
+            break;
+        case Node::Kind::WordBoundary:
+            _Emit(program, Op::AssertWordBoundary);
+            break;
+        case Node::Kind::NotWordBoundary:
+            _Emit(program, Op::AssertNotWordBoundary);
+            break;
+        }
+    }
+
+private:
+    static size_t _Emit(std::vector<Instruction>& program, const Op op)
+    {
+        if (program.size() >= MaxProgramSize)
+        {
+            THROW_HR(E_INVALIDARG);
+        }
+        program.push_back({ op, 0, 0 });
+        return program.size() - 1;
+    }
+
+    static void _SetSplitTargets(Instruction& split, const size_t body, const size_t end, const bool greedy)
+    {
+        // The first target of a split is the preferred one.
+        split.x = gsl::narrow_cast<uint32_t>(greedy ? body : end);
+        split.y = gsl::narrow_cast<uint32_t>(greedy ? end : body);
+    }
+
+    bool _AtEnd() const noexcept
+    {
+        return _pos >= _pattern.size();
+    }
+
+    wchar_t _Peek() const noexcept
+    {
+        return _AtEnd() ? L'\0' : til::at(_pattern, _pos);
+    }
+
+    bool _Accept(const wchar_t wch) noexcept
+    {
+        if (!_AtEnd() && _Peek() == wch)
+        {
+            ++_pos;
+            return true;
+        }
+        return false;
+    }
+
+    char32_t _NextCodePoint()
+    {
+        if (_AtEnd())
+        {
+            THROW_HR(E_INVALIDARG);
+        }
+        size_t length;
+        const auto ch = _DecodeAt(_pattern, _pos, length);
+        _pos += length;
+        return ch;
+    }
+
+    Node _ParseAlternation()
+    {
+        auto first = _ParseConcat();
+        if (_Peek() != L'|')
+        {
+            return first;
+        }
+
+        Node node{ Node::Kind::Alternate };
+        node.children.emplace_back(std::move(first));
+        while (_Accept(L'|'))
+        {
+            node.children.emplace_back(_ParseConcat());
+        }
+        return node;
+    }
+
+    Node _ParseConcat()
+    {
+        Node node{ Node::Kind::Concat };
+        while (!_AtEnd() && _Peek() != L'|' && _Peek() != L')')
+        {
+            node.children.emplace_back(_ParseRepeat());
+        }
+        return node;
+    }
+
+    Node _ParseRepeat()
+    {
+        auto atom = _ParseAtom();
+
+        uint32_t min;
+        uint32_t max;
+        if (_Accept(L'*'))
+        {
+            min = 0;
+            max = Unbounded;
+        }
+        else if (_Accept(L'+'))
+        {
+            min = 1;
+            max = Unbounded;
+        }
+        else if (_Accept(L'?'))
+        {
+            min = 0;
+            max = 1;
+        }
+        else if (!_TryParseCount(min, max))
+        {
+            return atom;
+        }
+
+        Node node{ Node::Kind::Repeat };
+        node.min = min;
+        node.max = max;
+        node.greedy = !_Accept(L'?');
+        node.children.emplace_back(std::move(atom));
+
+        // "a**" and the like are as much of a mistake here as they are in ECMAScript.
+        if (_Peek() == L'*' || _Peek() == L'+' || _Peek() == L'?' || _TryParseCount(min, max))
+        {
+            THROW_HR(E_INVALIDARG);
+        }
+        return node;
+    }
+
+    // Parses {n}, {n,} or {n,m}. Anything else that starts with a '{' is left
+    // alone, and is matched literally, like ECMAScript does.
+    bool _TryParseCount(uint32_t& min, uint32_t& max)
+    {
+        if (_Peek() != L'{')
+        {
+            return false;
+        }
+
+        auto pos = _pos + 1;
+        const auto parseNumber = [&](uint32_t& value) {
+            const auto begin = pos;
+            value = 0;
+            while (pos < _pattern.size() && til::at(_pattern, pos) >= L'0' && til::at(_pattern, pos) <= L'9')
+            {
+                value = std::min(value * 10 + (til::at(_pattern, pos) - L'0'), MaxRepeatCount + 1);
+                ++pos;
+            }
+            return pos != begin;
+        };
+
+        if (!parseNumber(min))
+        {
+            return false;
+        }
+        max = min;
+        if (pos < _pattern.size() && til::at(_pattern, pos) == L',')
+        {
+            ++pos;
+            if (!parseNumber(max))
+            {
+                max = Unbounded;
+            }
+        }
+        if (pos >= _pattern.size() || til::at(_pattern, pos) != L'}')
+        {
+            return false;
+        }
+
+        if (min > MaxRepeatCount || (max != Unbounded && (max > MaxRepeatCount || max < min)))
+        {
+            THROW_HR(E_INVALIDARG);
+        }
+        _pos = pos + 1;
+        return true;
+    }
+
+    Node _ParseAtom()
+    {
+        const auto wch = _Peek();
+        switch (wch)
+        {
+        case L'(':
+        {
+            ++_pos;
+            if (++_depth > MaxGroupDepth)
+            {
+                THROW_HR(E_INVALIDARG);
+            }
+            // Groups don't capture, so (?:...) is the same as (...).
+            // Lookaround and the other extensions aren't supported.
+            if (_Accept(L'?') && !_Accept(L':'))
+            {
+                THROW_HR(E_INVALIDARG);
+            }
+            auto node = _ParseAlternation();
+            if (!_Accept(L')'))
+            {
+                THROW_HR(E_INVALIDARG);
+            }
+            --_depth;
+            return node;
+        }
+        case L'*':
+        case L'+':
+        case L'?':
+            // Nothing to repeat.
+            THROW_HR(E_INVALIDARG);
+        case L'[':
+            ++_pos;
+            return _ParseClass();
+        case L'.':
+            ++_pos;
+            return Node{ Node::Kind::Any };
+        case L'^':
+            ++_pos;
+            return Node{ Node::Kind::LineStart };
+        case L'$':
+            ++_pos;
+            return Node{ Node::Kind::LineEnd };
+        case L'\\':
+            ++_pos;
+            return _ParseEscape();
+        default:
+            return _MakeChar(_NextCodePoint());
+        }
+    }
+
+    Node _ParseEscape()
+    {
+        const auto wch = _Peek();
+        switch (wch)
+        {
+        case L'b':
+            ++_pos;
+            return Node{ Node::Kind::WordBoundary };
+        case L'B':
+            ++_pos;
+            return Node{ Node::Kind::NotWordBoundary };
+        case L'd':
+        case L'D':
+        case L'w':
+        case L'W':
+        case L's':
+        case L'S':
+        {
+            ++_pos;
+            CharClass charClass;
+            charClass.ranges = _ShorthandRanges(wch);
+            charClass.negated = ::iswupper(wch) != 0;
+            return _MakeClass(std::move(charClass));
+        }
+        default:
+            return _MakeChar(_ParseCharEscape());
+        }
+    }
+
+    // Parses the escapes that stand for a single character, after the '\'.
+    char32_t _ParseCharEscape()
+    {
+        const auto ch = _NextCodePoint();
+        switch (ch)
+        {
+        case L't':
+            return L'\t';
+        case L'n':
+            return L'\n';
+        case L'r':
+            return L'\r';
+        case L'f':
+            return L'\f';
+        case L'v':
+            return L'\v';
+        case L'0':
+            return L'\0';
+        case L'x':
+            return _ParseHex(2);
+        case L'u':
+            return _ParseHex(4);
+        default:
+            // Any other letter or digit might mean something in some other
+            // regex dialect. Rather than silently matching it literally, the
+            // pattern is rejected.
+            if (ch <= 0x7F && ::iswalnum(static_cast<wchar_t>(ch)))
+            {
+                THROW_HR(E_INVALIDARG);
+            }
+            return ch;
+        }
+    }
+
+    char32_t _ParseHex(const size_t digits)
+    {
+        char32_t value = 0;
+        for (size_t i = 0; i < digits; ++i)
+        {
+            const auto wch = _Peek();
+            if (!::iswxdigit(wch))
+            {
+                THROW_HR(E_INVALIDARG);
+            }
+            ++_pos;
+            value = value * 16 + (wch <= L'9' ? wch - L'0' : (::towlower(wch) - L'a' + 10));
+        }
+        return value;
+    }
+
+    // Parses a class, after the '['.
+    Node _ParseClass()
+    {
+        CharClass charClass;
+        charClass.negated = _Accept(L'^');
+
+        // Like in PCRE, a ']' right at the start is a literal ']'.
+        auto first = true;
+        while (first || _Peek() != L']')
+        {
+            if (_AtEnd())
+            {
+                THROW_HR(E_INVALIDARG);
+            }
+            first = false;
+
+            char32_t lo;
+            if (!_ParseClassAtom(charClass.ranges, lo))
+            {
+                continue;
+            }
+
+            // A '-' at the end of the class is a literal '-'.
+            if (_Peek() == L'-' && _pos + 1 < _pattern.size() && til::at(_pattern, _pos + 1) != L']')
+            {
+                ++_pos;
+                char32_t hi;
+                if (!_ParseClassAtom(charClass.ranges, hi) || hi < lo)
+                {
+                    // [a-\d] and [z-a] don't make sense.
+                    THROW_HR(E_INVALIDARG);
+                }
+                charClass.ranges.emplace_back(lo, hi);
+            }
+            else
+            {
+                charClass.ranges.emplace_back(lo, lo);
+            }
+        }
+        ++_pos;
+
+        return _MakeClass(std::move(charClass));
+    }
+
+    // Parses one character of a class. Shorthands like \d add their ranges
+    // directly and return false, since they can't be the end of a range.
+    bool _ParseClassAtom(Ranges& ranges, char32_t& ch)
+    {
+        if (!_Accept(L'\\'))
+        {
+            ch = _NextCodePoint();
+            return true;
+        }
+
+        const auto wch = _Peek();
+        switch (wch)
+        {
+        case L'd':
+        case L'w':
+        case L's':
+        {
+            ++_pos;
+            const auto& shorthand = _ShorthandRanges(wch);
+            ranges.insert(ranges.end(), shorthand.begin(), shorthand.end());
+            return false;
+        }
+        case L'D':
+        case L'W':
+        case L'S':
+        {
+            ++_pos;
+            const auto complement = _Complement(_ShorthandRanges(wch));
+            ranges.insert(ranges.end(), complement.begin(), complement.end());
+            return false;
+        }
+        case L'b':
+            // Inside a class, \b is a backspace.
+            ++_pos;
+            ch = L'\b';
+            return true;
+        default:
+            ch = _ParseCharEscape();
+            return true;
+        }
+    }
+
+    static const Ranges& _ShorthandRanges(const wchar_t wch) noexcept
+    {
+        switch (::towlower(wch))
+        {
+        case L'd':
+            return DigitRanges;
+        case L'w':
+            return WordRanges;
+        default:
+            return SpaceRanges;
+        }
+    }
+
+    static Node _MakeChar(const char32_t ch) noexcept
+    {
+        Node node{ Node::Kind::Char };
+        node.value = ch;
+        return node;
+    }
+
+    Node _MakeClass(CharClass charClass)
+    {
+        _classes.emplace_back(std::move(charClass));
+        Node node{ Node::Kind::Class };
+        node.value = gsl::narrow_cast<uint32_t>(_classes.size() - 1);
+        return node;
+    }
+
+    std::wstring_view _pattern;
+    size_t _pos = 0;
+    size_t _depth = 0;
+    std::vector<CharClass>& _classes;
+    bool _caseInsensitive;
+};
+
+// Routine Description:
+// - Compiles a pattern.
+// Arguments:
+// - pattern - The regular expression. See LinearRegex.hpp for the syntax.
+// - caseInsensitive - Whether letters match regardless of their case.
+// Return Value:
+// - <none>
+// - NOTE: Throws E_INVALIDARG if the pattern isn't valid, or is too large.
+LinearRegex::LinearRegex(const std::wstring_view pattern, const bool caseInsensitive) :
+    _caseInsensitive{ caseInsensitive }
+{
+    Parser parser{ pattern, _classes, caseInsensitive };
+    parser.Compile(parser.Parse(), _program);
+    _program.push_back({ Op::Match, 0, 0 });
+    _visited.resize(_program.size());
+}
+
+// Routine Description:
+// - Finds the leftmost match of the pattern that starts at or after offset.
+// - This takes O(text.size() * program size) time at worst.
+// Arguments:
+// - text - The text to search. ^ and $ match at its start and its end.
+// - offset - Where in the text to start searching.
+// Return Value:
+// - The [begin, end) code unit offsets of the match, if there is one.
+//   Matches can be empty, so callers that look for every match need to step
+//   over those themselves.
+std::optional<std::pair<size_t, size_t>> LinearRegex::Find(const std::wstring_view text, const size_t offset) const
+{
+    if (offset > text.size())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<std::pair<size_t, size_t>> match;
+    auto pos = offset;
+
+    _currentThreads.clear();
+    ++_generation;
+    _AddThread(_currentThreads, 0, pos, text, pos);
+
+    for (;;)
+    {
+        const auto atEnd = pos >= text.size();
+        size_t length = 0;
+        const auto ch = atEnd ? U'\0' : _DecodeAt(text, pos, length);
+
+        _nextThreads.clear();
+        ++_generation;
+
+        // The threads are in order of priority, so the first one to match
+        // wins, and every thread after it is dropped. The ones before it
+        // continue, because they might still find the match they prefer.
+        for (const auto& thread : _currentThreads)
+        {
+            const auto& instruction = til::at(_program, thread.pc);
+            if (instruction.op == Op::Match)
+            {
+                match.emplace(thread.start, pos);
+                break;
+            }
+            if (!atEnd && _MatchesChar(instruction, ch))
+            {
+                _AddThread(_nextThreads, thread.pc + 1, thread.start, text, pos + length);
+            }
+        }
+
+        if (atEnd)
+        {
+            break;
+        }
+        pos += length;
+
+        // Until something matched, a new attempt starts at every position,
+        // with the lowest priority, since it starts further to the right.
+        if (!match)
+        {
+            _AddThread(_nextThreads, 0, pos, text, pos);
+        }
+
+        std::swap(_currentThreads, _nextThreads);
+        if (match && _currentThreads.empty())
+        {
+            break;
+        }
+    }
+
+    return match;
+}
+
+// Routine Description:
+// - Adds the thread at pc to the list, after following its jumps, splits
+//   and assertions, so that the list only holds threads that wait for the
+//   next character, or that matched.
+// Arguments:
+// - list - The list of threads for the position at.
+// - pc - The instruction the thread continues at.
+// - start - Where the thread's match started.
+// - text - The text being searched.
+// - at - The position in text that the thread is at.
+// Return Value:
+// - <none>
+void LinearRegex::_AddThread(std::vector<Thread>& list, const uint32_t pc, const size_t start, const std::wstring_view text, const size_t at) const
+{
+    _stack.clear();
+    _stack.emplace_back(pc);
+
+    while (!_stack.empty())
+    {
+        const auto current = _stack.back();
+        _stack.pop_back();
+
+        // Every instruction is only added once per position. That's what
+        // keeps the search linear, and it's also what stops empty loops
+        // like (a*)* from looping forever.
+        auto& visited = til::at(_visited, current);
+        if (visited == _generation)
+        {
+            continue;
+        }
+        visited = _generation;
+
+        const auto& instruction = til::at(_program, current);
+        switch (instruction.op)
+        {
+        case Op::Jump:
+            _stack.emplace_back(instruction.x);
+            break;
+        case Op::Split:
+            // The stack is LIFO: the preferred target goes last.
+            _stack.emplace_back(instruction.y);
+            _stack.emplace_back(instruction.x);
+            break;
+        case Op::AssertLineStart:
+            if (at == 0)
+            {
+                _stack.emplace_back(current + 1);
+            }
+            break;
+        case Op::AssertLineEnd:
+            if (at == text.size())
+            {
+                _stack.emplace_back(current + 1);
+            }
+            break;
+        case Op::AssertWordBoundary:
+        case Op::AssertNotWordBoundary:
+        {
+            const auto boundary = (at > 0 && _IsWordAt(text, at - 1)) != _IsWordAt(text, at);
+            if (boundary == (instruction.op == Op::AssertWordBoundary))
+            {
+                _stack.emplace_back(current + 1);
+            }
+            break;
+        }
+        default:
+            list.push_back({ current, start });
+            break;
+        }
+    }
+}
+
+bool LinearRegex::_MatchesChar(const Instruction& instruction, const char32_t ch) const noexcept
+{
+    switch (instruction.op)
+    {
+    case Op::Char:
+        return (_caseInsensitive ? _FoldCase(ch) : ch) == instruction.x;
+    case Op::Any:
+        return ch != L'\n' && ch != L'\r';
+    case Op::Class:
+        return _InClass(til::at(_classes, instruction.x), ch);
+    default:
+        return false;
+    }
+}
+
+bool LinearRegex::_InClass(const CharClass& charClass, const char32_t ch) const noexcept
+{
+    const auto inRanges = [&](const char32_t c) {
+        return std::any_of(charClass.ranges.begin(), charClass.ranges.end(), [&](const auto& range) {
+            return c >= range.first && c <= range.second;
+        });
+    };
+
+    auto found = inRanges(ch);
+    if (!found && _caseInsensitive && ch <= 0xFFFF)
+    {
+        // [A-Z] has to match 'a' and [a-z] 'A'.
+        const auto wch = static_cast<wchar_t>(ch);
+        found = inRanges(::towlower(wch)) || inRanges(::towupper(wch));
+    }
+    return found != charClass.negated;
+}
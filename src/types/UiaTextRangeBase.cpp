@@ -970,19 +970,42 @@ std::wstring UiaTextRangeBase::_getTextValue(std::optional<unsigned int> maxLeng
         bufferSize.DecrementInBounds(inclusiveEnd, true);
 
         const auto textRects = buffer.GetTextRects(_start, inclusiveEnd, _blockRange, true);
-        const auto bufferData = buffer.GetText(true,
-                                               false,
-                                               textRects);
 
-        const size_t textDataSize = base::ClampMul(bufferData.text.size(), bufferSize.Width());
-        textData.reserve(textDataSize);
-        for (const auto& text : bufferData.text)
+        if (maxLength.has_value())
         {
-            textData += text;
+            // Screen readers often only want the start of a large range. The
+            // text of each row doesn't depend on the others, so we can stop
+            // reading rows once we have enough text.
+            for (const auto& rect : textRects)
+            {
+                if (textData.size() >= *maxLength)
+                {
+                    break;
+                }
+
+                const auto bufferData = buffer.GetText(true, false, { rect });
+                for (const auto& text : bufferData.text)
+                {
+                    textData += text;
+                }
+            }
+        }
+        else
+        {
+            const auto bufferData = buffer.GetText(true,
+                                                   false,
+                                                   textRects);
+
+            const size_t textDataSize = base::ClampMul(bufferData.text.size(), bufferSize.Width());
+            textData.reserve(textDataSize);
+            for (const auto& text : bufferData.text)
+            {
+                textData += text;
+            }
         }
     }
 
-    if (maxLength.has_value())
+    if (maxLength.has_value() && textData.size() > *maxLength)
     {
         textData.resize(*maxLength);
     }
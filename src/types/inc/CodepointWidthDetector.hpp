@@ -14,6 +14,7 @@ Author:
 #pragma once
 
 #include "convert.hpp"
+#include <atomic>
 #include <functional>
 
 static_assert(sizeof(unsigned int) == sizeof(wchar_t) * 2,
@@ -33,8 +34,10 @@ public:
     CodepointWidth GetWidth(const std::wstring_view glyph) const;
     bool IsWide(const std::wstring_view glyph) const;
     bool IsWide(const wchar_t wch) const noexcept;
+    void GetWidths(const std::wstring_view text, const gsl::span<CodepointWidth> widths) const;
     void SetFallbackMethod(std::function<bool(const std::wstring_view)> pfnFallback);
     void NotifyFontChanged() const noexcept;
+    void PrewarmFallbackCache() const noexcept;
 
 #ifdef UNIT_TESTING
     friend class CodepointWidthDetectorTests;
@@ -42,10 +45,21 @@ public:
 
 private:
     CodepointWidth _lookupGlyphWidth(const std::wstring_view glyph) const;
+    static CodepointWidth _lookupRangeWidth(const unsigned int codepoint) noexcept;
     CodepointWidth _lookupGlyphWidthWithCache(const std::wstring_view glyph) const noexcept;
     bool _checkFallbackViaCache(const std::wstring_view glyph) const;
+    bool _tryGetCachedFallback(const unsigned int codepoint, bool& isWide) const noexcept;
+    void _storeCachedFallback(const unsigned int codepoint, const bool isWide) const noexcept;
     static unsigned int _extractCodepoint(const std::wstring_view glyph) noexcept;
 
-    mutable std::unordered_map<std::wstring, bool> _fallbackCache;
+    // The fallback results are stored in a fixed size open addressing hash table
+    // keyed by codepoint, so that the parser thread and UIA readers can query it
+    // without taking a lock. Every slot packs the codepoint, the result and the
+    // generation it was stored in, and NotifyFontChanged just starts a new generation.
+    // An all-zero slot is empty, since generations start at 1.
+    static constexpr size_t s_fallbackCacheSize = 4096;
+    static constexpr size_t s_fallbackCacheProbes = 8;
+    mutable std::array<std::atomic<uint64_t>, s_fallbackCacheSize> _fallbackCache;
+    mutable std::atomic<uint32_t> _fallbackGeneration;
     std::function<bool(std::wstring_view)> _pfnFallbackMethod;
 };
@@ -12,7 +12,11 @@ Abstract:
 #include <functional>
 #include <string_view>
 
+#include "convert.hpp"
+
 bool IsGlyphFullWidth(const std::wstring_view glyph);
 bool IsGlyphFullWidth(const wchar_t wch) noexcept;
+void GetGlyphWidths(const std::wstring_view text, const gsl::span<CodepointWidth> widths);
 void SetGlyphWidthFallback(std::function<bool(std::wstring_view)> pfnFallback);
 void NotifyGlyphWidthFontChanged() noexcept;
+void PrewarmGlyphWidthFallback() noexcept;
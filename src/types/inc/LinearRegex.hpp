@@ -0,0 +1,100 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- LinearRegex.hpp
+
+Abstract:
+- A small regular expression engine for searching the text buffer.
+- Patterns are compiled into a Thompson NFA, which is run as a Pike VM: all
+  the possible states of the match are advanced together, one code point at a
+  time. A search therefore takes time linear in the length of the text, no
+  matter the pattern, and a pattern typed into the search box can't make the
+  UI hang with catastrophic backtracking.
+- Matches are leftmost-first, like in ECMAScript or PCRE: of the matches that
+  start at the leftmost position, the one the pattern prefers wins.
+- The supported syntax is the common subset of ECMAScript and PCRE without
+  backreferences and lookaround:
+    literals, ., [abc], [^a-z], \d \w \s \D \W \S, \t \n \r \f \v \xHH \uHHHH,
+    ^ $ \b \B, (...) (?:...), |, * + ? {n} {n,} {n,m} and their lazy forms.
+
+--*/
+
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Microsoft::Console::Types
+{
+    class LinearRegex final
+    {
+    public:
+        // Patterns that compile into more instructions than this (mostly
+        // because of large repetition counts) are rejected.
+        static constexpr size_t MaxProgramSize = 10000;
+
+        LinearRegex(const std::wstring_view pattern, const bool caseInsensitive);
+
+        std::optional<std::pair<size_t, size_t>> Find(const std::wstring_view text, const size_t offset = 0) const;
+
+    private:
+        enum class Op : uint8_t
+        {
+            Char,
+            Any,
+            Class,
+            Split,
+            Jump,
+            AssertLineStart,
+            AssertLineEnd,
+            AssertWordBoundary,
+            AssertNotWordBoundary,
+            Match
+        };
+
+        struct Instruction
+        {
+            Op op;
+            // Char: the code point. Class: the index into _classes.
+            // Split: the preferred target. Jump: the target.
+            uint32_t x;
+            // Split: the other target.
+            uint32_t y;
+        };
+
+        struct CharClass
+        {
+            std::vector<std::pair<char32_t, char32_t>> ranges;
+            bool negated = false;
+        };
+
+        struct Thread
+        {
+            uint32_t pc;
+            size_t start;
+        };
+
+        class Parser;
+
+        bool _MatchesChar(const Instruction& instruction, const char32_t ch) const noexcept;
+        bool _InClass(const CharClass& charClass, const char32_t ch) const noexcept;
+        void _AddThread(std::vector<Thread>& list, const uint32_t pc, const size_t start, const std::wstring_view text, const size_t at) const;
+
+        std::vector<Instruction> _program;
+        std::vector<CharClass> _classes;
+        bool _caseInsensitive;
+
+        // Scratch space for Find, so that searching line after line doesn't
+        // allocate every time. A LinearRegex must thus not be shared between
+        // threads; every search makes its own.
+        mutable std::vector<Thread> _currentThreads;
+        mutable std::vector<Thread> _nextThreads;
+        mutable std::vector<uint32_t> _stack;
+        mutable std::vector<size_t> _visited;
+        mutable size_t _generation = 0;
+    };
+}
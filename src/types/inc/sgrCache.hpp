@@ -0,0 +1,76 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- sgrCache.hpp
+
+Abstract:
+- A small memo of SGR results. Applications tend to emit the same few SGR
+  sequences over and over (a colorized compiler log uses two per token), so
+  remembering what a given sequence did to a given attribute lets us skip
+  re-applying its options one at a time.
+
+--*/
+
+#pragma once
+
+#include "..\..\buffer\out\TextAttribute.hpp"
+#include "..\..\terminal\adapter\DispatchTypes.hpp"
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    class SgrCache
+    {
+    public:
+        // Sequences with more options than this aren't cached. Real output
+        // rarely uses more than a handful, and 38/48 take up to 5 each.
+        static constexpr size_t MaxCachedOptions = 10;
+
+        // Method Description:
+        // - Looks up the result of applying the given SGR options to attributes.
+        // Arguments:
+        // - attributes - The attributes the options would be applied to.
+        // - options - The SGR options.
+        // - result - Receives the resulting attributes, if they're cached.
+        // Return Value:
+        // - True if the result was found in the cache.
+        bool TryLookup(const TextAttribute& attributes,
+                       const VTParameters options,
+                       TextAttribute& result) const noexcept;
+
+        // Method Description:
+        // - Remembers the result of applying the given SGR options to attributes,
+        //   replacing whatever was cached for similar options before.
+        // Arguments:
+        // - attributes - The attributes before the options were applied.
+        // - options - The SGR options.
+        // - result - The attributes after the options were applied.
+        // Return Value:
+        // - <none>
+        void Store(const TextAttribute& attributes,
+                   const VTParameters options,
+                   const TextAttribute& result) noexcept;
+
+    private:
+        // The cache is direct mapped (on the options alone), so this needs to
+        // be a power of two.
+        static constexpr size_t _entryCount = 16;
+
+        struct Entry
+        {
+            TextAttribute before;
+            TextAttribute after;
+            std::array<size_t, MaxCachedOptions> options{};
+            // An empty VTParameters still has a size of 1, so an entry with no
+            // options never matches anything.
+            size_t optionCount = 0;
+        };
+
+        static size_t _OptionKey(const VTParameter option) noexcept;
+        static size_t _Slot(const VTParameters options) noexcept;
+        static bool _OptionsMatch(const Entry& entry, const VTParameters options) noexcept;
+
+        std::array<Entry, _entryCount> _entries;
+    };
+}
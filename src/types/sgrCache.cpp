@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/sgrCache.hpp"
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    bool SgrCache::TryLookup(const TextAttribute& attributes,
+                             const VTParameters options,
+                             TextAttribute& result) const noexcept
+    {
+        if (options.size() > MaxCachedOptions)
+        {
+            return false;
+        }
+
+        const auto& entry = til::at(_entries, _Slot(options));
+        if (entry.before == attributes && _OptionsMatch(entry, options))
+        {
+            result = entry.after;
+            return true;
+        }
+        return false;
+    }
+
+    void SgrCache::Store(const TextAttribute& attributes,
+                         const VTParameters options,
+                         const TextAttribute& result) noexcept
+    {
+        if (options.size() > MaxCachedOptions)
+        {
+            return;
+        }
+
+        auto& entry = til::at(_entries, _Slot(options));
+        entry.before = attributes;
+        entry.after = result;
+        entry.optionCount = options.size();
+        for (size_t i = 0; i < entry.optionCount; i++)
+        {
+            til::at(entry.options, i) = _OptionKey(options.at(i));
+        }
+    }
+
+    // Omitted options have to be told apart from explicit zeros. They mean the
+    // same thing for most SGRs, but not in the middle of a 38/48 color.
+    size_t SgrCache::_OptionKey(const VTParameter option) noexcept
+    {
+        return option.has_value() ? option.value() : SIZE_MAX;
+    }
+
+    size_t SgrCache::_Slot(const VTParameters options) noexcept
+    {
+        size_t hash = options.size();
+        for (size_t i = 0; i < options.size(); i++)
+        {
+            hash = hash * 31 + _OptionKey(options.at(i));
+        }
+        return hash & (_entryCount - 1);
+    }
+
+    bool SgrCache::_OptionsMatch(const Entry& entry, const VTParameters options) noexcept
+    {
+        if (entry.optionCount != options.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < entry.optionCount; i++)
+        {
+            if (til::at(entry.options, i) != _OptionKey(options.at(i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,155 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../inc/LinearRegex.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Types;
+
+class LinearRegexTests
+{
+    TEST_CLASS(LinearRegexTests);
+
+    TEST_METHOD(TestLeftmostFirstMatches);
+    TEST_METHOD(TestClassesAndCase);
+    TEST_METHOD(TestAssertions);
+    TEST_METHOD(TestInvalidPatterns);
+    TEST_METHOD(TestPathologicalPattern);
+
+    // Returns every non-empty match in text, like the search box highlights them.
+    static std::wstring _FindAll(const std::wstring_view pattern, const std::wstring_view text, const bool caseInsensitive = false)
+    {
+        const LinearRegex regex{ pattern, caseInsensitive };
+        std::wstring results;
+        size_t offset = 0;
+        while (const auto match = regex.Find(text, offset))
+        {
+            if (match->first == match->second)
+            {
+                offset = match->second + 1;
+                continue;
+            }
+            if (!results.empty())
+            {
+                results.push_back(L'|');
+            }
+            results.append(text.substr(match->first, match->second - match->first));
+            offset = match->second;
+        }
+        return results;
+    }
+};
+
+void LinearRegexTests::TestLeftmostFirstMatches()
+{
+    const std::wstring greedy{ L"aaa|aa" };
+    VERIFY_ARE_EQUAL(greedy, _FindAll(L"a+", L"baaab aa"));
+
+    const std::wstring lazy{ L"a|a|a" };
+    VERIFY_ARE_EQUAL(lazy, _FindAll(L"a+?", L"baaab"));
+
+    Log::Comment(L"The first alternative that leads to a match wins, like in ECMAScript.");
+    const std::wstring alternation{ L"abcd" };
+    VERIFY_ARE_EQUAL(alternation, _FindAll(L"(a|ab)(c|bcd)", L"abcd"));
+
+    const std::wstring counted{ L"12|123|123|45" };
+    VERIFY_ARE_EQUAL(counted, _FindAll(L"\\d{2,3}", L"1 12 1234 12345"));
+
+    Log::Comment(L"A '{' that doesn't start a count is matched literally.");
+    const std::wstring brace{ L"a{,2}" };
+    VERIFY_ARE_EQUAL(brace, _FindAll(L"a{,2}", L"a{,2}"));
+
+    Log::Comment(L"'.' matches a whole surrogate pair.");
+    const std::wstring surrogates{ L"\xD83D\xDE00y" };
+    VERIFY_ARE_EQUAL(surrogates, _FindAll(L".y", L"x\xD83D\xDE00y"));
+}
+
+void LinearRegexTests::TestClassesAndCase()
+{
+    const std::wstring insensitive{ L"ABCabc" };
+    VERIFY_ARE_EQUAL(insensitive, _FindAll(L"[a-c]+", L"xxABCabcyy", true));
+
+    const std::wstring sensitive{ L"abc" };
+    VERIFY_ARE_EQUAL(sensitive, _FindAll(L"[a-c]+", L"xxABCabcyy"));
+
+    const std::wstring negated{ L"xx|def" };
+    VERIFY_ARE_EQUAL(negated, _FindAll(L"[^a-c ]+", L"xxabc def"));
+
+    const std::wstring shorthands{ L" 12 " };
+    VERIFY_ARE_EQUAL(shorthands, _FindAll(L"[\\d\\s]+", L"ab 12 c"));
+
+    Log::Comment(L"A ']' at the start and a '-' at the end of a class are literals.");
+    const std::wstring literals{ L"]-]" };
+    VERIFY_ARE_EQUAL(literals, _FindAll(L"[]-]+", L"x]-]x"));
+
+    const std::wstring escapes{ L"AB" };
+    VERIFY_ARE_EQUAL(escapes, _FindAll(L"\\x41\\u0042", L"xAB"));
+
+    const std::wstring literalSensitivity{ L"ERROR|Warn" };
+    VERIFY_ARE_EQUAL(literalSensitivity, _FindAll(L"error|warn", L"ERROR Warning", true));
+}
+
+void LinearRegexTests::TestAssertions()
+{
+    const std::wstring words{ L"foo|foo" };
+    VERIFY_ARE_EQUAL(words, _FindAll(L"\\bfoo\\b", L"foo foobar barfoo foo"));
+
+    const std::wstring notWords{ L"foo" };
+    VERIFY_ARE_EQUAL(notWords, _FindAll(L"\\Bfoo", L"foo foobar barfoo foo"));
+
+    const LinearRegex start{ L"^foo", false };
+    const auto startMatch = start.Find(L"foo foo", 1);
+    VERIFY_IS_FALSE(startMatch.has_value());
+
+    const LinearRegex end{ L"o$", false };
+    const auto endMatch = end.Find(L"foo foo");
+    VERIFY_IS_TRUE(endMatch.has_value());
+    VERIFY_ARE_EQUAL(6u, endMatch->first);
+    VERIFY_ARE_EQUAL(7u, endMatch->second);
+}
+
+void LinearRegexTests::TestInvalidPatterns()
+{
+    const std::wstring_view patterns[]{
+        L"(",
+        L")",
+        L"a**",
+        L"*a",
+        L"[a",
+        L"[z-a]",
+        L"\\q",
+        L"\\x4",
+        L"(?=a)",
+        L"a{3,2}",
+        L"(a{1000}){1000}",
+        L"a\\",
+    };
+
+    for (const auto pattern : patterns)
+    {
+        Log::Comment(NoThrowString().Format(L"Pattern: %.*s", gsl::narrow_cast<int>(pattern.size()), pattern.data()));
+        VERIFY_THROWS(LinearRegex(pattern, false), wil::ResultException);
+    }
+}
+
+void LinearRegexTests::TestPathologicalPattern()
+{
+    // With a backtracking engine, this takes exponential time to fail.
+    const std::wstring text(5000, L'a');
+    const LinearRegex regex{ L"(a*)*b", false };
+    VERIFY_IS_FALSE(regex.Find(text).has_value());
+
+    Log::Comment(L"Empty loops shouldn't loop forever.");
+    const LinearRegex empty{ L"(a*)*", false };
+    const auto match = empty.Find(L"aa");
+    VERIFY_IS_TRUE(match.has_value());
+    VERIFY_ARE_EQUAL(0u, match->first);
+    VERIFY_ARE_EQUAL(2u, match->second);
+}
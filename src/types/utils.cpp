@@ -559,3 +559,37 @@ GUID Utils::CreateV5Uuid(const GUID& namespaceGuid, const gsl::span<const gsl::b
     ::memcpy_s(&newGuid, sizeof(GUID), buffer.data(), sizeof(GUID));
     return EndianSwap(newGuid);
 }
+
+// Function Description:
+// - Returns how long ago the current process was created. Every module in the
+//   process measures from the same point this way, so startup milestones
+//   recorded by different DLLs (each with its own TraceLogging provider) can
+//   be compared with each other directly.
+// Arguments:
+// - <none>
+// Return Value:
+// - the number of milliseconds since the process was created, or 0 if that
+//   couldn't be determined.
+double Utils::MillisecondsSinceProcessStart() noexcept
+{
+    FILETIME creationTime{};
+    FILETIME exitTime{};
+    FILETIME kernelTime{};
+    FILETIME userTime{};
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    {
+        return 0.0;
+    }
+
+    FILETIME now{};
+    GetSystemTimePreciseAsFileTime(&now);
+
+    const auto toTicks = [](const FILETIME& ft) noexcept {
+        return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    const auto created = toTicks(creationTime);
+    const auto current = toTicks(now);
+
+    // FILETIMEs are in units of 100ns.
+    return current > created ? static_cast<double>(current - created) / 10000.0 : 0.0;
+}
@@ -94,19 +94,28 @@ HRESULT _CreatePseudoConsole(const HANDLE hToken,
     RETURN_IF_WIN32_BOOL_FALSE(SetHandleInformation(signalPipeConhostSide.get(), HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT));
 
     // GH4061: Ensure that the path to executable in the format is escaped so C:\Program.exe cannot collide with C:\Program Files
-    const wchar_t* pwszFormat = L"\"%s\" --headless %s%s%s--width %hu --height %hu --signal 0x%x --server 0x%x";
-    // This is plenty of space to hold the formatted string
-    wchar_t cmd[MAX_PATH]{};
+    const wchar_t* pwszFormat = L"\"%s\" --headless %s%s%s%s%s%s%s--width %hu --height %hu --signal 0x%x --server 0x%x";
+    // This is plenty of space to hold the formatted string, even with a
+    // console host path that's MAX_PATH long and all of the flags.
+    wchar_t cmd[MAX_PATH * 2]{};
     const BOOL bInheritCursor = (dwFlags & PSEUDOCONSOLE_INHERIT_CURSOR) == PSEUDOCONSOLE_INHERIT_CURSOR;
     const BOOL bResizeQuirk = (dwFlags & PSEUDOCONSOLE_RESIZE_QUIRK) == PSEUDOCONSOLE_RESIZE_QUIRK;
     const BOOL bWin32InputMode = (dwFlags & PSEUDOCONSOLE_WIN32_INPUT_MODE) == PSEUDOCONSOLE_WIN32_INPUT_MODE;
+    const BOOL bPassthroughMode = (dwFlags & PSEUDOCONSOLE_PASSTHROUGH_MODE) == PSEUDOCONSOLE_PASSTHROUGH_MODE;
+    const BOOL bTextStreamMode = (dwFlags & PSEUDOCONSOLE_TEXT_STREAM_MODE) == PSEUDOCONSOLE_TEXT_STREAM_MODE;
+    const BOOL bTerminalReflow = (dwFlags & PSEUDOCONSOLE_TERMINAL_REFLOW) == PSEUDOCONSOLE_TERMINAL_REFLOW;
+    const BOOL bRepeatCharacter = (dwFlags & PSEUDOCONSOLE_REPEAT_CHARACTER) == PSEUDOCONSOLE_REPEAT_CHARACTER;
     swprintf_s(cmd,
-               MAX_PATH,
+               std::size(cmd),
                pwszFormat,
                _ConsoleHostPath(),
                bInheritCursor ? L"--inheritcursor " : L"",
                bWin32InputMode ? L"--win32input " : L"",
                bResizeQuirk ? L"--resizeQuirk " : L"",
+               bPassthroughMode ? L"--passthrough " : L"",
+               bTextStreamMode ? L"--textstream " : L"",
+               bTerminalReflow ? L"--terminalReflow " : L"",
+               bRepeatCharacter ? L"--repeatCharacter " : L"",
                size.X,
                size.Y,
                signalPipeConhostSide.get(),
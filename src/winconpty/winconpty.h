@@ -24,6 +24,10 @@ typedef struct _PseudoConsole
 // #define PSEUDOCONSOLE_INHERIT_CURSOR (0x1)
 #define PSEUDOCONSOLE_RESIZE_QUIRK (0x2)
 #define PSEUDOCONSOLE_WIN32_INPUT_MODE (0x4)
+#define PSEUDOCONSOLE_PASSTHROUGH_MODE (0x8)
+#define PSEUDOCONSOLE_TEXT_STREAM_MODE (0x10)
+#define PSEUDOCONSOLE_TERMINAL_REFLOW (0x20)
+#define PSEUDOCONSOLE_REPEAT_CHARACTER (0x40)
 
 // Implementations of the various PseudoConsole functions.
 HRESULT _CreatePseudoConsole(const HANDLE hToken,
@@ -278,3 +278,38 @@ ForEach($_ in $ranges) {
 "        UnicodeRange{{ 0x{0:x}, 0x{1:x}, CodepointWidth::{2} }},{3}" -f $_.Start, $_.End, $_.Width, $comment
 }
 "    };"
+
+# Emit the same data for the BMP as a two-level lookup table.
+# The BMP is split into blocks of 2^$BmpBlockShift codepoints. Identical blocks
+# are only stored once in Stage2 and Stage1 maps each block to its offset.
+$BmpBlockShift = 7
+$BmpBlockSize = 1 -shl $BmpBlockShift
+$bmp = [byte[]]::new(0x10000) # Narrow is 0
+ForEach($_ in $ranges) {
+    For ($cp = $_.Start; $cp -le [Math]::Min($_.End, 0xFFFF); $cp++) {
+        $bmp[$cp] = [byte][int]$_.Width
+    }
+}
+
+$stage1 = [System.Collections.Generic.List[int]]::New(0x10000 / $BmpBlockSize)
+$stage2 = [System.Collections.Generic.List[byte]]::New()
+$blockOffsets = @{}
+For ($b = 0; $b -lt 0x10000; $b += $BmpBlockSize) {
+    $key = [Convert]::ToBase64String($bmp, $b, $BmpBlockSize)
+    If (-not $blockOffsets.ContainsKey($key)) {
+        $blockOffsets[$key] = $stage2.Count / $BmpBlockSize
+        $stage2.AddRange([byte[]]$bmp[$b..($b + $BmpBlockSize - 1)])
+    }
+    $stage1.Add($blockOffsets[$key])
+}
+
+"    static constexpr std::array<uint8_t, {0}> s_bmpStage1{{" -f $stage1.Count
+For ($i = 0; $i -lt $stage1.Count; $i += 16) {
+"        {0}," -f (($stage1[$i..($i + 15)] | ForEach-Object { "0x{0:x2}" -f $_ }) -join ", ")
+}
+"    };"
+"    static constexpr std::array<uint8_t, {0}> s_bmpStage2{{" -f $stage2.Count
+For ($i = 0; $i -lt $stage2.Count; $i += 32) {
+"        {0}," -f ($stage2[$i..($i + 31)] -join ", ")
+}
+"    };"